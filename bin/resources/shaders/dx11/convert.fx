@@ -455,6 +455,34 @@ PS_OUTPUT ps_convert_rgba_8i(PS_INPUT input)
 	return output;
 }
 
+PS_OUTPUT ps_unswizzle_ct32(PS_INPUT input)
+{
+	// Borrowing the YUV constant buffer.
+	uint2 origin = uint2(BGColor.xy);
+	float TA0 = BGColor.z;
+	bool AEM = BGColor.w != 0.0f;
+	uint BP = uint(EMODA);
+	uint BW = uint(EMODC);
+	uint PSM = uint(DOFFSET);
+
+	// Read a PSMCT32/PSMCT24 texel from the copy of local memory, stored as 1024 words per row.
+	uint2 pos = (uint2(input.p.xy) + origin) & 2047u;
+
+	// Pages are 64x32, blocks 8x8, see blockTable32 and columnTable32.
+	uint page = (pos.y >> 5) * BW + (pos.x >> 6);
+	uint2 b = (pos >> 3) & uint2(7u, 3u);
+	uint block = (b.x & 1u) | ((b.y & 1u) << 1) | ((b.x & 2u) << 1) | ((b.y & 2u) << 2) | ((b.x & 4u) << 2);
+	uint2 p = pos & 7u;
+	uint word = (p.x & 1u) | ((p.y & 1u) << 1) | ((p.x & 6u) << 1) | ((p.y & 6u) << 3);
+	uint addr = (((BP + (page << 5) + block) & 0x3FFFu) << 6) | word;
+
+	PS_OUTPUT output;
+	output.c = Texture.Load(int3(int(addr & 1023u), int(addr >> 10), 0));
+	if (PSM == 1u) // PSMCT24, expand alpha like ExpandBlock24().
+		output.c.a = (AEM && all(output.c.rgb == (float3)0.0f)) ? 0.0f : TA0;
+	return output;
+}
+
 PS_OUTPUT ps_convert_clut_4(PS_INPUT input)
 {
 	// Borrowing the YUV constant buffer.
@@ -484,6 +484,34 @@ void ps_colclip_resolve()
 }
 #endif
 
+#ifdef ps_unswizzle_ct32
+uniform vec2 Origin;
+uniform float TA0;
+uniform float AEM;
+uniform uint BP;
+uniform uint BW;
+uniform uint PSM;
+
+void ps_unswizzle_ct32()
+{
+	// Read a PSMCT32/PSMCT24 texel from the copy of local memory, stored as 1024 words per row.
+	uvec2 pos = (uvec2(gl_FragCoord.xy) + uvec2(Origin)) & uvec2(2047u);
+
+	// Pages are 64x32, blocks 8x8, see blockTable32 and columnTable32.
+	uint page = (pos.y >> 5) * BW + (pos.x >> 6);
+	uvec2 b = (pos >> 3) & uvec2(7u, 3u);
+	uint block = (b.x & 1u) | ((b.y & 1u) << 1) | ((b.x & 2u) << 1) | ((b.y & 2u) << 2) | ((b.x & 4u) << 2);
+	uvec2 p = pos & uvec2(7u);
+	uint word = (p.x & 1u) | ((p.y & 1u) << 1) | ((p.x & 6u) << 1) | ((p.y & 6u) << 3);
+	uint addr = (((BP + (page << 5) + block) & 0x3FFFu) << 6) | word;
+
+	vec4 pixel = texelFetch(TextureSampler, ivec2(addr & 1023u, addr >> 10), 0);
+	if (PSM == 1u) // PSMCT24, expand alpha like ExpandBlock24().
+		pixel.a = (AEM != 0.0f && all(equal(pixel.rgb, vec3(0.0f)))) ? 0.0f : TA0;
+	SV_Target0 = pixel;
+}
+#endif
+
 #ifdef ps_convert_clut_4
 uniform uvec3 offset;
 uniform float scale;
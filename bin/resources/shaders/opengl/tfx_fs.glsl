@@ -29,6 +29,16 @@
 #define NEEDS_RT (NEEDS_RT_EARLY || NEEDS_RT_FOR_AFAIL || (!PS_PRIMID_INIT && (PS_FBMASK || SW_BLEND_NEEDS_RT || SW_AD_TO_HW)))
 #define NEEDS_TEX (PS_TFX != 4)
 
+#if PS_DYNAMIC
+// Ubershader used while the specialized program compiles, the texture function,
+// alpha test and fog are taken from DynamicKey instead of PS_TFX/PS_TCC/PS_ATST/PS_FOG.
+uniform uint DynamicKey;
+#define DYNAMIC_TFX (DynamicKey & 3u)
+#define DYNAMIC_TCC ((DynamicKey >> 2) & 1u)
+#define DYNAMIC_ATST ((DynamicKey >> 3) & 7u)
+#define DYNAMIC_FOG ((DynamicKey >> 6) & 1u)
+#endif
+
 layout(std140, binding = 0) uniform cb21
 {
 	vec3 FogColor;
@@ -599,6 +609,33 @@ vec4 tfx(vec4 T, vec4 C)
 	vec4 C_out;
 	vec4 FxT = trunc((C * T) / 128.0f);
 
+#if PS_DYNAMIC && NEEDS_TEX
+	if (DYNAMIC_TFX == 0u)
+	{
+		C_out = FxT;
+	}
+	else if (DYNAMIC_TFX == 1u)
+	{
+		C_out = T;
+	}
+	else if (DYNAMIC_TFX == 2u)
+	{
+		C_out.rgb = FxT.rgb + C.a;
+		C_out.a = T.a + C.a;
+	}
+	else
+	{
+		C_out.rgb = FxT.rgb + C.a;
+		C_out.a = T.a;
+	}
+
+	if (DYNAMIC_TCC == 0u)
+		C_out.a = C.a;
+
+	// Clamp only when it is useful
+	if (DYNAMIC_TFX != 1u)
+		C_out = min(C_out, 255.0f);
+#else
 #if (PS_TFX == 0)
 	C_out = FxT;
 #elif (PS_TFX == 1)
@@ -620,6 +657,7 @@ vec4 tfx(vec4 T, vec4 C)
 #if (PS_TFX == 0) || (PS_TFX == 2) || (PS_TFX == 3)
 	// Clamp only when it is useful
 	C_out = min(C_out, 255.0f);
+#endif
 #endif
 
 	return C_out;
@@ -629,7 +667,16 @@ bool atst(vec4 C)
 {
 	float a = C.a;
 
-#if (PS_ATST == 1)
+#if PS_DYNAMIC
+	switch (DYNAMIC_ATST)
+	{
+		case 1u: return (a <= AREF);
+		case 2u: return (a >= AREF);
+		case 3u: return (abs(a - AREF) <= 0.5f);
+		case 4u: return (abs(a - AREF) >= 0.5f);
+		default: return true;
+	}
+#elif (PS_ATST == 1)
 	return (a <= AREF);
 #elif (PS_ATST == 2)
 	return (a >= AREF);
@@ -645,7 +692,10 @@ bool atst(vec4 C)
 
 void fog(inout vec4 C, float f)
 {
-#if PS_FOG != 0
+#if PS_DYNAMIC
+	if (DYNAMIC_FOG != 0u)
+		C.rgb = trunc(mix(FogColor, C.rgb, f));
+#elif PS_FOG != 0
 	C.rgb = trunc(mix(FogColor, C.rgb, f));
 #endif
 }
@@ -5,11 +5,16 @@
 #include "common/Assertions.h"
 #include "common/FileSystem.h"
 #include "common/SmallString.h"
+#include "common/Threading.h"
 #include "common/Timer.h"
 
 #include "fmt/format.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
@@ -35,13 +40,17 @@ NullLogWriter DbgConWriter;
 
 namespace Log
 {
-	static void WriteToConsole(LOGLEVEL level, ConsoleColors color, std::string_view message);
+	static void WriteToConsole(LOGLEVEL level, ConsoleColors color, std::string_view message, float message_time);
 	static void WriteToDebug(LOGLEVEL level, ConsoleColors color, std::string_view message);
-	static void WriteToFile(LOGLEVEL level, ConsoleColors color, std::string_view message);
+	static void WriteToFile(LOGLEVEL level, ConsoleColors color, std::string_view message, float message_time);
 
 	static void UpdateMaxLevel();
 
-	static void ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view message);
+	static void ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view message, float message_time);
+	static void DispatchMessage(LOGLEVEL level, ConsoleColors color, std::string_view message);
+
+	static bool EnqueueMessage(LOGLEVEL level, ConsoleColors color, std::string_view message);
+	static void AsyncWriterThread();
 
 	static Common::Timer::Value s_start_timestamp = Common::Timer::GetCurrentValue();
 
@@ -58,6 +67,38 @@ namespace Log
 
 	static HostCallbackType s_host_callback;
 
+	struct QueuedMessage
+	{
+		float time;
+		LOGLEVEL level;
+		ConsoleColors color;
+		u32 repeat_count;
+		std::string text;
+	};
+
+	// Bounds the queue when a game spams faster than the outputs can keep up, the excess is dropped and counted.
+	static constexpr size_t MAX_QUEUED_MESSAGES = 16384;
+
+	// How long a repeat count is held back waiting for more copies of the same message.
+	static constexpr std::chrono::milliseconds REPEAT_FLUSH_DELAY{250};
+
+	static std::atomic_bool s_async_enabled{false};
+	static std::mutex s_queue_mutex;
+	static std::condition_variable s_queue_cv;
+	static std::condition_variable s_queue_idle_cv;
+	static std::vector<QueuedMessage> s_queue;
+	static u32 s_dropped_messages = 0;
+	static bool s_writer_idle = true;
+	static bool s_writer_flush_requested = false;
+	static bool s_writer_shutdown = false;
+	static std::thread s_writer_thread;
+
+	// Joins the writer if the process exits with async output still enabled.
+	static struct AsyncWriterGuard
+	{
+		~AsyncWriterGuard() { SetAsyncOutputEnabled(false); }
+	} s_async_writer_guard;
+
 #ifdef _WIN32
 	static HANDLE s_hConsoleStdIn = NULL;
 	static HANDLE s_hConsoleStdOut = NULL;
@@ -70,7 +111,7 @@ float Log::GetCurrentMessageTime()
 	return static_cast<float>(Common::Timer::ConvertValueToSeconds(Common::Timer::GetCurrentValue() - s_start_timestamp));
 }
 
-__ri void Log::WriteToConsole(LOGLEVEL level, ConsoleColors color, std::string_view message)
+__ri void Log::WriteToConsole(LOGLEVEL level, ConsoleColors color, std::string_view message, float message_time)
 {
 	static constexpr std::string_view s_ansi_color_codes[ConsoleColors_Count] = {
 		"\033[0m"sv, // default
@@ -103,7 +144,7 @@ __ri void Log::WriteToConsole(LOGLEVEL level, ConsoleColors color, std::string_v
 	buffer.append(s_ansi_color_codes[color]);
 
 	if (s_log_timestamps)
-		buffer.append_format(TIMESTAMP_FORMAT_STRING, Log::GetCurrentMessageTime());
+		buffer.append_format(TIMESTAMP_FORMAT_STRING, message_time);
 
 	buffer.append(message);
 	buffer.append('\n');
@@ -291,7 +332,7 @@ void Log::SetDebugOutputLevel(LOGLEVEL level)
 	UpdateMaxLevel();
 }
 
-__ri void Log::WriteToFile(LOGLEVEL level, ConsoleColors color, std::string_view message)
+__ri void Log::WriteToFile(LOGLEVEL level, ConsoleColors color, std::string_view message, float message_time)
 {
 	std::unique_lock lock(s_file_mutex);
 	if (!s_file_handle) [[unlikely]]
@@ -301,7 +342,7 @@ __ri void Log::WriteToFile(LOGLEVEL level, ConsoleColors color, std::string_view
 	{
 		if (s_log_timestamps)
 		{
-			std::fprintf(s_file_handle.get(), TIMESTAMP_PRINTF_STRING "%.*s\n", GetCurrentMessageTime(),
+			std::fprintf(s_file_handle.get(), TIMESTAMP_PRINTF_STRING "%.*s\n", message_time,
 				static_cast<int>(message.size()), message.data());
 		}
 		else
@@ -313,7 +354,7 @@ __ri void Log::WriteToFile(LOGLEVEL level, ConsoleColors color, std::string_view
 	{
 		if (s_log_timestamps)
 		{
-			std::fprintf(s_file_handle.get(), TIMESTAMP_PRINTF_STRING "\n", GetCurrentMessageTime());
+			std::fprintf(s_file_handle.get(), TIMESTAMP_PRINTF_STRING "\n", message_time);
 		}
 		else
 		{
@@ -352,7 +393,7 @@ bool Log::SetFileOutputLevel(LOGLEVEL level, std::string path)
 					s_file_path = {};
 
 					if (IsConsoleOutputEnabled())
-						WriteToConsole(LOGLEVEL_ERROR, Color_StrongRed, TinyString::from_format("Failed to open log file '{}'", path));
+						WriteToConsole(LOGLEVEL_ERROR, Color_StrongRed, TinyString::from_format("Failed to open log file '{}'", path), GetCurrentMessageTime());
 				}
 			}
 		}
@@ -406,10 +447,8 @@ __ri void Log::UpdateMaxLevel()
 	s_max_level = std::max(s_console_level, std::max(s_debug_level, std::max(s_file_level, s_host_level)));
 }
 
-void Log::ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view message)
+void Log::ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view message, float message_time)
 {
-	// TODO: Cache the message time.
-
 	// Split newlines into separate messages.
 	std::string_view::size_type start_pos = 0;
 	if (std::string_view::size_type end_pos = message.find('\n'); end_pos != std::string::npos) [[unlikely]]
@@ -420,7 +459,7 @@ void Log::ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view
 			if (start_pos != end_pos)
 				message_line = message.substr(start_pos, (end_pos == std::string_view::npos) ? end_pos : end_pos - start_pos);
 
-			ExecuteCallbacks(level, color, message_line);
+			ExecuteCallbacks(level, color, message_line, message_time);
 
 			if (end_pos == std::string_view::npos)
 				return;
@@ -433,13 +472,13 @@ void Log::ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view
 
 	pxAssert(level > LOGLEVEL_NONE);
 	if (level <= s_console_level)
-		WriteToConsole(level, color, message);
+		WriteToConsole(level, color, message, message_time);
 
 	if (level <= s_debug_level)
 		WriteToDebug(level, color, message);
 
 	if (level <= s_file_level)
-		WriteToFile(level, color, message);
+		WriteToFile(level, color, message, message_time);
 
 	if (level <= s_host_level)
 	{
@@ -450,12 +489,18 @@ void Log::ExecuteCallbacks(LOGLEVEL level, ConsoleColors color, std::string_view
 	}
 }
 
+void Log::DispatchMessage(LOGLEVEL level, ConsoleColors color, std::string_view message)
+{
+	if (!EnqueueMessage(level, color, message))
+		ExecuteCallbacks(level, color, message, GetCurrentMessageTime());
+}
+
 void Log::Write(LOGLEVEL level, ConsoleColors color, std::string_view message)
 {
 	if (level > s_max_level)
 		return;
 
-	ExecuteCallbacks(level, color, message);
+	DispatchMessage(level, color, message);
 }
 
 void Log::Writef(LOGLEVEL level, ConsoleColors color, const char* format, ...)
@@ -486,14 +531,14 @@ void Log::Writev(LOGLEVEL level, ConsoleColors color, const char* format, va_lis
 		char buffer[512];
 		const int len = std::vsnprintf(buffer, std::size(buffer), format, ap);
 		if (len > 0)
-			ExecuteCallbacks(level, color, std::string_view(buffer, static_cast<size_t>(len)));
+			DispatchMessage(level, color, std::string_view(buffer, static_cast<size_t>(len)));
 	}
 	else
 	{
 		char* buffer = new char[required_size + 1];
 		const int len = std::vsnprintf(buffer, required_size + 1, format, ap);
 		if (len > 0)
-			ExecuteCallbacks(level, color, std::string_view(buffer, static_cast<size_t>(len)));
+			DispatchMessage(level, color, std::string_view(buffer, static_cast<size_t>(len)));
 		delete[] buffer;
 	}
 }
@@ -506,5 +551,170 @@ void Log::WriteFmtArgs(LOGLEVEL level, ConsoleColors color, fmt::string_view fmt
 	fmt::memory_buffer buffer;
 	fmt::vformat_to(std::back_inserter(buffer), fmt, args);
 
-	ExecuteCallbacks(level, color, std::string_view(buffer.data(), buffer.size()));
+	DispatchMessage(level, color, std::string_view(buffer.data(), buffer.size()));
+}
+
+bool Log::EnqueueMessage(LOGLEVEL level, ConsoleColors color, std::string_view message)
+{
+	if (!s_async_enabled.load(std::memory_order_acquire))
+		return false;
+
+	const float message_time = GetCurrentMessageTime();
+	{
+		std::unique_lock lock(s_queue_mutex);
+		if (!s_queue.empty())
+		{
+			QueuedMessage& last = s_queue.back();
+			if (last.level == level && last.color == color && last.text == message)
+			{
+				last.repeat_count++;
+				return true;
+			}
+		}
+
+		if (s_queue.size() >= MAX_QUEUED_MESSAGES) [[unlikely]]
+		{
+			s_dropped_messages++;
+			return true;
+		}
+
+		const bool was_empty = s_queue.empty();
+		s_queue.push_back(QueuedMessage{message_time, level, color, 1, std::string(message)});
+		if (was_empty)
+			s_queue_cv.notify_one();
+	}
+
+	// Errors are usually followed by a crash or exit, don't lose them in the queue.
+	if (level <= LOGLEVEL_ERROR)
+		Flush();
+
+	return true;
+}
+
+void Log::AsyncWriterThread()
+{
+	Threading::SetNameOfCurrentThread("Log Writer");
+
+	std::vector<QueuedMessage> batch;
+	QueuedMessage last = {};
+	u32 pending_repeats = 0;
+	bool timed_out = false;
+
+	const auto write_repeat_count = [&last, &pending_repeats]() {
+		if (pending_repeats == 0)
+			return;
+
+		ExecuteCallbacks(last.level, last.color, TinyString::from_format("Last message repeated {} times.", pending_repeats),
+			GetCurrentMessageTime());
+		pending_repeats = 0;
+	};
+
+	std::unique_lock lock(s_queue_mutex);
+	for (;;)
+	{
+		if (s_queue.empty() && s_dropped_messages == 0)
+		{
+			if (pending_repeats > 0 && (timed_out || s_writer_flush_requested || s_writer_shutdown))
+			{
+				lock.unlock();
+				write_repeat_count();
+				lock.lock();
+				continue;
+			}
+
+			s_writer_flush_requested = false;
+			s_writer_idle = true;
+			s_queue_idle_cv.notify_all();
+			if (s_writer_shutdown)
+				break;
+
+			const auto wake = []() { return !s_queue.empty() || s_writer_flush_requested || s_writer_shutdown; };
+			if (pending_repeats > 0)
+				timed_out = !s_queue_cv.wait_for(lock, REPEAT_FLUSH_DELAY, wake);
+			else
+				s_queue_cv.wait(lock, wake);
+
+			continue;
+		}
+
+		timed_out = false;
+		s_writer_idle = false;
+		batch.swap(s_queue);
+		const u32 dropped = std::exchange(s_dropped_messages, 0);
+		lock.unlock();
+
+		for (QueuedMessage& msg : batch)
+		{
+			if (msg.level == last.level && msg.color == last.color && msg.text == last.text)
+			{
+				pending_repeats += msg.repeat_count;
+				continue;
+			}
+
+			write_repeat_count();
+			ExecuteCallbacks(msg.level, msg.color, msg.text, msg.time);
+			pending_repeats = msg.repeat_count - 1;
+			last = std::move(msg);
+		}
+		batch.clear();
+
+		if (dropped > 0)
+		{
+			write_repeat_count();
+			ExecuteCallbacks(LOGLEVEL_WARNING, Color_StrongOrange,
+				TinyString::from_format("{} log messages were dropped, output could not keep up.", dropped), GetCurrentMessageTime());
+		}
+
+		lock.lock();
+	}
+}
+
+bool Log::IsAsyncOutputEnabled()
+{
+	return s_async_enabled.load(std::memory_order_acquire);
+}
+
+void Log::SetAsyncOutputEnabled(bool enabled)
+{
+	if (s_async_enabled.load(std::memory_order_acquire) == enabled)
+		return;
+
+	if (enabled)
+	{
+		s_writer_shutdown = false;
+		s_writer_idle = true;
+		s_writer_thread = std::thread(&Log::AsyncWriterThread);
+		s_async_enabled.store(true, std::memory_order_release);
+		return;
+	}
+
+	s_async_enabled.store(false, std::memory_order_release);
+	{
+		std::unique_lock lock(s_queue_mutex);
+		s_writer_shutdown = true;
+		s_queue_cv.notify_one();
+	}
+	s_writer_thread.join();
+
+	// Anything which raced with the shutdown gets written directly.
+	std::vector<QueuedMessage> remaining;
+	{
+		std::unique_lock lock(s_queue_mutex);
+		remaining.swap(s_queue);
+		s_dropped_messages = 0;
+	}
+	for (const QueuedMessage& msg : remaining)
+		ExecuteCallbacks(msg.level, msg.color, msg.text, msg.time);
+}
+
+void Log::Flush()
+{
+	if (!s_async_enabled.load(std::memory_order_acquire) || std::this_thread::get_id() == s_writer_thread.get_id())
+		return;
+
+	std::unique_lock lock(s_queue_mutex);
+	s_writer_flush_requested = true;
+	s_writer_idle = false;
+	s_queue_cv.notify_one();
+	s_queue_idle_cv.wait(lock, []() { return s_writer_idle || s_writer_shutdown; });
 }
@@ -95,6 +95,14 @@ namespace Log
 	// Returns the current global filtering level.
 	LOGLEVEL GetMaxLevel();
 
+	// queues messages and writes them to the outputs from a background thread, so the caller never
+	// waits on console/file I/O. consecutive identical messages are coalesced into a repeat count.
+	bool IsAsyncOutputEnabled();
+	void SetAsyncOutputEnabled(bool enabled);
+
+	// blocks until all queued messages have been written, no-op when async output is disabled
+	void Flush();
+
 	// writes a message to the log
 	void Write(LOGLEVEL level, ConsoleColors color, std::string_view message);
 	void Writef(LOGLEVEL level, ConsoleColors color, const char* format, ...);
@@ -27,6 +27,7 @@
 #include <mach/task.h>
 #include <mach/vm_map.h>
 #include <mutex>
+#include <vector>
 #include <ApplicationServices/ApplicationServices.h>
 #include <IOKit/pwr_mgt/IOPMLib.h>
 
@@ -76,6 +77,16 @@ u64 GetAvailablePhysicalMemory()
 	return get_available_mem;
 }
 
+u64 GetProcessResidentMemory()
+{
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+		return 0;
+
+	return static_cast<u64>(info.resident_size);
+}
+
 static mach_timebase_info_data_t s_timebase_info;
 static const u64 tickfreq = []() {
 	if (mach_timebase_info(&s_timebase_info) != KERN_SUCCESS)
@@ -389,6 +400,27 @@ void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode&
 	}
 }
 
+bool HostSys::AdviseHugePages(void* baseaddr, size_t size, bool enable)
+{
+	// Superpages can only be requested at allocation time, and not for shared memory.
+	return false;
+}
+
+size_t HostSys::GetResidentSize(const void* baseaddr, size_t size)
+{
+	const uptr start = reinterpret_cast<uptr>(baseaddr) & ~static_cast<uptr>(__pagemask);
+	const uptr end = Common::AlignUpPow2(reinterpret_cast<uptr>(baseaddr) + size, __pagesize);
+	std::vector<char> pages((end - start) / __pagesize);
+	if (pages.empty() || mincore(reinterpret_cast<caddr_t>(start), end - start, pages.data()) != 0)
+		return 0;
+
+	size_t resident = 0;
+	for (const char page : pages)
+		resident += ((page & MINCORE_INCORE) != 0);
+
+	return resident * __pagesize;
+}
+
 std::string HostSys::GetFileMappingName(const char* prefix)
 {
 	// name actually is not used.
@@ -2644,3 +2644,44 @@ FileSystem::POSIXLock::~POSIXLock()
 }
 
 #endif
+
+FileSystem::SharedFileLock::SharedFileLock(std::FILE* fp)
+	: m_fp(fp)
+{
+#ifdef _WIN32
+	const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(fp)));
+	OVERLAPPED ov = {};
+	m_locked = (handle != INVALID_HANDLE_VALUE &&
+				LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &ov));
+	if (!m_locked)
+		Console.Error("LockFileEx() failed: %u", GetLastError());
+#else
+	// fcntl() rather than lockf(), the latter only covers the range past the current file position.
+	struct flock fl = {};
+	fl.l_type = F_WRLCK;
+	fl.l_whence = SEEK_SET;
+	m_locked = (fcntl(fileno(fp), F_SETLKW, &fl) == 0);
+	if (!m_locked)
+		Console.Error("fcntl(F_SETLKW) failed: %d", errno);
+#endif
+}
+
+FileSystem::SharedFileLock::~SharedFileLock()
+{
+	if (!m_locked)
+		return;
+
+	// Anything written while holding the lock must be visible before the next process takes it.
+	std::fflush(m_fp);
+
+#ifdef _WIN32
+	const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_fp)));
+	OVERLAPPED ov = {};
+	UnlockFileEx(handle, 0, MAXDWORD, MAXDWORD, &ov);
+#else
+	struct flock fl = {};
+	fl.l_type = F_UNLCK;
+	fl.l_whence = SEEK_SET;
+	fcntl(fileno(m_fp), F_SETLK, &fl);
+#endif
+}
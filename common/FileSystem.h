@@ -209,4 +209,19 @@ namespace FileSystem
 		int m_fd;
 	};
 #endif
+
+	/// Holds an exclusive lock on the whole file until destroyed, for files which several processes append to.
+	/// Only excludes other processes, threads within the same process are not serialized.
+	class SharedFileLock
+	{
+	public:
+		SharedFileLock(std::FILE* fp);
+		~SharedFileLock();
+
+		bool IsLocked() const { return m_locked; }
+
+	private:
+		std::FILE* m_fp;
+		bool m_locked = false;
+	};
 }; // namespace FileSystem
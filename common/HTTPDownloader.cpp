@@ -34,18 +34,19 @@ void HTTPDownloader::SetMaxActiveRequests(u32 max_active_requests)
 	m_max_active_requests = max_active_requests;
 }
 
-void HTTPDownloader::CreateRequest(std::string url, Request::Callback callback, ProgressCallback* progress)
+void HTTPDownloader::CreateRequest(std::string url, Request::Callback callback, ProgressCallback* progress, Request::Priority priority)
 {
 	Request* req = InternalCreateRequest();
 	req->parent = this;
 	req->type = Request::Type::Get;
+	req->priority = priority;
 	req->url = std::move(url);
 	req->callback = std::move(callback);
 	req->progress = progress;
 	req->start_time = Common::Timer::GetCurrentValue();
 
 	std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
-	if (LockedGetActiveRequestCount() < m_max_active_requests)
+	if (LockedCanStartRequest(req, LockedGetActiveRequestCount()))
 	{
 		if (!StartRequest(req))
 			return;
@@ -66,7 +67,7 @@ void HTTPDownloader::CreatePostRequest(std::string url, std::string post_data, R
 	req->start_time = Common::Timer::GetCurrentValue();
 
 	std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
-	if (LockedGetActiveRequestCount() < m_max_active_requests)
+	if (LockedCanStartRequest(req, LockedGetActiveRequestCount()))
 	{
 		if (!StartRequest(req))
 			return;
@@ -161,18 +162,25 @@ void HTTPDownloader::LockedPollRequests(std::unique_lock<std::mutex>& lock)
 		lock.lock();
 	}
 
-	// start new requests when we finished some
-	if (unstarted_requests > 0 && active_requests < m_max_active_requests)
+	// start new requests when we finished some, interactive ones first
+	for (const Request::Priority priority : {Request::Priority::Interactive, Request::Priority::Bulk})
 	{
+		if (unstarted_requests == 0 || active_requests >= m_max_active_requests)
+			break;
+
 		for (size_t index = 0; index < m_pending_http_requests.size();)
 		{
 			Request* req = m_pending_http_requests[index];
-			if (req->state != Request::State::Pending)
+			if (req->state != Request::State::Pending || req->priority != priority)
 			{
 				index++;
 				continue;
 			}
 
+			if (!LockedCanStartRequest(req, active_requests))
+				break;
+
+			unstarted_requests--;
 			if (!StartRequest(req))
 			{
 				m_pending_http_requests.erase(m_pending_http_requests.begin() + index);
@@ -181,9 +189,6 @@ void HTTPDownloader::LockedPollRequests(std::unique_lock<std::mutex>& lock)
 
 			active_requests++;
 			index++;
-
-			if (active_requests >= m_max_active_requests)
-				break;
 		}
 	}
 }
@@ -205,6 +210,17 @@ void HTTPDownloader::WaitForAllRequests()
 	}
 }
 
+void HTTPDownloader::WaitForRequestCountBelow(u32 max_requests)
+{
+	std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
+	while (m_pending_http_requests.size() >= max_requests)
+	{
+		// Don't burn too much CPU.
+		Threading::Sleep(1);
+		LockedPollRequests(lock);
+	}
+}
+
 void HTTPDownloader::LockedAddRequest(Request* request)
 {
 	m_pending_http_requests.push_back(request);
@@ -221,6 +237,14 @@ u32 HTTPDownloader::LockedGetActiveRequestCount()
 	return count;
 }
 
+bool HTTPDownloader::LockedCanStartRequest(const Request* request, u32 active_requests) const
+{
+	if (request->priority == Request::Priority::Bulk && m_max_active_requests > 1)
+		return (active_requests + 1) < m_max_active_requests;
+
+	return active_requests < m_max_active_requests;
+}
+
 bool HTTPDownloader::HasAnyRequests()
 {
 	std::unique_lock<std::mutex> lock(m_pending_http_request_lock);
@@ -38,6 +38,14 @@ public:
 			Post,
 		};
 
+		// Bulk requests never take the last free request slot, so an interactive request
+		// (e.g. a server call) doesn't have to wait for a batch of image downloads.
+		enum class Priority
+		{
+			Interactive,
+			Bulk,
+		};
+
 		enum class State
 		{
 			Pending,
@@ -59,6 +67,7 @@ public:
 		u32 content_length = 0;
 		u32 last_progress_update = 0;
 		Type type = Type::Get;
+		Priority priority = Priority::Interactive;
 		std::atomic<State> state{State::Pending};
 	};
 
@@ -71,10 +80,14 @@ public:
 	void SetTimeout(float timeout);
 	void SetMaxActiveRequests(u32 max_active_requests);
 
-	void CreateRequest(std::string url, Request::Callback callback, ProgressCallback* progress = nullptr);
+	void CreateRequest(std::string url, Request::Callback callback, ProgressCallback* progress = nullptr,
+		Request::Priority priority = Request::Priority::Interactive);
 	void CreatePostRequest(std::string url, std::string post_data, Request::Callback callback, ProgressCallback* progress = nullptr);
 	void PollRequests();
 	void WaitForAllRequests();
+
+	/// Polls until fewer than max_requests requests are queued or in flight.
+	void WaitForRequestCountBelow(u32 max_requests);
 	bool HasAnyRequests();
 
 	static const char DEFAULT_USER_AGENT[];
@@ -88,6 +101,7 @@ protected:
 
 	void LockedAddRequest(Request* request);
 	u32 LockedGetActiveRequestCount();
+	bool LockedCanStartRequest(const Request* request, u32 active_requests) const;
 	void LockedPollRequests(std::unique_lock<std::mutex>& lock);
 
 	float m_timeout;
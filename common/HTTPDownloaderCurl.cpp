@@ -65,6 +65,9 @@ bool HTTPDownloaderCurl::Initialize(std::string user_agent)
 		return false;
 	}
 
+	// Badge and cover downloads mostly go to the same few hosts, share one HTTP/2 connection where we can.
+	curl_multi_setopt(m_multi_handle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
 	m_user_agent = std::move(user_agent);
 	return true;
 }
@@ -172,6 +175,7 @@ bool HTTPDownloaderCurl::StartRequest(HTTPDownloader::Request* request)
 	curl_easy_setopt(req->handle, CURLOPT_NOSIGNAL, 1L);
 	curl_easy_setopt(req->handle, CURLOPT_PRIVATE, req);
 	curl_easy_setopt(req->handle, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(req->handle, CURLOPT_PIPEWAIT, 1L);
 
 	if (request->type == Request::Type::Post)
 	{
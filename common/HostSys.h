@@ -106,6 +106,14 @@ namespace HostSys
 	extern void* MapSharedMemory(void* handle, size_t offset, void* baseaddr, size_t size, const PageProtectionMode& mode);
 	extern void UnmapSharedMemory(void* baseaddr, size_t size);
 
+	/// Asks the kernel to back a mapping with huge pages, or to stop doing so.
+	/// Returns false if the host doesn't support it, in which case normal pages are used.
+	extern bool AdviseHugePages(void* baseaddr, size_t size, bool enable);
+
+	/// Returns how much of a mapping is currently resident in physical memory, in bytes.
+	/// Pages which were reserved but never touched don't count.
+	extern size_t GetResidentSize(const void* baseaddr, size_t size);
+
 	/// JIT write protect for Apple Silicon. Needs to be called prior to writing to any RWX pages.
 #if !defined(__APPLE__) || !defined(_M_ARM64)
 	// clang-format -off
@@ -182,6 +190,8 @@ extern u64 GetTickFrequency();
 extern u64 GetCPUTicks();
 extern u64 GetPhysicalMemory();
 extern u64 GetAvailablePhysicalMemory();
+/// Returns the resident set size (working set on Windows) of the current process, in bytes.
+extern u64 GetProcessResidentMemory();
 /// Spin for a short period of time (call while spinning waiting for a lock)
 /// Returns the approximate number of ns that passed
 extern u32 ShortSpin();
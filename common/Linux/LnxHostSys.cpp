@@ -16,6 +16,7 @@
 #include <sys/mman.h>
 #include <ucontext.h>
 #include <unistd.h>
+#include <vector>
 
 #include "fmt/format.h"
 
@@ -82,6 +83,31 @@ void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode&
 		pxFail("mprotect() failed");
 }
 
+bool HostSys::AdviseHugePages(void* baseaddr, size_t size, bool enable)
+{
+#ifdef MADV_HUGEPAGE
+	// Transparent huge pages, this also covers the shared memory file as long as shmem_enabled is at least "advise".
+	return (madvise(baseaddr, size, enable ? MADV_HUGEPAGE : MADV_NOHUGEPAGE) == 0);
+#else
+	return false;
+#endif
+}
+
+size_t HostSys::GetResidentSize(const void* baseaddr, size_t size)
+{
+	const uptr start = reinterpret_cast<uptr>(baseaddr) & ~static_cast<uptr>(__pagemask);
+	const uptr end = Common::AlignUpPow2(reinterpret_cast<uptr>(baseaddr) + size, __pagesize);
+	std::vector<unsigned char> pages((end - start) / __pagesize);
+	if (pages.empty() || mincore(reinterpret_cast<void*>(start), end - start, pages.data()) != 0)
+		return 0;
+
+	size_t resident = 0;
+	for (const unsigned char page : pages)
+		resident += (page & 1);
+
+	return resident * __pagesize;
+}
+
 std::string HostSys::GetFileMappingName(const char* prefix)
 {
 	const unsigned pid = static_cast<unsigned>(getpid());
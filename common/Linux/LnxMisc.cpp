@@ -41,6 +41,19 @@ u64 GetPhysicalMemory()
 	return pages * getpagesize();
 }
 
+u64 GetProcessResidentMemory()
+{
+	// Second field is the resident size in pages.
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (!file)
+		return 0;
+
+	unsigned long size = 0, resident = 0;
+	const bool ok = (fscanf(file, "%lu %lu", &size, &resident) == 2);
+	fclose(file);
+	return ok ? (static_cast<u64>(resident) * getpagesize()) : 0;
+}
+
 u64 GetAvailablePhysicalMemory()
 {
 	// Try to read MemAvailable from /proc/meminfo.
@@ -17,6 +17,7 @@ bool MemorySettingsInterface::Save(Error* error)
 
 void MemorySettingsInterface::Clear()
 {
+	BumpRevision();
 	m_sections.clear();
 }
 
@@ -187,6 +188,7 @@ std::vector<std::pair<std::string, std::string>> MemorySettingsInterface::GetKey
 
 void MemorySettingsInterface::SetKeyValueList(const char* section, const std::vector<std::pair<std::string, std::string>>& items)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	sit->second.clear();
 	for (const auto& [key, value] : items)
@@ -195,6 +197,7 @@ void MemorySettingsInterface::SetKeyValueList(const char* section, const std::ve
 
 void MemorySettingsInterface::SetValue(const char* section, const char* key, std::string value)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		sit = m_sections.emplace(std::make_pair(std::string(section), KeyMap())).first;
@@ -235,6 +238,7 @@ std::vector<std::string> MemorySettingsInterface::GetStringList(const char* sect
 
 void MemorySettingsInterface::SetStringList(const char* section, const char* key, const std::vector<std::string>& items)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		sit = m_sections.emplace(std::make_pair(std::string(section), KeyMap())).first;
@@ -250,6 +254,7 @@ void MemorySettingsInterface::SetStringList(const char* section, const char* key
 
 bool MemorySettingsInterface::RemoveFromStringList(const char* section, const char* key, const char* item)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		sit = m_sections.emplace(std::make_pair(std::string(section), KeyMap())).first;
@@ -274,6 +279,7 @@ bool MemorySettingsInterface::RemoveFromStringList(const char* section, const ch
 
 bool MemorySettingsInterface::AddToStringList(const char* section, const char* key, const char* item)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		sit = m_sections.emplace(std::make_pair(std::string(section), KeyMap())).first;
@@ -300,6 +306,7 @@ bool MemorySettingsInterface::ContainsValue(const char* section, const char* key
 
 void MemorySettingsInterface::DeleteValue(const char* section, const char* key)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		return;
@@ -311,6 +318,7 @@ void MemorySettingsInterface::DeleteValue(const char* section, const char* key)
 
 void MemorySettingsInterface::ClearSection(const char* section)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		return;
@@ -320,6 +328,7 @@ void MemorySettingsInterface::ClearSection(const char* section)
 
 void MemorySettingsInterface::RemoveSection(const char* section)
 {
+	BumpRevision();
 	auto sit = m_sections.find(section);
 	if (sit == m_sections.end())
 		return;
@@ -329,6 +338,7 @@ void MemorySettingsInterface::RemoveSection(const char* section)
 
 void MemorySettingsInterface::RemoveEmptySections()
 {
+	BumpRevision();
 	for (auto sit = m_sections.begin(); sit != m_sections.end();)
 	{
 		if (sit->second.size() > 0)
@@ -11,6 +11,7 @@
 #endif
 
 #include <array>
+#include <cstdlib>
 #include <cstring>
 
 #ifdef __linux__
@@ -40,11 +41,39 @@ namespace Perf
 	Group vif("VIF");
 
 // Perf is only supported on linux
-#if defined(__linux__) && defined(ProfileWithPerf)
+#ifdef __linux__
+	enum class LinuxMode : u8
+	{
+		None,
+		Map,
+		JitDump,
+	};
+
+	// PCSX2_PERF=map writes /tmp/perf-<pid>.map, PCSX2_PERF=jitdump writes jit-<pid>.dump
+	// including the code bytes, which `perf inject --jit` needs for annotation.
+	static LinuxMode GetLinuxMode()
+	{
+		static const LinuxMode mode = []() {
+			const char* env = std::getenv("PCSX2_PERF");
+			if (env && std::strcmp(env, "map") == 0)
+				return LinuxMode::Map;
+			else if (env && std::strcmp(env, "jitdump") == 0)
+				return LinuxMode::JitDump;
+#if defined(ProfileWithPerf)
+			return LinuxMode::Map;
+#elif defined(ProfileWithPerfJitDump)
+			return LinuxMode::JitDump;
+#else
+			return LinuxMode::None;
+#endif
+		}();
+		return mode;
+	}
+
 	static std::FILE* s_map_file = nullptr;
 	static bool s_map_file_opened = false;
 	static std::mutex s_mutex;
-	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+	static void RegisterPerfMap(const void* ptr, size_t size, const char* symbol)
 	{
 		std::unique_lock lock(s_mutex);
 
@@ -64,7 +93,7 @@ namespace Perf
 		std::fprintf(s_map_file, "%" PRIx64 " %zx %s\n", static_cast<u64>(reinterpret_cast<uintptr_t>(ptr)), size, symbol);
 		std::fflush(s_map_file);
 	}
-#elif defined(__linux__) && defined(ProfileWithPerfJitDump)
+
 	enum : u32
 	{
 		JIT_CODE_LOAD = 0,
@@ -117,22 +146,22 @@ namespace Perf
 	static std::mutex s_jitdump_mutex;
 	static u32 s_jitdump_record_id;
 
-	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+	static void RegisterJitDump(const void* ptr, size_t size, const char* symbol)
 	{
 		const u32 namelen = std::strlen(symbol) + 1;
 
 		std::unique_lock lock(s_jitdump_mutex);
 		if (!s_jitdump_file)
 		{
-			if (!s_jitdump_file_opened)
-			{
-				char file[256];
-				snprintf(file, std::size(file), "jit-%d.dump", getpid());
-				s_jitdump_file = fopen(file, "w+b");
-				s_jitdump_file_opened = true;
-				if (!s_jitdump_file)
-					return;
-			}
+			if (s_jitdump_file_opened)
+				return;
+
+			char file[256];
+			snprintf(file, std::size(file), "jit-%d.dump", getpid());
+			s_jitdump_file = fopen(file, "w+b");
+			s_jitdump_file_opened = true;
+			if (!s_jitdump_file)
+				return;
 
 			void* perf_marker = mmap(nullptr, 4096, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(s_jitdump_file), 0);
 			pxAssertRel(perf_marker != MAP_FAILED, "Map perf marker");
@@ -150,6 +179,8 @@ namespace Perf
 			std::fwrite(&jh, sizeof(jh), 1, s_jitdump_file);
 		}
 
+		// Code bytes are copied into the record, so blocks recompiled at the same address
+		// after a cache reset still annotate correctly, perf picks the newest load.
 		JITDUMP_CODE_LOAD cl = {};
 		cl.header.id = JIT_CODE_LOAD;
 		cl.header.total_size = sizeof(cl) + namelen + static_cast<u32>(size);
@@ -165,8 +196,16 @@ namespace Perf
 		std::fwrite(ptr, size, 1, s_jitdump_file);
 		std::fflush(s_jitdump_file);
 	}
-#elif defined(ENABLE_VTUNE)
-	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+#endif
+
+#ifdef ENABLE_VTUNE
+	static bool IsVTuneActive()
+	{
+		static const bool active = (iJIT_IsProfilingActive() == iJIT_SAMPLING_ON);
+		return active;
+	}
+
+	static void RegisterVTune(const void* ptr, size_t size, const char* symbol)
 	{
 		iJIT_Method_Load_V2 ml = {};
 		ml.method_id = iJIT_GetNewMethodID();
@@ -177,9 +216,45 @@ namespace Perf
 	}
 #endif
 
-#if (defined(__linux__) && (defined(ProfileWithPerf) || defined(ProfileWithPerfJitDump))) || defined(ENABLE_VTUNE)
+	bool IsEnabled()
+	{
+#ifdef __linux__
+		if (GetLinuxMode() != LinuxMode::None)
+			return true;
+#endif
+#ifdef ENABLE_VTUNE
+		if (IsVTuneActive())
+			return true;
+#endif
+		return false;
+	}
+
+	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+	{
+#ifdef __linux__
+		switch (GetLinuxMode())
+		{
+			case LinuxMode::Map:
+				RegisterPerfMap(ptr, size, symbol);
+				break;
+			case LinuxMode::JitDump:
+				RegisterJitDump(ptr, size, symbol);
+				break;
+			default:
+				break;
+		}
+#endif
+#ifdef ENABLE_VTUNE
+		if (IsVTuneActive())
+			RegisterVTune(ptr, size, symbol);
+#endif
+	}
+
 	void Group::Register(const void* ptr, size_t size, const char* symbol)
 	{
+		if (!IsEnabled())
+			return;
+
 		char full_symbol[128];
 		if (HasPrefix())
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%s", m_prefix, symbol);
@@ -188,18 +263,34 @@ namespace Perf
 		RegisterMethod(ptr, size, full_symbol);
 	}
 
-	void Group::RegisterPC(const void* ptr, size_t size, u32 pc)
+	void Group::RegisterPC(const void* ptr, size_t size, u32 pc, const char* function, u32 function_pc)
 	{
-		char full_symbol[128];
+		if (!IsEnabled())
+			return;
+
+		char full_symbol[192];
+		int len;
 		if (HasPrefix())
-			std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
+			len = std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
 		else
-			std::snprintf(full_symbol, std::size(full_symbol), "%08X", pc);
+			len = std::snprintf(full_symbol, std::size(full_symbol), "%08X", pc);
+
+		if (function && function[0] && len > 0 && static_cast<size_t>(len) < std::size(full_symbol))
+		{
+			if (pc != function_pc)
+				std::snprintf(full_symbol + len, std::size(full_symbol) - len, " %s+0x%X", function, pc - function_pc);
+			else
+				std::snprintf(full_symbol + len, std::size(full_symbol) - len, " %s", function);
+		}
+
 		RegisterMethod(ptr, size, full_symbol);
 	}
 
 	void Group::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key)
 	{
+		if (!IsEnabled())
+			return;
+
 		char full_symbol[128];
 		if (HasPrefix())
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%s%016" PRIX64, m_prefix, prefix, key);
@@ -207,9 +298,4 @@ namespace Perf
 			std::snprintf(full_symbol, std::size(full_symbol), "%s%016" PRIX64, prefix, key);
 		RegisterMethod(ptr, size, full_symbol);
 	}
-#else
-	void Group::Register(const void* ptr, size_t size, const char* symbol) {}
-	void Group::RegisterPC(const void* ptr, size_t size, u32 pc) {}
-	void Group::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key) {}
-#endif
 } // namespace Perf
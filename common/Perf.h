@@ -18,10 +18,14 @@ namespace Perf
 		bool HasPrefix() const { return (m_prefix && m_prefix[0]); }
 
 		void Register(const void* ptr, size_t size, const char* symbol);
-		void RegisterPC(const void* ptr, size_t size, u32 pc);
+		void RegisterPC(const void* ptr, size_t size, u32 pc, const char* function = nullptr, u32 function_pc = 0);
 		void RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key);
 	};
 
+	/// Returns true when a profiler backend is active, so callers can skip building symbol names.
+	/// On Linux the backend is chosen with the PCSX2_PERF environment variable ("map" or "jitdump").
+	bool IsEnabled();
+
 	extern Group any;
 	extern Group ee;
 	extern Group iop;
@@ -259,4 +259,13 @@ public:
 	{
 		SetKeyValueList(section, si.GetKeyValueList(section));
 	}
+
+	/// Changes whenever anything in the interface is modified, so lookups through it can be cached.
+	__fi u32 GetRevision() const { return m_revision; }
+
+protected:
+	__fi void BumpRevision() { m_revision++; }
+
+private:
+	u32 m_revision = 0;
 };
@@ -11,7 +11,9 @@
 #include <intrin.h>
 #endif
 
-#if defined(__AVX2__)
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+#define _M_SSE 0x601
+#elif defined(__AVX2__)
 #define _M_SSE 0x501
 #elif defined(__AVX__)
 #define _M_SSE 0x500
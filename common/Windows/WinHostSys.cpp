@@ -12,7 +12,10 @@
 
 #include "fmt/format.h"
 
+#include <psapi.h>
+
 #include <mutex>
+#include <vector>
 
 static DWORD ConvertToWinApi(const PageProtectionMode& mode)
 {
@@ -59,6 +62,41 @@ void HostSys::MemProtect(void* baseaddr, size_t size, const PageProtectionMode&
 		pxFail("VirtualProtect() failed");
 }
 
+bool HostSys::AdviseHugePages(void* baseaddr, size_t size, bool enable)
+{
+	// Large pages have to be requested when the memory is committed, and need SeLockMemoryPrivilege.
+	// Neither works for our reserved, sparsely committed mappings.
+	return false;
+}
+
+size_t HostSys::GetResidentSize(const void* baseaddr, size_t size)
+{
+	// Query in batches, the code area alone is tens of thousands of pages.
+	static constexpr size_t batch_pages = 4096;
+
+	const uptr start = reinterpret_cast<uptr>(baseaddr) & ~static_cast<uptr>(__pagemask);
+	const uptr end = Common::AlignUpPow2(reinterpret_cast<uptr>(baseaddr) + size, __pagesize);
+	std::vector<PSAPI_WORKING_SET_EX_INFORMATION> pages(std::min<size_t>((end - start) / __pagesize, batch_pages));
+
+	size_t resident = 0;
+	for (uptr addr = start; addr < end;)
+	{
+		const size_t count = std::min<size_t>((end - addr) / __pagesize, batch_pages);
+		for (size_t i = 0; i < count; i++)
+			pages[i].VirtualAddress = reinterpret_cast<void*>(addr + i * __pagesize);
+
+		if (!QueryWorkingSetEx(GetCurrentProcess(), pages.data(), static_cast<DWORD>(count * sizeof(pages[0]))))
+			return 0;
+
+		for (size_t i = 0; i < count; i++)
+			resident += pages[i].VirtualAttributes.Valid;
+
+		addr += count * __pagesize;
+	}
+
+	return resident * __pagesize;
+}
+
 std::string HostSys::GetFileMappingName(const char* prefix)
 {
 	const unsigned pid = GetCurrentProcessId();
@@ -10,6 +10,7 @@
 #include "common/WindowInfo.h"
 
 #include <mmsystem.h>
+#include <psapi.h>
 #include <timeapi.h>
 #include <VersionHelpers.h>
 
@@ -65,6 +66,15 @@ u64 GetAvailablePhysicalMemory()
 	return status.ullAvailPhys;
 }
 
+u64 GetProcessResidentMemory()
+{
+	PROCESS_MEMORY_COUNTERS counters = {};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+
+	return counters.WorkingSetSize;
+}
+
 // Calculates the Windows OS Version and processor architecture, and returns it as a
 // human-readable string. :)
 std::string GetOSVersionString()
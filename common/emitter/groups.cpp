@@ -71,7 +71,12 @@ namespace x86Emitter
 
 	void xImpl_Group1::operator()(const xRegisterInt& to, int imm) const
 	{
-		if (!to.Is8BitOp() && is_s8(imm))
+		if (InstType == G1Type_CMP && imm == 0)
+		{
+			// test reg, reg is a byte shorter and leaves ZF/SF/PF/CF/OF exactly as cmp reg, 0 would.
+			xOpWrite(to.GetPrefix16(), to.Is8BitOp() ? 0x84 : 0x85, to, to);
+		}
+		else if (!to.Is8BitOp() && is_s8(imm))
 		{
 			xOpWrite(to.GetPrefix16(), 0x83, InstType, to);
 			xWrite<s8>(imm);
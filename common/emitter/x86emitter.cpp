@@ -1117,14 +1117,32 @@ const xRegister32
 		xOpWrite(to.GetPrefix16(), to.Is8BitOp() ? 0x84 : 0x85, from, to);
 	}
 
+	// With bit 7 clear the mask only covers the low byte, so testing that byte alone sets identical
+	// flags (SF is zero either way) and drops the 16/32-bit immediate.
+	static __fi bool IsTestByteMask(int imm) { return imm >= 0 && imm < 0x80; }
+
 	void xImpl_Test::operator()(const xIndirect64orLess& dest, int imm) const
 	{
+		if (!dest.Is8BitOp() && IsTestByteMask(imm))
+		{
+			const xIndirect8 byte(dest);
+			xOpWrite(0, 0xf6, 0, byte, 1);
+			xWrite8(imm);
+			return;
+		}
+
 		xOpWrite(dest.GetPrefix16(), dest.Is8BitOp() ? 0xf6 : 0xf7, 0, dest, dest.GetImmSize());
 		dest.xWriteImm(imm);
 	}
 
 	void xImpl_Test::operator()(const xRegisterInt& to, int imm) const
 	{
+		if (!to.Is8BitOp() && IsTestByteMask(imm))
+		{
+			operator()(xRegister8(to), imm);
+			return;
+		}
+
 		if (to.IsAccumulator())
 		{
 			xOpAccWrite(to.GetPrefix16(), to.Is8BitOp() ? 0xa8 : 0xa9, 0, to);
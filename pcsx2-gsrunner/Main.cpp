@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -8,23 +9,37 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
+#include <vector>
 
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+extern char** environ;
 #endif
 
 #include "fmt/format.h"
+#include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/writer.h"
 
 #include "common/Assertions.h"
 #include "common/CocoaTools.h"
 #include "common/Console.h"
 #include "common/CrashHandler.h"
+#include "common/Error.h"
 #include "common/FileSystem.h"
 #include "common/MemorySettingsInterface.h"
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
 #include "common/SettingsWrapper.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "pcsx2/PrecompiledHeader.h"
 
@@ -43,6 +58,8 @@
 #include "pcsx2/MTGS.h"
 #include "pcsx2/SIO/Pad/Pad.h"
 #include "pcsx2/PerformanceMetrics.h"
+#include "pcsx2/Recording/InputRecording.h"
+#include "pcsx2/StateHash.h"
 #include "pcsx2/VMManager.h"
 
 #include "svnrev.h"
@@ -53,6 +70,11 @@ namespace GSRunner
 	static bool InitializeConfig();
 	static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params);
 	static void DumpStats();
+	static bool ReportBenchmark();
+	static bool ReportPerformance();
+	static bool StartInputRecording();
+	static bool ReportInputRecording();
+	static bool RunCorpus(int argc, char* argv[]);
 
 	static bool CreatePlatformWindow();
 	static void DestroyPlatformWindow();
@@ -71,6 +93,55 @@ static s32 s_loop_count = 1;
 static std::optional<bool> s_use_window;
 static bool s_no_console = false;
 
+static std::string s_benchmark_path;
+static std::string s_benchmark_baseline_path;
+static std::string s_benchmark_dump_name;
+static u32 s_benchmark_warmup_frames = 0;
+static double s_benchmark_threshold = 5.0;
+static bool s_benchmark_failed = false;
+
+static std::string s_corpus_dir;
+static std::string s_corpus_output_dir;
+static u32 s_corpus_jobs = 1;
+static std::vector<std::string> s_corpus_adapters;
+
+// Full system runs, booting a game instead of replaying a dump.
+static u32 s_run_frames = 0;
+static std::string s_perf_report_path;
+static std::string s_run_name;
+static std::string s_input_recording_path;
+static std::string s_input_recording_start_state;
+static u32 s_input_recording_checkpoints = 0;
+static std::string s_state_hash_path;
+
+struct PerformanceTotals
+{
+	u32 samples;
+	double speed;
+	double fps;
+	double internal_fps;
+	double ee_time; // milliseconds per frame, the IOP runs on the same thread
+	double ee_usage;
+	double gs_time;
+	double gs_usage;
+	double vu_time;
+	double vu_usage;
+};
+
+// Owned by the CPU thread.
+static PerformanceTotals s_perf_totals = {};
+static Common::Timer s_run_timer;
+
+struct BenchmarkFrame
+{
+	double gs_cpu_time; // milliseconds
+	double gpu_time; // milliseconds, zero if the device has no timestamp queries
+	u32 draws;
+	u32 uploads;
+	u32 readbacks;
+	u32 pipeline_misses;
+};
+
 // Owned by the GS thread.
 static u32 s_dump_frame_number = 0;
 static u32 s_loop_number = s_loop_count;
@@ -81,6 +152,7 @@ static double s_last_barriers = 0;
 static double s_last_copies = 0;
 static double s_last_uploads = 0;
 static double s_last_readbacks = 0;
+static double s_last_pipeline_misses = 0;
 static u64 s_total_internal_draws = 0;
 static u64 s_total_draws = 0;
 static u64 s_total_render_passes = 0;
@@ -88,8 +160,11 @@ static u64 s_total_barriers = 0;
 static u64 s_total_copies = 0;
 static u64 s_total_uploads = 0;
 static u64 s_total_readbacks = 0;
+static u64 s_total_pipeline_misses = 0;
 static u32 s_total_frames = 0;
 static u32 s_total_drawn_frames = 0;
+static u64 s_benchmark_last_gs_cpu_time = 0;
+static std::vector<BenchmarkFrame> s_benchmark_frames;
 
 bool GSRunner::InitializeConfig()
 {
@@ -274,6 +349,9 @@ void Host::BeginPresentFrame()
 	{
 		const u32 last_draws = s_total_internal_draws;
 		const u32 last_uploads = s_total_uploads;
+		const u64 last_draw_calls = s_total_draws;
+		const u64 last_readbacks = s_total_readbacks;
+		const u64 last_pipeline_misses = s_total_pipeline_misses;
 
 		static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last) {
 			// perfmon resets every 30 frames to zero
@@ -289,12 +367,32 @@ void Host::BeginPresentFrame()
 		update_stat(GSPerfMon::TextureCopies, s_total_copies, s_last_copies);
 		update_stat(GSPerfMon::TextureUploads, s_total_uploads, s_last_uploads);
 		update_stat(GSPerfMon::Readbacks, s_total_readbacks, s_last_readbacks);
+		update_stat(GSPerfMon::PipelineMisses, s_total_pipeline_misses, s_last_pipeline_misses);
 
 		const bool idle_frame = s_total_frames && (last_draws == s_total_internal_draws && last_uploads == s_total_uploads);
 
 		if (!idle_frame)
 			s_total_drawn_frames++;
 
+		if (!s_benchmark_path.empty())
+		{
+			// GPU time lags a frame behind, it's collected when the previous frame was presented.
+			const u64 gs_cpu_time = MTGS::GetThreadHandle().GetCPUTime();
+			if (!idle_frame && s_benchmark_last_gs_cpu_time != 0 && s_total_frames >= s_benchmark_warmup_frames)
+			{
+				s_benchmark_frames.push_back(BenchmarkFrame{
+					static_cast<double>(gs_cpu_time - s_benchmark_last_gs_cpu_time) * 1000.0 /
+						static_cast<double>(Threading::GetThreadTicksPerSecond()),
+					static_cast<double>(PerformanceMetrics::GetLastGPUTime()),
+					static_cast<u32>(s_total_draws - last_draw_calls),
+					static_cast<u32>(s_total_uploads - last_uploads),
+					static_cast<u32>(s_total_readbacks - last_readbacks),
+					static_cast<u32>(s_total_pipeline_misses - last_pipeline_misses),
+				});
+			}
+			s_benchmark_last_gs_cpu_time = gs_cpu_time;
+		}
+
 		s_total_frames++;
 
 		std::atomic_thread_fence(std::memory_order_release);
@@ -311,6 +409,7 @@ void Host::OnVMStarting()
 
 void Host::OnVMStarted()
 {
+	s_run_timer.Reset();
 }
 
 void Host::OnVMDestroyed()
@@ -332,6 +431,20 @@ void Host::OnGameChanged(const std::string& title, const std::string& elf_overri
 
 void Host::OnPerformanceMetricsUpdated()
 {
+	if (s_perf_report_path.empty())
+		return;
+
+	PerformanceTotals& totals = s_perf_totals;
+	totals.samples++;
+	totals.speed += PerformanceMetrics::GetSpeed();
+	totals.fps += PerformanceMetrics::GetFPS();
+	totals.internal_fps += PerformanceMetrics::GetInternalFPS();
+	totals.ee_time += PerformanceMetrics::GetCPUThreadAverageTime();
+	totals.ee_usage += PerformanceMetrics::GetCPUThreadUsage();
+	totals.gs_time += PerformanceMetrics::GetGSThreadAverageTime();
+	totals.gs_usage += PerformanceMetrics::GetGSThreadUsage();
+	totals.vu_time += PerformanceMetrics::GetVUThreadAverageTime();
+	totals.vu_usage += PerformanceMetrics::GetVUThreadUsage();
 }
 
 void Host::OnSaveStateLoading(const std::string_view filename)
@@ -488,6 +601,26 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -surfaceless: Disables showing a window.\n");
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
 	std::fprintf(stderr, "  -noshadercache: Disables the shader cache (useful for parallel runs).\n");
+	std::fprintf(stderr, "  -readonlyshadercache: Uses the shader cache without writing to it (safe for parallel runs).\n");
+	std::fprintf(stderr, "  -adapter <name>: Sets the GPU adapter. With -corpus, can be given several times to spread workers across GPUs.\n");
+	std::fprintf(stderr, "  -benchmark <filename>: Writes per-frame GS CPU/GPU time and HW counter percentiles to filename as JSON.\n");
+	std::fprintf(stderr, "  -warmup <frames>: Excludes the first N frames (including loops) from the benchmark. Defaults to 0.\n");
+	std::fprintf(stderr, "  -baseline <filename>: Compares the benchmark against a previous -benchmark file, failing on regressions.\n");
+	std::fprintf(stderr, "  -threshold <percent>: Regression threshold for -baseline comparisons. Defaults to 5.\n");
+	std::fprintf(stderr, "  -corpus <dir>: Runs every GS dump in dir in a separate worker process, instead of a single dump.\n"
+						 "    Requires -dumpdir, which receives a sub-directory per dump and a results journal. Dumps already\n"
+						 "    in the journal are skipped, so an interrupted run resumes where it left off. With -benchmark,\n"
+						 "    the filename is created in each dump's directory, and -baseline names a previous -dumpdir.\n");
+	std::fprintf(stderr, "  -parallel <count>: Number of worker processes for -corpus. Defaults to 1.\n");
+	std::fprintf(stderr, "  -frames <count>: Stops after N frames. Required when filename is a game instead of a GS dump.\n");
+	std::fprintf(stderr, "  -statefile <filename>: Loads a save state after booting the game.\n");
+	std::fprintf(stderr, "  -perfreport <filename>: Writes average speed and EE/IOP, GS and VU thread times to filename as JSON.\n");
+	std::fprintf(stderr, "  -cachedir <dir>: Uses a separate cache directory (for running several instances at once).\n");
+	std::fprintf(stderr, "  -memcarddir <dir>: Inserts a memory card from a separate directory in slot 1.\n");
+	std::fprintf(stderr, "  -inputrec <filename>: Replays an input recording, stopping at its end. Fails if the replay desyncs.\n");
+	std::fprintf(stderr, "  -inputrecstart <filename>: Resumes -inputrec from a checkpoint state, for replaying a single segment.\n");
+	std::fprintf(stderr, "  -checkpoints <frames>: Saves a checkpoint state next to the -inputrec file every N frames.\n");
+	std::fprintf(stderr, "  -statehash <filename>: Writes hashes of memory and registers for every frame to filename, for diffing runs.\n");
 	std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
 						 "    parameters make up the filename. Use when the filename contains\n"
 						 "    spaces or starts with a dash.\n");
@@ -655,6 +788,8 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 #endif
 				else if (StringUtil::Strcasecmp(rname, "sw") == 0)
 					type = GSRendererType::SW;
+				else if (StringUtil::Strcasecmp(rname, "null") == 0)
+					type = GSRendererType::Null;
 				else
 				{
 					Console.Error("Unknown renderer '%s'", rname);
@@ -731,7 +866,190 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 			else if (CHECK_ARG("-noshadercache"))
 			{
 				Console.WriteLn("Disabling shader cache");
-				s_settings_interface.SetBoolValue("EmuCore/GS", "disable_shader_cache", true);
+				s_settings_interface.SetBoolValue("EmuCore/GS", "DisableShaderCache", true);
+				continue;
+			}
+			else if (CHECK_ARG("-readonlyshadercache"))
+			{
+				Console.WriteLn("Using read-only shader cache");
+				s_settings_interface.SetBoolValue("EmuCore/GS", "ReadOnlyShaderCache", true);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-adapter"))
+			{
+				const char* adapter = argv[++i];
+				Console.WriteLn("Using adapter '%s'.", adapter);
+				s_settings_interface.SetStringValue("EmuCore/GS", "Adapter", adapter);
+				s_corpus_adapters.emplace_back(adapter);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-corpus"))
+			{
+				s_corpus_dir = StringUtil::StripWhitespace(argv[++i]);
+				if (!FileSystem::DirectoryExists(s_corpus_dir.c_str()))
+				{
+					Console.Error("Corpus directory '%s' does not exist.", s_corpus_dir.c_str());
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-parallel"))
+			{
+				s_corpus_jobs = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+				if (s_corpus_jobs == 0)
+				{
+					Console.Error("Invalid number of parallel workers.");
+					return false;
+				}
+#ifdef _WIN32
+				// WaitForMultipleObjects() limit.
+				s_corpus_jobs = std::min<u32>(s_corpus_jobs, MAXIMUM_WAIT_OBJECTS);
+#endif
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-benchmark"))
+			{
+				s_benchmark_path = StringUtil::StripWhitespace(argv[++i]);
+				if (s_benchmark_path.empty())
+				{
+					Console.Error("Invalid benchmark output file specified.");
+					return false;
+				}
+
+				// GPU time is only collected when it's enabled for the OSD.
+				s_settings_interface.SetBoolValue("EmuCore/GS", "OsdShowGPU", true);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-warmup"))
+			{
+				s_benchmark_warmup_frames = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+				Console.WriteLn("Excluding %u warmup frames from benchmark.", s_benchmark_warmup_frames);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-baseline"))
+			{
+				s_benchmark_baseline_path = StringUtil::StripWhitespace(argv[++i]);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-threshold"))
+			{
+				const std::optional<double> threshold = StringUtil::FromChars<double>(argv[++i]);
+				if (!threshold.has_value() || threshold.value() < 0.0)
+				{
+					Console.Error("Invalid regression threshold specified.");
+					return false;
+				}
+
+				s_benchmark_threshold = threshold.value();
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-frames"))
+			{
+				s_run_frames = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+				if (s_run_frames == 0)
+				{
+					Console.Error("Invalid number of frames.");
+					return false;
+				}
+
+				Console.WriteLn("Stopping after %u frames.", s_run_frames);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-statefile"))
+			{
+				params.save_state = StringUtil::StripWhitespace(argv[++i]);
+				if (!FileSystem::FileExists(params.save_state.c_str()))
+				{
+					Console.Error("Save state '%s' does not exist.", params.save_state.c_str());
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-perfreport"))
+			{
+				s_perf_report_path = StringUtil::StripWhitespace(argv[++i]);
+				if (s_perf_report_path.empty())
+				{
+					Console.Error("Invalid performance report file specified.");
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-cachedir"))
+			{
+				// Absolute, so the directory is used as-is instead of relative to the data directory.
+				const std::string dir = Path::RealPath(StringUtil::StripWhitespace(argv[++i]));
+				if (!FileSystem::DirectoryExists(dir.c_str()) && !FileSystem::CreateDirectoryPath(dir.c_str(), false))
+				{
+					Console.Error("Failed to create cache directory");
+					return false;
+				}
+
+				s_settings_interface.SetStringValue("Folders", "Cache", dir.c_str());
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-memcarddir"))
+			{
+				const std::string dir = Path::RealPath(StringUtil::StripWhitespace(argv[++i]));
+				if (!FileSystem::DirectoryExists(dir.c_str()) && !FileSystem::CreateDirectoryPath(dir.c_str(), false))
+				{
+					Console.Error("Failed to create memory card directory");
+					return false;
+				}
+
+				// Private to this instance, so it's safe to have a card inserted.
+				s_settings_interface.SetStringValue("Folders", "MemoryCards", dir.c_str());
+				s_settings_interface.SetBoolValue("MemoryCards", "Slot1_Enable", true);
+				s_settings_interface.SetStringValue("MemoryCards", "Slot1_Filename", "Mcd001.ps2");
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-inputrec"))
+			{
+				s_input_recording_path = StringUtil::StripWhitespace(argv[++i]);
+				if (!FileSystem::FileExists(s_input_recording_path.c_str()))
+				{
+					Console.Error("Input recording '%s' does not exist.", s_input_recording_path.c_str());
+					return false;
+				}
+
+				s_settings_interface.SetBoolValue("EmuCore", "EnableRecordingTools", true);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-inputrecstart"))
+			{
+				s_input_recording_start_state = StringUtil::StripWhitespace(argv[++i]);
+				if (!FileSystem::FileExists(s_input_recording_start_state.c_str()))
+				{
+					Console.Error("Checkpoint state '%s' does not exist.", s_input_recording_start_state.c_str());
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-statehash"))
+			{
+				s_state_hash_path = StringUtil::StripWhitespace(argv[++i]);
+				if (s_state_hash_path.empty())
+				{
+					Console.Error("Invalid state hash file specified.");
+					return false;
+				}
+
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-checkpoints"))
+			{
+				s_input_recording_checkpoints = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+				if (s_input_recording_checkpoints == 0)
+				{
+					Console.Error("Invalid checkpoint interval.");
+					return false;
+				}
+
 				continue;
 			}
 			else if (CHECK_ARG("-window"))
@@ -766,6 +1084,28 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 		params.filename += argv[i];
 	}
 
+	if (!s_corpus_dir.empty())
+	{
+		if (!params.filename.empty())
+		{
+			Console.Error("-corpus can't be combined with a dump filename.");
+			return false;
+		}
+		if (dumpdir.empty())
+		{
+			Console.Error("-corpus requires -dumpdir.");
+			return false;
+		}
+		if (!s_benchmark_baseline_path.empty() && s_benchmark_path.empty())
+		{
+			Console.Error("-baseline requires -benchmark.");
+			return false;
+		}
+
+		s_corpus_output_dir = std::move(dumpdir);
+		return true;
+	}
+
 	if (params.filename.empty())
 	{
 		Console.Error("No dump filename provided.");
@@ -774,10 +1114,36 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 
 	if (!VMManager::IsGSDumpFileName(params.filename))
 	{
-		Console.Error("Provided filename is not a GS dump.");
+		// Anything else is booted as a game, which never ends on its own.
+		if (s_run_frames == 0)
+		{
+			Console.Error("Provided filename is not a GS dump, -frames is required to boot a game.");
+			return false;
+		}
+
+		// Keep runs comparable, games are seeded from the clock.
+		s_settings_interface.SetBoolValue("EmuCore", "ManuallySetRealTimeClock", true);
+	}
+	else if (!params.save_state.empty())
+	{
+		Console.Error("-statefile can't be used with a GS dump.");
 		return false;
 	}
 
+	s_run_name = Path::GetFileName(params.filename);
+
+	// pick up -cachedir and -memcarddir
+	VMManager::Internal::UpdateEmuFolders();
+
+	if (!s_benchmark_baseline_path.empty() && s_benchmark_path.empty())
+	{
+		Console.Error("-baseline requires -benchmark.");
+		return false;
+	}
+
+	if (!s_benchmark_path.empty())
+		s_benchmark_dump_name = Path::GetFileName(params.filename);
+
 	if (s_settings_interface.GetBoolValue("EmuCore/GS", "DumpGSData") && !dumpdir.empty())
 	{
 		if (s_settings_interface.GetStringValue("EmuCore/GS", "HWDumpDirectory").empty())
@@ -815,7 +1181,676 @@ void GSRunner::DumpStats()
 	Console.WriteLn(fmt::format("@HWSTAT@ Copies: {} (avg {})", s_total_copies, static_cast<u64>(std::ceil(s_total_copies / static_cast<double>(s_total_drawn_frames)))));
 	Console.WriteLn(fmt::format("@HWSTAT@ Uploads: {} (avg {})", s_total_uploads, static_cast<u64>(std::ceil(s_total_uploads / static_cast<double>(s_total_drawn_frames)))));
 	Console.WriteLn(fmt::format("@HWSTAT@ Readbacks: {} (avg {})", s_total_readbacks, static_cast<u64>(std::ceil(s_total_readbacks / static_cast<double>(s_total_drawn_frames)))));
+	Console.WriteLn(fmt::format("@HWSTAT@ Pipeline Misses: {} (avg {})", s_total_pipeline_misses, static_cast<u64>(std::ceil(s_total_pipeline_misses / static_cast<double>(s_total_drawn_frames)))));
+	Console.WriteLn("============================================");
+}
+
+bool GSRunner::ReportBenchmark()
+{
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (s_benchmark_frames.empty())
+	{
+		Console.Error("No frames were recorded for the benchmark, the dump may be shorter than the warmup.");
+		return false;
+	}
+
+	struct Metric
+	{
+		const char* name;
+		double BenchmarkFrame::*double_field;
+		u32 BenchmarkFrame::*u32_field;
+	};
+	static constexpr Metric metrics[] = {
+		{"gs_cpu_ms", &BenchmarkFrame::gs_cpu_time, nullptr},
+		{"gpu_ms", &BenchmarkFrame::gpu_time, nullptr},
+		{"draws", nullptr, &BenchmarkFrame::draws},
+		{"uploads", nullptr, &BenchmarkFrame::uploads},
+		{"readbacks", nullptr, &BenchmarkFrame::readbacks},
+		{"pipeline_misses", nullptr, &BenchmarkFrame::pipeline_misses},
+	};
+	static constexpr std::pair<const char*, double> percentiles[] = {
+		{"p50", 50.0}, {"p90", 90.0}, {"p95", 95.0}, {"p99", 99.0}};
+
+	rapidjson::Document json(rapidjson::kObjectType);
+	rapidjson::Document::AllocatorType& allocator = json.GetAllocator();
+	const char* renderer = Pcsx2Config::GSOptions::GetRendererName(GSGetCurrentRenderer());
+	json.AddMember("dump", rapidjson::Value().SetString(s_benchmark_dump_name.c_str(), s_benchmark_dump_name.size(), allocator), allocator);
+	json.AddMember("renderer", rapidjson::Value().SetString(renderer, std::strlen(renderer), allocator), allocator);
+	json.AddMember("frames", static_cast<u64>(s_benchmark_frames.size()), allocator);
+	json.AddMember("warmup_frames", s_benchmark_warmup_frames, allocator);
+
+	Console.WriteLn(fmt::format("======= BENCHMARK FOR {} FRAMES ========", s_benchmark_frames.size()));
+
+	rapidjson::Value json_metrics(rapidjson::kObjectType);
+	std::vector<double> values(s_benchmark_frames.size());
+	for (const Metric& metric : metrics)
+	{
+		double total = 0.0;
+		for (size_t i = 0; i < s_benchmark_frames.size(); i++)
+		{
+			const BenchmarkFrame& frame = s_benchmark_frames[i];
+			values[i] = metric.double_field ? frame.*metric.double_field : static_cast<double>(frame.*metric.u32_field);
+			total += values[i];
+		}
+		std::sort(values.begin(), values.end());
+
+		rapidjson::Value json_metric(rapidjson::kObjectType);
+		json_metric.AddMember("mean", total / static_cast<double>(values.size()), allocator);
+		json_metric.AddMember("min", values.front(), allocator);
+		json_metric.AddMember("max", values.back(), allocator);
+		json_metric.AddMember("total", total, allocator);
+
+		std::string line = fmt::format("@BENCH@ {}: mean {:.3f}", metric.name, total / static_cast<double>(values.size()));
+		for (const auto& [pname, pct] : percentiles)
+		{
+			// nearest-rank percentile
+			const size_t rank = static_cast<size_t>(std::ceil(pct / 100.0 * static_cast<double>(values.size())));
+			const double value = values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+			json_metric.AddMember(rapidjson::StringRef(pname), value, allocator);
+			line += fmt::format(" {} {:.3f}", pname, value);
+		}
+		Console.WriteLn(line);
+
+		json_metrics.AddMember(rapidjson::StringRef(metric.name), json_metric, allocator);
+	}
+	json.AddMember("metrics", json_metrics, allocator);
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+	json.Accept(writer);
+	if (!FileSystem::WriteStringToFile(s_benchmark_path.c_str(), std::string_view(buffer.GetString(), buffer.GetSize())))
+	{
+		Console.Error(fmt::format("Failed to write benchmark results to {}", s_benchmark_path));
+		return false;
+	}
+
+	bool okay = true;
+	if (!s_benchmark_baseline_path.empty())
+	{
+		const std::optional<std::string> baseline_data = FileSystem::ReadFileToString(s_benchmark_baseline_path.c_str());
+		rapidjson::Document baseline;
+		if (!baseline_data.has_value() || baseline.Parse(baseline_data->c_str(), baseline_data->size()).HasParseError() ||
+			!baseline.IsObject() || !baseline.HasMember("metrics") || !baseline["metrics"].IsObject())
+		{
+			Console.Error(fmt::format("Failed to read benchmark baseline {}", s_benchmark_baseline_path));
+			return false;
+		}
+
+		// Compare the median and the tail, means hide stutter and maxima are too noisy.
+		static constexpr const char* compared[] = {"p50", "p95"};
+		const rapidjson::Value& baseline_metrics = baseline["metrics"];
+		const rapidjson::Value& current_metrics = json["metrics"];
+		for (const Metric& metric : metrics)
+		{
+			if (!baseline_metrics.HasMember(metric.name) || !baseline_metrics[metric.name].IsObject())
+				continue;
+
+			const rapidjson::Value& base = baseline_metrics[metric.name];
+			const rapidjson::Value& cur = current_metrics[metric.name];
+			for (const char* stat : compared)
+			{
+				if (!base.HasMember(stat) || !base[stat].IsNumber())
+					continue;
+
+				const double base_value = base[stat].GetDouble();
+				const double cur_value = cur[stat].GetDouble();
+				const double limit = base_value * (1.0 + s_benchmark_threshold / 100.0);
+
+				// Ignore differences below timer/counter resolution, otherwise idle metrics flip-flop.
+				if (cur_value > limit && (cur_value - base_value) > 0.01)
+				{
+					Console.Error(fmt::format("@BENCH@ REGRESSION {} {}: {:.3f} -> {:.3f} (+{:.1f}%, threshold {:.1f}%)",
+						metric.name, stat, base_value, cur_value,
+						(base_value > 0.0) ? ((cur_value / base_value) - 1.0) * 100.0 : 100.0, s_benchmark_threshold));
+					okay = false;
+				}
+			}
+		}
+
+		if (okay)
+			Console.WriteLn(fmt::format("@BENCH@ No regressions against {}", s_benchmark_baseline_path));
+	}
+
 	Console.WriteLn("============================================");
+	return okay;
+}
+
+bool GSRunner::StartInputRecording()
+{
+	if (!g_InputRecording.play(s_input_recording_path))
+	{
+		Console.Error("Failed to start input recording '%s'.", s_input_recording_path.c_str());
+		return false;
+	}
+
+	// The frame counter follows the state, so the replay picks up at the checkpoint's frame.
+	if (!s_input_recording_start_state.empty() && !VMManager::LoadState(s_input_recording_start_state.c_str()))
+	{
+		Console.Error("Failed to load checkpoint state '%s'.", s_input_recording_start_state.c_str());
+		g_InputRecording.stop();
+		return false;
+	}
+
+	g_InputRecording.setCheckpointInterval(s_input_recording_checkpoints);
+	return true;
+}
+
+bool GSRunner::ReportInputRecording()
+{
+	const u32 frame = g_InputRecording.getFrameCounter();
+	const std::optional<u32> desync = g_InputRecording.getFirstDesyncFrame();
+	g_InputRecording.stop();
+
+	if (desync.has_value())
+	{
+		Console.Error(fmt::format("@INPUTREC@ Replay desynced at frame {}, stopped at frame {}.", desync.value(), frame));
+		return false;
+	}
+
+	Console.WriteLn(fmt::format("@INPUTREC@ Replay matched up to frame {}.", frame));
+	return true;
+}
+
+bool GSRunner::ReportPerformance()
+{
+	const PerformanceTotals& totals = s_perf_totals;
+	const double elapsed = s_run_timer.GetTimeSeconds();
+	const u64 frames = PerformanceMetrics::GetFrameNumber();
+	if (totals.samples == 0 || elapsed <= 0.0)
+	{
+		Console.Error("No performance samples were collected, the run was too short.");
+		return false;
+	}
+
+	const double divider = 1.0 / static_cast<double>(totals.samples);
+	const char* renderer = Pcsx2Config::GSOptions::GetRendererName(GSGetCurrentRenderer());
+
+	rapidjson::Document json(rapidjson::kObjectType);
+	rapidjson::Document::AllocatorType& allocator = json.GetAllocator();
+	json.AddMember("game", rapidjson::Value().SetString(s_run_name.c_str(), s_run_name.size(), allocator), allocator);
+	json.AddMember("renderer", rapidjson::Value().SetString(renderer, std::strlen(renderer), allocator), allocator);
+	json.AddMember("frames", frames, allocator);
+	json.AddMember("elapsed_s", elapsed, allocator);
+	json.AddMember("frames_per_second", static_cast<double>(frames) / elapsed, allocator);
+	json.AddMember("speed", totals.speed * divider, allocator);
+	json.AddMember("fps", totals.fps * divider, allocator);
+	json.AddMember("internal_fps", totals.internal_fps * divider, allocator);
+
+	static constexpr auto add_thread = [](rapidjson::Value& dst, const char* name, double time, double usage,
+										   rapidjson::Document::AllocatorType& allocator) {
+		rapidjson::Value thread(rapidjson::kObjectType);
+		thread.AddMember("ms_per_frame", time, allocator);
+		thread.AddMember("usage", usage, allocator);
+		dst.AddMember(rapidjson::StringRef(name), thread, allocator);
+	};
+
+	// The IOP is interpreted/recompiled on the EE thread, so its time is included in the EE's.
+	rapidjson::Value threads(rapidjson::kObjectType);
+	add_thread(threads, "ee_iop", totals.ee_time * divider, totals.ee_usage * divider, allocator);
+	add_thread(threads, "gs", totals.gs_time * divider, totals.gs_usage * divider, allocator);
+	add_thread(threads, "vu", totals.vu_time * divider, totals.vu_usage * divider, allocator);
+	json.AddMember("threads", threads, allocator);
+
+	Console.WriteLn(fmt::format("@PERF@ {} frames in {:.2f}s ({:.2f} fps), EE/IOP {:.3f}ms GS {:.3f}ms VU {:.3f}ms",
+		frames, elapsed, static_cast<double>(frames) / elapsed, totals.ee_time * divider, totals.gs_time * divider,
+		totals.vu_time * divider));
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+	json.Accept(writer);
+	if (!FileSystem::WriteStringToFile(s_perf_report_path.c_str(), std::string_view(buffer.GetString(), buffer.GetSize())))
+	{
+		Console.Error(fmt::format("Failed to write performance report to {}", s_perf_report_path));
+		return false;
+	}
+
+	return true;
+}
+
+namespace GSRunner
+{
+	struct CorpusWorker
+	{
+#ifdef _WIN32
+		HANDLE process = NULL;
+#else
+		pid_t pid = 0;
+#endif
+		size_t dump_index = 0;
+		u32 slot = 0;
+		Common::Timer timer;
+	};
+
+	static std::string GetCorpusDumpTitle(std::string_view filename);
+	static std::unordered_set<std::string> ReadCorpusJournal(const std::string& path);
+	static std::vector<std::string> GetCorpusWorkerArgs(
+		int argc, char* argv[], const std::string& dump_name, u32 slot, bool read_only_shader_cache);
+	static u64 GetCorpusWorkerAffinity(u32 slot);
+	static bool SpawnCorpusWorker(const std::vector<std::string>& args, u32 slot, CorpusWorker* worker);
+	static bool WaitForCorpusWorker(std::vector<CorpusWorker>& workers, size_t* index, s64* exit_code, bool* crashed);
+} // namespace GSRunner
+
+std::string GSRunner::GetCorpusDumpTitle(std::string_view filename)
+{
+	// strip off all extensions, same as the frame dump prefix
+	std::string_view title(Path::GetFileTitle(filename));
+	if (StringUtil::EndsWithNoCase(title, ".gs"))
+		title = Path::GetFileTitle(title);
+
+	return std::string(StringUtil::StripWhitespace(title));
+}
+
+std::unordered_set<std::string> GSRunner::ReadCorpusJournal(const std::string& path)
+{
+	std::unordered_set<std::string> completed;
+
+	const std::optional<std::string> data = FileSystem::ReadFileToString(path.c_str());
+	if (!data.has_value())
+		return completed;
+
+	// One object per line. A torn last line from a killed run won't parse, so it just gets rerun.
+	for (const std::string_view line : StringUtil::SplitString(data.value(), '\n'))
+	{
+		rapidjson::Document doc;
+		if (doc.Parse(line.data(), line.size()).HasParseError() || !doc.IsObject())
+			continue;
+
+		const auto it = doc.FindMember("dump");
+		if (it != doc.MemberEnd() && it->value.IsString())
+			completed.emplace(it->value.GetString(), it->value.GetStringLength());
+	}
+
+	return completed;
+}
+
+std::vector<std::string> GSRunner::GetCorpusWorkerArgs(
+	int argc, char* argv[], const std::string& dump_name, u32 slot, bool read_only_shader_cache)
+{
+	// Options which only make sense for the corpus runner, or are replaced per-worker.
+	static constexpr const char* local_params[] = {
+		"-corpus", "-parallel", "-adapter", "-dumpdir", "-logfile", "-benchmark", "-baseline"};
+	static constexpr const char* local_flags[] = {"-window", "-surfaceless", "-readonlyshadercache"};
+
+	std::vector<std::string> args;
+	args.push_back(FileSystem::GetProgramPath());
+
+	for (int i = 1; i < argc && std::strcmp(argv[i], "--") != 0; i++)
+	{
+		if (std::any_of(std::begin(local_params), std::end(local_params),
+				[arg = argv[i]](const char* param) { return std::strcmp(arg, param) == 0; }))
+		{
+			i++;
+			continue;
+		}
+		if (std::any_of(std::begin(local_flags), std::end(local_flags),
+				[arg = argv[i]](const char* flag) { return std::strcmp(arg, flag) == 0; }))
+		{
+			continue;
+		}
+
+		args.emplace_back(argv[i]);
+	}
+
+	const std::string title = GetCorpusDumpTitle(dump_name);
+	const std::string output_dir = Path::Combine(s_corpus_output_dir, title);
+	args.emplace_back("-dumpdir");
+	args.push_back(output_dir);
+	args.emplace_back("-logfile");
+	args.push_back(Path::Combine(output_dir, "emulog.txt"));
+
+	if (!s_corpus_adapters.empty())
+	{
+		args.emplace_back("-adapter");
+		args.push_back(s_corpus_adapters[slot % s_corpus_adapters.size()]);
+	}
+
+	if (!s_benchmark_path.empty())
+	{
+		const std::string_view benchmark_name = Path::GetFileName(s_benchmark_path);
+		args.emplace_back("-benchmark");
+		args.push_back(Path::Combine(output_dir, benchmark_name));
+
+		if (!s_benchmark_baseline_path.empty())
+		{
+			std::string baseline = Path::Combine(Path::Combine(s_benchmark_baseline_path, title), benchmark_name);
+			if (FileSystem::FileExists(baseline.c_str()))
+			{
+				args.emplace_back("-baseline");
+				args.push_back(std::move(baseline));
+			}
+		}
+	}
+
+	if (read_only_shader_cache)
+		args.emplace_back("-readonlyshadercache");
+
+	// we don't want tons of windows popping up
+	args.emplace_back("-surfaceless");
+	args.emplace_back("--");
+	args.push_back(Path::Combine(s_corpus_dir, dump_name));
+	return args;
+}
+
+u64 GSRunner::GetCorpusWorkerAffinity(u32 slot)
+{
+	// Give each worker its own contiguous block of cores, so the GS/SW threads of neighbours don't migrate onto it.
+	const u32 num_cpus = std::min(std::thread::hardware_concurrency(), 64u);
+	if (s_corpus_jobs <= 1 || num_cpus < s_corpus_jobs)
+		return 0;
+
+	const u32 cpus_per_worker = num_cpus / s_corpus_jobs;
+	const u64 mask = (cpus_per_worker >= 64) ? ~static_cast<u64>(0) : ((static_cast<u64>(1) << cpus_per_worker) - 1);
+	return mask << (slot * cpus_per_worker);
+}
+
+#ifdef _WIN32
+
+bool GSRunner::SpawnCorpusWorker(const std::vector<std::string>& args, u32 slot, CorpusWorker* worker)
+{
+	// Quoted per the CommandLineToArgvW() rules, backslashes only need escaping when they precede a quote.
+	std::wstring cmdline;
+	for (const std::string& arg : args)
+	{
+		if (!cmdline.empty())
+			cmdline += L' ';
+
+		cmdline += L'"';
+		size_t backslashes = 0;
+		for (const wchar_t ch : StringUtil::UTF8StringToWideString(arg))
+		{
+			if (ch == L'\\')
+			{
+				backslashes++;
+			}
+			else
+			{
+				if (ch == L'"')
+					cmdline.append(backslashes + 1, L'\\');
+				backslashes = 0;
+			}
+
+			cmdline += ch;
+		}
+		cmdline.append(backslashes, L'\\');
+		cmdline += L'"';
+	}
+
+	const std::wstring program = StringUtil::UTF8StringToWideString(args.front());
+	STARTUPINFOW si = {};
+	si.cb = sizeof(si);
+	PROCESS_INFORMATION pi = {};
+
+	// Started suspended so the affinity is in place before any of the worker's threads exist.
+	if (!CreateProcessW(program.c_str(), cmdline.data(), nullptr, nullptr, FALSE,
+			CREATE_SUSPENDED | CREATE_NO_WINDOW | BELOW_NORMAL_PRIORITY_CLASS, nullptr, nullptr, &si, &pi))
+	{
+		Console.Error("CreateProcessW() failed: %u", GetLastError());
+		return false;
+	}
+
+	const u64 affinity = GetCorpusWorkerAffinity(slot);
+	if (affinity != 0 && !SetProcessAffinityMask(pi.hProcess, static_cast<DWORD_PTR>(affinity)))
+		Console.Warning("SetProcessAffinityMask() failed: %u", GetLastError());
+
+	ResumeThread(pi.hThread);
+	CloseHandle(pi.hThread);
+	worker->process = pi.hProcess;
+	return true;
+}
+
+bool GSRunner::WaitForCorpusWorker(std::vector<CorpusWorker>& workers, size_t* index, s64* exit_code, bool* crashed)
+{
+	std::vector<HANDLE> handles;
+	handles.reserve(workers.size());
+	for (const CorpusWorker& worker : workers)
+		handles.push_back(worker.process);
+
+	const DWORD res = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+	if (res < WAIT_OBJECT_0 || res >= (WAIT_OBJECT_0 + handles.size()))
+	{
+		Console.Error("WaitForMultipleObjects() failed: %u", GetLastError());
+		return false;
+	}
+
+	*index = res - WAIT_OBJECT_0;
+
+	DWORD code = 0;
+	GetExitCodeProcess(handles[*index], &code);
+	CloseHandle(handles[*index]);
+	workers[*index].process = NULL;
+
+	// Unhandled exceptions exit with the NTSTATUS, e.g. 0xC0000005 for access violations.
+	*exit_code = static_cast<s64>(code);
+	*crashed = (code >= 0xC0000000u);
+	return true;
+}
+
+#else
+
+bool GSRunner::SpawnCorpusWorker(const std::vector<std::string>& args, u32 slot, CorpusWorker* worker)
+{
+	std::vector<char*> argv;
+	argv.reserve(args.size() + 1);
+	for (const std::string& arg : args)
+		argv.push_back(const_cast<char*>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+	posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+	posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+	pid_t pid;
+	const int res = posix_spawn(&pid, args.front().c_str(), &actions, nullptr, argv.data(), environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (res != 0)
+	{
+		Console.Error("posix_spawn() failed: %s", std::strerror(res));
+		return false;
+	}
+
+	// posix_spawn() can't do either of these up front, but the worker is still loading at this point,
+	// so its threads will inherit them from the main thread.
+	setpriority(PRIO_PROCESS, pid, 10);
+
+#ifdef __linux__
+	if (const u64 affinity = GetCorpusWorkerAffinity(slot); affinity != 0)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (u32 cpu = 0; cpu < 64; cpu++)
+		{
+			if (affinity & (static_cast<u64>(1) << cpu))
+				CPU_SET(cpu, &set);
+		}
+
+		if (sched_setaffinity(pid, sizeof(set), &set) != 0)
+			Console.Warning("sched_setaffinity() failed: %s", std::strerror(errno));
+	}
+#endif
+
+	// macOS has no way of pinning threads to cores, the scheduler will have to do.
+
+	worker->pid = pid;
+	return true;
+}
+
+bool GSRunner::WaitForCorpusWorker(std::vector<CorpusWorker>& workers, size_t* index, s64* exit_code, bool* crashed)
+{
+	for (;;)
+	{
+		int status;
+		const pid_t pid = waitpid(-1, &status, 0);
+		if (pid < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			Console.Error("waitpid() failed: %s", std::strerror(errno));
+			return false;
+		}
+
+		const auto it = std::find_if(
+			workers.begin(), workers.end(), [pid](const CorpusWorker& worker) { return worker.pid == pid; });
+		if (it == workers.end() || (!WIFEXITED(status) && !WIFSIGNALED(status)))
+			continue;
+
+		*index = static_cast<size_t>(it - workers.begin());
+
+		// Same convention as the shell for processes killed by signals.
+		*crashed = WIFSIGNALED(status);
+		*exit_code = *crashed ? (128 + WTERMSIG(status)) : WEXITSTATUS(status);
+		it->pid = 0;
+		return true;
+	}
+}
+
+#endif
+
+bool GSRunner::RunCorpus(int argc, char* argv[])
+{
+	FileSystem::FindResultsArray results;
+	FileSystem::FindFiles(s_corpus_dir.c_str(), "*",
+		FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RELATIVE_PATHS |
+			FILESYSTEM_FIND_SORT_BY_NAME,
+		&results);
+
+	std::vector<std::string> dumps;
+	for (FILESYSTEM_FIND_DATA& fd : results)
+	{
+		if (VMManager::IsGSDumpFileName(fd.FileName))
+			dumps.push_back(std::move(fd.FileName));
+	}
+	if (dumps.empty())
+	{
+		Console.Error("No GS dumps found in '%s'.", s_corpus_dir.c_str());
+		return false;
+	}
+
+	// Anything already in the journal finished (or crashed) in a previous run, so it isn't retried.
+	const std::string journal_path = Path::Combine(s_corpus_output_dir, "corpus_results.jsonl");
+	const std::unordered_set<std::string> completed = ReadCorpusJournal(journal_path);
+	std::vector<size_t> pending;
+	for (size_t i = 0; i < dumps.size(); i++)
+	{
+		if (completed.find(dumps[i]) == completed.end())
+			pending.push_back(i);
+	}
+
+	Console.WriteLn(fmt::format("Found {} GS dumps, {} already completed, running {} on {} worker processes.",
+		dumps.size(), dumps.size() - pending.size(), pending.size(), s_corpus_jobs));
+
+	auto journal = FileSystem::OpenManagedCFile(journal_path.c_str(), "ab");
+	if (!journal)
+	{
+		Console.Error("Failed to open results journal '%s'.", journal_path.c_str());
+		return false;
+	}
+
+	// Workers can't all write to the shader cache at once. So the first dump runs by itself to warm it up,
+	// and everything after that shares it read-only instead of compiling every shader from scratch.
+	const bool share_shader_cache =
+		(s_corpus_jobs > 1 && !s_settings_interface.GetBoolValue("EmuCore/GS", "DisableShaderCache", false));
+	bool shader_cache_warm = !share_shader_cache;
+
+	// hide the console of the workers, we have the log files
+#ifdef _WIN32
+	SetEnvironmentVariableW(L"PCSX2_NOCONSOLE", L"1");
+#else
+	setenv("PCSX2_NOCONSOLE", "1", 1);
+#endif
+
+	std::vector<CorpusWorker> workers;
+	std::vector<u32> free_slots;
+	for (u32 slot = s_corpus_jobs; slot > 0; slot--)
+		free_slots.push_back(slot - 1);
+
+	size_t next_pending = 0;
+	u32 num_finished = 0;
+	u32 num_failed = 0;
+	while (next_pending < pending.size() || !workers.empty())
+	{
+		while (next_pending < pending.size() && !free_slots.empty() && (shader_cache_warm || workers.empty()))
+		{
+			const size_t dump_index = pending[next_pending++];
+			const u32 slot = free_slots.back();
+
+			const std::string output_dir = Path::Combine(s_corpus_output_dir, GetCorpusDumpTitle(dumps[dump_index]));
+			if (!FileSystem::DirectoryExists(output_dir.c_str()) &&
+				!FileSystem::CreateDirectoryPath(output_dir.c_str(), false))
+			{
+				Console.Error("Failed to create output directory '%s'.", output_dir.c_str());
+				num_failed++;
+				continue;
+			}
+
+			CorpusWorker worker;
+			worker.dump_index = dump_index;
+			worker.slot = slot;
+			if (!SpawnCorpusWorker(
+					GetCorpusWorkerArgs(argc, argv, dumps[dump_index], slot, share_shader_cache && shader_cache_warm),
+					slot, &worker))
+			{
+				// Not journaled, so it gets another try when resuming.
+				Console.Error("Failed to start worker for '%s'.", dumps[dump_index].c_str());
+				num_failed++;
+				continue;
+			}
+
+			free_slots.pop_back();
+			workers.push_back(std::move(worker));
+		}
+
+		if (workers.empty())
+			continue;
+
+		size_t index;
+		s64 exit_code;
+		bool crashed;
+		if (!WaitForCorpusWorker(workers, &index, &exit_code, &crashed))
+			return false;
+
+		const CorpusWorker worker = std::move(workers[index]);
+		workers.erase(workers.begin() + index);
+		free_slots.push_back(worker.slot);
+		shader_cache_warm = true;
+
+		const std::string& dump_name = dumps[worker.dump_index];
+		const double time = worker.timer.GetTimeSeconds();
+		const char* status = crashed ? "crashed" : ((exit_code == 0) ? "passed" : "failed");
+		num_finished++;
+		num_failed += static_cast<u32>(crashed || exit_code != 0);
+
+		Console.WriteLn(fmt::format("@CORPUS@ [{}/{}] {}: {} (exit code {}, {:.2f}s)", num_finished, pending.size(),
+			dump_name, status, exit_code, time));
+
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("dump");
+		writer.String(dump_name.c_str(), static_cast<rapidjson::SizeType>(dump_name.size()));
+		writer.Key("status");
+		writer.String(status);
+		writer.Key("exit_code");
+		writer.Int64(exit_code);
+		writer.Key("time");
+		writer.Double(time);
+		writer.Key("worker");
+		writer.Uint(worker.slot);
+		writer.EndObject();
+
+		// Flushed per line, this is what lets an interrupted run resume.
+		if (std::fwrite(buffer.GetString(), buffer.GetSize(), 1, journal.get()) != 1 ||
+			std::fputc('\n', journal.get()) == EOF || std::fflush(journal.get()) != 0)
+		{
+			Console.Error("Failed to write to results journal '%s'.", journal_path.c_str());
+		}
+	}
+
+	Console.WriteLn(fmt::format("@CORPUS@ {} of {} dumps passed, {} completed in previous runs.",
+		pending.size() - num_failed, pending.size(), dumps.size() - pending.size()));
+	return (num_failed == 0);
 }
 
 #ifdef _WIN32
@@ -826,13 +1861,27 @@ void GSRunner::DumpStats()
 static void CPUThreadMain(VMBootParameters* params) {
 	if (VMManager::Initialize(*params))
 	{
-		// run until end
+		// run until end, replays pause themselves at the end of the recording
 		GSDumpReplayer::SetLoopCount(s_loop_count);
-		VMManager::SetState(VMState::Running);
+		Error error;
+		if (!s_state_hash_path.empty() && !StateHash::Start(s_state_hash_path, &error))
+		{
+			Console.Error(fmt::format("Failed to open state hash file: {}", error.GetDescription()));
+			s_benchmark_failed = true;
+		}
+		else if (s_input_recording_path.empty() || GSRunner::StartInputRecording())
+		{
+			VMManager::SetState(VMState::Running);
+		}
 		while (VMManager::GetState() == VMState::Running)
 			VMManager::Execute();
+		const bool report_okay = s_perf_report_path.empty() || GSRunner::ReportPerformance();
+		const bool replay_okay = s_input_recording_path.empty() || (g_InputRecording.isActive() && GSRunner::ReportInputRecording());
 		VMManager::Shutdown(false);
 		GSRunner::DumpStats();
+		if (!s_benchmark_path.empty())
+			s_benchmark_failed = !GSRunner::ReportBenchmark();
+		s_benchmark_failed |= !report_okay || !replay_okay;
 	}
 
 	VMManager::Internal::CPUThreadShutdown();
@@ -854,6 +1903,10 @@ int main(int argc, char* argv[])
 	if (!GSRunner::ParseCommandLineArgs(argc, argv, params))
 		return EXIT_FAILURE;
 
+	// The corpus runner never boots a VM itself, the workers do.
+	if (!s_corpus_dir.empty())
+		return GSRunner::RunCorpus(argc, argv) ? EXIT_SUCCESS : EXIT_FAILURE;
+
 	if (!VMManager::Internal::CPUThreadInitialize())
 		return EXIT_FAILURE;
 
@@ -874,11 +1927,17 @@ int main(int argc, char* argv[])
 	VMManager::Internal::CPUThreadShutdown();
 	GSRunner::DestroyPlatformWindow();
 
-	return EXIT_SUCCESS;
+	return s_benchmark_failed ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 void Host::PumpMessagesOnCPUThread()
 {
+	if (s_run_frames > 0 && PerformanceMetrics::GetFrameNumber() >= s_run_frames &&
+		VMManager::GetState() == VMState::Running)
+	{
+		VMManager::SetState(VMState::Stopping);
+	}
+
 	// update GS thread copy of frame number
 	MTGS::RunOnGSThread([frame_number = GSDumpReplayer::GetFrameNumber()]() { s_dump_frame_number = frame_number; });
 	MTGS::RunOnGSThread([loop_number = GSDumpReplayer::GetLoopCount()]() { s_loop_number = loop_number; });
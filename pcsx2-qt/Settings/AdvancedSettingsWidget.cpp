@@ -21,6 +21,8 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* settings_dialog,
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.eeINTCSpinDetection, "EmuCore/Speedhacks", "IntcStat", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.eeWaitLoopDetection, "EmuCore/Speedhacks", "WaitLoop", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.eeFastmem, "EmuCore/CPU/Recompiler", "EnableFastmem", true);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.eeBlockCache, "EmuCore/CPU/Recompiler", "EnableEEBlockCache", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.eeHotBlocks, "EmuCore/CPU/Recompiler", "EnableEEHotBlocks", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.pauseOnTLBMiss, "EmuCore/CPU/Recompiler", "PauseOnTLBMiss", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.extraMemory, "EmuCore/CPU", "ExtraMemory", false);
 
@@ -28,6 +30,8 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* settings_dialog,
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.vu1Recompiler, "EmuCore/CPU/Recompiler", "EnableVU1", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.vuFlagHack, "EmuCore/Speedhacks", "vuFlagHack", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.instantVU1, "EmuCore/Speedhacks", "vu1Instant", true);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.vuProgramCache, "EmuCore/CPU/Recompiler", "EnableVUProgramCache", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.vifUnpackCache, "EmuCore/CPU/Recompiler", "EnableVIFUnpackCache", false);
 
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.eeRoundingMode, "EmuCore/CPU", "FPU.Roundmode", static_cast<int>(FPRoundMode::ChopZero));
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.eeDivRoundingMode, "EmuCore/CPU", "FPUDiv.Roundmode", static_cast<int>(FPRoundMode::Nearest));
@@ -85,7 +89,7 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* settings_dialog,
 	dialog()->registerWidgetHelp(m_ui.eeWaitLoopDetection, tr("Wait Loop Detection"), tr("Checked"),
 		tr("Moderate speedup for some games, with no known side effects."));
 
-	dialog()->registerWidgetHelp(m_ui.eeCache, tr("Enable Cache (Slow)"), tr("Unchecked"), tr("Interpreter only, provided for diagnostic."));
+	dialog()->registerWidgetHelp(m_ui.eeCache, tr("Enable Cache (Slow)"), tr("Unchecked"), tr("Emulates the EE data cache for all games. Slow, games which need it have it enabled through the game database."));
 
 	//: INTC = Name of a PS2 register, leave as-is. "spin" = to make a cpu (or gpu) actively do nothing while you wait for something.  Like spinning in a circle, you're moving but not actually going anywhere.
 	dialog()->registerWidgetHelp(m_ui.eeINTCSpinDetection, tr("INTC Spin Detection"), tr("Checked"),
@@ -103,6 +107,14 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* settings_dialog,
 	dialog()->registerWidgetHelp(m_ui.extraMemory, tr("Enable 128MB RAM (Dev Console)"), tr("Unchecked"),
 		tr("Exposes an additional 96MB of memory to the virtual machine."));
 
+	dialog()->registerWidgetHelp(m_ui.eeBlockCache, tr("Persistent Block Cache"), tr("Unchecked"),
+		tr("Remembers which code blocks each game compiled, and compiles them up front when the game boots again, "
+		   "reducing stutter from recompilation during gameplay."));
+
+	dialog()->registerWidgetHelp(m_ui.eeHotBlocks, tr("Hot Block Recompilation"), tr("Unchecked"),
+		tr("Recompiles frequently executed code into larger blocks, so registers and constants are kept across "
+		   "what would otherwise be block boundaries."));
+
 	dialog()->registerWidgetHelp(m_ui.vu0RoundingMode, tr("VU0 Rounding Mode"), tr("Chop/Zero (Default)"), tr("Changes how PCSX2 handles rounding while emulating the Emotion Engine's Vector Unit 0 (EE VU0). "
 																											  "The default value handles the vast majority of games; <b>modifying this setting when a game is not having a visible problem will cause stability issues and/or crashes.</b>"));
 
@@ -120,6 +132,12 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsWindow* settings_dialog,
 		tr("Runs VU1 instantly. Provides a modest speed improvement in most games. "
 		   "Safe for most games, but a few games may exhibit graphical errors."));
 
+	dialog()->registerWidgetHelp(m_ui.vuProgramCache, tr("Persistent VU1 Program Cache"), tr("Unchecked"),
+		tr("Remembers which VU1 microprograms each game ran, and compiles them up front when the game boots again, "
+		   "reducing stutter from recompilation during gameplay."));
+	dialog()->registerWidgetHelp(m_ui.vifUnpackCache, tr("Persistent VIF Unpack Cache"), tr("Unchecked"),
+		tr("Remembers which VIF unpack variants each game used, and generates them up front when the game boots again."));
+
 	//: VU0 = Vector Unit 0. One of the PS2's processors.
 	dialog()->registerWidgetHelp(m_ui.vu0Recompiler, tr("Enable VU0 Recompiler (Micro Mode)"), tr("Checked"), tr("Enables VU0 Recompiler."));
 
@@ -55,6 +55,9 @@ AudioSettingsWidget::AudioSettingsWidget(SettingsWindow* settings_dialog, QWidge
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.outputLatencyMS, "SPU2/Output", "OutputLatencyMS",
 		AudioStreamParameters::DEFAULT_OUTPUT_LATENCY_MS);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.outputLatencyMinimal, "SPU2/Output", "OutputLatencyMinimal", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.threadedOutput, "SPU2/Output", "ThreadedOutput", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.adaptiveBuffer, "SPU2/Output", "AdaptiveBufferSize",
+		AudioStreamParameters::DEFAULT_ADAPTIVE_BUFFER);
 	connect(m_ui.audioBackend, &QComboBox::currentIndexChanged, this, &AudioSettingsWidget::updateDriverNames);
 	connect(m_ui.expansionMode, &QComboBox::currentIndexChanged, this, &AudioSettingsWidget::onExpansionModeChanged);
 	connect(m_ui.expansionSettings, &QToolButton::clicked, this, &AudioSettingsWidget::onExpansionSettingsClicked);
@@ -103,6 +106,13 @@ AudioSettingsWidget::AudioSettingsWidget(SettingsWindow* settings_dialog, QWidge
 		m_ui.outputLatencyMS, tr("Output Latency"), tr("%1 ms").arg(AudioStreamParameters::DEFAULT_OUTPUT_LATENCY_MS),
 		tr("Determines the latency from the buffer to the host audio output. This can be set lower than the target latency "
 		   "to reduce audio delay."));
+	dialog()->registerWidgetHelp(m_ui.adaptiveBuffer, tr("Adaptive Buffer Size"), tr("Unchecked"),
+		tr("Lets the time stretcher lower the buffer size while the host keeps up, and raise it again when audio runs "
+		   "dry. The buffer size above is used as the starting point. Only applies when synchronization is set to "
+		   "TimeStretch."));
+	dialog()->registerWidgetHelp(m_ui.threadedOutput, tr("Threaded Audio Output"), tr("Unchecked"),
+		tr("Moves resampling, time stretching and expansion of the audio output to a separate thread. Emulation timing "
+		   "is unaffected. Can help on CPUs where the emulation threads are the bottleneck."));
 	dialog()->registerWidgetHelp(m_ui.volume, tr("Output Volume"), "100%",
 		tr("Controls the volume of the audio played on the host."));
 	dialog()->registerWidgetHelp(m_ui.fastForwardVolume, tr("Fast Forward Volume"), "100%",
@@ -432,7 +442,16 @@ void AudioSettingsWidget::onStretchSettingsClicked()
 	dlgui.setupUi(&dlg);
 	QtUtils::SetScalableIcon(dlgui.icon, QIcon::fromTheme(QStringLiteral("volume-up-line")), QSize(32, 32));
 
+	for (u32 i = 0; i < static_cast<u32>(AudioStretchAlgorithm::Count); i++)
+	{
+		dlgui.algorithm->addItem(
+			QString::fromUtf8(AudioStream::GetStretchAlgorithmDisplayName(static_cast<AudioStretchAlgorithm>(i))));
+	}
+
 	SettingsInterface* sif = dialog()->getSettingsInterface();
+	SettingWidgetBinder::BindWidgetToEnumSetting(sif, dlgui.algorithm, "SPU2/Output", "StretchAlgorithm",
+		&AudioStream::ParseStretchAlgorithm, &AudioStream::GetStretchAlgorithmName,
+		AudioStreamParameters::DEFAULT_STRETCH_ALGORITHM);
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, dlgui.sequenceLength, "SPU2/Output", "StretchSequenceLengthMS",
 		AudioStreamParameters::DEFAULT_STRETCH_SEQUENCE_LENGTH, 0);
 	QtUtils::BindLabelToSlider(dlgui.sequenceLength, dlgui.sequenceLengthLabel);
@@ -449,6 +468,10 @@ void AudioSettingsWidget::onStretchSettingsClicked()
 
 	connect(dlgui.buttonBox->button(QDialogButtonBox::Close), &QPushButton::clicked, &dlg, &QDialog::accept);
 	connect(dlgui.buttonBox->button(QDialogButtonBox::RestoreDefaults), &QPushButton::clicked, this, [this, &dlg]() {
+		dialog()->setStringSettingValue("SPU2/Output", "StretchAlgorithm",
+			dialog()->isPerGameSettings() ?
+				std::nullopt :
+				std::optional<const char*>(AudioStream::GetStretchAlgorithmName(AudioStreamParameters::DEFAULT_STRETCH_ALGORITHM)));
 		dialog()->setIntSettingValue("SPU2/Output", "StretchSequenceLengthMS",
 			dialog()->isPerGameSettings() ?
 				std::nullopt :
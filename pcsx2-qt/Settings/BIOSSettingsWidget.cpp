@@ -24,6 +24,7 @@ BIOSSettingsWidget::BIOSSettingsWidget(SettingsWindow* settings_dialog, QWidget*
 
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.fastBoot, "EmuCore", "EnableFastBoot", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.fastBootFastForward, "EmuCore", "EnableFastBootFastForward", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.fastBootSnapshot, "EmuCore", "EnableFastBootSnapshot", false);
 	SettingWidgetBinder::BindWidgetToFolderSetting(sif, m_ui.searchDirectory, m_ui.browseSearchDirectory, m_ui.openSearchDirectory,
 		m_ui.resetSearchDirectory, "Folders", "Bios", Path::Combine(EmuFolders::DataRoot, "bios"));
 
@@ -33,6 +34,10 @@ BIOSSettingsWidget::BIOSSettingsWidget(SettingsWindow* settings_dialog, QWidget*
 	dialog()->registerWidgetHelp(m_ui.fastBootFastForward, tr("Fast Forward Boot"), tr("Unchecked"),
 		tr("Removes emulation speed throttle until the game starts to reduce startup time."));
 
+	dialog()->registerWidgetHelp(m_ui.fastBootSnapshot, tr("Cache BIOS Startup"), tr("Unchecked"),
+		tr("Saves the console's state once the BIOS has finished starting up, and restores it on later fast boots with the "
+		   "same BIOS instead of running the startup again. Requires the EE recompiler."));
+
 	refreshList();
 
 	connect(m_ui.searchDirectory, &QLineEdit::textChanged, this, &BIOSSettingsWidget::refreshList);
@@ -140,4 +145,5 @@ void BIOSSettingsWidget::fastBootChanged()
 {
 	const bool enabled = dialog()->getEffectiveBoolValue("EmuCore", "EnableFastBoot", true);
 	m_ui.fastBootFastForward->setEnabled(enabled);
+	m_ui.fastBootSnapshot->setEnabled(enabled);
 }
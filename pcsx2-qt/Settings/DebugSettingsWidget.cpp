@@ -128,6 +128,10 @@ DebugSettingsWidget::DebugSettingsWidget(SettingsWindow* settings_dialog, QWidge
 	//////////////////////////////////////////////////////////////////////////
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_logging.chkEnable, "EmuCore/TraceLog", "Enabled", false);
 	dialog()->registerWidgetHelp(m_logging.chkEnable, tr("Enable Trace Logging"), tr("Unchecked"), tr("Globally enable / disable trace logging."));
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_logging.chkBuffered, "EmuCore/TraceLog", "Buffered", false);
+	dialog()->registerWidgetHelp(m_logging.chkBuffered, tr("Buffer Trace Output"), tr("Unchecked"),
+		tr("Collects trace messages in per-thread buffers and writes them to emutrace.txt in the logs folder from a background thread. "
+		   "Much faster than regular trace logging, but messages are not shown in the log window."));
 
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_logging.chkEEBIOS, "EmuCore/TraceLog", "EE.bios", false);
 	dialog()->registerWidgetHelp(m_logging.chkEEBIOS, tr("EE BIOS"), tr("Unchecked"), tr("Log SYSCALL and DECI2 activity."));
@@ -232,6 +236,7 @@ void DebugSettingsWidget::onLoggingEnableChanged()
 {
 	const bool enabled = dialog()->getEffectiveBoolValue("EmuCore/TraceLog", "Enabled", false);
 
+	m_logging.chkBuffered->setEnabled(enabled);
 	m_logging.chkEEBIOS->setEnabled(enabled);
 	m_logging.chkEEMemory->setEnabled(enabled);
 	m_logging.chkEER5900->setEnabled(enabled);
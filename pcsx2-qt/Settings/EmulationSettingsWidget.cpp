@@ -33,6 +33,10 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* settings_dialog
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.syncToHostRefreshRate, "EmuCore/GS", "SyncToHostRefreshRate", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.useVSyncForTiming, "EmuCore/GS", "UseVSyncForTiming", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.skipPresentingDuplicateFrames, "EmuCore/GS", "SkipDuplicateFrames", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.throttleUncappedPresentation, "EmuCore/GS", "ThrottleUncappedPresentation", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.reduceInputLatency, "Framerate", "ReduceInputLatency", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.powerSaving, "Framerate", "PowerSaving", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.dynamicResolution, "EmuCore/GS", "DynamicResolution", false);
 	connect(m_ui.optimalFramePacing, &QCheckBox::checkStateChanged, this, &EmulationSettingsWidget::onOptimalFramePacingChanged);
 	connect(m_ui.vsync, &QCheckBox::checkStateChanged, this, &EmulationSettingsWidget::updateUseVSyncForTimingEnabled);
 	connect(m_ui.syncToHostRefreshRate, &QCheckBox::checkStateChanged, this, &EmulationSettingsWidget::updateUseVSyncForTimingEnabled);
@@ -41,9 +45,15 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* settings_dialog
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_ui.eeCycleSkipping, "EmuCore/Speedhacks", "EECycleSkip", DEFAULT_EE_CYCLE_SKIP);
 
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.MTVU, "EmuCore/Speedhacks", "vuThread", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.ipuThread, "EmuCore/Speedhacks", "ipuThread", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.threadPinning, "EmuCore", "EnableThreadPinning", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.hugePages, "EmuCore", "EnableHugePages", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.fastCDVD, "EmuCore/Speedhacks", "fastCDVD", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.precacheCDVD, "EmuCore", "CdvdPrecache", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.backgroundPrecacheCDVD, "EmuCore", "CdvdBackgroundPrecache", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.predictReadsCDVD, "EmuCore", "CdvdReadPrediction", false);
+	connect(m_ui.precacheCDVD, &QCheckBox::checkStateChanged, this, &EmulationSettingsWidget::onPrecacheCDVDChanged);
+	onPrecacheCDVDChanged();
 
 	if (dialog()->isPerGameSettings())
 	{
@@ -121,14 +131,27 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* settings_dialog
 		tr("Sets the priority for specific threads in a specific order ignoring the system scheduler. "
 		   //: P-Core = Performance Core, E-Core = Efficiency Core. See if Intel has official translations for these terms.
 		   "May help CPUs with big (P) and little (E) cores (e.g., Intel 12th or newer generation CPUs or other vendors such as AMD)."));
+	dialog()->registerWidgetHelp(m_ui.hugePages, tr("Use Huge Pages"), tr("Unchecked"),
+		tr("Backs emulated memory and the recompiler code caches with huge pages, reducing TLB misses in CPU-heavy games. "
+		   "Currently only supported on Linux with transparent huge pages enabled, other systems fall back to normal pages."));
 	dialog()->registerWidgetHelp(m_ui.MTVU, tr("Enable Multithreaded VU1 (MTVU1)"), tr("Checked"),
 		tr("Generally a speedup on CPUs with 4 or more cores. "
 		   "Safe for most games, but a few are incompatible and may hang."));
+	dialog()->registerWidgetHelp(m_ui.ipuThread, tr("Enable Threaded IPU"), tr("Unchecked"),
+		tr("Decodes FMVs on a separate thread while the EE keeps running. May speed up videos on CPUs with spare cores, "
+		   "but delays IPU interrupts slightly, which can upset some games."));
 	dialog()->registerWidgetHelp(m_ui.fastCDVD, tr("Enable Fast CDVD"), tr("Unchecked"),
-		tr("Fast disc access, shorter loading times. Check HDLoader compatibility lists for games that are known to have issues with this."));
+		tr("Fast disc access, shorter loading times. Reads which look like streamed audio or video are kept at the normal speed. "
+		   "Check HDLoader compatibility lists for games that are known to have issues with this."));
 	dialog()->registerWidgetHelp(m_ui.precacheCDVD, tr("Enable CDVD Precaching"), tr("Unchecked"),
 		tr("Loads the disc image into RAM before starting the virtual machine. Can reduce stutter on systems with hard drives that "
 		   "have long wake times, but significantly increases boot times."));
+	dialog()->registerWidgetHelp(m_ui.backgroundPrecacheCDVD, tr("Precache CDVD in Background"), tr("Unchecked"),
+		tr("Starts the game immediately and loads the disc image into RAM while it runs, instead of before the virtual machine starts. "
+		   "Sectors the game reads are cached first. If there isn't enough memory for the whole image, as much as fits is cached."));
+	dialog()->registerWidgetHelp(m_ui.predictReadsCDVD, tr("Predict CDVD Reads"), tr("Unchecked"),
+		tr("Records which parts of the disc each game reads, and prefetches them on later runs before the game asks for them. "
+		   "This can shorten loading times with compressed images, or images on slow drives."));
 	dialog()->registerWidgetHelp(m_ui.cheats, tr("Enable Cheats"), tr("Unchecked"),
 		tr("Automatically loads and applies cheats on game start."));
 	dialog()->registerWidgetHelp(m_ui.hostFilesystem, tr("Enable Host Filesystem"), tr("Unchecked"),
@@ -151,11 +174,27 @@ EmulationSettingsWidget::EmulationSettingsWidget(SettingsWindow* settings_dialog
 	dialog()->registerWidgetHelp(m_ui.useVSyncForTiming, tr("Use Host VSync Timing"), tr("Unchecked"),
 		tr("When synchronizing with the host refresh rate, this option disables PCSX2's internal frame timing and uses the host instead. "
 		   "Can result in smoother frame pacing, <strong>but at the cost of increased input latency</strong>."));
+	dialog()->registerWidgetHelp(m_ui.reduceInputLatency, tr("Reduce Input Latency"), tr("Unchecked"),
+		tr("Measures how long each frame takes to emulate, and waits before starting the next one so that controller input is "
+		   "read as late as possible while the frame still finishes in time, and polls controllers again when the game reads them. "
+		   "Frame delaying has no effect when using host vsync timing. Can cause stutter in games with very uneven frame times."));
+	dialog()->registerWidgetHelp(m_ui.powerSaving, tr("Power Saving Mode"), tr("Unchecked"),
+		tr("Sleeps instead of spinning while waiting for the next frame, and lets the software renderer threads sleep while "
+		   "they have no work. Reduces CPU usage and power draw, especially on laptops, but frame pacing depends on the "
+		   "accuracy of the operating system's timers. Software renderer changes apply when the renderer is restarted."));
 	dialog()->registerWidgetHelp(m_ui.skipPresentingDuplicateFrames, tr("Skip Presenting Duplicate Frames"), tr("Unchecked"),
 		tr("Detects when idle frames are being presented in 25/30fps games, and skips presenting those frames. The frame is still "
 		   "rendered, it just means the GPU has more time to complete it (this is NOT frame skipping). Can smooth out frame time "
 		   "fluctuations when the CPU/GPU are near maximum utilization, but makes frame pacing more inconsistent and can increase "
 		   "input lag. Helps when using frame generation on 25/30fps games."));
+	dialog()->registerWidgetHelp(m_ui.throttleUncappedPresentation, tr("Throttle Presentation When Uncapped"), tr("Unchecked"),
+		tr("When fast forwarding or running with the frame limiter disabled, only presents as many frames as the display can "
+		   "show, regardless of the VSync setting. Frames in between are still emulated and drawn, but skip post-processing and "
+		   "presentation. Speeds up fast forwarding when the GPU is the bottleneck."));
+	dialog()->registerWidgetHelp(m_ui.dynamicResolution, tr("Dynamic Resolution"), tr("Unchecked"),
+		tr("When the hardware renderer can't keep emulation at full speed because the GPU is too busy, lowers the internal "
+		   "resolution step by step, and once at native resolution, skips presenting frames. Steps back up towards the "
+		   "configured resolution when the GPU has headroom again."));
 	dialog()->registerWidgetHelp(m_ui.manuallySetRealTimeClock, tr("Manually Set Real-Time Clock"), tr("Unchecked"),
 		tr("Manually set a real-time clock to use for the virtual PlayStation 2 instead of using your OS' system clock."));
 	dialog()->registerWidgetHelp(m_ui.rtcDateTime, tr("Real-Time Clock"), tr("Current date and time"),
@@ -315,3 +354,8 @@ void EmulationSettingsWidget::onManuallySetRealTimeClockChanged()
 	const bool enabled = dialog()->getEffectiveBoolValue("EmuCore", "ManuallySetRealTimeClock", false);
 	m_ui.rtcDateTime->setEnabled(enabled);
 }
+
+void EmulationSettingsWidget::onPrecacheCDVDChanged()
+{
+	m_ui.backgroundPrecacheCDVD->setEnabled(dialog()->getEffectiveBoolValue("EmuCore", "CdvdPrecache", false));
+}
@@ -24,6 +24,7 @@ private:
 	void updateOptimalFramePacing();
 	void updateUseVSyncForTimingEnabled();
 	void onManuallySetRealTimeClockChanged();
+	void onPrecacheCDVDChanged();
 
 	Ui::EmulationSettingsWidget m_ui;
 };
@@ -239,6 +239,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showVPS, "EmuCore/GS", "OsdShowVPS", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showCPU, "EmuCore/GS", "OsdShowCPU", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showGPU, "EmuCore/GS", "OsdShowGPU", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showGPUBreakdown, "EmuCore/GS", "OsdShowGPUBreakdown", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showResolution, "EmuCore/GS", "OsdShowResolution", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showGSStats, "EmuCore/GS", "OsdShowGSStats", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showIndicators, "EmuCore/GS", "OsdShowIndicators", true);
@@ -247,6 +248,7 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showFrameTimes, "EmuCore/GS", "OsdShowFrameTimes", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showVersion, "EmuCore/GS", "OsdShowVersion", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showHardwareInfo, "EmuCore/GS", "OsdShowHardwareInfo", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showMemoryUsage, "EmuCore/GS", "OsdShowMemoryUsage", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showVideoCapture, "EmuCore/GS", "OsdShowVideoCapture", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.showInputRec, "EmuCore/GS", "OsdShowInputRec", true);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_osd.warnAboutUnsafeSettings, "EmuCore", "OsdWarnAboutUnsafeSettings", true);
@@ -264,12 +266,17 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.disableFramebufferFetch, "EmuCore/GS", "DisableFramebufferFetch", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.disableShaderCache, "EmuCore/GS", "DisableShaderCache", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.disableVertexShaderExpand, "EmuCore/GS", "DisableVertexShaderExpand", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.asyncShaderCompilation, "EmuCore/GS", "AsyncShaderCompilation", false);
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_advanced.gsDownloadMode, "EmuCore/GS", "HWDownloadMode", static_cast<int>(GSHardwareDownloadMode::Enabled));
 	SettingWidgetBinder::BindWidgetToFloatSetting(sif, m_advanced.ntscFrameRate, "EmuCore/GS", "FrameRateNTSC", 59.94f);
 	SettingWidgetBinder::BindWidgetToFloatSetting(sif, m_advanced.palFrameRate, "EmuCore/GS", "FrameRatePAL", 50.00f);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.spinCPUDuringReadbacks, "EmuCore/GS", "HWSpinCPUForReadbacks", false);
 	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.spinGPUDuringReadbacks, "EmuCore/GS", "HWSpinGPUForReadbacks", false);
+	SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_advanced.gpuTextureUnswizzle, "EmuCore/GS", "GPUTextureUnswizzle", false);
 	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_advanced.texturePreloading, "EmuCore/GS", "texture_preloading", static_cast<int>(TexturePreloadingLevel::Off));
+	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_advanced.hashCacheBudget, "EmuCore/GS", "HashCacheBudget", 0);
+	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_advanced.vramBudget, "EmuCore/GS", "VRAMBudget", 0);
+	SettingWidgetBinder::BindWidgetToIntSetting(sif, m_advanced.gsDumpReplayBuffer, "EmuCore/GS", "GSDumpReplayBuffer", 0);
 
 	setTabVisible(m_advanced_tab, QtHost::ShouldShowAdvancedSettings());
 
@@ -555,6 +562,15 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 			tr("Uploads entire textures at once instead of in small pieces, avoiding redundant uploads when possible. "
 			   "Improves performance in most games, but can make a small selection slower."));
 
+		dialog()->registerWidgetHelp(m_advanced.hashCacheBudget, tr("Hash Cache Budget"), tr("Unlimited"),
+			tr("Limits how much video memory fully preloaded textures can use. When the budget is exceeded, the least recently "
+			   "used textures are evicted first. Can avoid running out of video memory on GPUs with little VRAM."));
+
+		dialog()->registerWidgetHelp(m_advanced.vramBudget, tr("VRAM Budget"), tr("Unlimited"),
+			tr("Limits how much video memory the texture cache can use in total. When the budget is exceeded, unused textures "
+			   "are freed first, then render targets which have not been used for a while are written back to GS memory and "
+			   "dropped. Helps high upscaling multipliers on GPUs with 4-6 GB of VRAM, at the cost of some readbacks."));
+
 		dialog()->registerWidgetHelp(m_fixes.gpuPaletteConversion, tr("GPU Palette Conversion"), tr("Unchecked"),
 			tr("When enabled the GPU will convert colormap textures, otherwise the CPU will. "
 			   "It is a trade-off between GPU and CPU."));
@@ -572,6 +588,11 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 			tr("Submits useless work to the GPU during readbacks to prevent it from going into powersave modes. "
 			   "May improve performance during readbacks but with a significant increase in power usage."));
 
+		dialog()->registerWidgetHelp(m_advanced.gpuTextureUnswizzle, tr("GPU Texture Unswizzle"), tr("Unchecked"),
+			tr("Keeps a copy of GS memory on the GPU, uploading only the pages which change, and unswizzles "
+			   "32-bit and 24-bit textures from it instead of on the CPU. Only applies to textures which are not preloaded. "
+			   "It is a trade-off between GPU and CPU."));
+
 		// Software
 		dialog()->registerWidgetHelp(m_sw.extraSWThreads, tr("Software Rendering Threads"), tr("2 threads"),
 			tr("Number of rendering threads: 0 for single thread, 2 or more for multithread (1 is for debugging). "
@@ -747,6 +768,10 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 
 		dialog()->registerWidgetHelp(m_osd.showGPU, tr("Show GPU Usage"), tr("Unchecked"), tr("Shows host's GPU utilization."));
 
+		dialog()->registerWidgetHelp(m_osd.showGPUBreakdown, tr("Show GPU Time Breakdown"), tr("Unchecked"),
+			tr("Shows the GPU time per frame spent on texture cache conversions, draws, shuffles, readbacks, post-processing "
+			   "and presentation. Only supported by the Vulkan and Direct3D 12 renderers."));
+
 		dialog()->registerWidgetHelp(m_osd.showGSStats, tr("Show Statistics"), tr("Unchecked"),
 			tr("Shows counters for internal graphical utilization, useful for debugging."));
 
@@ -774,6 +799,9 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 		dialog()->registerWidgetHelp(m_osd.showHardwareInfo, tr("Show Hardware Info"), tr("Unchecked"),
 			tr("Shows the current system hardware information on the OSD."));
 
+		dialog()->registerWidgetHelp(m_osd.showMemoryUsage, tr("Show Memory Usage"), tr("Unchecked"),
+			tr("Shows how much memory the emulator and each of its subsystems are using on the OSD."));
+
 		dialog()->registerWidgetHelp(m_osd.warnAboutUnsafeSettings, tr("Warn About Unsafe Settings"), tr("Checked"),
 			tr("Displays warnings when settings are enabled which may break games."));
 	}
@@ -824,6 +852,10 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 		dialog()->registerWidgetHelp(m_advanced.gsDumpCompression, tr("GS Dump Compression"), tr("Zstandard (zst)"),
 			tr("Change the compression algorithm used when creating a GS dump."));
 
+		dialog()->registerWidgetHelp(m_advanced.gsDumpReplayBuffer, tr("GS Dump Replay Buffer"), tr("Disabled"),
+			tr("Keeps the last few seconds of GS data in memory, compressed in the background, so the Save GS Dump Replay "
+			   "Buffer hotkey can write a GS dump of a problem after it has happened. Uses more memory the longer it is."));
+
 		//: Blit = a data operation. You might want to write it as-is, but fully uppercased. More information: https://en.wikipedia.org/wiki/Bit_blit \nSwap chain: see Microsoft's Terminology Portal.
 		dialog()->registerWidgetHelp(m_advanced.useBlitSwapChain, tr("Use Blit Swap Chain"), tr("Unchecked"),
 			//: Blit = a data operation. You might want to write it as-is, but fully uppercased. More information: https://en.wikipedia.org/wiki/Bit_blit
@@ -845,6 +877,11 @@ GraphicsSettingsWidget::GraphicsSettingsWidget(SettingsWindow* settings_dialog,
 		dialog()->registerWidgetHelp(m_advanced.useDebugDevice, tr("Enable Debug Device"), tr("Unchecked"),
 			tr("Enables API-level validation of graphics commands."));
 
+		dialog()->registerWidgetHelp(m_advanced.asyncShaderCompilation, tr("Asynchronous Shader Compilation"), tr("Unchecked"),
+			tr("Compiles new shaders in the background instead of stalling the emulation. Draws which need a shader that is "
+			   "still compiling are skipped, which can cause brief graphical glitches. Only supported on OpenGL with "
+			   "KHR_parallel_shader_compile."));
+
 		dialog()->registerWidgetHelp(m_advanced.gsDownloadMode, tr("GS Download Mode"), tr("Accurate"),
 			tr("Skips synchronizing with the GS thread and host GPU for GS downloads. "
 			   "Can result in a large speed boost on slower systems, at the cost of many broken graphical effects. "
@@ -952,9 +989,11 @@ void GraphicsSettingsWidget::onPerformancePosChanged()
 	m_osd.showFPS->setEnabled(enabled);
 	m_osd.showCPU->setEnabled(enabled);
 	m_osd.showGPU->setEnabled(enabled);
+	m_osd.showGPUBreakdown->setEnabled(enabled);
 	m_osd.showResolution->setEnabled(enabled);
 	m_osd.showGSStats->setEnabled(enabled);
 	m_osd.showHardwareInfo->setEnabled(enabled);
+	m_osd.showMemoryUsage->setEnabled(enabled);
 	m_osd.showIndicators->setEnabled(enabled);
 	m_osd.showFrameTimes->setEnabled(enabled);
 	m_osd.showVersion->setEnabled(enabled);
@@ -1141,6 +1180,9 @@ void GraphicsSettingsWidget::updateRendererDependentOptions()
 	if (m_advanced.disableFramebufferFetch)
 		m_advanced.disableFramebufferFetch->setDisabled(is_sw_dx);
 
+	if (m_advanced.asyncShaderCompilation)
+		m_advanced.asyncShaderCompilation->setEnabled(is_auto || type == GSRendererType::OGL);
+
 	if (m_advanced.exclusiveFullscreenControl)
 		m_advanced.exclusiveFullscreenControl->setEnabled(is_auto || is_vk);
 
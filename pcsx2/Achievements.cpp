@@ -337,7 +337,7 @@ void Achievements::DownloadImage(std::string url, std::string cache_filename)
 		ImGuiFullscreen::InvalidateCachedTexture(cache_filename);
 	};
 
-	s_http_downloader->CreateRequest(std::move(url), std::move(callback));
+	s_http_downloader->CreateRequest(std::move(url), std::move(callback), nullptr, HTTPDownloader::Request::Priority::Bulk);
 }
 
 bool Achievements::IsActive()
@@ -670,6 +670,8 @@ void Achievements::ClientMessageCallback(const char* message, const rc_client_t*
 	Console.WriteLn("Achievements: %s", message);
 }
 
+// rcheevos reads each unique memory reference once per frame and evaluates every condition against those
+// cached values, so this is only called once per distinct address/size, not once per condition.
 uint32_t Achievements::ClientReadMemory(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client)
 {
 	if ((static_cast<u64>(address) + num_bytes) > GetExposedEEMemorySize()) [[unlikely]]
@@ -55,6 +55,64 @@ static __fi void SetSCMDResultSize(u8 size) noexcept
 	memset(&cdvd.SCMDResultBuff[0], 0, size);
 }
 
+// Fast CDVD only speeds up bulk loads. Streamed audio/FMV data comes in small sequential
+// reads with the drive sitting idle in between while the game plays back its buffer, and
+// those have to stay at the real rate or the stream runs ahead of the playback.
+struct CdvdReadPattern
+{
+	u32 nextSector; // sector following the previous read
+	u32 lastCompleteCycle; // IOP cycle the previous read completed on
+	u8 streamScore;
+	bool streaming;
+};
+
+static CdvdReadPattern s_read_pattern;
+
+static constexpr u8 CDVD_STREAM_SCORE_MAX = 8;
+static constexpr u8 CDVD_STREAM_SCORE_ON = 4;
+
+// Called when a read command is issued, after SeekToSector/SectorCnt are set.
+static void cdvdTrackReadCommand(bool audio)
+{
+	CdvdReadPattern& rp = s_read_pattern;
+
+	// Stream reads are issued some sectors worth of idle time after the previous one,
+	// bulk loaders ask for the next chunk straight away.
+	const u32 idle = psxRegs.cycle - rp.lastCompleteCycle;
+	const bool sequential = (cdvd.SeekToSector == rp.nextSector);
+	const bool stream_like = audio || (sequential && idle > (cdvd.ReadTime * 4));
+
+	if (audio)
+		rp.streamScore = CDVD_STREAM_SCORE_MAX;
+	else if (stream_like)
+		rp.streamScore = std::min<u8>(rp.streamScore + 2, CDVD_STREAM_SCORE_MAX);
+	else if (rp.streamScore > 0)
+		rp.streamScore--;
+
+	const bool streaming = (rp.streamScore >= CDVD_STREAM_SCORE_ON);
+	if (streaming != rp.streaming && EmuConfig.Speedhacks.fastCDVD && EmuConfig.CdvdVerboseReads)
+		Console.WriteLn(Color_Gray, "CDVD: Fast CDVD %s at sector %u", streaming ? "paused for streaming" : "resumed", cdvd.SeekToSector);
+
+	rp.streaming = streaming;
+	rp.nextSector = cdvd.SeekToSector + cdvd.SectorCnt;
+	rp.lastCompleteCycle = psxRegs.cycle;
+}
+
+static void cdvdTrackReadComplete()
+{
+	s_read_pattern.lastCompleteCycle = psxRegs.cycle;
+}
+
+static u32 cdvdFastCDVDCycles(u32 eCycle)
+{
+	// Keep long seeks out though, as games may try to push dmas while seeking. (Tales of the Abyss)
+	if (!EmuConfig.Speedhacks.fastCDVD || s_read_pattern.streaming || eCycle >= Cdvd_FullSeek_Cycles || eCycle <= 1)
+		return eCycle;
+
+	// Give it an arbitary FAST value. Good for ~10000kb/s in ULE when copying a file from CDVD to HDD
+	return std::max<u32>(eCycle / 4, 1);
+}
+
 static void CDVDCancelReadAhead()
 {
 	cdvd.nextSectorsBuffered = 0;
@@ -66,26 +124,12 @@ static void CDVDSECTORREADY_INT(u32 eCycle)
 	if (psxRegs.interrupt & (1 << IopEvt_CdvdSectorReady))
 		return;
 
-	if (EmuConfig.Speedhacks.fastCDVD)
-	{
-		if (eCycle < Cdvd_FullSeek_Cycles && eCycle > 1)
-			eCycle *= 0.5f;
-	}
-
-	PSX_INT(IopEvt_CdvdSectorReady, eCycle);
+	PSX_INT(IopEvt_CdvdSectorReady, cdvdFastCDVDCycles(eCycle));
 }
 
 static void CDVDREAD_INT(u32 eCycle)
 {
-	// Give it an arbitary FAST value. Good for ~5000kb/s in ULE when copying a file from CDVD to HDD
-	// Keep long seeks out though, as games may try to push dmas while seeking. (Tales of the Abyss)
-	if (EmuConfig.Speedhacks.fastCDVD)
-	{
-		if (eCycle < Cdvd_FullSeek_Cycles && eCycle > 1)
-			eCycle *= 0.5f;
-	}
-
-	PSX_INT(IopEvt_CdvdRead, eCycle);
+	PSX_INT(IopEvt_CdvdRead, cdvdFastCDVDCycles(eCycle));
 }
 
 static void CDVD_INT(int eCycle)
@@ -907,6 +951,7 @@ static uint cdvdBlockReadTime(CDVD_MODE_TYPE mode) noexcept
 void cdvdReset()
 {
 	std::memset(&cdvd, 0, sizeof(cdvd));
+	s_read_pattern = {};
 
 	cdvd.DiscType = CDVD_TYPE_NODISC;
 	cdvd.Spinning = false;
@@ -1008,6 +1053,13 @@ bool SaveStateBase::cdvdFreeze()
 	return true;
 }
 
+// Refreshes the disc type and size after restoring a state which was created with a different disc.
+void cdvdRedetectDisk()
+{
+	DoCDVDresetDiskTypeCache();
+	cdvdDetectDisk();
+}
+
 void cdvdNewDiskCB()
 {
 	DoCDVDresetDiskTypeCache();
@@ -1352,6 +1404,7 @@ __fi void cdvdReadInterrupt()
 		{
 			// Setting the data ready flag fixes a black screen loading issue in
 			// Street Fighter Ex3 (NTSC-J version).
+			cdvdTrackReadComplete();
 			cdvdSetIrq();
 			cdvdUpdateReady(CDVD_DRIVE_READY);
 			cdvd.Reading = 0;
@@ -2046,6 +2099,7 @@ static void cdvdWrite04(u8 rt)
 				Console.WriteLn(Color_Gray, "CDRead: Reading Sector %07d (%03d Blocks of Size %d) at Speed=%dx(%s) Spindle=%x",
 					cdvd.SeekToSector, cdvd.SectorCnt, cdvd.BlockSize, cdvd.Speed, (cdvd.SpindlCtrl & CDVD_SPINDLE_CAV) ? "CAV" : "CLV", cdvd.SpindlCtrl);
 
+			cdvdTrackReadCommand(false);
 			CDVDREAD_INT(cdvdStartSeek(cdvd.SeekToSector, static_cast<CDVD_MODE_TYPE>(cdvdIsDVD()), !(cdvd.SpindlCtrl & CDVD_SPINDLE_CAV) && (oldSpindleCtrl & CDVD_SPINDLE_CAV)));
 
 			// Read-ahead by telling CDVD about the track now.
@@ -2144,6 +2198,7 @@ static void cdvdWrite04(u8 rt)
 				Console.WriteLn(Color_Gray, "CdAudioRead: Reading Sector %07d (%03d Blocks of Size %d) at Speed=%dx(%s) Spindle=%x",
 					cdvd.CurrentSector, cdvd.SectorCnt, cdvd.BlockSize, cdvd.Speed, (cdvd.SpindlCtrl & CDVD_SPINDLE_CAV) ? "CAV" : "CLV", cdvd.SpindlCtrl);
 
+			cdvdTrackReadCommand(true);
 			CDVDREAD_INT(cdvdStartSeek(cdvd.SeekToSector, MODE_CDROM, !(cdvd.SpindlCtrl& CDVD_SPINDLE_CAV) && (oldSpindleCtrl& CDVD_SPINDLE_CAV)));
 
 			// Read-ahead by telling CDVD about the track now.
@@ -2239,6 +2294,7 @@ static void cdvdWrite04(u8 rt)
 				Console.WriteLn(Color_Gray, "DvdRead: Reading Sector %07d (%03d Blocks of Size %d) at Speed=%dx(%s) SpindleCtrl=%x",
 					cdvd.SeekToSector, cdvd.SectorCnt, cdvd.BlockSize, cdvd.Speed, (cdvd.SpindlCtrl & CDVD_SPINDLE_CAV) ? "CAV" : "CLV", cdvd.SpindlCtrl);
 
+			cdvdTrackReadCommand(false);
 			CDVDREAD_INT(cdvdStartSeek(cdvd.SeekToSector, MODE_DVDROM, !(cdvd.SpindlCtrl & CDVD_SPINDLE_CAV) && (oldSpindleCtrl& CDVD_SPINDLE_CAV)));
 
 			// Read-ahead by telling CDVD about the track now.
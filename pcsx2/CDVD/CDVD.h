@@ -169,6 +169,7 @@ extern void cdvdReadLanguageParams(u8* config);
 extern void cdvdLoadNVRAM();
 extern void cdvdSaveNVRAM();
 extern void cdvdReset();
+extern void cdvdRedetectDisk();
 extern void cdvdVsync();
 extern void cdvdActionInterrupt();
 extern void cdvdSectorReady();
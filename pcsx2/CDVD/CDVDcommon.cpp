@@ -406,11 +406,12 @@ bool DoCDVDopen(Error* error)
 	return true;
 }
 
-bool DoCDVDprecache(ProgressCallback* progress, Error* error)
+bool DoCDVDprecache(ProgressCallback* progress, bool background, Error* error)
 {
 	CheckNullCDVD();
-	progress->SetTitle(TRANSLATE("CDVD", "Precaching CDVD"));
-	return CDVD->precache(progress, error);
+	if (progress)
+		progress->SetTitle(TRANSLATE("CDVD", "Precaching CDVD"));
+	return CDVD->precache(progress, background, error);
 }
 
 void DoCDVDclose()
@@ -525,7 +526,7 @@ static bool NODISCopen(std::string filename, Error* error)
 	return true;
 }
 
-static bool NODISCprecache(ProgressCallback* progress, Error* error)
+static bool NODISCprecache(ProgressCallback* progress, bool background, Error* error)
 {
 	return true;
 }
@@ -116,7 +116,7 @@ struct cdvdTN
 
 // CDVD
 typedef bool (*_CDVDopen)(std::string filename, Error* error);
-typedef bool (*_CDVDprecache)(ProgressCallback* progress, Error* error);
+typedef bool (*_CDVDprecache)(ProgressCallback* progress, bool background, Error* error);
 
 // Initiates an asynchronous track read operation.
 // Returns -1 on error (invalid track)
@@ -184,6 +184,10 @@ extern const CDVD_API CDVDapi_Iso;
 extern const CDVD_API CDVDapi_Disc;
 extern const CDVD_API CDVDapi_NoDisc;
 
+/// Records the reads of the open image under the serial, and prefetches the ones earlier sessions made
+/// next. An empty serial stops recording.
+extern void ISOsetReadProfile(const std::string& serial);
+
 extern u8 strack;
 extern u8 etrack;
 extern std::array<cdvdTrack, 100> tracks;
@@ -195,7 +199,7 @@ extern CDVD_SourceType CDVDsys_GetSourceType();
 extern void CDVDsys_ClearFiles();
 
 extern bool DoCDVDopen(Error* error);
-extern bool DoCDVDprecache(ProgressCallback* progress, Error* error);
+extern bool DoCDVDprecache(ProgressCallback* progress, bool background, Error* error);
 extern void DoCDVDclose();
 extern s32 DoCDVDreadSector(u8* buffer, u32 lsn, int mode);
 extern s32 DoCDVDreadTrack(u32 lsn, int mode);
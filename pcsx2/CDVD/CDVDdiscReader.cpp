@@ -121,6 +121,7 @@ bool weAreInNewDiskCB = false;
 std::unique_ptr<IOCtlSrc> src;
 
 extern u32 g_last_sector_block_lsn;
+extern std::atomic<bool> g_disc_read_since_keepalive;
 
 ///////////////////////////////////////////////////////////////////////////////
 // keepAliveThread throws a read event regularly to prevent drive spin down  //
@@ -132,9 +133,13 @@ static void keepAliveThread()
 	printf(" * CDVD: KeepAlive thread started...\n");
 	std::unique_lock<std::mutex> guard(s_keepalive_lock);
 
-	while (!s_keepalive_cv.wait_for(guard, std::chrono::seconds(30),
+	// Drives tend to spin down after a few seconds of inactivity, and spinning back up stalls the next read
+	// for a second or more. Only poll when the IO thread hasn't touched the disc since the last poll.
+	while (!s_keepalive_cv.wait_for(guard, std::chrono::seconds(10),
 		[]() { return !s_keepalive_is_open; }))
 	{
+		if (g_disc_read_since_keepalive.exchange(false, std::memory_order_relaxed))
+			continue;
 
 		//printf(" * keepAliveThread: polling drive.\n");
 		if (src->GetMediaType() >= 0)
@@ -196,7 +201,7 @@ static bool DISCopen(std::string filename, Error* error)
 	return true;
 }
 
-static bool DISCprecache(ProgressCallback* progress, Error* error)
+static bool DISCprecache(ProgressCallback* progress, bool background, Error* error)
 {
 	Error::SetStringView(error, TRANSLATE_SV("CDVD", "Precaching is not supported for discs."));
 	return false;
@@ -10,20 +10,33 @@
 #include <limits>
 #include <queue>
 #include <thread>
+#include <unordered_map>
 
 const u32 sectors_per_read = 16;
 
 static_assert(sectors_per_read > 1 && !(sectors_per_read & (sectors_per_read - 1)),
 			  "sectors_per_read must by a power of 2");
 
+// Read-ahead window in blocks. It grows while the game streams sequentially, and shrinks again on seeks,
+// so random access doesn't keep the drive busy reading data which won't be used.
+static constexpr u32 min_readahead_blocks = 4;
+static constexpr u32 max_readahead_blocks = 256;
+
+// Optical drives are much happier with fewer, larger reads, so prefetches cover several blocks at once.
+static constexpr u32 max_blocks_per_read = 4;
+
 struct SectorInfo
 {
 	u32 lsn;
+	// LRU list links, as cache slot indices.
+	u32 prev;
+	u32 next;
 	// Sectors are read in blocks, not individually
 	u8 data[2352 * sectors_per_read];
 };
 
 u32 g_last_sector_block_lsn;
+std::atomic<bool> g_disc_read_since_keepalive;
 
 static std::thread s_thread;
 
@@ -41,67 +54,111 @@ static std::atomic<bool> cdvd_is_open;
 static constexpr u32 CacheSize = 1U << CACHE_SIZE;
 static SectorInfo Cache[CacheSize];
 
-static u32 cdvdSectorHash(u32 lsn)
+// Block LSN to cache slot, and the least recently used list, most recent first.
+static std::unordered_map<u32, u32> s_cache_map;
+static u32 s_cache_head;
+static u32 s_cache_tail;
+
+static void cdvdCacheUnlink(u32 entry)
 {
-	u32 t = 0;
+	SectorInfo& info = Cache[entry];
+	if (info.prev != CacheSize)
+		Cache[info.prev].next = info.next;
+	else
+		s_cache_head = info.next;
 
-	int i = 32;
-	u32 m = CacheSize - 1;
+	if (info.next != CacheSize)
+		Cache[info.next].prev = info.prev;
+	else
+		s_cache_tail = info.prev;
+}
 
-	while (i >= 0)
-	{
-		t ^= lsn & m;
-		lsn >>= CACHE_SIZE;
-		i -= CACHE_SIZE;
-	}
+static void cdvdCachePushFront(u32 entry)
+{
+	SectorInfo& info = Cache[entry];
+	info.prev = CacheSize;
+	info.next = s_cache_head;
+	if (s_cache_head != CacheSize)
+		Cache[s_cache_head].prev = entry;
+	else
+		s_cache_tail = entry;
+	s_cache_head = entry;
+}
+
+static void cdvdCacheTouch(u32 entry)
+{
+	if (s_cache_head == entry)
+		return;
 
-	return t & m;
+	cdvdCacheUnlink(entry);
+	cdvdCachePushFront(entry);
 }
 
-static void cdvdCacheUpdate(u32 lsn, u8* data)
+static void cdvdCacheUpdate(u32 lsn, const u8* data)
 {
 	std::lock_guard<std::mutex> guard(s_cache_lock);
-	u32 entry = cdvdSectorHash(lsn);
+
+	u32 entry;
+	if (const auto it = s_cache_map.find(lsn); it != s_cache_map.end())
+	{
+		entry = it->second;
+	}
+	else
+	{
+		// Evict the least recently used block.
+		entry = s_cache_tail;
+		if (Cache[entry].lsn != std::numeric_limits<u32>::max())
+			s_cache_map.erase(Cache[entry].lsn);
+
+		Cache[entry].lsn = lsn;
+		s_cache_map.emplace(lsn, entry);
+	}
 
 	memcpy(Cache[entry].data, data, 2352 * sectors_per_read);
-	Cache[entry].lsn = lsn;
+	cdvdCacheTouch(entry);
 }
 
 static bool cdvdCacheCheck(u32 lsn)
 {
 	std::lock_guard<std::mutex> guard(s_cache_lock);
-	u32 entry = cdvdSectorHash(lsn);
-
-	return Cache[entry].lsn == lsn;
+	return s_cache_map.contains(lsn);
 }
 
 static bool cdvdCacheFetch(u32 lsn, u8* data)
 {
 	std::lock_guard<std::mutex> guard(s_cache_lock);
-	u32 entry = cdvdSectorHash(lsn);
 
-	if (Cache[entry].lsn == lsn)
-	{
-		memcpy(data, Cache[entry].data, 2352 * sectors_per_read);
-		return true;
-	}
-	//printf("NOT IN CACHE\n");
-	return false;
+	const auto it = s_cache_map.find(lsn);
+	if (it == s_cache_map.end())
+		return false;
+
+	memcpy(data, Cache[it->second].data, 2352 * sectors_per_read);
+	cdvdCacheTouch(it->second);
+	return true;
 }
 
 static void cdvdCacheReset()
 {
 	std::lock_guard<std::mutex> guard(s_cache_lock);
+	s_cache_map.clear();
+	s_cache_map.reserve(CacheSize);
+
 	for (u32 i = 0; i < CacheSize; i++)
 	{
 		Cache[i].lsn = std::numeric_limits<u32>::max();
+		Cache[i].prev = (i == 0) ? CacheSize : (i - 1);
+		Cache[i].next = i + 1;
 	}
+
+	s_cache_head = 0;
+	s_cache_tail = CacheSize - 1;
 }
 
-static bool cdvdReadBlockOfSectors(u32 sector, u8* data)
+static bool cdvdReadBlocksOfSectors(u32 sector, u32 blocks, u8* data)
 {
-	u32 count = std::min(sectors_per_read, src->GetSectorCount() - sector);
+	u32 count = std::min(sectors_per_read * blocks, src->GetSectorCount() - sector);
 	const s32 media = src->GetMediaType();
+	g_disc_read_since_keepalive.store(true, std::memory_order_relaxed);
 
 	// TODO: Is it really necessary to retry if it fails? I'm not sure the
 	// second time is really going to be any better.
@@ -121,6 +178,11 @@ static bool cdvdReadBlockOfSectors(u32 sector, u8* data)
 	return false;
 }
 
+static bool cdvdReadBlockOfSectors(u32 sector, u8* data)
+{
+	return cdvdReadBlocksOfSectors(sector, 1, data);
+}
+
 static void cdvdCallNewDiscCB()
 {
 	weAreInNewDiskCB = true;
@@ -163,10 +225,33 @@ static bool cdvdUpdateDiscStatus()
 	return !ready;
 }
 
+// Reads as many uncached blocks as we can in one go, starting at lsn, which is known not to be cached.
+static u32 cdvdPrefetchBlocks(u32 lsn, u32 max_blocks, u8* buffer)
+{
+	const u32 total_blocks = (src->GetSectorCount() + sectors_per_read - 1) / sectors_per_read;
+	u32 blocks = 1;
+	while (blocks < max_blocks && (lsn / sectors_per_read + blocks) < total_blocks &&
+		   !cdvdCacheCheck(lsn + blocks * sectors_per_read))
+	{
+		blocks++;
+	}
+
+	if (!cdvdReadBlocksOfSectors(lsn, blocks, buffer))
+		return 0;
+
+	const u32 block_size = ((src->GetMediaType() >= 0) ? 2048 : 2352) * sectors_per_read;
+	for (u32 i = 0; i < blocks; i++)
+		cdvdCacheUpdate(lsn + i * sectors_per_read, buffer + i * block_size);
+
+	return blocks;
+}
+
 static void cdvdThread()
 {
-	u8 buffer[2352 * sectors_per_read];
+	static u8 buffer[2352 * sectors_per_read * max_blocks_per_read];
 	u32 prefetches_left = 0;
+	u32 readahead_blocks = 16;
+	u32 last_request_lsn = std::numeric_limits<u32>::max();
 
 	printf(" * CDVD: IO thread started...\n");
 	std::unique_lock<std::mutex> guard(s_notify_lock);
@@ -213,14 +298,13 @@ static void cdvdThread()
 			request_lsn = next_prefetch_lsn;
 		}
 
-		// Handle request
+		// Handle request. Requested blocks are read on their own, the game is waiting for them.
+		u32 blocks_read = 1;
 		if (!cdvdCacheCheck(request_lsn))
 		{
-			if (cdvdReadBlockOfSectors(request_lsn, buffer))
-			{
-				cdvdCacheUpdate(request_lsn, buffer);
-			}
-			else
+			blocks_read = handling_request ? cdvdPrefetchBlocks(request_lsn, 1, buffer) :
+			                                 cdvdPrefetchBlocks(request_lsn, std::min(prefetches_left + 1, max_blocks_per_read), buffer);
+			if (blocks_read == 0)
 			{
 				// If the read fails, further reads are likely to fail too.
 				prefetches_left = 0;
@@ -228,10 +312,25 @@ static void cdvdThread()
 			}
 		}
 
-		g_last_sector_block_lsn = request_lsn;
+		g_last_sector_block_lsn = request_lsn + (blocks_read - 1) * sectors_per_read;
 
 		if (!handling_request)
+		{
+			prefetches_left -= std::min(prefetches_left, blocks_read - 1);
 			continue;
+		}
+
+		// Grow the window while requests land inside what we read ahead last time, shrink it on seeks.
+		if (last_request_lsn != std::numeric_limits<u32>::max() && request_lsn > last_request_lsn &&
+			request_lsn <= last_request_lsn + (readahead_blocks + 1) * sectors_per_read)
+		{
+			readahead_blocks = std::min(readahead_blocks * 2, max_readahead_blocks);
+		}
+		else
+		{
+			readahead_blocks = std::max(readahead_blocks / 4, min_readahead_blocks);
+		}
+		last_request_lsn = request_lsn;
 
 		// Prefetch
 		u32 next_prefetch_lsn = g_last_sector_block_lsn + sectors_per_read;
@@ -241,9 +340,8 @@ static void cdvdThread()
 		}
 		else
 		{
-			const u32 max_prefetches = 16;
 			u32 remaining = src->GetSectorCount() - next_prefetch_lsn;
-			prefetches_left = std::min((remaining + sectors_per_read - 1) / sectors_per_read, max_prefetches);
+			prefetches_left = std::min((remaining + sectors_per_read - 1) / sectors_per_read, readahead_blocks);
 		}
 	}
 	printf(" * CDVD: IO thread finished.\n");
@@ -251,13 +349,14 @@ static void cdvdThread()
 
 void cdvdStartThread()
 {
+	// Before the thread starts, it uses the cache links too.
+	cdvdCacheReset();
+
 	if (cdvd_is_open == false)
 	{
 		cdvd_is_open = true;
 		s_thread = std::thread(cdvdThread);
 	}
-
-	cdvdCacheReset();
 }
 
 void cdvdStopThread()
@@ -3,10 +3,14 @@
 
 #include "IsoFileFormats.h"
 #include "CDVD/CDVD.h"
+#include "Config.h"
 
 #include "common/Assertions.h"
 #include "common/Console.h"
 #include "common/Error.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
 
 #include <cstring>
 #include <array>
@@ -55,9 +59,9 @@ static bool ISOopen(std::string filename, Error* error)
 	return true;
 }
 
-static bool ISOprecache(ProgressCallback* progress, Error* error)
+static bool ISOprecache(ProgressCallback* progress, bool background, Error* error)
 {
-	return iso.Precache(progress, error);
+	return iso.Precache(progress, background, error);
 }
 
 static s32 ISOreadSubQ(u32 lsn, cdvdSubQ* subq)
@@ -400,6 +404,12 @@ static void ISOnewDiskCB(void (* /* callback */)())
 {
 }
 
+void ISOsetReadProfile(const std::string& serial)
+{
+	iso.SetReadProfile(serial.empty() ? std::string() :
+										Path::Combine(EmuFolders::Cache, fmt::format("cdvd_reads_{}.bin", serial)));
+}
+
 const CDVD_API CDVDapi_Iso =
 	{
 		ISOclose,
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "ChdFileReader.h"
+#include "Config.h"
 
 #include "common/Assertions.h"
 #include "common/Console.h"
@@ -11,11 +12,15 @@
 #include "common/ProgressCallback.h"
 #include "common/SmallString.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include "libchdr/chd.h"
 #include "fmt/format.h"
 #include "xxhash.h"
 
+#include <algorithm>
+#include <bitset>
+
 static constexpr u32 MAX_PARENTS = 32; // Surely someone wouldn't be insane enough to go beyond this...
 static std::vector<std::pair<std::string, chd_header>> s_chd_hash_cache; // <filename, header>
 static std::recursive_mutex s_chd_hash_cache_mutex;
@@ -380,6 +385,7 @@ bool ChdFileReader::Open2(std::string filename, Error* error)
 
 	const chd_header* chd_header = chd_get_header(ChdFile);
 	hunk_size = chd_header->hunkbytes;
+	hunk_count = chd_header->totalhunks;
 	// CHD likes to use full 2448 byte blocks, but keeps the +24 offset of source ISOs
 	// The rest of PCSX2 likes to use 2448 byte buffers, which can't fit that so trim blocks instead
 	m_internalBlockSize = chd_header->unitbytes;
@@ -397,16 +403,191 @@ bool ChdFileReader::Open2(std::string filename, Error* error)
 		file_size = static_cast<u64>(chd_header->unitbytes) * chd_header->unitcount;
 	}
 
+	// Worker handles are opened lazily, once we see a sequential read pattern.
+	m_decompress_threads = static_cast<u32>(std::clamp<int>(EmuConfig.CdvdDecompressThreads, 0, MAX_DECOMPRESS_THREADS));
+	m_prefetch_max_depth = static_cast<u32>(std::clamp<int>(EmuConfig.CdvdPrefetchDepth, 1, MAX_PREFETCH_DEPTH));
+	m_workers_failed = false;
+
+	return true;
+}
+
+bool ChdFileReader::StartPrefetchWorkers()
+{
+	for (u32 i = 0; i < m_decompress_threads; i++)
+	{
+		Error error;
+		auto fp = FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite, &error);
+		chd_file* chd = fp ? OpenCHD(m_filename, std::move(fp), &error, 0) : nullptr;
+		if (!chd)
+		{
+			Console.Warning(fmt::format("CDVD: Failed to open CHD for prefetching: {}", error.GetDescription()));
+			break;
+		}
+
+		m_worker_chds.push_back(chd);
+	}
+
+	if (m_worker_chds.empty())
+	{
+		m_workers_failed = true;
+		return false;
+	}
+
+	// Extra slots so hunks which are still decompressing after the window moves don't starve the queue.
+	m_prefetch_slots.resize(m_prefetch_max_depth + static_cast<u32>(m_worker_chds.size()));
+	for (PrefetchSlot& slot : m_prefetch_slots)
+	{
+		slot.data.resize(hunk_size);
+		slot.state = PrefetchState::Free;
+	}
+
+	m_workers_quit = false;
+	for (chd_file* chd : m_worker_chds)
+		m_workers.emplace_back(&ChdFileReader::PrefetchWorkerThread, this, chd);
+
+	DevCon.WriteLn("CDVD: Started %zu CHD decompression threads, prefetching up to %u hunks.", m_workers.size(), m_prefetch_max_depth);
 	return true;
 }
 
+void ChdFileReader::StopPrefetchWorkers()
+{
+	{
+		std::unique_lock lock(m_prefetch_mutex);
+		m_workers_quit = true;
+		m_prefetch_work_cv.notify_all();
+	}
+
+	for (std::thread& thread : m_workers)
+		thread.join();
+	m_workers.clear();
+
+	for (chd_file* chd : m_worker_chds)
+		chd_close(chd);
+	m_worker_chds.clear();
+
+	m_prefetch_queue.clear();
+	m_prefetch_slots.clear();
+	m_prefetch_distance = 0;
+	m_sequential_run = 0;
+	m_last_hunk = -1;
+}
+
+void ChdFileReader::PrefetchWorkerThread(chd_file* chd)
+{
+	Threading::SetNameOfCurrentThread("CHD Decompress");
+
+	std::unique_lock lock(m_prefetch_mutex);
+	for (;;)
+	{
+		m_prefetch_work_cv.wait(lock, [this]() { return m_workers_quit || !m_prefetch_queue.empty(); });
+		if (m_workers_quit)
+			return;
+
+		PrefetchSlot* slot = m_prefetch_queue.front();
+		m_prefetch_queue.pop_front();
+		slot->state = PrefetchState::Decompressing;
+		const u32 hunk = slot->hunk;
+		lock.unlock();
+
+		const chd_error error = chd_read(chd, hunk, slot->data.data());
+
+		lock.lock();
+		slot->state = (error == CHDERR_NONE) ? PrefetchState::Ready : PrefetchState::Failed;
+		m_prefetch_done_cv.notify_all();
+	}
+}
+
+ChdFileReader::PrefetchSlot* ChdFileReader::UpdatePrefetch(u32 hunk, std::unique_lock<std::mutex>& lock)
+{
+	PrefetchSlot* slot = nullptr;
+	for (PrefetchSlot& it : m_prefetch_slots)
+	{
+		if (it.state != PrefetchState::Free && it.hunk == hunk)
+		{
+			slot = &it;
+			break;
+		}
+	}
+
+	if (slot && slot->state == PrefetchState::Queued)
+	{
+		// Nobody has picked it up yet, we may as well decompress it ourselves.
+		m_prefetch_queue.erase(std::find(m_prefetch_queue.begin(), m_prefetch_queue.end(), slot));
+		slot->state = PrefetchState::Free;
+		slot = nullptr;
+	}
+
+	if (!slot || slot->state != PrefetchState::Decompressing)
+		return slot;
+
+	// The workers aren't far enough ahead of the reader, so look further ahead next time.
+	m_prefetch_distance = std::min(m_prefetch_distance * 2, m_prefetch_max_depth);
+	m_prefetch_done_cv.wait(lock, [slot]() { return slot->state != PrefetchState::Decompressing; });
+	return slot;
+}
+
+void ChdFileReader::QueuePrefetch(u32 hunk)
+{
+	const u32 window_end = static_cast<u32>(std::min<u64>(static_cast<u64>(hunk) + m_prefetch_distance, hunk_count - 1));
+	const auto in_window = [hunk, window_end](u32 h) { return h > hunk && h <= window_end; };
+
+	for (auto it = m_prefetch_queue.begin(); it != m_prefetch_queue.end();)
+	{
+		if (!in_window((*it)->hunk))
+		{
+			(*it)->state = PrefetchState::Free;
+			it = m_prefetch_queue.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	std::bitset<MAX_PREFETCH_DEPTH> present;
+	for (PrefetchSlot& slot : m_prefetch_slots)
+	{
+		if (slot.state == PrefetchState::Free)
+			continue;
+
+		if (in_window(slot.hunk))
+			present.set(slot.hunk - hunk - 1);
+		else if (slot.state != PrefetchState::Decompressing)
+			slot.state = PrefetchState::Free;
+	}
+
+	bool queued = false;
+	auto free_slot = m_prefetch_slots.begin();
+	for (u32 h = hunk + 1; h <= window_end && hunk < window_end; h++)
+	{
+		if (present.test(h - hunk - 1))
+			continue;
+
+		free_slot = std::find_if(free_slot, m_prefetch_slots.end(), [](const PrefetchSlot& slot) { return slot.state == PrefetchState::Free; });
+		if (free_slot == m_prefetch_slots.end())
+			break;
+
+		free_slot->hunk = h;
+		free_slot->state = PrefetchState::Queued;
+		m_prefetch_queue.push_back(&*free_slot);
+		queued = true;
+	}
+
+	if (queued)
+		m_prefetch_work_cv.notify_all();
+}
+
 bool ChdFileReader::Precache2(ProgressCallback* progress, Error* error)
 {
 	ChdCoreFileWrapper* fileWrapper = ChdCoreFileWrapper::FromCoreFile(chd_core_file(ChdFile));
 	if (!CheckAvailableMemoryForPrecaching(fileWrapper->GetPrecacheSize(), error))
 		return false;
 
-	return fileWrapper->Precache(progress, error);
+	if (!fileWrapper->Precache(progress, error))
+		return false;
+
+	SetPrecacheMemoryUsage(fileWrapper->GetPrecacheSize());
+	return true;
 }
 
 ThreadedFileReader::Chunk ChdFileReader::ChunkForOffset(u64 offset)
@@ -430,6 +611,44 @@ int ChdFileReader::ReadChunk(void* dst, s64 chunkID)
 	if (chunkID < 0)
 		return -1;
 
+	if (m_decompress_threads > 0)
+	{
+		const u32 hunk = static_cast<u32>(chunkID);
+
+		// Only prefetch while the game is streaming, random access would just waste decompression time.
+		if (m_last_hunk >= 0 && hunk == static_cast<u64>(m_last_hunk) + 1)
+		{
+			if (++m_sequential_run >= PREFETCH_MIN_SEQUENTIAL_RUN && m_prefetch_distance == 0)
+				m_prefetch_distance = std::min(m_decompress_threads, m_prefetch_max_depth);
+		}
+		else if (hunk != m_last_hunk)
+		{
+			m_sequential_run = 0;
+			m_prefetch_distance = 0;
+		}
+		m_last_hunk = hunk;
+
+		if (m_workers.empty() && m_prefetch_distance > 0 && !m_workers_failed)
+			StartPrefetchWorkers();
+
+		if (!m_workers.empty())
+		{
+			std::unique_lock lock(m_prefetch_mutex);
+			PrefetchSlot* slot = UpdatePrefetch(hunk, lock);
+			const bool ready = (slot && slot->state == PrefetchState::Ready);
+			if (ready)
+				std::memcpy(dst, slot->data.data(), hunk_size);
+			if (slot)
+				slot->state = PrefetchState::Free;
+
+			QueuePrefetch(hunk);
+			if (ready)
+				return hunk_size;
+
+			// Not prefetched or failed, in which case read it again so we get the error message.
+		}
+	}
+
 	chd_error error = chd_read(ChdFile, chunkID, dst);
 	if (error != CHDERR_NONE)
 	{
@@ -442,6 +661,9 @@ int ChdFileReader::ReadChunk(void* dst, s64 chunkID)
 
 void ChdFileReader::Close2()
 {
+	StopPrefetchWorkers();
+	SetPrecacheMemoryUsage(0);
+
 	if (ChdFile)
 	{
 		chd_close(ChdFile);
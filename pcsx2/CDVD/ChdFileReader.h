@@ -3,6 +3,13 @@
 
 #pragma once
 #include "ThreadedFileReader.h"
+
+#include "common/HeapArray.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 typedef struct _chd_file chd_file;
@@ -26,9 +33,58 @@ public:
 	uint GetBlockCount(void) const override;
 
 private:
+	/// Hunks are prefetched once this many sequential hunks have been read.
+	static constexpr u32 PREFETCH_MIN_SEQUENTIAL_RUN = 2;
+	static constexpr u32 MAX_DECOMPRESS_THREADS = 16;
+	static constexpr u32 MAX_PREFETCH_DEPTH = 256;
+
+	enum class PrefetchState : u8
+	{
+		Free,
+		Queued,
+		Decompressing,
+		Ready,
+		Failed,
+	};
+
+	struct PrefetchSlot
+	{
+		DynamicHeapArray<u8> data;
+		u32 hunk = 0;
+		PrefetchState state = PrefetchState::Free;
+	};
+
 	bool ParseTOC(u64* out_frame_count);
 
+	/// Opens one chd_file per worker, since libchdr handles can't be shared between threads.
+	bool StartPrefetchWorkers();
+	void StopPrefetchWorkers();
+	void PrefetchWorkerThread(chd_file* chd);
+
+	/// Adjusts the prefetch distance to match the access pattern, and returns the slot holding the hunk if it was prefetched.
+	PrefetchSlot* UpdatePrefetch(u32 hunk, std::unique_lock<std::mutex>& lock);
+	/// Queues hunks after the given one, up to the current prefetch distance.
+	void QueuePrefetch(u32 hunk);
+	void DiscardQueuedPrefetch();
+
 	chd_file* ChdFile = nullptr;
 	u64 file_size = 0;
 	u32 hunk_size = 0;
+	u32 hunk_count = 0;
+
+	u32 m_decompress_threads = 0;
+	u32 m_prefetch_max_depth = 0;
+	u32 m_prefetch_distance = 0;
+	u32 m_sequential_run = 0;
+	s64 m_last_hunk = -1;
+
+	std::vector<PrefetchSlot> m_prefetch_slots;
+	std::deque<PrefetchSlot*> m_prefetch_queue;
+	std::vector<chd_file*> m_worker_chds;
+	std::vector<std::thread> m_workers;
+	std::mutex m_prefetch_mutex;
+	std::condition_variable m_prefetch_work_cv;
+	std::condition_variable m_prefetch_done_cv;
+	bool m_workers_failed = false;
+	bool m_workers_quit = false;
 };
@@ -2,16 +2,19 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CsoFileReader.h"
+#include "Config.h"
 
 #include "common/Assertions.h"
 #include "common/Console.h"
 #include "common/FileSystem.h"
 #include "common/Error.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include "fmt/format.h"
 #include "lz4.h"
 
+#include <algorithm>
 #include <zlib.h>
 
 // Implementation of CSO compressed ISO reading, based on:
@@ -29,6 +32,10 @@ struct CsoHeader
 
 static const u32 CSO_READ_BUFFER_SIZE = 256 * 1024;
 
+// Batches smaller than this are decoded on the read thread alone, waking workers isn't worth it.
+static constexpr u32 MIN_FRAMES_PER_DECODE_THREAD = 4;
+static constexpr u32 MAX_DECODE_THREADS = 16;
+
 CsoFileReader::CsoFileReader() = default;
 
 CsoFileReader::~CsoFileReader()
@@ -81,6 +88,9 @@ bool CsoFileReader::Open2(std::string filename, Error* error)
 		Close2();
 		return false;
 	}
+
+	// Workers are only started once we see a batch big enough to split.
+	m_decodeThreads = static_cast<u32>(std::clamp<int>(EmuConfig.CdvdDecompressThreads, 0, MAX_DECODE_THREADS));
 	return true;
 }
 
@@ -103,6 +113,7 @@ bool CsoFileReader::Precache2(ProgressCallback* progress, Error* error)
 		return false;
 	}
 
+	SetPrecacheMemoryUsage(m_file_cache_size);
 	m_readBuffer.reset();
 	std::fclose(m_src);
 	m_src = nullptr;
@@ -144,6 +155,7 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 {
 	// Round up, since part of a frame requires a full frame.
 	u32 numFrames = (u32)((m_totalSize + m_frameSize - 1) / m_frameSize);
+	m_numFrames = numFrames;
 
 	// We might read a bit of alignment too, so be prepared.
 	if (m_frameSize + (1 << m_indexShift) < CSO_READ_BUFFER_SIZE)
@@ -178,6 +190,7 @@ bool CsoFileReader::InitializeBuffers(Error* error)
 
 void CsoFileReader::Close2()
 {
+	StopDecodeWorkers();
 	m_filename.clear();
 
 	if (m_src)
@@ -186,12 +199,16 @@ void CsoFileReader::Close2()
 		m_src = nullptr;
 	}
 	if (m_file_cache)
+	{
 		m_file_cache.reset();
+		SetPrecacheMemoryUsage(0);
+	}
 	if (!m_uselz4)
 		inflateEnd(&m_z_stream);
 
 	m_readBuffer.reset();
 	m_index.reset();
+	m_batchBuffer.deallocate();
 }
 
 u32 CsoFileReader::GetBlockCount() const
@@ -276,35 +293,212 @@ int CsoFileReader::ReadChunk(void* dst, s64 chunkID)
 			readRawBytes = fread(m_readBuffer.get(), 1, frameRawSize, m_src);
 		}
 
-		bool success = false;
+		const bool success = DecompressFrameData(&m_z_stream, readBuffer, readRawBytes, dst);
+		if (!success)
+			Console.Error(fmt::format("Unable to decompress CSO frame using {}", (m_uselz4)? "lz4":"zlib"));
+
+		return success ? m_frameSize : 0;
+	}
+}
+
+bool CsoFileReader::DecompressFrameData(z_stream* zs, const u8* src, u32 srcSize, void* dst) const
+{
+	if (m_uselz4)
+	{
+		// LZ4 is stateless, so it decodes straight from the raw data into the destination.
+		const int dst_size = static_cast<int>(m_frameSize);
+		const int res = LZ4_decompress_safe_partial(
+			reinterpret_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(srcSize), dst_size, dst_size);
+		return (res > 0);
+	}
+
+	zs->next_in = const_cast<Bytef*>(src);
+	zs->avail_in = srcSize;
+	zs->next_out = static_cast<Bytef*>(dst);
+	zs->avail_out = m_frameSize;
+
+	const int status = inflate(zs, Z_FINISH);
+	const bool success = (status == Z_STREAM_END && zs->total_out == m_frameSize);
+	inflateReset(zs);
+	return success;
+}
+
+int CsoFileReader::ReadChunks(void* dst, s64 chunkID, u32 count)
+{
+	if (chunkID < 0 || static_cast<u64>(chunkID) >= m_numFrames)
+		return -1;
+
+	const u32 first = static_cast<u32>(chunkID);
+	count = std::min(count, m_numFrames - first);
+	if (count <= 1)
+		return ReadChunk(dst, chunkID);
+
+	// The index is fully loaded, so the whole batch's raw data can be located up front.
+	const u64 raw_start = static_cast<u64>(m_index[first] & 0x7FFFFFFF) << m_indexShift;
+	const u64 raw_end = static_cast<u64>(m_index[first + count] & 0x7FFFFFFF) << m_indexShift;
+	if (raw_end < raw_start)
+		return ThreadedFileReader::ReadChunks(dst, chunkID, count);
 
-		if (m_uselz4)
+	const size_t raw_size = static_cast<size_t>(raw_end - raw_start);
+	if (m_file_cache)
+	{
+		if (raw_end > m_file_cache_size)
+			return ThreadedFileReader::ReadChunks(dst, chunkID, count);
+
+		m_batchRaw = &m_file_cache[raw_start];
+	}
+	else
+	{
+		// One read for the whole batch, rather than a seek and read per frame.
+		if (m_batchBuffer.size() < raw_size)
+			m_batchBuffer.resize(raw_size);
+
+		// The last frame can be short because of alignment padding, let the per-frame path handle it.
+		if (FileSystem::FSeek64(m_src, raw_start, SEEK_SET) != 0 || std::fread(m_batchBuffer.data(), 1, raw_size, m_src) != raw_size)
+			return ThreadedFileReader::ReadChunks(dst, chunkID, count);
+
+		m_batchRaw = m_batchBuffer.data();
+	}
+
+	m_batchRawStart = raw_start;
+	m_batchDst = static_cast<u8*>(dst);
+	m_batchFirstFrame = first;
+
+	const u32 max_groups = std::max(count / MIN_FRAMES_PER_DECODE_THREAD, 1u);
+	if (max_groups > 1 && m_decodeThreads > 0 && !m_workersStarted)
+		StartDecodeWorkers();
+
+	const u32 num_groups = std::min(max_groups, static_cast<u32>(m_workers.size()) + 1);
+	const u32 frames_per_group = (count + num_groups - 1) / num_groups;
+
+	std::unique_lock lock(m_batchMutex);
+	m_batchFailed = false;
+	if (num_groups > 1)
+	{
+		for (u32 start = frames_per_group; start < count; start += frames_per_group)
 		{
-			const int src_size = static_cast<int>(readRawBytes);
-			const int dst_size = static_cast<int>(m_frameSize);
-			const char* src_buf = reinterpret_cast<const char*>(readBuffer);
-			char* dst_buf = static_cast<char*>(dst);
-			
-			const int res = LZ4_decompress_safe_partial(src_buf, dst_buf, src_size, dst_size, dst_size);
-			success = (res > 0);
+			m_batchJobs.emplace_back(start, std::min(start + frames_per_group, count));
+			m_batchPending++;
 		}
-		else
+		m_batchWorkCV.notify_all();
+	}
+	lock.unlock();
+
+	// The read thread takes the first group, since that's what the reader is waiting on.
+	bool success = DecodeBatchFrames(&m_z_stream, 0, std::min(frames_per_group, count));
+
+	lock.lock();
+	m_batchDoneCV.wait(lock, [this]() { return m_batchPending == 0; });
+	success = success && !m_batchFailed;
+	lock.unlock();
+
+	// Fall back to reading individually, so the failing frame gets logged and the rest is still returned.
+	if (!success)
+		return ThreadedFileReader::ReadChunks(dst, chunkID, count);
+
+	return static_cast<int>(count * m_frameSize);
+}
+
+bool CsoFileReader::DecodeBatchFrames(z_stream* zs, u32 start, u32 end) const
+{
+	for (u32 i = start; i < end; i++)
+	{
+		const u32 frame = m_batchFirstFrame + i;
+		const bool compressed = (m_index[frame + 0] & 0x80000000) == 0;
+		const u64 frameRawPos = static_cast<u64>(m_index[frame + 0] & 0x7FFFFFFF) << m_indexShift;
+		const u64 frameRawEnd = static_cast<u64>(m_index[frame + 1] & 0x7FFFFFFF) << m_indexShift;
+		if (frameRawEnd < frameRawPos)
+			return false;
+
+		const u8* src = m_batchRaw + (frameRawPos - m_batchRawStart);
+		const u32 srcSize = static_cast<u32>(frameRawEnd - frameRawPos);
+		u8* dst = m_batchDst + static_cast<size_t>(i) * m_frameSize;
+		if (!compressed)
 		{
-			m_z_stream.next_in = readBuffer;
-			m_z_stream.avail_in = readRawBytes;
-			m_z_stream.next_out = static_cast<Bytef*>(dst);
-			m_z_stream.avail_out = m_frameSize;
+			if (srcSize < m_frameSize)
+				return false;
 
-			const int status = inflate(&m_z_stream, Z_FINISH);
-			success = (status == Z_STREAM_END && m_z_stream.total_out == m_frameSize);
+			std::memcpy(dst, src, m_frameSize);
 		}
+		else if (!DecompressFrameData(zs, src, srcSize, dst))
+		{
+			return false;
+		}
+	}
 
-		if (!success)
-			Console.Error(fmt::format("Unable to decompress CSO frame using {}", (m_uselz4)? "lz4":"zlib"));
-		
-		if (!m_uselz4)
-			inflateReset(&m_z_stream);
+	return true;
+}
 
-		return success ? m_frameSize : 0;
+bool CsoFileReader::StartDecodeWorkers()
+{
+	m_workersStarted = true;
+
+	m_workerStreams = std::make_unique<z_stream[]>(m_decodeThreads);
+	for (u32 i = 0; i < m_decodeThreads; i++)
+	{
+		m_workerStreams[i] = {};
+		if (!m_uselz4 && inflateInit2(&m_workerStreams[i], -15) != Z_OK)
+		{
+			Console.Warning("CsoFileReader: Unable to initialize zlib for decode thread.");
+			break;
+		}
+
+		m_workers.emplace_back(&CsoFileReader::DecodeWorkerThread, this, &m_workerStreams[i]);
+	}
+
+	DevCon.WriteLn("CsoFileReader: Started %zu decode threads.", m_workers.size());
+	return !m_workers.empty();
+}
+
+void CsoFileReader::StopDecodeWorkers()
+{
+	if (!m_workersStarted)
+		return;
+
+	{
+		std::unique_lock lock(m_batchMutex);
+		m_workersQuit = true;
+		m_batchWorkCV.notify_all();
+	}
+
+	for (std::thread& thread : m_workers)
+		thread.join();
+
+	if (!m_uselz4)
+	{
+		for (size_t i = 0; i < m_workers.size(); i++)
+			inflateEnd(&m_workerStreams[i]);
+	}
+
+	m_workers.clear();
+	m_workerStreams.reset();
+	m_batchJobs.clear();
+	m_batchPending = 0;
+	m_workersQuit = false;
+	m_workersStarted = false;
+}
+
+void CsoFileReader::DecodeWorkerThread(z_stream* zs)
+{
+	Threading::SetNameOfCurrentThread("CSO Decompress");
+
+	std::unique_lock lock(m_batchMutex);
+	for (;;)
+	{
+		m_batchWorkCV.wait(lock, [this]() { return m_workersQuit || !m_batchJobs.empty(); });
+		if (m_workersQuit)
+			return;
+
+		const auto [start, end] = m_batchJobs.back();
+		m_batchJobs.pop_back();
+		lock.unlock();
+
+		const bool success = DecodeBatchFrames(zs, start, end);
+
+		lock.lock();
+		if (!success)
+			m_batchFailed = true;
+		if (--m_batchPending == 0)
+			m_batchDoneCV.notify_all();
 	}
 }
@@ -4,6 +4,14 @@
 #pragma once
 
 #include "ThreadedFileReader.h"
+
+#include "common/HeapArray.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <zlib.h>
 
 struct CsoHeader;
@@ -22,6 +30,7 @@ public:
 
 	Chunk ChunkForOffset(u64 offset) override;
 	int ReadChunk(void* dst, s64 chunkID) override;
+	int ReadChunks(void* dst, s64 chunkID, u32 count) override;
 
 	void Close2() override;
 
@@ -34,6 +43,13 @@ private:
 	int ReadFromFrame(u8* dest, u64 pos, int maxBytes);
 	bool DecompressFrame(Bytef* dst, u32 frame, u32 readBufferSize);
 	bool DecompressFrame(u32 frame, u32 readBufferSize);
+	bool DecompressFrameData(z_stream* zs, const u8* src, u32 srcSize, void* dst) const;
+	/// Decodes frames [start, end) of the current batch, which may run on any decode thread
+	bool DecodeBatchFrames(z_stream* zs, u32 start, u32 end) const;
+
+	bool StartDecodeWorkers();
+	void StopDecodeWorkers();
+	void DecodeWorkerThread(z_stream* zs);
 
 	u32 m_frameSize = 0;
 	u8 m_frameShift = 0;
@@ -48,4 +64,25 @@ private:
 	std::unique_ptr<u8[]> m_file_cache;
 	size_t m_file_cache_size = 0;
 	z_stream m_z_stream = {};
+	u32 m_numFrames = 0;
+
+	// Raw data for a batch of consecutive frames, read with a single fread unless the file is precached.
+	DynamicHeapArray<u8> m_batchBuffer;
+	const u8* m_batchRaw = nullptr;
+	u64 m_batchRawStart = 0;
+	u8* m_batchDst = nullptr;
+	u32 m_batchFirstFrame = 0;
+
+	// Extra threads which decode part of each batch alongside the read thread.
+	u32 m_decodeThreads = 0;
+	bool m_workersStarted = false;
+	std::vector<std::thread> m_workers;
+	std::unique_ptr<z_stream[]> m_workerStreams;
+	std::vector<std::pair<u32, u32>> m_batchJobs;
+	u32 m_batchPending = 0;
+	bool m_batchFailed = false;
+	bool m_workersQuit = false;
+	std::mutex m_batchMutex;
+	std::condition_variable m_batchWorkCV;
+	std::condition_variable m_batchDoneCV;
 };
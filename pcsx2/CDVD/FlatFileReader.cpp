@@ -7,12 +7,26 @@
 #include "common/Console.h"
 #include "common/FileSystem.h"
 #include "common/Error.h"
+#include "common/ProgressCallback.h"
 
 #include <cerrno>
 #include <cstring>
 
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
 static constexpr size_t CHUNK_SIZE = 128 * 1024;
 
+// How far past the current read the OS is asked to fault in a mapped image.
+static constexpr u64 MAPPED_READAHEAD_SIZE = 1024 * 1024;
+
+// How much of a mapped image is faulted in between progress updates when precaching.
+static constexpr u64 MAPPED_PRECACHE_STEP = 16 * 1024 * 1024;
+
 FlatFileReader::FlatFileReader() = default;
 
 FlatFileReader::~FlatFileReader()
@@ -35,14 +49,102 @@ bool FlatFileReader::Open2(std::string filename, Error* error)
 	}
 
 	m_file_size = static_cast<u64>(filesize);
+	MapFile();
 	return true;
 }
 
+void FlatFileReader::MapFile()
+{
+#ifdef _WIN32
+	const HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+	const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		Console.Warning("FlatFileReader: CreateFileMapping() failed: %u", GetLastError());
+		return;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		Console.Warning("FlatFileReader: MapViewOfFile() failed: %u", GetLastError());
+		CloseHandle(mapping);
+		return;
+	}
+
+	m_mapping_handle = mapping;
+	m_mapping = static_cast<const u8*>(view);
+#else
+	void* view = mmap(nullptr, m_file_size, PROT_READ, MAP_SHARED, fileno(m_file), 0);
+	if (view == MAP_FAILED)
+	{
+		Console.Warning("FlatFileReader: mmap() failed: %d", errno);
+		return;
+	}
+
+	m_mapping = static_cast<const u8*>(view);
+#endif
+
+	m_prefetch_start = 0;
+	m_prefetch_end = 0;
+}
+
+void FlatFileReader::UnmapFile()
+{
+	if (!m_mapping)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_mapping);
+	CloseHandle(m_mapping_handle);
+	m_mapping_handle = nullptr;
+#else
+	munmap(const_cast<u8*>(m_mapping), m_file_size);
+#endif
+
+	m_mapping = nullptr;
+}
+
+const u8* FlatFileReader::GetDirectPointer(u64 offset, u32 size)
+{
+	if (!m_mapping || offset >= m_file_size || size > m_file_size - offset)
+		return nullptr;
+
+	return m_mapping + offset;
+}
+
+void FlatFileReader::PrefetchDirect(u64 offset, u64 size)
+{
+	// Sequential reads only need a new hint once they get halfway through the last one.
+	// Anything outside the window is a seek, so start prefetching from the new target.
+	if (offset >= m_prefetch_start && (offset + size + MAPPED_READAHEAD_SIZE / 2) <= m_prefetch_end)
+		return;
+
+	const u64 start = offset & ~static_cast<u64>(__pagemask);
+	const u64 end = std::min<u64>(offset + size + MAPPED_READAHEAD_SIZE, m_file_size);
+	m_prefetch_start = start;
+	m_prefetch_end = end;
+
+#ifdef _WIN32
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = const_cast<u8*>(m_mapping + start);
+	range.NumberOfBytes = static_cast<SIZE_T>(end - start);
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	madvise(const_cast<u8*>(m_mapping + start), static_cast<size_t>(end - start), MADV_WILLNEED);
+#endif
+}
+
 bool FlatFileReader::Precache2(ProgressCallback* progress, Error* error)
 {
 	if (!m_file || !CheckAvailableMemoryForPrecaching(m_file_size, error))
 		return false;
 
+	// Mapped images are read straight out of the page cache, which other instances using the same
+	// image share. Faulting it all in gives the same result as a private copy, without duplicating it.
+	if (m_mapping)
+		return PrecacheMapping(progress);
+
 	m_file_cache = std::make_unique_for_overwrite<u8[]>(m_file_size);
 	if (FileSystem::FSeek64(m_file, 0, SEEK_SET) != 0 ||
 		FileSystem::ReadFileWithProgress(
@@ -52,11 +154,41 @@ bool FlatFileReader::Precache2(ProgressCallback* progress, Error* error)
 		return false;
 	}
 
+	SetPrecacheMemoryUsage(m_file_size);
+
+	// The cache is served through ReadChunk(), and there's no point keeping the file mapped alongside it.
+	UnmapFile();
 	std::fclose(m_file);
 	m_file = nullptr;
 	return true;
 }
 
+bool FlatFileReader::PrecacheMapping(ProgressCallback* progress)
+{
+	progress->SetProgressRange(100);
+
+	for (u64 done = 0; done < m_file_size;)
+	{
+		if (progress->IsCancelled())
+			return false;
+
+		const u64 size = std::min<u64>(m_file_size - done, MAPPED_PRECACHE_STEP);
+		PrefetchDirect(done, size);
+
+		// The hint is only advisory, touching every page is what actually makes them resident.
+		for (u64 offset = done; offset < (done + size); offset += __pagesize)
+			static_cast<void>(*static_cast<const volatile u8*>(m_mapping + offset));
+
+		done += size;
+		progress->SetProgressValue(static_cast<u32>((done * 100) / m_file_size));
+	}
+
+	// Let the first real read ask for readahead again.
+	m_prefetch_start = 0;
+	m_prefetch_end = 0;
+	return true;
+}
+
 ThreadedFileReader::Chunk FlatFileReader::ChunkForOffset(u64 offset)
 {
 	ThreadedFileReader::Chunk chunk = {};
@@ -100,6 +232,14 @@ int FlatFileReader::ReadChunk(void* dst, s64 blockID)
 
 void FlatFileReader::Close2()
 {
+	UnmapFile();
+
+	if (m_file_cache)
+	{
+		m_file_cache.reset();
+		SetPrecacheMemoryUsage(0);
+	}
+
 	if (!m_file)
 		return;
 
@@ -15,6 +15,22 @@ class FlatFileReader final : public ThreadedFileReader
 	std::unique_ptr<u8[]> m_file_cache;
 	u64 m_file_size = 0;
 
+	// Read-only view of the whole file, so sectors can be copied straight out of the page cache.
+	const u8* m_mapping = nullptr;
+#ifdef _WIN32
+	void* m_mapping_handle = nullptr;
+#endif
+	u64 m_prefetch_start = 0;
+	u64 m_prefetch_end = 0;
+
+	void MapFile();
+	void UnmapFile();
+	bool PrecacheMapping(ProgressCallback* progress);
+
+protected:
+	const u8* GetDirectPointer(u64 offset, u32 size) override;
+	void PrefetchDirect(u64 offset, u64 size) override;
+
 public:
 	FlatFileReader();
 	~FlatFileReader() override;
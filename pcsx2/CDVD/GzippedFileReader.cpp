@@ -11,6 +11,7 @@
 #include "common/Error.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/Timer.h"
 
 #include "fmt/format.h"
@@ -151,33 +152,153 @@ bool GzippedFileReader::LoadOrCreateIndex(Error* error)
 	if ((m_index = ReadIndexFromFile(indexfile.c_str())) != nullptr)
 	{
 		INFO_LOG("Gzip quick access index read from disk: '{}'", indexfile);
+		m_uncompressed_size.store(m_index->uncompressed_size, std::memory_order_release);
+		m_index_complete = true;
 		return true;
 	}
 
-	// No valid index file. Generate an index
-	Console.Warning("This may take a while (but only once). Scanning compressed file to generate a quick access index...");
+	// No valid index file. Generate one in the background, with its own file handle so reads can continue.
+	std::FILE* fp = FileSystem::OpenCFile(m_filename.c_str(), "rb", error);
+	if (!fp)
+		return false;
+
+	Console.Warning("Scanning compressed file in the background to generate a quick access index...");
+
+	m_index = static_cast<Access*>(std::calloc(1, sizeof(Access)));
+	m_index->list = static_cast<Point*>(std::malloc(sizeof(Point) * 8));
+	m_index->size = 8;
+	m_index->span = GZFILE_SPAN_DEFAULT;
+	m_index_cancel.store(false, std::memory_order_relaxed);
+	m_index_complete = false;
+	m_index_failed = false;
+	m_index_thread = std::thread(&GzippedFileReader::IndexThread, this, fp, indexfile);
 
-	const s64 prevoffset = FileSystem::FTell64(m_src);
-	Access* index = nullptr;
-	int len = build_index(m_src, GZFILE_SPAN_DEFAULT, &index);
-	printf("\n"); // build_index prints progress without \n's
-	FileSystem::FSeek64(m_src, prevoffset, SEEK_SET);
+	// The first access point is at the start of the stream, after that the volume descriptor can be read.
+	std::unique_lock lock(m_index_mutex);
+	m_index_cv.wait(lock, [this]() { return m_index_complete || m_index->have > 0; });
 
-	if (len >= 0)
+	const s64 estimated_size = m_index_complete ? 0 : EstimateUncompressedSize();
+	if (estimated_size > 0)
 	{
-		m_index = index;
-		WriteIndexToFile(m_index, indexfile.c_str());
+		m_uncompressed_size.store(estimated_size, std::memory_order_release);
 	}
 	else
 	{
-		Error::SetStringFmt(error, "ERROR ({}): Index could not be generated for file '{}'", len, m_filename);
-		free_index(index);
+		Console.Warning("Image size is unknown, waiting for the index to finish...");
+		m_index_cv.wait(lock, [this]() { return m_index_complete; });
+	}
+
+	if (m_index_failed)
+	{
+		Error::SetStringFmt(error, "Index could not be generated for file '{}'", m_filename);
 		return false;
 	}
 
 	return true;
 }
 
+void GzippedFileReader::IndexThread(std::FILE* fp, std::string index_filename)
+{
+	Threading::SetNameOfCurrentThread("Gzip Indexer");
+
+	Common::Timer timer;
+	s64 total = 0;
+	const int ret = build_index_points(fp, GZFILE_SPAN_DEFAULT, &m_index_cancel, &total,
+		[this](int bits, s64 in, s64 out, unsigned left, unsigned char* window) {
+			{
+				std::unique_lock lock(m_index_mutex);
+
+				// Grow the list here rather than in addpoint(), which frees the whole index on failure.
+				if (m_index->have == m_index->size)
+				{
+					Point* list = static_cast<Point*>(std::realloc(m_index->list, sizeof(Point) * m_index->size * 2));
+					if (!list)
+						return false;
+
+					m_index->list = list;
+					m_index->size *= 2;
+				}
+
+				addpoint(m_index, bits, in, out, left, window);
+			}
+
+			m_index_cv.notify_all();
+			return true;
+		});
+	printf("\n"); // build_index_points prints progress without \n's
+	std::fclose(fp);
+
+	{
+		std::unique_lock lock(m_index_mutex);
+		if (ret == Z_OK && m_index->have > 0)
+		{
+			const s64 estimated_size = m_uncompressed_size.load(std::memory_order_acquire);
+			if (estimated_size != 0 && estimated_size != total)
+				WARNING_LOG("Gzip image is {} bytes, but {} bytes were expected.", total, estimated_size);
+
+			m_index->uncompressed_size = total;
+			m_uncompressed_size.store(total, std::memory_order_release);
+			INFO_LOG("Gzip quick access index built in {:.2f} seconds.", timer.GetTimeSeconds());
+			WriteIndexToFile(m_index, index_filename.c_str());
+		}
+		else
+		{
+			if (!m_index_cancel.load(std::memory_order_relaxed))
+				ERROR_LOG("ERROR ({}): Index could not be generated for file '{}'", ret, m_filename);
+			m_index_failed = true;
+		}
+
+		m_index_complete = true;
+	}
+
+	m_index_cv.notify_all();
+}
+
+void GzippedFileReader::StopIndexThread()
+{
+	if (!m_index_thread.joinable())
+		return;
+
+	m_index_cancel.store(true, std::memory_order_relaxed);
+	m_index_thread.join();
+}
+
+s64 GzippedFileReader::EstimateUncompressedSize()
+{
+	// ISIZE in the gzip trailer is the uncompressed size modulo 4GB, the volume size picks the right multiple.
+	u8 trailer[4];
+	if (FileSystem::FSeek64(m_src, -4, SEEK_END) != 0 || std::fread(trailer, sizeof(trailer), 1, m_src) != 1)
+		return 0;
+
+	const u32 isize = static_cast<u32>(trailer[0]) | (static_cast<u32>(trailer[1]) << 8) |
+					  (static_cast<u32>(trailer[2]) << 16) | (static_cast<u32>(trailer[3]) << 24);
+
+	// Primary volume descriptor at LBA 16, for 2048 byte ISOs and mode 1/mode 2 CD images.
+	static constexpr std::pair<s64, s64> pvd_locations[] = {{16 * 2048, 2048}, {16 * 2352 + 24, 2352}, {16 * 2352 + 16, 2352}};
+	for (const auto& [offset, sector_size] : pvd_locations)
+	{
+		zstate state = {};
+		u8 pvd[2048];
+		const int len = extract(m_src, m_index, offset, pvd, sizeof(pvd), &state);
+		if (state.isValid)
+			inflateEnd(&state.strm);
+
+		if (len != static_cast<int>(sizeof(pvd)) || pvd[0] != 1 || std::memcmp(&pvd[1], "CD001", 5) != 0)
+			continue;
+
+		const u32 volume_blocks = static_cast<u32>(pvd[80]) | (static_cast<u32>(pvd[81]) << 8) |
+								  (static_cast<u32>(pvd[82]) << 16) | (static_cast<u32>(pvd[83]) << 24);
+		const s64 volume_size = static_cast<s64>(volume_blocks) * sector_size;
+		s64 size = isize;
+		while (size < volume_size)
+			size += (static_cast<s64>(1) << 32);
+
+		return size;
+	}
+
+	return 0;
+}
+
 bool GzippedFileReader::Open2(std::string filename, Error* error)
 {
 	Close();
@@ -194,6 +315,8 @@ bool GzippedFileReader::Open2(std::string filename, Error* error)
 
 void GzippedFileReader::Close2()
 {
+	StopIndexThread();
+
 	if (m_z_state.isValid)
 	{
 		inflateEnd(&m_z_state.strm);
@@ -211,12 +334,16 @@ void GzippedFileReader::Close2()
 		free_index(m_index);
 		m_index = nullptr;
 	}
+
+	m_index_complete = false;
+	m_index_failed = false;
+	m_uncompressed_size.store(0, std::memory_order_relaxed);
 }
 
 ThreadedFileReader::Chunk GzippedFileReader::ChunkForOffset(u64 offset)
 {
 	ThreadedFileReader::Chunk chunk = {};
-	if (static_cast<s64>(offset) >= m_index->uncompressed_size)
+	if (static_cast<s64>(offset) >= m_uncompressed_size.load(std::memory_order_acquire))
 	{
 		chunk.chunkID = -1;
 	}
@@ -236,11 +363,21 @@ int GzippedFileReader::ReadChunk(void* dst, s64 chunkID)
 		return -1;
 
 	const s64 file_offset = chunkID * m_index->span;
-	const u32 read_len = static_cast<u32>(std::min<s64>(m_index->uncompressed_size - file_offset, m_index->span));
+	const u32 read_len = static_cast<u32>(std::min<s64>(m_uncompressed_size.load(std::memory_order_acquire) - file_offset, m_index->span));
+
+	// While the index is being built, wait until there's an access point within a span of the chunk,
+	// so the read costs the same as it would with the full index.
+	std::unique_lock lock(m_index_mutex);
+	m_index_cv.wait(lock, [this, file_offset]() {
+		return m_index_complete || (m_index->list[m_index->have - 1].out + m_index->span) >= file_offset;
+	});
+	if (m_index_failed)
+		return -1;
+
 	return extract(m_src, m_index, file_offset, static_cast<unsigned char*>(dst), read_len, &m_z_state);
 }
 
 u32 GzippedFileReader::GetBlockCount() const
 {
-	return (m_index->uncompressed_size + (m_blocksize - 1)) / m_blocksize;
+	return (m_uncompressed_size.load(std::memory_order_acquire) + (m_blocksize - 1)) / m_blocksize;
 }
@@ -6,6 +6,11 @@
 #include "CDVD/ThreadedFileReader.h"
 #include "zlib_indexed.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 class GzippedFileReader final : public ThreadedFileReader
 {
 	DeclareNoncopyableObject(GzippedFileReader);
@@ -31,9 +36,25 @@ private:
 	// Verifies that we have an index, or try to create one
 	bool LoadOrCreateIndex(Error* error);
 
+	// Builds the index on a worker thread, reads only wait for the access points they need.
+	void IndexThread(std::FILE* fp, std::string index_filename);
+	void StopIndexThread();
+
+	// Works out the image size from the ISO volume descriptor and the gzip trailer,
+	// so the image can be opened before the index is complete. Returns 0 if unknown.
+	s64 EstimateUncompressedSize();
+
 	Access* m_index = nullptr; // Quick access index
 
 	std::FILE* m_src = nullptr;
 
 	zstate m_z_state = {};
+
+	std::thread m_index_thread;
+	std::mutex m_index_mutex;
+	std::condition_variable m_index_cv;
+	std::atomic_bool m_index_cancel{false};
+	bool m_index_complete = false;
+	bool m_index_failed = false;
+	std::atomic<s64> m_uncompressed_size{0};
 };
@@ -13,11 +13,16 @@
 #include "common/Assertions.h"
 #include "common/Console.h"
 #include "common/Error.h"
+#include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
 
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 static const char* nameFromType(int type)
 {
 	switch (type)
@@ -56,6 +61,132 @@ static std::unique_ptr<ThreadedFileReader> GetFileReader(const std::string& path
 	return std::make_unique<FlatFileReader>();
 }
 
+void IsoReadProfile::Open(std::string path)
+{
+	Close();
+	m_path = std::move(path);
+
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(m_path.c_str());
+	if (!data.has_value())
+		return;
+
+	u32 header[3];
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(header, data->data(), sizeof(header));
+	if (header[0] != MAGIC || header[1] != VERSION || header[2] > MAX_EXTENTS ||
+		(data->size() - sizeof(header)) < (header[2] * sizeof(Extent)))
+	{
+		Console.Warning("isoFile: Ignoring invalid read profile '%s'", m_path.c_str());
+		return;
+	}
+
+	m_profile.resize(header[2]);
+	std::memcpy(m_profile.data(), data->data() + sizeof(header), header[2] * sizeof(Extent));
+
+	m_profile_lookup.reserve(m_profile.size());
+	for (u32 i = 0; i < static_cast<u32>(m_profile.size()); i++)
+	{
+		if (m_profile[i].count > 0)
+			m_profile_lookup.emplace_back(m_profile[i].lsn, i);
+	}
+	std::sort(m_profile_lookup.begin(), m_profile_lookup.end());
+
+	DevCon.WriteLn("isoFile: Predicting reads from %zu extents in '%s'", m_profile.size(), m_path.c_str());
+}
+
+void IsoReadProfile::Close()
+{
+	if (!m_path.empty() && !m_trace.empty())
+	{
+		// The newest session goes first, so the oldest ones are dropped when it's full.
+		std::vector<Extent> extents = std::move(m_trace);
+		if (!m_profile.empty() && extents.size() < MAX_EXTENTS)
+		{
+			extents.push_back({0, 0});
+			const size_t count = std::min<size_t>(m_profile.size(), MAX_EXTENTS - extents.size());
+			extents.insert(extents.end(), m_profile.begin(), m_profile.begin() + count);
+		}
+
+		const u32 header[3] = {MAGIC, VERSION, static_cast<u32>(extents.size())};
+		std::vector<u8> data(sizeof(header) + extents.size() * sizeof(Extent));
+		std::memcpy(data.data(), header, sizeof(header));
+		std::memcpy(data.data() + sizeof(header), extents.data(), extents.size() * sizeof(Extent));
+		if (FileSystem::WriteBinaryFile(m_path.c_str(), data.data(), data.size()))
+			DevCon.WriteLn("isoFile: Wrote %zu extents to '%s'", extents.size(), m_path.c_str());
+		else
+			Console.Error("isoFile: Failed to write read profile '%s'", m_path.c_str());
+	}
+
+	m_path = {};
+	m_profile = {};
+	m_profile_lookup = {};
+	m_trace = {};
+	m_prediction.clear();
+	m_position = NO_POSITION;
+	m_predicted_begin = 0;
+	m_predicted_end = 0;
+}
+
+std::span<const IsoReadProfile::Extent> IsoReadProfile::AddRead(u32 lsn)
+{
+	if (!m_trace.empty())
+	{
+		// Sequential reads carry on with the current extent, the reader's readahead already covers those.
+		Extent& last = m_trace.back();
+		if (lsn >= last.lsn && lsn <= last.lsn + last.count)
+		{
+			last.count = std::max(last.count, lsn - last.lsn + 1);
+			return {};
+		}
+	}
+
+	if (m_trace.size() < MAX_EXTENTS)
+		m_trace.push_back({lsn, 1});
+
+	Predict(lsn);
+	return m_prediction;
+}
+
+void IsoReadProfile::Predict(u32 lsn)
+{
+	m_prediction.clear();
+
+	const auto begin = std::lower_bound(m_profile_lookup.begin(), m_profile_lookup.end(), std::make_pair(lsn, 0u));
+	const auto end = std::upper_bound(begin, m_profile_lookup.end(), std::make_pair(lsn, std::numeric_limits<u32>::max()));
+	if (begin == end)
+		return;
+
+	// Files which are loaded more than once, e.g. on every level, are followed by different ones each time.
+	// Taking the first match after the last one keeps following the same recording.
+	auto match = begin;
+	if (m_position != NO_POSITION)
+	{
+		match = std::upper_bound(begin, end, std::make_pair(lsn, static_cast<u32>(m_position)));
+		if (match == end)
+			match = begin;
+	}
+	m_position = match->second;
+
+	u32 sectors = 0;
+	size_t pos = m_position + 1;
+	for (; pos < m_profile.size() && pos <= (m_position + LOOKAHEAD_EXTENTS) && sectors < LOOKAHEAD_SECTORS; pos++)
+	{
+		const Extent& extent = m_profile[pos];
+		if (extent.count == 0)
+			break;
+
+		const u32 count = std::min(extent.count, LOOKAHEAD_SECTORS - sectors);
+		sectors += count;
+		if (pos < m_predicted_begin || pos >= m_predicted_end)
+			m_prediction.push_back({extent.lsn, count});
+	}
+
+	m_predicted_begin = m_position + 1;
+	m_predicted_end = pos;
+}
+
 int InputIsoFile::ReadSync(u8* dst, uint lsn)
 {
 	if (lsn >= m_blocks)
@@ -85,8 +216,23 @@ void InputIsoFile::BeginRead2(uint lsn)
 
 	m_read_lsn = lsn;
 
-	m_reader->BeginRead(m_readbuffer, m_read_lsn, 1);
-	m_read_inprogress = true;
+	// Uncompressed images can be copied straight out of the page cache when the read completes.
+	m_read_direct = m_reader->GetDirectRead(m_read_lsn, 1);
+	if (!m_read_direct)
+	{
+		m_reader->BeginRead(m_readbuffer, m_read_lsn, 1);
+		m_read_inprogress = true;
+	}
+
+	// After the read itself, so it doesn't have to wait behind the prefetch.
+	if (m_read_profile.IsOpen())
+	{
+		for (const IsoReadProfile::Extent& extent : m_read_profile.AddRead(lsn))
+		{
+			if (extent.lsn < m_blocks)
+				m_reader->PrefetchSectors(extent.lsn, std::min(extent.count, m_blocks - extent.lsn));
+		}
+	}
 }
 
 int InputIsoFile::FinishRead3(u8* dst, uint mode)
@@ -152,7 +298,7 @@ int InputIsoFile::FinishRead3(u8* dst, uint mode)
 
 	length = end - _offset;
 
-	std::memcpy(dst + diff, m_readbuffer + ndiff, length);
+	std::memcpy(dst + diff, (m_read_direct ? m_read_direct : m_readbuffer) + ndiff, length);
 
 	if (m_type == ISOTYPE_CD && diff >= 12)
 	{
@@ -186,6 +332,7 @@ void InputIsoFile::_init()
 	m_read_inprogress = false;
 	m_current_lsn = -1;
 	m_read_lsn = -1;
+	m_read_direct = nullptr;
 	m_reader.reset();
 }
 
@@ -221,13 +368,41 @@ bool InputIsoFile::Open(std::string srcfile, Error* error)
 	return true;
 }
 
-bool InputIsoFile::Precache(ProgressCallback* progress, Error* error)
+bool InputIsoFile::Precache(ProgressCallback* progress, bool background, Error* error)
 {
+	if (background)
+		return m_reader->StartBackgroundPrecache(error);
+
+	// Precaching drops the reader's mapping, so make sure we don't reuse a pointer into it.
+	m_read_direct = nullptr;
+	m_read_lsn = -1;
+
 	return m_reader->Precache(progress, error);
 }
 
+void InputIsoFile::SetReadProfile(std::string path)
+{
+	if (path == m_read_profile.GetPath())
+		return;
+
+	m_read_profile.Close();
+	if (path.empty() || !m_reader)
+		return;
+
+	Error error;
+	if (!m_reader->EnablePrefetch(&error))
+	{
+		Console.Warning(fmt::format("isoFile: Not predicting reads: {}", error.GetDescription()));
+		return;
+	}
+
+	m_read_profile.Open(std::move(path));
+}
+
 void InputIsoFile::Close()
 {
+	m_read_profile.Close();
+
 	if (m_reader)
 	{
 		m_reader->Close();
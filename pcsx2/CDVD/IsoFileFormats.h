@@ -6,6 +6,7 @@
 #include "CDVD/CDVD.h"
 #include "CDVD/ThreadedFileReader.h"
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -23,6 +24,57 @@ enum isoType
 
 static constexpr int CD_FRAMESIZE_RAW = 2448;
 
+// --------------------------------------------------------------------------------------
+//  IsoReadProfile
+// --------------------------------------------------------------------------------------
+// Records the extents a game reads from the disc, and matches them against the recordings
+// from earlier sessions to predict which ones it's going to read next. Games tend to load
+// the same files in the same order at boot and between levels, so those can be prefetched
+// while the game is still busy with the current one.
+class IsoReadProfile final
+{
+public:
+	struct Extent
+	{
+		u32 lsn;
+		u32 count; ///< Zero separates the recordings of different sessions.
+	};
+
+	const std::string& GetPath() const { return m_path; }
+	bool IsOpen() const { return !m_path.empty(); }
+
+	void Open(std::string path);
+	/// Writes the recording of this session in front of the earlier ones.
+	void Close();
+
+	/// Adds a sector read by the game. Returns the extents which are expected to be read next and haven't been
+	/// predicted already.
+	std::span<const Extent> AddRead(u32 lsn);
+
+private:
+	static constexpr u32 MAGIC = 0x46504443; // CDPF
+	static constexpr u32 VERSION = 1;
+	static constexpr u32 MAX_EXTENTS = 32768;
+
+	// How far ahead to prefetch after each match.
+	static constexpr u32 LOOKAHEAD_EXTENTS = 8;
+	static constexpr u32 LOOKAHEAD_SECTORS = 8192;
+
+	static constexpr size_t NO_POSITION = static_cast<size_t>(-1);
+
+	void Predict(u32 lsn);
+
+	std::string m_path;
+	std::vector<Extent> m_profile;
+	/// Start LSN and position of each extent in `m_profile`, sorted for lookups.
+	std::vector<std::pair<u32, u32>> m_profile_lookup;
+	std::vector<Extent> m_trace;
+	std::vector<Extent> m_prediction;
+	size_t m_position = NO_POSITION;
+	size_t m_predicted_begin = 0;
+	size_t m_predicted_end = 0;
+};
+
 // --------------------------------------------------------------------------------------
 //  isoFile
 // --------------------------------------------------------------------------------------
@@ -50,6 +102,11 @@ protected:
 	uint m_read_lsn;
 	u8 m_readbuffer[CD_FRAMESIZE_RAW];
 
+	// Points into the reader's memory mapping when the sector could be read in place, otherwise m_readbuffer is used.
+	const u8* m_read_direct;
+
+	IsoReadProfile m_read_profile;
+
 public:
 	InputIsoFile();
 	~InputIsoFile();
@@ -66,7 +123,9 @@ public:
 	}
 
 	bool Open(std::string srcfile, Error* error);
-	bool Precache(ProgressCallback* progress, Error* error);
+	bool Precache(ProgressCallback* progress, bool background, Error* error);
+	/// Records reads to the profile at path, and prefetches the ones it predicts. An empty path stops it.
+	void SetReadProfile(std::string path);
 	void Close();
 	bool Detect(bool readType = true);
 
@@ -12,6 +12,8 @@
 #include "fmt/format.h"
 
 #include <algorithm>
+#include <array>
+#include <future>
 
 IsoHasher::IsoHasher() = default;
 
@@ -146,31 +148,60 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 	// use 2048 byte reads for DVDs, otherwise 2352 raw.
 	const int read_mode = m_is_cd ? CDVD_MODE_2352 : CDVD_MODE_2048;
 	const u32 sector_size = m_is_cd ? 2352 : 2048;
-	std::vector<u8> sector_buffer(sector_size);
 
-	const u32 update_interval = std::max<u32>(track.sectors / 100u, 1u);
+	// Sectors are read into one buffer while the previous one is hashed on another thread,
+	// so reading from disk and MD5 overlap instead of taking turns.
+	static constexpr u32 CHUNK_SECTORS = 256;
+	std::array<std::vector<u8>, 2> chunk_buffers;
+	for (std::vector<u8>& buffer : chunk_buffers)
+		buffer.resize(CHUNK_SECTORS * sector_size);
+
 	callback->SetFormattedStatusText("Computing hash for track %u...", track.number);
 	callback->SetProgressRange(track.sectors);
 
 	MD5Digest md5;
-	for (u32 i = 0; i < track.sectors; i++)
+	std::future<void> pending_hash;
+	bool result = true;
+	for (u32 chunk_start = 0, chunk_index = 0; chunk_start < track.sectors; chunk_start += CHUNK_SECTORS, chunk_index ^= 1)
 	{
 		if (callback->IsCancelled())
-			return false;
+		{
+			result = false;
+			break;
+		}
 
-		const u32 lsn = track.start_lsn + i;
-		if (DoCDVDreadSector(sector_buffer.data(), lsn, read_mode) != 0)
+		u8* const buffer = chunk_buffers[chunk_index].data();
+		const u32 chunk_sectors = std::min(CHUNK_SECTORS, track.sectors - chunk_start);
+		for (u32 i = 0; i < chunk_sectors; i++)
 		{
-			callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
-			return false;
+			const u32 lsn = track.start_lsn + chunk_start + i;
+			if (DoCDVDreadSector(buffer + i * sector_size, lsn, read_mode) != 0)
+			{
+				callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
+				result = false;
+				break;
+			}
 		}
+		if (!result)
+			break;
+
+		// The other buffer is free again once its hash completes.
+		if (pending_hash.valid())
+			pending_hash.get();
 
-		md5.Update(sector_buffer.data(), sector_size);
+		pending_hash = std::async(std::launch::async, [&md5, buffer, size = chunk_sectors * sector_size]() {
+			md5.Update(buffer, size);
+		});
 
-		if ((i % update_interval) == 0)
-			callback->SetProgressValue(i);
+		callback->SetProgressValue(chunk_start);
 	}
 
+	if (pending_hash.valid())
+		pending_hash.get();
+
+	if (!result)
+		return false;
+
 	u8 digest[16];
 	md5.Final(digest);
 	track.hash =
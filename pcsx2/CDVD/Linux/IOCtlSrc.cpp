@@ -54,8 +54,17 @@ bool IOCtlSrc::Reopen(Error* error)
 
 void IOCtlSrc::SetSpindleSpeed(bool restore_defaults) const
 {
-	// TODO: CD seems easy enough (CDROM_SELECT_SPEED ioctl), but I'm not sure
-	// about DVD.
+	// CDROM_SELECT_SPEED takes a multiple of 150KB/s, zero picks the drive's own maximum. The PS2 can do 24x
+	// CD-ROM, and a fixed speed stops the drive from slowing down (and back up) between bursts of streaming.
+	// TODO: DVDs need a SET STREAMING command through SG_IO instead.
+	if (m_media_type >= 0)
+		return;
+
+	const int speed = restore_defaults ? 0 : 24;
+	if (ioctl(m_device, CDROM_SELECT_SPEED, speed) == -1)
+		DevCon.Warning("CDVD: Failed to set spindle speed: %s", strerror(errno));
+	else if (!restore_defaults)
+		DevCon.WriteLn("CDVD: Spindle speed set to %dx", speed);
 }
 
 u32 IOCtlSrc::GetSectorCount() const
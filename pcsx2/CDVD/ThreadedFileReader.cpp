@@ -4,6 +4,7 @@
 #include "ThreadedFileReader.h"
 #include "Host.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
 #include "common/HostSys.h"
 #include "common/Path.h"
@@ -11,12 +12,25 @@
 #include "common/SmallString.h"
 #include "common/Threading.h"
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 // Make sure buffer size is bigger than the cutoff where PCSX2 emulates a seek
 // If buffers are smaller than that, we can't keep up with linear reads
 static constexpr u32 MINIMUM_SIZE = 128 * 1024;
 
+static std::atomic<u64> s_precache_memory_usage{0};
+
+// Upper bound on the number of chunks decoded in one go, so new requests don't wait too long for readahead to notice them.
+static constexpr u32 MAX_BATCH_CHUNKS = 32;
+
+// Size of the cache for predicted reads when the image isn't being precached.
+static constexpr u64 PREFETCH_CACHE_SIZE = 128 * _1mb;
+
+// Number of predicted extents which can be waiting to be prefetched.
+static constexpr size_t MAX_PREFETCH_RANGES = 64;
+
 ThreadedFileReader::ThreadedFileReader()
 {
 	m_readThread = std::thread([](ThreadedFileReader* r){ r->Loop(); }, this);
@@ -28,6 +42,7 @@ ThreadedFileReader::~ThreadedFileReader()
 	(void)std::lock_guard<std::mutex>{m_mtx};
 	m_condition.notify_one();
 	m_readThread.join();
+	SetPrecacheMemoryUsage(0);
 	for (auto& buffer : m_buffer)
 		if (buffer.ptr)
 			free(buffer.ptr);
@@ -61,12 +76,31 @@ void ThreadedFileReader::Loop()
 
 	while (true)
 	{
-		while (!m_requestSize && !m_quit)
+		while (!m_requestSize && !m_quit && !m_warmup_active)
 			m_condition.wait(lock);
 
 		if (m_quit)
 			return;
 
+		if (!m_requestSize)
+		{
+			// Nothing to read, so fill in the background cache one chunk at a time, checking for requests in between.
+			// Chunks the game is predicted to read soon go first.
+			m_running = true;
+			bool more = PrefetchNextChunk(lock);
+			if (!more && !m_cache_recycle)
+			{
+				lock.unlock();
+				more = WarmupNextChunk();
+				lock.lock();
+			}
+			if (!more && m_prefetch_queue.empty())
+				m_warmup_active = false;
+			m_running = false;
+			m_condition.notify_one();
+			continue;
+		}
+
 		u64 requestOffset;
 		u32 requestSize;
 
@@ -120,7 +154,8 @@ void ThreadedFileReader::Loop()
 					}
 					else
 					{
-						int amt = ReadChunk(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID);
+						const u32 count = std::min((buf->cap - bufsize) / chunk.length, MAX_BATCH_CHUNKS);
+						int amt = ReadChunksCached(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID, count);
 						if (amt <= 0)
 							break;
 						buf->size.store(bufsize + amt, std::memory_order_release);
@@ -141,6 +176,231 @@ void ThreadedFileReader::Loop()
 	}
 }
 
+int ThreadedFileReader::ReadChunkCached(void* dst, s64 chunkID)
+{
+	if (!m_cache_slots || chunkID < 0 || static_cast<u64>(chunkID) >= m_cache_num_chunks)
+		return ReadChunk(dst, chunkID);
+
+	const u32 slot = m_cache_slots[chunkID].load(std::memory_order_acquire);
+	if (slot != INVALID_CACHE_SLOT)
+	{
+		const u32 length = m_cache_slot_lengths[slot];
+		std::memcpy(dst, &m_cache_data[static_cast<size_t>(slot) * m_cache_chunk_size], length);
+		return static_cast<int>(length);
+	}
+
+	const int amt = ReadChunk(dst, chunkID);
+
+	// Keep what the game actually reads, so seeking back to it is as fast as if it had been precached.
+	// A recycled cache is left for prefetching, the read buffers already cover what was just read.
+	if (amt > 0 && static_cast<u32>(amt) <= m_cache_chunk_size && m_cache_used < m_cache_capacity && !m_cache_recycle)
+	{
+		const u32 new_slot = m_cache_used++;
+		std::memcpy(&m_cache_data[static_cast<size_t>(new_slot) * m_cache_chunk_size], dst, amt);
+		m_cache_slot_lengths[new_slot] = static_cast<u32>(amt);
+		m_cache_slots[chunkID].store(new_slot, std::memory_order_release);
+
+		// Warm up whatever follows, since that's most likely to be read next.
+		m_warmup_chunk = static_cast<u64>(chunkID) + 1;
+	}
+
+	return amt;
+}
+
+int ThreadedFileReader::ReadChunks(void* dst, s64 chunkID, u32 count)
+{
+	// Chunks are a fixed size in all formats, so consecutive IDs are contiguous.
+	const u32 chunk_length = ChunkForOffset(0).length;
+	int total = 0;
+	for (u32 i = 0; i < count; i++)
+	{
+		const s64 id = chunkID + i;
+		if (i > 0 && ChunkForOffset(static_cast<u64>(id) * chunk_length).chunkID != id)
+			break;
+
+		const int amt = ReadChunk(static_cast<u8*>(dst) + total, id);
+		if (amt <= 0)
+			return (total > 0) ? total : amt;
+
+		total += amt;
+		if (static_cast<u32>(amt) < chunk_length)
+			break;
+	}
+
+	return total;
+}
+
+int ThreadedFileReader::ReadChunksCached(void* dst, s64 chunkID, u32 count)
+{
+	if (count == 1)
+		return ReadChunkCached(dst, chunkID);
+
+	// Batches would bypass the cache, so go one at a time while it's active.
+	if (!m_cache_slots)
+		return ReadChunks(dst, chunkID, count);
+
+	int total = 0;
+	for (u32 i = 0; i < count && static_cast<u64>(chunkID + i) < m_cache_num_chunks; i++)
+	{
+		const int amt = ReadChunkCached(static_cast<u8*>(dst) + total, chunkID + i);
+		if (amt <= 0)
+			return (total > 0) ? total : amt;
+
+		total += amt;
+		if (static_cast<u32>(amt) < m_cache_chunk_size)
+			break;
+	}
+
+	return total;
+}
+
+bool ThreadedFileReader::WarmupNextChunk()
+{
+	if (m_cache_used >= m_cache_capacity)
+	{
+		Console.WriteLn("CDVD: Background precache finished, %u of %llu chunks cached.", m_cache_used,
+			static_cast<unsigned long long>(m_cache_num_chunks));
+		return false;
+	}
+
+	// Skip over anything the game already read. Limit the scan so a request is never kept waiting long.
+	static constexpr u32 MAX_SCAN = 4096;
+	u64 chunkID = m_warmup_chunk;
+	for (u32 i = 0; i < MAX_SCAN; i++, chunkID++)
+	{
+		if (chunkID >= m_cache_num_chunks)
+			chunkID = 0;
+
+		if (m_cache_slots[chunkID].load(std::memory_order_relaxed) != INVALID_CACHE_SLOT)
+			continue;
+
+		const Chunk chunk = ChunkForOffset(chunkID * m_cache_chunk_size);
+		const u32 slot = m_cache_used;
+		const int amt = (chunk.chunkID == static_cast<s64>(chunkID)) ?
+							ReadChunk(&m_cache_data[static_cast<size_t>(slot) * m_cache_chunk_size], chunk.chunkID) :
+							-1;
+		if (amt <= 0)
+		{
+			Console.Warning("CDVD: Background precache stopped, failed to read chunk %llu.", static_cast<unsigned long long>(chunkID));
+			return false;
+		}
+
+		m_cache_used++;
+		m_cache_slot_lengths[slot] = static_cast<u32>(amt);
+		m_cache_slots[chunkID].store(slot, std::memory_order_release);
+		m_warmup_chunk = chunkID + 1;
+		return true;
+	}
+
+	m_warmup_chunk = chunkID;
+	return true;
+}
+
+bool ThreadedFileReader::PrefetchNextChunk(std::unique_lock<std::mutex>& lock)
+{
+	// Skip over anything which was cached since it was queued.
+	u64 chunkID;
+	for (;;)
+	{
+		if (m_prefetch_queue.empty())
+			return false;
+
+		std::pair<u64, u64>& range = m_prefetch_queue.front();
+		chunkID = range.first++;
+		if (range.first >= range.second)
+			m_prefetch_queue.pop_front();
+
+		if (m_cache_slots[chunkID].load(std::memory_order_relaxed) == INVALID_CACHE_SLOT)
+			break;
+	}
+
+	const bool full = (m_cache_used >= m_cache_capacity);
+	if (full && !m_cache_recycle)
+	{
+		m_prefetch_queue.clear();
+		return false;
+	}
+
+	const u32 slot = full ? m_cache_next_recycled : m_cache_used;
+	if (full)
+	{
+		// TryCachedRead() copies out of the cache with the lock held, so nobody can still be reading the slot after this.
+		const u64 old_chunk = m_cache_slot_chunks[slot];
+		if (m_cache_slots[old_chunk].load(std::memory_order_relaxed) == slot)
+			m_cache_slots[old_chunk].store(INVALID_CACHE_SLOT, std::memory_order_relaxed);
+	}
+
+	lock.unlock();
+	const Chunk chunk = ChunkForOffset(chunkID * m_cache_chunk_size);
+	const int amt = (chunk.chunkID == static_cast<s64>(chunkID)) ?
+						ReadChunk(&m_cache_data[static_cast<size_t>(slot) * m_cache_chunk_size], chunk.chunkID) :
+						-1;
+	lock.lock();
+
+	if (amt <= 0 || static_cast<u32>(amt) > m_cache_chunk_size)
+	{
+		Console.Warning("CDVD: Failed to prefetch chunk %llu.", static_cast<unsigned long long>(chunkID));
+		return !m_prefetch_queue.empty();
+	}
+
+	if (full)
+		m_cache_next_recycled = (m_cache_next_recycled + 1) % m_cache_capacity;
+	else
+		m_cache_used++;
+
+	if (m_cache_slot_chunks)
+		m_cache_slot_chunks[slot] = chunkID;
+	m_cache_slot_lengths[slot] = static_cast<u32>(amt);
+	m_cache_slots[chunkID].store(slot, std::memory_order_release);
+	return true;
+}
+
+void ThreadedFileReader::AllocateBackgroundCache(u64 num_chunks, u64 capacity, u32 chunk_size, bool recycle)
+{
+	m_cache_data = std::make_unique_for_overwrite<u8[]>(static_cast<size_t>(capacity * chunk_size));
+	m_cache_slots = std::make_unique<std::atomic<u32>[]>(num_chunks);
+	for (u64 i = 0; i < num_chunks; i++)
+		m_cache_slots[i].store(INVALID_CACHE_SLOT, std::memory_order_relaxed);
+	m_cache_slot_lengths = std::make_unique_for_overwrite<u32[]>(capacity);
+	if (recycle)
+		m_cache_slot_chunks = std::make_unique_for_overwrite<u64[]>(capacity);
+	m_cache_num_chunks = num_chunks;
+	m_cache_chunk_size = chunk_size;
+	m_cache_capacity = static_cast<u32>(capacity);
+	m_cache_recycle = recycle;
+	SetPrecacheMemoryUsage(capacity * (chunk_size + sizeof(u32) + (recycle ? sizeof(u64) : 0)) +
+		num_chunks * sizeof(std::atomic<u32>));
+}
+
+void ThreadedFileReader::FreeBackgroundCache()
+{
+	m_warmup_active = false;
+	m_cache_data.reset();
+	m_cache_slots.reset();
+	m_cache_slot_lengths.reset();
+	m_cache_slot_chunks.reset();
+	m_prefetch_queue.clear();
+	m_cache_num_chunks = 0;
+	m_cache_chunk_size = 0;
+	m_cache_capacity = 0;
+	m_cache_used = 0;
+	m_cache_recycle = false;
+	m_cache_next_recycled = 0;
+	m_warmup_chunk = 0;
+	SetPrecacheMemoryUsage(0);
+}
+
+void ThreadedFileReader::SetPrecacheMemoryUsage(u64 bytes)
+{
+	s_precache_memory_usage.fetch_add(bytes - m_precache_memory_usage, std::memory_order_relaxed);
+	m_precache_memory_usage = bytes;
+}
+
+u64 ThreadedFileReader::GetPrecacheMemoryUsage()
+{
+	return s_precache_memory_usage.load(std::memory_order_relaxed);
+}
+
 ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 {
 	for (int i = 0; i < static_cast<int>(std::size(m_buffer)); i++)
@@ -170,7 +430,7 @@ ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 		}
 		buf.size.store(0, std::memory_order_relaxed);
 	}
-	int size = ReadChunk(buf.ptr, block.chunkID);
+	int size = ReadChunkCached(buf.ptr, block.chunkID);
 	if (size > 0)
 	{
 		buf.offset = block.offset;
@@ -208,12 +468,14 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 		}
 		else
 		{
-			int amt = ReadChunk(write, chunk.chunkID);
-			if (amt < static_cast<int>(chunk.length))
+			const u32 count = std::min(remaining / chunk.length, MAX_BATCH_CHUNKS);
+			const u32 length = count * chunk.length;
+			int amt = ReadChunksCached(write, chunk.chunkID, count);
+			if (amt < static_cast<int>(length))
 				return false;
-			write += chunk.length;
-			remaining -= chunk.length;
-			off += chunk.length;
+			write += length;
+			remaining -= length;
+			off += length;
 		}
 	}
 	m_amtRead += write - static_cast<char*>(target);
@@ -248,6 +510,33 @@ bool ThreadedFileReader::TryCachedRead(void*& buffer, u64& offset, u32& size, co
 		if (end > 0 && buf.offset == end)
 			allDone = true;
 	}
+
+	// Anything the background precache has already decompressed can be copied out without waking the thread.
+	while (size > 0 && m_cache_slots)
+	{
+		const Chunk chunk = ChunkForOffset(offset);
+		if (chunk.chunkID < 0 || static_cast<u64>(chunk.chunkID) >= m_cache_num_chunks)
+			break;
+
+		const u32 slot = m_cache_slots[chunk.chunkID].load(std::memory_order_acquire);
+		if (slot == INVALID_CACHE_SLOT)
+			break;
+
+		const u32 off = static_cast<u32>(offset - chunk.offset);
+		const u32 length = m_cache_slot_lengths[slot];
+		if (off >= length)
+			break;
+
+		const u32 cpysize = std::min(size, length - off);
+		const size_t read = CopyBlocks(buffer, &m_cache_data[static_cast<size_t>(slot) * m_cache_chunk_size + off], cpysize);
+		m_amtRead += read;
+		size -= cpysize;
+		offset += cpysize;
+		buffer = static_cast<char*>(buffer) + read;
+		if (size == 0)
+			allDone = true;
+	}
+
 	return allDone;
 }
 
@@ -264,33 +553,159 @@ bool ThreadedFileReader::Precache2(ProgressCallback* progress, Error* error)
 	return false;
 }
 
-bool ThreadedFileReader::CheckAvailableMemoryForPrecaching(u64 required_size, Error* error)
+// Reserve 2GB of available memory for headroom.
+static constexpr u64 PRECACHE_MEMORY_RESERVE = 2147483648;
+
+static u64 GetMaximumPrecacheSize()
 {
 	// We want to check available physical memory instead of total.
 	const u64 memory_available = GetAvailablePhysicalMemory();
-	// Reserve 2GB of available memory for headroom.
-	constexpr u64 memory_reserve = 2147483648;
-	const u64 max_precache_size = std::max(s64{0}, static_cast<s64>(memory_available - memory_reserve));
+	return std::max(s64{0}, static_cast<s64>(memory_available - PRECACHE_MEMORY_RESERVE));
+}
 
-	if (required_size > max_precache_size)
+bool ThreadedFileReader::CheckAvailableMemoryForPrecaching(u64 required_size, Error* error)
+{
+	if (required_size > GetMaximumPrecacheSize())
 	{
 		Error::SetStringFmt(error,
 			TRANSLATE_FS("CDVD", "Not enough memory available for precaching ({:.2f} GB required)."),
-			static_cast<double>(required_size + memory_reserve) / static_cast<double>(_1gb));
+			static_cast<double>(required_size + PRECACHE_MEMORY_RESERVE) / static_cast<double>(_1gb));
+		return false;
+	}
+
+	return true;
+}
+
+bool ThreadedFileReader::StartBackgroundPrecache(Error* error)
+{
+	CancelAndWaitUntilStopped();
+
+	std::unique_lock<std::mutex> lock(m_mtx);
+	FreeBackgroundCache();
+
+	const u64 image_size = static_cast<u64>(GetBlockCount()) * InternalBlockSize() + m_dataoffset;
+
+	// Uncompressed images are read straight out of the page cache, so just ask the OS to fill it.
+	if (!m_internalBlockSize && GetDirectPointer(0, m_blocksize))
+	{
+		PrefetchDirect(0, image_size);
+		return true;
+	}
+
+	const Chunk first = ChunkForOffset(0);
+	const Chunk last = ChunkForOffset(image_size - 1);
+	if (first.chunkID != 0 || last.chunkID < 0 || first.length == 0)
+	{
+		Error::SetStringView(error, TRANSLATE_SV("CDVD", "Precaching is not supported for this file format."));
+		return false;
+	}
+
+	// Cache as much as fits if the whole image doesn't.
+	const u64 num_chunks = static_cast<u64>(last.chunkID) + 1;
+	const u64 max_chunks = GetMaximumPrecacheSize() / first.length;
+	const u64 capacity = std::min<u64>({num_chunks, max_chunks, std::numeric_limits<u32>::max() - 1});
+	if (capacity == 0)
+	{
+		Error::SetStringFmt(error, TRANSLATE_FS("CDVD", "Not enough memory available for precaching ({:.2f} GB required)."),
+			static_cast<double>(num_chunks * first.length + PRECACHE_MEMORY_RESERVE) / static_cast<double>(_1gb));
+		return false;
+	}
+
+	AllocateBackgroundCache(num_chunks, capacity, first.length, false);
+	m_warmup_active = true;
+
+	Console.WriteLn("CDVD: Precaching %llu of %llu MB in the background.",
+		static_cast<unsigned long long>((capacity * first.length) / _1mb), static_cast<unsigned long long>((num_chunks * first.length) / _1mb));
+
+	lock.unlock();
+	m_condition.notify_one();
+	return true;
+}
+
+bool ThreadedFileReader::EnablePrefetch(Error* error)
+{
+	// Uncompressed images are prefetched straight into the page cache.
+	if (!m_internalBlockSize && GetDirectPointer(0, m_blocksize))
+		return true;
+
+	CancelAndWaitUntilStopped();
+
+	std::unique_lock<std::mutex> lock(m_mtx);
+	if (m_cache_slots)
+		return true;
+
+	const u64 image_size = static_cast<u64>(GetBlockCount()) * InternalBlockSize() + m_dataoffset;
+	const Chunk first = ChunkForOffset(0);
+	const Chunk last = ChunkForOffset(image_size - 1);
+	if (first.chunkID != 0 || last.chunkID < 0 || first.length == 0)
+	{
+		Error::SetStringView(error, TRANSLATE_SV("CDVD", "Prefetching is not supported for this file format."));
 		return false;
 	}
 
+	const u64 num_chunks = static_cast<u64>(last.chunkID) + 1;
+	const u64 capacity = std::clamp<u64>(PREFETCH_CACHE_SIZE / first.length, 1, num_chunks);
+	AllocateBackgroundCache(num_chunks, capacity, first.length, true);
+
+	DevCon.WriteLn("CDVD: Prefetching predicted reads into a %llu MB cache.",
+		static_cast<unsigned long long>((capacity * first.length) / _1mb));
 	return true;
 }
 
+void ThreadedFileReader::PrefetchSectors(u32 sector, u32 count)
+{
+	// Direct reads already ask the OS to prefetch what they point to.
+	if (GetDirectRead(sector, count))
+		return;
+
+	const u64 offset = static_cast<u64>(sector) * InternalBlockSize() + m_dataoffset;
+	const u64 size = static_cast<u64>(count) * InternalBlockSize();
+	{
+		std::lock_guard<std::mutex> lock(m_mtx);
+		if (!m_cache_slots || (!m_cache_recycle && m_cache_used >= m_cache_capacity))
+			return;
+
+		const Chunk first = ChunkForOffset(offset);
+		const Chunk last = ChunkForOffset(offset + size - 1);
+		if (first.chunkID < 0 || last.chunkID < first.chunkID || static_cast<u64>(first.chunkID) >= m_cache_num_chunks)
+			return;
+
+		// Older predictions are less likely to still be useful, don't let them pile up behind the new ones.
+		if (m_prefetch_queue.size() >= MAX_PREFETCH_RANGES)
+			m_prefetch_queue.pop_front();
+
+		m_prefetch_queue.emplace_back(first.chunkID, std::min(static_cast<u64>(last.chunkID) + 1, m_cache_num_chunks));
+		m_warmup_active = true;
+	}
+	m_condition.notify_one();
+}
+
 bool ThreadedFileReader::Open(std::string filename, Error* error)
 {
 	CancelAndWaitUntilStopped();
 	return Open2(std::move(filename), error);
 }
 
+const u8* ThreadedFileReader::GetDirectRead(u32 sector, u32 count)
+{
+	// Direct reads can't strip internal blocks down to external ones.
+	if (m_internalBlockSize)
+		return nullptr;
+
+	const u64 offset = static_cast<u64>(sector) * static_cast<u64>(m_blocksize) + m_dataoffset;
+	const u32 size = count * m_blocksize;
+	const u8* ptr = GetDirectPointer(offset, size);
+	if (ptr)
+		PrefetchDirect(offset, size);
+
+	return ptr;
+}
+
 int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
 {
+	if (const u8* direct = GetDirectRead(sector, count))
+		return static_cast<int>(CopyBlocks(pBuffer, direct, count * m_blocksize));
+
 	u32 blocksize = InternalBlockSize();
 	u64 offset = (u64)sector * (u64)blocksize + m_dataoffset;
 	u32 size = count * blocksize;
@@ -339,6 +754,9 @@ void ThreadedFileReader::CancelAndWaitUntilStopped(void)
 	// m_requestCancelled just stops the current decompress.
 	m_requestSize = 0;
 
+	// Background precaching only decompresses one chunk at a time, so it'll stop soon enough.
+	m_warmup_active = false;
+
 	while (m_running)
 		m_condition.wait(lock);
 }
@@ -395,6 +813,7 @@ void ThreadedFileReader::Close(void)
 	CancelAndWaitUntilStopped();
 	for (auto& buf : m_buffer)
 		buf.size.store(0, std::memory_order_relaxed);
+	FreeBackgroundCache();
 	Close2();
 }
 
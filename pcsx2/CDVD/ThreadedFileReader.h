@@ -9,6 +9,7 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 
 class Error;
 class ProgressCallback;
@@ -41,6 +42,9 @@ protected:
 	virtual Chunk ChunkForOffset(u64 offset) = 0;
 	/// Synchronously read the given block into `dst`
 	virtual int ReadChunk(void* dst, s64 chunkID) = 0;
+	/// Synchronously read `count` consecutive blocks into `dst`, stopping early at a short or failed block
+	/// Override to decode batches more efficiently than one ReadChunk at a time
+	virtual int ReadChunks(void* dst, s64 chunkID, u32 count);
 	/// AsyncFileReader open but ThreadedFileReader needs prep work first
 	virtual bool Open2(std::string filename, Error* error) = 0;
 	/// AsyncFileReader precache but ThreadedFileReader needs prep work first
@@ -49,6 +53,12 @@ protected:
 	virtual void Close2() = 0;
 	/// Checks system memory, to ensure that precaching would not exceed a reasonable amount.
 	bool CheckAvailableMemoryForPrecaching(u64 required_size, Error* error);
+	/// Get a pointer to `size` bytes at `offset` if they can be read in place (e.g. from a memory mapping), otherwise null
+	virtual const u8* GetDirectPointer(u64 offset, u32 size) { return nullptr; }
+	/// Hint that the given range is about to be read through GetDirectPointer()
+	virtual void PrefetchDirect(u64 offset, u64 size) {}
+	/// Updates this reader's contribution to GetPrecacheMemoryUsage()
+	void SetPrecacheMemoryUsage(u64 bytes);
 
 	ThreadedFileReader();
 
@@ -85,6 +95,31 @@ private:
 	/// View while holding `m_mtx`.  If false, you may touch decompression functions from other threads
 	bool m_running = false;
 
+	static constexpr u32 INVALID_CACHE_SLOT = 0xFFFFFFFFu;
+	/// Decompressed chunks filled by background precaching, `m_cache_slots` maps chunk IDs to slots
+	/// Slots are published with release ordering and never reused, so they can be read from `TryCachedRead` while the thread is decompressing
+	std::unique_ptr<u8[]> m_cache_data;
+	std::unique_ptr<std::atomic<u32>[]> m_cache_slots;
+	std::unique_ptr<u32[]> m_cache_slot_lengths;
+	u64 m_cache_num_chunks = 0;
+	u32 m_cache_chunk_size = 0;
+	u32 m_cache_capacity = 0;
+	u32 m_cache_used = 0;
+	/// True if the cache only holds prefetched chunks, in which case the oldest slot is recycled once it's full
+	/// `m_cache_slot_chunks` maps slots back to chunk IDs so they can be unpublished first
+	bool m_cache_recycle = false;
+	u32 m_cache_next_recycled = 0;
+	std::unique_ptr<u64[]> m_cache_slot_chunks;
+	/// Ranges of chunk IDs queued by PrefetchSectors(), decompressed before any other warmup
+	/// View while holding `m_mtx`
+	std::deque<std::pair<u64, u64>> m_prefetch_queue;
+	/// Next chunk for the read thread to warm up when it has nothing else to do
+	/// View while holding `m_mtx`
+	bool m_warmup_active = false;
+	u64 m_warmup_chunk = 0;
+	/// Bytes this reader holds in precache buffers, included in GetPrecacheMemoryUsage()
+	u64 m_precache_memory_usage = 0;
+
 	/// Get the internal block size
 	u32 InternalBlockSize() const { return m_internalBlockSize ? m_internalBlockSize : m_blocksize; }
 	/// memcpy from internal to external blocks
@@ -95,6 +130,21 @@ private:
 	/// Main loop of read thread
 	void Loop();
 
+	/// ReadChunk, but served from and inserted into the background precache
+	int ReadChunkCached(void* dst, s64 chunkID);
+	/// ReadChunks, but served from and inserted into the background precache
+	int ReadChunksCached(void* dst, s64 chunkID, u32 count);
+	/// Decompress a single chunk that isn't cached yet into the background precache
+	/// Returns false once there's nothing left to warm up
+	bool WarmupNextChunk();
+	/// Decompress the next chunk queued by PrefetchSectors() into the background precache
+	/// Called with `lock` held, which is released while decompressing. Returns false once the queue is empty
+	bool PrefetchNextChunk(std::unique_lock<std::mutex>& lock);
+	/// Sets up the background precache with room for `capacity` of the image's `num_chunks` chunks
+	void AllocateBackgroundCache(u64 num_chunks, u64 capacity, u32 chunk_size, bool recycle);
+	/// Releases the background precache, must not be called while the thread is running
+	void FreeBackgroundCache();
+
 	/// Load the given block into one of the `m_buffer` buffers if necessary and return a pointer to its contents if successful
 	Buffer* GetBlockPtr(const Chunk& block);
 	/// Decompress from offset to size into
@@ -114,9 +164,21 @@ public:
 
 	virtual u32 GetBlockCount() const = 0;
 
+	/// Memory held in precache buffers by all open readers. Safe to call from any thread.
+	static u64 GetPrecacheMemoryUsage();
 
 	bool Open(std::string filename, Error* error);
 	bool Precache(ProgressCallback* progress, Error* error);
+	/// Fill a cache of decompressed chunks on the read thread whenever it's idle, instead of blocking until the whole image is loaded
+	/// The cache is limited to available memory, and actual reads are always serviced first
+	bool StartBackgroundPrecache(Error* error);
+	/// Set up a small cache for PrefetchSectors(), unless background precaching already provides one
+	bool EnablePrefetch(Error* error);
+	/// Queue sectors which are likely to be read soon, to be decompressed whenever the read thread is idle
+	void PrefetchSectors(u32 sector, u32 count);
+	/// Get a pointer to the given sectors if they can be read without copying or waking the read thread
+	/// The pointer remains valid until the reader is closed or precached
+	const u8* GetDirectRead(u32 sector, u32 count);
 	int ReadSync(void* pBuffer, u32 sector, u32 count);
 	void BeginRead(void* pBuffer, u32 sector, u32 count);
 	int FinishRead();
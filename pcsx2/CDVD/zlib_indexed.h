@@ -49,6 +49,7 @@ Comments) 1950 to 1952 in the files http://tools.ietf.org/html/rfc1950
       (Thanks to Mark Adler for suggesting the approach)
   - build_index(...) - added progress prints
   - CHUNK changed from 16k to 512k
+  - build_index(...) split into build_index_points(...), so the index can be built in the background
  */
 
 /* Illustrate the use of Z_BLOCK, inflatePrime(), and inflateSetDictionary()
@@ -102,6 +103,8 @@ Comments) 1950 to 1952 in the files http://tools.ietf.org/html/rfc1950
 #include <string.h>
 #include <zlib.h>
 
+#include <atomic>
+
 #include "common/FileSystem.h"
 
 //#define SPAN (1048576L)  /* desired distance between access points */
@@ -209,20 +212,15 @@ static inline struct access* addpoint(struct access* index, int bits,
 	return index;
 }
 
-/* Make one entire pass through the compressed stream and build an index, with
-   access points about every span bytes of uncompressed output -- span is
-   chosen to balance the speed of random access against the memory requirements
-   of the list, about 32K bytes per access point.  Note that data after the end
-   of the first zlib or gzip stream in the file is ignored.  build_index()
-   returns the number of access points on success (>= 1), Z_MEM_ERROR for out
-   of memory, Z_DATA_ERROR for an error in the input file, or Z_ERRNO for a
-   file read error.  On success, *built points to the resulting index. */
-static inline int build_index(FILE* in, s64 span, struct access** built)
+/* PCSX2: the decoding loop of build_index(), with the access points handed to add_point(bits, in, out, left,
+   window) instead of being collected. add_point returns 0 to fail with Z_MEM_ERROR. The loop stops with
+   Z_ERRNO if *cancel is set. On success, returns Z_OK and stores the uncompressed size in *total. */
+template <typename F>
+static inline int build_index_points(FILE* in, s64 span, const std::atomic_bool* cancel, s64* total, F&& add_point)
 {
 	int ret;
 	s64 totin, totout, totPrinted; /* our own total counters to avoid 4GB limit */
 	s64 last;                      /* totout value of last access point */
-	struct access* index;               /* access points being generated */
 	z_stream strm;
 	unsigned char input[CHUNK];
 	unsigned char window[WINSIZE];
@@ -241,10 +239,15 @@ static inline int build_index(FILE* in, s64 span, struct access** built)
        also validates the integrity of the compressed data using the check
        information at the end of the gzip or zlib stream */
 	totin = totout = last = totPrinted = 0;
-	index = NULL; /* will be allocated by first addpoint() */
 	strm.avail_out = 0;
 	do
 	{
+		if (cancel && cancel->load(std::memory_order_relaxed))
+		{
+			ret = Z_ERRNO;
+			goto build_index_error;
+		}
+
 		/* get some compressed data from input file */
 		strm.avail_in = fread(input, 1, CHUNK, in);
 		if (ferror(in))
@@ -295,9 +298,7 @@ static inline int build_index(FILE* in, s64 span, struct access** built)
 			if ((strm.data_type & 128) && !(strm.data_type & 64) &&
 				(totout == 0 || totout - last > span))
 			{
-				index = addpoint(index, strm.data_type & 7, totin,
-								 totout, strm.avail_out, window);
-				if (index == NULL)
+				if (!add_point(strm.data_type & 7, totin, totout, strm.avail_out, window))
 				{
 					ret = Z_MEM_ERROR;
 					goto build_index_error;
@@ -312,6 +313,40 @@ static inline int build_index(FILE* in, s64 span, struct access** built)
 		}
 	} while (ret != Z_STREAM_END);
 
+	(void)inflateEnd(&strm);
+	*total = totout;
+	return Z_OK;
+
+	/* return error */
+build_index_error:
+	(void)inflateEnd(&strm);
+	return ret;
+}
+
+/* Make one entire pass through the compressed stream and build an index, with
+   access points about every span bytes of uncompressed output -- span is
+   chosen to balance the speed of random access against the memory requirements
+   of the list, about 32K bytes per access point.  Note that data after the end
+   of the first zlib or gzip stream in the file is ignored.  build_index()
+   returns the number of access points on success (>= 1), Z_MEM_ERROR for out
+   of memory, Z_DATA_ERROR for an error in the input file, or Z_ERRNO for a
+   file read error.  On success, *built points to the resulting index. */
+static inline int build_index(FILE* in, s64 span, struct access** built)
+{
+	struct access* index = NULL; /* will be allocated by first addpoint() */
+	s64 totout = 0;
+	const int ret = build_index_points(in, span, NULL, &totout,
+		[&index](int bits, s64 in_pos, s64 out_pos, unsigned left, unsigned char* window) {
+			index = addpoint(index, bits, in_pos, out_pos, left, window);
+			return index != NULL;
+		});
+	if (ret != Z_OK)
+	{
+		if (index != NULL)
+			free_index(index);
+		return ret;
+	}
+
 	if (index == NULL)
 	{
 		// Could happen if the start of the stream in Z_STREAM_END
@@ -319,20 +354,12 @@ static inline int build_index(FILE* in, s64 span, struct access** built)
 	}
 
 	/* clean up and return index (release unused entries in list) */
-	(void)inflateEnd(&strm);
 	index->list = (Point*)realloc(index->list, sizeof(struct point) * index->have);
 	index->size = index->have;
 	index->span = span;
 	index->uncompressed_size = totout;
 	*built = index;
 	return index->have;
-
-	/* return error */
-build_index_error:
-	(void)inflateEnd(&strm);
-	if (index != NULL)
-		free_index(index);
-	return ret;
 }
 
 typedef struct zstate
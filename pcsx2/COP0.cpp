@@ -351,29 +351,81 @@ void UnmapTLB(const tlbs& t, int i)
 	}
 }
 
-void WriteTLB(int i)
+// TLB writes since the last LogTLBWriteStats(), and how many of them actually changed the mapping.
+static u64 s_tlb_writes = 0;
+static u64 s_tlb_remaps = 0;
+
+// Builds the entry a TLBWI/TLBWR would write from the current CP0 registers.
+static tlbs ReadTLBEntryFromCP0()
 {
-	tlb[i].PageMask.UL = cpuRegs.CP0.n.PageMask;
-	tlb[i].EntryHi.UL = cpuRegs.CP0.n.EntryHi;
-	tlb[i].EntryLo0.UL = cpuRegs.CP0.n.EntryLo0;
-	tlb[i].EntryLo1.UL = cpuRegs.CP0.n.EntryLo1;
+	tlbs t;
+	t.PageMask.UL = cpuRegs.CP0.n.PageMask;
+	t.EntryHi.UL = cpuRegs.CP0.n.EntryHi;
+	t.EntryLo0.UL = cpuRegs.CP0.n.EntryLo0;
+	t.EntryLo1.UL = cpuRegs.CP0.n.EntryLo1;
 
 	// Setting the cache mode to reserved values is vaguely defined in the manual.
 	// I found that SPR is set to cached regardless.
 	// Non-SPR entries default to uncached on reserved cache modes.
-	if (tlb[i].isSPR())
+	if (t.isSPR())
 	{
-		tlb[i].EntryLo0.C = 3;
-		tlb[i].EntryLo1.C = 3;
+		t.EntryLo0.C = 3;
+		t.EntryLo1.C = 3;
 	}
 	else
 	{
-		if (!tlb[i].EntryLo0.isValidCacheMode())
-			tlb[i].EntryLo0.C = 2;
-		if (!tlb[i].EntryLo1.isValidCacheMode())
-			tlb[i].EntryLo1.C = 2;
+		if (!t.EntryLo0.isValidCacheMode())
+			t.EntryLo0.C = 2;
+		if (!t.EntryLo1.isValidCacheMode())
+			t.EntryLo1.C = 2;
+	}
+
+	return t;
+}
+
+// The vtlb mapping and the cached TLB list only depend on the page mask, VPN2 and EntryLo registers,
+// so an entry which only differs in its ASID can be replaced without touching the page tables.
+static bool IsSameTLBMapping(const tlbs& a, const tlbs& b)
+{
+	return a.PageMask.UL == b.PageMask.UL &&
+		   (a.EntryHi.UL & ~0xFFu) == (b.EntryHi.UL & ~0xFFu) &&
+		   a.EntryLo0.UL == b.EntryLo0.UL &&
+		   a.EntryLo1.UL == b.EntryLo1.UL;
+}
+
+// Games and kernels tend to rewrite the same entries over and over (e.g. on every thread switch).
+// Unmapping and remapping those throws away every recompiled block in the affected pages, so skip it.
+static void WriteTLBFromCP0(int i)
+{
+	s_tlb_writes++;
+
+	const tlbs t = ReadTLBEntryFromCP0();
+	if (IsSameTLBMapping(tlb[i], t))
+	{
+		tlb[i] = t;
+		return;
 	}
 
+	s_tlb_remaps++;
+	UnmapTLB(tlb[i], i);
+	WriteTLB(i);
+}
+
+void LogTLBWriteStats()
+{
+	if (s_tlb_writes == 0)
+		return;
+
+	DevCon.WriteLnFmt("COP0: {} TLB writes, {} remapped ({:.1f}% skipped)",
+		s_tlb_writes, s_tlb_remaps, 100.0 * static_cast<double>(s_tlb_writes - s_tlb_remaps) / static_cast<double>(s_tlb_writes));
+	s_tlb_writes = 0;
+	s_tlb_remaps = 0;
+}
+
+void WriteTLB(int i)
+{
+	tlb[i] = ReadTLBEntryFromCP0();
+
 	if (!tlb[i].isSPR() && ((tlb[i].EntryLo0.V && tlb[i].EntryLo0.isCached()) || (tlb[i].EntryLo1.V && tlb[i].EntryLo1.isCached())))
 	{
 		const size_t idx = cachedTlbs.count;
@@ -432,8 +484,7 @@ namespace COP0 {
 			cpuRegs.CP0.n.Index, cpuRegs.CP0.n.PageMask, cpuRegs.CP0.n.EntryHi,
 			cpuRegs.CP0.n.EntryLo0, cpuRegs.CP0.n.EntryLo1);
 
-		UnmapTLB(tlb[j], j);
-		WriteTLB(j);
+		WriteTLBFromCP0(j);
 	}
 
 	void TLBWR()
@@ -450,8 +501,7 @@ namespace COP0 {
 			cpuRegs.CP0.n.Random, cpuRegs.CP0.n.PageMask, cpuRegs.CP0.n.EntryHi,
 			cpuRegs.CP0.n.EntryLo0, cpuRegs.CP0.n.EntryLo1);
 
-		UnmapTLB(tlb[j], j);
-		WriteTLB(j);
+		WriteTLBFromCP0(j);
 	}
 
 	void TLBP()
@@ -174,6 +174,10 @@ enum GamefixId
 	Fix_XGKick,
 	Fix_BlitInternalFPS,
 	Fix_FullVU0Sync,
+	Fix_MTVUStaleRead,
+	Fix_EECache,
+	Fix_FpuAccurate,
+	Fix_DMASlice,
 
 	GamefixId_COUNT
 };
@@ -187,9 +191,19 @@ enum class SpeedHack
 	InstantVU1,
 	MTVU,
 	EECycleRate,
+	TimingProfile,
 	MaxCount,
 };
 
+// Sets of EE timing speedhacks which are known to work well together.
+enum class EETimingProfile : u8
+{
+	Default, // Leave the individual options alone.
+	Accurate, // Nominal EE clock, no cycle skipping, VU1 runs in sync.
+	Throughput, // Mild underclock and cycle skip, for games limited by host CPU speed.
+	MaxCount
+};
+
 enum class DebugAnalysisCondition
 {
 	ALWAYS,
@@ -558,6 +572,7 @@ struct TraceLogsMISC
 struct TraceLogFilters
 {
 	bool Enabled;
+	bool Buffered;
 
 	TraceLogsEE EE;
 	TraceLogsIOP IOP;
@@ -636,6 +651,14 @@ struct Pcsx2Config
 			EnableEECache : 1;
 		bool
 			EnableFastmem : 1;
+		bool
+			EnableEEBlockCache : 1;
+		bool
+			EnableEEHotBlocks : 1;
+		bool
+			EnableVUProgramCache : 1;
+		bool
+			EnableVIFUnpackCache : 1;
 		bool
 			PauseOnTLBMiss : 1;
 		BITFIELD_END
@@ -728,14 +751,19 @@ struct Pcsx2Config
 					UseDebugDevice : 1,
 					UseBlitSwapChain : 1,
 					DisableShaderCache : 1,
+					ReadOnlyShaderCache : 1,
+					AsyncShaderCompilation : 1,
 					DisableFramebufferFetch : 1,
 					DisableVertexShaderExpand : 1,
 					SkipDuplicateFrames : 1,
+					ThrottleUncappedPresentation : 1,
+					DynamicResolution : 1,
 					OsdShowSpeed : 1,
 					OsdShowFPS : 1,
 					OsdShowVPS : 1,
 					OsdShowCPU : 1,
 					OsdShowGPU : 1,
+					OsdShowGPUBreakdown : 1,
 					OsdShowResolution : 1,
 					OsdShowGSStats : 1,
 					OsdShowIndicators : 1,
@@ -746,9 +774,11 @@ struct Pcsx2Config
 					OsdShowVideoCapture : 1,
 					OsdShowInputRec : 1,
 					OsdShowHardwareInfo : 1,
+					OsdShowMemoryUsage : 1,
 					HWSpinGPUForReadbacks : 1,
 					HWSpinCPUForReadbacks : 1,
 					GPUPaletteConversion : 1,
+					GPUTextureUnswizzle : 1,
 					AutoFlushSW : 1,
 					PreloadFrameWithGSData : 1,
 					Mipmap : 1,
@@ -852,6 +882,10 @@ struct Pcsx2Config
 		u16 SWExtraThreads = 2;
 		u16 SWExtraThreadsHeight = 4;
 
+		u16 HashCacheBudget = 0; // in MB, 0 = no budget
+		u16 VRAMBudget = 0; // in MB, 0 = no budget
+		u16 GSDumpReplayBuffer = 0; // in seconds, 0 = disabled
+
 		int SaveDrawStart = 0;
 		int SaveDrawCount = 5000;
 		int SaveDrawBy = 1;
@@ -944,6 +978,7 @@ struct Pcsx2Config
 		u32 OutputVolume = 100;
 		u32 FastForwardVolume = 100;
 		bool OutputMuted = false;
+		bool ThreadedOutput = false;
 
 		AudioBackend Backend = DEFAULT_BACKEND;
 		SPU2SyncMode SyncMode = DEFAULT_SYNC_MODE;
@@ -1050,7 +1085,11 @@ struct Pcsx2Config
 			VUOverflowHack : 1, // Tries to simulate overflow flag checks (not really possible on x86 without soft floats)
 			XgKickHack : 1, // Erementar Gerad, adds more delay to VU XGkick instructions. Corrects the color of some graphics, but breaks Tri-ace games and others.
 			BlitInternalFPSHack : 1, // Disables privileged register write-based FPS detection.
-			FullVU0SyncHack : 1; // Forces tight VU0 sync on every COP2 instruction.
+			FullVU0SyncHack : 1, // Forces tight VU0 sync on every COP2 instruction.
+			MTVUStaleReadHack : 1, // Lets EE reads of VU1 data memory and VIF1 row/col see MTVU's latest writes instead of waiting for it to finish.
+			EECacheHack : 1, // Emulates the EE data cache for games which depend on it, works with both the interpreter and the recompiler.
+			FpuAccurateHack : 1, // Single-precision FPU with sign-preserving clamps and overflow flags, between the clamp modes and full mode.
+			DMASliceHack : 1; // Always splits GIF/VIF1 DMA transfers into short slices, instead of running them in one go when nothing else can observe it.
 		BITFIELD_END
 
 		GamefixOptions();
@@ -1081,7 +1120,8 @@ struct Pcsx2Config
 			WaitLoop : 1, // enables constant loop detection and fast-forwarding
 			vuFlagHack : 1, // microVU specific flag hack
 			vuThread : 1, // Enable Threaded VU1
-			vu1Instant : 1; // Enable Instant VU1 (Without MTVU only)
+			vu1Instant : 1, // Enable Instant VU1 (Without MTVU only)
+			ipuThread : 1; // Runs the IPU decoder on its own thread
 		BITFIELD_END
 
 		s8 EECycleRate; // EE cycle rate selector (1.0, 1.5, 2.0)
@@ -1096,8 +1136,11 @@ struct Pcsx2Config
 		bool operator==(const SpeedhackOptions& right) const;
 		bool operator!=(const SpeedhackOptions& right) const;
 
+		void ApplyTimingProfile(EETimingProfile profile);
+
 		static const char* GetSpeedHackName(SpeedHack id);
 		static std::optional<SpeedHack> ParseSpeedHackName(const std::string_view name);
+		static const char* GetTimingProfileName(EETimingProfile profile);
 	};
 
 	// ------------------------------------------------------------------------
@@ -1137,6 +1180,8 @@ struct Pcsx2Config
 		BITFIELD32()
 		bool SyncToHostRefreshRate : 1;
 		bool UseVSyncForTiming : 1;
+		bool ReduceInputLatency : 1;
+		bool PowerSaving : 1;
 		BITFIELD_END
 
 		float NominalScalar{1.0f};
@@ -1285,6 +1330,12 @@ struct Pcsx2Config
 		SavestateCompressionMethod CompressionType = SavestateCompressionMethod::Zstandard;
 		SavestateCompressionLevel CompressionRatio = SavestateCompressionLevel::Medium;
 
+		bool EnableRewind = false;
+		u32 RewindFrequency = 10; // frames between rewind snapshots
+		u32 RewindBufferSize = 512; // memory budget for rewind snapshots, in megabytes
+
+		bool SaveTextureCacheTargets = false; // stores the hardware texture cache layout, so loads rebuild targets up front
+
 		bool operator==(const SavestateOptions& right) const;
 		bool operator!=(const SavestateOptions& right) const;
 	};
@@ -1296,14 +1347,19 @@ struct Pcsx2Config
 		CdvdVerboseReads : 1, // enables cdvd read activity verbosely dumped to the console
 		CdvdDumpBlocks : 1, // enables cdvd block dumping
 		CdvdPrecache : 1, // enables cdvd precaching of compressed images
+		CdvdBackgroundPrecache : 1, // precaches while the game runs instead of before it starts
+		CdvdReadPrediction : 1, // prefetches reads predicted from earlier sessions
 		EnablePatches : 1, // enables patch detection and application
 		EnableCheats : 1, // enables cheat detection and application
 		EnablePINE : 1, // enables inter-process communication
+		EnableSharedSnapshot : 1, // publishes the frame and memory ranges through shared memory
 		EnableWideScreenPatches : 1,
 		EnableNoInterlacingPatches : 1,
 		EnableFastBoot : 1,
 		EnableFastBootFastForward : 1,
+		EnableFastBootSnapshot : 1, // restores a cached post-BIOS-init state when fast booting
 		EnableThreadPinning : 1,
+		EnableHugePages : 1, // backs guest memory and the recompiler caches with huge pages where supported
 		// TODO - Vaser - where are these settings exposed in the Qt UI?
 		EnableRecordingTools : 1,
 		EnableGameFixes : 1, // enables automatic game fixes
@@ -1346,6 +1402,13 @@ struct Pcsx2Config
 
 	int PINESlot;
 
+	int SharedSnapshotWidth; // size of the published frame, 0 to only publish memory
+	int SharedSnapshotHeight;
+	std::string SharedSnapshotRanges; // comma separated hex address:size pairs of EE memory
+
+	int CdvdDecompressThreads; // worker threads for decompressing CHD/CSO images in parallel, 0 disables
+	int CdvdPrefetchDepth; // maximum number of hunks the CHD prefetcher may run ahead of the reader
+
 	int RtcYear;
 	int RtcMonth;
 	int RtcDay;
@@ -1446,7 +1509,7 @@ namespace EmuFolders
 #endif
 #define INSTANT_VU1 (EmuConfig.Speedhacks.vu1Instant)
 #define CHECK_EEREC (EmuConfig.Cpu.Recompiler.EnableEE)
-#define CHECK_CACHE (EmuConfig.Cpu.Recompiler.EnableEECache)
+#define CHECK_CACHE (EmuConfig.Cpu.Recompiler.EnableEECache || EmuConfig.Gamefixes.EECacheHack)
 #define CHECK_IOPREC (EmuConfig.Cpu.Recompiler.EnableIOP)
 #define CHECK_FASTMEM (EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableFastmem)
 #define CHECK_EXTRAMEM (memGetExtraMemMode())
@@ -1460,11 +1523,13 @@ namespace EmuFolders
 #define CHECK_SKIPMPEGHACK (EmuConfig.Gamefixes.SkipMPEGHack) // Finds sceMpegIsEnd pattern to tell the game the mpeg is finished (Katamari and a lot of games need this)
 #define CHECK_OPHFLAGHACK (EmuConfig.Gamefixes.OPHFlagHack) // Bleach Blade Battlers
 #define CHECK_DMABUSYHACK (EmuConfig.Gamefixes.DMABusyHack) // Denies writes to the DMAC when it's busy. This is correct behaviour but bad timing can cause problems.
+#define CHECK_DMASLICEHACK (EmuConfig.Gamefixes.DMASliceHack) // Always splits GIF/VIF1 DMA transfers for timing, even when nothing else is running.
 #define CHECK_VIFFIFOHACK (EmuConfig.Gamefixes.VIFFIFOHack) // Pretends to fill the non-existant VIF FIFO Buffer.
 #define CHECK_VIF1STALLHACK (EmuConfig.Gamefixes.VIF1StallHack) // Like above, processes FIFO data before the stall is allowed (to make sure data goes over).
 #define CHECK_GIFFIFOHACK (EmuConfig.Gamefixes.GIFFIFOHack) // Enabled the GIF FIFO (more correct but slower)
 #define CHECK_VUOVERFLOWHACK (EmuConfig.Gamefixes.VUOverflowHack) // Special Fix for Superman Returns, they check for overflows on PS2 floats which we can't do without soft floats.
 #define CHECK_FULLVU0SYNCHACK (EmuConfig.Gamefixes.FullVU0SyncHack)
+#define CHECK_MTVUSTALEREADHACK (EmuConfig.Gamefixes.MTVUStaleReadHack)
 
 //------------ Advanced Options!!! ---------------
 #define CHECK_VU_OVERFLOW(vunum) (((vunum) == 0) ? EmuConfig.Cpu.Recompiler.vu0Overflow : EmuConfig.Cpu.Recompiler.vu1Overflow)
@@ -1472,8 +1537,9 @@ namespace EmuFolders
 #define CHECK_VU_SIGN_OVERFLOW(vunum) (((vunum) == 0) ? EmuConfig.Cpu.Recompiler.vu0SignOverflow : EmuConfig.Cpu.Recompiler.vu1SignOverflow)
 #define CHECK_VU_UNDERFLOW(vunum) (((vunum) == 0) ? EmuConfig.Cpu.Recompiler.vu0Underflow : EmuConfig.Cpu.Recompiler.vu1Underflow)
 
-#define CHECK_FPU_OVERFLOW (EmuConfig.Cpu.Recompiler.fpuOverflow)
-#define CHECK_FPU_EXTRA_OVERFLOW (EmuConfig.Cpu.Recompiler.fpuExtraOverflow) // If enabled, Operands are checked for infinities before being used in the FPU recs
+#define CHECK_FPU_ACCURATE (EmuConfig.Gamefixes.FpuAccurateHack) // Clamps results to the signed maximum and raises O flags, implies extra overflow
+#define CHECK_FPU_OVERFLOW (EmuConfig.Cpu.Recompiler.fpuOverflow || CHECK_FPU_ACCURATE)
+#define CHECK_FPU_EXTRA_OVERFLOW (EmuConfig.Cpu.Recompiler.fpuExtraOverflow || CHECK_FPU_ACCURATE) // If enabled, Operands are checked for infinities before being used in the FPU recs
 #define CHECK_FPU_EXTRA_FLAGS 1 // Always enabled now // Sets D/I flags on FPU instructions
 #define CHECK_FPU_FULL (EmuConfig.Cpu.Recompiler.fpuFullMode)
 
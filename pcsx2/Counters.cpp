@@ -496,6 +496,10 @@ static __fi void VSyncStart(u32 sCycle)
 
 	gsPostVsyncStart(); // MUST be after framelimit; doing so before causes funk with frame times!
 
+	// The frame has already gone to the GS, so waiting here only moves the input poll and the next frame later.
+	if (!VMManager::Internal::IsExecutionInterrupted())
+		VMManager::Internal::DelayFrameStart();
+
 	// Poll input after MTGS frame push, just in case it has to stall to catch up.
 	VMManager::Internal::PollInputOnCPUThread();
 
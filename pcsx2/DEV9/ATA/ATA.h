@@ -116,6 +116,9 @@ private:
 		u64 sector;
 	};
 	SimpleQueue<WriteQueueEntry> writeQueue;
+	//Contiguous queued writes are merged into one file write
+	static constexpr u32 maxCoalescedWriteSize = 1024 * 1024;
+	std::unique_ptr<u8[]> coalescedWrite;
 
 	std::thread ioThread;
 	bool ioRunning = false;
@@ -138,6 +141,12 @@ private:
 	//Max tranfer on 48bit is 65536*512 = 32MB
 	int readBufferLen;
 	u8* readBuffer = nullptr;
+	//Sequential reads fetch the following sectors ahead of time
+	static constexpr u32 readAheadSectors = 2048;
+	std::unique_ptr<u8[]> readAheadBuffer;
+	s64 readAheadLBA = -1;
+	u32 readAheadLen = 0;
+	s64 lastReadEndLBA = -1;
 	//Read Buffer
 
 	//PIO Buffer
@@ -211,7 +220,9 @@ private:
 	//Transfer
 	void IO_Thread();
 	void IO_Read();
+	void IO_ReadSectors(s64 lba, u8* buffer, u32 sectors);
 	bool IO_Write();
+	void IO_WriteSectors(u64 sector, const u8* data, u32 length);
 	bool IO_SparseZero(u64 byteOffset, u64 byteSize);
 	void IO_SparseCacheUpdateLocation(u64 Offset);
 	void IO_SparseCacheLoad();
@@ -38,6 +38,11 @@ int ATA::Open(const std::string& hddPath)
 {
 	readBufferLen = 256 * 512;
 	readBuffer = new u8[readBufferLen];
+	readAheadBuffer = std::make_unique<u8[]>(readAheadSectors * 512);
+	readAheadLBA = -1;
+	readAheadLen = 0;
+	lastReadEndLBA = -1;
+	coalescedWrite = std::make_unique<u8[]>(maxCoalescedWriteSize);
 	memset(sceSec, 0, sizeof(sceSec));
 
 	DevCon.WriteLn("DEV9: ATA: HddFile : %s", hddPath.c_str());
@@ -289,6 +294,9 @@ void ATA::Close()
 
 	delete[] readBuffer;
 	readBuffer = nullptr;
+	readAheadBuffer = nullptr;
+	readAheadLBA = -1;
+	coalescedWrite = nullptr;
 }
 
 void ATA::ResetBegin()
@@ -67,18 +67,43 @@ void ATA::IO_Read()
 		abort();
 	}
 
+	if (readAheadLBA != -1 && lba >= readAheadLBA && lba + nsector <= readAheadLBA + readAheadLen)
+	{
+		//Already fetched by an earlier sequential read
+		memcpy(readBuffer, &readAheadBuffer[(lba - readAheadLBA) * 512], nsector * 512);
+	}
+	else if (lba == lastReadEndLBA && static_cast<u32>(nsector) <= readAheadSectors)
+	{
+		//Sequential read, fetch the following sectors along with this request
+		//nsector has already been limited to the end of the image
+		const s64 sectorsLeft = static_cast<s64>(hddImageSize / 512) - lba;
+		const u32 sectors = static_cast<u32>(std::min<s64>(readAheadSectors, sectorsLeft));
+		IO_ReadSectors(lba, readAheadBuffer.get(), sectors);
+		readAheadLBA = lba;
+		readAheadLen = sectors;
+		memcpy(readBuffer, readAheadBuffer.get(), nsector * 512);
+	}
+	else
+		IO_ReadSectors(lba, readBuffer, nsector);
+
+	lastReadEndLBA = lba + nsector;
+
+	{
+		std::lock_guard ioSignallock(ioMutex);
+		ioRead = false;
+	}
+}
+
+void ATA::IO_ReadSectors(s64 lba, u8* buffer, u32 sectors)
+{
 	const u64 pos = lba * 512;
 	if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
-		std::fread(readBuffer,  512, nsector, hddImage) != static_cast<size_t>(nsector))
+		std::fread(buffer, 512, sectors, hddImage) != sectors)
 	{
 		Console.Error("DEV9: ATA: File read error");
 		pxAssert(false);
 		abort();
 	}
-	{
-		std::lock_guard ioSignallock(ioMutex);
-		ioRead = false;
-	}
 }
 
 bool ATA::IO_Write()
@@ -91,7 +116,64 @@ bool ATA::IO_Write()
 		return false;
 	}
 
-	const u64 imagePos = entry.sector * 512;
+	//Merge contiguous entries, so a run of sequential DMA writes
+	//only needs a single seek, write and flush
+	u64 runSector = entry.sector;
+	u8* runData = entry.data;
+	u32 runLength = entry.length;
+	bool runCoalesced = false;
+	u32 batchLength = entry.length;
+
+	while (batchLength < maxCoalescedWriteSize && writeQueue.Dequeue(&entry))
+	{
+		batchLength += entry.length;
+		if (entry.sector == runSector + runLength / 512 && runLength + entry.length <= maxCoalescedWriteSize)
+		{
+			if (!runCoalesced)
+			{
+				memcpy(coalescedWrite.get(), runData, runLength);
+				delete[] runData;
+				runData = coalescedWrite.get();
+				runCoalesced = true;
+			}
+			memcpy(&coalescedWrite[runLength], entry.data, entry.length);
+			runLength += entry.length;
+			delete[] entry.data;
+		}
+		else
+		{
+			IO_WriteSectors(runSector, runData, runLength);
+			if (!runCoalesced)
+				delete[] runData;
+
+			runSector = entry.sector;
+			runData = entry.data;
+			runLength = entry.length;
+			runCoalesced = false;
+		}
+	}
+
+	IO_WriteSectors(runSector, runData, runLength);
+	if (!runCoalesced)
+		delete[] runData;
+
+	if (std::fflush(hddImage) != 0)
+	{
+		Console.Error("DEV9: ATA: File write error");
+		pxAssert(false);
+		abort();
+	}
+	return true;
+}
+
+void ATA::IO_WriteSectors(u64 sector, const u8* data, u32 length)
+{
+	//Drop read ahead data this write makes stale
+	if (readAheadLBA != -1 && static_cast<s64>(sector) < readAheadLBA + readAheadLen &&
+		static_cast<s64>(sector + length / 512) > readAheadLBA)
+		readAheadLBA = -1;
+
+	const u64 imagePos = sector * 512;
 	if (FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
 	{
 		Console.Error("DEV9: ATA: File seek error");
@@ -101,29 +183,31 @@ bool ATA::IO_Write()
 	if (hddSparse)
 	{
 		u32 written = 0;
-		while (written != entry.length)
+		while (written != length)
 		{
 			IO_SparseCacheUpdateLocation(imagePos + written);
 			// Align to sparse block size.
 			u32 writeSize = hddSparseBlockSize - ((imagePos + written) % hddSparseBlockSize);
 			// Limit to size of write.
-			writeSize = std::min(writeSize, entry.length - written);
+			writeSize = std::min(writeSize, length - written);
 
 			pxAssert(writeSize > 0);
 			pxAssert(writeSize <= hddSparseBlockSize);
 			pxAssert((imagePos + written) >= HddSparseStart);
 			pxAssert((imagePos + written) - HddSparseStart + writeSize <= hddSparseBlockSize);
 
-			bool sparseWrite = IsAllZero(&entry.data[written], writeSize);
+			bool sparseWrite = IsAllZero(&data[written], writeSize);
 
 			if (sparseWrite)
 			{
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 				std::unique_ptr<u8[]> zeroBlock = std::make_unique<u8[]>(writeSize);
 				memset(zeroBlock.get(), 0, writeSize);
-				pxAssert(memcmp(&entry.data[written], zeroBlock.get(), writeSize) == 0);
+				pxAssert(memcmp(&data[written], zeroBlock.get(), writeSize) == 0);
 #endif
 
+				//Buffered data for this region must reach the file before it is zeroed
+				std::fflush(hddImage);
 				if (!IO_SparseZero(imagePos + written, writeSize))
 				{
 					Console.Error("DEV9: ATA: File sparse write error");
@@ -149,15 +233,14 @@ bool ATA::IO_Write()
 				{
 					std::unique_ptr<u8[]> zeroBlock = std::make_unique<u8[]>(writeSize);
 					memset(zeroBlock.get(), 0, writeSize);
-					pxAssert(memcmp(&entry.data[written], zeroBlock.get(), writeSize) != 0);
+					pxAssert(memcmp(&data[written], zeroBlock.get(), writeSize) != 0);
 				}
 #endif
 				// Update cache.
 				if (hddSparseBlockValid)
-					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &entry.data[written], writeSize);
+					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &data[written], writeSize);
 
-				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1 ||
-					std::fflush(hddImage) != 0)
+				if (std::fwrite(&data[written], writeSize, 1, hddImage) != 1)
 				{
 					Console.Error("DEV9: ATA: File write error");
 					pxAssert(false);
@@ -170,15 +253,13 @@ bool ATA::IO_Write()
 	}
 	else
 	{
-		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
+		if (std::fwrite(data, length, 1, hddImage) != 1)
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
 			abort();
 		}
 	}
-	delete[] entry.data;
-	return true;
 }
 
 void ATA::IO_SparseCacheLoad()
@@ -30,6 +30,8 @@ using namespace PacketReader::IP::UDP;
 
 namespace Sessions::UDP_Common
 {
+	static constexpr int MAX_DATAGRAM_SIZE = 65536;
+
 #ifdef _WIN32
 	SOCKET CreateSocket(IP_Address adapterIP, std::optional<u16> port)
 	{
@@ -134,29 +136,18 @@ namespace Sessions::UDP_Common
 		}
 		else if (FD_ISSET(client, &sReady))
 		{
-			unsigned long available = 0;
+			// Large enough for any datagram, avoids querying the size
+			// with FIONREAD and allocating a buffer for every packet
+			static thread_local u8 buffer[MAX_DATAGRAM_SIZE];
 			PayloadData* recived = nullptr;
-			std::unique_ptr<u8[]> buffer;
 			sockaddr_in endpoint{};
 
-			// FIONREAD returns total size of all available messages
-			// however, we only read one message at a time
 #ifdef _WIN32
-			ret = ioctlsocket(client, FIONREAD, &available);
+			int fromlen = sizeof(endpoint);
 #elif defined(__POSIX__)
-			ret = ioctl(client, FIONREAD, &available);
+			socklen_t fromlen = sizeof(endpoint);
 #endif
-			if (ret != SOCKET_ERROR)
-			{
-				buffer = std::make_unique<u8[]>(available);
-
-#ifdef _WIN32
-				int fromlen = sizeof(endpoint);
-#elif defined(__POSIX__)
-				socklen_t fromlen = sizeof(endpoint);
-#endif
-				ret = recvfrom(client, reinterpret_cast<char*>(buffer.get()), available, 0, reinterpret_cast<sockaddr*>(&endpoint), &fromlen);
-			}
+			ret = recvfrom(client, reinterpret_cast<char*>(buffer), sizeof(buffer), 0, reinterpret_cast<sockaddr*>(&endpoint), &fromlen);
 
 			if (ret == SOCKET_ERROR)
 			{
@@ -180,7 +171,7 @@ namespace Sessions::UDP_Common
 			}
 
 			recived = new PayloadData(ret);
-			memcpy(recived->data.get(), buffer.get(), ret);
+			memcpy(recived->data.get(), buffer, ret);
 
 			std::unique_ptr<UDP_Packet> iRet = std::make_unique<UDP_Packet>(recived);
 			iRet->destinationPort = port;
@@ -66,6 +66,22 @@ public:
 		return keys;
 	}
 
+	//Reuses the storage of keys, for callers polling every frame
+	void GetKeys(std::vector<Key>* keys)
+	{
+#ifdef NO_SHARED_MUTEX
+		std::unique_lock readLock(accessMutex);
+#else
+		std::shared_lock readLock(accessMutex);
+#endif
+
+		keys->clear();
+		keys->reserve(map.size());
+
+		for (auto iter = map.begin(); iter != map.end(); ++iter)
+			keys->push_back(iter->first);
+	}
+
 	//Does not error or insert if no key is found
 	bool TryGetValue(Key key, T* value)
 	{
@@ -77,7 +93,7 @@ public:
 		auto search = map.find(key);
 		if (search != map.end())
 		{
-			*value = map[key];
+			*value = search->second;
 			return true;
 		}
 		else
@@ -270,6 +270,7 @@ bool PCAPAdapter::InitPCAP(const std::string& adapter, bool promiscuous)
 	char errbuf[PCAP_ERRBUF_SIZE];
 	Console.WriteLn("DEV9: Opening adapter '%s'...", adapter.c_str());
 
+#ifdef _WIN32
 	// Open the adapter.
 	if ((hpcap = pcap_open_live(adapter.c_str(), // Name of the device.
 			 65536, // portion of the packet to capture.
@@ -283,6 +284,36 @@ bool PCAPAdapter::InitPCAP(const std::string& adapter, bool promiscuous)
 		Console.Error("DEV9: Unable to open the adapter. %s is not supported by pcap", adapter.c_str());
 		return false;
 	}
+#else
+	if ((hpcap = pcap_create(adapter.c_str(), errbuf)) == nullptr)
+	{
+		Console.Error("DEV9: %s", errbuf);
+		Console.Error("DEV9: Unable to open the adapter. %s is not supported by pcap", adapter.c_str());
+		return false;
+	}
+
+	// 65536 grants that the whole packet will be captured on all the MACs.
+	pcap_set_snaplen(hpcap, 65536);
+	pcap_set_promisc(hpcap, promiscuous ? 1 : 0);
+	pcap_set_timeout(hpcap, 1);
+	// Linux captures into a memory mapped ring, which is otherwise only handed
+	// to us once a block fills or the read timeout expires.
+	// Immediate mode makes each packet available as soon as it arrives.
+	if (pcap_set_immediate_mode(hpcap, 1) != 0)
+		Console.Warning("DEV9: Failed to enable immediate mode");
+
+	const int activateRet = pcap_activate(hpcap);
+	if (activateRet < 0)
+	{
+		Console.Error("DEV9: %s", pcap_geterr(hpcap));
+		Console.Error("DEV9: Unable to open the adapter. %s is not supported by pcap", adapter.c_str());
+		pcap_close(hpcap);
+		hpcap = nullptr;
+		return false;
+	}
+	else if (activateRet > 0)
+		Console.Warning("DEV9: %s", pcap_geterr(hpcap));
+#endif
 
 	if (pcap_setnonblock(hpcap, 1, errbuf) == -1)
 	{
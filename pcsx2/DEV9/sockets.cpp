@@ -216,10 +216,14 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	if (!vRecBuffer.Dequeue(&bFrame))
 	{
 		std::lock_guard deletelock(deleteSendSentry);
-		std::vector<ConnectionKey> keys = connections.GetKeys();
-		for (size_t i = 0; i < keys.size(); i++)
+		connections.GetKeys(&recvKeys);
+		const size_t count = recvKeys.size();
+		for (size_t i = 0; i < count; i++)
 		{
-			const ConnectionKey key = keys[i];
+			// Start after the session that last returned data
+			// so a busy session can't starve the others
+			const size_t index = (recvNextSession + i) % count;
+			const ConnectionKey key = recvKeys[index];
 
 			BaseSession* session;
 			if (!connections.TryGetValue(key, &session))
@@ -229,6 +233,8 @@ bool SocketAdapter::recv(NetPacket* pkt)
 
 			if (pl.has_value())
 			{
+				recvNextSession = index + 1;
+
 				IP_Packet* ipPkt = new IP_Packet(pl->payload.release());
 				ipPkt->destinationIP = session->sourceIP;
 				ipPkt->sourceIP = pl->sourceIP;
@@ -27,6 +27,10 @@ class SocketAdapter : public NetAdapter
 	ThreadSafeMap<Sessions::ConnectionKey, Sessions::BaseSession*> connections;
 	ThreadSafeMap<u16, Sessions::BaseSession*> fixedUDPPorts;
 
+	//Used by the recv thread to poll the connections
+	std::vector<Sessions::ConnectionKey> recvKeys;
+	size_t recvNextSession = 0;
+
 	std::thread::id sendThreadId;
 	std::vector<Sessions::BaseSession*> deleteQueueSendThread;
 	std::vector<Sessions::BaseSession*> deleteQueueRecvThread;
@@ -209,6 +209,24 @@ struct ConsoleLogPack
 extern TraceLogPack TraceLogging;
 extern ConsoleLogPack ConsoleLogging;
 
+// --------------------------------------------------------------------------------------
+//  TraceBuffer
+// --------------------------------------------------------------------------------------
+// Optional output path for trace logs. When open, TraceLog::Write formats into a ring owned
+// by the calling thread instead of going through Log::Write, and a background thread writes
+// the collected messages to the trace file.
+//
+namespace TraceBuffer
+{
+	/// Starts the writer thread, all trace output is redirected to the given file until Close().
+	void Open(std::string path);
+
+	/// Writes out any pending messages and stops the writer thread.
+	void Close();
+
+	bool IsOpen();
+} // namespace TraceBuffer
+
 // Helper macro for cut&paste.  Note that we intentionally use a top-level *inline* bitcheck
 // against Trace.Enabled, to avoid extra overhead in Debug builds when logging is disabled.
 // (specifically this allows debug builds to skip havingto resolve all the parameters being
@@ -17,18 +17,45 @@ bool isInInterval(u32 start, u32 size, u32 value)
 	return start <= value && value <= (start+size-1);
 }
 
-static u32 computeHash(u32 address, u32 size)
+static u32 computeHash(DebugInterface* cpu, u32 address, u32 size)
 {
 	u32 end = address+size;
 	u32 hash = 0xBACD7814;
 	while (address < end)
 	{
-		hash += r5900Debug.read32(address);
+		hash += cpu->read32(address);
 		address += 4;
 	}
 	return hash;
 }
 
+// Collects the write stamps of the EE ram pages covering the range. While the recompiler
+// keeps a page write protected its stamp doesn't change, so a range with the same non-zero
+// stamps as before is known to be unmodified and doesn't have to be hashed again.
+static void getPageStamps(DebugInterface* cpu, u32 address, u32 size, std::vector<u32>& dest)
+{
+	dest.clear();
+	if (cpu->getCpuType() != BREAKPOINT_EE || size == 0)
+		return;
+
+	const u32 first = address >> 12;
+	const u32 last = (address + size - 1) >> 12;
+	for (u32 page = first; page <= last; page++)
+		dest.push_back(mmap_GetRamPageWriteStamp(page << 12));
+}
+
+static bool pageStampsUnchanged(DebugInterface* cpu, u32 address, u32 size, std::vector<u32>& stamps)
+{
+	std::vector<u32> current;
+	getPageStamps(cpu, address, size, current);
+
+	const bool unchanged = !current.empty() && current == stamps &&
+		std::find(current.begin(), current.end(), 0u) == current.end();
+
+	stamps = std::move(current);
+	return unchanged;
+}
+
 
 static void parseDisasm(SymbolGuardian& guardian, const char* disasm, char* opcode, char* arguments, size_t arguments_size, bool insertSymbols)
 {
@@ -352,13 +379,17 @@ void DisassemblyManager::clear()
 DisassemblyFunction::DisassemblyFunction(DebugInterface* _cpu, u32 _address, u32 _size): address(_address), size(_size)
 {
 	cpu = _cpu;
-	hash = computeHash(address,size);
+	hash = computeHash(cpu,address,size);
+	getPageStamps(cpu,address,size,pageStamps);
 	load();
 }
 
 void DisassemblyFunction::recheck()
 {
-	u32 newHash = computeHash(address,size);
+	if (pageStampsUnchanged(cpu,address,size,pageStamps))
+		return;
+
+	u32 newHash = computeHash(cpu,address,size);
 	if (hash != newHash)
 	{
 		hash = newHash;
@@ -841,13 +872,17 @@ bool DisassemblyMacro::disassemble(u32 address, DisassemblyLineInfo& dest, bool
 DisassemblyData::DisassemblyData(DebugInterface* _cpu, u32 _address, u32 _size, DataType _type): address(_address), size(_size), type(_type)
 {
 	cpu = _cpu;
-	hash = computeHash(address,size);
+	hash = computeHash(cpu,address,size);
+	getPageStamps(cpu,address,size,pageStamps);
 	createLines();
 }
 
 void DisassemblyData::recheck()
 {
-	u32 newHash = computeHash(address,size);
+	if (pageStampsUnchanged(cpu,address,size,pageStamps))
+		return;
+
+	u32 newHash = computeHash(cpu,address,size);
 	if (newHash != hash)
 	{
 		hash = newHash;
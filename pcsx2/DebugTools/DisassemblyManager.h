@@ -71,6 +71,7 @@ private:
 	u32 address;
 	u32 size;
 	u32 hash;
+	std::vector<u32> pageStamps;
 	std::vector<BranchLine> lines;
 	std::map<u32,DisassemblyEntry*> entries;
 	std::vector<u32> lineAddresses;
@@ -158,6 +159,7 @@ private:
 	u32 address;
 	u32 size;
 	u32 hash;
+	std::vector<u32> pageStamps;
 	DataType type;
 	std::map<u32,DataEntry> lines;
 	std::vector<u32> lineAddresses;
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "DebugTools/GuestProfiler.h"
+#include "DebugTools/SymbolGuardian.h"
+#include "Config.h"
+#include "Host.h"
+#include "R5900.h"
+#include "VMManager.h"
+#include "VUmicro.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
+
+#include "IconsFontAwesome6.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace GuestProfiler
+{
+	static constexpr int SAMPLE_INTERVAL_MS = 1;
+	static constexpr u32 TOP_FUNCTIONS_TO_LOG = 10;
+
+	static void SampleThread();
+	static void WriteProfile();
+
+	static std::thread s_thread;
+	static std::atomic_bool s_running{false};
+
+	// Only touched by the sampling thread while it is running, and by the CPU thread after it has been joined.
+	static std::unordered_map<u32, u32> s_ee_samples;
+	static std::unordered_map<u32, u32> s_vu1_samples;
+	static u32 s_total_samples = 0;
+} // namespace GuestProfiler
+
+bool GuestProfiler::IsActive()
+{
+	return s_thread.joinable();
+}
+
+void GuestProfiler::Start()
+{
+	if (s_thread.joinable())
+		return;
+
+	s_ee_samples.clear();
+	s_vu1_samples.clear();
+	s_total_samples = 0;
+	s_running.store(true, std::memory_order_release);
+	s_thread = std::thread(SampleThread);
+
+	Host::AddIconOSDMessage("GuestProfiler", ICON_FA_STOPWATCH,
+		TRANSLATE_SV("GuestProfiler", "Guest profiler started."), Host::OSD_QUICK_DURATION);
+}
+
+void GuestProfiler::Stop()
+{
+	if (!s_thread.joinable())
+		return;
+
+	s_running.store(false, std::memory_order_release);
+	s_thread.join();
+
+	WriteProfile();
+	s_ee_samples = {};
+	s_vu1_samples = {};
+}
+
+void GuestProfiler::Toggle()
+{
+	if (IsActive())
+		Stop();
+	else
+		Start();
+}
+
+void GuestProfiler::SampleThread()
+{
+	Threading::SetNameOfCurrentThread("Guest Profiler");
+
+	while (s_running.load(std::memory_order_acquire))
+	{
+		Threading::Sleep(SAMPLE_INTERVAL_MS);
+
+		if (VMManager::GetState() != VMState::Running)
+			continue;
+
+		// These are read without synchronization, a torn or slightly stale PC only shifts one sample.
+		// The recompilers update the PC at block boundaries, so EE samples land on the current block.
+		s_ee_samples[cpuRegs.pc]++;
+		if (VU0.VI[REG_VPU_STAT].UL & 0x100)
+			s_vu1_samples[VU1.start_pc]++;
+		s_total_samples++;
+	}
+}
+
+void GuestProfiler::WriteProfile()
+{
+	if (s_total_samples == 0)
+		return;
+
+	// Resolve on the CPU thread now that sampling is done, so the sampler never waits on the symbol lock.
+	std::unordered_map<std::string, u32> functions;
+	for (const auto& [pc, count] : s_ee_samples)
+	{
+		const FunctionInfo function = R5900SymbolGuardian.FunctionOverlappingAddress(pc);
+		std::string name = function.name.empty() ? fmt::format("{:08X}", pc) : function.name;
+		functions[fmt::format("EE;{}", name)] += count;
+	}
+	for (const auto& [pc, count] : s_vu1_samples)
+		functions[fmt::format("VU1;program_{:04X}", pc)] += count;
+
+	std::vector<std::pair<std::string, u32>> sorted(functions.begin(), functions.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+	const std::string serial = VMManager::GetDiscSerial();
+	const std::string filename = Path::Combine(EmuFolders::Logs,
+		fmt::format("guest_profile_{}_{}.folded", serial.empty() ? "unknown" : serial, static_cast<u64>(std::time(nullptr))));
+
+	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb");
+	if (!fp)
+	{
+		Console.Error(fmt::format("GuestProfiler: Failed to open '{}' for writing.", filename));
+		return;
+	}
+
+	for (const auto& [stack, count] : sorted)
+		std::fprintf(fp.get(), "%s %u\n", stack.c_str(), count);
+
+	Console.WriteLn(fmt::format("GuestProfiler: {} samples written to '{}'.", s_total_samples, filename));
+	for (u32 i = 0; i < std::min<u32>(TOP_FUNCTIONS_TO_LOG, static_cast<u32>(sorted.size())); i++)
+	{
+		Console.WriteLn(fmt::format("  {:5.1f}% {}", static_cast<double>(sorted[i].second) * 100.0 / s_total_samples,
+			sorted[i].first));
+	}
+
+	Host::AddIconOSDMessage("GuestProfiler", ICON_FA_STOPWATCH,
+		fmt::format(TRANSLATE_FS("GuestProfiler", "Guest profile saved to '{}'."), Path::GetFileName(filename)),
+		Host::OSD_INFO_DURATION);
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+// Lightweight sampling profiler for guest code. A background thread periodically
+// samples the EE PC and the running VU1 program, and on stop the samples are grouped
+// by guest function and written out in the folded stack format used by flamegraph.pl.
+namespace GuestProfiler
+{
+	bool IsActive();
+
+	// Starts sampling, should be called from the CPU thread while a VM is running.
+	void Start();
+
+	// Stops sampling and writes the profile to the logs directory.
+	void Stop();
+
+	void Toggle();
+} // namespace GuestProfiler
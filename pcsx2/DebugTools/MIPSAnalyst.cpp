@@ -315,6 +315,10 @@ namespace MIPSAnalyst
 			return;
 		}
 
+		// Hashes are generated once all the symbols have been created, since
+		// creating symbols can invalidate pointers to existing ones.
+		std::vector<ccc::FunctionHandle> functionsToHash;
+
 		for (const AnalyzedFunction& function : functions) {
 			ccc::FunctionHandle handle = database.functions.first_handle_from_starting_address(function.start);
 			ccc::Function* symbol = database.functions.symbol_from_handle(handle);
@@ -354,14 +358,21 @@ namespace MIPSAnalyst
 			}
 
 			if (generateHash) {
-				std::optional<ccc::FunctionHash> hash = SymbolGuardian::HashFunction(*symbol, reader);
-				if (hash.has_value()) {
-					symbol->set_original_hash(hash->get());
-				}
+				functionsToHash.emplace_back(symbol->handle());
 			}
 
 			symbol->is_no_return = function.suspectedNoReturn;
 		}
+
+		std::vector<ccc::Function*> symbolsToHash;
+		symbolsToHash.reserve(functionsToHash.size());
+		for (ccc::FunctionHandle handle : functionsToHash) {
+			if (ccc::Function* symbol = database.functions.symbol_from_handle(handle)) {
+				symbolsToHash.emplace_back(symbol);
+			}
+		}
+
+		SymbolGuardian::HashFunctions(symbolsToHash, reader, true);
 	}
 
 	MipsOpcodeInfo GetOpcodeInfo(DebugInterface* cpu, u32 address) {
@@ -6,6 +6,9 @@
 #include "DebugInterface.h"
 #include "Host.h"
 
+#include <algorithm>
+#include <future>
+
 SymbolGuardian R5900SymbolGuardian;
 SymbolGuardian R3000SymbolGuardian;
 
@@ -154,29 +157,21 @@ FunctionInfo SymbolGuardian::FunctionOverlappingAddress(u32 address) const
 
 void SymbolGuardian::GenerateFunctionHashes(ccc::SymbolDatabase& database, MemoryReader& reader)
 {
+	std::vector<ccc::Function*> functions;
 	for (ccc::Function& function : database.functions)
-	{
-		std::optional<ccc::FunctionHash> hash = HashFunction(function, reader);
-		if (!hash.has_value())
-			continue;
+		functions.emplace_back(&function);
 
-		function.set_original_hash(hash->get());
-	}
+	HashFunctions(functions, reader, true);
 }
 
 void SymbolGuardian::UpdateFunctionHashes(ccc::SymbolDatabase& database, MemoryReader& reader)
 {
+	std::vector<ccc::Function*> functions;
 	for (ccc::Function& function : database.functions)
-	{
-		if (function.original_hash() == 0)
-			continue;
+		if (function.original_hash() != 0)
+			functions.emplace_back(&function);
 
-		std::optional<ccc::FunctionHash> hash = HashFunction(function, reader);
-		if (!hash.has_value())
-			continue;
-
-		function.set_current_hash(*hash);
-	}
+	HashFunctions(functions, reader, false);
 
 	for (ccc::SourceFile& source_file : database.source_files)
 		source_file.check_functions_match(database);
@@ -205,6 +200,40 @@ std::optional<ccc::FunctionHash> SymbolGuardian::HashFunction(const ccc::Functio
 	return hash;
 }
 
+void SymbolGuardian::HashFunctions(const std::vector<ccc::Function*>& functions, MemoryReader& reader, bool original)
+{
+	// Not worth spinning up threads for small symbol tables.
+	static constexpr size_t MIN_FUNCTIONS_PER_TASK = 1024;
+
+	const size_t max_tasks = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	const size_t task_count = std::clamp<size_t>(functions.size() / MIN_FUNCTIONS_PER_TASK, 1, max_tasks);
+	const size_t functions_per_task = (functions.size() + task_count - 1) / task_count;
+
+	// Each function is only written to by a single task.
+	const auto hash_range = [&functions, &reader, original](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			std::optional<ccc::FunctionHash> hash = HashFunction(*functions[i], reader);
+			if (!hash.has_value())
+				continue;
+
+			if (original)
+				functions[i]->set_original_hash(hash->get());
+			else
+				functions[i]->set_current_hash(*hash);
+		}
+	};
+
+	std::vector<std::future<void>> tasks;
+	for (size_t begin = functions_per_task; begin < functions.size(); begin += functions_per_task)
+		tasks.push_back(std::async(std::launch::async, hash_range, begin, std::min(begin + functions_per_task, functions.size())));
+
+	hash_range(0, std::min(functions_per_task, functions.size()));
+
+	for (std::future<void>& task : tasks)
+		task.wait();
+}
+
 void SymbolGuardian::ClearIrxModules()
 {
 	ReadWrite([&](ccc::SymbolDatabase& database) {
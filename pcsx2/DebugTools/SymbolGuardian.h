@@ -85,6 +85,11 @@ public:
 	// Hash a function and return the result.
 	static std::optional<ccc::FunctionHash> HashFunction(const ccc::Function& function, MemoryReader& reader);
 
+	// Hash the given functions, split across multiple threads if there are
+	// lots of them, and store the results in either the original or the
+	// current hash fields. The reader must be safe to use from any thread.
+	static void HashFunctions(const std::vector<ccc::Function*>& functions, MemoryReader& reader, bool original);
+
 	// Delete all symbols from modules that have the "is_irx" flag set.
 	void ClearIrxModules();
 
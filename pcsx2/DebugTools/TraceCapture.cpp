@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "DebugTools/TraceCapture.h"
+#include "Config.h"
+#include "Host.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+
+#include "IconsFontAwesome6.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TraceCapture
+{
+	// Per thread, so roughly a minute of the busier threads at a few hundred events per frame.
+	static constexpr u32 EVENTS_PER_THREAD = 65536;
+
+	struct Event
+	{
+		const char* name;
+		u64 start_time;
+		u64 end_time;
+	};
+
+	struct ThreadBuffer
+	{
+		std::string name;
+		u32 id = 0;
+		bool thread_exited = false;
+		u64 last_mark = 0;
+		std::unique_ptr<Event[]> events = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+
+		// Only written by the owning thread, the exporter reads the events below it.
+		std::atomic<u64> write_pos{0};
+
+		void Add(const char* event_name, u64 start_time, u64 end_time);
+	};
+
+	// Frees the buffer on the next capture once the thread is gone, the events it recorded are still exported.
+	struct ThreadBufferRef
+	{
+		ThreadBuffer* buffer = nullptr;
+
+		~ThreadBufferRef();
+	};
+
+	static ThreadBuffer* GetThreadBuffer();
+	static void WriteTrace();
+
+	static std::mutex s_buffers_lock;
+	static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+	static ThreadBuffer* s_gpu_buffer = nullptr;
+	static u32 s_next_thread_id = 1;
+	static u64 s_start_time = 0;
+
+	static thread_local ThreadBufferRef s_thread_buffer;
+} // namespace TraceCapture
+
+std::atomic_bool TraceCapture::Internal::s_active{false};
+
+void TraceCapture::ThreadBuffer::Add(const char* event_name, u64 start_time, u64 end_time)
+{
+	const u64 pos = write_pos.load(std::memory_order_relaxed);
+	events[pos % EVENTS_PER_THREAD] = {event_name, start_time, end_time};
+	write_pos.store(pos + 1, std::memory_order_release);
+}
+
+TraceCapture::ThreadBufferRef::~ThreadBufferRef()
+{
+	if (!buffer)
+		return;
+
+	std::unique_lock lock(s_buffers_lock);
+	buffer->thread_exited = true;
+}
+
+TraceCapture::ThreadBuffer* TraceCapture::GetThreadBuffer()
+{
+	if (s_thread_buffer.buffer)
+		return s_thread_buffer.buffer;
+
+	std::unique_lock lock(s_buffers_lock);
+	std::unique_ptr<ThreadBuffer>& buffer = s_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+	buffer->id = s_next_thread_id++;
+	buffer->name = fmt::format("Thread {}", buffer->id);
+	s_thread_buffer.buffer = buffer.get();
+	return buffer.get();
+}
+
+u64 TraceCapture::ScopedEvent::GetTime()
+{
+	return Common::Timer::GetCurrentValue();
+}
+
+void TraceCapture::Start()
+{
+	if (IsActive())
+		return;
+
+	{
+		std::unique_lock lock(s_buffers_lock);
+		s_buffers.erase(std::remove_if(s_buffers.begin(), s_buffers.end(),
+							[](const std::unique_ptr<ThreadBuffer>& buffer) { return buffer->thread_exited; }),
+			s_buffers.end());
+
+		if (!s_gpu_buffer)
+		{
+			std::unique_ptr<ThreadBuffer>& buffer = s_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+			buffer->id = s_next_thread_id++;
+			buffer->name = "GPU";
+			s_gpu_buffer = buffer.get();
+		}
+
+		s_start_time = Common::Timer::GetCurrentValue();
+		for (const std::unique_ptr<ThreadBuffer>& buffer : s_buffers)
+		{
+			buffer->write_pos.store(0, std::memory_order_relaxed);
+			buffer->last_mark = s_start_time;
+		}
+	}
+
+	Internal::s_active.store(true, std::memory_order_release);
+
+	Host::AddIconOSDMessage("TraceCapture", ICON_FA_STOPWATCH,
+		TRANSLATE_SV("TraceCapture", "Trace capture started."), Host::OSD_QUICK_DURATION);
+}
+
+void TraceCapture::Stop()
+{
+	if (!IsActive())
+		return;
+
+	Internal::s_active.store(false, std::memory_order_release);
+	WriteTrace();
+}
+
+void TraceCapture::Toggle()
+{
+	if (IsActive())
+		Stop();
+	else
+		Start();
+}
+
+void TraceCapture::SetThreadName(const char* name)
+{
+	ThreadBuffer* const buffer = GetThreadBuffer();
+
+	std::unique_lock lock(s_buffers_lock);
+	buffer->name = name;
+}
+
+void TraceCapture::AddEvent(const char* name, u64 start_time, u64 end_time)
+{
+	if (!IsActive())
+		return;
+
+	GetThreadBuffer()->Add(name, start_time, end_time);
+}
+
+void TraceCapture::MarkFrame(const char* name)
+{
+	if (!IsActive())
+		return;
+
+	ThreadBuffer* const buffer = GetThreadBuffer();
+	const u64 current_time = Common::Timer::GetCurrentValue();
+	if (buffer->last_mark > s_start_time)
+		buffer->Add(name, buffer->last_mark, current_time);
+	buffer->last_mark = current_time;
+}
+
+void TraceCapture::AddGPUFrame(float gpu_time_ms)
+{
+	if (!IsActive())
+		return;
+
+	// The backends only report the accumulated time, so place it just before the present.
+	const u64 current_time = Common::Timer::GetCurrentValue();
+	const u64 duration = static_cast<u64>(static_cast<double>(gpu_time_ms) /
+										  Common::Timer::ConvertValueToMilliseconds(1));
+	s_gpu_buffer->Add("GPU Frame", current_time - std::min(duration, current_time - s_start_time), current_time);
+}
+
+void TraceCapture::WriteTrace()
+{
+	const std::string serial = VMManager::GetDiscSerial();
+	const std::string filename = Path::Combine(EmuFolders::Logs,
+		fmt::format("trace_{}_{}.json", serial.empty() ? "unknown" : serial, static_cast<u64>(std::time(nullptr))));
+
+	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb");
+	if (!fp)
+	{
+		Console.Error(fmt::format("TraceCapture: Failed to open '{}' for writing.", filename));
+		return;
+	}
+
+	const auto to_us = [](u64 value) { return Common::Timer::ConvertValueToNanoseconds(value) / 1000.0; };
+
+	std::fprintf(fp.get(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	u64 total_events = 0;
+	bool first = true;
+	std::unique_lock lock(s_buffers_lock);
+	for (const std::unique_ptr<ThreadBuffer>& buffer : s_buffers)
+	{
+		const u64 end = buffer->write_pos.load(std::memory_order_acquire);
+		if (end == 0)
+			continue;
+
+		std::fprintf(fp.get(), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+			first ? "" : ",\n", buffer->id, buffer->name.c_str());
+		first = false;
+
+		for (u64 pos = end - std::min<u64>(end, EVENTS_PER_THREAD); pos < end; pos++)
+		{
+			const Event& ev = buffer->events[pos % EVENTS_PER_THREAD];
+			if (ev.start_time < s_start_time || ev.end_time < ev.start_time)
+				continue;
+
+			std::fprintf(fp.get(), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				ev.name, buffer->id, to_us(ev.start_time - s_start_time), to_us(ev.end_time - ev.start_time));
+			total_events++;
+		}
+	}
+	lock.unlock();
+
+	std::fprintf(fp.get(), "\n]}\n");
+
+	Console.WriteLn(fmt::format("TraceCapture: {} events written to '{}'.", total_events, filename));
+	Host::AddIconOSDMessage("TraceCapture", ICON_FA_STOPWATCH,
+		fmt::format(TRANSLATE_FS("TraceCapture", "Trace saved to '{}'."), Path::GetFileName(filename)),
+		Host::OSD_INFO_DURATION);
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+#include <atomic>
+
+// Timeline capture of scoped events across the emulator threads. Each thread records into its own
+// ring buffer while a capture is active, and on stop the rings are merged and written to the logs
+// directory in the Chrome trace event JSON format, which Perfetto and chrome://tracing both load.
+namespace TraceCapture
+{
+	namespace Internal
+	{
+		extern std::atomic_bool s_active;
+	}
+
+	__fi bool IsActive() { return Internal::s_active.load(std::memory_order_relaxed); }
+
+	void Start();
+
+	// Stops recording and writes the trace out.
+	void Stop();
+
+	void Toggle();
+
+	// Names the calling thread's track in the trace, threads which don't call this are numbered.
+	void SetThreadName(const char* name);
+
+	// Records an event on the calling thread. The name must point to storage which outlives the capture.
+	void AddEvent(const char* name, u64 start_time, u64 end_time);
+
+	// Records an event on the calling thread spanning from its previous mark, for per-frame tracks.
+	void MarkFrame(const char* name);
+
+	// Records the GPU time of a presented frame on a separate track, ending at the current time.
+	void AddGPUFrame(float gpu_time_ms);
+
+	class ScopedEvent
+	{
+	public:
+		__fi ScopedEvent(const char* name)
+			: m_name(IsActive() ? name : nullptr)
+			, m_start(m_name ? GetTime() : 0)
+		{
+		}
+
+		__fi ~ScopedEvent()
+		{
+			if (m_name)
+				AddEvent(m_name, m_start, GetTime());
+		}
+
+		ScopedEvent(const ScopedEvent&) = delete;
+		ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+	private:
+		static u64 GetTime();
+
+		const char* m_name;
+		u64 m_start;
+	};
+} // namespace TraceCapture
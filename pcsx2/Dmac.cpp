@@ -176,6 +176,28 @@ __ri tDMA_TAG *dmaGetAddr(u32 addr, bool write)
 }
 
 
+// GIF and VIF1 transfers are split up so other channels, the VUs and the EE see them progress
+// in roughly the right order. When none of those are active, the split only costs events.
+bool dmacCanBatchTransfer(EE_EventType channel)
+{
+	if (CHECK_DMASLICEHACK)
+		return false;
+
+	// Other channels, VU finish and MTVU events would see the transfer complete early.
+	if (cpuRegs.interrupt & ~(1u << channel))
+		return false;
+
+	if (dmacRegs.ctrl.MFD != NO_MFD || dmacRegs.ctrl.STS != NO_STS || dmacRegs.ctrl.STD != NO_STD)
+		return false;
+
+	// A running VU1 could be kicked by the transfer earlier than it expects.
+	if (VU0.VI[REG_VPU_STAT].UL & 0x100)
+		return false;
+
+	// SIGNAL and FINISH in the data would raise their interrupts early.
+	return GSIMR.SIGMSK && GSIMR.FINISHMSK;
+}
+
 // Returns true if the DMA is enabled and executed successfully.  Returns false if execution
 // was blocked (DMAE or master DMA enabler).
 static bool QuickDmaExec( void (*func)(), u32 mem)
@@ -360,6 +382,10 @@ __fi bool dmacWrite32( u32 mem, mem32_t& value )
 		allow_write:;
 	}
 
+	// The threaded IPU reads the IPU DMA channels while it runs.
+	if (mem >= D3_CHCR && mem < D5_CHCR)
+		ipuThreadSync();
+
 	switch(mem) {
 
 		case (D0_QWC): // dma0 - vif0
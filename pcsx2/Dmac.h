@@ -565,6 +565,7 @@ extern void hwMFIFOResume(u32 transferred);
 extern void hwDmacSrcTadrInc(DMACh& dma);
 extern bool hwDmacSrcChainWithStack(DMACh& dma, int id);
 extern bool hwDmacSrcChain(DMACh& dma, int id);
+extern bool dmacCanBatchTransfer(EE_EventType channel);
 
 template< uint page > u32 dmacRead32( u32 mem );
 template< uint page > extern bool dmacWrite32( u32 mem, mem32_t& value );
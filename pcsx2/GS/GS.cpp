@@ -161,7 +161,10 @@ static bool OpenGSDevice(GSRendererType renderer, bool clear_state_on_fail, bool
 		return false;
 	}
 
-	GSConfig.OsdShowGPU = GSConfig.OsdShowGPU && g_gs_device->SetGPUTimingEnabled(true);
+	// Dynamic resolution needs the GPU usage, even when it isn't being displayed.
+	const bool gpu_timing = (GSConfig.OsdShowGPU || GSConfig.DynamicResolution) && g_gs_device->SetGPUTimingEnabled(true);
+	GSConfig.OsdShowGPU = GSConfig.OsdShowGPU && gpu_timing;
+	GSConfig.OsdShowGPUBreakdown = GSConfig.OsdShowGPUBreakdown && g_gs_device->SetGPUTimingBreakdownEnabled(true);
 
 	Console.WriteLn(Color_StrongGreen, "%s Graphics Driver Info:", GSDevice::RenderAPIToString(new_api));
 	Console.WriteLn(g_gs_device->GetDriverInfo());
@@ -413,6 +416,12 @@ void GSReadLocalMemoryUnsync(u8* mem, u32 qwc, u64 BITBLITBUF, u64 TRXPOS, u64 T
 	g_gs_renderer->ReadLocalMemoryUnsync(mem, qwc, GIFRegBITBLTBUF{BITBLITBUF}, GIFRegTRXPOS{TRXPOS}, GIFRegTRXREG{TRXREG});
 }
 
+u64 GSHashLocalMemory()
+{
+	// Hardware renderers only write back to local memory when the game reads it.
+	return MultiISAFunctions::GSXXH3_64_Long(g_gs_renderer->m_mem.vm8(), GSLocalMemory::m_vmsize);
+}
+
 void GSgifTransfer(const u8* mem, u32 size)
 {
 	g_gs_renderer->Transfer<3>(mem, size);
@@ -476,6 +485,25 @@ int GSfreeze(FreezeAction mode, freezeData* data)
 	}
 }
 
+void GSSaveTextureCacheTargets(std::vector<u8>* data)
+{
+	if (!g_texture_cache)
+	{
+		data->clear();
+		return;
+	}
+
+	g_texture_cache->SaveTargetLayout(data);
+}
+
+void GSRestoreTextureCacheTargets(std::span<const u8> data)
+{
+	if (!g_texture_cache || data.empty())
+		return;
+
+	g_texture_cache->RestoreTargetLayout(data);
+}
+
 void GSQueueSnapshot(const std::string& path, u32 gsdump_frames)
 {
 	if (g_gs_renderer)
@@ -488,6 +516,12 @@ void GSStopGSDump()
 		g_gs_renderer->StopGSDump();
 }
 
+void GSSaveGSDumpReplayBuffer()
+{
+	if (g_gs_renderer)
+		g_gs_renderer->SaveGSDumpReplayBuffer();
+}
+
 bool GSBeginCapture(std::string filename)
 {
 	if (g_gs_renderer)
@@ -518,11 +552,22 @@ void GSThrottlePresentation()
 	g_gs_device->ThrottlePresentation();
 }
 
+bool GSRunIdleWork()
+{
+	return g_gs_renderer && g_gs_renderer->RunIdleWork();
+}
+
 void GSGameChanged()
 {
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
 
+	if (g_gs_device)
+		g_gs_device->ReloadPipelineUsageList();
+
+	if (g_gs_renderer)
+		g_gs_renderer->GameChanged();
+
 	if (!VMManager::HasValidVM() && GSCapture::IsCapturing())
 		GSCapture::EndCapture();
 }
@@ -682,14 +727,15 @@ void GSgetStats(SmallStringBase& info)
 			prefix = '\0';
 		}
 
-		info.format("{} SW | {} SP | {} P | {} D | {:.2f} S | {:.2f} U | {:.2f} {}pps",
+		info.format("{} SW | {} SP | {} P | {} D | {:.2f} S | {:.2f} U | {:.2f} {}pps | {} HO",
 			api_name,
 			(int)pm.Get(GSPerfMon::SyncPoint),
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
 			pm.Get(GSPerfMon::Swizzle) / 1024,
 			pm.Get(GSPerfMon::Unswizzle) / 1024,
-			pps, prefix);
+			pps, prefix,
+			(int)std::ceil(pm.Get(GSPerfMon::RingHeapOrphans)));
 	}
 	else if (GSCurrentRenderer == GSRendererType::Null)
 	{
@@ -697,16 +743,20 @@ void GSgetStats(SmallStringBase& info)
 	}
 	else
 	{
-		info.format("{} HW | {} P | {} D | {} DC | {} B | {} RP | {} RB | {} TC | {} TU",
+		info.format("{} HW | {} P | {} D | {} MD | {} DC | {} B | {} RP | {} RB | {} TC | {} TU | {} TA | {} SD | {} SS",
 			api_name,
 			(int)pm.Get(GSPerfMon::Prim),
 			(int)pm.Get(GSPerfMon::Draw),
+			(int)std::ceil(pm.Get(GSPerfMon::MergedDraws)),
 			(int)std::ceil(pm.Get(GSPerfMon::DrawCalls)),
 			(int)std::ceil(pm.Get(GSPerfMon::Barriers)),
 			(int)std::ceil(pm.Get(GSPerfMon::RenderPasses)),
 			(int)std::ceil(pm.Get(GSPerfMon::Readbacks)),
 			(int)std::ceil(pm.Get(GSPerfMon::TextureCopies)),
-			(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)));
+			(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)),
+			(int)std::ceil(pm.Get(GSPerfMon::TextureCreates)),
+			(int)std::ceil(pm.Get(GSPerfMon::ShuffleDraws)),
+			(int)std::ceil(pm.Get(GSPerfMon::ShuffleDrawsSkipped)));
 	}
 }
 
@@ -740,6 +790,16 @@ void GSgetMemoryStats(SmallStringBase& info)
 	}
 }
 
+void GSgetCacheStats(SmallStringBase& info)
+{
+	if (!g_texture_cache)
+		return;
+
+	const GSTextureCache::CacheStats stats = g_texture_cache->GetCacheStats();
+	fmt::format_to(std::back_inserter(info), "TC: {} Offsets | {} Palettes | {} Hashes | Lists: {} KB | {} Compactions",
+		stats.surface_offsets, stats.palettes, stats.hash_cache_entries, stats.list_memory / 1024, stats.compactions);
+}
+
 void GSgetTitleStats(std::string& info)
 {
 	static constexpr const char* deinterlace_modes[] = {
@@ -804,6 +864,7 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 		GSConfig.TexturePreloading != old_config.TexturePreloading ||
 		GSConfig.TriFilter != old_config.TriFilter ||
 		GSConfig.GPUPaletteConversion != old_config.GPUPaletteConversion ||
+		GSConfig.GPUTextureUnswizzle != old_config.GPUTextureUnswizzle ||
 		GSConfig.PreloadFrameWithGSData != old_config.PreloadFrameWithGSData ||
 		GSConfig.UserHacks_CPUFBConversion != old_config.UserHacks_CPUFBConversion ||
 		GSConfig.UserHacks_DisableDepthSupport != old_config.UserHacks_DisableDepthSupport ||
@@ -836,11 +897,18 @@ void GSUpdateConfig(const Pcsx2Config::GSOptions& new_config)
 		g_gs_renderer->PurgeTextureCache(true, false, true);
 	}
 
-	if (GSConfig.OsdShowGPU != old_config.OsdShowGPU)
+	const bool gpu_timing = (GSConfig.OsdShowGPU || GSConfig.DynamicResolution);
+	if (gpu_timing != (old_config.OsdShowGPU || old_config.DynamicResolution))
 	{
-		if (!g_gs_device->SetGPUTimingEnabled(GSConfig.OsdShowGPU))
+		if (!g_gs_device->SetGPUTimingEnabled(gpu_timing))
 			GSConfig.OsdShowGPU = false;
 	}
+
+	if (GSConfig.OsdShowGPUBreakdown != old_config.OsdShowGPUBreakdown)
+	{
+		if (!g_gs_device->SetGPUTimingBreakdownEnabled(GSConfig.OsdShowGPUBreakdown))
+			GSConfig.OsdShowGPUBreakdown = false;
+	}
 }
 
 void GSSetSoftwareRendering(bool software_renderer, GSInterlaceMode new_interlace)
@@ -1136,6 +1204,13 @@ BEGIN_HOTKEY_LIST(g_gs_hotkeys){"Screenshot", TRANSLATE_NOOP("Hotkeys", "Graphic
 					GSStopGSDump();
 			});
 		}},
+	{"GSDumpReplayBuffer", TRANSLATE_NOOP("Hotkeys", "Graphics"), TRANSLATE_NOOP("Hotkeys", "Save GS Dump Replay Buffer"),
+		[](s32 pressed) {
+			if (!pressed)
+			{
+				MTGS::RunOnGSThread([]() { GSSaveGSDumpReplayBuffer(); });
+			}
+		}},
 	{"ToggleSoftwareRendering", TRANSLATE_NOOP("Hotkeys", "Graphics"),
 		TRANSLATE_NOOP("Hotkeys", "Toggle Software Rendering"),
 		[](s32 pressed) {
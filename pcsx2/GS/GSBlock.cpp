@@ -22,3 +22,47 @@ constinit const GSVector4i GSBlock::m_uw8hmask0(0, 0, 0, 0, 1, 1, 1, 1, 8, 8, 8,
 constinit const GSVector4i GSBlock::m_uw8hmask1(2, 2, 2, 2, 3, 3, 3, 3, 10, 10, 10, 10, 11, 11, 11, 11);
 constinit const GSVector4i GSBlock::m_uw8hmask2(4, 4, 4, 4, 5, 5, 5, 5, 12, 12, 12, 12, 13, 13, 13, 13);
 constinit const GSVector4i GSBlock::m_uw8hmask3(6, 6, 6, 6, 7, 7, 7, 7, 14, 14, 14, 14, 15, 15, 15, 15);
+
+#if _M_SSE >= 0x601
+
+alignas(64) constinit const u32 GSBlock::m_avx512_r32idx[16] = {0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15};
+alignas(64) constinit const u32 GSBlock::m_avx512_w32idx[16] = {0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15};
+
+alignas(64) constinit const u16 GSBlock::m_avx512_r16idx[32] = {
+	0, 2, 8, 10, 16, 18, 24, 26, 1, 3, 9, 11, 17, 19, 25, 27, 4, 6, 12, 14, 20, 22, 28, 30, 5, 7, 13, 15, 21, 23, 29, 31};
+alignas(64) constinit const u16 GSBlock::m_avx512_w16idx[32] = {
+	0, 8, 1, 9, 16, 24, 17, 25, 2, 10, 3, 11, 18, 26, 19, 27, 4, 12, 5, 13, 20, 28, 21, 29, 6, 14, 7, 15, 22, 30, 23, 31};
+
+alignas(64) constinit const u16 GSBlock::m_avx512_r8idx[2][32] = {
+	{0, 8, 16, 24, 1, 9, 17, 25, 2, 10, 18, 26, 3, 11, 19, 27, 20, 28, 4, 12, 21, 29, 5, 13, 22, 30, 6, 14, 23, 31, 7, 15},
+	{16, 24, 0, 8, 17, 25, 1, 9, 18, 26, 2, 10, 19, 27, 3, 11, 4, 12, 20, 28, 5, 13, 21, 29, 6, 14, 22, 30, 7, 15, 23, 31},
+};
+alignas(64) constinit const u16 GSBlock::m_avx512_w8idx[2][32] = {
+	{0, 18, 4, 22, 8, 26, 12, 30, 1, 19, 5, 23, 9, 27, 13, 31, 2, 16, 6, 20, 10, 24, 14, 28, 3, 17, 7, 21, 11, 25, 15, 29},
+	{2, 16, 6, 20, 10, 24, 14, 28, 3, 17, 7, 21, 11, 25, 15, 29, 0, 18, 4, 22, 8, 26, 12, 30, 1, 19, 5, 23, 9, 27, 13, 31},
+};
+
+alignas(64) constinit const u16 GSBlock::m_avx512_r4idx[2][2][32] = {
+	{
+		{0, 8, 16, 24, 1, 9, 17, 25, 4, 12, 20, 28, 5, 13, 21, 29, 16, 24, 0, 8, 17, 25, 1, 9, 20, 28, 4, 12, 21, 29, 5, 13},
+		{2, 10, 18, 26, 3, 11, 19, 27, 6, 14, 22, 30, 7, 15, 23, 31, 18, 26, 2, 10, 19, 27, 3, 11, 22, 30, 6, 14, 23, 31, 7, 15},
+	},
+	{
+		{16, 24, 0, 8, 17, 25, 1, 9, 20, 28, 4, 12, 21, 29, 5, 13, 0, 8, 16, 24, 1, 9, 17, 25, 4, 12, 20, 28, 5, 13, 21, 29},
+		{18, 26, 2, 10, 19, 27, 3, 11, 22, 30, 6, 14, 23, 31, 7, 15, 2, 10, 18, 26, 3, 11, 19, 27, 6, 14, 22, 30, 7, 15, 23, 31},
+	},
+};
+alignas(64) constinit const u16 GSBlock::m_avx512_w4idx[2][32] = {
+	{0, 1, 0, 1, 8, 9, 8, 9, 2, 3, 2, 3, 10, 11, 10, 11, 4, 5, 4, 5, 12, 13, 12, 13, 6, 7, 6, 7, 14, 15, 14, 15},
+	{16, 17, 16, 17, 24, 25, 24, 25, 18, 19, 18, 19, 26, 27, 26, 27, 20, 21, 20, 21, 28, 29, 28, 29, 22, 23, 22, 23, 30, 31, 30, 31},
+};
+alignas(64) constinit const u8 GSBlock::m_avx512_w4mask[2][64] = {
+	{0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+		2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13},
+	{2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13,
+		0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15, 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15},
+};
+
+constinit const GSVector4i GSBlock::m_avx512_r4w8mask(0, 2, 4, 6, 1, 3, 5, 7, 8, 10, 12, 14, 9, 11, 13, 15);
+
+#endif
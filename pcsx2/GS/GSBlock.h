@@ -30,6 +30,21 @@ class GSBlock
 	static const GSVector4i m_uw8hmask2;
 	static const GSVector4i m_uw8hmask3;
 
+#if _M_SSE >= 0x601
+	// A whole column is 64 bytes, so it fits in one zmm and can be (un)swizzled with cross-lane word/dword permutes
+	// 8/4-bit tables are indexed by column parity, 4-bit read tables by low/high nibble as well
+	alignas(64) static const u32 m_avx512_r32idx[16];
+	alignas(64) static const u32 m_avx512_w32idx[16];
+	alignas(64) static const u16 m_avx512_r16idx[32];
+	alignas(64) static const u16 m_avx512_w16idx[32];
+	alignas(64) static const u16 m_avx512_r8idx[2][32];
+	alignas(64) static const u16 m_avx512_w8idx[2][32];
+	alignas(64) static const u16 m_avx512_r4idx[2][2][32];
+	alignas(64) static const u16 m_avx512_w4idx[2][32];
+	alignas(64) static const u8 m_avx512_w4mask[2][64];
+	static const GSVector4i m_avx512_r4w8mask;
+#endif
+
 #if _M_SSE >= 0x501
 	// Equvialent of `a = *s0; b = *s1; sw128(a, b);`
 	// Loads in two halves instead to reduce shuffle instructions
@@ -51,7 +66,20 @@ public:
 		const u8* RESTRICT s0 = &src[srcpitch * 0];
 		const u8* RESTRICT s1 = &src[srcpitch * 1];
 
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		__m512i v = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((const __m256i*)s0)), _mm256_loadu_si256((const __m256i*)s1), 1);
+
+		v = _mm512_permutexvar_epi32(_mm512_load_si512(m_avx512_w32idx), v);
+
+		__m512i* d = reinterpret_cast<__m512i*>(dst) + i;
+
+		if (mask == 0xffffffff)
+			_mm512_store_si512(d, v);
+		else if (mask != 0)
+			_mm512_store_si512(d, _mm512_ternarylogic_epi32(_mm512_set1_epi32(static_cast<int>(mask)), v, _mm512_load_si512(d), 0xca));
+
+#elif _M_SSE >= 0x501
 
 		GSVector8i v0 = GSVector8i::load<false>(s0).acbd();
 		GSVector8i v1 = GSVector8i::load<false>(s1).acbd();
@@ -115,7 +143,13 @@ public:
 
 		// for(int j = 0; j < 16; j++) {((u16*)s0)[j] = columnTable16[0][j]; ((u16*)s1)[j] = columnTable16[1][j];}
 
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		__m512i v = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((const __m256i*)s0)), _mm256_loadu_si256((const __m256i*)s1), 1);
+
+		_mm512_store_si512(reinterpret_cast<__m512i*>(dst) + i, _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_w16idx), v));
+
+#elif _M_SSE >= 0x501
 
 		GSVector8i v0, v1;
 
@@ -179,7 +213,20 @@ public:
 	{
 		// TODO: read unaligned as WriteColumn32 does and try saving a few shuffles
 
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		__m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)&src[srcpitch * 0]));
+
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)&src[srcpitch * 1]), 1);
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)&src[srcpitch * 2]), 2);
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)&src[srcpitch * 3]), 3);
+
+		v = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_w8idx[i & 1]), v);
+		v = _mm512_shuffle_epi8(v, _mm512_broadcast_i32x4(m_avx512_r4w8mask.m));
+
+		_mm512_store_si512(reinterpret_cast<__m512i*>(dst) + i, v);
+
+#elif _M_SSE >= 0x501
 
 		GSVector4i v4 = GSVector4i::load<false>(&src[srcpitch * 0]);
 		GSVector4i v5 = GSVector4i::load<false>(&src[srcpitch * 1]);
@@ -242,7 +289,27 @@ public:
 
 		// TODO: pshufb
 
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		__m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)&src[srcpitch * 0]));
+
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)&src[srcpitch * 1]), 1);
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)&src[srcpitch * 2]), 2);
+		v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)&src[srcpitch * 3]), 3);
+
+		v = _mm512_shuffle_epi8(v, _mm512_load_si512(m_avx512_w4mask[i & 1]));
+
+		// Gather the source bytes of the low and high nibbles separately, then line the nibbles up and merge them
+
+		__m512i lo = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_w4idx[0]), v);
+		__m512i hi = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_w4idx[1]), v);
+
+		lo = _mm512_mask_srli_epi16(lo, 0xcccccccc, lo, 4);
+		hi = _mm512_mask_slli_epi16(hi, 0x33333333, hi, 4);
+
+		_mm512_store_si512(reinterpret_cast<__m512i*>(dst) + i, _mm512_ternarylogic_epi32(_mm512_set1_epi8(0x0f), lo, hi, 0xca));
+
+#elif _M_SSE >= 0x501
 
 		GSVector8i v0 = GSVector8i(GSVector4i::load<false>(&src[srcpitch * 0]), GSVector4i::load<false>(&src[srcpitch * 1]));
 		GSVector8i v1 = GSVector8i(GSVector4i::load<false>(&src[srcpitch * 2]), GSVector4i::load<false>(&src[srcpitch * 3]));
@@ -401,7 +468,14 @@ public:
 	template <int i>
 	__forceinline static void ReadColumn32(const u8* RESTRICT src, u8* RESTRICT dst, int dstpitch)
 	{
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		const __m512i v = _mm512_permutexvar_epi32(_mm512_load_si512(m_avx512_r32idx), _mm512_load_si512(reinterpret_cast<const __m512i*>(src) + i));
+
+		_mm256_store_si256((__m256i*)&dst[dstpitch * 0], _mm512_castsi512_si256(v));
+		_mm256_store_si256((__m256i*)&dst[dstpitch * 1], _mm512_extracti64x4_epi64(v, 1));
+
+#elif _M_SSE >= 0x501
 
 		const GSVector8i* s = (const GSVector8i*)src;
 
@@ -438,7 +512,14 @@ public:
 	template <int i>
 	__forceinline static void ReadColumn16(const u8* RESTRICT src, u8* RESTRICT dst, int dstpitch)
 	{
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		const __m512i v = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_r16idx), _mm512_load_si512(reinterpret_cast<const __m512i*>(src) + i));
+
+		_mm256_store_si256((__m256i*)&dst[dstpitch * 0], _mm512_castsi512_si256(v));
+		_mm256_store_si256((__m256i*)&dst[dstpitch * 1], _mm512_extracti64x4_epi64(v, 1));
+
+#elif _M_SSE >= 0x501
 
 		const GSVector8i* s = (const GSVector8i*)src;
 
@@ -480,7 +561,19 @@ public:
 
 		//for(int j = 0; j < 64; j++) ((u8*)src)[j] = (u8)j;
 
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		__m512i v = _mm512_load_si512(reinterpret_cast<const __m512i*>(src) + i);
+
+		v = _mm512_shuffle_epi8(v, _mm512_broadcast_i32x4(m_r8mask.m));
+		v = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_r8idx[i & 1]), v);
+
+		_mm_store_si128((__m128i*)&dst[dstpitch * 0], _mm512_castsi512_si128(v));
+		_mm_store_si128((__m128i*)&dst[dstpitch * 1], _mm512_extracti32x4_epi32(v, 1));
+		_mm_store_si128((__m128i*)&dst[dstpitch * 2], _mm512_extracti32x4_epi32(v, 2));
+		_mm_store_si128((__m128i*)&dst[dstpitch * 3], _mm512_extracti32x4_epi32(v, 3));
+
+#elif _M_SSE >= 0x501
 
 		const GSVector8i* s = (const GSVector8i*)src;
 
@@ -550,7 +643,26 @@ public:
 	{
 		//printf("ReadColumn4\n");
 
-#if _M_SSE >= 0x501
+#if _M_SSE >= 0x601
+
+		const __m512i v = _mm512_load_si512(reinterpret_cast<const __m512i*>(src) + i);
+
+		// Gather the source bytes of the low and high nibbles separately, then line the nibbles up and merge them
+
+		__m512i lo = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_r4idx[i & 1][0]), v);
+		__m512i hi = _mm512_permutexvar_epi16(_mm512_load_si512(m_avx512_r4idx[i & 1][1]), v);
+
+		lo = _mm512_mask_srli_epi16(lo, 0xffff0000, lo, 4);
+		hi = _mm512_mask_slli_epi16(hi, 0x0000ffff, hi, 4);
+
+		const __m512i r = _mm512_shuffle_epi8(_mm512_ternarylogic_epi32(_mm512_set1_epi8(0x0f), lo, hi, 0xca), _mm512_broadcast_i32x4(m_avx512_r4w8mask.m));
+
+		_mm_store_si128((__m128i*)&dst[dstpitch * 0], _mm512_castsi512_si128(r));
+		_mm_store_si128((__m128i*)&dst[dstpitch * 1], _mm512_extracti32x4_epi32(r, 1));
+		_mm_store_si128((__m128i*)&dst[dstpitch * 2], _mm512_extracti32x4_epi32(r, 2));
+		_mm_store_si128((__m128i*)&dst[dstpitch * 3], _mm512_extracti32x4_epi32(r, 3));
+
+#elif _M_SSE >= 0x501
 
 		const GSVector8i* s = (const GSVector8i*)src;
 
@@ -5,6 +5,7 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 #include "GS/GSExtra.h"
+#include "DebugTools/TraceCapture.h"
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GS/Renderers/Common/GSTexture.h"
 #include "SPU2/spu2.h"
@@ -159,12 +160,15 @@ namespace GSCapture
 	static void UnloadFFmpeg();
 	static std::string GetCaptureTypeForMessage(bool capture_video, bool capture_audio);
 	static bool IsUsingHardwareVideoEncoding();
+	static bool CodecSupportsPixelFormat(const AVCodec* codec, AVPixelFormat format);
+	static bool CreateHardwareFramesContext(AVPixelFormat hw_pix_fmt, AVPixelFormat sw_pix_fmt, bool report_errors);
 	static void ProcessFramePendingMap(std::unique_lock<std::mutex>& lock);
 	static void ProcessAllInFlightFrames(std::unique_lock<std::mutex>& lock);
 	static void EncoderThreadEntryPoint();
 	static void StartEncoderThread();
 	static void StopEncoderThread(std::unique_lock<std::mutex>& lock);
 	static bool SendFrame(const PendingFrame& pf);
+	static bool SendVideoFrame(AVFrame* frame, s64 pts);
 	static bool ReceivePackets(AVCodecContext* codec_context, AVStream* stream, AVPacket* packet);
 	static bool ProcessAudioPackets(s64 video_pts);
 	static void InternalEndCapture(std::unique_lock<std::mutex>& lock);
@@ -182,6 +186,7 @@ namespace GSCapture
 	static AVStream* s_video_stream = nullptr;
 	static AVFrame* s_converted_video_frame = nullptr; // YUV
 	static AVFrame* s_hw_video_frame = nullptr;
+	static AVFrame* s_direct_video_frame = nullptr; // RGB readback, uploaded without conversion
 	static AVPacket* s_video_packet = nullptr;
 	static SwsContext* s_sws_context = nullptr;
 	static AVDictionary* s_video_codec_arguments = nullptr;
@@ -371,6 +376,49 @@ bool GSCapture::IsUsingHardwareVideoEncoding()
 	return (s_video_hw_context != nullptr);
 }
 
+bool GSCapture::CodecSupportsPixelFormat(const AVCodec* codec, AVPixelFormat format)
+{
+	if (!codec->pix_fmts)
+		return false;
+
+	for (u32 i = 0; codec->pix_fmts[i] != AV_PIX_FMT_NONE; i++)
+	{
+		if (codec->pix_fmts[i] == format)
+			return true;
+	}
+
+	return false;
+}
+
+bool GSCapture::CreateHardwareFramesContext(AVPixelFormat hw_pix_fmt, AVPixelFormat sw_pix_fmt, bool report_errors)
+{
+	s_video_hw_frames = wrap_av_hwframe_ctx_alloc(s_video_hw_context);
+	if (!s_video_hw_frames)
+	{
+		Console.Error("s_video_hw_frames() failed");
+		return false;
+	}
+
+	AVHWFramesContext* frames_ctx = reinterpret_cast<AVHWFramesContext*>(s_video_hw_frames->data);
+	frames_ctx->format = (hw_pix_fmt != AV_PIX_FMT_NONE) ? hw_pix_fmt : sw_pix_fmt;
+	frames_ctx->sw_format = sw_pix_fmt;
+	frames_ctx->width = s_video_codec_context->width;
+	frames_ctx->height = s_video_codec_context->height;
+	const int res = wrap_av_hwframe_ctx_init(s_video_hw_frames);
+	if (res < 0)
+	{
+		if (report_errors)
+			LogAVError(res, "av_hwframe_ctx_init() failed: ");
+		else
+			DevCon.WriteLn("GSCapture: av_hwframe_ctx_init() failed for pixel format %d", sw_pix_fmt);
+
+		wrap_av_buffer_unref(&s_video_hw_frames);
+		return false;
+	}
+
+	return true;
+}
+
 bool GSCapture::BeginCapture(float fps, GSVector2i recommendedResolution, float aspect, std::string filename)
 {
 	const bool capture_video = GSConfig.EnableVideoCapture;
@@ -502,32 +550,25 @@ bool GSCapture::BeginCapture(float fps, GSVector2i recommendedResolution, float
 			}
 			else
 			{
-				s_video_hw_frames = wrap_av_hwframe_ctx_alloc(s_video_hw_context);
-				if (!s_video_hw_frames)
+				// If the encoder takes RGB surfaces, upload the readback as-is and let the GPU do the colour conversion.
+				// Converting to YUV with swscale is the most expensive part of capturing at high resolutions.
+				const bool try_rgb_upload = (GSConfig.VideoCaptureFormat.empty() && hwconfig->pix_fmt != AV_PIX_FMT_NONE &&
+											 sw_pix_fmt != AV_PIX_FMT_RGB0 && CodecSupportsPixelFormat(vcodec, AV_PIX_FMT_RGB0));
+				if (try_rgb_upload && CreateHardwareFramesContext(hwconfig->pix_fmt, AV_PIX_FMT_RGB0, false))
+				{
+					Console.WriteLn("GSCapture: Uploading RGB frames to the hardware encoder without conversion.");
+					sw_pix_fmt = AV_PIX_FMT_RGB0;
+				}
+
+				if (!s_video_hw_frames && !CreateHardwareFramesContext(hwconfig->pix_fmt, sw_pix_fmt, true))
 				{
-					Console.Error("s_video_hw_frames() failed");
 					wrap_av_buffer_unref(&s_video_hw_context);
 				}
 				else
 				{
-					AVHWFramesContext* frames_ctx = reinterpret_cast<AVHWFramesContext*>(s_video_hw_frames->data);
-					frames_ctx->format = (hwconfig->pix_fmt != AV_PIX_FMT_NONE) ? hwconfig->pix_fmt : sw_pix_fmt;
-					frames_ctx->sw_format = sw_pix_fmt;
-					frames_ctx->width = s_video_codec_context->width;
-					frames_ctx->height = s_video_codec_context->height;
-					res = wrap_av_hwframe_ctx_init(s_video_hw_frames);
-					if (res < 0)
-					{
-						LogAVError(res, "av_hwframe_ctx_init() failed: ");
-						wrap_av_buffer_unref(&s_video_hw_frames);
-						wrap_av_buffer_unref(&s_video_hw_context);
-					}
-					else
-					{
-						s_video_codec_context->hw_frames_ctx = wrap_av_buffer_ref(s_video_hw_frames);
-						if (hwconfig->pix_fmt != AV_PIX_FMT_NONE)
-							s_video_codec_context->pix_fmt = hwconfig->pix_fmt;
-					}
+					s_video_codec_context->hw_frames_ctx = wrap_av_buffer_ref(s_video_hw_frames);
+					if (hwconfig->pix_fmt != AV_PIX_FMT_NONE)
+						s_video_codec_context->pix_fmt = hwconfig->pix_fmt;
 				}
 			}
 
@@ -569,7 +610,9 @@ bool GSCapture::BeginCapture(float fps, GSVector2i recommendedResolution, float
 
 		s_converted_video_frame = wrap_av_frame_alloc();
 		s_hw_video_frame = IsUsingHardwareVideoEncoding() ? wrap_av_frame_alloc() : nullptr;
-		if (!s_converted_video_frame || (IsUsingHardwareVideoEncoding() && !s_hw_video_frame))
+		s_direct_video_frame = (IsUsingHardwareVideoEncoding() && sw_pix_fmt == AV_PIX_FMT_RGB0) ? wrap_av_frame_alloc() : nullptr;
+		if (!s_converted_video_frame || (IsUsingHardwareVideoEncoding() && !s_hw_video_frame) ||
+			(sw_pix_fmt == AV_PIX_FMT_RGB0 && IsUsingHardwareVideoEncoding() && !s_direct_video_frame))
 		{
 			LogAVError(AVERROR(ENOMEM), "Failed to allocate frame: ");
 			InternalEndCapture(lock);
@@ -927,6 +970,7 @@ void GSCapture::ProcessFramePendingMap(std::unique_lock<std::mutex>& lock)
 void GSCapture::EncoderThreadEntryPoint()
 {
 	Threading::SetNameOfCurrentThread("GS Capture Encoding");
+	TraceCapture::SetThreadName("GS Capture Encoding");
 
 	std::unique_lock<std::mutex> lock(s_lock);
 
@@ -945,7 +989,10 @@ void GSCapture::EncoderThreadEntryPoint()
 
 		// If the frame failed to map, this will be false, and we'll just skip it.
 		if (okay && s_video_stream && pf.tex->IsMapped())
+		{
+			TraceCapture::ScopedEvent trace("Encode Frame");
 			okay = SendFrame(pf);
+		}
 
 		// Encode as many audio frames while the video is ahead.
 		if (okay && s_audio_stream)
@@ -997,6 +1044,25 @@ bool GSCapture::SendFrame(const PendingFrame& pf)
 	const int source_height = static_cast<int>(pf.tex->GetHeight());
 	const int source_pitch = static_cast<int>(pf.tex->GetMapPitch());
 
+	if (s_direct_video_frame && source_width == s_converted_video_frame->width && source_height == s_converted_video_frame->height)
+	{
+		// The readback is already in the upload format, so it can go straight to the GPU.
+		s_direct_video_frame->format = AV_PIX_FMT_RGB0;
+		s_direct_video_frame->width = source_width;
+		s_direct_video_frame->height = source_height;
+		s_direct_video_frame->data[0] = const_cast<u8*>(source_ptr);
+		s_direct_video_frame->linesize[0] = source_pitch;
+
+		const int res = wrap_av_hwframe_transfer_data(s_hw_video_frame, s_direct_video_frame, 0);
+		if (res < 0)
+		{
+			LogAVError(res, "av_hwframe_transfer_data() failed: ");
+			return false;
+		}
+
+		return SendVideoFrame(s_hw_video_frame, pf.pts);
+	}
+
 	// In case a previous frame is still using the frame.
 	wrap_av_frame_make_writable(s_converted_video_frame);
 
@@ -1025,10 +1091,15 @@ bool GSCapture::SendFrame(const PendingFrame& pf)
 		frame_to_send = s_hw_video_frame;
 	}
 
+	return SendVideoFrame(frame_to_send, pf.pts);
+}
+
+bool GSCapture::SendVideoFrame(AVFrame* frame, s64 pts)
+{
 	// Set the correct PTS before handing it off.
-	frame_to_send->pts = pf.pts;
+	frame->pts = pts;
 
-	const int res = wrap_avcodec_send_frame(s_video_codec_context, frame_to_send);
+	const int res = wrap_avcodec_send_frame(s_video_codec_context, frame);
 	if (res < 0)
 	{
 		LogAVError(res, "avcodec_send_frame() failed: ");
@@ -1320,6 +1391,8 @@ void GSCapture::InternalEndCapture(std::unique_lock<std::mutex>& lock)
 		wrap_av_frame_free(&s_converted_video_frame);
 	if (s_hw_video_frame)
 		wrap_av_frame_free(&s_hw_video_frame);
+	if (s_direct_video_frame)
+		wrap_av_frame_free(&s_direct_video_frame);
 	if (s_video_hw_frames)
 		wrap_av_buffer_unref(&s_video_hw_frames);
 	if (s_video_hw_context)
@@ -6,6 +6,7 @@
 #include "GS/GSLocalMemory.h"
 #include "GS/GSGL.h"
 #include "GS/GSUtil.h"
+#include "GS/GSXXH.h"
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "common/AlignedMalloc.h"
@@ -22,6 +23,7 @@ GSClut::GSClut(GSLocalMemory* mem)
 	m_buff64 = reinterpret_cast<u64*>(reinterpret_cast<u8*>(m_clut) + 4096); // 2k
 	m_write.dirty = 1;
 	m_read.dirty = true;
+	m_read.cache_index = -1;
 
 	for (int i = 0; i < 16; i++)
 	{
@@ -134,6 +136,7 @@ void GSClut::Reset()
 	m_write.dirty = 1;
 	m_read = {};
 	m_read.dirty = true;
+	m_read.cache_index = -1;
 }
 
 bool GSClut::InvalidateRange(u32 start_block, u32 end_block, bool is_draw)
@@ -217,14 +220,75 @@ bool GSClut::WriteTest(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 
 void GSClut::Write(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 {
+	constexpr u64 mask = 0x1FFFFFE000000000ull; // CSA CSM CPSM CBP
+
+	// A write to the CLUT area dirties the CLUT even if the palette didn't change, when the source
+	// blocks still hold the same data as the previous load with this layout, the CLUT is still valid.
+	const u64 src_hash = HashWriteSource(TEX0);
+	const bool redundant = (src_hash != 0 && src_hash == m_write.src_hash && !((m_write.TEX0.U64 ^ TEX0.U64) & mask) &&
+							GSLocalMemory::m_psm[m_write.TEX0.PSM].pal == GSLocalMemory::m_psm[TEX0.PSM].pal);
+
 	m_write.TEX0 = TEX0;
 	m_write.TEXCLUT = TEXCLUT;
-	m_read.dirty = true;
 	m_write.dirty = 0;
+	m_write.src_hash = src_hash;
+
+	if (redundant)
+		return;
+
+	m_read.dirty = true;
 
 	(this->*m_wc[TEX0.CSM][TEX0.CPSM][TEX0.PSM])(TEX0, TEXCLUT);
 }
 
+u64 GSClut::HashWriteSource(const GIFRegTEX0& TEX0) const
+{
+	// CSM2 palettes are scattered over a buffer, only the CSM1 ones are cheap enough to hash.
+	if (TEX0.CSM != 0)
+		return 0;
+
+	const bool eight_bit = (TEX0.PSM & 0x7) == 0x3;
+	const bool four_bit = (TEX0.PSM & 0x7) == 0x4;
+	if (!eight_bit && !four_bit)
+		return 0;
+
+	switch (TEX0.CPSM)
+	{
+		case PSMCT32:
+		case PSMCT24:
+			return GSXXH3_64bits(m_mem->BlockPtr32(0, 0, TEX0.CBP, 1), eight_bit ? 1024 : 64);
+		case PSMCT16:
+			return GSXXH3_64bits(m_mem->BlockPtr16(0, 0, TEX0.CBP, 1), eight_bit ? 512 : 256);
+		case PSMCT16S:
+			return GSXXH3_64bits(m_mem->BlockPtr16S(0, 0, TEX0.CBP, 1), eight_bit ? 512 : 256);
+		default:
+			return 0;
+	}
+}
+
+u64 GSClut::HashReadSource(const GIFRegTEX0& TEX0) const
+{
+	const GSVector4i* clut = reinterpret_cast<const GSVector4i*>(m_clut);
+	const bool four_bit = (GSLocalMemory::m_psm[TEX0.PSM].pal == 16);
+
+	if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+	{
+		// The low and high halves are 512 bytes apart.
+		if (!four_bit)
+			return GSXXH3_64bits(m_clut, 1024);
+
+		clut += (TEX0.CSA & 15) << 1;
+		const GSVector4i src[4] = {clut[0], clut[1], clut[32], clut[33]};
+		return GSXXH3_64bits(src, sizeof(src));
+	}
+	else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+	{
+		return GSXXH3_64bits(m_clut + (TEX0.CSA << 4), four_bit ? 32 : 512);
+	}
+
+	return 0;
+}
+
 void GSClut::WriteCLUT32_I8_CSM1(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 {
 	ALIGN_STACK(32);
@@ -360,6 +424,49 @@ void GSClut::Read(const GIFRegTEX0& TEX0)
 }
 #endif
 
+void GSClut::ReadCLUT(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+{
+	u16* clut = m_clut;
+
+	if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+	{
+		switch (TEX0.PSM)
+		{
+			case PSMT8:
+			case PSMT8H:
+				ReadCLUT_T32_I8(clut, m_buff32, (TEX0.CSA & 15) << 4);
+				break;
+			case PSMT4:
+			case PSMT4HL:
+			case PSMT4HH:
+				clut += (TEX0.CSA & 15) << 4;
+				// TODO: merge these functions
+				ReadCLUT_T32_I4(clut, m_buff32);
+				ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+				break;
+		}
+	}
+	else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+	{
+		switch (TEX0.PSM)
+		{
+			case PSMT8:
+			case PSMT8H:
+				clut += TEX0.CSA << 4;
+				Expand16(clut, m_buff32, 256, TEXA);
+				break;
+			case PSMT4:
+			case PSMT4HL:
+			case PSMT4HH:
+				clut += TEX0.CSA << 4;
+				// TODO: merge these functions
+				Expand16(clut, m_buff32, 16, TEXA);
+				ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+				break;
+		}
+	}
+}
+
 void GSClut::Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 {
 	if (m_read.IsDirty(TEX0, TEXA))
@@ -369,43 +476,57 @@ void GSClut::Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 		m_read.dirty = false;
 		m_read.adirty = true;
 
-		u16* clut = m_clut;
+		const u16 pal = GSLocalMemory::m_psm[TEX0.PSM].pal;
+		const u64 key = (TEXA.U64 & 0xFF000080FFull) | (static_cast<u64>(TEX0.CPSM) << 40) |
+						(static_cast<u64>(pal == 16) << 46) | (static_cast<u64>(TEX0.CSA & 15) << 48);
+		const u64 src_hash = HashReadSource(TEX0);
 
-		if (TEX0.CPSM == PSMCT32 || TEX0.CPSM == PSMCT24)
+		m_read.cache_index = -1;
+		if (src_hash != 0)
 		{
-			switch (TEX0.PSM)
+			for (u32 i = 0; i < READ_CACHE_SIZE; i++)
 			{
-				case PSMT8:
-				case PSMT8H:
-					ReadCLUT_T32_I8(clut, m_buff32, (TEX0.CSA & 15) << 4);
-					break;
-				case PSMT4:
-				case PSMT4HL:
-				case PSMT4HH:
-					clut += (TEX0.CSA & 15) << 4;
-					// TODO: merge these functions
-					ReadCLUT_T32_I4(clut, m_buff32);
-					ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+				const ReadCacheEntry& entry = m_read_cache[i];
+				if (entry.valid && entry.key == key && entry.src_hash == src_hash)
+				{
+					m_read.cache_index = static_cast<s32>(i);
 					break;
+				}
 			}
 		}
-		else if (TEX0.CPSM == PSMCT16 || TEX0.CPSM == PSMCT16S)
+
+		if (m_read.cache_index >= 0)
 		{
-			switch (TEX0.PSM)
+			const ReadCacheEntry& entry = m_read_cache[m_read.cache_index];
+			std::memcpy(m_buff32, entry.buff32, pal * sizeof(u32));
+			if (pal == 16)
+				ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
+
+			m_read.hash = entry.hash;
+			m_read.hash_pal = pal;
+			m_read.adirty = entry.adirty;
+			m_read.amin = entry.amin;
+			m_read.amax = entry.amax;
+		}
+		else
+		{
+			ReadCLUT(TEX0, TEXA);
+
+			m_read.hash = GSXXH3_64bits(m_buff32, pal * sizeof(u32));
+			m_read.hash_pal = pal;
+
+			if (src_hash != 0)
 			{
-				case PSMT8:
-				case PSMT8H:
-					clut += TEX0.CSA << 4;
-					Expand16(clut, m_buff32, 256, TEXA);
-					break;
-				case PSMT4:
-				case PSMT4HL:
-				case PSMT4HH:
-					clut += TEX0.CSA << 4;
-					// TODO: merge these functions
-					Expand16(clut, m_buff32, 16, TEXA);
-					ExpandCLUT64_T32_I8(m_buff32, (u64*)m_buff64); // sw renderer does not need m_buff64 anymore
-					break;
+				m_read.cache_index = static_cast<s32>(m_read_cache_next);
+				m_read_cache_next = (m_read_cache_next + 1) % READ_CACHE_SIZE;
+
+				ReadCacheEntry& entry = m_read_cache[m_read.cache_index];
+				std::memcpy(entry.buff32, m_buff32, pal * sizeof(u32));
+				entry.key = key;
+				entry.src_hash = src_hash;
+				entry.hash = m_read.hash;
+				entry.adirty = true;
+				entry.valid = true;
 			}
 		}
 
@@ -520,6 +641,14 @@ void GSClut::GetAlphaMinMax32(int& amin_out, int& amax_out)
 			m_read.amin = v0.min_i16(v1).extract16<0>();
 			m_read.amax = v0.max_i16(v1).extract16<1>();
 		}
+
+		if (m_read.cache_index >= 0)
+		{
+			ReadCacheEntry& entry = m_read_cache[m_read.cache_index];
+			entry.amin = m_read.amin;
+			entry.amax = m_read.amax;
+			entry.adirty = false;
+		}
 	}
 
 	amin_out = m_read.amin;
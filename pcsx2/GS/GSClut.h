@@ -8,12 +8,15 @@
 #include "GSTables.h"
 #include "GSAlignedClass.h"
 
+#include <array>
+
 class GSLocalMemory;
 class GSTexture;
 
 class alignas(32) GSClut final : public GSAlignedClass<32>
 {
 	static constexpr u32 CLUT_ALLOC_SIZE = 4096 * 2;
+	static constexpr u32 READ_CACHE_SIZE = 8;
 
 	static const GSVector4i m_bm;
 	static const GSVector4i m_gm;
@@ -32,6 +35,7 @@ class alignas(32) GSClut final : public GSAlignedClass<32>
 		GIFRegTEXCLUT TEXCLUT;
 		u8 dirty;
 		u64 next_tex0;
+		u64 src_hash; // Hash of the source blocks for CSM1 loads, 0 if not hashed.
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT);
 	} m_write = {};
 
@@ -42,10 +46,29 @@ class alignas(32) GSClut final : public GSAlignedClass<32>
 		bool dirty;
 		bool adirty;
 		int amin, amax;
+		u64 hash; // Hash of the expanded palette in m_buff32, same as the texture cache palette hash.
+		u16 hash_pal;
+		s32 cache_index;
 		bool IsDirty(const GIFRegTEX0& TEX0);
 		bool IsDirty(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 	} m_read = {};
 
+	// Recently expanded palettes, games which flip between a handful of palettes per draw
+	// keep hitting the same few, so there is no need to expand them and scan the alpha again.
+	struct alignas(32) ReadCacheEntry
+	{
+		u32 buff32[256];
+		u64 key;
+		u64 src_hash;
+		u64 hash;
+		int amin, amax;
+		bool adirty;
+		bool valid;
+	};
+
+	std::array<ReadCacheEntry, READ_CACHE_SIZE> m_read_cache = {};
+	u32 m_read_cache_next = 0;
+
 	GSTexture* m_gpu_clut4 = nullptr;
 	GSTexture* m_gpu_clut8 = nullptr;
 	GSTexture* m_current_gpu_clut = nullptr;
@@ -92,12 +115,19 @@ private:
 
 	static void Expand16(const u16* RESTRICT src, u32* RESTRICT dst, int w, const GIFRegTEXA& TEXA);
 
+	u64 HashWriteSource(const GIFRegTEX0& TEX0) const;
+	u64 HashReadSource(const GIFRegTEX0& TEX0) const;
+	void ReadCLUT(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
+
 public:
 	GSClut(GSLocalMemory* mem);
 	~GSClut();
 
 	__fi GSTexture* GetGPUTexture() const { return m_current_gpu_clut; }
 
+	/// Returns the hash of the last expanded palette, or 0 if it was expanded with a different size.
+	__fi u64 GetPaletteHash(u16 pal) const { return (m_read.hash_pal == pal) ? m_read.hash : 0; }
+
 	void Reset();
 	bool InvalidateRange(u32 start_block, u32 end_block, bool is_draw = false);
 	u8 IsInvalid();
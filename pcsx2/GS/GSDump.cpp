@@ -3,19 +3,27 @@
 
 #include "GS/GSDump.h"
 #include "GS/GSExtra.h"
+#include "GS/GSJobQueue.h"
 #include "GS/GSLzma.h"
 #include "GS/GSState.h"
+#include "Host.h"
 
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/FileSystem.h"
 #include "common/HeapArray.h"
+#include "common/Path.h"
 #include "common/ScopedGuard.h"
 
+#include "fmt/format.h"
+
 #include <7zCrc.h>
 #include <XzCrc64.h>
 #include <XzEnc.h>
 #include <zstd.h>
 
+#include <deque>
+
 GSDumpBase::GSDumpBase(std::string fn)
 	: m_filename(std::move(fn))
 	, m_frames(0)
@@ -32,19 +40,20 @@ GSDumpBase::~GSDumpBase()
 		std::fclose(m_gs);
 }
 
-void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
+template <typename T>
+static void WriteDumpHeader(const T& append, const std::string& serial, u32 crc,
 	u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 	const freezeData& fd, const GSPrivRegSet* regs)
 {
 	// New header: CRC of FFFFFFFF, secondary header, full header follows.
 	const u32 fake_crc = 0xFFFFFFFFu;
-	AppendRawData(&fake_crc, 4);
+	append(&fake_crc, 4);
 
 	// Compute full header size (with serial).
 	// This acts as the state size for loading older dumps.
 	const u32 screenshot_size = screenshot_width * screenshot_height * sizeof(screenshot_pixels[0]);
 	const u32 header_size = sizeof(GSDumpHeader) + static_cast<u32>(serial.size()) + screenshot_size;
-	AppendRawData(&header_size, 4);
+	append(&header_size, 4);
 
 	// Write hader.
 	GSDumpHeader header = {};
@@ -57,15 +66,23 @@ void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
 	header.screenshot_height = screenshot_height;
 	header.screenshot_offset = header.serial_offset + header.serial_size;
 	header.screenshot_size = screenshot_size;
-	AppendRawData(&header, sizeof(header));
+	append(&header, sizeof(header));
 	if (!serial.empty())
-		AppendRawData(serial.data(), serial.size());
+		append(serial.data(), serial.size());
 	if (screenshot_pixels)
-		AppendRawData(screenshot_pixels, screenshot_size);
+		append(screenshot_pixels, screenshot_size);
 
 	// Then the real state data.
-	AppendRawData(fd.data, fd.size);
-	AppendRawData(regs, sizeof(*regs));
+	append(fd.data, fd.size);
+	append(regs, sizeof(*regs));
+}
+
+void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
+	u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
+	const freezeData& fd, const GSPrivRegSet* regs)
+{
+	WriteDumpHeader([this](const void* data, size_t size) { AppendRawData(data, size); }, serial, crc,
+		screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 }
 
 void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
@@ -77,6 +94,7 @@ void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
 	AppendRawData(static_cast<u8>(index));
 	AppendRawData(&size, 4);
 	AppendRawData(mem, size);
+	m_packets++;
 }
 
 void GSDumpBase::ReadFIFO(u32 size)
@@ -86,6 +104,7 @@ void GSDumpBase::ReadFIFO(u32 size)
 
 	AppendRawData(2);
 	AppendRawData(&size, 4);
+	m_packets++;
 }
 
 bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
@@ -100,10 +119,14 @@ bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
 	AppendRawData(1);
 	AppendRawData(static_cast<u8>(field));
 
+	m_packets += 2;
+	m_frames++;
+	OnFrameEnd();
+
 	if (last)
 		m_extra_frames--;
 
-	return (++m_frames & 1) == 0 && last && (m_extra_frames < 0);
+	return (m_frames & 1) == 0 && last && (m_extra_frames < 0);
 }
 
 void GSDumpBase::Write(const void* data, size_t size)
@@ -313,15 +336,25 @@ namespace
 {
 	class GSDumpZst final : public GSDumpBase
 	{
+		// Uncompressed size of each independently decompressable frame, which bounds the cost of a seek.
+		static constexpr u64 SEEK_FRAME_SIZE = 8 * _1mb;
+
 		ZSTD_CStream* m_strm;
 
 		std::vector<u8> m_in_buff;
 		std::vector<u8> m_out_buff;
 
+		std::vector<GSDumpIndexEntry> m_index;
+		u64 m_compressed_size = 0;
+		u64 m_uncompressed_size = 0;
+		u64 m_frame_start = 0;
+
 		void MayFlush();
 		void Compress(ZSTD_EndDirective action);
+		void WriteIndex();
 		void AppendRawData(const void* data, size_t size);
 		void AppendRawData(u8 c);
+		void OnFrameEnd() override;
 
 	public:
 		GSDumpZst(const std::string& fn, const std::string& serial, u32 crc,
@@ -343,6 +376,8 @@ namespace
 		m_in_buff.reserve(_1mb);
 		m_out_buff.resize(_1mb);
 
+		m_index.push_back({});
+
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 	}
 
@@ -350,6 +385,7 @@ namespace
 	{
 		// Finish the stream
 		Compress(ZSTD_e_end);
+		WriteIndex();
 
 		ZSTD_freeCStream(m_strm);
 	}
@@ -359,15 +395,40 @@ namespace
 		size_t old_size = m_in_buff.size();
 		m_in_buff.resize(old_size + size);
 		memcpy(&m_in_buff[old_size], data, size);
+		m_uncompressed_size += size;
 		MayFlush();
 	}
 
 	void GSDumpZst::AppendRawData(u8 c)
 	{
 		m_in_buff.push_back(c);
+		m_uncompressed_size++;
 		MayFlush();
 	}
 
+	void GSDumpZst::OnFrameEnd()
+	{
+		if ((m_uncompressed_size - m_frame_start) < SEEK_FRAME_SIZE)
+			return;
+
+		// End the zstd frame here, so decompression can start from the next vsync.
+		Compress(ZSTD_e_end);
+		m_frame_start = m_uncompressed_size;
+		m_index.push_back({m_compressed_size, m_uncompressed_size, GetVSyncCount(), GetPacketCount()});
+	}
+
+	void GSDumpZst::WriteIndex()
+	{
+		// Goes in a skippable frame, so older versions still decompress the dump as usual.
+		const GSDumpIndexFooter footer = {static_cast<u32>(m_index.size()), GetVSyncCount(), GetPacketCount(),
+			GSDUMP_INDEX_VERSION, GSDUMP_INDEX_MAGIC};
+		const u32 header[2] = {ZSTD_MAGIC_SKIPPABLE_START,
+			static_cast<u32>(m_index.size() * sizeof(GSDumpIndexEntry) + sizeof(footer))};
+		Write(header, sizeof(header));
+		Write(m_index.data(), m_index.size() * sizeof(GSDumpIndexEntry));
+		Write(&footer, sizeof(footer));
+	}
+
 	void GSDumpZst::MayFlush()
 	{
 		if (m_in_buff.size() >= _1mb)
@@ -376,7 +437,8 @@ namespace
 
 	void GSDumpZst::Compress(ZSTD_EndDirective action)
 	{
-		if (m_in_buff.empty())
+		// Ending a frame still has to flush what the compressor is holding on to.
+		if (m_in_buff.empty() && action != ZSTD_e_end)
 			return;
 
 		ZSTD_inBuffer inbuf = {m_in_buff.data(), m_in_buff.size(), 0};
@@ -395,6 +457,7 @@ namespace
 			if (outbuf.pos > 0)
 			{
 				Write(m_out_buff.data(), outbuf.pos);
+				m_compressed_size += outbuf.pos;
 				outbuf.pos = 0;
 			}
 
@@ -425,3 +488,368 @@ std::unique_ptr<GSDumpBase> GSDumpBase::CreateZstDump(
 		screenshot_width, screenshot_height, screenshot_pixels,
 		fd, regs);
 }
+
+//////////////////////////////////////////////////////////////////////
+// GSDumpReplayBuffer implementation
+//////////////////////////////////////////////////////////////////////
+
+struct GSDumpReplayBuffer::Job
+{
+	enum class Type : u8
+	{
+		Keyframe,
+		Chunk,
+		Clear,
+		Save,
+	};
+
+	Type type;
+	u32 vsyncs = 0; ///< Vsyncs in the chunk, or the number to keep for a keyframe.
+	u32 packets = 0;
+	std::vector<u8> data;
+	std::string path;
+};
+
+struct GSDumpReplayBuffer::Worker
+{
+	// Lower than regular dumps, the worker has to keep up with the game.
+	static constexpr int COMPRESSION_LEVEL = 3;
+
+	// Older segments are dropped past this, regardless of the requested length.
+	static constexpr size_t MAX_MEMORY = 256 * _1mb;
+
+	struct Chunk
+	{
+		std::vector<u8> data;
+		u64 uncompressed_size = 0;
+		u32 vsyncs = 0;
+		u32 packets = 0;
+	};
+
+	struct Segment
+	{
+		Chunk keyframe;
+		std::vector<Chunk> chunks;
+		u32 vsyncs = 0;
+		size_t memory = 0;
+	};
+
+	ZSTD_CCtx* cctx;
+	std::vector<u8> compress_buffer;
+	std::deque<Segment> segments;
+	size_t memory = 0;
+	u32 total_vsyncs = 0;
+	u32 max_vsyncs = 0;
+
+	// Must come last, the thread starts as soon as it's constructed.
+	GSJobQueue<std::shared_ptr<Job>, 64> queue;
+
+	Worker();
+	~Worker();
+
+	void Process(std::shared_ptr<Job>& job);
+	bool Compress(const Job& job, Chunk* chunk);
+	void Trim();
+	void Reset();
+	void Save(const std::string& path) const;
+};
+
+GSDumpReplayBuffer::Worker::Worker()
+	: cctx(ZSTD_createCCtx())
+	, queue(nullptr, [this](std::shared_ptr<Job>& job) { Process(job); }, nullptr)
+{
+}
+
+GSDumpReplayBuffer::Worker::~Worker()
+{
+	// Pending saves still have to be written.
+	queue.Wait();
+	ZSTD_freeCCtx(cctx);
+}
+
+void GSDumpReplayBuffer::Worker::Process(std::shared_ptr<Job>& job)
+{
+	switch (job->type)
+	{
+		case Job::Type::Keyframe:
+		{
+			Segment& segment = segments.emplace_back();
+			if (!Compress(*job, &segment.keyframe))
+			{
+				segments.pop_back();
+				break;
+			}
+
+			segment.memory = segment.keyframe.data.size();
+			memory += segment.memory;
+			max_vsyncs = job->vsyncs;
+			Trim();
+		}
+		break;
+
+		case Job::Type::Chunk:
+		{
+			// Nothing to continue from if the keyframe failed.
+			if (segments.empty())
+				break;
+
+			Segment& segment = segments.back();
+			Chunk& chunk = segment.chunks.emplace_back();
+			if (!Compress(*job, &chunk))
+			{
+				// A gap in the packets can't be replayed, wait for the next keyframe instead.
+				Reset();
+				break;
+			}
+
+			segment.vsyncs += chunk.vsyncs;
+			segment.memory += chunk.data.size();
+			total_vsyncs += chunk.vsyncs;
+			memory += chunk.data.size();
+			Trim();
+		}
+		break;
+
+		case Job::Type::Clear:
+			Reset();
+			break;
+
+		case Job::Type::Save:
+			Save(job->path);
+			break;
+	}
+}
+
+bool GSDumpReplayBuffer::Worker::Compress(const Job& job, Chunk* chunk)
+{
+	compress_buffer.resize(ZSTD_compressBound(job.data.size()));
+	const size_t size = ZSTD_compressCCtx(cctx, compress_buffer.data(), compress_buffer.size(),
+		job.data.data(), job.data.size(), COMPRESSION_LEVEL);
+	if (ZSTD_isError(size))
+	{
+		Console.ErrorFmt("GSDumpReplayBuffer: Error {}", ZSTD_getErrorName(size));
+		return false;
+	}
+
+	chunk->data.assign(compress_buffer.begin(), compress_buffer.begin() + size);
+	chunk->uncompressed_size = job.data.size();
+	chunk->vsyncs = (job.type == Job::Type::Chunk) ? job.vsyncs : 0;
+	chunk->packets = job.packets;
+	return true;
+}
+
+void GSDumpReplayBuffer::Worker::Trim()
+{
+	// The oldest segment is only needed while the newer ones don't cover the whole length by themselves.
+	while (segments.size() > 1 && ((total_vsyncs - segments.front().vsyncs) >= max_vsyncs || memory > MAX_MEMORY))
+	{
+		total_vsyncs -= segments.front().vsyncs;
+		memory -= segments.front().memory;
+		segments.pop_front();
+	}
+}
+
+void GSDumpReplayBuffer::Worker::Reset()
+{
+	segments.clear();
+	memory = 0;
+	total_vsyncs = 0;
+}
+
+void GSDumpReplayBuffer::Worker::Save(const std::string& path) const
+{
+	if (segments.empty())
+	{
+		Host::AddKeyedOSDMessage("GSDump", TRANSLATE_STR("GS", "Nothing has been recorded in the GS dump replay buffer yet."),
+			Host::OSD_ERROR_DURATION);
+		return;
+	}
+
+	Error error;
+	FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(path.c_str(), "wb", &error);
+	if (!fp)
+	{
+		Host::AddKeyedOSDMessage("GSDump",
+			fmt::format(TRANSLATE_FS("GS", "Failed to save GS dump to '{}': {}"), Path::GetFileName(path), error.GetDescription()),
+			Host::OSD_ERROR_DURATION);
+		return;
+	}
+
+	// Each chunk is already a complete zstd frame, so the file is just the first keyframe followed by every chunk
+	// after it. The later keyframes aren't needed, the packets carry on from one segment to the next.
+	std::vector<GSDumpIndexEntry> index;
+	u64 compressed_size = 0;
+	u64 uncompressed_size = 0;
+	u32 vsyncs = 0;
+	u32 packets = 0;
+	bool result = true;
+	const auto write_chunk = [&](const Chunk& chunk) {
+		index.push_back({compressed_size, uncompressed_size, vsyncs, packets});
+		result = result && (std::fwrite(chunk.data.data(), chunk.data.size(), 1, fp.get()) == 1);
+		compressed_size += chunk.data.size();
+		uncompressed_size += chunk.uncompressed_size;
+		vsyncs += chunk.vsyncs;
+		packets += chunk.packets;
+	};
+
+	write_chunk(segments.front().keyframe);
+	for (const Segment& segment : segments)
+	{
+		for (const Chunk& chunk : segment.chunks)
+			write_chunk(chunk);
+	}
+
+	// Same index as GSDumpZst, in a skippable frame.
+	const GSDumpIndexFooter footer = {static_cast<u32>(index.size()), vsyncs, packets, GSDUMP_INDEX_VERSION, GSDUMP_INDEX_MAGIC};
+	const u32 header[2] = {ZSTD_MAGIC_SKIPPABLE_START, static_cast<u32>(index.size() * sizeof(GSDumpIndexEntry) + sizeof(footer))};
+	result = result && (std::fwrite(header, sizeof(header), 1, fp.get()) == 1) &&
+			 (std::fwrite(index.data(), sizeof(GSDumpIndexEntry), index.size(), fp.get()) == index.size()) &&
+			 (std::fwrite(&footer, sizeof(footer), 1, fp.get()) == 1);
+	if (!result || std::fflush(fp.get()) != 0)
+	{
+		Host::AddKeyedOSDMessage("GSDump",
+			fmt::format(TRANSLATE_FS("GS", "Failed to save GS dump to '{}'."), Path::GetFileName(path)), Host::OSD_ERROR_DURATION);
+		return;
+	}
+
+	Host::AddKeyedOSDMessage("GSDump",
+		fmt::format(TRANSLATE_FS("GS", "Saved {} frames from the GS dump replay buffer to '{}'."), vsyncs, Path::GetFileName(path)),
+		Host::OSD_INFO_DURATION);
+}
+
+GSDumpReplayBuffer::GSDumpReplayBuffer(u32 seconds)
+	: m_worker(std::make_unique<Worker>())
+	, m_seconds(seconds)
+{
+	m_chunk.reserve(CHUNK_SIZE);
+}
+
+GSDumpReplayBuffer::~GSDumpReplayBuffer() = default;
+
+void GSDumpReplayBuffer::AppendRawData(const void* data, size_t size)
+{
+	const size_t old_size = m_chunk.size();
+	m_chunk.resize(old_size + size);
+	std::memcpy(&m_chunk[old_size], data, size);
+}
+
+void GSDumpReplayBuffer::AppendRawData(u8 c)
+{
+	m_chunk.push_back(c);
+}
+
+void GSDumpReplayBuffer::Transfer(int index, const u8* mem, size_t size)
+{
+	if (!m_has_segment || size == 0)
+		return;
+
+	const u32 size32 = static_cast<u32>(size);
+	AppendRawData(0);
+	AppendRawData(static_cast<u8>(index));
+	AppendRawData(&size32, 4);
+	AppendRawData(mem, size);
+	m_chunk_packets++;
+}
+
+void GSDumpReplayBuffer::ReadFIFO(u32 size)
+{
+	if (!m_has_segment || size == 0)
+		return;
+
+	AppendRawData(2);
+	AppendRawData(&size, 4);
+	m_chunk_packets++;
+}
+
+bool GSDumpReplayBuffer::VSync(int field, const GSPrivRegSet* regs, float refresh_rate)
+{
+	const u32 vsyncs_per_second = std::max(static_cast<u32>(refresh_rate + 0.5f), 1u);
+	m_max_vsyncs = m_seconds * vsyncs_per_second;
+	if (m_has_segment)
+	{
+		AppendRawData(3);
+		AppendRawData(regs, sizeof(*regs));
+
+		AppendRawData(1);
+		AppendRawData(static_cast<u8>(field));
+
+		m_chunk_packets += 2;
+		m_chunk_vsyncs++;
+		m_segment_vsyncs++;
+
+		// Chunks only end after a vsync, so every one of them is a point the replayer can seek to.
+		if (m_chunk.size() >= CHUNK_SIZE)
+			FlushChunk();
+	}
+
+	if (!m_save_path.empty())
+	{
+		FlushChunk();
+
+		std::shared_ptr<Job> job = std::make_shared<Job>();
+		job->type = Job::Type::Save;
+		job->path = std::move(m_save_path);
+		m_save_path = {};
+		m_worker->queue.Push(job);
+	}
+
+	return (!m_has_segment || m_segment_vsyncs >= KEYFRAME_INTERVAL * vsyncs_per_second);
+}
+
+void GSDumpReplayBuffer::AddKeyframe(const std::string& serial, u32 crc, const freezeData& fd, const GSPrivRegSet* regs)
+{
+	FlushChunk();
+
+	std::shared_ptr<Job> job = std::make_shared<Job>();
+	job->type = Job::Type::Keyframe;
+	job->vsyncs = m_max_vsyncs;
+	job->data.reserve(fd.size + _1mb);
+	WriteDumpHeader([&job](const void* data, size_t size) {
+		const size_t old_size = job->data.size();
+		job->data.resize(old_size + size);
+		std::memcpy(&job->data[old_size], data, size);
+	}, serial, crc, 0, 0, nullptr, fd, regs);
+	m_worker->queue.Push(job);
+
+	m_segment_vsyncs = 0;
+	m_has_segment = true;
+}
+
+void GSDumpReplayBuffer::Clear()
+{
+	if (!m_has_segment)
+		return;
+
+	m_chunk.clear();
+	m_chunk_vsyncs = 0;
+	m_chunk_packets = 0;
+	m_segment_vsyncs = 0;
+	m_has_segment = false;
+
+	std::shared_ptr<Job> job = std::make_shared<Job>();
+	job->type = Job::Type::Clear;
+	m_worker->queue.Push(job);
+}
+
+void GSDumpReplayBuffer::Save(std::string path)
+{
+	m_save_path = std::move(path);
+}
+
+void GSDumpReplayBuffer::FlushChunk()
+{
+	if (m_chunk.empty())
+		return;
+
+	std::shared_ptr<Job> job = std::make_shared<Job>();
+	job->type = Job::Type::Chunk;
+	job->vsyncs = m_chunk_vsyncs;
+	job->packets = m_chunk_packets;
+	job->data = std::move(m_chunk);
+	m_worker->queue.Push(job);
+
+	m_chunk = {};
+	m_chunk.reserve(CHUNK_SIZE);
+	m_chunk_vsyncs = 0;
+	m_chunk_packets = 0;
+}
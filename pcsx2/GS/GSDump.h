@@ -24,6 +24,10 @@ ReadFIFO2 data (id == 2)
 Regs data (id == 3)
 - [PMODE/0x2000]
 
+Zstandard dumps are split into independent frames which start after a vsync, followed by a skippable frame
+holding an index of them, so the reader can seek without decompressing everything before that point:
+- [skippable magic/4] [size/4] [GSDumpIndexEntry/16 * N] [GSDumpIndexFooter/20]
+
 */
 
 #pragma pack(push, 4)
@@ -39,14 +43,35 @@ struct GSDumpHeader
 	u32 screenshot_offset;
 	u32 screenshot_size;
 };
+
+struct GSDumpIndexEntry
+{
+	u64 file_offset; ///< Start of the compressed frame in the file.
+	u64 stream_offset; ///< Position of the first byte of the frame in the decompressed stream.
+	u32 frame; ///< Number of vsyncs before the first packet of the frame.
+	u32 packet; ///< Number of packets before the first packet of the frame.
+};
+
+struct GSDumpIndexFooter
+{
+	u32 num_entries;
+	u32 num_frames;
+	u32 num_packets;
+	u32 version;
+	u32 magic;
+};
 #pragma pack(pop)
 
+static constexpr u32 GSDUMP_INDEX_MAGIC = 0x58444947; // GIDX
+static constexpr u32 GSDUMP_INDEX_VERSION = 1;
+
 class GSDumpBase
 {
 	FILE* m_gs;
 	std::string m_filename;
 	int m_frames;
 	int m_extra_frames;
+	u32 m_packets = 0;
 
 protected:
 	void AddHeader(const std::string& serial, u32 crc,
@@ -57,6 +82,12 @@ protected:
 	virtual void AppendRawData(const void* data, size_t size) = 0;
 	virtual void AppendRawData(u8 c) = 0;
 
+	/// Called after each vsync has been written, i.e. at a point where playback can resume from.
+	virtual void OnFrameEnd() {}
+
+	__fi u32 GetPacketCount() const { return m_packets; }
+	__fi u32 GetVSyncCount() const { return static_cast<u32>(m_frames); }
+
 public:
 	GSDumpBase(std::string fn);
 	virtual ~GSDumpBase();
@@ -80,3 +111,51 @@ public:
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs);
 };
+
+/// Keeps the last few seconds of GS packets in memory, so a dump can be saved after a problem has already happened.
+/// Packets are appended to a chunk on the GS thread, and each complete chunk is compressed as an independent zstd
+/// frame on a worker thread. Chunks are grouped in segments which start with a keyframe, a dump header holding a
+/// copy of the GS state, and only enough segments to cover the requested length are kept.
+class GSDumpReplayBuffer
+{
+public:
+	explicit GSDumpReplayBuffer(u32 seconds);
+	~GSDumpReplayBuffer();
+
+	__fi u32 GetLength() const { return m_seconds; }
+
+	void ReadFIFO(u32 size);
+	void Transfer(int index, const u8* mem, size_t size);
+
+	/// Returns true when the caller should start a new segment with AddKeyframe().
+	bool VSync(int field, const GSPrivRegSet* regs, float refresh_rate);
+
+	void AddKeyframe(const std::string& serial, u32 crc, const freezeData& fd, const GSPrivRegSet* regs);
+
+	/// Drops everything recorded so far, for when the packet stream no longer follows on from the last keyframe.
+	void Clear();
+
+	/// Writes the retained segments to path at the next vsync, in the background.
+	void Save(std::string path);
+
+private:
+	struct Job;
+	struct Worker;
+
+	static constexpr size_t CHUNK_SIZE = _1mb;
+	static constexpr u32 KEYFRAME_INTERVAL = 5; // in seconds
+
+	void AppendRawData(const void* data, size_t size);
+	void AppendRawData(u8 c);
+	void FlushChunk();
+
+	std::unique_ptr<Worker> m_worker;
+	std::vector<u8> m_chunk;
+	std::string m_save_path;
+	u32 m_seconds;
+	u32 m_max_vsyncs = 0;
+	u32 m_segment_vsyncs = 0;
+	u32 m_chunk_vsyncs = 0;
+	u32 m_chunk_packets = 0;
+	bool m_has_segment = false;
+};
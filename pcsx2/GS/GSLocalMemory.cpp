@@ -49,6 +49,7 @@ GSLocalMemory::readImage GSLocalMemory::m_readImageX;
 
 GSLocalMemory::GSLocalMemory()
 	: m_clut(this)
+	, m_p2tmap(MAX_PAGE2TILE_MAPS)
 {
 	m_vm8 = (u8*)GSAllocateWrappedMemory(m_vmsize, 4);
 	if (!m_vm8)
@@ -248,11 +249,6 @@ GSLocalMemory::~GSLocalMemory()
 		_aligned_free(i.second);
 	for (auto& i : m_po4map)
 		_aligned_free(i.second);
-
-	for (auto& i : m_p2tmap)
-	{
-		delete[] i.second;
-	}
 }
 
 GSPixelOffset* GSLocalMemory::GetPixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
@@ -361,15 +357,13 @@ GSPixelOffset4* GSLocalMemory::GetPixelOffset4(const GIFRegFRAME& FRAME, const G
 	return off;
 }
 
-std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
+GSPage2TileMap GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
 {
 	u64 hash = TEX0.U64 & 0x3ffffffffull; // TBP0 TBW PSM TW TH
 
-	auto it = m_p2tmap.find(hash);
-
-	if (it != m_p2tmap.end())
+	if (const GSPage2TileMap* cached = m_p2tmap.Lookup(hash))
 	{
-		return it->second;
+		return *cached;
 	}
 
 	GSVector2i bs = m_psm[TEX0.PSM].bs;
@@ -401,7 +395,7 @@ std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
 
 	// combine the lower 5 bits of the address into a 9:5 pointer:mask form, so the "valid bits" can be tested against an u32 array
 
-	auto p2t = new std::vector<GSVector2i>[GS_MAX_PAGES];
+	std::shared_ptr<std::vector<GSVector2i>[]> p2t(new std::vector<GSVector2i>[GS_MAX_PAGES]);
 
 	for (const auto& i : tmp)
 	{
@@ -441,9 +435,7 @@ std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
 		std::sort(p2t[page].begin(), p2t[page].end(), [](const GSVector2i& a, const GSVector2i& b) { return a.x < b.x; });
 	}
 
-	m_p2tmap[hash] = p2t;
-
-	return p2t;
+	return *m_p2tmap.Insert(hash, std::move(p2t));
 }
 
 u32 GSLocalMemory::IsPageAlignedMasked(u32 psm, const GSVector4i& rc)
@@ -675,7 +667,7 @@ void GSLocalMemory::SaveBMP(const std::string& fn, u32 bp, u32 bw, u32 psm, int
 		}
 	}
 
-	GSPng::Save((IsDevBuild || GSConfig.SaveAlpha) ? GSPng::RGB_A_PNG : GSPng::RGB_PNG, fn, static_cast<u8*>(bits), w, h, pitch, GSConfig.PNGCompressionLevel, false);
+	GSPng::SaveAsync((IsDevBuild || GSConfig.SaveAlpha) ? GSPng::RGB_A_PNG : GSPng::RGB_PNG, fn, static_cast<u8*>(bits), w, h, pitch, GSConfig.PNGCompressionLevel, false);
 
 	_aligned_free(bits);
 }
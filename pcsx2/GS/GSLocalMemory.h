@@ -9,8 +9,10 @@
 #include "MultiISA.h"
 
 #include "common/Assertions.h"
+#include "common/LRUCache.h"
 
 #include <array>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +37,9 @@ struct GSPixelOffset4
 	u32 fbp, zbp, fpsm, zpsm, bw;
 };
 
+/// Per-page lists of tile rows (x) and inverted column masks (y) covered by a texture, see GSLocalMemory::GetPage2TileMap
+using GSPage2TileMap = std::shared_ptr<const std::vector<GSVector2i>[]>;
+
 class GSOffset;
 
 class GSSwizzleInfo
@@ -470,6 +475,9 @@ public:
 
 	static constexpr int m_vmsize = 1024 * 1024 * 4;
 
+	/// Each page-to-tile map is at least 12KB, keep the ones for recently created textures around
+	static constexpr size_t MAX_PAGE2TILE_MAPS = 256;
+
 	u8* m_vm8;
 
 	GSClut m_clut;
@@ -506,7 +514,8 @@ protected:
 
 	std::unordered_map<u32, GSPixelOffset*> m_pomap;
 	std::unordered_map<u32, GSPixelOffset4*> m_po4map;
-	std::unordered_map<u64, std::vector<GSVector2i>*> m_p2tmap;
+	/// Textures hold a reference to their map, so evicting only drops the cache's reference
+	LRUCache<u64, GSPage2TileMap> m_p2tmap;
 
 public:
 	GSLocalMemory();
@@ -522,7 +531,7 @@ public:
 	}
 	GSPixelOffset* GetPixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF);
 	GSPixelOffset4* GetPixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF);
-	std::vector<GSVector2i>* GetPage2TileMap(const GIFRegTEX0& TEX0);
+	GSPage2TileMap GetPage2TileMap(const GIFRegTEX0& TEX0);
 	static bool HasOverlap(u32 src_bp, u32 src_bw, u32 src_psm, GSVector4i src_rect, u32 dst_bp, u32 dst_bw, u32 dst_psm, GSVector4i dst_rect);
 	static u32 IsPageAlignedMasked(u32 psm, const GSVector4i& rc);
 	static bool IsPageAligned(u32 psm, const GSVector4i& rc);
@@ -63,7 +63,7 @@ class CURRENT_ISA::GSLocalMemoryFunctions
 	static void ReadTextureBlock4HLP(const GSLocalMemory& mem, u32 bp, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
 	static void ReadTextureBlock4HHP(const GSLocalMemory& mem, u32 bp, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
 
-#if _M_SSE == 0x501
+#if _M_SSE >= 0x501
 	static void ReadTexture8HSW(GSLocalMemory& mem, const GSOffset& off, const GSVector4i& r, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
 	static void ReadTexture8HHSW(GSLocalMemory& mem, const GSOffset& off, const GSVector4i& r, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
 	static void ReadTextureBlock8HSW(const GSLocalMemory& mem, u32 bp, u8* dst, int dstpitch, const GIFRegTEXA& TEXA);
@@ -166,7 +166,7 @@ void GSLocalMemoryFunctions::PopulateFunctions(GSLocalMemory& mem)
 	mem.m_psm[PSMZ16].rtxbP = ReadTextureBlock16;
 	mem.m_psm[PSMZ16S].rtxbP = ReadTextureBlock16;
 
-#if _M_SSE == 0x501
+#if _M_SSE >= 0x501
 	if (g_cpu.hasSlowGather)
 	{
 		mem.m_psm[PSMT8].rtx = ReadTexture8HSW;
@@ -1142,7 +1142,7 @@ void GSLocalMemoryFunctions::ReadTexture8H(GSLocalMemory& mem, const GSOffset& o
 	});
 }
 
-#if _M_SSE == 0x501
+#if _M_SSE >= 0x501
 void GSLocalMemoryFunctions::ReadTexture8HSW(GSLocalMemory& mem, const GSOffset& off, const GSVector4i& r, u8* dst, int dstpitch, const GIFRegTEXA& TEXA)
 {
 	const u32* pal = mem.m_clut;
@@ -1242,7 +1242,7 @@ void GSLocalMemoryFunctions::ReadTextureBlock8H(const GSLocalMemory& mem, u32 bp
 	GSBlock::ReadAndExpandBlock8H_32(mem.BlockPtr(bp), dst, dstpitch, mem.m_clut);
 }
 
-#if _M_SSE == 0x501
+#if _M_SSE >= 0x501
 void GSLocalMemoryFunctions::ReadTextureBlock8HSW(const GSLocalMemory& mem, u32 bp, u8* dst, int dstpitch, const GIFRegTEXA& TEXA)
 {
 	ALIGN_STACK(32);
@@ -8,6 +8,7 @@
 #include "common/BitUtils.h"
 #include "common/Error.h"
 #include "common/HeapArray.h"
+#include "common/Threading.h"
 
 #include "GS/GSDump.h"
 #include "GS/GSLzma.h"
@@ -19,6 +20,7 @@
 #include <XzCrc64.h>
 #include <zstd.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace GSDumpTypes;
@@ -84,6 +86,8 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
+	u64 header_size = sizeof(m_crc) + sizeof(ss) + ss;
+
 	// Pull serial out of new header, if present.
 	if (m_crc == 0xFFFFFFFFu)
 	{
@@ -117,6 +121,8 @@ bool GSDumpFile::ReadFile(Error* error)
 			Error::SetString(error, "Failed to read real state data");
 			return false;
 		}
+
+		header_size += header.state_size;
 	}
 
 	m_regs_data.resize(8192);
@@ -126,105 +132,254 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
-	// read all the packet data in
-	// TODO: make this suck less by getting the full/extracted size and preallocating
-	for (;;)
+	header_size += m_regs_data.size();
+
+	// Packets are parsed as they're needed from here on, so memory use doesn't depend on the length of the dump.
+	m_stream_pos = header_size;
+	m_seek_points.insert(m_seek_points.begin(), SeekPoint{header_size, 0, 0});
+	for (u32 i = 0; i < NUM_READ_BUFFERS; i++)
+	{
+		m_read_buffers[i].resize(READ_BUFFER_SIZE);
+		m_free_buffers.push_back(i);
+	}
+
+	StartReadThread();
+	return true;
+}
+
+void GSDumpFile::AddIndexedSeekPoint(const SeekPoint& point, u32 num_frames, u32 num_packets)
+{
+	m_seek_points.push_back(point);
+	m_frame_count = num_frames;
+	m_packet_count = num_packets;
+	m_has_index = true;
+}
+
+void GSDumpFile::StartReadThread()
+{
+	m_read_thread_done = false;
+	m_read_thread_stop = false;
+	m_read_thread = std::thread(&GSDumpFile::ReadThreadEntryPoint, this);
+}
+
+void GSDumpFile::StopReadThread()
+{
+	if (!m_read_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(m_read_mutex);
+		m_read_thread_stop = true;
+	}
+	m_read_cv.notify_all();
+	m_read_thread.join();
+
+	// Anything decompressed ahead is for the old position.
+	if (m_current_buffer >= 0)
 	{
-		const size_t packet_data_size = m_packet_data.size();
-		m_packet_data.resize(std::max<size_t>(packet_data_size * 2, 8 * _1mb));
+		m_free_buffers.push_back(static_cast<u32>(m_current_buffer));
+		m_current_buffer = -1;
+	}
+	m_free_buffers.insert(m_free_buffers.end(), m_filled_buffers.begin(), m_filled_buffers.end());
+	m_filled_buffers.clear();
+	m_current_buffer_pos = 0;
+}
+
+void GSDumpFile::ReadThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("GS Dump Reader");
 
-		const size_t read_size = m_packet_data.size() - packet_data_size;
-		const size_t read = Read(m_packet_data.data() + packet_data_size, read_size);
-		if (read != read_size)
+	for (;;)
+	{
+		u32 index;
 		{
-			if (!IsEof())
-			{
-				Error::SetString(error, "Failed to read packet");
-				return false;
-			}
+			std::unique_lock lock(m_read_mutex);
+			m_read_cv.wait(lock, [this]() { return m_read_thread_stop || !m_free_buffers.empty(); });
+			if (m_read_thread_stop)
+				return;
 
-			m_packet_data.resize(packet_data_size + read);
-			m_packet_data.shrink_to_fit();
-			break;
+			index = m_free_buffers.back();
+			m_free_buffers.pop_back();
 		}
+
+		const size_t size = Read(m_read_buffers[index].data(), READ_BUFFER_SIZE);
+		if (size != READ_BUFFER_SIZE && !IsEof())
+			Console.Error("(GSDump) Failed to read packet data");
+
+		{
+			std::unique_lock lock(m_read_mutex);
+			m_read_buffer_sizes[index] = size;
+			m_filled_buffers.push_back(index);
+			m_read_thread_done = (size != READ_BUFFER_SIZE);
+		}
+		m_read_cv.notify_all();
+
+		if (size != READ_BUFFER_SIZE)
+			return;
 	}
+}
 
-	u8* data = m_packet_data.data();
-	size_t remaining = m_packet_data.size();
-
-#define GET_BYTE(dst) \
-	do \
-	{ \
-		if (remaining < sizeof(u8)) \
-		{ \
-			Error::SetString(error, "Failed to read byte"); \
-			return false; \
-		} \
-		std::memcpy(dst, data, sizeof(u8)); \
-		data++; \
-		remaining--; \
-	} while (0)
-#define GET_WORD(dst) \
-	do \
-	{ \
-		if (remaining < sizeof(u32)) \
-		{ \
-			Error::SetString(error, "Failed to read word"); \
-			return false; \
-		} \
-		std::memcpy(dst, data, sizeof(u32)); \
-		data += sizeof(u32); \
-		remaining -= sizeof(u32); \
-	} while (0)
-
-	while (remaining > 0)
-	{
-		GSData packet = {};
-		packet.path = GSTransferPath::Dummy;
-		GET_BYTE(&packet.id);
-
-		switch (packet.id)
+bool GSDumpFile::NextReadBuffer()
+{
+	std::unique_lock lock(m_read_mutex);
+	if (m_current_buffer >= 0)
+	{
+		m_free_buffers.push_back(static_cast<u32>(m_current_buffer));
+		m_current_buffer = -1;
+		m_read_cv.notify_all();
+	}
+
+	m_read_cv.wait(lock, [this]() { return !m_filled_buffers.empty() || m_read_thread_done; });
+	if (m_filled_buffers.empty())
+		return false;
+
+	m_current_buffer = static_cast<s32>(m_filled_buffers.front());
+	m_current_buffer_pos = 0;
+	m_filled_buffers.pop_front();
+	return true;
+}
+
+bool GSDumpFile::ReadStream(void* ptr, size_t size)
+{
+	u8* dst = static_cast<u8*>(ptr);
+	while (size > 0)
+	{
+		if (m_current_buffer < 0 || m_current_buffer_pos == m_read_buffer_sizes[m_current_buffer])
 		{
-			case GSType::Transfer:
-				GET_BYTE(&packet.path);
-				GET_WORD(&packet.length);
-				break;
-			case GSType::VSync:
-				packet.length = 1;
-				break;
-			case GSType::ReadFIFO2:
-				packet.length = 4;
-				break;
-			case GSType::Registers:
-				packet.length = 8192;
-				break;
-			default:
-				Error::SetString(error, fmt::format("Unknown packet type {}", static_cast<u32>(packet.id)));
+			if (!NextReadBuffer())
 				return false;
+
+			continue;
 		}
 
-		if (packet.length > 0)
+		const size_t avail = m_read_buffer_sizes[m_current_buffer] - m_current_buffer_pos;
+		const size_t copy = std::min(avail, size);
+		std::memcpy(dst, &m_read_buffers[m_current_buffer][m_current_buffer_pos], copy);
+		m_current_buffer_pos += copy;
+		m_stream_pos += copy;
+		dst += copy;
+		size -= copy;
+	}
+
+	return true;
+}
+
+const u8* GSDumpFile::ReadStreamData(size_t size)
+{
+	// Most packets are entirely within one buffer, so they can be passed through without a copy.
+	if (m_current_buffer >= 0 && (m_read_buffer_sizes[m_current_buffer] - m_current_buffer_pos) >= size)
+	{
+		const u8* data = &m_read_buffers[m_current_buffer][m_current_buffer_pos];
+		m_current_buffer_pos += size;
+		m_stream_pos += size;
+		return data;
+	}
+
+	if (m_packet_data.size() < size)
+		m_packet_data.resize(size);
+
+	return ReadStream(m_packet_data.data(), size) ? m_packet_data.data() : nullptr;
+}
+
+const GSDumpFile::GSData* GSDumpFile::GetNextPacket()
+{
+	GSData& packet = m_packet;
+	packet = {};
+	packet.path = GSTransferPath::Dummy;
+
+	if (!ReadStream(&packet.id, sizeof(packet.id)))
+	{
+		// Now we know how long it is, if there wasn't an index.
+		m_frame_count = m_current_frame;
+		m_packet_count = m_current_packet;
+		return nullptr;
+	}
+
+	switch (packet.id)
+	{
+		case GSType::Transfer:
 		{
-			if (remaining < packet.length)
+			u32 length;
+			if (!ReadStream(&packet.path, sizeof(packet.path)) || !ReadStream(&length, sizeof(length)))
 			{
-				// There's apparently some "bad" dumps out there that are missing bytes on the end..
-				// The "safest" option here is to discard the last packet, since that has less risk
-				// of leaving the GS in the middle of a command.
-				Console.Error("(GSDump) Dropping last packet of %u bytes (we only have %u bytes)",
-					static_cast<u32>(packet.length), static_cast<u32>(remaining));
-				break;
+				Console.Error("(GSDump) Failed to read transfer header");
+				return nullptr;
 			}
 
-			packet.data = data;
-			data += packet.length;
-			remaining -= packet.length;
+			packet.length = length;
+		}
+		break;
+		case GSType::VSync:
+			packet.length = 1;
+			break;
+		case GSType::ReadFIFO2:
+			packet.length = 4;
+			break;
+		case GSType::Registers:
+			packet.length = 8192;
+			break;
+		default:
+			Console.Error("(GSDump) Unknown packet type %u", static_cast<u32>(packet.id));
+			return nullptr;
+	}
+
+	if (packet.length > 0)
+	{
+		packet.data = ReadStreamData(packet.length);
+		if (!packet.data)
+		{
+			// There's apparently some "bad" dumps out there that are missing bytes on the end..
+			// The "safest" option here is to discard the last packet, since that has less risk
+			// of leaving the GS in the middle of a command.
+			Console.Error("(GSDump) Dropping last packet of %u bytes", static_cast<u32>(packet.length));
+			return nullptr;
+		}
+	}
+
+	m_current_packet++;
+	m_at_frame_start = (packet.id == GSType::VSync);
+	if (packet.id == GSType::VSync)
+	{
+		m_current_frame++;
+		if (!m_has_index && (m_current_frame % SEEK_POINT_INTERVAL) == 0 && m_current_frame > m_seek_points.back().frame)
+			m_seek_points.push_back(SeekPoint{m_stream_pos, m_current_frame, m_current_packet});
+	}
+
+	return &packet;
+}
+
+bool GSDumpFile::SeekToFrame(u32 frame)
+{
+	if (frame == m_current_frame && m_at_frame_start)
+		return true;
+
+	const auto it = std::upper_bound(m_seek_points.begin(), m_seek_points.end(), frame,
+		[](u32 frame, const SeekPoint& point) { return frame < point.frame; });
+	pxAssert(it != m_seek_points.begin());
+	const SeekPoint& point = *(it - 1);
+
+	// Only reposition if we'd otherwise have to go backwards, or skip over more than the seek point.
+	if (frame <= m_current_frame || point.frame > m_current_frame)
+	{
+		StopReadThread();
+		if (!Seek(point.stream_offset))
+		{
+			Console.ErrorFmt("(GSDump) Failed to seek to offset {}", point.stream_offset);
+			return false;
 		}
 
-		m_dump_packets.push_back(std::move(packet));
+		m_stream_pos = point.stream_offset;
+		m_current_frame = point.frame;
+		m_current_packet = point.packet;
+		m_at_frame_start = true;
+		StartReadThread();
 	}
 
-#undef GET_WORD
-#undef GET_BYTE
+	while (m_current_frame < frame)
+	{
+		if (!GetNextPacket())
+			return false;
+	}
 
 	return true;
 }
@@ -253,6 +408,7 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool Seek(u64 offset) override;
 
 	private:
 		static constexpr size_t kInputBufSize = static_cast<size_t>(1) << 18;
@@ -285,6 +441,7 @@ namespace
 
 	GSDumpLzma::~GSDumpLzma()
 	{
+		StopReadThread();
 		XzUnpacker_Free(&m_unpacker);
 	}
 
@@ -463,6 +620,27 @@ namespace
 		return size - remain;
 	}
 
+	bool GSDumpLzma::Seek(u64 offset)
+	{
+		// Blocks can be decompressed independently, so start from the one containing the offset.
+		const auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), offset,
+			[](u64 offset, const Block& block) { return offset < block.stream_offset; });
+		m_block_index = static_cast<size_t>(it - m_blocks.begin()) - 1;
+		m_block_size = 0;
+		m_block_pos = 0;
+		if (offset >= m_stream_size)
+		{
+			m_block_index = m_blocks.size();
+			return (offset == m_stream_size);
+		}
+
+		if (!DecompressNextBlock())
+			return false;
+
+		m_block_pos = static_cast<size_t>(offset - m_blocks[m_block_index - 1].stream_offset);
+		return (m_block_pos <= m_block_size);
+	}
+
 	/******************************************************************/
 
 	class GSDumpDecompressZst final : public GSDumpFile
@@ -478,7 +656,16 @@ namespace
 		size_t m_avail = 0;
 		size_t m_start = 0;
 
+		// Start of each zstd frame, when the dump has an index of them.
+		struct Frame
+		{
+			u64 file_offset;
+			u64 stream_offset;
+		};
+		std::vector<Frame> m_frames;
+
 		bool Decompress();
+		void ReadIndex();
 
 	public:
 		GSDumpDecompressZst();
@@ -487,12 +674,15 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool Seek(u64 offset) override;
 	};
 
 	GSDumpDecompressZst::GSDumpDecompressZst() = default;
 
 	GSDumpDecompressZst::~GSDumpDecompressZst()
 	{
+		StopReadThread();
+
 		if (m_strm)
 			ZSTD_freeDStream(m_strm);
 
@@ -513,9 +703,55 @@ namespace
 		m_inbuf.size = 0;
 		m_avail = 0;
 		m_start = 0;
+
+		m_frames.push_back({0, 0});
+		ReadIndex();
 		return true;
 	}
 
+	void GSDumpDecompressZst::ReadIndex()
+	{
+		const s64 file_size = FileSystem::FSize64(m_fp.get());
+		GSDumpIndexFooter footer;
+		if (file_size < static_cast<s64>(sizeof(footer) + sizeof(u32) * 2) ||
+			FileSystem::FSeek64(m_fp.get(), file_size - static_cast<s64>(sizeof(footer)), SEEK_SET) != 0 ||
+			std::fread(&footer, sizeof(footer), 1, m_fp.get()) != 1 || footer.magic != GSDUMP_INDEX_MAGIC ||
+			footer.version != GSDUMP_INDEX_VERSION)
+		{
+			// Older dump, or not written by us. Seeking goes back to the start and decompresses from there.
+			std::rewind(m_fp.get());
+			return;
+		}
+
+		const u64 index_size = static_cast<u64>(footer.num_entries) * sizeof(GSDumpIndexEntry);
+		const s64 index_start = file_size - static_cast<s64>(sizeof(footer) + index_size);
+		u32 frame_header[2];
+		std::vector<GSDumpIndexEntry> entries(footer.num_entries);
+		if (index_start < static_cast<s64>(sizeof(frame_header)) ||
+			FileSystem::FSeek64(m_fp.get(), index_start - static_cast<s64>(sizeof(frame_header)), SEEK_SET) != 0 ||
+			std::fread(frame_header, sizeof(frame_header), 1, m_fp.get()) != 1 ||
+			frame_header[0] != ZSTD_MAGIC_SKIPPABLE_START || frame_header[1] != (index_size + sizeof(footer)) ||
+			std::fread(entries.data(), sizeof(GSDumpIndexEntry), entries.size(), m_fp.get()) != entries.size())
+		{
+			Console.Warning("(GSDump) Ignoring corrupted frame index.");
+			std::rewind(m_fp.get());
+			return;
+		}
+
+		for (const GSDumpIndexEntry& entry : entries)
+		{
+			// The first frame starts with the header, not at a packet.
+			if (entry.frame == 0)
+				continue;
+
+			m_frames.push_back({entry.file_offset, entry.stream_offset});
+			AddIndexedSeekPoint({entry.stream_offset, entry.frame, entry.packet}, footer.num_frames, footer.num_packets);
+		}
+
+		DevCon.WriteLnFmt("(GSDump) Read index of {} frames, {} vsyncs", footer.num_entries, footer.num_frames);
+		std::rewind(m_fp.get());
+	}
+
 	bool GSDumpDecompressZst::Decompress()
 	{
 		ZSTD_outBuffer outbuf = {m_area, OUTPUT_BUFFER_SIZE, 0};
@@ -534,6 +770,10 @@ namespace
 				}
 			}
 
+			// Only skippable frames (i.e. the index) were left.
+			if (m_inbuf.pos == m_inbuf.size && std::feof(m_fp.get()))
+				break;
+
 			const size_t ret = ZSTD_decompressStream(m_strm, &outbuf, &m_inbuf);
 			if (ZSTD_isError(ret))
 			{
@@ -575,6 +815,36 @@ namespace
 		return off;
 	}
 
+	bool GSDumpDecompressZst::Seek(u64 offset)
+	{
+		const auto it = std::upper_bound(m_frames.begin(), m_frames.end(), offset,
+			[](u64 offset, const Frame& frame) { return offset < frame.stream_offset; });
+		const Frame& frame = *(it - 1);
+		if (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(frame.file_offset), SEEK_SET) != 0)
+			return false;
+
+		ZSTD_DCtx_reset(m_strm, ZSTD_reset_session_only);
+		m_inbuf.pos = 0;
+		m_inbuf.size = 0;
+		m_avail = 0;
+		m_start = 0;
+
+		// Decompress up to the offset within the frame.
+		u64 remaining = offset - frame.stream_offset;
+		while (remaining > 0)
+		{
+			if (m_avail == 0 && (IsEof() || !Decompress() || m_avail == 0))
+				return false;
+
+			const size_t skip = static_cast<size_t>(std::min<u64>(remaining, m_avail));
+			m_start += skip;
+			m_avail -= skip;
+			remaining -= skip;
+		}
+
+		return true;
+	}
+
 	/******************************************************************/
 
 	class GSDumpRaw final : public GSDumpFile
@@ -586,11 +856,15 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		bool Seek(u64 offset) override;
 	};
 
 	GSDumpRaw::GSDumpRaw() = default;
 
-	GSDumpRaw::~GSDumpRaw() = default;
+	GSDumpRaw::~GSDumpRaw()
+	{
+		StopReadThread();
+	}
 
 	bool GSDumpRaw::Open(FileSystem::ManagedCFilePtr fp, Error* error)
 	{
@@ -613,6 +887,11 @@ namespace
 
 		return ret;
 	}
+
+	bool GSDumpRaw::Seek(u64 offset)
+	{
+		return (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(offset), SEEK_SET) == 0);
+	}
 } // namespace
 
 /******************************************************************/
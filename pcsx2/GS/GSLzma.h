@@ -4,9 +4,15 @@
 #pragma once
 
 #include "common/FileSystem.h"
+#include "common/HeapArray.h"
 
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 class Error;
@@ -288,7 +294,6 @@ public:
 	};
 
 	using ByteArray = std::vector<u8>;
-	using GSDataArray = std::vector<GSData>;
 
 	virtual ~GSDumpFile();
 
@@ -300,29 +305,94 @@ public:
 
 	__fi const ByteArray& GetRegsData() const { return m_regs_data; }
 	__fi const ByteArray& GetStateData() const { return m_state_data; }
-	__fi const GSDataArray& GetPackets() const { return m_dump_packets; }
 
+	/// Number of frames and packets in the dump. Zero when the dump has no index, until it's been played through once.
+	__fi u32 GetFrameCount() const { return m_frame_count; }
+	__fi u32 GetPacketCount() const { return m_packet_count; }
+
+	/// Frame and packet number of the packet which GetNextPacket() will return.
+	__fi u32 GetCurrentFrame() const { return m_current_frame; }
+	__fi u32 GetCurrentPacket() const { return m_current_packet; }
+
+	/// Reads the header, and starts decompressing packets in the background.
 	bool ReadFile(Error* error);
 
+	/// Returns the next packet, or nullptr at the end of the dump. The data is valid until the next call.
+	const GSData* GetNextPacket();
+
+	/// Moves playback to the first packet after the given number of vsyncs, zero being the start of the dump.
+	bool SeekToFrame(u32 frame);
+
 protected:
+	struct SeekPoint
+	{
+		u64 stream_offset;
+		u32 frame;
+		u32 packet;
+	};
+
 	GSDumpFile();
 
 	virtual bool Open(FileSystem::ManagedCFilePtr fp, Error* error) = 0;
 	virtual bool IsEof() = 0;
 	virtual size_t Read(void* ptr, size_t size) = 0;
 
+	/// Repositions the decompressed stream, so the next Read() returns data from that offset.
+	virtual bool Seek(u64 offset) = 0;
+
+	/// For formats with an index, makes the given position available to SeekToFrame().
+	void AddIndexedSeekPoint(const SeekPoint& point, u32 num_frames, u32 num_packets);
+
+	/// Must be called by subclass destructors, since the read thread calls back into them.
+	void StopReadThread();
+
 protected:
 	FileSystem::ManagedCFilePtr m_fp;
 
 private:
+	static constexpr u32 NUM_READ_BUFFERS = 4;
+	static constexpr size_t READ_BUFFER_SIZE = 4 * _1mb;
+
+	// Record somewhere to come back to every so many frames when there's no index.
+	static constexpr u32 SEEK_POINT_INTERVAL = 256;
+
+	void StartReadThread();
+	void ReadThreadEntryPoint();
+	bool NextReadBuffer();
+	bool ReadStream(void* ptr, size_t size);
+	const u8* ReadStreamData(size_t size);
+
 	std::string m_serial;
 	u32 m_crc = 0;
 
 	std::vector<u8> m_regs_data;
 	std::vector<u8> m_state_data;
+
+	// Decompressed data is handed over from the read thread in fixed size buffers.
+	std::thread m_read_thread;
+	std::mutex m_read_mutex;
+	std::condition_variable m_read_cv;
+	std::array<DynamicHeapArray<u8, 64>, NUM_READ_BUFFERS> m_read_buffers;
+	std::array<size_t, NUM_READ_BUFFERS> m_read_buffer_sizes = {};
+	std::deque<u32> m_filled_buffers;
+	std::vector<u32> m_free_buffers;
+	bool m_read_thread_done = false;
+	bool m_read_thread_stop = false;
+
+	s32 m_current_buffer = -1;
+	size_t m_current_buffer_pos = 0;
+	u64 m_stream_pos = 0;
+
+	GSData m_packet = {};
 	std::vector<u8> m_packet_data;
+	u32 m_current_frame = 0;
+	u32 m_current_packet = 0;
+	u32 m_frame_count = 0;
+	u32 m_packet_count = 0;
+	bool m_at_frame_start = true;
 
-	GSDataArray m_dump_packets;
+	std::vector<SeekPoint> m_seek_points;
+	bool m_has_index = false;
 };
 
 // Initializes CRC tables used by LZMA SDK.
@@ -22,6 +22,18 @@ public:
 		SyncPoint,
 		Barriers,
 		RenderPasses,
+		MergedDraws, // flushes skipped because the changed registers didn't affect the draw
+		PipelineMisses, // draws which had to create a new pipeline/shader on the HW renderers
+		TextureCreates, // surfaces which couldn't be satisfied from the device's texture pool
+		GPUTimeConversion, // milliseconds of GPU time per GSDevice::GPUTimingCategory, same order
+		GPUTimeDraw,
+		GPUTimeShuffle,
+		GPUTimeReadback,
+		GPUTimePostProcess,
+		GPUTimePresent,
+		RingHeapOrphans, // SW vertex heap buffers replaced because a quadrant was still in use
+		ShuffleDraws, // channel/texture shuffle draws which were rendered on the HW renderers
+		ShuffleDrawsSkipped, // shuffle draws folded into an earlier draw of the same sequence
 		CounterLast,
 
 		// Reused counters for HW.
@@ -3,7 +3,12 @@
 
 #include "GSPng.h"
 #include "GSExtra.h"
+#include "common/Console.h"
 #include "common/FileSystem.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <zlib.h>
 #include <png.h>
 
@@ -112,8 +117,8 @@ namespace GSPng
 		return SaveFile(filename, fmt, image, row.get(), w, h, pitch, compression);
 	}
 
-	Transaction::Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression)
-		: m_fmt(fmt), m_file(file), m_w(w), m_h(h), m_pitch(pitch), m_compression(compression)
+	Transaction::Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped)
+		: m_fmt(fmt), m_file(file), m_w(w), m_h(h), m_pitch(pitch), m_compression(compression), m_rb_swapped(rb_swapped)
 	{
 		// Note: yes it would be better to use shared pointer
 		m_image = (u8*)_aligned_malloc(pitch * h, 32);
@@ -129,7 +134,41 @@ namespace GSPng
 
 	void Process(std::shared_ptr<Transaction>& item)
 	{
-		Save(item->m_fmt, item->m_file, item->m_image, item->m_w, item->m_h, item->m_pitch, item->m_compression);
+		if (!item->m_image || !Save(item->m_fmt, item->m_file, item->m_image, item->m_w, item->m_h, item->m_pitch, item->m_compression, item->m_rb_swapped))
+			Console.Error("GSPng: Failed to save '%s'.", item->m_file.c_str());
+	}
+
+	static constexpr u32 MAX_WORKERS = 4;
+	static std::mutex s_workers_mutex;
+	static std::vector<std::unique_ptr<Worker>> s_workers;
+	static u32 s_next_worker = 0;
+
+	bool SaveAsync(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped)
+	{
+		std::shared_ptr<Transaction> item = std::make_shared<Transaction>(fmt, file, image, w, h, pitch, compression, rb_swapped);
+		if (!item->m_image)
+			return false;
+
+		std::unique_lock lock(s_workers_mutex);
+		if (s_workers.empty())
+		{
+			// Leave half the cores for the emulator itself.
+			const u32 num_workers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_WORKERS);
+			for (u32 i = 0; i < num_workers; i++)
+				s_workers.push_back(std::make_unique<Worker>(nullptr, Process, nullptr));
+		}
+
+		// Round robin, each worker blocks the caller once its own queue is full.
+		s_workers[s_next_worker]->Push(item);
+		s_next_worker = (s_next_worker + 1) % static_cast<u32>(s_workers.size());
+		return true;
+	}
+
+	void WaitForPendingSaves()
+	{
+		std::unique_lock lock(s_workers_mutex);
+		for (const std::unique_ptr<Worker>& worker : s_workers)
+			worker->Wait();
 	}
 
 } // namespace GSPng
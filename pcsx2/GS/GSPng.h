@@ -30,13 +30,21 @@ namespace GSPng
 		int m_h;
 		int m_pitch;
 		int m_compression;
+		bool m_rb_swapped;
 
-		Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression);
+		Transaction(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped = false);
 		~Transaction();
 	};
 
 	bool Save(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped = false);
 
+	/// Copies the image and compresses it on a background worker, so the caller's buffer can be released straight away.
+	/// Only blocks when every worker's queue is full.
+	bool SaveAsync(GSPng::Format fmt, const std::string& file, const u8* image, int w, int h, int pitch, int compression, bool rb_swapped = false);
+
+	/// Waits for all images queued with SaveAsync() to be written.
+	void WaitForPendingSaves();
+
 	void Process(std::shared_ptr<Transaction>& item);
 
 	using Worker = GSJobQueue<std::shared_ptr<Transaction>, 16>;
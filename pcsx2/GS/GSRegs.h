@@ -69,6 +69,8 @@ enum GIF_REG_COMPLEX
 {
 	GIF_REG_STQRGBAXYZF2 = 0x00,
 	GIF_REG_STQRGBAXYZ2 = 0x01,
+	GIF_REG_RGBAXYZF2 = 0x02,
+	GIF_REG_RGBAXYZ2 = 0x03,
 };
 
 enum GIF_A_D_REG
@@ -1109,7 +1111,9 @@ struct alignas(32) GIFPath
 		TYPE_UNKNOWN,
 		TYPE_ADONLY,
 		TYPE_STQRGBAXYZF2,
-		TYPE_STQRGBAXYZ2
+		TYPE_STQRGBAXYZ2,
+		TYPE_RGBAXYZF2,
+		TYPE_RGBAXYZ2
 	};
 
 	__forceinline void SetTag(const void* mem)
@@ -1150,6 +1154,11 @@ struct alignas(32) GIFPath
 					case 1:
 						break;
 					case 2:
+						// untextured geometry
+						if (regs.U32[0] == 0x00000401)
+							type = TYPE_RGBAXYZF2;
+						if (regs.U32[0] == 0x00000501)
+							type = TYPE_RGBAXYZ2;
 						break;
 					case 3:
 						// many games, TODO: formats mixed with NOPs (xeno2: 040f010f02, 04010f020f, mgs3: 04010f0f02, 0401020f0f, 04010f020f)
@@ -1161,6 +1170,18 @@ struct alignas(32) GIFPath
 						// TODO: common types with UV instead
 						break;
 					case 4:
+						if (regs.U32[0] == 0x04010401)
+						{
+							type = TYPE_RGBAXYZF2;
+							nreg = 2;
+							nloop *= 2;
+						}
+						if (regs.U32[0] == 0x05010501)
+						{
+							type = TYPE_RGBAXYZ2;
+							nreg = 2;
+							nloop *= 2;
+						}
 						break;
 					case 5:
 						break;
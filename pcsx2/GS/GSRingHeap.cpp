@@ -172,49 +172,66 @@ constexpr size_t GSRingHeap::MIN_ALIGN;
 
 GSRingHeap::GSRingHeap()
 {
-	m_current_buffer = Buffer::make(14); // Start with 64k buffer
+	// Start with 64k buffers
+	for (Buffer*& buffer : m_current_buffer)
+		buffer = Buffer::make(14);
 }
 
 GSRingHeap::~GSRingHeap() noexcept
 {
-	orphanBuffer();
+	orphanBuffer(SIZE_CLASS_SMALL);
+	orphanBuffer(SIZE_CLASS_LARGE);
 }
 
-void GSRingHeap::orphanBuffer() noexcept
+GSRingHeap::Stats GSRingHeap::GetStats() const
 {
-	m_current_buffer->decref(1);
+	Stats stats = m_stats;
+	for (size_t i = 0; i < SIZE_CLASS_COUNT; i++)
+		stats.ring_size[i] = m_current_buffer[i]->m_size;
+	return stats;
+}
+
+void GSRingHeap::orphanBuffer(SizeClass size_class) noexcept
+{
+	m_current_buffer[size_class]->decref(1);
 }
 
 void* GSRingHeap::alloc_internal(size_t size, size_t align_mask, size_t prefix_size)
 {
 	prefix_size += sizeof(Buffer*); // Add space for a pointer to the buffer
 	size_t total_size = size + prefix_size;
+	const SizeClass size_class = (total_size <= SMALL_ALLOC_LIMIT) ? SIZE_CLASS_SMALL : SIZE_CLASS_LARGE;
+	Buffer*& current = m_current_buffer[size_class];
+
+	m_stats.allocations++;
 
-	if (total_size <= (m_current_buffer->m_size / 2)) [[likely]]
+	if (total_size <= (current->m_size / 2)) [[likely]]
 	{
-		if (void* ptr = m_current_buffer->alloc(size, align_mask, prefix_size))
+		if (void* ptr = current->alloc(size, align_mask, prefix_size))
 		{
 			Buffer** bptr = static_cast<Buffer**>(ptr);
-			*bptr = m_current_buffer;
+			*bptr = current;
 			return bptr + 1;
 		}
-		else if (IsDevBuild)
+
+		m_stats.orphans++;
+
+		size_t total = current->m_size;
+		size_t used = current->m_amt_allocated.load(std::memory_order_relaxed) - 1;
+		if (used * 4 < total)
 		{
-			size_t total = m_current_buffer->m_size;
+			m_stats.low_usage_orphans++;
+
 			size_t mb = 1024 * 1024;
-			if (total >= mb)
+			if (IsDevBuild && total >= mb)
 			{
-				size_t used = m_current_buffer->m_amt_allocated.load(std::memory_order_relaxed) - 1;
-				if (used * 4 < total)
-				{
-					fprintf(stderr, "GSRingHeap: Orphaning %zumb buffer with low usage of %d%%, check that allocations are actually being deallocated approximately in order\n", total / mb, static_cast<int>((used * 100) / total));
-				}
+				fprintf(stderr, "GSRingHeap: Orphaning %zumb buffer with low usage of %d%%, check that allocations are actually being deallocated approximately in order\n", total / mb, static_cast<int>((used * 100) / total));
 			}
 		}
 	}
 
 	// Couldn't allocate, orphan buffer and make a new one
-	int shift = m_current_buffer->m_quadrant_shift;
+	int shift = current->m_quadrant_shift;
 	do
 	{
 		shift++;
@@ -226,14 +243,17 @@ void* GSRingHeap::alloc_internal(size_t size, size_t align_mask, size_t prefix_s
 		fprintf(stderr, "GSRingHeap: Refusing to grow to %umb\n", 4u << (shift - 20));
 		shift--;
 	}
+	if (shift > current->m_quadrant_shift)
+		m_stats.grows++;
+
 	Buffer* new_buffer = Buffer::make(shift);
-	orphanBuffer();
-	m_current_buffer = new_buffer;
-	void* ptr = m_current_buffer->alloc(size, align_mask, prefix_size);
+	orphanBuffer(size_class);
+	current = new_buffer;
+	void* ptr = current->alloc(size, align_mask, prefix_size);
 	pxAssert(ptr && "Fresh buffer failed to allocate!");
 
 	Buffer** bptr = static_cast<Buffer**>(ptr);
-	*bptr = m_current_buffer;
+	*bptr = current;
 	return bptr + 1;
 }
 
@@ -16,12 +16,44 @@
 /// - Other threads read from allocations (once shared, no one writes)
 /// - Any thread can free
 /// - Frees are done in approximately the same order as allocations (but not exactly the same order)
+/// Small and large allocations are served from separate rings, so a long-lived vertex buffer
+/// doesn't hold up the quadrant that the small per-draw allocations want to reuse (or vice versa).
 class GSRingHeap
 {
+public:
+	/// Counters for the producer thread, cumulative since the heap was created
+	struct Stats
+	{
+		/// Number of allocations made
+		uint64_t allocations;
+		/// Number of times a buffer had to be replaced because the next quadrant was still in use
+		uint64_t orphans;
+		/// Orphans where less than a quarter of the buffer was actually allocated,
+		/// which usually means allocations aren't being freed in order
+		uint64_t low_usage_orphans;
+		/// Number of times a ring was replaced with a larger buffer
+		uint64_t grows;
+		/// Current size of each ring in bytes
+		size_t ring_size[2];
+	};
+
+private:
 	struct Buffer;
-	Buffer* m_current_buffer;
 
-	void orphanBuffer() noexcept;
+	enum SizeClass : uint32_t
+	{
+		SIZE_CLASS_SMALL,
+		SIZE_CLASS_LARGE,
+		SIZE_CLASS_COUNT,
+	};
+
+	/// Allocations up to this size (including headers) go to the small ring
+	static constexpr size_t SMALL_ALLOC_LIMIT = 4096;
+
+	Buffer* m_current_buffer[SIZE_CLASS_COUNT];
+	Stats m_stats = {};
+
+	void orphanBuffer(SizeClass size_class) noexcept;
 	/// Allocate a value of `size` bytes with `prefix_size` bytes before it (for allocation tracking) and alignment specified by `align_mask`
 	void* alloc_internal(size_t size, size_t align_mask, size_t prefix_size);
 	/// Free a value of size `size` (equal to prefix_size + size when allocated)
@@ -39,6 +71,9 @@ public:
 	GSRingHeap();
 	~GSRingHeap() noexcept;
 
+	/// Returns the allocation counters, only meaningful on the producer thread
+	Stats GetStats() const;
+
 	/// Allocate a piece of memory with the given size and alignment
 	void* alloc(size_t size, size_t align)
 	{
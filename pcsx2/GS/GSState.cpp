@@ -150,6 +150,10 @@ void GSState::Reset(bool hardware_reset)
 {
 	Flush(GSFlushReason::RESET);
 
+	// Dumps can't replay a reset, so the replay buffer has to start again from the next keyframe.
+	if (m_dump_replay_buffer)
+		m_dump_replay_buffer->Clear();
+
 	// FIXME: bios logo not shown cut in half after reset, missing graphics in GoW after first FMV
 	memset(&m_path, 0, sizeof(m_path));
 	memset(&m_v, 0, sizeof(m_v));
@@ -217,7 +221,9 @@ void GSState::SetPrimHandlers()
 	m_fpGIFRegHandlerXYZ[P][2] = &GSState::GIFRegHandlerXYZ2<P, 0, auto_flush>; \
 	m_fpGIFRegHandlerXYZ[P][3] = &GSState::GIFRegHandlerXYZ2<P, 1, auto_flush>; \
 	m_fpGIFPackedRegHandlerSTQRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush>; \
-	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush>;
+	m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush>; \
+	m_fpGIFPackedRegHandlerRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerRGBAXYZF2<P, auto_flush>; \
+	m_fpGIFPackedRegHandlerRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerRGBAXYZ2<P, auto_flush>;
 
 	SetHandlerXYZ(GS_POINTLIST, true);
 	SetHandlerXYZ(GS_LINELIST, auto_flush);
@@ -1015,6 +1021,72 @@ void GSState::GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, u32
 	m_q = r[-3].STQ.Q; // remember the last one, STQ outputs this to the temp Q each time
 }
 
+template <u32 prim, bool auto_flush>
+void GSState::GIFPackedRegHandlerRGBAXYZF2(const GIFPackedReg* RESTRICT r, u32 size)
+{
+	pxAssert(size > 0 && size % 2 == 0);
+
+	CheckFlushes();
+
+	// ST, Q and UV stay the same for the whole run, RGBA outputs the temp Q each time (see GIFPackedRegHandlerRGBA)
+	const GSVector4i st = GSVector4i::loadl(&m_v.ST);
+	const GSVector4i q = GSVector4i::cast(GSVector4(m_q));
+	const GSVector4i uv = GSVector4i::load((int)m_v.UV);
+	const GSVector4i zf_mask = GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+
+	const GIFPackedReg* RESTRICT r_end = r + size;
+
+	while (r < r_end)
+	{
+		const GSVector4i rgba = (GSVector4i::load<false>(&r[0]) & GSVector4i::x000000ff()).ps32().pu16();
+
+		m_v.m[0] = st.upl64(rgba.upl32(q)); // TODO: only store the last one
+
+		GSVector4i xy = GSVector4i::loadl(&r[1].U64[0]);
+		GSVector4i zf = GSVector4i::loadl(&r[1].U64[1]);
+		xy = xy.upl16(xy.srl<4>()).upl32(uv);
+		zf = zf.srl32<4>() & zf_mask;
+
+		m_v.m[1] = xy.upl32(zf); // TODO: only store the last one
+
+		VertexKick<prim, auto_flush>(r[1].XYZF2.Skip());
+
+		r += 2;
+	}
+}
+
+template <u32 prim, bool auto_flush>
+void GSState::GIFPackedRegHandlerRGBAXYZ2(const GIFPackedReg* RESTRICT r, u32 size)
+{
+	pxAssert(size > 0 && size % 2 == 0);
+
+	CheckFlushes();
+
+	// ST, Q and UV stay the same for the whole run, RGBA outputs the temp Q each time (see GIFPackedRegHandlerRGBA)
+	const GSVector4i st = GSVector4i::loadl(&m_v.ST);
+	const GSVector4i q = GSVector4i::cast(GSVector4(m_q));
+	const GSVector4i uv = GSVector4i::loadl(&m_v.UV);
+
+	const GIFPackedReg* RESTRICT r_end = r + size;
+
+	while (r < r_end)
+	{
+		const GSVector4i rgba = (GSVector4i::load<false>(&r[0]) & GSVector4i::x000000ff()).ps32().pu16();
+
+		m_v.m[0] = st.upl64(rgba.upl32(q)); // TODO: only store the last one
+
+		const GSVector4i xy = GSVector4i::loadl(&r[1].U64[0]);
+		const GSVector4i z = GSVector4i::loadl(&r[1].U64[1]);
+		const GSVector4i xyz = xy.upl16(xy.srl<4>()).upl32(z);
+
+		m_v.m[1] = xyz.upl64(uv); // TODO: only store the last one
+
+		VertexKick<prim, auto_flush>(r[1].XYZ2.Skip());
+
+		r += 2;
+	}
+}
+
 void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, u32 size)
 {
 }
@@ -1870,6 +1942,45 @@ void GSState::FlushWrite()
 		m_env.TRXDIR.XDIR = 3;
 }
 
+// Helpers for TestDrawChanged(), which return true if a register change affects how the pending draw renders.
+// Games often rewrite these between small sprites with values which only differ in unused fields.
+static bool TEX1ChangeAffectsDraw(const GIFRegTEX1& prev, const GIFRegTEX1& next)
+{
+	// MXL, MMAG and MMIN always matter.
+	constexpr u64 filter_mask = 0x1FCull;
+	if ((prev.U64 ^ next.U64) & filter_mask)
+		return true;
+
+	// Without mipmapping, and the same filter either side of the LOD threshold, the LOD parameters are unused.
+	return (prev.MXL != 0 || prev.MMIN > 1 || prev.MMAG != prev.MMIN);
+}
+
+static bool CLAMPChangeAffectsDraw(const GIFRegCLAMP& prev, const GIFRegCLAMP& next)
+{
+	// The min/max values are only used by the region clamp/repeat modes.
+	u64 mask = 0xFull;
+	if (prev.WMS >= CLAMP_REGION_CLAMP)
+		mask |= 0x0000000000FFFFF0ull;
+	if (prev.WMT >= CLAMP_REGION_CLAMP)
+		mask |= 0x00000FFFFF000000ull;
+
+	return ((prev.U64 ^ next.U64) & mask) != 0;
+}
+
+static bool ALPHAChangeAffectsDraw(const GIFRegALPHA& prev, const GIFRegALPHA& next)
+{
+	// FIX is only used when C selects it.
+	const u64 mask = (prev.C == 2) ? ~0ull : 0xFFull;
+	return ((prev.U64 ^ next.U64) & mask) != 0;
+}
+
+static bool TEXAChangeAffectsDraw(const GIFRegTEX0& TEX0)
+{
+	// TEXA is only used to expand 24/16-bit texels, or 16-bit palette entries.
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	return (psm.pal > 0) ? (TEX0.CPSM != PSMCT32) : (psm.fmt != GSLocalMemory::PSM_FMT_32);
+}
+
 // This function decides if the context has changed in a way which warrants flushing the draw.
 inline bool GSState::TestDrawChanged()
 {
@@ -1896,14 +2007,29 @@ inline bool GSState::TestDrawChanged()
 	if ((m_dirty_gs_regs & ((1 << DIRTY_REG_TEST) | (1 << DIRTY_REG_SCISSOR) | (1 << DIRTY_REG_XYOFFSET) | (1 << DIRTY_REG_SCANMSK) | (1 << DIRTY_REG_DTHE))) || ((m_dirty_gs_regs & (1 << DIRTY_REG_DIMX)) && m_prev_env.DTHE.DTHE))
 		return true;
 
-	if (m_prev_env.PRIM.ABE && (m_dirty_gs_regs & ((1 << DIRTY_REG_ALPHA) | (1 << DIRTY_REG_PABE))))
-		return true;
+	const int context = m_prev_env.PRIM.CTXT;
+	const GSDrawingContext& ctx = m_prev_env.CTXT[context];
+	const GSDrawingContext& next_ctx = m_env.CTXT[context];
+
+	// Set when a dirty register turned out to make no difference, so the draws get merged.
+	bool merged = false;
+
+	if (m_prev_env.PRIM.ABE)
+	{
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_PABE))
+			return true;
+
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_ALPHA))
+		{
+			if (ALPHAChangeAffectsDraw(ctx.ALPHA, next_ctx.ALPHA))
+				return true;
+
+			merged = true;
+		}
+	}
 
 	if (m_prev_env.PRIM.FGE && (m_dirty_gs_regs & (1 << DIRTY_REG_FOGCOL)))
 		return true;
-
-	const int context = m_prev_env.PRIM.CTXT;
-	const GSDrawingContext& ctx = m_prev_env.CTXT[context];
 	// If the frame is getting updated check the FRAME, otherwise, we can ignore it
 	if ((ctx.TEST.ATST != ATST_NEVER) || !ctx.TEST.ATE || (ctx.TEST.AFAIL & 1) || ctx.TEST.DATE)
 	{
@@ -1919,13 +2045,40 @@ inline bool GSState::TestDrawChanged()
 
 	if (m_prev_env.PRIM.TME)
 	{
-		if (m_dirty_gs_regs & ((1 << DIRTY_REG_TEX0) | (1 << DIRTY_REG_TEX1) | (1 << DIRTY_REG_CLAMP) | (1 << DIRTY_REG_TEXA)))
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_TEX0))
 			return true;
 
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_TEX1))
+		{
+			if (TEX1ChangeAffectsDraw(ctx.TEX1, next_ctx.TEX1))
+				return true;
+
+			merged = true;
+		}
+
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_CLAMP))
+		{
+			if (CLAMPChangeAffectsDraw(ctx.CLAMP, next_ctx.CLAMP))
+				return true;
+
+			merged = true;
+		}
+
+		if (m_dirty_gs_regs & (1 << DIRTY_REG_TEXA))
+		{
+			if (TEXAChangeAffectsDraw(ctx.TEX0))
+				return true;
+
+			merged = true;
+		}
+
 		if(ctx.TEX1.MXL > 0 && (m_dirty_gs_regs & ((1 << DIRTY_REG_MIPTBP1) | (1 << DIRTY_REG_MIPTBP2))))
 			return true;
 	}
 
+	if (merged)
+		g_perfmon.Put(GSPerfMon::MergedDraws, 1);
+
 	m_dirty_gs_regs = 0;
 
 	return false;
@@ -2675,6 +2828,8 @@ void GSState::ReadFIFO(u8* mem, int size)
 
 	if (m_dump)
 		m_dump->ReadFIFO(size / 16);
+	if (m_dump_replay_buffer)
+		m_dump_replay_buffer->ReadFIFO(size / 16);
 }
 
 void GSState::ReadLocalMemoryUnsync(u8* mem, int qwc, GIFRegBITBLTBUF BITBLTBUF, GIFRegTRXPOS TRXPOS, GIFRegTRXREG TRXREG)
@@ -2819,6 +2974,18 @@ void GSState::Transfer(const u8* mem, u32 size)
 
 								mem += total * sizeof(GIFPackedReg);
 
+								break;
+							case GIFPath::TYPE_RGBAXYZF2:
+								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZF2])((GIFPackedReg*)mem, total);
+
+								mem += total * sizeof(GIFPackedReg);
+
+								break;
+							case GIFPath::TYPE_RGBAXYZ2:
+								(this->*m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZ2])((GIFPackedReg*)mem, total);
+
+								mem += total * sizeof(GIFPackedReg);
+
 								break;
 							default:
 								ASSUME(0);
@@ -2901,6 +3068,8 @@ void GSState::Transfer(const u8* mem, u32 size)
 
 	if (m_dump && mem > start)
 		m_dump->Transfer(index, start, mem - start);
+	if (m_dump_replay_buffer && mem > start)
+		m_dump_replay_buffer->Transfer(index, start, mem - start);
 
 	if (index == 0)
 	{
@@ -3209,6 +3378,8 @@ void GSState::UpdateVertexKick()
 
 	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = m_fpGIFPackedRegHandlerSTQRGBAXYZF2[prim];
 	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2] = m_fpGIFPackedRegHandlerSTQRGBAXYZ2[prim];
+	m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZF2] = m_fpGIFPackedRegHandlerRGBAXYZF2[prim];
+	m_fpGIFPackedRegHandlersC[GIF_REG_RGBAXYZ2] = m_fpGIFPackedRegHandlerRGBAXYZ2[prim];
 }
 
 void GSState::GrowVertexBuffer()
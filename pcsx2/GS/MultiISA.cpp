@@ -44,7 +44,9 @@ static ProcessorFeatures::VectorISA getCurrentISA()
 		return ProcessorFeatures::VectorISA::SSE4;
 	if (!cpuinfo_has_x86_avx2())
 		return ProcessorFeatures::VectorISA::AVX;
-	if (!cpuinfo_has_x86_avx512f())
+	// The AVX-512 tier is built for x86-64-v4 (F/BW/VL/DQ/CD), not just the foundation subset
+	if (!cpuinfo_has_x86_avx512f() || !cpuinfo_has_x86_avx512bw() || !cpuinfo_has_x86_avx512vl() ||
+		!cpuinfo_has_x86_avx512dq() || !cpuinfo_has_x86_avx512cd())
 		return ProcessorFeatures::VectorISA::AVX2;
 	return ProcessorFeatures::VectorISA::AVX512F;
 }
@@ -76,7 +78,7 @@ static ProcessorFeatures getProcessorFeatures()
 		features.hasSlowGather = over[0] == 'Y' || over[0] == 'y' || over[0] == '1';
 		fprintf(stderr, "Processor gather override: %s\n", features.hasSlowGather ? "Slow" : "Fast");
 	}
-	else if (features.vectorISA == ProcessorFeatures::VectorISA::AVX2)
+	else if (features.vectorISA >= ProcessorFeatures::VectorISA::AVX2)
 	{
 		if (cpuinfo_get_cores_count() > 0 && cpuinfo_get_core(0)->vendor == cpuinfo_vendor_intel)
 		{
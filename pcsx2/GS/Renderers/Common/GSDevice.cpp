@@ -4,7 +4,11 @@
 #include "GS/Renderers/Common/GSDevice.h"
 #include "GS/GSGL.h"
 #include "GS/GS.h"
+#include "GS/GSPerfMon.h"
+#include "GS/GSXXH.h"
 #include "Host.h"
+#include "ShaderCacheVersion.h"
+#include "VMManager.h"
 
 #include "common/Console.h"
 #include "common/BitUtils.h"
@@ -18,6 +22,7 @@
 #include "imgui.h"
 
 #include <algorithm>
+#include <bit>
 
 int SetDATMShader(SetDATM datm)
 {
@@ -71,6 +76,7 @@ const char* shaderName(ShaderConvert value)
 		case ShaderConvert::RGB5A1_TO_8I:           return "ps_convert_rgb5a1_8i";
 		case ShaderConvert::CLUT_4:                 return "ps_convert_clut_4";
 		case ShaderConvert::CLUT_8:                 return "ps_convert_clut_8";
+		case ShaderConvert::UNSWIZZLE_CT32:         return "ps_unswizzle_ct32";
 		case ShaderConvert::YUV:                    return "ps_yuv";
 			// clang-format on
 		default:
@@ -220,7 +226,7 @@ GSDevice::GSDevice()
 GSDevice::~GSDevice()
 {
 	// should've been cleaned up in Destroy()
-	pxAssert(m_pool[0].empty() && m_pool[1].empty() && !m_merge && !m_weavebob && !m_blend && !m_mad && !m_target_tmp && !m_cas);
+	pxAssert(m_pool[0].count == 0 && m_pool[1].count == 0 && !m_merge && !m_weavebob && !m_blend && !m_mad && !m_target_tmp && !m_cas);
 }
 
 const char* GSDevice::RenderAPIToString(RenderAPI api)
@@ -331,10 +337,149 @@ bool GSDevice::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 
 void GSDevice::Destroy()
 {
+	m_pipeline_usage.Close();
 	ClearCurrent();
 	PurgePool();
 }
 
+void GSDevice::OpenPipelineUsageList(const char* api_name, u32 selector_size)
+{
+	XXH3_state_t state;
+	XXH3_64bits_reset(&state);
+	GSXXH3_64bits_update(&state, m_name.data(), m_name.size());
+	GSXXH3_64bits_update(&state, &m_features, sizeof(m_features));
+	m_pipeline_usage.Open(api_name, selector_size, GSXXH3_64bits_digest(&state));
+}
+
+void GSDevice::ReloadPipelineUsageList()
+{
+	m_pipeline_usage.Reopen();
+}
+
+GSPipelineUsageList::GSPipelineUsageList() = default;
+
+GSPipelineUsageList::~GSPipelineUsageList() = default;
+
+#pragma pack(push, 1)
+struct PipelineUsageListHeader
+{
+	u32 magic;
+	u32 version;
+	u32 shader_cache_version;
+	u32 selector_size;
+	u64 compat_hash;
+	u32 num_selectors;
+	u32 pad;
+};
+#pragma pack(pop)
+
+static constexpr u32 PIPELINE_USAGE_LIST_MAGIC = 0x4C505350; // PSPL
+static constexpr u32 PIPELINE_USAGE_LIST_VERSION = 1;
+
+// Stops a game which generates pipelines endlessly (e.g. from bad state) from growing the list forever.
+static constexpr u32 MAX_PIPELINE_USAGE_LIST_SELECTORS = 32768;
+
+void GSPipelineUsageList::Open(const char* api_name, u32 selector_size, u64 compat_hash)
+{
+	Close();
+
+	m_api_name = api_name;
+	m_selector_size = selector_size;
+	m_compat_hash = compat_hash;
+
+	// Nothing to key off while sitting in the BIOS, and pointless if the shaders are not cached either.
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetDiscCRC();
+	if (GSConfig.DisableShaderCache || (serial.empty() && crc == 0))
+		return;
+
+	m_path = Path::Combine(EmuFolders::Cache, fmt::format("pipelines_{}_{}_{:08X}.bin", api_name, serial, crc));
+
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(m_path.c_str());
+	if (!data.has_value() || data->size() < sizeof(PipelineUsageListHeader))
+		return;
+
+	PipelineUsageListHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != PIPELINE_USAGE_LIST_MAGIC || header.version != PIPELINE_USAGE_LIST_VERSION ||
+		header.shader_cache_version != SHADER_CACHE_VERSION || header.selector_size != selector_size ||
+		header.compat_hash != compat_hash || header.num_selectors > MAX_PIPELINE_USAGE_LIST_SELECTORS ||
+		(data->size() - sizeof(header)) != (static_cast<size_t>(header.num_selectors) * selector_size))
+	{
+		Console.Warning("GS: Discarding out of date pipeline usage list %s", Path::GetFileName(m_path).data());
+
+		// Rewrite it on close, so we don't keep rejecting the same file.
+		m_dirty = true;
+		return;
+	}
+
+	m_selectors.assign(data->begin() + sizeof(header), data->end());
+	m_selector_hashes.reserve(header.num_selectors);
+	for (u32 i = 0; i < header.num_selectors; i++)
+		m_selector_hashes.insert(GSXXH3_64bits(&m_selectors[i * selector_size], selector_size));
+
+	m_precompile_pos = 0;
+	m_precompile_count = header.num_selectors;
+	Console.WriteLn("GS: Loaded %u pipelines from usage list %s", header.num_selectors, Path::GetFileName(m_path).data());
+}
+
+void GSPipelineUsageList::Reopen()
+{
+	if (m_api_name.empty())
+		return;
+
+	// Open() takes the name by pointer, and clears the member we'd be passing in.
+	const std::string api_name = std::move(m_api_name);
+	Open(api_name.c_str(), m_selector_size, m_compat_hash);
+}
+
+void GSPipelineUsageList::Close()
+{
+	// Read-only caches are shared between processes, only the owner gets to update the list.
+	if (m_dirty && !m_path.empty() && !GSConfig.ReadOnlyShaderCache)
+	{
+		const PipelineUsageListHeader header = {PIPELINE_USAGE_LIST_MAGIC, PIPELINE_USAGE_LIST_VERSION,
+			SHADER_CACHE_VERSION, m_selector_size, m_compat_hash, static_cast<u32>(m_selector_hashes.size()), 0};
+
+		std::vector<u8> data(sizeof(header) + m_selectors.size());
+		std::memcpy(data.data(), &header, sizeof(header));
+		if (!m_selectors.empty())
+			std::memcpy(data.data() + sizeof(header), m_selectors.data(), m_selectors.size());
+
+		if (!FileSystem::WriteBinaryFile(m_path.c_str(), data.data(), data.size()))
+			Console.Error("GS: Failed to write pipeline usage list %s", Path::GetFileName(m_path).data());
+	}
+
+	m_path = {};
+	m_api_name = {};
+	m_selectors = {};
+	m_selector_hashes = {};
+	m_precompile_pos = 0;
+	m_precompile_count = 0;
+	m_dirty = false;
+}
+
+void GSPipelineUsageList::Record(const void* selector)
+{
+	if (m_path.empty() || m_selector_hashes.size() >= MAX_PIPELINE_USAGE_LIST_SELECTORS)
+		return;
+
+	if (!m_selector_hashes.insert(GSXXH3_64bits(selector, m_selector_size)).second)
+		return;
+
+	const u8* selector_bytes = static_cast<const u8*>(selector);
+	m_selectors.insert(m_selectors.end(), selector_bytes, selector_bytes + m_selector_size);
+	m_dirty = true;
+}
+
+const void* GSPipelineUsageList::GetNextPrecompile()
+{
+	if (m_precompile_pos >= m_precompile_count)
+		return nullptr;
+
+	return &m_selectors[(m_precompile_pos++) * m_selector_size];
+}
+
 bool GSDevice::AcquireWindow(bool recreate_window)
 {
 	std::optional<WindowInfo> wi = Host::AcquireRenderWindow(recreate_window);
@@ -351,8 +496,8 @@ bool GSDevice::AcquireWindow(bool recreate_window)
 
 bool GSDevice::ShouldSkipPresentingFrame()
 {
-	// Only needed with FIFO.
-	if (!m_allow_present_throttle || m_vsync_mode != GSVSyncMode::FIFO)
+	// Only needed with FIFO, unless the user asked for uncapped frames to be dropped anyway.
+	if (!m_allow_present_throttle || (m_vsync_mode != GSVSyncMode::FIFO && !GSConfig.ThrottleUncappedPresentation))
 		return false;
 
 	const float throttle_rate = (m_window_info.surface_refresh_rate > 0.0f) ? m_window_info.surface_refresh_rate : 60.0f;
@@ -550,12 +695,13 @@ GSTexture* GSDevice::FetchSurface(GSTexture::Type type, int width, int height, i
 {
 	const GSVector2i size(std::clamp(width, 1, static_cast<int>(g_gs_device->GetMaxTextureSize())),
 		std::clamp(height, 1, static_cast<int>(g_gs_device->GetMaxTextureSize())));
-	FastList<GSTexture*>& pool = m_pool[type != GSTexture::Type::Texture];
+	TexturePool& pool = m_pool[type != GSTexture::Type::Texture];
+	FastList<GSTexture*>& bucket = pool.buckets[GetPoolSizeClass(size)];
 
 	GSTexture* t = nullptr;
-	auto fallback = pool.end();
+	auto fallback = bucket.end();
 
-	for (auto i = pool.begin(); i != pool.end(); ++i)
+	for (auto i = bucket.begin(); i != bucket.end(); ++i)
 	{
 		t = *i;
 
@@ -566,10 +712,11 @@ GSTexture* GSDevice::FetchSurface(GSTexture::Type type, int width, int height, i
 			if (!prefer_unused_texture || t->GetLastFrameUsed() != m_frame)
 			{
 				m_pool_memory_usage -= t->GetMemUsage();
-				pool.erase(i);
+				bucket.erase(i);
+				pool.count--;
 				break;
 			}
-			else if (fallback == pool.end())
+			else if (fallback == bucket.end())
 			{
 				fallback = i;
 			}
@@ -580,12 +727,13 @@ GSTexture* GSDevice::FetchSurface(GSTexture::Type type, int width, int height, i
 
 	if (!t)
 	{
-		if (pool.size() >= ((type == GSTexture::Type::Texture) ? MAX_POOLED_TEXTURES : MAX_POOLED_TARGETS) &&
-			fallback != pool.end())
+		if (pool.count >= ((type == GSTexture::Type::Texture) ? MAX_POOLED_TEXTURES : MAX_POOLED_TARGETS) &&
+			fallback != bucket.end())
 		{
 			t = *fallback;
 			m_pool_memory_usage -= t->GetMemUsage();
-			pool.erase(fallback);
+			bucket.erase(fallback);
+			pool.count--;
 		}
 		else
 		{
@@ -602,6 +750,8 @@ GSTexture* GSDevice::FetchSurface(GSTexture::Type type, int width, int height, i
 				}
 			}
 
+			g_perfmon.Put(GSPerfMon::TextureCreates, 1);
+
 #ifdef PCSX2_DEVBUILD
 			if (GSConfig.UseDebugDevice)
 			{
@@ -645,27 +795,56 @@ void GSDevice::Recycle(GSTexture* t)
 
 	t->SetLastFrameUsed(m_frame);
 
-	FastList<GSTexture*>& pool = m_pool[!t->IsTexture()];
-	pool.push_front(t);
+	TexturePool& pool = m_pool[!t->IsTexture()];
+	FastList<GSTexture*>& bucket = pool.buckets[GetPoolSizeClass(t->GetSize())];
+	bucket.push_front(t);
+	pool.count++;
 	m_pool_memory_usage += t->GetMemUsage();
 
+	// Only the bucket we just touched is trimmed, the rest get caught by AgePool() at the end of the frame.
 	const u32 max_size = t->IsTexture() ? MAX_POOLED_TEXTURES : MAX_POOLED_TARGETS;
-	const u32 max_age = t->IsTexture() ? MAX_TEXTURE_AGE : MAX_TARGET_AGE;
-	while (pool.size() > max_size)
+	if (pool.count > max_size)
+		TrimPoolBucket(pool, bucket, t->IsTexture() ? MAX_TEXTURE_AGE : MAX_TARGET_AGE);
+}
+
+u32 GSDevice::GetPoolSizeClass(const GSVector2i& size)
+{
+	// 1-16384 maps to 1-15, so every class holds dimensions within a factor of two of each other.
+	const u32 dim = static_cast<u32>(std::max(size.x, size.y));
+	return std::min(static_cast<u32>(std::bit_width(dim)), NUM_POOL_SIZE_CLASSES - 1);
+}
+
+void GSDevice::TrimPoolBucket(TexturePool& pool, FastList<GSTexture*>& bucket, u32 max_age)
+{
+	while (!bucket.empty())
 	{
-		// Don't toss when the texture was last used in this frame.
-		// Because we're going to need to keep it alive anyway.
-		GSTexture* back = pool.back();
+		// Don't toss when the texture was used recently.
+		// Because we're probably going to need it again soon.
+		GSTexture* back = bucket.back();
 		if ((m_frame - back->GetLastFrameUsed()) < max_age)
 			break;
 
 		m_pool_memory_usage -= back->GetMemUsage();
 		delete back;
 
-		pool.pop_back();
+		bucket.pop_back();
+		pool.count--;
 	}
 }
 
+bool GSDevice::SetGPUTimingBreakdownEnabled(bool enabled)
+{
+	m_gpu_timing_breakdown = false;
+	return !enabled;
+}
+
+void GSDevice::AddGPUTimingCategoryTime(GPUTimingCategory category, double ms)
+{
+	static_assert(GSPerfMon::GPUTimePresent - GSPerfMon::GPUTimeConversion ==
+				  static_cast<int>(GPUTimingCategory::Present) - static_cast<int>(GPUTimingCategory::Conversion));
+	g_perfmon.Put(static_cast<GSPerfMon::counter_t>(GSPerfMon::GPUTimeConversion + static_cast<int>(category)), ms);
+}
+
 bool GSDevice::UsesLowerLeftOrigin() const
 {
 	const RenderAPI api = GetRenderAPI();
@@ -680,28 +859,23 @@ void GSDevice::AgePool()
 	for (u32 pool_idx = 0; pool_idx < m_pool.size(); pool_idx++)
 	{
 		const u32 max_age = (pool_idx == 0) ? MAX_TEXTURE_AGE : MAX_TARGET_AGE;
-		FastList<GSTexture*>& pool = m_pool[pool_idx];
-		while (!pool.empty())
-		{
-			GSTexture* back = pool.back();
-			if ((m_frame - back->GetLastFrameUsed()) < max_age)
-				break;
-
-			m_pool_memory_usage -= back->GetMemUsage();
-			delete back;
-
-			pool.pop_back();
-		}
+		TexturePool& pool = m_pool[pool_idx];
+		for (FastList<GSTexture*>& bucket : pool.buckets)
+			TrimPoolBucket(pool, bucket, max_age);
 	}
 }
 
 void GSDevice::PurgePool()
 {
-	for (FastList<GSTexture*>& pool : m_pool)
+	for (TexturePool& pool : m_pool)
 	{
-		for (GSTexture* t : pool)
-			delete t;
-		pool.clear();
+		for (FastList<GSTexture*>& bucket : pool.buckets)
+		{
+			for (GSTexture* t : bucket)
+				delete t;
+			bucket.clear();
+		}
+		pool.count = 0;
 	}
 	m_pool_memory_usage = 0;
 }
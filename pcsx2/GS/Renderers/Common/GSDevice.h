@@ -13,6 +13,9 @@
 #include "GS/GSAlignedClass.h"
 #include "GS/GSExtra.h"
 #include <array>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 enum class ShaderConvert
 {
@@ -47,6 +50,7 @@ enum class ShaderConvert
 	RGB5A1_TO_8I,
 	CLUT_4,
 	CLUT_8,
+	UNSWIZZLE_CT32,
 	YUV,
 	Count
 };
@@ -783,6 +787,45 @@ static inline u32 GetVertexAlignment(GSHWDrawConfig::VSExpand expand)
 	}
 }
 
+/// Records the draw pipeline selectors a game creates, so they can be compiled ahead of time on the next boot,
+/// instead of hitching the first time each one is drawn. The list is stored per-game in the cache directory.
+class GSPipelineUsageList
+{
+public:
+	GSPipelineUsageList();
+	~GSPipelineUsageList();
+
+	__fi bool HasPendingPrecompiles() const { return (m_precompile_pos < m_precompile_count); }
+
+	/// Loads the usage list for the running game, writing out any previously open list first.
+	/// compat_hash should change whenever existing pipelines would no longer be valid (e.g. GPU or features).
+	void Open(const char* api_name, u32 selector_size, u64 compat_hash);
+
+	/// Reopens the list for the current game, with the parameters from the last Open() call.
+	void Reopen();
+
+	/// Writes out any newly recorded selectors, and releases the list.
+	void Close();
+
+	/// Records a selector which was compiled during emulation.
+	void Record(const void* selector);
+
+	/// Returns the next selector to precompile, or nullptr if there are none left.
+	const void* GetNextPrecompile();
+
+private:
+	std::string m_path;
+	std::string m_api_name;
+	u32 m_selector_size = 0;
+	u64 m_compat_hash = 0;
+
+	std::vector<u8> m_selectors;
+	std::unordered_set<u64> m_selector_hashes;
+	size_t m_precompile_pos = 0;
+	size_t m_precompile_count = 0;
+	bool m_dirty = false;
+};
+
 class GSDevice : public GSAlignedClass<32>
 {
 public:
@@ -802,6 +845,19 @@ public:
 		Performance
 	};
 
+	/// GPU work is attributed to one of these when the GPU time breakdown is enabled.
+	/// The order matches the GPUTime counters in GSPerfMon.
+	enum class GPUTimingCategory : u8
+	{
+		Conversion, ///< Texture cache copies, conversions and clears between draws
+		Draw,
+		Shuffle,
+		Readback,
+		PostProcess, ///< Merge, deinterlacing, shade boost, FXAA and CAS
+		Present,
+		Count
+	};
+
 	// clang-format off
 	struct FeatureSupport
 	{
@@ -872,8 +928,26 @@ protected:
 
 	u32 m_frame = 0; // for ageing the pool
 
+	GPUTimingCategory m_gpu_timing_category = GPUTimingCategory::Conversion;
+	bool m_gpu_timing_breakdown = false;
+
+	GSPipelineUsageList m_pipeline_usage;
+
 private:
-	std::array<FastList<GSTexture*>, 2> m_pool; // [texture, target]
+	// Pooled surfaces are bucketed by the larger of their dimensions, so a fetch only has to scan
+	// textures of a similar size. Each bucket is ordered most recently used first.
+	static constexpr u32 NUM_POOL_SIZE_CLASSES = 16;
+
+	struct TexturePool
+	{
+		std::array<FastList<GSTexture*>, NUM_POOL_SIZE_CLASSES> buckets;
+		u32 count = 0;
+	};
+
+	static u32 GetPoolSizeClass(const GSVector2i& size);
+	void TrimPoolBucket(TexturePool& pool, FastList<GSTexture*>& bucket, u32 max_age);
+
+	std::array<TexturePool, 2> m_pool; // [texture, target]
 	u64 m_pool_memory_usage = 0;
 
 	static const std::array<HWBlend, 3*3*3*3> m_blendMap;
@@ -887,6 +961,7 @@ protected:
 	static constexpr u32 MAX_TEXTURE_AGE = 10;
 	static constexpr u32 NUM_CAS_CONSTANTS = 12; // 8 plus src offset x/y, 16 byte alignment
 	static constexpr u32 EXPAND_BUFFER_SIZE = sizeof(u16) * 16383 * 6;
+	static constexpr double PIPELINE_PRECOMPILE_TIME_SLICE_MS = 4.0; // per presented frame
 
 	WindowInfo m_window_info;
 	GSVSyncMode m_vsync_mode = GSVSyncMode::Disabled;
@@ -904,6 +979,9 @@ protected:
 
 	bool AcquireWindow(bool recreate_window);
 
+	/// Adds the time between two breakdown timestamps to the perfmon counter for the category.
+	static void AddGPUTimingCategoryTime(GPUTimingCategory category, double ms);
+
 	virtual GSTexture* CreateSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format) = 0;
 	GSTexture* FetchSurface(GSTexture::Type type, int width, int height, int levels, GSTexture::Format format, bool clear, bool prefer_unused_texture);
 
@@ -921,6 +999,9 @@ protected:
 	/// Perform texture operations for ImGui
 	void UpdateImGuiTextures();
 
+	/// Opens the pipeline usage list for the running game, keyed on the adapter and its features.
+	void OpenPipelineUsageList(const char* api_name, u32 selector_size);
+
 public:
 	GSDevice();
 	virtual ~GSDevice();
@@ -977,6 +1058,9 @@ public:
 	virtual bool Create(GSVSyncMode vsync_mode, bool allow_present_throttle);
 	virtual void Destroy();
 
+	/// Switches the recorded pipeline usage list over to the newly-running game.
+	void ReloadPipelineUsageList();
+
 	/// Returns the graphics API used by this device.
 	virtual RenderAPI GetRenderAPI() const = 0;
 
@@ -1014,6 +1098,12 @@ public:
 	/// Returns the amount of GPU time utilized since the last time this method was called.
 	virtual float GetAndResetAccumulatedGPUTime() = 0;
 
+	/// Enables/disables timestamps between GPU work of different categories. Returns false if unsupported.
+	virtual bool SetGPUTimingBreakdownEnabled(bool enabled);
+
+	/// Attributes any GPU work recorded after this call to the specified category.
+	__fi void SetGPUTimingCategory(GPUTimingCategory category) { m_gpu_timing_category = category; }
+
 	/// Returns true if not enough time has passed for present to not block.
 	bool ShouldSkipPresentingFrame();
 
@@ -1057,6 +1147,9 @@ public:
 	/// Converts a colour format to an indexed format texture.
 	virtual void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM) = 0;
 
+	/// Unswizzles a PSMCT32/PSMCT24 texture from a 1024x1024 copy of local memory. origin is the GS coordinate of the top left of dTex.
+	virtual void UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM) = 0;
+
 	/// Uses box downsampling to resize a texture.
 	virtual void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) = 0;
 
@@ -88,3 +88,49 @@ GSVector4i GSDirtyRectList::GetDirtyRect(size_t index, GIFRegTEX0 TEX0, const GS
 	return r.rintersect(clamp);
 }
 
+// Returns true if the union of both rects doesn't cover any area outside of them.
+static bool CanMergeDirtyRects(const GSVector4i& a, const GSVector4i& b)
+{
+	const GSVector4i u = a.runion(b);
+	if (u.eq(a) || u.eq(b))
+		return true;
+
+	// Same columns with touching or overlapping rows, or the other way around.
+	if (a.xzxz().eq(b.xzxz()))
+		return (a.y <= b.w && b.y <= a.w);
+	if (a.ywyw().eq(b.ywyw()))
+		return (a.x <= b.z && b.x <= a.z);
+
+	return false;
+}
+
+void GSDirtyRectList::Coalesce()
+{
+	// The rects are never grown past what was dirtied, unaligned edges are kept on purpose, see Target::Update().
+	bool merged = (size() > 1);
+	while (merged)
+	{
+		merged = false;
+
+		for (size_t i = 0; i < size(); i++)
+		{
+			for (size_t j = i + 1; j < size();)
+			{
+				GSDirtyRect& a = (*this)[i];
+				const GSDirtyRect& b = (*this)[j];
+				if (a.psm == b.psm && a.bw == b.bw && a.rgba._u32 == b.rgba._u32 && a.req_linear == b.req_linear &&
+					CanMergeDirtyRects(a.r, b.r))
+				{
+					a.r = a.r.runion(b.r);
+					erase(begin() + j);
+					merged = true;
+				}
+				else
+				{
+					j++;
+				}
+			}
+		}
+	}
+}
+
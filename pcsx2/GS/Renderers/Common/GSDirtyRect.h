@@ -38,4 +38,7 @@ public:
 	GSVector4i GetTotalRect(GIFRegTEX0 TEX0, const GSVector2i& size) const;
 	u32 GetDirtyChannels();
 	GSVector4i GetDirtyRect(size_t index, GIFRegTEX0 TEX0, const GSVector4i& clamp, bool align) const;
+
+	/// Merges rects with the same format and channels whose union is still exactly covered by them.
+	void Coalesce();
 };
@@ -121,6 +121,25 @@ public:
 		return size() == 0;
 	}
 
+	__forceinline u16 capacity() const
+	{
+		return m_capacity;
+	}
+
+	// Bytes allocated for m_buffer and m_free_indexes_stack
+	__forceinline size_t memory_usage() const
+	{
+		return m_capacity * sizeof(Element<T>) + (m_capacity - 1) * sizeof(u16);
+	}
+
+	// Grow() never gives memory back, so release it once the list is empty again.
+	// Only empty lists are shrunk, as moving elements would invalidate the indexes callers hold on to.
+	void shrink_to_fit()
+	{
+		if (empty() && m_capacity > 4)
+			clear();
+	}
+
 	__forceinline void EraseIndex(const u16 index)
 	{
 		ListRemove(index);
@@ -23,6 +23,11 @@ size_t GSCodeReserve::GetMemoryUsed()
 	return s_memory_ptr - s_memory_base;
 }
 
+size_t GSCodeReserve::GetMemorySize()
+{
+	return s_memory_end - s_memory_base;
+}
+
 u8* GSCodeReserve::ReserveMemory(size_t size)
 {
 	pxAssert((s_memory_ptr + size) <= s_memory_end);
@@ -67,6 +67,30 @@ public:
 		return m_active->f;
 	}
 
+	/// Returns every key which has been looked up, most expensive first when draw stats are enabled.
+	std::vector<KEY> GetActiveKeys() const
+	{
+		std::vector<std::pair<KEY, const ActivePtr*>> sorted(std::begin(m_map_active), std::end(m_map_active));
+		std::stable_sort(std::begin(sorted), std::end(sorted), [](const auto& l, const auto& r){ return l.second->ticks > r.second->ticks; });
+
+		std::vector<KEY> keys;
+		keys.reserve(sorted.size());
+		for (const auto& i : sorted)
+			keys.push_back(i.first);
+
+		return keys;
+	}
+
+	/// Forgets which keys have been looked up, along with their stats.
+	void ClearActive()
+	{
+		for (auto& i : m_map_active)
+			delete i.second;
+
+		m_map_active.clear();
+		m_active = NULL;
+	}
+
 	void UpdateStats(u64 frame, u64 ticks, int actual, int total, int prims)
 	{
 		if (m_active)
@@ -142,6 +166,7 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemorySize();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
@@ -8,7 +8,9 @@
 #include "GS/GSDump.h"
 #include "GS/GSGL.h"
 #include "GS/GSPerfMon.h"
+#include "GS/GSPng.h"
 #include "GS/GSUtil.h"
+#include "DebugTools/TraceCapture.h"
 #include "GSDumpReplayer.h"
 #include "Host.h"
 #include "PerformanceMetrics.h"
@@ -510,6 +512,9 @@ void GSJoinSnapshotThreads()
 		save_thread.join();
 		lock.lock();
 	}
+	lock.unlock();
+
+	GSPng::WaitForPendingSaves();
 }
 
 bool GSRenderer::BeginPresentFrame(bool frame_skip)
@@ -613,14 +618,38 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 		}
 	}
 
-	const bool blank_frame = !Merge(field);
+	// Frameskip once the renderer can't lower the resolution any further to keep up.
+	bool dynamic_skip = false;
+	if (!skip_frame && m_present_skip_interval > 0 && !GSCapture::IsCapturingVideo())
+	{
+		if (m_present_skip_count < m_present_skip_interval)
+		{
+			m_present_skip_count++;
+			dynamic_skip = true;
+		}
+		else
+		{
+			m_present_skip_count = 0;
+		}
+	}
+
+	// Skip presentation when running uncapped while vsync is on, or throttling uncapped presentation.
+	const bool skip_present = skip_frame || dynamic_skip || g_gs_device->ShouldSkipPresentingFrame();
+
+	// When throttling, frames which won't be displayed don't need to be merged either. Local memory and the
+	// texture cache are already up to date, only the output is skipped, so keep it for anything consuming it.
+	const bool skip_merge = skip_present && !skip_frame && (dynamic_skip || GSConfig.ThrottleUncappedPresentation) &&
+	                        m_snapshot.empty() && !GSCapture::IsCapturingVideo();
+
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::PostProcess);
+	const bool blank_frame = skip_merge || !Merge(field);
 
 	m_last_draw_n = s_n;
 	m_last_transfer_n = s_transfer_n;
 
-	// Skip presentation when running uncapped while vsync is on.
-	if (skip_frame || g_gs_device->ShouldSkipPresentingFrame())
+	if (skip_present)
 	{
+		g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Present);
 		if (BeginPresentFrame(true))
 			EndPresentFrame();
 
@@ -670,6 +699,7 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 			}
 		}
 
+		g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Present);
 		if (BeginPresentFrame(false))
 		{
 			if (current && !blank_frame)
@@ -684,12 +714,18 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 			EndPresentFrame();
 
 			if (GSConfig.OsdShowGPU)
-				PerformanceMetrics::OnGPUPresent(g_gs_device->GetAndResetAccumulatedGPUTime());
+			{
+				const float gpu_time = g_gs_device->GetAndResetAccumulatedGPUTime();
+				PerformanceMetrics::OnGPUPresent(gpu_time);
+				TraceCapture::AddGPUFrame(gpu_time);
+			}
 		}
 
 		PerformanceMetrics::Update(registers_written, fb_sprite_frame, false);
 	}
 
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Conversion);
+
 	// snapshot
 	if (!m_snapshot.empty())
 	{
@@ -780,6 +816,23 @@ void GSRenderer::VSync(u32 field, bool registers_written, bool idle_frame)
 		}
 	}
 
+	// replay buffer
+	if (GSConfig.GSDumpReplayBuffer == 0 || GSDumpReplayer::IsReplayingDump())
+		m_dump_replay_buffer.reset();
+	else if (!m_dump_replay_buffer || m_dump_replay_buffer->GetLength() != GSConfig.GSDumpReplayBuffer)
+		m_dump_replay_buffer = std::make_unique<GSDumpReplayBuffer>(GSConfig.GSDumpReplayBuffer);
+
+	if (m_dump_replay_buffer && m_dump_replay_buffer->VSync(field, m_regs, GetTvRefreshRate()))
+	{
+		// Only a copy of the state here, the worker compresses it.
+		freezeData fd = {0, nullptr};
+		Freeze(&fd, true);
+		fd.data = new u8[fd.size];
+		Freeze(&fd, false);
+		m_dump_replay_buffer->AddKeyframe(VMManager::GetDiscSerial(), VMManager::GetDiscCRC(), fd, m_regs);
+		delete[] fd.data;
+	}
+
 	// capture
 	if (GSCapture::IsCapturingVideo())
 	{
@@ -922,6 +975,18 @@ void GSRenderer::StopGSDump()
 	m_dump_frames = 0;
 }
 
+void GSRenderer::SaveGSDumpReplayBuffer()
+{
+	if (!m_dump_replay_buffer)
+	{
+		Host::AddKeyedOSDMessage("GSDump", TRANSLATE_STR("GS", "The GS dump replay buffer is not enabled."),
+			Host::OSD_ERROR_DURATION);
+		return;
+	}
+
+	m_dump_replay_buffer->Save(GSGetBaseSnapshotFilename() + ".gs.zst");
+}
+
 void GSRenderer::PresentCurrentFrame()
 {
 	if (BeginPresentFrame(false))
@@ -19,6 +19,7 @@ private:
 	std::string m_snapshot;
 	u32 m_dump_frames = 0;
 	u32 m_skipped_duplicate_frames = 0;
+	u32 m_present_skip_count = 0;
 
 	// Tracking draw counters for idle frame detection.
 	int m_last_draw_n = 0;
@@ -32,6 +33,9 @@ protected:
 	bool m_same_group_texture_shuffle = false;
 	bool m_downscale_source = false;
 
+	/// Number of frames to skip presenting between each presented frame, set by the dynamic resolution controller.
+	u32 m_present_skip_interval = 0;
+
 	virtual GSTexture* GetOutput(int i, float& scale, int& y_offset) = 0;
 	virtual GSTexture* GetFeedbackOutput(float& scale) { return nullptr; }
 
@@ -45,7 +49,14 @@ public:
 
 	virtual void UpdateRenderFixes();
 
+	/// Called when the running game changes, for renderer-specific per-game caches.
+	virtual void GameChanged() {}
+
 	virtual void VSync(u32 field, bool registers_written, bool idle_frame);
+
+	/// Called by the GS thread while it's waiting for more packets. Returns true if there's still work to do.
+	virtual bool RunIdleWork() { return false; }
+
 	virtual bool CanUpscale() { return false; }
 	virtual float GetUpscaleMultiplier() { return 1.0f; }
 	virtual float GetTextureScaleFactor() { return 1.0f; }
@@ -61,6 +72,7 @@ public:
 
 	void QueueSnapshot(const std::string& path, u32 gsdump_frames);
 	void StopGSDump();
+	void SaveGSDumpReplayBuffer();
 	void PresentCurrentFrame();
 	bool BeginCapture(std::string filename, const GSVector2i& size = GSVector2i(0, 0));
 	void EndCapture();
@@ -48,6 +48,10 @@ public:
 	Vertex m_max = {};
 	VertexAlpha m_alpha = {}; // source alpha range after tfx, GSRenderer::GetAlphaMinMax() updates it
 
+	// Index count of the traced draw if every flat-shaded line/triangle has the same color on its
+	// first and last vertex, 0 otherwise. Saves the HW renderer a second pass for provoking vertex fixes.
+	u32 m_flat_provoking_eq = 0;
+
 	union
 	{
 		u32 value;
@@ -89,6 +89,10 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 
 	const GSVertex* RESTRICT v = (GSVertex*)vertex;
 
+	// Flat shading takes the color of the last vertex, track whether the first one differs anywhere.
+	constexpr bool flat_color = color && !iip && primclass != GS_POINT_CLASS;
+	u32 provoking_diff = 0;
+
 	// Process 2 vertices at a time for increased efficiency
 	auto processVertices = [&tmin, &tmax, &cmin, &cmax, &pmin, &pmax, n](const GSVertex& v0, const GSVertex& v1, bool finalVertex)
 	{
@@ -170,6 +174,8 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 		for (int i = 0; i < count; i += 2)
 		{
 			processVertices(v[index[i + 0]], v[index[i + 1]], false);
+			if (flat_color)
+				provoking_diff |= v[index[i + 0]].RGBAQ.U32[0] ^ v[index[i + 1]].RGBAQ.U32[0];
 		}
 	}
 	else if (iip || n == 1) // iip means final and non-final vertexes are treated the same
@@ -194,6 +200,11 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 			processVertices(v[index[i + 0]], v[index[i + 3]], false);
 			processVertices(v[index[i + 1]], v[index[i + 4]], false);
 			processVertices(v[index[i + 2]], v[index[i + 5]], true);
+			if (flat_color)
+			{
+				provoking_diff |= v[index[i + 0]].RGBAQ.U32[0] ^ v[index[i + 2]].RGBAQ.U32[0];
+				provoking_diff |= v[index[i + 3]].RGBAQ.U32[0] ^ v[index[i + 5]].RGBAQ.U32[0];
+			}
 		}
 		if (count & 1)
 		{
@@ -201,6 +212,8 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 			// Compiler optimizations go!
 			// (And if they don't, it's only one vertex out of many)
 			processVertices(v[index[i + 2]], v[index[i + 2]], true);
+			if (flat_color)
+				provoking_diff |= v[index[i + 0]].RGBAQ.U32[0] ^ v[index[i + 2]].RGBAQ.U32[0];
 		}
 	}
 	else
@@ -208,6 +221,8 @@ void GSVertexTraceFMM::FindMinMax(GSVertexTrace& vt, const void* vertex, const u
 		pxAssertRel(0, "Bad n value");
 	}
 
+	vt.m_flat_provoking_eq = (flat_color && provoking_diff == 0) ? static_cast<u32>(count) : 0;
+
 	GSVector4 o(context->XYOFFSET);
 	GSVector4 s(1.0f / 16, 1.0f / 16, 2.0f, 1.0f);
 
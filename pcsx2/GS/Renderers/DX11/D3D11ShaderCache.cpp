@@ -66,7 +66,16 @@ bool D3D11ShaderCache::Open(D3D_FEATURE_LEVEL feature_level, bool debug)
 		const std::string blob_filename = base_filename + ".bin";
 
 		if (!ReadExisting(index_filename, blob_filename))
+		{
+			// Shared between several processes, never replace it.
+			if (GSConfig.ReadOnlyShaderCache)
+			{
+				Console.Warning("Read-only shader cache is missing or invalid, continuing without it.");
+				return true;
+			}
+
 			return CreateNew(index_filename, blob_filename);
+		}
 	}
 
 	return true;
@@ -99,7 +108,7 @@ bool D3D11ShaderCache::CreateNew(const std::string& index_filename, const std::s
 		FileSystem::DeleteFilePath(blob_filename.c_str());
 	}
 
-	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "wb");
+	m_index_file = FileSystem::OpenSharedCFile(index_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_index_file)
 	{
 		Console.Error("Failed to open index file '%s' for writing", index_filename.c_str());
@@ -116,7 +125,7 @@ bool D3D11ShaderCache::CreateNew(const std::string& index_filename, const std::s
 		return false;
 	}
 
-	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "w+b");
+	m_blob_file = FileSystem::OpenSharedCFile(blob_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_blob_file)
 	{
 		Console.Error("Failed to open blob file '%s' for writing", blob_filename.c_str());
@@ -126,12 +135,17 @@ bool D3D11ShaderCache::CreateNew(const std::string& index_filename, const std::s
 		return false;
 	}
 
+	m_index_read_pos = FileSystem::FTell64(m_index_file);
 	return true;
 }
 
 bool D3D11ShaderCache::ReadExisting(const std::string& index_filename, const std::string& blob_filename)
 {
-	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "r+b");
+	const bool read_only = GSConfig.ReadOnlyShaderCache;
+	// Writable caches can be shared by several instances, see CompileAndAddShaderBlob().
+	m_index_file = read_only ?
+					   FileSystem::OpenSharedCFile(index_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					   FileSystem::OpenSharedCFile(index_filename.c_str(), "r+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_index_file)
 	{
 		// special case here: when there's a sharing violation (i.e. two instances running),
@@ -154,7 +168,9 @@ bool D3D11ShaderCache::ReadExisting(const std::string& index_filename, const std
 		return false;
 	}
 
-	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "a+b");
+	m_blob_file = read_only ?
+					  FileSystem::OpenSharedCFile(blob_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					  FileSystem::OpenSharedCFile(blob_filename.c_str(), "a+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_blob_file)
 	{
 		Console.Error("Blob file '%s' is missing", blob_filename.c_str());
@@ -163,39 +179,55 @@ bool D3D11ShaderCache::ReadExisting(const std::string& index_filename, const std
 		return false;
 	}
 
-	std::fseek(m_blob_file, 0, SEEK_END);
-	const u32 blob_file_size = static_cast<u32>(std::ftell(m_blob_file));
+	m_index_read_pos = FileSystem::FTell64(m_index_file);
+	if (!ReadNewIndexEntries())
+	{
+		Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
+		m_index.clear();
+		std::fclose(m_blob_file);
+		m_blob_file = nullptr;
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		return false;
+	}
+
+	if (read_only)
+	{
+		// new shaders won't be added, so the index isn't needed past this point
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+	}
+
+	DevCon.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
+	return true;
+}
+
+bool D3D11ShaderCache::ReadNewIndexEntries()
+{
+	if (FileSystem::FSeek64(m_index_file, m_index_read_pos, SEEK_SET) != 0)
+		return false;
+
+	const s64 blob_file_size = FileSystem::FSize64(m_blob_file);
 
 	for (;;)
 	{
 		CacheIndexEntry entry;
-		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1 ||
-			(entry.file_offset + entry.blob_size) > blob_file_size)
+		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1)
 		{
-			if (std::feof(m_index_file))
-				break;
-
-			Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
-			m_index.clear();
-			std::fclose(m_blob_file);
-			m_blob_file = nullptr;
-			std::fclose(m_index_file);
-			m_index_file = nullptr;
-			return false;
+			// A partial entry at the end is still being written by another instance.
+			return !std::ferror(m_index_file);
 		}
 
+		if ((static_cast<s64>(entry.file_offset) + entry.blob_size) > blob_file_size)
+			return false;
+
 		const CacheIndexKey key{entry.source_hash_low, entry.source_hash_high, entry.macro_hash_low,
 			entry.macro_hash_high, entry.entry_point_low, entry.entry_point_high, entry.source_length,
 			static_cast<D3D::ShaderType>(entry.shader_type)};
 		const CacheIndexData data{entry.file_offset, entry.blob_size};
 		m_index.emplace(key, data);
+		m_index_read_pos += sizeof(entry);
 	}
-
-	// ensure we don't write before seeking
-	std::fseek(m_index_file, 0, SEEK_END);
-
-	DevCon.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
-	return true;
 }
 
 std::string D3D11ShaderCache::GetCacheBaseFileName(D3D_FEATURE_LEVEL feature_level, bool debug)
@@ -270,7 +302,11 @@ wil::com_ptr_nothrow<ID3DBlob> D3D11ShaderCache::GetShaderBlob(D3D::ShaderType t
 	const auto key = GetCacheKey(type, shader_code, macros, entry_point);
 	auto iter = m_index.find(key);
 	if (iter == m_index.end())
-		return CompileAndAddShaderBlob(key, shader_code, macros, entry_point);
+	{
+		// Another instance sharing the cache might have compiled it already.
+		if (!m_index_file || !ReadNewIndexEntries() || (iter = m_index.find(key)) == m_index.end())
+			return CompileAndAddShaderBlob(key, shader_code, macros, entry_point);
+	}
 
 	wil::com_ptr_nothrow<ID3DBlob> blob;
 	HRESULT hr = D3DCreateBlob(iter->second.blob_size, blob.put());
@@ -404,9 +440,18 @@ wil::com_ptr_nothrow<ID3DBlob> D3D11ShaderCache::CompileAndAddShaderBlob(const C
 	if (!blob)
 		return {};
 
-	if (!m_blob_file || std::fseek(m_blob_file, 0, SEEK_END) != 0)
+	if (!m_blob_file || !m_index_file)
 		return blob;
 
+	// Other instances append to the same files, so pick the blob offset and write both files under the lock.
+	// The blob goes first, readers don't take the lock and will only see the index entry once the data is there.
+	FileSystem::SharedFileLock lock(m_index_file);
+	if (!ReadNewIndexEntries() || m_index.find(key) != m_index.end() || std::fseek(m_blob_file, 0, SEEK_END) != 0 ||
+		FileSystem::FSeek64(m_index_file, m_index_read_pos, SEEK_SET) != 0)
+	{
+		return blob;
+	}
+
 	CacheIndexData data;
 	data.file_offset = static_cast<u32>(std::ftell(m_blob_file));
 	data.blob_size = static_cast<u32>(blob->GetBufferSize());
@@ -431,6 +476,7 @@ wil::com_ptr_nothrow<ID3DBlob> D3D11ShaderCache::CompileAndAddShaderBlob(const C
 		return blob;
 	}
 
+	m_index_read_pos += sizeof(entry);
 	m_index.emplace(key, data);
 	return blob;
 }
@@ -80,12 +80,14 @@ private:
 
 	bool CreateNew(const std::string& index_filename, const std::string& blob_filename);
 	bool ReadExisting(const std::string& index_filename, const std::string& blob_filename);
+	bool ReadNewIndexEntries();
 
 	wil::com_ptr_nothrow<ID3DBlob> CompileAndAddShaderBlob(const CacheIndexKey& key,
 		const std::string_view shader_code, const D3D_SHADER_MACRO* macros, const char* entry_point);
 
 	std::FILE* m_index_file = nullptr;
 	std::FILE* m_blob_file = nullptr;
+	s64 m_index_read_pos = 0; ///< End of the last complete index entry, other instances may append past it.
 
 	CacheIndex m_index;
 
@@ -433,11 +433,26 @@ bool GSDevice11::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 
 	// constant buffer
 
+	// Stream the per-draw constants through a ring where the runtime lets us bind part of a buffer, so
+	// updates are a NO_OVERWRITE map instead of a copy which may have to wait on the GPU.
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	m_cb_offsetting = SUCCEEDED(m_dev->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+					  options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+	m_vs_cb_size = m_cb_offsetting ? CONSTANT_BUFFER_STREAM_SIZE :
+									 Common::AlignUpPow2(static_cast<u32>(sizeof(GSHWDrawConfig::VSConstantBuffer)), CONSTANT_BUFFER_ALIGNMENT);
+	m_ps_cb_size = m_cb_offsetting ? CONSTANT_BUFFER_STREAM_SIZE :
+									 Common::AlignUpPow2(static_cast<u32>(sizeof(GSHWDrawConfig::PSConstantBuffer)), CONSTANT_BUFFER_ALIGNMENT);
+	m_vs_cb_pos = 0;
+	m_ps_cb_pos = 0;
+	m_vs_cb_offset = 0;
+	m_ps_cb_offset = 0;
+
 	memset(&bd, 0, sizeof(bd));
 
-	bd.ByteWidth = sizeof(GSHWDrawConfig::VSConstantBuffer);
-	bd.Usage = D3D11_USAGE_DEFAULT;
+	bd.ByteWidth = m_vs_cb_size;
+	bd.Usage = D3D11_USAGE_DYNAMIC;
 	bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
 	if (FAILED(m_dev->CreateBuffer(&bd, nullptr, m_vs_cb.put())))
 	{
@@ -447,9 +462,10 @@ bool GSDevice11::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 
 	memset(&bd, 0, sizeof(bd));
 
-	bd.ByteWidth = sizeof(GSHWDrawConfig::PSConstantBuffer);
-	bd.Usage = D3D11_USAGE_DEFAULT;
+	bd.ByteWidth = m_ps_cb_size;
+	bd.Usage = D3D11_USAGE_DYNAMIC;
 	bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
 	if (FAILED(m_dev->CreateBuffer(&bd, nullptr, m_ps_cb.put())))
 	{
@@ -1452,6 +1468,22 @@ void GSDevice11::ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offs
 	StretchRect(sTex, GSVector4::zero(), dTex, dRect, m_convert.ps[static_cast<int>(shader)].get(), m_merge.cb.get(), nullptr, false);
 }
 
+void GSDevice11::UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM)
+{
+	// match merge cb
+	struct Uniforms
+	{
+		GSVector4 origin_texa;
+		u32 BP, BW, PSM;
+	};
+
+	const Uniforms cb = {GSVector4(static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(TA0) / 255.0f, AEM ? 1.0f : 0.0f), BP, BW, PSM};
+	m_ctx->UpdateSubresource(m_merge.cb.get(), 0, nullptr, &cb, 0, 0);
+
+	const ShaderConvert shader = ShaderConvert::UNSWIZZLE_CT32;
+	StretchRect(sTex, GSVector4::zero(), dTex, GSVector4(dRect), m_convert.ps[static_cast<int>(shader)].get(), m_merge.cb.get(), nullptr, false);
+}
+
 void GSDevice11::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
 {
 	struct Uniforms
@@ -1659,6 +1691,8 @@ void GSDevice11::SetupVS(VSSelector sel, const GSHWDrawConfig::VSConstantBuffer*
 
 	if (i == m_vs.end())
 	{
+		g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
 		ShaderMacro sm;
 
 		sm.AddMacro("VERTEX_SHADER", 1);
@@ -1693,11 +1727,9 @@ void GSDevice11::SetupVS(VSSelector sel, const GSHWDrawConfig::VSConstantBuffer*
 	}
 
 	if (m_vs_cb_cache.Update(*cb))
-	{
-		m_ctx->UpdateSubresource(m_vs_cb.get(), 0, NULL, cb, 0, 0);
-	}
+		m_vs_cb_offset = StreamConstantBuffer(m_vs_cb.get(), m_vs_cb_size, m_vs_cb_pos, cb, sizeof(*cb));
 
-	VSSetShader(i->second.vs.get(), m_vs_cb.get());
+	VSSetShader(i->second.vs.get(), m_vs_cb.get(), m_vs_cb_offset);
 
 	IASetInputLayout(i->second.il.get());
 }
@@ -1708,6 +1740,8 @@ void GSDevice11::SetupPS(const PSSelector& sel, const GSHWDrawConfig::PSConstant
 
 	if (i == m_ps.end())
 	{
+		g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
 		ShaderMacro sm;
 
 		sm.AddMacro("PIXEL_SHADER", 1);
@@ -1772,9 +1806,7 @@ void GSDevice11::SetupPS(const PSSelector& sel, const GSHWDrawConfig::PSConstant
 	}
 
 	if (cb && m_ps_cb_cache.Update(*cb))
-	{
-		m_ctx->UpdateSubresource(m_ps_cb.get(), 0, NULL, cb, 0, 0);
-	}
+		m_ps_cb_offset = StreamConstantBuffer(m_ps_cb.get(), m_ps_cb_size, m_ps_cb_pos, cb, sizeof(*cb));
 
 	wil::com_ptr_nothrow<ID3D11SamplerState> ss0;
 
@@ -1835,7 +1867,7 @@ void GSDevice11::SetupPS(const PSSelector& sel, const GSHWDrawConfig::PSConstant
 
 	PSSetSamplerState(ss0.get());
 
-	PSSetShader(i->second.get(), m_ps_cb.get());
+	PSSetShader(i->second.get(), m_ps_cb.get(), m_ps_cb_offset);
 }
 
 void GSDevice11::SetupOM(OMDepthStencilSelector dssel, OMBlendSelector bsel, u8 afix)
@@ -2340,7 +2372,33 @@ void GSDevice11::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
 	}
 }
 
-void GSDevice11::VSSetShader(ID3D11VertexShader* vs, ID3D11Buffer* vs_cb)
+u32 GSDevice11::StreamConstantBuffer(ID3D11Buffer* buffer, u32 buffer_size, u32& pos, const void* data, u32 size)
+{
+	const u32 aligned_size = Common::AlignUpPow2(size, CONSTANT_BUFFER_ALIGNMENT);
+
+	D3D11_MAP type = D3D11_MAP_WRITE_NO_OVERWRITE;
+	u32 offset = pos;
+	if (!m_cb_offsetting || (offset + aligned_size) > buffer_size)
+	{
+		offset = 0;
+		type = D3D11_MAP_WRITE_DISCARD;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE m;
+	if (FAILED(m_ctx->Map(buffer, 0, type, 0, &m)))
+	{
+		Console.Error("D3D11: Failed to map constant buffer.");
+		return offset / 16;
+	}
+
+	std::memcpy(static_cast<u8*>(m.pData) + offset, data, size);
+	m_ctx->Unmap(buffer, 0);
+
+	pos = offset + aligned_size;
+	return offset / 16;
+}
+
+void GSDevice11::VSSetShader(ID3D11VertexShader* vs, ID3D11Buffer* vs_cb, u32 vs_cb_offset)
 {
 	if (m_state.vs != vs)
 	{
@@ -2349,11 +2407,20 @@ void GSDevice11::VSSetShader(ID3D11VertexShader* vs, ID3D11Buffer* vs_cb)
 		m_ctx->VSSetShader(vs, nullptr, 0);
 	}
 
-	if (m_state.vs_cb != vs_cb)
+	if (m_state.vs_cb != vs_cb || m_state.vs_cb_offset != vs_cb_offset)
 	{
 		m_state.vs_cb = vs_cb;
+		m_state.vs_cb_offset = vs_cb_offset;
 
-		m_ctx->VSSetConstantBuffers(0, 1, &vs_cb);
+		if (m_cb_offsetting && vs_cb == m_vs_cb.get())
+		{
+			const UINT num_constants = Common::AlignUpPow2(static_cast<u32>(sizeof(GSHWDrawConfig::VSConstantBuffer)), CONSTANT_BUFFER_ALIGNMENT) / 16;
+			m_ctx->VSSetConstantBuffers1(0, 1, &vs_cb, &vs_cb_offset, &num_constants);
+		}
+		else
+		{
+			m_ctx->VSSetConstantBuffers(0, 1, &vs_cb);
+		}
 	}
 }
 
@@ -2372,7 +2439,7 @@ void GSDevice11::ClearSamplerCache()
 	m_ps_ss.clear();
 }
 
-void GSDevice11::PSSetShader(ID3D11PixelShader* ps, ID3D11Buffer* ps_cb)
+void GSDevice11::PSSetShader(ID3D11PixelShader* ps, ID3D11Buffer* ps_cb, u32 ps_cb_offset)
 {
 	if (m_state.ps != ps)
 	{
@@ -2381,11 +2448,20 @@ void GSDevice11::PSSetShader(ID3D11PixelShader* ps, ID3D11Buffer* ps_cb)
 		m_ctx->PSSetShader(ps, nullptr, 0);
 	}
 
-	if (m_state.ps_cb != ps_cb)
+	if (m_state.ps_cb != ps_cb || m_state.ps_cb_offset != ps_cb_offset)
 	{
 		m_state.ps_cb = ps_cb;
+		m_state.ps_cb_offset = ps_cb_offset;
 
-		m_ctx->PSSetConstantBuffers(0, 1, &ps_cb);
+		if (m_cb_offsetting && ps_cb == m_ps_cb.get())
+		{
+			const UINT num_constants = Common::AlignUpPow2(static_cast<u32>(sizeof(GSHWDrawConfig::PSConstantBuffer)), CONSTANT_BUFFER_ALIGNMENT) / 16;
+			m_ctx->PSSetConstantBuffers1(0, 1, &ps_cb, &ps_cb_offset, &num_constants);
+		}
+		else
+		{
+			m_ctx->PSSetConstantBuffers(0, 1, &ps_cb);
+		}
 	}
 }
 
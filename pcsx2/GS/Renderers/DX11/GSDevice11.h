@@ -87,6 +87,8 @@ private:
 		MAX_SAMPLERS = 1,
 		VERTEX_BUFFER_SIZE = 32 * 1024 * 1024,
 		INDEX_BUFFER_SIZE = 16 * 1024 * 1024,
+		CONSTANT_BUFFER_STREAM_SIZE = 1024 * 1024,
+		CONSTANT_BUFFER_ALIGNMENT = 256, // 16 constants, required for offsetting.
 		NUM_TIMESTAMP_QUERIES = 5,
 	};
 
@@ -113,6 +115,9 @@ private:
 	bool CreateImGuiResources();
 	void RenderImGui();
 
+	/// Writes constants to the next free range of a dynamic buffer, returning its offset in constants.
+	u32 StreamConstantBuffer(ID3D11Buffer* buffer, u32 buffer_size, u32& pos, const void* data, u32 size);
+
 	wil::com_ptr_nothrow<IDXGIFactory5> m_dxgi_factory;
 	wil::com_ptr_nothrow<ID3D11Device1> m_dev;
 	wil::com_ptr_nothrow<ID3D11DeviceContext1> m_ctx;
@@ -131,6 +136,15 @@ private:
 	u32 m_vb_pos = 0; // bytes
 	u32 m_ib_pos = 0; // indices/sizeof(u32)
 	u32 m_structured_vb_pos = 0; // bytes
+	u32 m_vs_cb_pos = 0; // bytes
+	u32 m_ps_cb_pos = 0; // bytes
+	u32 m_vs_cb_size = 0; // bytes
+	u32 m_ps_cb_size = 0; // bytes
+	u32 m_vs_cb_offset = 0; // constants, of the last update
+	u32 m_ps_cb_offset = 0; // constants, of the last update
+
+	/// Whether the TFX constant buffers are rings bound with offsets (D3D11.1), otherwise they're discarded each update.
+	bool m_cb_offsetting = false;
 
 	bool m_allow_tearing_supported = false;
 	bool m_using_flip_model_swap_chain = true;
@@ -144,10 +158,12 @@ private:
 		ID3D11Buffer* index_buffer;
 		ID3D11VertexShader* vs;
 		ID3D11Buffer* vs_cb;
+		u32 vs_cb_offset;
 		std::array<ID3D11ShaderResourceView*, MAX_TEXTURES> ps_sr_views;
 		std::array<ID3D11ShaderResourceView*, MAX_TEXTURES> ps_cached_sr_views;
 		ID3D11PixelShader* ps;
 		ID3D11Buffer* ps_cb;
+		u32 ps_cb_offset;
 		std::array<ID3D11SamplerState*, MAX_SAMPLERS> ps_ss;
 		std::array<ID3D11SamplerState*, MAX_SAMPLERS> ps_cached_ss;
 		GSVector2i viewport;
@@ -305,6 +321,7 @@ public:
 	void PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, PresentShader shader, float shaderTime, bool linear) override;
 	void UpdateCLUTTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize) override;
 	void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM) override;
+	void UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM) override;
 	void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) override;
 	void DrawMultiStretchRects(const MultiStretchRect* rects, u32 num_rects, GSTexture* dTex, ShaderConvert shader) override;
 	void DoMultiStretchRects(const MultiStretchRect* rects, u32 num_rects, const GSVector2& ds);
@@ -324,10 +341,10 @@ public:
 	void IASetInputLayout(ID3D11InputLayout* layout);
 	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
 
-	void VSSetShader(ID3D11VertexShader* vs, ID3D11Buffer* vs_cb);
+	void VSSetShader(ID3D11VertexShader* vs, ID3D11Buffer* vs_cb, u32 vs_cb_offset = 0);
 
 	void PSSetShaderResource(int i, GSTexture* sr);
-	void PSSetShader(ID3D11PixelShader* ps, ID3D11Buffer* ps_cb);
+	void PSSetShader(ID3D11PixelShader* ps, ID3D11Buffer* ps_cb, u32 ps_cb_offset = 0);
 	void PSUpdateShaderState(const bool sr_update, const bool ss_update);
 	void PSUnbindConflictingSRVs(GSTexture* tex1 = nullptr, GSTexture* tex2 = nullptr);
 	void PSSetSamplerState(ID3D11SamplerState* ss0);
@@ -68,7 +68,11 @@ bool GSTexture11::Update(const GSVector4i& r, const void* data, int pitch, int l
 		Common::AlignUpPow2((u32)r.right, bs), Common::AlignUpPow2((u32)r.bottom, bs), 1U};
 	const UINT subresource = layer; // MipSlice + (ArraySlice * MipLevels).
 
-	GSDevice11::GetInstance()->GetD3DContext()->UpdateSubresource(m_texture.get(), subresource, &box, data, pitch, 0);
+	// Replacing all of a single level texture doesn't need the old contents, let the driver rename it instead of waiting.
+	const bool discard = (m_mipmap_levels == 1 && box.left == 0 && box.top == 0 &&
+						  box.right >= static_cast<u32>(m_size.x) && box.bottom >= static_cast<u32>(m_size.y));
+	GSDevice11::GetInstance()->GetD3DContext()->UpdateSubresource1(
+		m_texture.get(), subresource, &box, data, pitch, 0, discard ? D3D11_COPY_DISCARD : 0);
 	m_needs_mipmaps_generated |= (layer == 0);
 	return true;
 }
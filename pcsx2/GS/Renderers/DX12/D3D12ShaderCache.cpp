@@ -67,10 +67,15 @@ bool D3D12ShaderCache::Open(D3D_FEATURE_LEVEL feature_level, bool debug)
 		const std::string shader_index_filename = base_shader_filename + ".idx";
 		const std::string shader_blob_filename = base_shader_filename + ".bin";
 
+		// A read-only cache is shared between several processes, so never replace it.
+		const bool read_only = GSConfig.ReadOnlyShaderCache;
 		if (!ReadExisting(
-				shader_index_filename, shader_blob_filename, m_shader_index_file, m_shader_blob_file, m_shader_index))
+				shader_index_filename, shader_blob_filename, m_shader_index_file, m_shader_blob_file,
+				m_shader_index_read_pos, m_shader_index) &&
+			!read_only)
 		{
-			result = CreateNew(shader_index_filename, shader_blob_filename, m_shader_index_file, m_shader_blob_file);
+			result = CreateNew(shader_index_filename, shader_blob_filename, m_shader_index_file, m_shader_blob_file,
+				m_shader_index_read_pos);
 		}
 
 		if (result)
@@ -80,10 +85,11 @@ bool D3D12ShaderCache::Open(D3D_FEATURE_LEVEL feature_level, bool debug)
 			const std::string pipelines_blob_filename = base_pipelines_filename + ".bin";
 
 			if (!ReadExisting(pipelines_index_filename, pipelines_blob_filename, m_pipeline_index_file,
-					m_pipeline_blob_file, m_pipeline_index))
+					m_pipeline_blob_file, m_pipeline_index_read_pos, m_pipeline_index) &&
+				!read_only)
 			{
-				result = CreateNew(
-					pipelines_index_filename, pipelines_blob_filename, m_pipeline_index_file, m_pipeline_blob_file);
+				result = CreateNew(pipelines_index_filename, pipelines_blob_filename, m_pipeline_index_file,
+					m_pipeline_blob_file, m_pipeline_index_read_pos);
 			}
 		}
 	}
@@ -130,17 +136,18 @@ void D3D12ShaderCache::InvalidatePipelineCache()
 		m_pipeline_index_file = nullptr;
 	}
 
-	if (GSConfig.DisableShaderCache)
+	if (GSConfig.DisableShaderCache || GSConfig.ReadOnlyShaderCache)
 		return;
 
 	const std::string base_pipelines_filename = GetCacheBaseFileName("pipelines", m_feature_level, m_debug);
 	const std::string pipelines_index_filename = base_pipelines_filename + ".idx";
 	const std::string pipelines_blob_filename = base_pipelines_filename + ".bin";
-	CreateNew(pipelines_index_filename, pipelines_blob_filename, m_pipeline_index_file, m_pipeline_blob_file);
+	CreateNew(pipelines_index_filename, pipelines_blob_filename, m_pipeline_index_file, m_pipeline_blob_file,
+		m_pipeline_index_read_pos);
 }
 
-bool D3D12ShaderCache::CreateNew(
-	const std::string& index_filename, const std::string& blob_filename, std::FILE*& index_file, std::FILE*& blob_file)
+bool D3D12ShaderCache::CreateNew(const std::string& index_filename, const std::string& blob_filename,
+	std::FILE*& index_file, std::FILE*& blob_file, s64& read_pos)
 {
 	if (FileSystem::FileExists(index_filename.c_str()))
 	{
@@ -153,7 +160,7 @@ bool D3D12ShaderCache::CreateNew(
 		FileSystem::DeleteFilePath(blob_filename.c_str());
 	}
 
-	index_file = FileSystem::OpenCFile(index_filename.c_str(), "wb");
+	index_file = FileSystem::OpenSharedCFile(index_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!index_file)
 	{
 		Console.Error("Failed to open index file '%s' for writing", index_filename.c_str());
@@ -170,23 +177,28 @@ bool D3D12ShaderCache::CreateNew(
 		return false;
 	}
 
-	blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "w+b");
+	blob_file = FileSystem::OpenSharedCFile(blob_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!blob_file)
 	{
 		Console.Error("Failed to open blob file '%s' for writing", blob_filename.c_str());
-		std::fclose(blob_file);
-		blob_file = nullptr;
+		std::fclose(index_file);
+		index_file = nullptr;
 		FileSystem::DeleteFilePath(index_filename.c_str());
 		return false;
 	}
 
+	read_pos = FileSystem::FTell64(index_file);
 	return true;
 }
 
 bool D3D12ShaderCache::ReadExisting(const std::string& index_filename, const std::string& blob_filename,
-	std::FILE*& index_file, std::FILE*& blob_file, CacheIndex& index)
+	std::FILE*& index_file, std::FILE*& blob_file, s64& read_pos, CacheIndex& index)
 {
-	index_file = FileSystem::OpenCFile(index_filename.c_str(), "r+b");
+	// Writable caches can be shared by several instances, see CompileAndAddShaderBlob().
+	const bool read_only = GSConfig.ReadOnlyShaderCache;
+	index_file = read_only ?
+					 FileSystem::OpenSharedCFile(index_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					 FileSystem::OpenSharedCFile(index_filename.c_str(), "r+b", FileSystem::FileShareMode::DenyNone);
 	if (!index_file)
 	{
 		// special case here: when there's a sharing violation (i.e. two instances running),
@@ -209,7 +221,9 @@ bool D3D12ShaderCache::ReadExisting(const std::string& index_filename, const std
 		return false;
 	}
 
-	blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "a+b");
+	blob_file = read_only ?
+					FileSystem::OpenSharedCFile(blob_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					FileSystem::OpenSharedCFile(blob_filename.c_str(), "a+b", FileSystem::FileShareMode::DenyNone);
 	if (!blob_file)
 	{
 		Console.Error("Blob file '%s' is missing", blob_filename.c_str());
@@ -218,39 +232,67 @@ bool D3D12ShaderCache::ReadExisting(const std::string& index_filename, const std
 		return false;
 	}
 
-	std::fseek(blob_file, 0, SEEK_END);
-	const u32 blob_file_size = static_cast<u32>(std::ftell(blob_file));
+	read_pos = FileSystem::FTell64(index_file);
+	if (!ReadNewIndexEntries(index_file, blob_file, read_pos, index))
+	{
+		Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
+		index.clear();
+		std::fclose(blob_file);
+		blob_file = nullptr;
+		std::fclose(index_file);
+		index_file = nullptr;
+		return false;
+	}
+
+	if (read_only)
+	{
+		// new entries won't be added, so the index isn't needed past this point
+		std::fclose(index_file);
+		index_file = nullptr;
+	}
+
+	DevCon.WriteLn("Read %zu entries from '%s'", index.size(), index_filename.c_str());
+	return true;
+}
+
+bool D3D12ShaderCache::ReadNewIndexEntries(std::FILE* index_file, std::FILE* blob_file, s64& read_pos, CacheIndex& index)
+{
+	if (FileSystem::FSeek64(index_file, read_pos, SEEK_SET) != 0)
+		return false;
+
+	const s64 blob_file_size = FileSystem::FSize64(blob_file);
 
 	for (;;)
 	{
 		CacheIndexEntry entry;
-		if (std::fread(&entry, sizeof(entry), 1, index_file) != 1 ||
-			(entry.file_offset + entry.blob_size) > blob_file_size)
+		if (std::fread(&entry, sizeof(entry), 1, index_file) != 1)
 		{
-			if (std::feof(index_file))
-				break;
-
-			Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
-			index.clear();
-			std::fclose(blob_file);
-			blob_file = nullptr;
-			std::fclose(index_file);
-			index_file = nullptr;
-			return false;
+			// A partial entry at the end is still being written by another instance.
+			return !std::ferror(index_file);
 		}
 
+		if ((static_cast<s64>(entry.file_offset) + entry.blob_size) > blob_file_size)
+			return false;
+
 		const CacheIndexKey key{entry.source_hash_low, entry.source_hash_high, entry.macro_hash_low,
 			entry.macro_hash_high, entry.entry_point_low, entry.entry_point_high, entry.source_length,
 			static_cast<EntryType>(entry.shader_type)};
 		const CacheIndexData data{entry.file_offset, entry.blob_size};
 		index.emplace(key, data);
+		read_pos += sizeof(entry);
 	}
+}
 
-	// ensure we don't write before seeking
-	std::fseek(index_file, 0, SEEK_END);
+D3D12ShaderCache::CacheIndex::const_iterator D3D12ShaderCache::FindEntry(
+	std::FILE* index_file, std::FILE* blob_file, s64& read_pos, CacheIndex& index, const CacheIndexKey& key)
+{
+	auto iter = index.find(key);
 
-	DevCon.WriteLn("Read %zu entries from '%s'", index.size(), index_filename.c_str());
-	return true;
+	// Another instance sharing the cache might have added it since we last looked.
+	if (iter == index.end() && index_file && ReadNewIndexEntries(index_file, blob_file, read_pos, index))
+		iter = index.find(key);
+
+	return iter;
 }
 
 std::string D3D12ShaderCache::GetCacheBaseFileName(const std::string_view type, D3D_FEATURE_LEVEL feature_level, bool debug)
@@ -404,7 +446,7 @@ D3D12ShaderCache::ComPtr<ID3DBlob> D3D12ShaderCache::GetShaderBlob(EntryType typ
 	const D3D_SHADER_MACRO* macros /* = nullptr */, const char* entry_point /* = "main" */)
 {
 	const auto key = GetShaderCacheKey(type, shader_code, macros, entry_point);
-	auto iter = m_shader_index.find(key);
+	auto iter = FindEntry(m_shader_index_file, m_shader_blob_file, m_shader_index_read_pos, m_shader_index, key);
 	if (iter == m_shader_index.end())
 		return CompileAndAddShaderBlob(key, shader_code, macros, entry_point);
 
@@ -425,7 +467,8 @@ D3D12ShaderCache::ComPtr<ID3D12PipelineState> D3D12ShaderCache::GetPipelineState
 {
 	const auto key = GetPipelineCacheKey(desc);
 
-	auto iter = m_pipeline_index.find(key);
+	auto iter =
+		FindEntry(m_pipeline_index_file, m_pipeline_blob_file, m_pipeline_index_read_pos, m_pipeline_index, key);
 	if (iter == m_pipeline_index.end())
 		return CompileAndAddPipeline(device, key, desc);
 
@@ -459,7 +502,8 @@ D3D12ShaderCache::ComPtr<ID3D12PipelineState> D3D12ShaderCache::GetPipelineState
 {
 	const auto key = GetPipelineCacheKey(desc);
 
-	auto iter = m_pipeline_index.find(key);
+	auto iter =
+		FindEntry(m_pipeline_index_file, m_pipeline_blob_file, m_pipeline_index_read_pos, m_pipeline_index, key);
 	if (iter == m_pipeline_index.end())
 		return CompileAndAddPipeline(device, key, desc);
 
@@ -514,9 +558,19 @@ D3D12ShaderCache::ComPtr<ID3DBlob> D3D12ShaderCache::CompileAndAddShaderBlob(
 	if (!blob)
 		return {};
 
-	if (!m_shader_blob_file || std::fseek(m_shader_blob_file, 0, SEEK_END) != 0)
+	if (!m_shader_blob_file || !m_shader_index_file)
 		return blob;
 
+	// Other instances append to the same files, so pick the blob offset and write both files under the lock.
+	// The blob goes first, readers don't take the lock and will only see the index entry once the data is there.
+	FileSystem::SharedFileLock lock(m_shader_index_file);
+	if (!ReadNewIndexEntries(m_shader_index_file, m_shader_blob_file, m_shader_index_read_pos, m_shader_index) ||
+		m_shader_index.find(key) != m_shader_index.end() || std::fseek(m_shader_blob_file, 0, SEEK_END) != 0 ||
+		FileSystem::FSeek64(m_shader_index_file, m_shader_index_read_pos, SEEK_SET) != 0)
+	{
+		return blob;
+	}
+
 	CacheIndexData data;
 	data.file_offset = static_cast<u32>(std::ftell(m_shader_blob_file));
 	data.blob_size = static_cast<u32>(blob->GetBufferSize());
@@ -541,6 +595,7 @@ D3D12ShaderCache::ComPtr<ID3DBlob> D3D12ShaderCache::CompileAndAddShaderBlob(
 		return blob;
 	}
 
+	m_shader_index_read_pos += sizeof(entry);
 	m_shader_index.emplace(key, data);
 	return blob;
 }
@@ -577,7 +632,7 @@ D3D12ShaderCache::ComPtr<ID3D12PipelineState> D3D12ShaderCache::CompileAndAddPip
 
 bool D3D12ShaderCache::AddPipelineToBlob(const CacheIndexKey& key, ID3D12PipelineState* pso)
 {
-	if (!m_pipeline_blob_file || std::fseek(m_pipeline_blob_file, 0, SEEK_END) != 0)
+	if (!m_pipeline_blob_file || !m_pipeline_index_file)
 		return false;
 
 	ComPtr<ID3DBlob> blob;
@@ -588,6 +643,15 @@ bool D3D12ShaderCache::AddPipelineToBlob(const CacheIndexKey& key, ID3D12Pipelin
 		return false;
 	}
 
+	// Same as CompileAndAddShaderBlob(), other instances may be appending to these files.
+	FileSystem::SharedFileLock lock(m_pipeline_index_file);
+	if (!ReadNewIndexEntries(m_pipeline_index_file, m_pipeline_blob_file, m_pipeline_index_read_pos, m_pipeline_index) ||
+		m_pipeline_index.find(key) != m_pipeline_index.end() || std::fseek(m_pipeline_blob_file, 0, SEEK_END) != 0 ||
+		FileSystem::FSeek64(m_pipeline_index_file, m_pipeline_index_read_pos, SEEK_SET) != 0)
+	{
+		return false;
+	}
+
 	CacheIndexData data;
 	data.file_offset = static_cast<u32>(std::ftell(m_pipeline_blob_file));
 	data.blob_size = static_cast<u32>(blob->GetBufferSize());
@@ -608,6 +672,7 @@ bool D3D12ShaderCache::AddPipelineToBlob(const CacheIndexKey& key, ID3D12Pipelin
 		return false;
 	}
 
-	m_shader_index.emplace(key, data);
+	m_pipeline_index_read_pos += sizeof(entry);
+	m_pipeline_index.emplace(key, data);
 	return true;
 }
@@ -102,9 +102,12 @@ private:
 	static CacheIndexKey GetPipelineCacheKey(const D3D12_COMPUTE_PIPELINE_STATE_DESC& gpdesc);
 
 	bool CreateNew(const std::string& index_filename, const std::string& blob_filename, std::FILE*& index_file,
-		std::FILE*& blob_file);
+		std::FILE*& blob_file, s64& read_pos);
 	bool ReadExisting(const std::string& index_filename, const std::string& blob_filename, std::FILE*& index_file,
-		std::FILE*& blob_file, CacheIndex& index);
+		std::FILE*& blob_file, s64& read_pos, CacheIndex& index);
+	static bool ReadNewIndexEntries(std::FILE* index_file, std::FILE* blob_file, s64& read_pos, CacheIndex& index);
+	static CacheIndex::const_iterator FindEntry(
+		std::FILE* index_file, std::FILE* blob_file, s64& read_pos, CacheIndex& index, const CacheIndexKey& key);
 	void InvalidatePipelineCache();
 
 	ComPtr<ID3DBlob> CompileAndAddShaderBlob(const CacheIndexKey& key, std::string_view shader_code,
@@ -117,10 +120,12 @@ private:
 
 	std::FILE* m_shader_index_file = nullptr;
 	std::FILE* m_shader_blob_file = nullptr;
+	s64 m_shader_index_read_pos = 0; ///< End of the last complete index entry, other instances may append past it.
 	CacheIndex m_shader_index;
 
 	std::FILE* m_pipeline_index_file = nullptr;
 	std::FILE* m_pipeline_blob_file = nullptr;
+	s64 m_pipeline_index_read_pos = 0;
 	CacheIndex m_pipeline_index;
 
 	D3D_FEATURE_LEVEL m_feature_level = D3D_FEATURE_LEVEL_11_0;
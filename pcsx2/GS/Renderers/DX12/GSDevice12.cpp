@@ -19,6 +19,7 @@
 #include "common/ScopedGuard.h"
 #include "common/SmallString.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "D3D12MemAlloc.h"
 #include "imgui.h"
@@ -244,6 +245,17 @@ bool GSDevice12::CreateDevice(u32& vendor_id)
 		return false;
 	}
 
+	// Render targets and depth buffers are placed in their own heaps, so texture cache churn
+	// suballocates from existing memory instead of creating a committed resource every time.
+	D3D12MA::POOL_DESC target_pool_desc = {};
+	target_pool_desc.Flags = D3D12MA::POOL_FLAG_MSAA_TEXTURES_ALWAYS_COMMITTED;
+	target_pool_desc.HeapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+	target_pool_desc.HeapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+	target_pool_desc.BlockSize = TARGET_POOL_BLOCK_SIZE;
+	hr = m_allocator->CreatePool(&target_pool_desc, m_target_pool.put());
+	if (FAILED(hr))
+		Console.Warning("D3D12: CreatePool() for targets failed with HRESULT %08X, using committed targets", hr);
+
 	hr = m_device->CreateFence(m_completed_fence_value, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence));
 	if (FAILED(hr))
 	{
@@ -355,6 +367,7 @@ void GSDevice12::MoveToNextCommandList()
 	res.command_allocators[1]->Reset();
 	res.command_lists[1]->Reset(res.command_allocators[1].get(), nullptr);
 	res.descriptor_allocator.Reset();
+	m_texture_groups.clear();
 	if (res.sampler_allocator.ShouldReset())
 		res.sampler_allocator.Reset();
 
@@ -382,6 +395,9 @@ void GSDevice12::MoveToNextCommandList()
 		}
 	}
 
+	if (res.num_timing_markers > 1)
+		ReadGPUTimingMarkers(res);
+
 	res.has_timestamp_query = m_gpu_timing_enabled;
 	if (m_gpu_timing_enabled)
 	{
@@ -389,6 +405,15 @@ void GSDevice12::MoveToNextCommandList()
 			m_current_command_list * NUM_TIMESTAMP_QUERIES_PER_CMDLIST);
 	}
 
+	res.num_timing_markers = 0;
+	if (m_gpu_timing_breakdown)
+	{
+		res.command_lists[1]->EndQuery(m_timestamp_query_heap.get(), D3D12_QUERY_TYPE_TIMESTAMP,
+			GetTimingMarkerQueryIndex(m_current_command_list, 0));
+		res.timing_categories[0] = m_gpu_timing_category;
+		res.num_timing_markers = 1;
+	}
+
 	ID3D12DescriptorHeap* heaps[2] = {
 		res.descriptor_allocator.GetDescriptorHeap(), res.sampler_allocator.GetDescriptorHeap()};
 	res.command_lists[1]->SetDescriptorHeaps(std::size(heaps), heaps);
@@ -397,6 +422,13 @@ void GSDevice12::MoveToNextCommandList()
 }
 
 ID3D12GraphicsCommandList4* GSDevice12::GetInitCommandList()
+{
+	// Anything else recorded to the init list may depend on the uploads, so they have to go first.
+	FlushUploadBatch();
+	return BeginInitCommandList();
+}
+
+ID3D12GraphicsCommandList4* GSDevice12::BeginInitCommandList()
 {
 	CommandListResources& res = m_command_lists[m_current_command_list];
 	if (!res.init_command_list_used)
@@ -412,8 +444,53 @@ ID3D12GraphicsCommandList4* GSDevice12::GetInitCommandList()
 	return res.command_lists[0].get();
 }
 
+void GSDevice12::AddUploadBatchResource(
+	ID3D12Resource* resource, D3D12_RESOURCE_STATES state_before, D3D12_RESOURCE_STATES state_after)
+{
+	if (state_before != D3D12_RESOURCE_STATE_COPY_DEST)
+	{
+		m_upload_batch_pre_barriers.push_back({D3D12_RESOURCE_BARRIER_TYPE_TRANSITION, D3D12_RESOURCE_BARRIER_FLAG_NONE,
+			{{resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, state_before, D3D12_RESOURCE_STATE_COPY_DEST}}});
+	}
+	if (state_after != D3D12_RESOURCE_STATE_COPY_DEST)
+	{
+		m_upload_batch_post_barriers.push_back({D3D12_RESOURCE_BARRIER_TYPE_TRANSITION, D3D12_RESOURCE_BARRIER_FLAG_NONE,
+			{{resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_STATE_COPY_DEST, state_after}}});
+	}
+}
+
+void GSDevice12::QueueBatchedUpload(const D3D12_TEXTURE_COPY_LOCATION& dst, u32 x, u32 y,
+	const D3D12_TEXTURE_COPY_LOCATION& src, const D3D12_BOX& src_box)
+{
+	m_upload_batch.push_back({dst, src, src_box, x, y});
+}
+
+void GSDevice12::FlushUploadBatch()
+{
+	if (m_upload_batch.empty())
+		return;
+
+	ID3D12GraphicsCommandList4* const cmdlist = BeginInitCommandList();
+	if (!m_upload_batch_pre_barriers.empty())
+		cmdlist->ResourceBarrier(static_cast<UINT>(m_upload_batch_pre_barriers.size()), m_upload_batch_pre_barriers.data());
+
+	// Copies stay in order, like back to back uploads to a texture which is already in COPY_DEST.
+	for (const BatchedUpload& upload : m_upload_batch)
+		cmdlist->CopyTextureRegion(&upload.dst, upload.x, upload.y, 0, &upload.src, &upload.src_box);
+
+	if (!m_upload_batch_post_barriers.empty())
+		cmdlist->ResourceBarrier(static_cast<UINT>(m_upload_batch_post_barriers.size()), m_upload_batch_post_barriers.data());
+
+	m_upload_batch.clear();
+	m_upload_batch_pre_barriers.clear();
+	m_upload_batch_post_barriers.clear();
+	m_upload_batch_counter++;
+}
+
 bool GSDevice12::ExecuteCommandList(WaitType wait_for_completion)
 {
+	FlushUploadBatch();
+
 	CommandListResources& res = m_command_lists[m_current_command_list];
 	HRESULT hr;
 
@@ -427,6 +504,16 @@ bool GSDevice12::ExecuteCommandList(WaitType wait_for_completion)
 			m_timestamp_query_buffer.get(), m_current_command_list * (sizeof(u64) * NUM_TIMESTAMP_QUERIES_PER_CMDLIST));
 	}
 
+	if (res.num_timing_markers > 0)
+	{
+		const u32 first = GetTimingMarkerQueryIndex(m_current_command_list, 0);
+		res.command_lists[1]->EndQuery(m_timestamp_query_heap.get(), D3D12_QUERY_TYPE_TIMESTAMP,
+			first + res.num_timing_markers);
+		res.num_timing_markers++;
+		res.command_lists[1]->ResolveQueryData(m_timestamp_query_heap.get(), D3D12_QUERY_TYPE_TIMESTAMP, first,
+			res.num_timing_markers, m_timestamp_query_buffer.get(), first * sizeof(u64));
+	}
+
 	if (res.init_command_list_used)
 	{
 		hr = res.command_lists[0]->Close();
@@ -473,6 +560,11 @@ void GSDevice12::InvalidateSamplerGroups()
 		res.sampler_allocator.InvalidateCache();
 }
 
+void GSDevice12::InvalidateTextureGroups()
+{
+	m_texture_groups.clear();
+}
+
 void GSDevice12::DeferObjectDestruction(ID3D12DeviceChild* resource)
 {
 	if (!resource)
@@ -510,6 +602,8 @@ void GSDevice12::DeferDescriptorDestruction(D3D12DescriptorHeapManager& manager,
 
 void GSDevice12::DestroyPendingResources(CommandListResources& cmdlist)
 {
+	if (!cmdlist.pending_descriptors.empty())
+		InvalidateTextureGroups();
 	for (const auto& dd : cmdlist.pending_descriptors)
 		dd.first.Free(dd.second);
 	cmdlist.pending_descriptors.clear();
@@ -574,7 +668,7 @@ void GSDevice12::WaitForGPUIdle()
 
 bool GSDevice12::CreateTimestampQuery()
 {
-	constexpr u32 QUERY_COUNT = NUM_TIMESTAMP_QUERIES_PER_CMDLIST * NUM_COMMAND_LISTS;
+	constexpr u32 QUERY_COUNT = (NUM_TIMESTAMP_QUERIES_PER_CMDLIST + MAX_GPU_TIMING_MARKERS) * NUM_COMMAND_LISTS;
 	constexpr u32 BUFFER_SIZE = sizeof(u64) * QUERY_COUNT;
 
 	const D3D12_QUERY_HEAP_DESC desc = {D3D12_QUERY_HEAP_TYPE_TIMESTAMP, QUERY_COUNT};
@@ -621,6 +715,52 @@ bool GSDevice12::SetGPUTimingEnabled(bool enabled)
 	return true;
 }
 
+bool GSDevice12::SetGPUTimingBreakdownEnabled(bool enabled)
+{
+	m_gpu_timing_breakdown = enabled;
+	return true;
+}
+
+void GSDevice12::WriteGPUTimingMarker()
+{
+	// Markers are only written when commands are actually recorded, so switching category
+	// back and forth without any work in between doesn't cost anything. The command list
+	// has no start marker if the breakdown was enabled after it began.
+	CommandListResources& res = m_command_lists[m_current_command_list];
+	const u32 count = res.num_timing_markers;
+	if (count == 0 || count >= (MAX_GPU_TIMING_MARKERS - 1) || res.timing_categories[count - 1] == m_gpu_timing_category)
+		return;
+
+	res.command_lists[1]->EndQuery(m_timestamp_query_heap.get(), D3D12_QUERY_TYPE_TIMESTAMP,
+		GetTimingMarkerQueryIndex(m_current_command_list, count));
+	res.timing_categories[count] = m_gpu_timing_category;
+	res.num_timing_markers = count + 1;
+}
+
+void GSDevice12::ReadGPUTimingMarkers(CommandListResources& res)
+{
+	const u32 offset = GetTimingMarkerQueryIndex(m_current_command_list, 0) * sizeof(u64);
+	const D3D12_RANGE read_range = {offset, offset + (sizeof(u64) * res.num_timing_markers)};
+	void* map;
+	HRESULT hr = m_timestamp_query_buffer->Map(0, &read_range, &map);
+	if (FAILED(hr))
+	{
+		Console.Warning("D3D12: Map() for timing breakdown query failed: %08X", hr);
+		return;
+	}
+
+	std::array<u64, MAX_GPU_TIMING_MARKERS> timestamps;
+	std::memcpy(timestamps.data(), static_cast<const u8*>(map) + offset, sizeof(u64) * res.num_timing_markers);
+	for (u32 i = 0; i < (res.num_timing_markers - 1); i++)
+	{
+		AddGPUTimingCategoryTime(res.timing_categories[i],
+			static_cast<double>(timestamps[i + 1] - timestamps[i]) / m_timestamp_frequency);
+	}
+
+	const D3D12_RANGE write_range = {};
+	m_timestamp_query_buffer->Unmap(0, &write_range);
+}
+
 bool GSDevice12::AllocatePreinitializedGPUBuffer(u32 size, ID3D12Resource** gpu_buffer,
 	D3D12MA::Allocation** gpu_allocation, const std::function<void(void*)>& fill_callback)
 {
@@ -747,6 +887,7 @@ bool GSDevice12::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 
 	InitializeState();
 	InitializeSamplers();
+	OpenPipelineUsageList("dx12", sizeof(PipelineSelector));
 	return true;
 }
 
@@ -1143,6 +1284,8 @@ void GSDevice12::EndPresent()
 	m_swap_chain->Present(sync_interval, flags);
 
 	InvalidateCachedState();
+
+	PrecompileTFXPipelines();
 }
 
 #ifdef ENABLE_OGL_DEBUG
@@ -1489,6 +1632,27 @@ void GSDevice12::ConvertToIndexedTexture(
 		m_convert[static_cast<int>(shader)].get(), false, true);
 }
 
+void GSDevice12::UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin,
+	u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM)
+{
+	// match merge cb
+	struct Uniforms
+	{
+		GSVector4 origin_texa;
+		u32 BP, BW, PSM;
+	};
+
+	const Uniforms cb = {GSVector4(static_cast<float>(origin.x), static_cast<float>(origin.y),
+							 static_cast<float>(TA0) / 255.0f, AEM ? 1.0f : 0.0f),
+		BP, BW, PSM};
+	SetUtilityRootSignature();
+	SetUtilityPushConstants(&cb, sizeof(cb));
+
+	const ShaderConvert shader = ShaderConvert::UNSWIZZLE_CT32;
+	DoStretchRect(static_cast<GSTexture12*>(sTex), GSVector4::zero(), static_cast<GSTexture12*>(dTex), GSVector4(dRect),
+		m_convert[static_cast<int>(shader)].get(), false, true);
+}
+
 void GSDevice12::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
 {
 	struct Uniforms
@@ -2288,9 +2452,26 @@ void GSDevice12::ClearSamplerCache()
 bool GSDevice12::GetTextureGroupDescriptors(
 	D3D12DescriptorHandle* gpu_handle, const D3D12DescriptorHandle* cpu_handles, u32 count)
 {
+	pxAssert(count <= NUM_TFX_TEXTURES);
+
+	// Texture sets tend to repeat within a command list, so reuse the table instead of copying again.
+	TextureGroupKey key = {};
+	key.count = count;
+	for (u32 i = 0; i < count; i++)
+		key.idx[i] = cpu_handles[i].index;
+
+	const auto it = m_texture_groups.find(key);
+	if (it != m_texture_groups.end())
+	{
+		*gpu_handle = it->second;
+		return true;
+	}
+
 	if (!GetDescriptorAllocator().Allocate(count, gpu_handle))
 		return false;
 
+	m_texture_groups.emplace(key, *gpu_handle);
+
 	if (count == 1)
 	{
 		m_device.get()->CopyDescriptorsSimple(
@@ -2301,7 +2482,6 @@ bool GSDevice12::GetTextureGroupDescriptors(
 	D3D12_CPU_DESCRIPTOR_HANDLE dst_handle = *gpu_handle;
 	D3D12_CPU_DESCRIPTOR_HANDLE src_handles[NUM_TFX_TEXTURES];
 	UINT src_sizes[NUM_TFX_TEXTURES];
-	pxAssert(count <= NUM_TFX_TEXTURES);
 	for (u32 i = 0; i < count; i++)
 	{
 		src_handles[i] = cpu_handles[i];
@@ -2828,6 +3008,7 @@ void GSDevice12::DestroyResources()
 		m_fence_event = {};
 	}
 
+	m_target_pool.reset();
 	m_allocator.reset();
 	m_command_queue.reset();
 	m_device.reset();
@@ -3042,11 +3223,35 @@ const ID3D12PipelineState* GSDevice12::GetTFXPipeline(const PipelineSelector& p)
 	if (it != m_tfx_pipelines.end())
 		return it->second.get();
 
+	g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
 	ComPtr<ID3D12PipelineState> pipeline(CreateTFXPipeline(p));
+	if (pipeline)
+		m_pipeline_usage.Record(&p);
+
 	it = m_tfx_pipelines.emplace(p, std::move(pipeline)).first;
 	return it->second.get();
 }
 
+void GSDevice12::PrecompileTFXPipelines()
+{
+	if (!m_pipeline_usage.HasPendingPrecompiles())
+		return;
+
+	// Spread the work over a few frames, so a long list doesn't stall presentation.
+	Common::Timer timer;
+	while (const void* data = m_pipeline_usage.GetNextPrecompile())
+	{
+		PipelineSelector p;
+		std::memcpy(&p, data, sizeof(p));
+		if (m_tfx_pipelines.find(p) == m_tfx_pipelines.end())
+			m_tfx_pipelines.emplace(p, CreateTFXPipeline(p));
+
+		if (timer.GetTimeMilliseconds() >= PIPELINE_PRECOMPILE_TIME_SLICE_MS)
+			break;
+	}
+}
+
 bool GSDevice12::BindDrawPipeline(const PipelineSelector& p)
 {
 	const ID3D12PipelineState* pipeline = GetTFXPipeline(p);
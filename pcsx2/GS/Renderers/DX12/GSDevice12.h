@@ -40,25 +40,46 @@ public:
 
 		/// Start/End timestamp queries.
 		NUM_TIMESTAMP_QUERIES_PER_CMDLIST = 2,
+
+		/// Timestamps per command list for the GPU time breakdown, including the one at the end.
+		/// These are placed after the start/end queries of all command lists.
+		MAX_GPU_TIMING_MARKERS = 128,
+
+		/// Heap size for placed render targets, larger targets are still committed.
+		TARGET_POOL_BLOCK_SIZE = 128 * 1024 * 1024,
+		MAX_PLACED_TARGET_SIZE = TARGET_POOL_BLOCK_SIZE / 4,
 	};
 
 	__fi IDXGIAdapter1* GetAdapter() const { return m_adapter.get(); }
 	__fi ID3D12Device* GetDevice() const { return m_device.get(); }
 	__fi ID3D12CommandQueue* GetCommandQueue() const { return m_command_queue.get(); }
 	__fi D3D12MA::Allocator* GetAllocator() const { return m_allocator.get(); }
+	__fi D3D12MA::Pool* GetTargetPool() const { return m_target_pool.get(); }
 
 	/// Returns the PCI vendor ID of the device, if known.
 	u32 GetAdapterVendorID() const;
 
 	/// Returns the current command list, commands can be recorded directly.
-	ID3D12GraphicsCommandList4* GetCommandList() const
+	ID3D12GraphicsCommandList4* GetCommandList()
 	{
+		if (m_gpu_timing_breakdown) [[unlikely]]
+			WriteGPUTimingMarker();
 		return m_command_lists[m_current_command_list].command_lists[1].get();
 	}
 
 	/// Returns the init command list for uploading.
 	ID3D12GraphicsCommandList4* GetInitCommandList();
 
+	/// Texture uploads to the init command list are batched, so all of them share one ResourceBarrier() call
+	/// before and after the copies. The batch is recorded when the init command list is needed for anything
+	/// else, or when it is executed.
+	u64 GetUploadBatchCounter() const { return m_upload_batch_counter; }
+	void AddUploadBatchResource(
+		ID3D12Resource* resource, D3D12_RESOURCE_STATES state_before, D3D12_RESOURCE_STATES state_after);
+	void QueueBatchedUpload(const D3D12_TEXTURE_COPY_LOCATION& dst, u32 x, u32 y,
+		const D3D12_TEXTURE_COPY_LOCATION& src, const D3D12_BOX& src_box);
+	void FlushUploadBatch();
+
 	/// Returns the per-frame SRV/CBV/UAV allocator.
 	D3D12DescriptorAllocator& GetDescriptorAllocator()
 	{
@@ -75,6 +96,10 @@ public:
 	/// and are going to re-use the handles from GetSamplerHeapManager().
 	void InvalidateSamplerGroups();
 
+	/// Drops the cached texture descriptor tables. Call after freeing handles from GetDescriptorHeapManager(),
+	/// since a new texture may be given the same index within the current command list.
+	void InvalidateTextureGroups();
+
 	// Descriptor manager access.
 	D3D12DescriptorHeapManager& GetDescriptorHeapManager() { return m_descriptor_heap_manager; }
 	D3D12DescriptorHeapManager& GetRTVHeapManager() { return m_rtv_heap_manager; }
@@ -142,19 +167,40 @@ private:
 		u64 ready_fence_value = 0;
 		bool init_command_list_used = false;
 		bool has_timestamp_query = false;
+
+		// Category of the work following each breakdown timestamp.
+		std::array<GPUTimingCategory, MAX_GPU_TIMING_MARKERS> timing_categories;
+		u32 num_timing_markers = 0;
 	};
 
 	bool CreateDevice(u32& vendor_id);
 	bool CreateDescriptorHeaps();
 	bool CreateCommandLists();
 	bool CreateTimestampQuery();
+	static constexpr u32 GetTimingMarkerQueryIndex(u32 cmdlist, u32 marker)
+	{
+		return (NUM_TIMESTAMP_QUERIES_PER_CMDLIST * NUM_COMMAND_LISTS) + (cmdlist * MAX_GPU_TIMING_MARKERS) + marker;
+	}
+	void ReadGPUTimingMarkers(CommandListResources& res);
+	void WriteGPUTimingMarker();
 	void MoveToNextCommandList();
 	void DestroyPendingResources(CommandListResources& cmdlist);
+	ID3D12GraphicsCommandList4* BeginInitCommandList();
+
+	struct BatchedUpload
+	{
+		D3D12_TEXTURE_COPY_LOCATION dst;
+		D3D12_TEXTURE_COPY_LOCATION src;
+		D3D12_BOX src_box;
+		u32 x;
+		u32 y;
+	};
 
 	ComPtr<IDXGIAdapter1> m_adapter;
 	ComPtr<ID3D12Device> m_device;
 	ComPtr<ID3D12CommandQueue> m_command_queue;
 	ComPtr<D3D12MA::Allocator> m_allocator;
+	ComPtr<D3D12MA::Pool> m_target_pool;
 
 	ComPtr<ID3D12Fence> m_fence;
 	HANDLE m_fence_event = {};
@@ -164,6 +210,11 @@ private:
 	std::array<CommandListResources, NUM_COMMAND_LISTS> m_command_lists;
 	u32 m_current_command_list = NUM_COMMAND_LISTS - 1;
 
+	std::vector<BatchedUpload> m_upload_batch;
+	std::vector<D3D12_RESOURCE_BARRIER> m_upload_batch_pre_barriers;
+	std::vector<D3D12_RESOURCE_BARRIER> m_upload_batch_post_barriers;
+	u64 m_upload_batch_counter = 1;
+
 	ComPtr<ID3D12QueryHeap> m_timestamp_query_heap;
 	ComPtr<ID3D12Resource> m_timestamp_query_buffer;
 	ComPtr<D3D12MA::Allocation> m_timestamp_query_allocation;
@@ -327,6 +378,25 @@ private:
 		m_tfx_pixel_shaders;
 	std::unordered_map<PipelineSelector, ComPtr<ID3D12PipelineState>, PipelineSelectorHash> m_tfx_pipelines;
 
+	// Descriptor tables already copied to the current command list's heap, keyed by the source handles.
+	struct TextureGroupKey
+	{
+		u32 count;
+		u32 idx[NUM_TFX_TEXTURES];
+
+		__fi bool operator==(const TextureGroupKey& rhs) const { return BitEqual(*this, rhs); }
+	};
+	struct TextureGroupKeyHash
+	{
+		__fi std::size_t operator()(const TextureGroupKey& key) const noexcept
+		{
+			std::size_t h = 0;
+			HashCombine(h, key.count, key.idx[0], key.idx[1]);
+			return h;
+		}
+	};
+	std::unordered_map<TextureGroupKey, D3D12DescriptorHandle, TextureGroupKeyHash> m_texture_groups;
+
 	ComPtr<ID3D12RootSignature> m_cas_root_signature;
 	ComPtr<ID3D12PipelineState> m_cas_upscale_pipeline;
 	ComPtr<ID3D12PipelineState> m_cas_sharpen_pipeline;
@@ -369,6 +439,7 @@ private:
 	const ID3DBlob* GetTFXPixelShader(const GSHWDrawConfig::PSSelector& sel);
 	ComPtr<ID3D12PipelineState> CreateTFXPipeline(const PipelineSelector& p);
 	const ID3D12PipelineState* GetTFXPipeline(const PipelineSelector& p);
+	void PrecompileTFXPipelines();
 
 	ComPtr<ID3DBlob> GetUtilityVertexShader(const std::string& source, const char* entry_point);
 	ComPtr<ID3DBlob> GetUtilityPixelShader(const std::string& source, const char* entry_point);
@@ -415,6 +486,7 @@ public:
 
 	bool SetGPUTimingEnabled(bool enabled) override;
 	float GetAndResetAccumulatedGPUTime() override;
+	bool SetGPUTimingBreakdownEnabled(bool enabled) override;
 
 	void PushDebugGroup(const char* fmt, ...) override;
 	void PopDebugGroup() override;
@@ -438,6 +510,8 @@ public:
 		GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize) override;
 	void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM,
 		GSTexture* dTex, u32 DBW, u32 DPSM) override;
+	void UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP,
+		u32 BW, u32 PSM, u32 TA0, bool AEM) override;
 	void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) override;
 
 	void DrawMultiStretchRects(
@@ -70,6 +70,7 @@ void GSTexture12::Destroy(bool defer)
 	}
 	else
 	{
+		dev->InvalidateTextureGroups();
 		dev->GetDescriptorHeapManager().Free(&m_srv_descriptor);
 
 		switch (m_write_descriptor_type)
@@ -132,9 +133,7 @@ std::unique_ptr<GSTexture12> GSTexture12::Create(Type type, Format format, int w
 
 		case Type::RenderTarget:
 		{
-			// RT's tend to be larger, so we'll keep them committed for speed.
 			pxAssert(levels == 1);
-			allocationDesc.Flags |= D3D12MA::ALLOCATION_FLAG_COMMITTED;
 			desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
 			optimized_clear_value.Format = rtv_format;
 			state = D3D12_RESOURCE_STATE_RENDER_TARGET;
@@ -144,7 +143,6 @@ std::unique_ptr<GSTexture12> GSTexture12::Create(Type type, Format format, int w
 		case Type::DepthStencil:
 		{
 			pxAssert(levels == 1);
-			allocationDesc.Flags |= D3D12MA::ALLOCATION_FLAG_COMMITTED;
 			desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
 			optimized_clear_value.Format = dsv_format;
 			state = D3D12_RESOURCE_STATE_DEPTH_WRITE;
@@ -166,6 +164,18 @@ std::unique_ptr<GSTexture12> GSTexture12::Create(Type type, Format format, int w
 	if (uav_format != DXGI_FORMAT_UNKNOWN)
 		desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 
+	// Small targets come from the placed target pool, large ones stay committed.
+	bool placed_target = false;
+	if (type == Type::RenderTarget || type == Type::DepthStencil)
+	{
+		const D3D12_RESOURCE_ALLOCATION_INFO alloc_info = dev->GetDevice()->GetResourceAllocationInfo(0, 1, &desc);
+		placed_target = (dev->GetTargetPool() && alloc_info.SizeInBytes <= GSDevice12::MAX_PLACED_TARGET_SIZE);
+		if (placed_target)
+			allocationDesc.CustomPool = dev->GetTargetPool();
+		else
+			allocationDesc.Flags |= D3D12MA::ALLOCATION_FLAG_COMMITTED;
+	}
+
 	wil::com_ptr_nothrow<ID3D12Resource> resource;
 	wil::com_ptr_nothrow<D3D12MA::Allocation> allocation;
 	HRESULT hr = dev->GetAllocator()->CreateResource(&allocationDesc, &desc, state,
@@ -180,6 +190,10 @@ std::unique_ptr<GSTexture12> GSTexture12::Create(Type type, Format format, int w
 		return {};
 	}
 
+	// Placed targets have undefined contents and must be discarded, cleared or copied to before first use.
+	if (placed_target)
+		dev->GetInitCommandList()->DiscardResource(resource.get(), nullptr);
+
 	D3D12DescriptorHandle srv_descriptor, write_descriptor, uav_descriptor;
 	WriteDescriptorType write_descriptor_type = WriteDescriptorType::None;
 	if (srv_format != DXGI_FORMAT_UNKNOWN)
@@ -394,6 +408,34 @@ void GSTexture12::CopyTextureDataForUpload(void* dst, const void* src, u32 pitch
 	StringUtil::StrideMemCpy(dst, upload_pitch, src, pitch, std::min(upload_pitch, pitch), count);
 }
 
+bool GSTexture12::CanBatchUpload() const
+{
+	// Same condition as GetCommandBufferForUpdate() using the init command list.
+	return (m_type == Type::Texture && m_use_fence_counter != GSDevice12::GetInstance()->GetCurrentFenceValue());
+}
+
+void GSTexture12::QueueBatchedUpload(int level, u32 x, u32 y, const D3D12_TEXTURE_COPY_LOCATION& srcloc,
+	const D3D12_BOX& srcbox)
+{
+	GSDevice12* const dev = GSDevice12::GetInstance();
+
+	// The batch transitions the whole resource, and leaves it in the same state as an unbatched upload would.
+	if (m_upload_batch != dev->GetUploadBatchCounter())
+	{
+		const D3D12_RESOURCE_STATES state_after =
+			(m_resource_state == D3D12_RESOURCE_STATE_COMMON) ? D3D12_RESOURCE_STATE_COPY_DEST : m_resource_state;
+		dev->AddUploadBatchResource(m_resource.get(), m_resource_state, state_after);
+		m_resource_state = state_after;
+		m_upload_batch = dev->GetUploadBatchCounter();
+	}
+
+	D3D12_TEXTURE_COPY_LOCATION dstloc;
+	dstloc.pResource = m_resource.get();
+	dstloc.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+	dstloc.SubresourceIndex = level;
+	dev->QueueBatchedUpload(dstloc, x, y, srcloc, srcbox);
+}
+
 bool GSTexture12::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
 	if (layer >= m_mipmap_levels)
@@ -446,6 +488,15 @@ bool GSTexture12::Update(const GSVector4i& r, const void* data, int pitch, int l
 		sbuffer.CommitMemory(required_size);
 	}
 
+	if (CanBatchUpload())
+	{
+		const D3D12_BOX srcbox{0u, 0u, 0u, width, height, 1u};
+		QueueBatchedUpload(layer, Common::AlignDownPow2((u32)r.x, block_size), Common::AlignDownPow2((u32)r.y, block_size),
+			srcloc, srcbox);
+		m_needs_mipmaps_generated |= (layer == 0);
+		return true;
+	}
+
 	ID3D12GraphicsCommandList* cmdlist = GetCommandBufferForUpdate();
 	GL_PUSH("GSTexture12::Update({%d,%d} %dx%d Lvl:%u", r.x, r.y, r.width(), r.height(), layer);
 
@@ -524,6 +575,24 @@ void GSTexture12::Unmap()
 	const u32 buffer_offset = buffer.GetCurrentOffset();
 	buffer.CommitMemory(required_size);
 
+	D3D12_TEXTURE_COPY_LOCATION srcloc;
+	srcloc.pResource = buffer.GetBuffer();
+	srcloc.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+	srcloc.PlacedFootprint.Offset = buffer_offset;
+	srcloc.PlacedFootprint.Footprint.Width = width;
+	srcloc.PlacedFootprint.Footprint.Height = height;
+	srcloc.PlacedFootprint.Footprint.Depth = 1;
+	srcloc.PlacedFootprint.Footprint.Format = m_dxgi_format;
+	srcloc.PlacedFootprint.Footprint.RowPitch = pitch;
+
+	if (CanBatchUpload())
+	{
+		const D3D12_BOX srcbox{0u, 0u, 0u, width, height, 1u};
+		QueueBatchedUpload(m_map_level, m_map_area.x, m_map_area.y, srcloc, srcbox);
+		m_needs_mipmaps_generated |= (m_map_level == 0);
+		return;
+	}
+
 	ID3D12GraphicsCommandList* cmdlist = GetCommandBufferForUpdate();
 	GL_PUSH("GSTexture12::Update({%d,%d} %dx%d Lvl:%u", m_map_area.x, m_map_area.y, m_map_area.width(),
 		m_map_area.height(), m_map_level);
@@ -543,16 +612,6 @@ void GSTexture12::Unmap()
 			m_state = State::Dirty;
 	}
 
-	D3D12_TEXTURE_COPY_LOCATION srcloc;
-	srcloc.pResource = buffer.GetBuffer();
-	srcloc.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-	srcloc.PlacedFootprint.Offset = buffer_offset;
-	srcloc.PlacedFootprint.Footprint.Width = width;
-	srcloc.PlacedFootprint.Footprint.Height = height;
-	srcloc.PlacedFootprint.Footprint.Depth = 1;
-	srcloc.PlacedFootprint.Footprint.Format = m_dxgi_format;
-	srcloc.PlacedFootprint.Footprint.RowPitch = pitch;
-
 	D3D12_TEXTURE_COPY_LOCATION dstloc;
 	dstloc.pResource = m_resource.get();
 	dstloc.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
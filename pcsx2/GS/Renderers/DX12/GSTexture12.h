@@ -82,6 +82,10 @@ private:
 	ID3D12Resource* AllocateUploadStagingBuffer(const void* data, u32 pitch, u32 upload_pitch, u32 height) const;
 	void CopyTextureDataForUpload(void* dst, const void* src, u32 pitch, u32 upload_pitch, u32 height) const;
 
+	// Uploads which would go to the init command list are batched by the device instead.
+	bool CanBatchUpload() const;
+	void QueueBatchedUpload(int level, u32 x, u32 y, const D3D12_TEXTURE_COPY_LOCATION& srcloc, const D3D12_BOX& srcbox);
+
 	wil::com_ptr_nothrow<ID3D12Resource> m_resource;
 	wil::com_ptr_nothrow<D3D12MA::Allocation> m_allocation;
 
@@ -97,6 +101,9 @@ private:
 	// When this matches the current fence counter, the texture was used this command buffer.
 	u64 m_use_fence_counter = 0;
 
+	// Upload batch counter of the device when this texture's barriers were added to the batch.
+	u64 m_upload_batch = 0;
+
 	int m_map_level = std::numeric_limits<int>::max();
 	GSVector4i m_map_area = GSVector4i::zero();
 };
@@ -7,11 +7,21 @@
 #include "GS/GSPerfMon.h"
 #include "GS/GSUtil.h"
 #include "Host.h"
+#include "PerformanceMetrics.h"
 #include "common/Console.h"
 #include "common/BitUtils.h"
 #include "common/StringUtil.h"
 #include <bit>
 
+static void RenderHWWithTimingCategory(GSHWDrawConfig& config)
+{
+	// Anything the texture cache does in between draws counts as a conversion.
+	g_gs_device->SetGPUTimingCategory(
+		config.ps.shuffle ? GSDevice::GPUTimingCategory::Shuffle : GSDevice::GPUTimingCategory::Draw);
+	g_gs_device->RenderHW(config);
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Conversion);
+}
+
 GSRendererHW::GSRendererHW()
 	: GSRenderer()
 {
@@ -90,6 +100,85 @@ void GSRendererHW::UpdateSettings(const Pcsx2Config::GSOptions& old_config)
 	GSRenderer::UpdateSettings(old_config);
 	m_mipmap = GSConfig.HWMipmap;
 	SetTCOffset();
+
+	// The multiplier has been reset to the user's setting, start over from there.
+	m_dynres_base_scale = 0.0f;
+	m_dynres_frames = 0;
+	m_dynres_idle_periods = 0;
+	m_present_skip_interval = 0;
+}
+
+void GSRendererHW::UpdateDynamicResolution()
+{
+	// Frames between each check, PerformanceMetrics only refreshes its averages every half second.
+	static constexpr u32 PERIOD_FRAMES = 30;
+
+	// Below this speed with the GPU this busy, the GPU is what's holding emulation back.
+	static constexpr float SLOW_SPEED = 95.0f;
+	static constexpr float BUSY_GPU_USAGE = 90.0f;
+
+	// Number of quiet periods needed before stepping back up, so we don't oscillate.
+	static constexpr float IDLE_GPU_USAGE = 70.0f;
+	static constexpr u32 IDLE_PERIODS = 4;
+
+	static constexpr float SCALE_STEP = 0.5f;
+	static constexpr u32 MAX_PRESENT_SKIP = 2;
+
+	if (!GSConfig.DynamicResolution || ++m_dynres_frames < PERIOD_FRAMES)
+		return;
+
+	m_dynres_frames = 0;
+	if (m_dynres_base_scale == 0.0f)
+		m_dynres_base_scale = GSConfig.UpscaleMultiplier;
+
+	// GPU usage rather than frame time, so that skipped presents and slow motion don't confuse it.
+	const float speed = PerformanceMetrics::GetSpeed();
+	const float gpu_usage = PerformanceMetrics::GetGPUUsage();
+	const float scale = GSConfig.UpscaleMultiplier;
+
+	if (speed < SLOW_SPEED && gpu_usage >= BUSY_GPU_USAGE)
+	{
+		m_dynres_idle_periods = 0;
+		if (scale > 1.0f)
+		{
+			SetDynamicResolutionScale(std::max(scale - SCALE_STEP, 1.0f));
+		}
+		else if (m_present_skip_interval < MAX_PRESENT_SKIP)
+		{
+			m_present_skip_interval++;
+			DevCon.WriteLnFmt("HW: Dynamic resolution skipping {} of every {} frames", m_present_skip_interval,
+				m_present_skip_interval + 1);
+		}
+
+		return;
+	}
+
+	if (gpu_usage >= IDLE_GPU_USAGE || ++m_dynres_idle_periods < IDLE_PERIODS)
+		return;
+
+	m_dynres_idle_periods = 0;
+	if (m_present_skip_interval > 0)
+	{
+		m_present_skip_interval--;
+		DevCon.WriteLnFmt("HW: Dynamic resolution skipping {} of every {} frames", m_present_skip_interval,
+			m_present_skip_interval + 1);
+	}
+	else if (scale < m_dynres_base_scale)
+	{
+		// Rendering cost goes with the pixel count, only step up if the next scale should still fit.
+		const float next_scale = std::min(scale + SCALE_STEP, m_dynres_base_scale);
+		if ((gpu_usage * (next_scale * next_scale) / (scale * scale)) < BUSY_GPU_USAGE)
+			SetDynamicResolutionScale(next_scale);
+	}
+}
+
+void GSRendererHW::SetDynamicResolutionScale(float scale)
+{
+	DevCon.WriteLnFmt("HW: Dynamic resolution {:.1f}x -> {:.1f}x", GSConfig.UpscaleMultiplier, scale);
+
+	// Targets are rescaled by the texture cache as they're looked up again, same as for a settings change.
+	GSConfig.UpscaleMultiplier = scale;
+	UpdateRenderFixes();
 }
 
 void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
@@ -97,6 +186,9 @@ void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 	if (GSConfig.LoadTextureReplacements)
 		GSTextureReplacements::ProcessAsyncLoadedTextures();
 
+	// Kick off downloads for targets we expect to be read next frame, so they're in flight with this frame's submission.
+	g_texture_cache->QueueSpeculativeReadbacks();
+
 	if (!idle_frame)
 	{
 		// If it did draws very recently, we should keep the recent stuff in case it hasn't been preloaded/used yet.
@@ -126,7 +218,8 @@ void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 		GL_INS("HW: No draws or transfers, not aging TC");
 	}
 
-	if (g_texture_cache->GetHashCacheMemoryUsage() > 1024 * 1024 * 1024)
+	// With a budget set, the texture cache evicts by itself instead.
+	if (GSConfig.HashCacheBudget == 0 && g_texture_cache->GetHashCacheMemoryUsage() > 1024 * 1024 * 1024)
 	{
 		Host::AddKeyedOSDMessage("HashCacheOverflow",
 			fmt::format(TRANSLATE_FS("GS", "Hash cache has used {:.2f} MB of VRAM, disabling."),
@@ -140,6 +233,8 @@ void GSRendererHW::VSync(u32 field, bool registers_written, bool idle_frame)
 	m_skip = 0;
 	m_skip_offset = 0;
 
+	UpdateDynamicResolution();
+
 	GSRenderer::VSync(field, registers_written, idle_frame);
 }
 
@@ -1848,9 +1943,12 @@ void GSRendererHW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 		rect.z = 2048;
 		loop_w = true;
 	}
+	// The data is in local memory now, so sources using it can be rebuilt before the draw that needs them.
+	const GSOffset off = m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM);
 	if (loop_h || loop_w)
 	{
-		g_texture_cache->InvalidateVideoMem(m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM), rect);
+		g_texture_cache->InvalidateVideoMem(off, rect);
+		g_texture_cache->QueueIdleUpdates(off, rect);
 		if (loop_h)
 		{
 			rect.y = 0;
@@ -1861,10 +1959,19 @@ void GSRendererHW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 			rect.x = 0;
 			rect.z = r.z - 2048;
 		}
-		g_texture_cache->InvalidateVideoMem(m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM), rect);
+		g_texture_cache->InvalidateVideoMem(off, rect);
+		g_texture_cache->QueueIdleUpdates(off, rect);
 	}
 	else
-		g_texture_cache->InvalidateVideoMem(m_mem.GetOffset(BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM), r);
+	{
+		g_texture_cache->InvalidateVideoMem(off, r);
+		g_texture_cache->QueueIdleUpdates(off, r);
+	}
+}
+
+bool GSRendererHW::RunIdleWork()
+{
+	return g_texture_cache->RunIdleUpdates();
 }
 
 void GSRendererHW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut)
@@ -2319,6 +2426,9 @@ void GSRendererHW::Draw()
 {
 	static u32 num_skipped_channel_shuffle_draws = 0;
 
+	// Bring the GPU copy of local memory up to date with any transfers since the last draw.
+	g_texture_cache->SyncVRAMTexture();
+
 	// We mess with this state as an optimization, so take a copy and use that instead.
 	const GSDrawingContext* context = m_context;
 	m_cached_ctx.TEX0 = context->TEX0;
@@ -2357,6 +2467,7 @@ void GSRendererHW::Draw()
 			}
 
 			num_skipped_channel_shuffle_draws++;
+			g_perfmon.Put(GSPerfMon::ShuffleDrawsSkipped, 1);
 			return;
 		}
 
@@ -2391,7 +2502,8 @@ void GSRendererHW::Draw()
 
 				m_last_rt->UpdateValidity(valid_area);
 
-				g_gs_device->RenderHW(m_conf);
+				g_perfmon.Put(GSPerfMon::ShuffleDraws, 1);
+				RenderHWWithTimingCategory(m_conf);
 
 				if (GSConfig.DumpGSData)
 				{
@@ -3323,6 +3435,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				ds->m_TEX0.TBP0 = m_cached_ctx.ZBUF.Block();
+				g_texture_cache->IndexTarget(ds);
 				GSVector2i new_size = ds->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / zbuf_psm.pgs.y) * GSLocalMemory::m_psm[ds->m_TEX0.PSM].pgs.y);
@@ -3370,6 +3483,7 @@ void GSRendererHW::Draw()
 				// Thankfully this doesn't really happen, but catwoman moves the framebuffer backwards 1 page with a channel shuffle, which is really messy and not easy to deal with.
 				// Hopefully the quick channel shuffle will just guess this and run with it.
 				ds->m_TEX0.TBP0 += horizontal_offset;
+				g_texture_cache->IndexTarget(ds);
 				horizontal_offset = 0;
 			}
 
@@ -3547,6 +3661,7 @@ void GSRendererHW::Draw()
 				if (m_cached_ctx.FRAME.Block() == m_cached_ctx.TEX0.TBP0)
 					g_texture_cache->InvalidateVideoMem(context->offset.fb, m_r, false);
 
+				g_perfmon.Put(GSPerfMon::ShuffleDrawsSkipped, 1);
 				CleanupDraw(true);
 				return;
 			}
@@ -3620,6 +3735,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				rt->m_TEX0.TBP0 = m_cached_ctx.FRAME.Block();
+				g_texture_cache->IndexTarget(rt);
 				GSVector2i new_size = rt->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / frame_psm.pgs.y) * GSLocalMemory::m_psm[rt->m_TEX0.PSM].pgs.y);
@@ -3993,6 +4109,7 @@ void GSRendererHW::Draw()
 				if (m_cached_ctx.FRAME.Block() == m_cached_ctx.TEX0.TBP0)
 					g_texture_cache->InvalidateVideoMem(context->offset.fb, m_r, false);
 
+				g_perfmon.Put(GSPerfMon::ShuffleDrawsSkipped, 1);
 				CleanupDraw(true);
 				return;
 			}
@@ -4697,7 +4814,12 @@ void GSRendererHW::Draw()
 	const GSVector4i real_rect = m_r;
 
 	if (!skip_draw)
+	{
+		if (m_channel_shuffle || m_texture_shuffle)
+			g_perfmon.Put(GSPerfMon::ShuffleDraws, 1);
+
 		DrawPrims(rt, ds, src, tmm);
+	}
 
 
 	// Temporary source *must* be invalidated before normal, because otherwise it'll be double freed.
@@ -4913,7 +5035,8 @@ void GSRendererHW::HandleProvokingVertexFirst()
 	if (g_gs_device->Features().provoking_vertex_last || // device supports provoking last vertex
 	    m_conf.vs.iip ||                                 // we are doing Gouraud shading
 	    m_vt.m_primclass == GS_POINT_CLASS ||            // drawing points (one vertex per primitive; color is unambiguous)
-	    m_vt.m_primclass == GS_SPRITE_CLASS)             // drawing sprites (handled by the sprites -> triangles expand shader)
+	    m_vt.m_primclass == GS_SPRITE_CLASS ||           // drawing sprites (handled by the sprites -> triangles expand shader)
+	    m_vt.m_flat_provoking_eq == m_index.tail)        // the vertex trace already found all first/last colors equal
 		return;
 
 	const int n = GSUtil::GetClassVertexCount(m_vt.m_primclass);
@@ -8137,7 +8260,7 @@ __ri void GSRendererHW::DrawPrims(GSTextureCache::Target* rt, GSTextureCache::Ta
 	m_conf.drawlist = (m_conf.require_full_barrier && m_vt.m_primclass == GS_SPRITE_CLASS) ? &m_drawlist : nullptr;
 
 	if (!m_channel_shuffle_width)
-		g_gs_device->RenderHW(m_conf);
+		RenderHWWithTimingCategory(m_conf);
 	else
 		m_last_rt = rt;
 }
@@ -8930,6 +9053,9 @@ void GSRendererHW::ClearGSLocalMemory(const GSOffset& off, const GSVector4i& r,
 	GL_INS("HW: ClearGSLocalMemory(): %08X %d,%d => %d,%d @ BP %x BW %u %s", vert_color, r.x, r.y, r.z, r.w, off.bp(),
 		off.bw(), GSUtil::GetPSMName(off.psm()));
 
+	// Not every caller invalidates the cleared area, but the GPU copy of local memory still needs it.
+	g_texture_cache->InvalidateVRAMPages(off, r);
+
 	const u32 psm = (off.psm() == PSMCT32 && m_cached_ctx.FRAME.FBMSK == 0xFF000000u) ? PSMCT24 : off.psm();
 	const int format = GSLocalMemory::m_psm[psm].fmt;
 
@@ -9563,7 +9689,7 @@ void GSRendererHW::EndHLEHardwareDraw(bool force_copy_on_hazard /* = false */)
 	                      (!GSDevice::IsDualSourceBlendFactor(config.blend.src_factor) &&
 	                       !GSDevice::IsDualSourceBlendFactor(config.blend.dst_factor));
 
-	g_gs_device->RenderHW(m_conf);
+	RenderHWWithTimingCategory(m_conf);
 
 	if (copy)
 		g_gs_device->Recycle(copy);
@@ -186,6 +186,14 @@ private:
 
 	GSTextureCache::Target* m_last_rt;
 
+	// Dynamic resolution controller state. The base scale is the user's multiplier, zero until first used.
+	float m_dynres_base_scale = 0.0f;
+	u32 m_dynres_frames = 0;
+	u32 m_dynres_idle_periods = 0;
+
+	void UpdateDynamicResolution();
+	void SetDynamicResolutionScale(float scale);
+
 	GIFRegFRAME m_split_clear_start = {};
 	GIFRegZBUF m_split_clear_start_Z = {};
 	u32 m_split_clear_pages = 0; // if zero, inactive
@@ -232,6 +240,7 @@ public:
 	void Reset(bool hardware_reset) override;
 	void UpdateSettings(const Pcsx2Config::GSOptions& old_config) override;
 	void VSync(u32 field, bool registers_written, bool idle_frame) override;
+	bool RunIdleWork() override;
 
 	GSTexture* GetOutput(int i, float& scale, int& y_offset) override;
 	GSTexture* GetFeedbackOutput(float& scale) override;
@@ -31,7 +31,7 @@ std::unique_ptr<GSTextureCache> g_texture_cache;
 static u8* s_unswizzle_buffer;
 
 /// List of candidates for purging when the hash cache gets too large.
-static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, s32>> s_hash_cache_purge_list;
+static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, u64>> s_hash_cache_purge_list;
 
 #ifdef PCSX2_DEVBUILD
 // We can only set one texture name per command buffer, which would break our fancy texture cache RT/DS/texture naming.
@@ -62,6 +62,9 @@ GSTextureCache::~GSTextureCache()
 {
 	RemoveAll(true, true, true);
 
+	if (m_vram_texture)
+		g_gs_device->Recycle(m_vram_texture);
+
 	s_hash_cache_purge_list = {};
 	_aligned_free(s_unswizzle_buffer);
 }
@@ -75,6 +78,117 @@ void GSTextureCache::ReadbackAll()
 	}
 }
 
+namespace
+{
+	static constexpr u32 TARGET_LAYOUT_VERSION = 1;
+
+	enum TargetLayoutFlags : u32
+	{
+		TARGET_LAYOUT_FRAME = 1 << 0,
+		TARGET_LAYOUT_VALID_RGB = 1 << 1,
+		TARGET_LAYOUT_VALID_ALPHA_LOW = 1 << 2,
+		TARGET_LAYOUT_VALID_ALPHA_HIGH = 1 << 3,
+	};
+
+	struct TargetLayoutHeader
+	{
+		u32 version;
+		u32 count;
+	};
+
+	struct TargetLayoutRecord
+	{
+		u64 TEX0;
+		u32 type;
+		u32 flags;
+		s32 width;
+		s32 height;
+		s32 valid[4];
+		float scale;
+	};
+} // namespace
+
+void GSTextureCache::SaveTargetLayout(std::vector<u8>* data) const
+{
+	data->clear();
+
+	TargetLayoutHeader header = {TARGET_LAYOUT_VERSION, 0};
+	for (int type = 0; type < 2; type++)
+		header.count += static_cast<u32>(m_dst[type].size());
+
+	data->resize(sizeof(header) + sizeof(TargetLayoutRecord) * header.count);
+	std::memcpy(data->data(), &header, sizeof(header));
+
+	u8* ptr = data->data() + sizeof(header);
+	for (int type = 0; type < 2; type++)
+	{
+		for (const Target* t : m_dst[type])
+		{
+			TargetLayoutRecord rec = {};
+			rec.TEX0 = t->m_TEX0.U64;
+			rec.type = static_cast<u32>(type);
+			rec.flags = (t->m_is_frame ? TARGET_LAYOUT_FRAME : 0) | (t->m_valid_rgb ? TARGET_LAYOUT_VALID_RGB : 0) |
+						(t->m_valid_alpha_low ? TARGET_LAYOUT_VALID_ALPHA_LOW : 0) |
+						(t->m_valid_alpha_high ? TARGET_LAYOUT_VALID_ALPHA_HIGH : 0);
+			rec.width = t->m_unscaled_size.x;
+			rec.height = t->m_unscaled_size.y;
+			GSVector4i::store<false>(rec.valid, t->m_valid);
+			rec.scale = t->m_scale;
+			std::memcpy(ptr, &rec, sizeof(rec));
+			ptr += sizeof(rec);
+		}
+	}
+}
+
+void GSTextureCache::RestoreTargetLayout(std::span<const u8> data)
+{
+	TargetLayoutHeader header;
+	if (data.size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.version != TARGET_LAYOUT_VERSION || data.size() < sizeof(header) + sizeof(TargetLayoutRecord) * header.count)
+	{
+		Console.Warning("TC: Ignoring texture cache layout with version %u and %u targets.", header.version, header.count);
+		return;
+	}
+
+	// The upscale multiplier may have changed since the state was made, so targets which were upscaled
+	// pick up the current one. Native resolution targets (e.g. from the native scaling hacks) stay native.
+	const float current_scale = GSRendererHW::GetInstance()->GetTextureScaleFactor();
+
+	// Lists are most recently used first, so walk them backwards to end up with the same order.
+	u32 restored = 0;
+	for (u32 i = header.count; i > 0; i--)
+	{
+		TargetLayoutRecord rec;
+		std::memcpy(&rec, data.data() + sizeof(header) + sizeof(rec) * (i - 1), sizeof(rec));
+		if (rec.type > DepthStencil || rec.width <= 0 || rec.height <= 0)
+			continue;
+
+		GIFRegTEX0 TEX0;
+		TEX0.U64 = rec.TEX0;
+
+		const GSVector4i valid = GSVector4i::load<false>(rec.valid);
+		const GSVector2i size(rec.width, rec.height);
+		const GSVector2i valid_size(std::max(valid.z, 1), std::max(valid.w, 1));
+		const float scale = (rec.scale == 1.0f) ? 1.0f : current_scale;
+
+		Target* dst = CreateTarget(TEX0, size, valid_size, scale, static_cast<int>(rec.type), false, 0,
+			(rec.flags & TARGET_LAYOUT_FRAME) != 0, true, true);
+		if (!dst)
+			continue;
+
+		dst->m_valid_rgb = (rec.flags & TARGET_LAYOUT_VALID_RGB) != 0;
+		dst->m_valid_alpha_low = (rec.flags & TARGET_LAYOUT_VALID_ALPHA_LOW) != 0;
+		dst->m_valid_alpha_high = (rec.flags & TARGET_LAYOUT_VALID_ALPHA_HIGH) != 0;
+		dst->Update();
+		restored++;
+	}
+
+	DevCon.WriteLn("TC: Restored %u of %u targets from save state.", restored, header.count);
+}
+
 void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 {
 	InvalidateTemporaryZ();
@@ -84,6 +198,14 @@ void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 		m_src.RemoveAll();
 		m_palette_map.Clear();
 		m_source_memory_usage = 0;
+
+		// Loading a state writes to local memory directly, so the GPU copy has to be uploaded again.
+		if (m_vram_texture && !GSConfig.GPUTextureUnswizzle)
+		{
+			g_gs_device->Recycle(m_vram_texture);
+			m_vram_texture = nullptr;
+		}
+		m_vram_dirty_pages.set();
 	}
 
 	if (targets)
@@ -98,6 +220,7 @@ void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 
 		m_target_heights.clear();
 		m_surface_offset_cache.clear();
+		m_readback_predictions.clear();
 		m_target_memory_usage = 0;
 	}
 
@@ -148,6 +271,8 @@ void GSTextureCache::AddDirtyRectTarget(Target* target, GSVector4i rect, u32 psm
 	if (rect.rempty())
 		return;
 
+	target->DiscardSpeculativeReadback();
+
 	std::vector<GSDirtyRect>::iterator it = target->m_dirty.end();
 	while (it != target->m_dirty.begin())
 	{
@@ -1008,7 +1133,7 @@ __ri static GSTextureCache::Source* FindSourceInMap(const GIFRegTEX0& TEX0, cons
 				// We request a palette texture (psm_s.pal). If the texture was
 				// converted by the CPU (!s->m_palette), we need to ensure
 				// palette content is the same.
-				if (!s->m_palette && !s->ClutMatch({clut, psm_s.pal}))
+				if (!s->m_palette && !s->ClutMatch(GSTextureCache::PaletteKey::Create(clut, psm_s.pal)))
 					continue;
 			}
 			else
@@ -1614,6 +1739,7 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 							}
 							t->m_valid_rgb = true;
 							t->m_TEX0 = dst_match->m_TEX0;
+							IndexTarget(t);
 							break;
 						}
 					}
@@ -2153,7 +2279,7 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 
 		if (gpu_clut)
 			AttachPaletteToSource(src, gpu_clut);
-		else if (src->m_palette && (!src->m_palette_obj || !src->ClutMatch({clut, psm_s.pal})))
+		else if (src->m_palette && (!src->m_palette_obj || !src->ClutMatch(PaletteKey::Create(clut, psm_s.pal))))
 			AttachPaletteToSource(src, psm_s.pal, true, true);
 	}
 
@@ -2540,6 +2666,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 							t->m_TEX0.TBW = TEX0.TBW;
 							t->m_valid = dirty_rect;
 							t->m_end_block = GSLocalMemory::GetEndBlockAddress(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM, t->m_valid);
+							IndexTarget(t);
 							t->m_drawn_since_read = GSVector4i::zero();
 						}
 						else
@@ -3057,6 +3184,7 @@ GSTextureCache::Target* GSTextureCache::LookupTarget(GIFRegTEX0 TEX0, const GSVe
 			dst->m_32_bits_fmt = dst_match->m_32_bits_fmt;
 			dst->OffsetHack_modxy = dst_match->OffsetHack_modxy;
 			dst->m_end_block = dst_match->m_end_block; // If we're copying the size, we need to keep the end block.
+			IndexTarget(dst);
 			dst->m_valid = dst_match->m_valid;
 			dst->m_valid_alpha_low = dst_match->m_valid_alpha_low; //&& psm_s.trbpp != 24;
 			dst->m_valid_alpha_high = dst_match->m_valid_alpha_high; //&& psm_s.trbpp != 24;
@@ -3634,6 +3762,7 @@ bool GSTextureCache::PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, cons
 							dst->m_valid = t->m_valid;
 							dst->m_drawn_since_read = t->m_drawn_since_read;
 							dst->m_end_block = t->m_end_block;
+							IndexTarget(dst);
 							dst->m_valid_rgb = true;
 							t->m_valid_rgb = false;
 							t->m_was_dst_matched = true;
@@ -4245,11 +4374,57 @@ void GSTextureCache::InvalidateContainedTargets(u32 start_bp, u32 end_bp, u32 wr
 	}
 }
 
+void GSTextureCache::IndexTarget(Target* t)
+{
+	const u32 start_page = t->m_TEX0.TBP0 >> 5;
+	const u32 num_pages = std::min<u32>((t->UnwrappedEndBlock() >> 5) - start_page + 1, GS_MAX_PAGES);
+	if (t->m_indexed_num_pages == num_pages && t->m_indexed_page == start_page)
+		return;
+
+	UnindexTarget(t);
+
+	std::array<u16, GS_MAX_PAGES>& counts = m_target_page_count[t->m_type];
+	for (u32 i = 0; i < num_pages; i++)
+		counts[(start_page + i) % GS_MAX_PAGES]++;
+
+	t->m_indexed_page = static_cast<u16>(start_page);
+	t->m_indexed_num_pages = static_cast<u16>(num_pages);
+}
+
+void GSTextureCache::UnindexTarget(Target* t)
+{
+	std::array<u16, GS_MAX_PAGES>& counts = m_target_page_count[t->m_type];
+	for (u32 i = 0; i < t->m_indexed_num_pages; i++)
+	{
+		pxAssert(counts[(t->m_indexed_page + i) % GS_MAX_PAGES] > 0);
+		counts[(t->m_indexed_page + i) % GS_MAX_PAGES]--;
+	}
+
+	t->m_indexed_num_pages = 0;
+}
+
+bool GSTextureCache::HasTargetsInRange(int type, u32 start_bp, u32 end_bp) const
+{
+	const std::array<u16, GS_MAX_PAGES>& counts = m_target_page_count[type];
+	const u32 start_page = start_bp >> 5;
+	const u32 num_pages = std::min<u32>((std::max(start_bp, end_bp) >> 5) - start_page + 1, GS_MAX_PAGES);
+	for (u32 i = 0; i < num_pages; i++)
+	{
+		if (counts[(start_page + i) % GS_MAX_PAGES] != 0)
+			return true;
+	}
+
+	return false;
+}
+
 // Goal: Depth And Target at the same address is not possible. On GS it is
 // the same memory but not on the Dx/GL. Therefore a write to the Depth/Target
 // must invalidate the Target/Depth respectively
 void GSTextureCache::InvalidateVideoMemType(int type, u32 bp, u32 write_psm, u32 write_fbmsk, bool dirty_only)
 {
+	if (!HasTargetsInRange(type, bp, bp))
+		return;
+
 	auto& list = m_dst[type];
 	for (auto i = list.begin(); i != list.end(); ++i)
 	{
@@ -4310,6 +4485,8 @@ void GSTextureCache::InvalidateVideoMemType(int type, u32 bp, u32 write_psm, u32
 // Called each time you want to write to the GS memory
 void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& rect, bool target)
 {
+	InvalidateVRAMPages(off, rect);
+
 	const u32 bp = off.bp();
 	const u32 bw = off.bw();
 	const u32 psm = off.psm();
@@ -4437,6 +4614,10 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 
 	for (int type = 0; type < 2; type++)
 	{
+		// Most writes don't touch any target of the other type, skip the walk if nothing is there.
+		if (!HasTargetsInRange(type, bp, end_bp))
+			continue;
+
 		auto& list = m_dst[type];
 		for (auto i = list.begin(); i != list.end();)
 		{
@@ -4516,6 +4697,103 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 // Goal: retrive the data from the GPU to the GS memory.
 // Called each time you want to read from the GS memory.
 // full_flush is set when it's a Local->Local stransfer and both src and destination are the same.
+void GSTextureCache::QueueIdleUpdates(const GSOffset& off, const GSVector4i& rect)
+{
+	const u32 psm = off.psm();
+
+	off.loopPages(rect, [this, psm](u32 page) {
+		for (Source* s : m_src.m_map[page])
+		{
+			// Only bother with sources the game sampled recently, anything older is unlikely to be drawn with again.
+			// Targets and hash cache sources don't read local memory on update.
+			if (s->m_idle_update_queued || s->m_target || s->m_from_hash_cache || s->m_age > 1 ||
+				(s->m_complete_layers & 1u) || !GSUtil::HasSharedBits(psm, s->m_TEX0.PSM))
+			{
+				continue;
+			}
+
+			s->m_idle_update_queued = true;
+			m_src.m_idle_updates.push_back(s);
+		}
+	});
+}
+
+bool GSTextureCache::RunIdleUpdates()
+{
+	// Keep each call short, the GS thread checks for new packets in between.
+	static constexpr u32 MAX_UPDATES_PER_CALL = 4;
+
+	std::vector<Source*>& queue = m_src.m_idle_updates;
+	for (u32 i = 0; i < MAX_UPDATES_PER_CALL && !queue.empty(); i++)
+	{
+		Source* s = queue.back();
+		queue.pop_back();
+		s->m_idle_update_queued = false;
+
+		// Anything the EE wrote since the transfer just invalidates the blocks again, so there's nothing to
+		// cancel here. The draw picks up whatever's left, same as without the idle update.
+		if (s->m_complete_layers & 1u)
+			continue;
+
+		// Update() marks the source as used, but it hasn't been, so don't let this keep it alive.
+		const int age = s->m_age;
+		s->Update(s->m_region.GetRect(1 << s->m_TEX0.TW, 1 << s->m_TEX0.TH));
+		s->m_age = age;
+	}
+
+	if (queue.empty() && m_compaction_pending)
+		Compact();
+
+	return !queue.empty();
+}
+
+void GSTextureCache::Compact()
+{
+	m_compaction_pending = false;
+	m_last_compaction_frame = m_frame_counter;
+	m_compaction_count++;
+
+	// Anything which wasn't looked up since the last pass is most likely from a previous scene.
+	const size_t old_surface_offsets = m_surface_offset_cache.size();
+	for (auto it = m_surface_offset_cache.begin(); it != m_surface_offset_cache.end();)
+	{
+		if ((m_frame_counter - it->second.last_used) >= COMPACTION_INTERVAL)
+			it = m_surface_offset_cache.erase(it);
+		else
+			++it;
+	}
+
+	const u32 removed_palettes = m_palette_map.Compact();
+
+	const size_t old_list_memory = GetCacheStats().list_memory;
+	for (FastList<Source*>& list : m_src.m_map)
+		list.shrink_to_fit();
+	for (FastList<Target*>& list : m_dst)
+		list.shrink_to_fit();
+	m_target_heights.shrink_to_fit();
+
+	const CacheStats stats = GetCacheStats();
+	GL_INS("TC: Compaction removed %zu surface offsets and %u palettes, freed %zu bytes of list storage.",
+		old_surface_offsets - stats.surface_offsets, removed_palettes, old_list_memory - stats.list_memory);
+	DevCon.WriteLn("TC: Compacted to %zu surface offsets, %zu palettes, %zu hash cache entries, %zu KB of lists.",
+		stats.surface_offsets, stats.palettes, stats.hash_cache_entries, stats.list_memory / 1024);
+}
+
+GSTextureCache::CacheStats GSTextureCache::GetCacheStats() const
+{
+	CacheStats stats;
+	stats.surface_offsets = m_surface_offset_cache.size();
+	stats.palettes = m_palette_map.GetSize();
+	stats.hash_cache_entries = m_hash_cache.size();
+	stats.list_memory = m_target_heights.memory_usage();
+	for (const FastList<Source*>& list : m_src.m_map)
+		stats.list_memory += list.memory_usage();
+	for (const FastList<Target*>& list : m_dst)
+		stats.list_memory += list.memory_usage();
+	stats.compactions = m_compaction_count;
+	return stats;
+}
+
 void GSTextureCache::InvalidateLocalMem(const GSOffset& off, const GSVector4i& r, bool full_flush)
 {
 	const u32 bp = off.bp();
@@ -4869,15 +5147,9 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 		return false;
 	}
 
-	// DX11/12 is a bit lame and can't partial copy depth targets. We could do this with a blit instead,
-	// but so far haven't seen anything which needs it.
+	// DX11/12 is a bit lame and can't partial copy depth targets, so those go through a blit instead.
 	const GSRendererType renderer = GSGetCurrentRenderer();
 	const bool renderer_is_directx = (renderer == GSRendererType::DX11 || renderer == GSRendererType::DX12);
-	if (renderer_is_directx)
-	{
-		if (spsm_s.depth || dpsm_s.depth)
-			return false;
-	}
 
 	bool req_resize = false;
 
@@ -4954,6 +5226,7 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 			if (dst->m_was_dst_matched)
 			{
 				dst->m_TEX0 = new_TEX0;
+				IndexTarget(dst);
 			}
 		}
 
@@ -4964,7 +5237,12 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 		dst->OffsetHack_modxy = src->OffsetHack_modxy;
 	}
 
-	if (!src || !dst || src->m_scale != dst->m_scale)
+	if (!src || !dst)
+		return false;
+
+	// Targets at different scales get blitted, but overlapping moves go through a temporary copy at the source scale.
+	const bool scale_mismatch = (src->m_scale != dst->m_scale);
+	if (scale_mismatch && SBP == DBP)
 		return false;
 
 	// If we have an offset, adjust the base positions
@@ -4989,10 +5267,12 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 	const float scale = src->m_scale;
 	const int scaled_sx = static_cast<int>(sx * scale);
 	const int scaled_sy = static_cast<int>(sy * scale);
-	const int scaled_dx = static_cast<int>(dx * scale);
-	const int scaled_dy = static_cast<int>(dy * scale);
 	const int scaled_w = static_cast<int>(w * scale);
 	const int scaled_h = static_cast<int>(h * scale);
+	const int scaled_dx = static_cast<int>(dx * dst->m_scale);
+	const int scaled_dy = static_cast<int>(dy * dst->m_scale);
+	const int scaled_dw = static_cast<int>(w * dst->m_scale);
+	const int scaled_dh = static_cast<int>(h * dst->m_scale);
 
 	// The source isn't in our texture, otherwise it could falsely expand the texture causing a misdetection later, which then renders black.
 	if ((scaled_sx + scaled_w) > src->m_texture->GetWidth() || (scaled_sy + scaled_h) > src->m_texture->GetHeight())
@@ -5015,8 +5295,8 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 	g_texture_cache->InvalidateVideoMemType(GSTextureCache::DepthStencil - dst->m_type, dst->m_TEX0.TBP0);
 
 	// Expand the target when we used a more conservative size.
-	const int required_dh = scaled_dy + scaled_h;
-	if ((scaled_dx + scaled_w) <= dst->m_texture->GetWidth() && required_dh > dst->m_texture->GetHeight())
+	const int required_dh = scaled_dy + scaled_dh;
+	if ((scaled_dx + scaled_dw) <= dst->m_texture->GetWidth() && required_dh > dst->m_texture->GetHeight())
 	{
 		int new_height = dy + h;
 		if (new_height > GSRendererHW::MAX_FRAMEBUFFER_HEIGHT)
@@ -5039,7 +5319,7 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 	}
 
 	// Make sure the copy doesn't go out of bounds (it shouldn't).
-	if ((scaled_dx + scaled_w) > dst->m_texture->GetWidth() || (scaled_dy + scaled_h) > dst->m_texture->GetHeight())
+	if ((scaled_dx + scaled_dw) > dst->m_texture->GetWidth() || (scaled_dy + scaled_dh) > dst->m_texture->GetHeight())
 		return false;
 	GL_CACHE("TC: HW Move after draw %d 0x%x[BW:%u PSM:%s] to 0x%x[BW:%u PSM:%s] <%d,%d->%d,%d> -> <%d,%d->%d,%d>", GSState::s_n, SBP, SBW,
 		GSUtil::GetPSMName(SPSM), DBP, DBW, GSUtil::GetPSMName(DPSM), sx, sy, sx + w, sy + h, dx, dy, dx + w, dy + h);
@@ -5105,7 +5385,7 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 			ShaderConvert shader = ShaderConvert::COPY;
 
 			const GSVector4 src_rect = GSVector4(scaled_sx, scaled_sy, scaled_sx + scaled_w, scaled_sy + scaled_h) / (GSVector4(src->m_texture->GetSize()).xyxy());
-			const GSVector4 dst_rect = GSVector4(scaled_dx, scaled_dy, (scaled_dx + scaled_w), (scaled_dy + scaled_h));
+			const GSVector4 dst_rect = GSVector4(scaled_dx, scaled_dy, (scaled_dx + scaled_dw), (scaled_dy + scaled_dh));
 			g_gs_device->StretchRect(src->m_texture, src_rect, dst->m_texture, dst_rect, false, false, false, true, shader);
 		}
 		else if (src->m_type != dst->m_type)
@@ -5124,7 +5404,15 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 					break;
 			}
 			const GSVector4 src_rect = GSVector4(scaled_sx, scaled_sy, scaled_sx + scaled_w, scaled_sy + scaled_h) / (GSVector4(src->m_texture->GetSize()).xyxy());
-			g_gs_device->StretchRect(src->m_texture, src_rect, dst->m_texture, GSVector4(scaled_sx, scaled_sy, scaled_sx + scaled_w, scaled_sy + scaled_h), shader, false);
+			const GSVector4 dst_rect = GSVector4(scaled_dx, scaled_dy, (scaled_dx + scaled_dw), (scaled_dy + scaled_dh));
+			g_gs_device->StretchRect(src->m_texture, src_rect, dst->m_texture, dst_rect, shader, false);
+		}
+		else if (scale_mismatch || (renderer_is_directx && dst->m_texture->IsDepthStencil()))
+		{
+			const ShaderConvert shader = dst->m_texture->IsDepthStencil() ? ShaderConvert::DEPTH_COPY : ShaderConvert::COPY;
+			const GSVector4 src_rect = GSVector4(scaled_sx, scaled_sy, scaled_sx + scaled_w, scaled_sy + scaled_h) / (GSVector4(src->m_texture->GetSize()).xyxy());
+			const GSVector4 dst_rect = GSVector4(scaled_dx, scaled_dy, (scaled_dx + scaled_dw), (scaled_dy + scaled_dh));
+			g_gs_device->StretchRect(src->m_texture, src_rect, dst->m_texture, dst_rect, shader, false);
 		}
 		else
 		{
@@ -5345,6 +5633,8 @@ void GSTextureCache::CopyPages(Target* src, u32 sbw, u32 src_offset, Target* dst
 	GL_PUSH("TC: GSTextureCache::CopyPages(): %u pages at %x[eff %x] BW %u to %x[eff %x] BW %u", num_pages,
 		src->m_TEX0.TBP0, src->m_TEX0.TBP0 + src_offset, sbw, dst->m_TEX0.TBP0, dst->m_TEX0.TBP0 + dst_offset, dbw);
 
+	dst->DiscardSpeculativeReadback();
+
 	// Create rectangles for the pages.
 	const GSVector2i& pgs = GSLocalMemory::m_psm[dst->m_TEX0.PSM].pgs;
 	const GSVector4i page_rc = GSVector4i::loadh(pgs);
@@ -5630,6 +5920,14 @@ void GSTextureCache::IncAge()
 
 	AgeHashCache();
 
+	// Compaction normally waits for the GS thread to be idle, but some games never leave it any time.
+	m_frame_counter++;
+	const u32 frames_since_compaction = m_frame_counter - m_last_compaction_frame;
+	if (frames_since_compaction >= (COMPACTION_INTERVAL * 2))
+		Compact();
+	else if (frames_since_compaction >= COMPACTION_INTERVAL)
+		m_compaction_pending = true;
+
 	// As of 04/15/2024 this is s et to 60 (just 1 second of targets), which should be fine now as it doesn't destroy targets which haven't been covered.
 	//
 	// For reference, here are some games sensitive to killing old targets:
@@ -5664,11 +5962,14 @@ void GSTextureCache::IncAge()
 				{
 					GL_CACHE("TC: Extending life of target for %x", t->m_TEX0.TBP0);
 					t->m_age = 10;
+					IndexTarget(t);
 					++i;
 				}
 			}
 			else
 			{
+				// Resync the page index, in case anything moved the target without updating it.
+				IndexTarget(t);
 				++i;
 			}
 		}
@@ -5687,6 +5988,8 @@ void GSTextureCache::IncAge()
 			++it;
 		}
 	}
+
+	EnforceVRAMBudget();
 }
 
 //Fixme: Several issues in here. Not handling depth stencil, pitch conversion doesnt work.
@@ -6211,7 +6514,12 @@ GSTextureCache::Source* GSTextureCache::CreateSource(const GIFRegTEX0& TEX0, con
 		}
 		else
 		{
-			src->m_texture = g_gs_device->CreateTexture(tw, th, tlevels, GSTexture::Format::Color);
+			// Unswizzling on the GPU means drawing to the texture, so it has to be a render target.
+			// Preloaded textures are hashed on the CPU anyway, and mipmaps are still read per level.
+			src->m_gpu_unswizzle = GSConfig.GPUTextureUnswizzle && (TEX0.PSM == PSMCT32 || TEX0.PSM == PSMCT24) &&
+			                       tlevels == 1 && !CanPreloadTextureSize(TEX0.TW, TEX0.TH);
+			src->m_texture = src->m_gpu_unswizzle ? g_gs_device->CreateRenderTarget(tw, th, GSTexture::Format::Color, false) :
+			                                        g_gs_device->CreateTexture(tw, th, tlevels, GSTexture::Format::Color);
 			if (!src->m_texture) [[unlikely]]
 			{
 				Console.Error("Failed to allocate %dx%d source texture", tw, th);
@@ -6610,6 +6918,7 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 		HashCacheEntry* entry = &it->second;
 		paltex &= (entry->texture->GetFormat() == GSTexture::Format::UNorm8);
 		entry->refcount++;
+		entry->last_use = ++m_hash_cache_use_counter;
 		return entry;
 	}
 
@@ -6710,9 +7019,13 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 		key.RemoveCLUTHash();
 
 	// insert into the cache cache, and we're done
-	const HashCacheEntry entry{tex, 1u, 0u, alpha_minmax, compute_alpha_minmax, false};
+	const HashCacheEntry entry{tex, 1u, 0u, alpha_minmax, compute_alpha_minmax, false, ++m_hash_cache_use_counter};
 	m_hash_cache_memory_usage += tex->GetMemUsage();
-	return &m_hash_cache.emplace(key, entry).first->second;
+	HashCacheEntry* new_entry = &m_hash_cache.emplace(key, entry).first->second;
+
+	// Make room for the new texture, it's referenced so it won't be evicted itself.
+	EnforceHashCacheBudget();
+	return new_entry;
 }
 
 void GSTextureCache::RemoveFromHashCache(HashCacheMap::iterator it)
@@ -6760,7 +7073,7 @@ void GSTextureCache::AgeHashCache()
 		{
 			might_need_cache_purge = (m_hash_cache.size() > MAX_HASH_CACHE_SIZE);
 			if (might_need_cache_purge)
-				s_hash_cache_purge_list.emplace_back(it, static_cast<s32>(e.age));
+				s_hash_cache_purge_list.emplace_back(it, static_cast<u64>(e.age));
 		}
 
 		++it;
@@ -6777,6 +7090,126 @@ void GSTextureCache::AgeHashCache()
 		for (u32 i = 0; i < entries_to_purge; i++)
 			RemoveFromHashCache(s_hash_cache_purge_list[i].first);
 	}
+
+	EnforceHashCacheBudget();
+}
+
+void GSTextureCache::EnforceHashCacheBudget()
+{
+	const u64 budget = static_cast<u64>(GSConfig.HashCacheBudget) * _1mb;
+	if (budget == 0 || m_hash_cache_memory_usage <= budget)
+		return;
+
+	// Evict down to 90% of the budget, so we're not sorting the whole cache on every new texture.
+	EvictHashCache(budget - (budget / 10));
+
+	GL_CACHE("TC: HC now using %.2f MB of %.2f MB budget", static_cast<float>(m_hash_cache_memory_usage) / 1048576.0f,
+		static_cast<float>(budget) / 1048576.0f);
+}
+
+void GSTextureCache::EvictHashCache(u64 target_usage)
+{
+	s_hash_cache_purge_list.clear();
+	for (auto it = m_hash_cache.begin(); it != m_hash_cache.end(); ++it)
+	{
+		// Replacement textures aren't counted towards the budget, and in-use entries can't go.
+		const HashCacheEntry& e = it->second;
+		if (e.refcount == 0 && !e.is_replacement)
+			s_hash_cache_purge_list.emplace_back(it, e.last_use);
+	}
+
+	std::sort(s_hash_cache_purge_list.begin(), s_hash_cache_purge_list.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+
+	[[maybe_unused]] u32 num_evicted = 0;
+	for (const auto& [it, last_use] : s_hash_cache_purge_list)
+	{
+		if (m_hash_cache_memory_usage <= target_usage)
+			break;
+
+		RemoveFromHashCache(it);
+		num_evicted++;
+	}
+
+	GL_CACHE("TC: HC Evicted %u entries", num_evicted);
+}
+
+void GSTextureCache::EnforceVRAMBudget()
+{
+	// Targets which haven't been used for this many frames can be written back to local memory and dropped.
+	static constexpr int min_target_demote_age = 10;
+
+	const u64 budget = static_cast<u64>(GSConfig.VRAMBudget) * _1mb;
+	const auto get_usage = [this]() {
+		return m_source_memory_usage + m_target_memory_usage + m_hash_cache_memory_usage + m_hash_cache_replacement_memory_usage;
+	};
+	if (budget == 0 || get_usage() <= budget)
+		return;
+
+	// Same as the hash cache, free down to 90% so we're not doing this every frame.
+	const u64 target_usage = budget - (budget / 10);
+
+	// Sources are the cheapest to get back, drop everything that wasn't used this frame.
+	for (auto i = m_src.m_surfaces.begin(); i != m_src.m_surfaces.end() && get_usage() > target_usage;)
+	{
+		Source* s = *i;
+		++i;
+		if (s->m_age > 0)
+			m_src.RemoveAt(s);
+	}
+
+	// Then preloaded textures, which only cost a rehash and upload to come back.
+	if (get_usage() > target_usage)
+	{
+		const u64 other_usage = get_usage() - m_hash_cache_memory_usage;
+		EvictHashCache((other_usage < target_usage) ? (target_usage - other_usage) : 0);
+	}
+
+	if (get_usage() <= target_usage)
+		return;
+
+	// Then idle targets, oldest first. Anything drawn since the last read is written back to local memory first,
+	// so the target gets recreated from memory at native quality if it's needed again, instead of being lost.
+	std::vector<std::pair<Target*, int>> candidates;
+	for (int type = 0; type < 2; type++)
+	{
+		for (Target* t : m_dst[type])
+		{
+			if (t->m_age >= min_target_demote_age)
+				candidates.emplace_back(t, type);
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.first->m_age > rhs.first->m_age; });
+
+	[[maybe_unused]] u32 num_demoted = 0;
+	for (const auto& [t, type] : candidates)
+	{
+		if (get_usage() <= target_usage)
+			break;
+
+		if (!t->m_drawn_since_read.rempty())
+			Read(t, t->m_drawn_since_read);
+
+		GL_CACHE("TC: Demote Target(%s): (0x%x) to local memory, over VRAM budget", to_string(type), t->m_TEX0.TBP0);
+
+		InvalidateSourcesFromTarget(t);
+		auto& list = m_dst[type];
+		for (auto it = list.begin(); it != list.end(); ++it)
+		{
+			if (*it == t)
+			{
+				list.erase(it);
+				break;
+			}
+		}
+		delete t;
+		num_demoted++;
+	}
+
+	GL_CACHE("TC: Demoted %u targets, now using %.2f MB of %.2f MB VRAM budget", num_demoted,
+		static_cast<float>(get_usage()) / 1048576.0f, static_cast<float>(budget) / 1048576.0f);
 }
 
 GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, int h, float scale, int type, bool clear)
@@ -6796,6 +7229,7 @@ GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, i
 	g_texture_cache->m_target_memory_usage += t->m_texture->GetMemUsage();
 
 	g_texture_cache->m_dst[type].push_front(t);
+	g_texture_cache->IndexTarget(t);
 
 	t->UpdateTextureDebugName();
 
@@ -6876,18 +7310,10 @@ std::shared_ptr<GSTextureCache::Palette> GSTextureCache::LookupPaletteObject(con
 	return m_palette_map.LookupPalette(clut, pal, need_gs_texture);
 }
 
-void GSTextureCache::Read(Target* t, const GSVector4i& r)
+static bool GetTargetReadbackFormat(const GSTextureCache::Target* t, GSTexture::Format* fmt, ShaderConvert* ps_shader)
 {
-	if ((!t->m_dirty.empty() && !t->m_dirty.GetTotalRect(t->m_TEX0, t->m_unscaled_size).rintersect(r).rempty()) || r.width() == 0 || r.height() == 0)
-		return;
-
-	const GIFRegTEX0& TEX0 = t->m_TEX0;
-	const bool is_depth = (t->m_type == DepthStencil);
-
-	GSTexture::Format fmt;
-	ShaderConvert ps_shader;
-	std::unique_ptr<GSDownloadTexture>* dltex;
-	switch (TEX0.PSM)
+	const bool is_depth = (t->m_type == GSTextureCache::DepthStencil);
+	switch (t->m_TEX0.PSM)
 	{
 		case PSMCT32:
 		case PSMCT24:
@@ -6899,38 +7325,206 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 			// better than writing back FP values to local memory.
 			if (is_depth)
 			{
-				fmt = GSTexture::Format::UInt32;
-				ps_shader = ShaderConvert::FLOAT32_TO_32_BITS;
-				dltex = &m_uint32_download_texture;
+				*fmt = GSTexture::Format::UInt32;
+				*ps_shader = ShaderConvert::FLOAT32_TO_32_BITS;
 			}
 			else
 			{
-				fmt = GSTexture::Format::Color;
+				*fmt = GSTexture::Format::Color;
 				if (t->m_rt_alpha_scale)
-					ps_shader = ShaderConvert::RTA_DECORRECTION;
+					*ps_shader = ShaderConvert::RTA_DECORRECTION;
 				else
-					ps_shader = ShaderConvert::COPY;
-
-				dltex = &m_color_download_texture;
+					*ps_shader = ShaderConvert::COPY;
 			}
 		}
-		break;
+		return true;
 
 		case PSMCT16:
 		case PSMCT16S:
 		case PSMZ16:
 		case PSMZ16S:
 		{
-			fmt = GSTexture::Format::UInt16;
-			ps_shader = is_depth ? ShaderConvert::FLOAT32_TO_16_BITS : ShaderConvert::RGBA8_TO_16_BITS;
-			dltex = &m_uint16_download_texture;
+			*fmt = GSTexture::Format::UInt16;
+			*ps_shader = is_depth ? ShaderConvert::FLOAT32_TO_16_BITS : ShaderConvert::RGBA8_TO_16_BITS;
 		}
-		break;
+		return true;
 
 		default:
-			return;
+			return false;
+	}
+}
+
+static u32 GetReadbackPredictionKey(const GIFRegTEX0& TEX0)
+{
+	return static_cast<u32>(TEX0.TBP0) | (static_cast<u32>(TEX0.TBW) << 14) | (static_cast<u32>(TEX0.PSM) << 20);
+}
+
+bool GSTextureCache::CopyTargetToDownloadTexture(Target* t, const GSVector4i& r, GSTexture::Format fmt, ShaderConvert ps_shader, GSDownloadTexture* dltex)
+{
+	const GSVector4 src(GSVector4(r) * GSVector4(t->m_scale) / GSVector4(t->m_texture->GetSize()).xyxy());
+	const GSVector4i drc(0, 0, r.width(), r.height());
+	const bool direct_read = t->m_type == RenderTarget && t->m_scale == 1.0f && ps_shader == ShaderConvert::COPY;
+
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Readback);
+
+	if (direct_read)
+	{
+		dltex->CopyFromTexture(drc, t->m_texture, r, 0, true);
+		g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Conversion);
+		return true;
 	}
 
+	GSTexture* tmp = g_gs_device->CreateRenderTarget(drc.z, drc.w, fmt, false);
+	if (!tmp)
+	{
+		Console.Error("Failed to allocate temporary %dx%d target for read.", drc.z, drc.w);
+		g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Conversion);
+		return false;
+	}
+
+	g_gs_device->StretchRect(t->m_texture, src, tmp, GSVector4(drc), ps_shader, false);
+	g_perfmon.Put(GSPerfMon::TextureCopies, 1);
+	dltex->CopyFromTexture(drc, tmp, drc, 0, true);
+	g_gs_device->Recycle(tmp);
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Conversion);
+	return true;
+}
+
+void GSTextureCache::RecordReadbackPrediction(const Target* t, const GSVector4i& r)
+{
+	const u64 frame = g_perfmon.GetFrame();
+	const auto [it, inserted] = m_readback_predictions.try_emplace(GetReadbackPredictionKey(t->m_TEX0), ReadbackPrediction{r, frame, 1});
+	if (inserted)
+		return;
+
+	ReadbackPrediction& pred = it->second;
+	if (pred.last_frame == frame)
+	{
+		pred.rect = pred.rect.runion(r);
+		return;
+	}
+
+	pred.frames = (pred.last_frame == (frame - 1)) ? (pred.frames + 1) : 1;
+	pred.rect = r;
+	pred.last_frame = frame;
+}
+
+void GSTextureCache::QueueSpeculativeReadbacks()
+{
+	// Predictions are dropped after this many frames without a readback.
+	static constexpr u64 max_prediction_age = 30;
+
+	// Number of consecutive frames a surface has to be read on before it's speculatively downloaded.
+	static constexpr u32 min_prediction_frames = 2;
+
+	// Keep the number of in-flight downloads (and staging memory) bounded.
+	static constexpr u32 max_speculative_readbacks = 4;
+
+	// Reads of a handful of pixels (occlusion tests, brightness meters) cost next to nothing to copy,
+	// but stall just as long as big ones. Download them after a single frame, with their own budget.
+	static constexpr int small_readback_pixels = 64 * 64;
+	static constexpr u32 max_small_speculative_readbacks = 8;
+
+	if (m_readback_predictions.empty())
+		return;
+
+	if (GSConfig.HWDownloadMode != GSHardwareDownloadMode::Enabled)
+	{
+		m_readback_predictions.clear();
+		return;
+	}
+
+	const u64 frame = g_perfmon.GetFrame();
+	u32 num_queued = 0;
+	u32 num_small_queued = 0;
+
+	for (auto it = m_readback_predictions.begin(); it != m_readback_predictions.end();)
+	{
+		const u32 key = it->first;
+		const ReadbackPrediction& pred = it->second;
+		if ((frame - pred.last_frame) > max_prediction_age)
+		{
+			it = m_readback_predictions.erase(it);
+			continue;
+		}
+
+		++it;
+
+		const bool small = (pred.rect.width() * pred.rect.height()) <= small_readback_pixels;
+		if (pred.last_frame != frame ||
+			(small ? (num_small_queued == max_small_speculative_readbacks) :
+					 (pred.frames < min_prediction_frames || num_queued == max_speculative_readbacks)))
+		{
+			continue;
+		}
+
+		const u32 bp = key & 0x3FFF;
+		const u32 bw = (key >> 14) & 0x3F;
+		const u32 psm = key >> 20;
+
+		Target* t = nullptr;
+		for (int type = 0; type < 2 && !t; type++)
+		{
+			for (Target* dst : m_dst[type])
+			{
+				if (dst->m_TEX0.TBP0 == bp && dst->m_TEX0.TBW == bw && dst->m_TEX0.PSM == psm)
+				{
+					t = dst;
+					break;
+				}
+			}
+		}
+
+		if (!t)
+			continue;
+
+		const GSVector4i r = pred.rect.rintersect(t->m_valid);
+		if (r.rempty() || t->HasSpeculativeReadback(r) ||
+			(!t->m_dirty.empty() && !t->m_dirty.GetTotalRect(t->m_TEX0, t->m_unscaled_size).rintersect(r).rempty()))
+		{
+			continue;
+		}
+
+		GSTexture::Format fmt;
+		ShaderConvert ps_shader;
+		if (!GetTargetReadbackFormat(t, &fmt, &ps_shader))
+			continue;
+
+		GL_PERF("TC: Speculative Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", t->m_TEX0.TBP0, t->m_TEX0.PSM, r.width(), r.height());
+
+		t->DiscardSpeculativeReadback();
+		if (t->m_readback_texture && t->m_readback_texture->GetFormat() != fmt)
+			t->m_readback_texture.reset();
+		if (!PrepareDownloadTexture(r.width(), r.height(), fmt, &t->m_readback_texture) ||
+			!CopyTargetToDownloadTexture(t, r, fmt, ps_shader, t->m_readback_texture.get()))
+		{
+			continue;
+		}
+
+		// No flush here, the copy is submitted along with the frame, and will usually have
+		// completed by the time the game reads the surface.
+		t->m_readback_source = t->m_texture;
+		t->m_readback_rect = r;
+		t->m_readback_draw = t->m_last_draw;
+		if (small)
+			num_small_queued++;
+		else
+			num_queued++;
+	}
+}
+
+void GSTextureCache::Read(Target* t, const GSVector4i& r)
+{
+	if ((!t->m_dirty.empty() && !t->m_dirty.GetTotalRect(t->m_TEX0, t->m_unscaled_size).rintersect(r).rempty()) || r.width() == 0 || r.height() == 0)
+		return;
+
+	const GIFRegTEX0& TEX0 = t->m_TEX0;
+
+	GSTexture::Format fmt;
+	ShaderConvert ps_shader;
+	if (!GetTargetReadbackFormat(t, &fmt, &ps_shader))
+		return;
+
 	// Don't overwrite bits which aren't used in the target's format.
 	// Stops Burnout 3's sky from breaking when flushing targets to local memory.
 	const u32 write_mask = (t->m_valid_rgb ? 0x00FFFFFFu : 0) | (t->m_valid_alpha_low ? 0x0F000000u : 0) | (t->m_valid_alpha_high ? 0xF0000000u : 0);
@@ -6940,44 +7534,47 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		return;
 	}
 
-	GL_PERF("TC: Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", TEX0.TBP0, TEX0.PSM, r.width(), r.height());
-
-	const GSVector4 src(GSVector4(r) * GSVector4(t->m_scale) / GSVector4(t->m_texture->GetSize()).xyxy());
-	const GSVector4i drc(0, 0, r.width(), r.height());
-	const bool direct_read = t->m_type == RenderTarget && t->m_scale == 1.0f && ps_shader == ShaderConvert::COPY;
+	RecordReadbackPrediction(t, r);
 
-	if (!PrepareDownloadTexture(drc.z, drc.w, fmt, dltex))
-		return;
-
-	if (direct_read)
+	GSDownloadTexture* dltex;
+	GSVector4i drc;
+	if (t->HasSpeculativeReadback(r))
 	{
-		dltex->get()->CopyFromTexture(drc, t->m_texture, r, 0, true);
+		GL_PERF("TC: Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d (speculative)", TEX0.TBP0, TEX0.PSM, r.width(), r.height());
+
+		dltex = t->m_readback_texture.get();
+		drc = r - t->m_readback_rect.xyxy();
 	}
 	else
 	{
-		GSTexture* tmp = g_gs_device->CreateRenderTarget(drc.z, drc.w, fmt, false);
-		if (tmp)
-		{
-			g_gs_device->StretchRect(t->m_texture, src, tmp, GSVector4(drc), ps_shader, false);
-			g_perfmon.Put(GSPerfMon::TextureCopies, 1);
-			dltex->get()->CopyFromTexture(drc, tmp, drc, 0, true);
-			g_gs_device->Recycle(tmp);
-		}
+		GL_PERF("TC: Read Back Target: (0x%x)[fmt: 0x%x]. Size %dx%d", TEX0.TBP0, TEX0.PSM, r.width(), r.height());
+
+		std::unique_ptr<GSDownloadTexture>* tex;
+		if (fmt == GSTexture::Format::UInt32)
+			tex = &m_uint32_download_texture;
+		else if (fmt == GSTexture::Format::UInt16)
+			tex = &m_uint16_download_texture;
 		else
-		{
-			Console.Error("Failed to allocate temporary %dx%d target for read.", drc.z, drc.w);
+			tex = &m_color_download_texture;
+
+		drc = GSVector4i(0, 0, r.width(), r.height());
+		if (!PrepareDownloadTexture(drc.z, drc.w, fmt, tex) || !CopyTargetToDownloadTexture(t, r, fmt, ps_shader, tex->get()))
 			return;
-		}
+
+		dltex = tex->get();
 	}
 
-	dltex->get()->Flush();
-	if (!dltex->get()->Map(drc))
+	if (dltex->NeedsFlush())
+		dltex->Flush();
+	if (!dltex->Map(drc))
 		return;
 
 	// Why does WritePixelNN() not take a const pointer?
 	const GSOffset off = g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
-	u8* bits = const_cast<u8*>(dltex->get()->GetMapPointer());
-	const u32 pitch = dltex->get()->GetMapPitch();
+	u32 map_offset, map_size, map_rows;
+	dltex->GetTransferSize(drc, &map_offset, &map_size, &map_rows);
+	u8* bits = const_cast<u8*>(dltex->GetMapPointer()) + map_offset;
+	const u32 pitch = dltex->GetMapPitch();
 
 	switch (TEX0.PSM)
 	{
@@ -6999,7 +7596,9 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 			break;
 	}
 
-	dltex->get()->Unmap();
+	InvalidateVRAMPages(off, r);
+
+	dltex->Unmap();
 }
 
 void GSTextureCache::Read(Source* t, const GSVector4i& r)
@@ -7012,7 +7611,9 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 	if (!PrepareDownloadTexture(drc.z, drc.w, GSTexture::Format::Color, &m_color_download_texture))
 		return;
 
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Readback);
 	m_color_download_texture->CopyFromTexture(drc, t->m_texture, r, 0, true);
+	g_gs_device->SetGPUTimingCategory(GSDevice::GPUTimingCategory::Conversion);
 	m_color_download_texture->Flush();
 
 	if (m_color_download_texture->Map(drc))
@@ -7021,7 +7622,63 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 		g_gs_renderer->m_mem.WritePixel32(
 			const_cast<u8*>(m_color_download_texture->GetMapPointer()), m_color_download_texture->GetMapPitch(), off, r);
 		m_color_download_texture->Unmap();
+		InvalidateVRAMPages(off, r);
+	}
+}
+
+void GSTextureCache::InvalidateVRAMPages(const GSOffset& off, const GSVector4i& r)
+{
+	// Everything gets uploaded when the copy is created, so there's nothing to track until then.
+	if (!m_vram_texture)
+		return;
+
+	off.loopPages(r, [this](u32 page) { m_vram_dirty_pages.set(page % GS_MAX_PAGES); });
+}
+
+GSTexture* GSTextureCache::GetVRAMTexture()
+{
+	if (!m_vram_texture)
+	{
+		m_vram_texture = g_gs_device->CreateTexture(VRAM_TEXTURE_WIDTH, VRAM_TEXTURE_HEIGHT, 1, GSTexture::Format::Color);
+		if (!m_vram_texture) [[unlikely]]
+		{
+			Console.Error("Failed to allocate local memory texture");
+			return nullptr;
+		}
+
+		m_vram_dirty_pages.set();
+	}
+
+	SyncVRAMTexture();
+	return m_vram_texture;
+}
+
+void GSTextureCache::SyncVRAMTexture()
+{
+	if (!m_vram_texture || m_vram_dirty_pages.none())
+		return;
+
+	// Each page is two rows of the texture, so runs of consecutive pages can go up in one update.
+	constexpr u32 rows_per_page = GS_PAGE_SIZE / (VRAM_TEXTURE_WIDTH * sizeof(u32));
+	const u8* vm = g_gs_renderer->m_mem.vm8();
+	u32 page = 0;
+	while (page < GS_MAX_PAGES)
+	{
+		if (!m_vram_dirty_pages.test(page))
+		{
+			page++;
+			continue;
+		}
+
+		const u32 start = page;
+		while (page < GS_MAX_PAGES && m_vram_dirty_pages.test(page))
+			page++;
+
+		const GSVector4i rect(0, start * rows_per_page, VRAM_TEXTURE_WIDTH, page * rows_per_page);
+		m_vram_texture->Update(rect, vm + start * GS_PAGE_SIZE, VRAM_TEXTURE_WIDTH * sizeof(u32));
 	}
+
+	m_vram_dirty_pages.reset();
 }
 
 // GSTextureCache::Surface
@@ -7302,10 +7959,25 @@ void GSTextureCache::Source::Flush(u32 count, int layer, const GSOffset& off)
 
 	pitch = VectorAlign(pitch);
 
+	GSTexture* const vram = m_gpu_unswizzle ? g_texture_cache->GetVRAMTexture() : nullptr;
+
 	for (u32 i = 0; i < count; i++)
 	{
 		const GSVector4i r(m_write.rect[i]);
 
+		if (vram)
+		{
+			// Unswizzle straight from the GPU copy of local memory, rather than going through the CPU.
+			const GSVector4i rint(r.rintersect(tex_r));
+			if (!rint.rempty())
+			{
+				g_gs_device->UnswizzleTexture(vram, m_texture, rint - tex_r.xyxy(), GSVector2i(tex_r.left, tex_r.top),
+					m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_TEXA.TA0, m_TEXA.AEM);
+			}
+
+			continue;
+		}
+
 		// if update rect lies to the left/above of the region rectangle, or extends past the texture bounds, we can't use a direct map
 		if (((r > tex_r).mask() & 0xff00) == 0 && ((tex_r > r).mask() & 0x00ff) == 0)
 		{
@@ -7416,6 +8088,8 @@ GSTextureCache::Target::~Target()
 		g_gs_device->Recycle(m_texture);
 	}
 
+	g_texture_cache->UnindexTarget(this);
+
 #ifdef PCSX2_DEVBUILD
 	// Make sure all sources referencing this target have been removed.
 	for (GSTextureCache::Source* src : g_texture_cache->m_src.m_surfaces)
@@ -7454,6 +8128,9 @@ void GSTextureCache::Target::Update(bool cannot_scale)
 		return;
 	}
 
+	// Lots of small uploads tend to tile a larger area, merging them saves on reads and draws.
+	m_dirty.Coalesce();
+
 	const GSVector4i total_rect = m_dirty.GetTotalRect(m_TEX0, m_unscaled_size);
 	if (total_rect.rempty())
 	{
@@ -7707,8 +8384,16 @@ void GSTextureCache::Target::ResizeDrawn(const GSVector4i& rect)
 }
 
 
+bool GSTextureCache::Target::HasSpeculativeReadback(const GSVector4i& rect) const
+{
+	return (m_readback_source && m_readback_source == m_texture && m_readback_draw == m_last_draw &&
+			m_readback_rect.rintersect(rect).eq(rect));
+}
+
 void GSTextureCache::Target::UpdateDrawn(const GSVector4i& rect, bool can_update_size)
 {
+	DiscardSpeculativeReadback();
+
 	if (m_drawn_since_read.rempty())
 	{
 		m_drawn_since_read = rect.rintersect(m_valid);
@@ -7730,6 +8415,8 @@ void GSTextureCache::Target::ResizeValidity(const GSVector4i& rect)
 
 	// Else No valid size, so need to resize down.
 
+	g_texture_cache->IndexTarget(this);
+
 	// GL_CACHE("TC: ResizeValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
 
@@ -7747,6 +8434,8 @@ void GSTextureCache::Target::UpdateValidity(const GSVector4i& rect, bool can_res
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
 	}
+
+	g_texture_cache->IndexTarget(this);
 	// GL_CACHE("TC: UpdateValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
 
@@ -7877,6 +8566,7 @@ void GSTextureCache::SourceMap::RemoveAll()
 	}
 
 	m_surfaces.clear();
+	m_idle_updates.clear();
 
 	for (FastList<Source*>& item : m_map)
 	{
@@ -7888,6 +8578,9 @@ void GSTextureCache::SourceMap::RemoveAt(Source* s)
 {
 	m_surfaces.erase(s);
 
+	if (s->m_idle_update_queued)
+		m_idle_updates.erase(std::find(m_idle_updates.begin(), m_idle_updates.end(), s));
+
 	GL_CACHE("TC: Remove Src Texture: 0x%x TBW %u PSM %s",
 		s->m_TEX0.TBP0, s->m_TEX0.TBW, GSUtil::GetPSMName(s->m_TEX0.PSM));
 
@@ -8001,12 +8694,16 @@ GSTextureCache::SurfaceOffset GSTextureCache::ComputeSurfaceOffset(const Surface
 	// Key parameter is valid.
 	const auto it = m_surface_offset_cache.find(sok);
 	if (it != m_surface_offset_cache.end())
+	{
+		it->second.last_used = m_frame_counter;
 		return it->second; // Cache HIT.
+	}
 
 	// Cache MISS.
 	// Search for a valid <x,y> offset from B to A in B coordinates.
 	SurfaceOffset so;
 	so.is_valid = false;
+	so.last_used = m_frame_counter;
 	const int dx = b_psm_s.bs.x;
 	const int dy = b_psm_s.bs.y;
 	GSVector4i b2a_offset = GSVector4i::zero();
@@ -8202,13 +8899,15 @@ void GSTextureCache::InjectHashCacheTexture(const HashCacheKey& key, GSTexture*
 
 // GSTextureCache::Palette
 
-GSTextureCache::Palette::Palette(const u32* clut, u16 pal, bool need_gs_texture)
+GSTextureCache::Palette::Palette(const PaletteKey& key, bool need_gs_texture)
 	: m_tex_palette(nullptr)
-	, m_pal(pal)
+	, m_hash(PaletteKeyHash()(key))
+	, m_pal(key.pal)
 {
+	const u16 pal = key.pal;
 	const u16 palette_size = pal * sizeof(u32);
 	m_clut = (u32*)_aligned_malloc(palette_size, 64);
-	memcpy(m_clut, clut, palette_size);
+	memcpy(m_clut, key.clut, palette_size);
 	if (need_gs_texture)
 	{
 		InitializeTexture();
@@ -8241,7 +8940,7 @@ GSTexture* GSTextureCache::Palette::GetPaletteGSTexture()
 
 GSTextureCache::PaletteKey GSTextureCache::Palette::GetPaletteKey()
 {
-	return {m_clut, m_pal};
+	return {m_clut, m_pal, m_hash};
 }
 
 void GSTextureCache::Palette::InitializeTexture()
@@ -8266,11 +8965,22 @@ void GSTextureCache::Palette::InitializeTexture()
 	}
 }
 
+// GSTextureCache::PaletteKey
+
+GSTextureCache::PaletteKey GSTextureCache::PaletteKey::Create(const u32* clut, u16 pal)
+{
+	const GSClut& gs_clut = g_gs_renderer->m_mem.m_clut;
+	return {clut, pal, (clut == static_cast<const u32*>(gs_clut)) ? gs_clut.GetPaletteHash(pal) : 0};
+}
+
 // GSTextureCache::PaletteKeyHash
 
 u64 GSTextureCache::PaletteKeyHash::operator()(const PaletteKey& key) const
 {
 	pxAssert(key.pal == 16 || key.pal == 256);
+	if (key.hash != 0)
+		return key.hash;
+
 	return key.pal == 16 ?
 	           GSXXH3_64bits(key.clut, sizeof(key.clut[0]) * 16) :
 	           GSXXH3_64bits(key.clut, sizeof(key.clut[0]) * 256);
@@ -8285,6 +8995,11 @@ bool GSTextureCache::PaletteKeyEqual::operator()(const PaletteKey& lhs, const Pa
 		return false;
 	}
 
+	if (lhs.hash != 0 && rhs.hash != 0 && lhs.hash != rhs.hash)
+	{
+		return false;
+	}
+
 	return GSVector4i::compare64(lhs.clut, rhs.clut, lhs.pal * sizeof(lhs.clut[0]));
 };
 
@@ -8313,7 +9028,7 @@ std::shared_ptr<GSTextureCache::Palette> GSTextureCache::PaletteMap::LookupPalet
 	auto& map = m_maps[pal == 16 ? 0 : 1];
 
 	// Create PaletteKey for searching into map (clut is actually not copied, so do not store this key into the map)
-	const PaletteKey palette_key = {clut, pal};
+	const PaletteKey palette_key = PaletteKey::Create(clut, pal);
 
 	const auto& it1 = map.find(palette_key);
 
@@ -8366,7 +9081,7 @@ std::shared_ptr<GSTextureCache::Palette> GSTextureCache::PaletteMap::LookupPalet
 		}
 	}
 
-	std::shared_ptr<Palette> palette = std::make_shared<Palette>(clut, pal, need_gs_texture);
+	std::shared_ptr<Palette> palette = std::make_shared<Palette>(palette_key, need_gs_texture);
 
 	map.emplace(palette->GetPaletteKey(), palette);
 
@@ -8375,6 +9090,26 @@ std::shared_ptr<GSTextureCache::Palette> GSTextureCache::PaletteMap::LookupPalet
 	return palette;
 }
 
+u32 GSTextureCache::PaletteMap::Compact()
+{
+	u32 removed = 0;
+	for (auto& map : m_maps)
+	{
+		const size_t current_size = map.size();
+
+		// Same as when a map fills up, the map holds the only reference to unused palettes.
+		std::erase_if(map, [](const auto& it) { return it.second.use_count() <= 1; });
+		removed += static_cast<u32>(current_size - map.size());
+	}
+
+	return removed;
+}
+
+size_t GSTextureCache::PaletteMap::GetSize() const
+{
+	return m_maps[0].size() + m_maps[1].size();
+}
+
 void GSTextureCache::PaletteMap::Clear()
 {
 	for (auto& map : m_maps)
@@ -8533,11 +9268,6 @@ __fi static void BlockHashReset(BlockHashState& st)
 	XXH3_64bits_reset(&st);
 }
 
-__fi static void BlockHashAccumulate(BlockHashState& st, const u8* bp)
-{
-	GSXXH3_64bits_update(&st, bp, GS_BLOCK_SIZE);
-}
-
 __fi static void BlockHashAccumulate(BlockHashState& st, const u8* bp, u32 size)
 {
 	GSXXH3_64bits_update(&st, bp, size);
@@ -8598,15 +9328,30 @@ static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GST
 		GSOffset::BNHelper bn = off.bnMulti(block_rect.left, block_rect.top);
 		const int right = block_rect.right >> off.blockShiftX();
 		const int bottom = block_rect.bottom >> off.blockShiftY();
-		const int xAdd = (1 << off.blockShiftX()) * (psm.bpp / 8);
+
+		// Feeding XXH3 one 256 byte block at a time spends most of the time in the streaming
+		// bookkeeping, rather than the vectorized accumulate loop. Gather the blocks into the
+		// temp buffer in hash order and update in large batches instead, which gives exactly
+		// the same hash (replacement texture names depend on it), just with far fewer calls.
+		static constexpr u32 gather_size = 64 * 1024;
+		u32 gathered = 0;
 
 		for (; bn.blkY() < bottom; bn.nextBlockY())
 		{
-			for (int x = 0; bn.blkX() < right; bn.nextBlockX(), x += xAdd)
+			for (; bn.blkX() < right; bn.nextBlockX())
 			{
-				BlockHashAccumulate(hash_st, mem.BlockPtr(bn.value()));
+				std::memcpy(temp + gathered, mem.BlockPtr(bn.value()), GS_BLOCK_SIZE);
+				gathered += GS_BLOCK_SIZE;
+				if (gathered == gather_size)
+				{
+					BlockHashAccumulate(hash_st, temp, gathered);
+					gathered = 0;
+				}
 			}
 		}
+
+		if (gathered > 0)
+			BlockHashAccumulate(hash_st, temp, gathered);
 	}
 }
 
@@ -8686,7 +9431,7 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 	HashCacheKey ret;
 	ret.TEX0.U64 = TEX0.U64 & 0x00000003FFF00000ULL; // PSM, TW, TH
 	ret.TEXA.U64 = (psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0;
-	ret.CLUTHash = clut ? GSTextureCache::PaletteKeyHash{}({clut, psm.pal}) : 0;
+	ret.CLUTHash = clut ? GSTextureCache::PaletteKeyHash{}(PaletteKey::Create(clut, psm.pal)) : 0;
 	ret.region_width = static_cast<u16>(region.GetWidth());
 	ret.region_height = static_cast<u16>(region.GetHeight());
 
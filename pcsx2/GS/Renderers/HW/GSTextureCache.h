@@ -7,9 +7,12 @@
 #include "GS/Renderers/Common/GSFastList.h"
 #include "GS/Renderers/Common/GSDirtyRect.h"
 
+#include <bitset>
+#include <span>
 #include <unordered_set>
 #include <utility>
 #include <limits>
+#include <vector>
 
 class GSHwHack;
 
@@ -121,6 +124,7 @@ public:
 		std::pair<u8, u8> alpha_minmax;
 		bool valid_alpha_minmax;
 		bool is_replacement;
+		u64 last_use = 0; // for LRU eviction when over budget
 	};
 
 	using HashCacheMap = std::unordered_map<HashCacheKey, HashCacheEntry, HashCacheKeyHash>;
@@ -165,6 +169,10 @@ public:
 	{
 		const u32* clut;
 		u16 pal;
+		u64 hash = 0; // Content hash when already known, otherwise computed on demand.
+
+		/// Creates a key for a clut, reusing the hash from GSClut when it points to the current palette.
+		static PaletteKey Create(const u32* clut, u16 pal);
 	};
 
 	class Palette
@@ -172,11 +180,12 @@ public:
 	private:
 		u32* m_clut;
 		GSTexture* m_tex_palette;
+		u64 m_hash;
 		u16 m_pal;
 		std::pair<u8, u8> m_alpha_minmax;
 
 	public:
-		Palette(const u32* clut, u16 pal, bool need_gs_texture);
+		Palette(const PaletteKey& key, bool need_gs_texture);
 		~Palette();
 
 		__fi std::pair<u8, u8> GetAlphaMinMax() const { return m_alpha_minmax; }
@@ -242,6 +251,17 @@ public:
 		GSVector4i m_drawn_since_read{};
 		int readbacks_since_draw = 0;
 
+		// Speculative readback, queued at vsync when this target is predicted to be read back.
+		// Only valid while the target texture hasn't been written since the copy was queued.
+		std::unique_ptr<GSDownloadTexture> m_readback_texture;
+		GSTexture* m_readback_source = nullptr;
+		GSVector4i m_readback_rect{};
+		int m_readback_draw = 0;
+
+		// Page range this target is registered under in the target page index.
+		u16 m_indexed_page = 0;
+		u16 m_indexed_num_pages = 0;
+
 	public:
 		Target(GIFRegTEX0 TEX0, int type, const GSVector2i& unscaled_size, float scale, GSTexture* texture);
 		~Target();
@@ -259,6 +279,10 @@ public:
 		void ScaleRTAlpha();
 		void UnscaleRTAlpha();
 
+		/// Returns true if the speculative readback covers the rectangle, and is still up to date.
+		bool HasSpeculativeReadback(const GSVector4i& rect) const;
+		__fi void DiscardSpeculativeReadback() { m_readback_source = nullptr; }
+
 		void Update(bool cannot_scale = false);
 
 		/// Updates the target, if the dirty area intersects with the specified rectangle.
@@ -301,8 +325,10 @@ public:
 		bool m_target_direct = false;
 		bool m_repeating = false;
 		bool m_valid_alpha_minmax = false;
+		bool m_gpu_unswizzle = false;
+		bool m_idle_update_queued = false;
 		std::pair<u8, u8> m_alpha_minmax = {0u, 255u};
-		std::vector<GSVector2i>* m_p2t = nullptr;
+		GSPage2TileMap m_p2t;
 		// Keep a trace of the target origin. There is no guarantee that pointer will
 		// still be valid on future. However it ought to be good when the source is created
 		// so it can be used to access un-converted data for the current draw call.
@@ -354,6 +380,11 @@ public:
 		std::shared_ptr<Palette> LookupPalette(const u32* clut, u16 pal, bool need_gs_texture);
 
 		void Clear(); // Clears m_maps, thus deletes Palette objects
+
+		// Removes the palettes no source holds a reference to, returns how many were removed
+		u32 Compact();
+
+		size_t GetSize() const;
 	};
 
 	class SourceMap
@@ -362,6 +393,9 @@ public:
 		std::unordered_set<Source*> m_surfaces;
 		std::array<FastList<Source*>, GS_MAX_PAGES> m_map;
 
+		/// Sources invalidated by a host transfer, which get refreshed from local memory while the GS thread is idle.
+		std::vector<Source*> m_idle_updates;
+
 		void Add(Source* s, const GIFRegTEX0& TEX0);
 		void SwapTexture(GSTexture* old_tex, GSTexture* new_tex);
 		void RemoveAll();
@@ -405,6 +439,7 @@ public:
 	{
 		bool is_valid;
 		GSVector4i b2a_offset; // B to A offset in B coords.
+		u32 last_used; // Texture cache frame of the last lookup, for compaction.
 	};
 
 	struct SurfaceOffsetKeyHash
@@ -424,9 +459,15 @@ protected:
 	HashCacheMap m_hash_cache;
 	u64 m_hash_cache_memory_usage = 0;
 	u64 m_hash_cache_replacement_memory_usage = 0;
+	u64 m_hash_cache_use_counter = 0;
 
 	FastList<Target*> m_dst[2];
 	FastList<TargetHeightElem> m_target_heights;
+
+	// Number of targets of each type covering each page. Lets invalidations skip the target
+	// walk entirely when nothing lives in the written range. Kept up to date whenever a
+	// target's base pointer or end block changes, and resynced on aging.
+	std::array<std::array<u16, GS_MAX_PAGES>, 2> m_target_page_count = {};
 	u64 m_target_memory_usage = 0;
 
 	int m_expected_src_bp = -1;
@@ -437,6 +478,14 @@ protected:
 	constexpr static size_t S_SURFACE_OFFSET_CACHE_MAX_SIZE = std::numeric_limits<u16>::max();
 	std::unordered_map<SurfaceOffsetKey, SurfaceOffset, SurfaceOffsetKeyHash, SurfaceOffsetKeyEqual> m_surface_offset_cache;
 
+	// Frames between compaction passes, about 30 seconds at 60 FPS. The pass runs when the GS thread is
+	// next idle, or at the following IncAge() once it's been pending for a whole interval.
+	constexpr static u32 COMPACTION_INTERVAL = 1800;
+	u32 m_frame_counter = 0;
+	u32 m_last_compaction_frame = 0;
+	bool m_compaction_pending = false;
+	u32 m_compaction_count = 0;
+
 	Source* m_temporary_source = nullptr; // invalidated after the draw
 	GSTexture* m_temporary_z = nullptr; // invalidated after the draw
 	TempZAddress m_temporary_z_info;
@@ -445,6 +494,24 @@ protected:
 	std::unique_ptr<GSDownloadTexture> m_uint16_download_texture;
 	std::unique_ptr<GSDownloadTexture> m_uint32_download_texture;
 
+	// Copy of local memory on the GPU, one word per texel. Only pages written since the last sync are uploaded.
+	static constexpr u32 VRAM_TEXTURE_WIDTH = 1024;
+	static constexpr u32 VRAM_TEXTURE_HEIGHT = VM_SIZE / (VRAM_TEXTURE_WIDTH * sizeof(u32));
+	GSTexture* m_vram_texture = nullptr;
+	std::bitset<GS_MAX_PAGES> m_vram_dirty_pages;
+
+	struct ReadbackPrediction
+	{
+		GSVector4i rect;
+		u64 last_frame;
+		u32 frames;
+	};
+
+	// Targets which were read back recently, keyed by TBP/TBW/PSM. Surfaces read back on several
+	// consecutive frames (or just the last one, for small reads) get their download queued at vsync,
+	// instead of stalling on it mid-frame.
+	std::unordered_map<u32, ReadbackPrediction> m_readback_predictions;
+
 	Source* CreateSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, Target* t, int x_offset, int y_offset, const GSVector2i* lod, const GSVector4i* src_range, GSTexture* gpu_clut, SourceRegion region);
 
 	bool PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, const GSVector2i& valid_size, bool is_frame,
@@ -457,6 +524,12 @@ protected:
 	/// plus the height is larger than the current size of the target.
 	void ScaleTargetForDisplay(Target* t, const GIFRegTEX0& dispfb, int real_w, int real_h);
 
+	/// Copies the specified rectangle of a target to a download texture, converting if needed.
+	bool CopyTargetToDownloadTexture(Target* t, const GSVector4i& r, GSTexture::Format fmt, ShaderConvert ps_shader, GSDownloadTexture* dltex);
+
+	/// Records a synchronous target readback, for predicting the next frame's readbacks.
+	void RecordReadbackPrediction(const Target* t, const GSVector4i& r);
+
 	/// Resizes the download texture if needed.
 	bool PrepareDownloadTexture(u32 width, u32 height, GSTexture::Format format, std::unique_ptr<GSDownloadTexture>* tex);
 
@@ -464,6 +537,13 @@ protected:
 	void RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
 
+	/// Evicts the least recently used unreferenced entries until the hash cache fits in the configured budget.
+	void EnforceHashCacheBudget();
+	void EvictHashCache(u64 target_usage);
+
+	/// Frees sources, hash cache entries and idle targets until the whole cache fits in the VRAM budget.
+	void EnforceVRAMBudget();
+
 	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
 	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
 
@@ -482,10 +562,43 @@ public:
 	__fi u64 GetSourceMemoryUsage() const { return m_source_memory_usage; }
 	__fi u64 GetTargetMemoryUsage() const { return m_target_memory_usage; }
 
+	struct CacheStats
+	{
+		size_t surface_offsets;
+		size_t palettes;
+		size_t hash_cache_entries;
+		size_t list_memory; ///< Bytes held by the source and target lists, including unused capacity.
+		u32 compactions;
+	};
+
+	/// Sizes of the bookkeeping structures, so growth over long sessions is visible.
+	CacheStats GetCacheStats() const;
+
+	/// Trims stale surface offsets and unused palettes, and releases list storage left over from busier scenes.
+	void Compact();
+
 	void Read(Target* t, const GSVector4i& r);
 	void Read(Source* t, const GSVector4i& r);
+
+	/// Flags local memory pages as changed, so they are uploaded to the GPU copy on the next sync.
+	void InvalidateVRAMPages(const GSOffset& off, const GSVector4i& r);
+
+	/// Uploads the changed pages to the GPU copy of local memory, creating it on first use.
+	GSTexture* GetVRAMTexture();
+
+	/// Uploads the changed pages if the GPU copy of local memory is in use. Called before each draw.
+	void SyncVRAMTexture();
 	void RemoveAll(bool sources, bool targets, bool hash_cache);
 	void ReadbackAll();
+
+	/// Serializes the position, format and scale of each live target, so a save state can rebuild them on load.
+	void SaveTargetLayout(std::vector<u8>* data) const;
+
+	/// Recreates targets from a layout written by SaveTargetLayout(), populating them from local memory.
+	void RestoreTargetLayout(std::span<const u8> data);
+
+	/// Queues asynchronous downloads of the targets which are expected to be read back next frame.
+	void QueueSpeculativeReadbacks();
 	static void AddDirtyRectTarget(Target* target, GSVector4i rect, u32 psm, u32 bw, RGBAMask rgba, bool req_linear = false);
 	void ResizeTarget(Target* t, GSVector4i rect, u32 tbp, u32 psm, u32 tbw);
 	static bool FullRectDirty(Target* target, u32 rgba_mask);
@@ -528,9 +641,22 @@ public:
 	void InvalidateVideoMem(const GSOffset& off, const GSVector4i& r, bool target = true);
 	void InvalidateLocalMem(const GSOffset& off, const GSVector4i& r, bool full_flush = false);
 
+	/// Queues recently used sources overlapping a host transfer, so they can be re-uploaded before their next draw.
+	void QueueIdleUpdates(const GSOffset& off, const GSVector4i& r);
+
+	/// Re-uploads a few queued sources, or runs a pending compaction. Returns true if there's still more work queued.
+	bool RunIdleUpdates();
+
 	/// Removes any sources which point to the specified target.
 	void InvalidateSourcesFromTarget(const Target* t);
 
+	/// Updates the page index after a target's base pointer or end block has changed.
+	void IndexTarget(Target* t);
+	void UnindexTarget(Target* t);
+
+	/// Returns true if any target of the specified type could overlap the (unwrapped) block range.
+	bool HasTargetsInRange(int type, u32 start_bp, u32 end_bp) const;
+
 	/// Removes any sources which point to the same address as a new target.
 	void ReplaceSourceTexture(Source* s, GSTexture* new_texture, float new_scale, const GSVector2i& new_unscaled_size,
 		HashCacheEntry* hc_entry, bool new_texture_is_shared);
@@ -7,6 +7,7 @@
 #include "common/Path.h"
 #include "common/StringUtil.h"
 #include "common/ScopedGuard.h"
+#include "common/TextureDecompress.h"
 
 #include "GS/Renderers/HW/GSTextureReplacements.h"
 
@@ -142,6 +143,56 @@ static void ConvertTexture_R8G8B8(u32 width, u32 height, std::vector<u8>& data,
 	pitch = new_pitch;
 }
 
+/// Decodes block compressed data to RGBA8, for devices which can't sample the format directly.
+/// Runs on the replacement loader threads, so it doesn't stall the GS thread.
+template <GSTexture::Format format>
+static void DecompressTexture_BC(u32 width, u32 height, std::vector<u8>& data, u32& pitch)
+{
+	constexpr u32 BC_BLOCK_SIZE = 4;
+	constexpr u32 BC_BLOCK_BYTES = (format == GSTexture::Format::BC1) ? 8 : 16;
+	constexpr u32 BLOCK_PITCH = BC_BLOCK_SIZE * sizeof(u32);
+
+	const u32 new_pitch = width * sizeof(u32);
+	std::vector<u8> new_data(new_pitch * height);
+
+	for (u32 by = 0; by < height; by += BC_BLOCK_SIZE)
+	{
+		const u8* block_in = data.data() + (by / BC_BLOCK_SIZE) * pitch;
+		const u32 rows = std::min(height - by, BC_BLOCK_SIZE);
+
+		for (u32 bx = 0; bx < width; bx += BC_BLOCK_SIZE, block_in += BC_BLOCK_BYTES)
+		{
+			alignas(16) u8 block_pixels_out[BC_BLOCK_SIZE * BLOCK_PITCH];
+			switch (format)
+			{
+				case GSTexture::Format::BC1:
+					DecompressBlockBC1(0, 0, BLOCK_PITCH, block_in, block_pixels_out);
+					break;
+				case GSTexture::Format::BC2:
+					DecompressBlockBC2(0, 0, BLOCK_PITCH, block_in, block_pixels_out);
+					break;
+				case GSTexture::Format::BC3:
+					DecompressBlockBC3(0, 0, BLOCK_PITCH, block_in, block_pixels_out);
+					break;
+				case GSTexture::Format::BC7:
+					bc7decomp::unpack_bc7(block_in, reinterpret_cast<bc7decomp::color_rgba*>(block_pixels_out));
+					break;
+			}
+
+			// Mip levels smaller than the block size only take the top-left texels.
+			const u32 row_bytes = std::min(width - bx, BC_BLOCK_SIZE) * sizeof(u32);
+			for (u32 row = 0; row < rows; row++)
+			{
+				std::memcpy(new_data.data() + (by + row) * new_pitch + bx * sizeof(u32),
+					block_pixels_out + row * BLOCK_PITCH, row_bytes);
+			}
+		}
+	}
+
+	data = std::move(new_data);
+	pitch = new_pitch;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // PNG Handlers
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -248,6 +299,11 @@ bool GSTextureReplacements::SavePNGImage(const std::string& filename, u32 width,
 
 	png_init_io(png_ptr, fp.get());
 	png_set_compression_level(png_ptr, compression);
+
+	// At the fast levels, libpng's per-row search over all five filters costs more than the deflate itself.
+	if (compression <= 1)
+		png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+
 	png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGBA,
 		PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
 	png_write_info(png_ptr, info_ptr);
@@ -469,7 +525,10 @@ static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
 			info->block_size = 4;
 			info->bytes_per_block = 8;
 			if (!features.dxt_textures)
-				return false;
+			{
+				info->format = GSTexture::Format::Color;
+				info->conversion_function = DecompressTexture_BC<GSTexture::Format::BC1>;
+			}
 		}
 		else if (header.ddspf.dwFourCC == MAKEFOURCC('D', 'X', 'T', '2') || header.ddspf.dwFourCC == MAKEFOURCC('D', 'X', 'T', '3') || dxt10_format == 74 /*DXGI_FORMAT_BC2_UNORM*/)
 		{
@@ -477,7 +536,10 @@ static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
 			info->block_size = 4;
 			info->bytes_per_block = 16;
 			if (!features.dxt_textures)
-				return false;
+			{
+				info->format = GSTexture::Format::Color;
+				info->conversion_function = DecompressTexture_BC<GSTexture::Format::BC2>;
+			}
 		}
 		else if (header.ddspf.dwFourCC == MAKEFOURCC('D', 'X', 'T', '4') || header.ddspf.dwFourCC == MAKEFOURCC('D', 'X', 'T', '5') || dxt10_format == 77 /*DXGI_FORMAT_BC3_UNORM*/)
 		{
@@ -485,7 +547,10 @@ static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
 			info->block_size = 4;
 			info->bytes_per_block = 16;
 			if (!features.dxt_textures)
-				return false;
+			{
+				info->format = GSTexture::Format::Color;
+				info->conversion_function = DecompressTexture_BC<GSTexture::Format::BC3>;
+			}
 		}
 		else if (dxt10_format == 98 /*DXGI_FORMAT_BC7_UNORM*/)
 		{
@@ -493,7 +558,10 @@ static bool ParseDDSHeader(std::FILE* fp, DDSLoadInfo* info)
 			info->block_size = 4;
 			info->bytes_per_block = 16;
 			if (!features.bptc_textures)
-				return false;
+			{
+				info->format = GSTexture::Format::Color;
+				info->conversion_function = DecompressTexture_BC<GSTexture::Format::BC7>;
+			}
 		}
 		else
 		{
@@ -586,7 +654,7 @@ static bool ReadDDSMipLevel(std::FILE* fp, const std::string& filename, u32 mip_
 	if (std::fread(data.data(), size, 1, fp) != 1)
 		return false;
 
-	// Apply conversion function for uncompressed textures.
+	// Apply conversion function for uncompressed textures, or decompress if the device lacks support.
 	if (info.conversion_function)
 		info.conversion_function(width, height, data, pitch);
 
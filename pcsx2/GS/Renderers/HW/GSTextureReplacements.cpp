@@ -23,6 +23,7 @@
 #include <cstring>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
@@ -38,6 +39,7 @@
 #define TEXTURE_FILENAME_OLD_REGION_CLUT_FORMAT_STRING "%" PRIx64 "-%" PRIx64 "-r%" PRIx64 "-%08x"
 #define TEXTURE_REPLACEMENT_SUBDIRECTORY_NAME "replacements"
 #define TEXTURE_DUMP_SUBDIRECTORY_NAME "dumps"
+#define TEXTURE_REPLACEMENT_INDEX_FILENAME "replacements.idx"
 
 namespace
 {
@@ -112,6 +114,9 @@ namespace GSTextureReplacements
 	static void QueueAsyncReplacementTextureLoad(const TextureName& name, const std::string& filename, bool mipmap, bool cache_only);
 	static void PrecacheReplacementTextures();
 	static void ClearReplacementTextures();
+	static void AddReplacementTextureName(TextureName name, std::string filename);
+	static bool LoadReplacementIndex(const std::string& index_path);
+	static void SaveReplacementIndex(const std::string& index_path, const FileSystem::FindResultsArray& dirs);
 
 	static void StartWorkerThread();
 	static void StopWorkerThread();
@@ -142,14 +147,57 @@ namespace GSTextureReplacements
 	/// Second element is whether the texture should be created with mipmaps.
 	static std::vector<std::pair<TextureName, bool>> s_async_loaded_textures;
 
-	/// Loader/dumper thread.
-	static std::thread s_worker_thread;
+	/// Loader/dumper threads. Decoding big PNGs is slow, so several textures are decoded at once.
+	static constexpr u32 MAX_WORKER_THREADS = 4;
+	static std::vector<std::thread> s_worker_threads;
 	static std::mutex s_worker_thread_mutex;
 	static std::condition_variable s_worker_thread_cv;
 	static std::deque<std::pair<std::function<void()>, bool>> s_worker_thread_queue;
+	static u32 s_worker_threads_busy = 0;
 	static bool s_worker_thread_running = false;
+
+	/// Pixel data of dumps waiting to be compressed. Dumping only stalls the GS thread once this is full.
+	static constexpr u32 MAX_PENDING_DUMP_BYTES = 256 * 1024 * 1024;
+	static std::mutex s_pending_dump_mutex;
+	static std::condition_variable s_pending_dump_cv;
+	static u32 s_pending_dump_bytes = 0;
+
+	/// Readback buffer for a queued dump, released when the item runs or is cancelled.
+	struct PendingDump
+	{
+		u8* buffer;
+		u32 size;
+
+		PendingDump(u32 size_);
+		~PendingDump();
+	};
 }; // namespace GSTextureReplacements
 
+GSTextureReplacements::PendingDump::PendingDump(u32 size_)
+	: size(size_)
+{
+	std::unique_lock lock(s_pending_dump_mutex);
+	s_pending_dump_cv.wait(lock, [this]() {
+		return (s_pending_dump_bytes + size) <= MAX_PENDING_DUMP_BYTES || s_pending_dump_bytes == 0;
+	});
+	s_pending_dump_bytes += size;
+	lock.unlock();
+
+	// must be 32 byte aligned for ReadTexture().
+	buffer = static_cast<u8*>(_aligned_malloc(size, 32));
+}
+
+GSTextureReplacements::PendingDump::~PendingDump()
+{
+	_aligned_free(buffer);
+
+	{
+		std::unique_lock lock(s_pending_dump_mutex);
+		s_pending_dump_bytes -= size;
+	}
+	s_pending_dump_cv.notify_all();
+}
+
 TextureName GSTextureReplacements::CreateTextureName(const GSTextureCache::HashCacheKey& hash, u32 miplevel)
 {
 	TextureName name;
@@ -412,28 +460,45 @@ void GSTextureReplacements::ReloadReplacementMap()
 			Host::OSD_WARNING_DURATION);
 	}
 
-	if (!FileSystem::FindFiles(replacement_dir.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files))
-		return;
-
-	std::string filename;
-	for (FILESYSTEM_FIND_DATA& fd : files)
+	// scanning packs with a lot of files takes a while, so reuse the names from last time if nothing moved
+	const std::string index_path(Path::Combine(texture_dir, TEXTURE_REPLACEMENT_INDEX_FILENAME));
+	if (!LoadReplacementIndex(index_path))
 	{
-		// file format we can handle?
-		filename = Path::GetFileName(fd.FileName);
-		if (!GetLoader(filename))
-			continue;
+		if (!FileSystem::FindFiles(replacement_dir.c_str(), "*",
+				FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_FOLDERS | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files))
+		{
+			return;
+		}
 
-		// parse the name if it's valid
-		std::optional<TextureName> name = ParseReplacementName(filename);
-		if (!name.has_value())
-			continue;
+		FileSystem::FindResultsArray dirs;
+		FILESYSTEM_STAT_DATA sd;
+		if (FileSystem::StatFile(replacement_dir.c_str(), &sd))
+			dirs.push_back({sd.CreationTime, sd.ModificationTime, replacement_dir, sd.Size, sd.Attributes});
+
+		std::string filename;
+		for (FILESYSTEM_FIND_DATA& fd : files)
+		{
+			if (fd.Attributes & FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY)
+			{
+				dirs.push_back(std::move(fd));
+				continue;
+			}
 
-		DbgCon.WriteLn("Found %ux%u replacement '%.*s'", name->Width(), name->Height(), static_cast<int>(filename.size()), filename.data());
-		s_replacement_texture_filenames.emplace(name.value(), std::move(fd.FileName));
+			// file format we can handle?
+			filename = Path::GetFileName(fd.FileName);
+			if (!GetLoader(filename))
+				continue;
 
-		// zero out the CLUT hash, because we need this for checking if there's any replacements with this hash when using paltex
-		name->CLUTHash = 0;
-		s_replacement_textures_without_clut_hash.insert(name.value());
+			// parse the name if it's valid
+			std::optional<TextureName> name = ParseReplacementName(filename);
+			if (!name.has_value())
+				continue;
+
+			DbgCon.WriteLn("Found %ux%u replacement '%.*s'", name->Width(), name->Height(), static_cast<int>(filename.size()), filename.data());
+			AddReplacementTextureName(name.value(), std::move(fd.FileName));
+		}
+
+		SaveReplacementIndex(index_path, dirs);
 	}
 
 	if (!s_replacement_texture_filenames.empty())
@@ -450,6 +515,122 @@ void GSTextureReplacements::ReloadReplacementMap()
 	}
 }
 
+void GSTextureReplacements::AddReplacementTextureName(TextureName name, std::string filename)
+{
+	s_replacement_texture_filenames.emplace(name, std::move(filename));
+
+	// zero out the CLUT hash, because we need this for checking if there's any replacements with this hash when using paltex
+	name.CLUTHash = 0;
+	s_replacement_textures_without_clut_hash.insert(name);
+}
+
+namespace
+{
+	// Index layout: header, then each directory (mtime, path), then each replacement (name, path).
+	// Any file being added, removed or renamed bumps the mtime of the directory it's in.
+	static constexpr u32 REPLACEMENT_INDEX_MAGIC = 0x58444952; // RIDX
+	static constexpr u32 REPLACEMENT_INDEX_VERSION = 1;
+
+	struct ReplacementIndexHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 num_dirs;
+		u32 num_replacements;
+	};
+} // namespace
+
+bool GSTextureReplacements::LoadReplacementIndex(const std::string& index_path)
+{
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(index_path.c_str());
+	if (!data.has_value() || data->size() < sizeof(ReplacementIndexHeader))
+		return false;
+
+	ReplacementIndexHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != REPLACEMENT_INDEX_MAGIC || header.version != REPLACEMENT_INDEX_VERSION)
+		return false;
+
+	size_t pos = sizeof(header);
+	const auto read = [&data, &pos](void* dst, size_t size) {
+		if ((data->size() - pos) < size)
+			return false;
+		std::memcpy(dst, data->data() + pos, size);
+		pos += size;
+		return true;
+	};
+	const auto read_string = [&data, &pos, &read](std::string* str) {
+		u32 length;
+		if (!read(&length, sizeof(length)) || (data->size() - pos) < length)
+			return false;
+		str->assign(reinterpret_cast<const char*>(data->data() + pos), length);
+		pos += length;
+		return true;
+	};
+
+	std::string path;
+	for (u32 i = 0; i < header.num_dirs; i++)
+	{
+		s64 mtime;
+		FILESYSTEM_STAT_DATA sd;
+		if (!read(&mtime, sizeof(mtime)) || !read_string(&path) || !FileSystem::StatFile(path.c_str(), &sd) ||
+			static_cast<s64>(sd.ModificationTime) != mtime)
+		{
+			return false;
+		}
+	}
+
+	for (u32 i = 0; i < header.num_replacements; i++)
+	{
+		TextureName name;
+		if (!read(&name, sizeof(name)) || !read_string(&path))
+		{
+			s_replacement_texture_filenames.clear();
+			s_replacement_textures_without_clut_hash.clear();
+			return false;
+		}
+
+		AddReplacementTextureName(name, std::move(path));
+	}
+
+	DevCon.WriteLn("Loaded %u replacement texture names from index.", header.num_replacements);
+	return true;
+}
+
+void GSTextureReplacements::SaveReplacementIndex(const std::string& index_path, const FileSystem::FindResultsArray& dirs)
+{
+	std::vector<u8> data;
+	const auto write = [&data](const void* src, size_t size) {
+		data.insert(data.end(), static_cast<const u8*>(src), static_cast<const u8*>(src) + size);
+	};
+	const auto write_string = [&write](const std::string& str) {
+		const u32 length = static_cast<u32>(str.size());
+		write(&length, sizeof(length));
+		write(str.data(), str.size());
+	};
+
+	const ReplacementIndexHeader header = {REPLACEMENT_INDEX_MAGIC, REPLACEMENT_INDEX_VERSION,
+		static_cast<u32>(dirs.size()), static_cast<u32>(s_replacement_texture_filenames.size())};
+	write(&header, sizeof(header));
+
+	for (const FILESYSTEM_FIND_DATA& fd : dirs)
+	{
+		const s64 mtime = static_cast<s64>(fd.ModificationTime);
+		write(&mtime, sizeof(mtime));
+		write_string(fd.FileName);
+	}
+
+	for (const auto& [name, filename] : s_replacement_texture_filenames)
+	{
+		write(&name, sizeof(name));
+		write_string(filename);
+	}
+
+	// not fatal, the directory might be read-only
+	if (!FileSystem::WriteBinaryFile(index_path.c_str(), data.data(), data.size()))
+		DevCon.Warning("Failed to write replacement index to '%s'.", index_path.c_str());
+}
+
 void GSTextureReplacements::UpdateConfig(Pcsx2Config::GSOptions& old_config)
 {
 	// get rid of worker thread if it's no longer needed
@@ -827,16 +1008,14 @@ void GSTextureReplacements::DumpTexture(const GSTextureCache::HashCacheKey& hash
 	const u32 pitch = static_cast<u32>(read_width) * sizeof(u32);
 
 	// use per-texture buffer so we can compress the texture asynchronously and not block the GS thread
-	// must be 32 byte aligned for ReadTexture().
-	u8* buffer = static_cast<u8*>(_aligned_malloc(pitch * static_cast<u32>(read_height), 32));
-	psm.rtx(mem, mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM), block_rect, buffer, pitch, TEXA);
+	std::shared_ptr<PendingDump> dump = std::make_shared<PendingDump>(pitch * static_cast<u32>(read_height));
+	psm.rtx(mem, mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM), block_rect, dump->buffer, pitch, TEXA);
 
 	// okay, now we can actually dump it
 	const u32 buffer_offset = ((rect.top - block_rect.top) * pitch) + ((rect.left - block_rect.left) * sizeof(u32));
-	QueueWorkerThreadItem([filename = std::move(filename), tw, th, pitch, buffer, buffer_offset]() {
-		if (!SavePNGImage(filename.c_str(), tw, th, buffer + buffer_offset, pitch))
+	QueueWorkerThreadItem([filename = std::move(filename), tw, th, pitch, dump = std::move(dump), buffer_offset]() {
+		if (!SavePNGImage(filename.c_str(), tw, th, dump->buffer + buffer_offset, pitch))
 			Console.Error(fmt::format("Failed to dump texture to '{}'.", filename));
-		_aligned_free(buffer);
 	}, false);
 }
 
@@ -853,25 +1032,31 @@ void GSTextureReplacements::StartWorkerThread()
 {
 	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
 
-	if (s_worker_thread.joinable())
+	if (!s_worker_threads.empty())
 		return;
 
+	// Leave half the cores for the emulator itself.
+	const u32 num_threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_WORKER_THREADS);
+
 	s_worker_thread_running = true;
-	s_worker_thread = std::thread(WorkerThreadEntryPoint);
+	for (u32 i = 0; i < num_threads; i++)
+		s_worker_threads.emplace_back(WorkerThreadEntryPoint);
 }
 
 void GSTextureReplacements::StopWorkerThread()
 {
 	{
 		std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-		if (!s_worker_thread.joinable())
+		if (s_worker_threads.empty())
 			return;
 
 		s_worker_thread_running = false;
-		s_worker_thread_cv.notify_one();
+		s_worker_thread_cv.notify_all();
 	}
 
-	s_worker_thread.join();
+	for (std::thread& thread : s_worker_threads)
+		thread.join();
+	s_worker_threads.clear();
 
 	// clear out workery-things too
 	CancelPendingLoadsAndDumps();
@@ -879,7 +1064,7 @@ void GSTextureReplacements::StopWorkerThread()
 
 void GSTextureReplacements::QueueWorkerThreadItem(std::function<void()> fn, bool high_priority)
 {
-	pxAssert(s_worker_thread.joinable());
+	pxAssert(!s_worker_threads.empty());
 
 	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
 	if (!high_priority)
@@ -928,22 +1113,25 @@ void GSTextureReplacements::WorkerThreadEntryPoint()
 
 		std::function<void()> fn = std::move(s_worker_thread_queue.front().first);
 		s_worker_thread_queue.pop_front();
+		s_worker_threads_busy++;
 		lock.unlock();
 		fn();
 		lock.lock();
+		s_worker_threads_busy--;
 	}
 }
 
 void GSTextureReplacements::SyncWorkerThread()
 {
 	std::unique_lock<std::mutex> lock(s_worker_thread_mutex);
-	if (!s_worker_thread.joinable())
+	if (s_worker_threads.empty())
 		return;
 
 	// not the most efficient by far, but it only gets called on config changes, so whatever
 	for (;;)
 	{
-		if (s_worker_thread_queue.empty())
+		// other threads may still be finishing off their items
+		if (s_worker_thread_queue.empty() && s_worker_threads_busy == 0)
 			break;
 
 		lock.unlock();
@@ -218,6 +218,9 @@ public:
 	MRCOwned<id<MTLCommandQueue>> m_queue;
 	MRCOwned<id<MTLFence>> m_draw_sync_fence;
 	MRCOwned<MTLFunctionConstantValues*> m_fn_constants;
+	/// Persists compiled pipelines across runs, nil when the shader cache is disabled.
+	MRCOwned<id<MTLBinaryArchive>> m_pipeline_archive;
+	bool m_pipeline_archive_dirty = false;
 	MRCOwned<MTLVertexDescriptor*> m_hw_vertex;
 	MTLResourceOptions m_resource_options_shared_wc;
 
@@ -372,6 +375,8 @@ public:
 	MRCOwned<id<MTLFunction>> LoadShader(NSString* name);
 	MRCOwned<id<MTLRenderPipelineState>> MakePipeline(MTLRenderPipelineDescriptor* desc, id<MTLFunction> vertex, id<MTLFunction> fragment, NSString* name);
 	MRCOwned<id<MTLComputePipelineState>> MakeComputePipeline(id<MTLFunction> compute, NSString* name);
+	void OpenPipelineArchive();
+	void SavePipelineArchive();
 	bool Create(GSVSyncMode vsync_mode, bool allow_present_throttle) override;
 	void Destroy() override;
 
@@ -413,6 +418,7 @@ public:
 	void DrawMultiStretchRects(const MultiStretchRect* rects, u32 num_rects, GSTexture* dTex, ShaderConvert shader) override;
 	void UpdateCLUTTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize) override;
 	void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM) override;
+	void UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM) override;
 	void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) override;
 
 	void FlushClears(GSTexture* tex);
@@ -6,9 +6,12 @@
 #include "GS/Renderers/Metal/GSDeviceMTL.h"
 #include "GS/Renderers/Metal/GSTextureMTL.h"
 #include "GS/GSPerfMon.h"
+#include "ShaderCacheVersion.h"
 
 #include "common/Console.h"
+#include "common/FileSystem.h"
 #include "common/HostSys.h"
+#include "common/Path.h"
 
 #include "cpuinfo.h"
 #include "imgui.h"
@@ -694,8 +697,27 @@ MRCOwned<id<MTLRenderPipelineState>> GSDeviceMTL::MakePipeline(MTLRenderPipeline
 	[desc setLabel:name];
 	[desc setVertexFunction:vertex];
 	[desc setFragmentFunction:fragment];
-	NSError* err;
-	MRCOwned<id<MTLRenderPipelineState>> res = MRCTransfer([m_dev.dev newRenderPipelineStateWithDescriptor:desc error:&err]);
+	NSError* err = nil;
+	MRCOwned<id<MTLRenderPipelineState>> res;
+	if (m_pipeline_archive)
+	{
+		[desc setBinaryArchives:@[m_pipeline_archive.Get()]];
+		res = MRCTransfer([m_dev.dev newRenderPipelineStateWithDescriptor:desc
+		                                                          options:MTLPipelineOptionFailOnBinaryArchiveMiss
+		                                                       reflection:nil
+		                                                            error:nil]);
+		if (!res)
+		{
+			// Not in the archive yet, add it so the next run can skip the compile.
+			if ([m_pipeline_archive addRenderPipelineFunctionsWithDescriptor:desc error:&err])
+				m_pipeline_archive_dirty = true;
+			else
+				Console.Warning("Metal: Failed to add pipeline %s to archive: %s", [name UTF8String], [[err localizedDescription] UTF8String]);
+			err = nil;
+		}
+	}
+	if (!res)
+		res = MRCTransfer([m_dev.dev newRenderPipelineStateWithDescriptor:desc error:&err]);
 	if (err) [[unlikely]]
 	{
 		NSString* msg = [NSString stringWithFormat:@"Failed to create pipeline %@: %@", name, [err localizedDescription]];
@@ -705,6 +727,50 @@ MRCOwned<id<MTLRenderPipelineState>> GSDeviceMTL::MakePipeline(MTLRenderPipeline
 	return res;
 }
 
+static std::string GetPipelineArchiveFileName()
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("metal_pipelines_v{}.bin", SHADER_CACHE_VERSION));
+}
+
+void GSDeviceMTL::OpenPipelineArchive()
+{
+	if (GSConfig.DisableShaderCache)
+	{
+		Console.WriteLn("Metal: Not using pipeline archive.");
+		return;
+	}
+
+	const std::string path = GetPipelineArchiveFileName();
+	auto desc = MRCTransfer([MTLBinaryArchiveDescriptor new]);
+	if (FileSystem::FileExists(path.c_str()))
+		[desc setUrl:[NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]]];
+
+	NSError* err = nil;
+	m_pipeline_archive = MRCTransfer([m_dev.dev newBinaryArchiveWithDescriptor:desc error:&err]);
+	if (!m_pipeline_archive && [desc url])
+	{
+		// Probably written by a different GPU or OS version, start over.
+		Console.Warning("Metal: Failed to load pipeline archive: %s", [[err localizedDescription] UTF8String]);
+		[desc setUrl:nil];
+		m_pipeline_archive = MRCTransfer([m_dev.dev newBinaryArchiveWithDescriptor:desc error:&err]);
+	}
+	if (!m_pipeline_archive)
+		Console.Warning("Metal: Failed to create pipeline archive: %s", [[err localizedDescription] UTF8String]);
+	m_pipeline_archive_dirty = false;
+}
+
+void GSDeviceMTL::SavePipelineArchive()
+{
+	if (!m_pipeline_archive || !m_pipeline_archive_dirty || GSConfig.ReadOnlyShaderCache)
+		return;
+
+	const std::string path = GetPipelineArchiveFileName();
+	NSError* err = nil;
+	if (![m_pipeline_archive serializeToURL:[NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]] error:&err])
+		Console.Warning("Metal: Failed to save pipeline archive: %s", [[err localizedDescription] UTF8String]);
+	m_pipeline_archive_dirty = false;
+}
+
 MRCOwned<id<MTLComputePipelineState>> GSDeviceMTL::MakeComputePipeline(id<MTLFunction> compute, NSString* name)
 {
 	MRCOwned<MTLComputePipelineDescriptor*> desc = MRCTransfer([MTLComputePipelineDescriptor new]);
@@ -1041,6 +1107,8 @@ bool GSDeviceMTL::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 		m_dss_hw[i] = MRCTransfer([m_dev.dev newDepthStencilStateWithDescriptor:dssdesc]);
 	}
 
+	OpenPipelineArchive();
+
 	// Init HW Vertex Shaders
 	for (size_t i = 0; i < std::size(m_hw_vs); i++)
 	{
@@ -1148,6 +1216,7 @@ bool GSDeviceMTL::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 			case ShaderConvert::DOWNSAMPLE_COPY:
 			case ShaderConvert::RGBA_TO_8I: // Yes really
 			case ShaderConvert::RGB5A1_TO_8I:
+			case ShaderConvert::UNSWIZZLE_CT32:
 			case ShaderConvert::RTA_CORRECTION:
 			case ShaderConvert::RTA_DECORRECTION:
 			case ShaderConvert::TRANSPARENCY_FILTER:
@@ -1226,6 +1295,8 @@ void GSDeviceMTL::Destroy()
 
 	GSDevice::Destroy();
 	GSDeviceMTL::DestroySurface();
+	SavePipelineArchive();
+	m_pipeline_archive = nullptr;
 	m_queue = nullptr;
 	m_dev.Reset();
 }}
@@ -1738,6 +1809,19 @@ void GSDeviceMTL::ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 off
 	DoStretchRect(sTex, GSVector4::zero(), dTex, dRect, pipeline, false, LoadAction::DontCareIfFull, &uniform, sizeof(uniform));
 }}
 
+void GSDeviceMTL::UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM)
+{ @autoreleasepool {
+	const ShaderConvert shader = ShaderConvert::UNSWIZZLE_CT32;
+	id<MTLRenderPipelineState> pipeline = m_convert_pipeline[static_cast<int>(shader)];
+	if (!pipeline)
+		[NSException raise:@"StretchRect Missing Pipeline" format:@"No pipeline for %d", static_cast<int>(shader)];
+
+	GSMTLUnswizzlePSUniform uniform = { {static_cast<uint>(origin.x), static_cast<uint>(origin.y)},
+	  static_cast<float>(TA0) / 255.f, AEM, BP, BW, PSM };
+
+	DoStretchRect(sTex, GSVector4::zero(), dTex, GSVector4(dRect), pipeline, false, LoadAction::DontCareIfFull, &uniform, sizeof(uniform));
+}}
+
 void GSDeviceMTL::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
 { @autoreleasepool {
 	const ShaderConvert shader = ShaderConvert::DOWNSAMPLE_COPY;
@@ -1818,6 +1902,8 @@ void GSDeviceMTL::MRESetHWPipelineState(GSHWDrawConfig::VSSelector vssel, GSHWDr
 		return;
 	}
 
+	g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
 	bool primid_tracking_init = pssel.date == 1 || pssel.date == 2;
 
 	VSSelector vssel_mtl;
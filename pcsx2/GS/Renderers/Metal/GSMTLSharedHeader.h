@@ -67,6 +67,16 @@ struct GSMTLIndexedConvertPSUniform
 	uint psm;
 };
 
+struct GSMTLUnswizzlePSUniform
+{
+	vector_uint2 origin;
+	float ta0;
+	uint aem;
+	uint bp;
+	uint bw;
+	uint psm;
+};
+
 struct GSMTLDownsamplePSUniform
 {
 	vector_uint2 clamp_min;
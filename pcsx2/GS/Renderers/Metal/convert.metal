@@ -453,6 +453,26 @@ fragment float4 ps_convert_rgba_8i(ConvertShaderData data [[stage_in]], DirectRe
 	return float4(sel1);
 }
 
+fragment float4 ps_unswizzle_ct32(ConvertShaderData data [[stage_in]], DirectReadTextureIn<float> res,
+	constant GSMTLUnswizzlePSUniform& uniform [[buffer(GSMTLBufferIndexUniforms)]])
+{
+	// Read a PSMCT32/PSMCT24 texel from the copy of local memory, stored as 1024 words per row.
+	uint2 pos = (uint2(data.p.xy) + uniform.origin) & 2047u;
+
+	// Pages are 64x32, blocks 8x8, see blockTable32 and columnTable32.
+	uint page = (pos.y >> 5) * uniform.bw + (pos.x >> 6);
+	uint2 b = (pos >> 3) & uint2(7, 3);
+	uint block = (b.x & 1) | ((b.y & 1) << 1) | ((b.x & 2) << 1) | ((b.y & 2) << 2) | ((b.x & 4) << 2);
+	uint2 p = pos & 7u;
+	uint word = (p.x & 1) | ((p.y & 1) << 1) | ((p.x & 6) << 1) | ((p.y & 6) << 3);
+	uint addr = (((uniform.bp + (page << 5) + block) & 0x3FFF) << 6) | word;
+
+	float4 pixel = res.tex.read(uint2(addr & 1023, addr >> 10));
+	if (uniform.psm == 1) // PSMCT24, expand alpha like ExpandBlock24().
+		pixel.a = (uniform.aem && all(pixel.rgb == 0.f)) ? 0.f : uniform.ta0;
+	return pixel;
+}
+
 fragment float4 ps_convert_clut_4(ConvertShaderData data [[stage_in]],
 	texture2d<float> texture [[texture(GSMTLTextureIndexNonHW)]],
 	constant GSMTLCLUTConvertPSUniform& uniform [[buffer(GSMTLBufferIndexUniforms)]])
@@ -115,6 +115,30 @@ bool GLProgram::Compile(const std::string_view vertex_shader, const std::string_
 	return true;
 }
 
+bool GLProgram::CompileAsync(const std::string_view vertex_shader, const std::string_view fragment_shader)
+{
+	const auto submit = [](GLenum type, const std::string_view source) {
+		const GLuint id = glCreateShader(type);
+		const GLchar* source_ptr = source.data();
+		const GLint source_length = static_cast<GLint>(source.size());
+		glShaderSource(id, 1, &source_ptr, &source_length);
+		glCompileShader(id);
+		return id;
+	};
+
+	if (!vertex_shader.empty())
+		m_vertex_shader_id = submit(GL_VERTEX_SHADER, vertex_shader);
+	if (!fragment_shader.empty())
+		m_fragment_shader_id = submit(GL_FRAGMENT_SHADER, fragment_shader);
+
+	m_program_id = glCreateProgram();
+	if (m_vertex_shader_id != 0)
+		glAttachShader(m_program_id, m_vertex_shader_id);
+	if (m_fragment_shader_id != 0)
+		glAttachShader(m_program_id, m_fragment_shader_id);
+	return true;
+}
+
 bool GLProgram::CompileCompute(const std::string_view glsl)
 {
 	GLuint id = CompileShader(GL_COMPUTE_SHADER, glsl);
@@ -215,6 +239,48 @@ void GLProgram::BindFragDataIndexed(GLuint color_number /*= 0*/, const char* nam
 bool GLProgram::Link()
 {
 	glLinkProgram(m_program_id);
+	return FinishLink();
+}
+
+void GLProgram::LinkAsync()
+{
+	glLinkProgram(m_program_id);
+}
+
+bool GLProgram::IsCompletionPending() const
+{
+	GLint status = GL_TRUE;
+	glGetProgramiv(m_program_id, GL_COMPLETION_STATUS_KHR, &status);
+	return (status == GL_FALSE);
+}
+
+bool GLProgram::FinishLink()
+{
+	GLint status = GL_FALSE;
+	glGetProgramiv(m_program_id, GL_LINK_STATUS, &status);
+
+	// Shaders submitted through CompileAsync() never had their status checked, so report them here.
+	if (status == GL_FALSE)
+	{
+		for (const GLuint id : {m_vertex_shader_id, m_fragment_shader_id})
+		{
+			if (id == 0)
+				continue;
+
+			GLint compile_status = GL_TRUE;
+			glGetShaderiv(id, GL_COMPILE_STATUS, &compile_status);
+			if (compile_status == GL_TRUE)
+				continue;
+
+			GLint shader_log_length = 0;
+			glGetShaderiv(id, GL_INFO_LOG_LENGTH, &shader_log_length);
+
+			std::string shader_log;
+			shader_log.resize(shader_log_length + 1);
+			glGetShaderInfoLog(id, shader_log_length, &shader_log_length, &shader_log[0]);
+			Console.Error("Shader failed to compile:\n%s", shader_log.c_str());
+		}
+	}
 
 	if (m_vertex_shader_id != 0)
 		glDeleteShader(m_vertex_shader_id);
@@ -223,9 +289,6 @@ bool GLProgram::Link()
 		glDeleteShader(m_fragment_shader_id);
 	m_fragment_shader_id = 0;
 
-	GLint status = GL_FALSE;
-	glGetProgramiv(m_program_id, GL_LINK_STATUS, &status);
-
 	GLint info_log_length = 0;
 
 	// Log will create a new line when there are no warnings so let's set a minimum log length of 1.
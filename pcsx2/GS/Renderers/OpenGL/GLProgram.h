@@ -27,6 +27,10 @@ public:
 
 	bool CompileCompute(const std::string_view glsl);
 
+	/// Submits the shaders without waiting for the compile status, for use with KHR_parallel_shader_compile.
+	/// Errors are reported by FinishLink() instead.
+	bool CompileAsync(const std::string_view vertex_shader, const std::string_view fragment_shader);
+
 	bool CreateFromBinary(const void* data, u32 data_length, u32 data_format);
 
 	bool GetBinary(std::vector<u8>* out_data, u32* out_data_format);
@@ -40,6 +44,11 @@ public:
 
 	bool Link();
 
+	/// Starts linking without checking the result, poll IsCompletionPending() before calling FinishLink().
+	void LinkAsync();
+	bool IsCompletionPending() const;
+	bool FinishLink();
+
 	void Bind() const;
 
 	void Destroy();
@@ -84,6 +84,13 @@ bool GLShaderCache::Open()
 		if (ReadExisting(index_filename, blob_filename))
 			return true;
 
+		// Shared between several processes, never replace it.
+		if (GSConfig.ReadOnlyShaderCache)
+		{
+			Console.Warning("Read-only shader cache is missing or invalid, continuing without it.");
+			return true;
+		}
+
 		return CreateNew(index_filename, blob_filename);
 	}
 
@@ -103,7 +110,7 @@ bool GLShaderCache::CreateNew(const std::string& index_filename, const std::stri
 		FileSystem::DeleteFilePath(blob_filename.c_str());
 	}
 
-	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "wb");
+	m_index_file = FileSystem::OpenSharedCFile(index_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_index_file)
 	{
 		Console.Error("Failed to open index file '%s' for writing", index_filename.c_str());
@@ -120,7 +127,7 @@ bool GLShaderCache::CreateNew(const std::string& index_filename, const std::stri
 		return false;
 	}
 
-	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "w+b");
+	m_blob_file = FileSystem::OpenSharedCFile(blob_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_blob_file)
 	{
 		Console.Error("Failed to open blob file '%s' for writing", blob_filename.c_str());
@@ -130,12 +137,17 @@ bool GLShaderCache::CreateNew(const std::string& index_filename, const std::stri
 		return false;
 	}
 
+	m_index_read_pos = FileSystem::FTell64(m_index_file);
 	return true;
 }
 
 bool GLShaderCache::ReadExisting(const std::string& index_filename, const std::string& blob_filename)
 {
-	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "r+b");
+	const bool read_only = GSConfig.ReadOnlyShaderCache;
+	// Writable caches can be shared by several instances, see WriteToBlobFile().
+	m_index_file = read_only ?
+					   FileSystem::OpenSharedCFile(index_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					   FileSystem::OpenSharedCFile(index_filename.c_str(), "r+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_index_file)
 	{
 		// special case here: when there's a sharing violation (i.e. two instances running),
@@ -158,7 +170,9 @@ bool GLShaderCache::ReadExisting(const std::string& index_filename, const std::s
 		return false;
 	}
 
-	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "a+b");
+	m_blob_file = read_only ?
+					  FileSystem::OpenSharedCFile(blob_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					  FileSystem::OpenSharedCFile(blob_filename.c_str(), "a+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_blob_file)
 	{
 		Console.Error("Blob file '%s' is missing", blob_filename.c_str());
@@ -167,35 +181,65 @@ bool GLShaderCache::ReadExisting(const std::string& index_filename, const std::s
 		return false;
 	}
 
-	std::fseek(m_blob_file, 0, SEEK_END);
-	const u32 blob_file_size = static_cast<u32>(std::ftell(m_blob_file));
+	m_index_read_pos = FileSystem::FTell64(m_index_file);
+	if (!ReadNewIndexEntries())
+	{
+		Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
+		m_index.clear();
+		std::fclose(m_blob_file);
+		m_blob_file = nullptr;
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		return false;
+	}
+
+	if (read_only)
+	{
+		// new programs won't be added, so the index isn't needed past this point
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+	}
+
+	Console.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
+	return true;
+}
+
+bool GLShaderCache::ReadNewIndexEntries()
+{
+	if (FileSystem::FSeek64(m_index_file, m_index_read_pos, SEEK_SET) != 0)
+		return false;
+
+	const s64 blob_file_size = FileSystem::FSize64(m_blob_file);
 
 	for (;;)
 	{
 		CacheIndexEntry entry;
-		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1 ||
-			(entry.file_offset + entry.blob_size) > blob_file_size)
+		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1)
 		{
-			if (std::feof(m_index_file))
-				break;
-
-			Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
-			m_index.clear();
-			std::fclose(m_blob_file);
-			m_blob_file = nullptr;
-			std::fclose(m_index_file);
-			m_index_file = nullptr;
-			return false;
+			// A partial entry at the end is still being written by another instance.
+			return !std::ferror(m_index_file);
 		}
 
+		if ((static_cast<s64>(entry.file_offset) + entry.blob_size) > blob_file_size)
+			return false;
+
 		const CacheIndexKey key{entry.vertex_source_hash_low, entry.vertex_source_hash_high, entry.vertex_source_length,
 			entry.fragment_source_hash_low, entry.fragment_source_hash_high, entry.fragment_source_length};
 		const CacheIndexData data{entry.file_offset, entry.blob_size, entry.blob_format};
 		m_index.emplace(key, data);
+		m_index_read_pos += sizeof(entry);
 	}
+}
 
-	Console.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
-	return true;
+GLShaderCache::CacheIndex::const_iterator GLShaderCache::FindEntry(const CacheIndexKey& key)
+{
+	auto iter = m_index.find(key);
+
+	// Another instance sharing the cache might have added it since we last looked.
+	if (iter == m_index.end() && m_index_file && ReadNewIndexEntries())
+		iter = m_index.find(key);
+
+	return iter;
 }
 
 void GLShaderCache::Close()
@@ -217,6 +261,9 @@ bool GLShaderCache::Recreate()
 {
 	Close();
 
+	if (GSConfig.ReadOnlyShaderCache)
+		return false;
+
 	const std::string index_filename = GetIndexFileName();
 	const std::string blob_filename = GetBlobFileName();
 
@@ -285,7 +332,7 @@ std::optional<GLProgram> GLShaderCache::GetProgram(
 	}
 
 	const auto key = GetCacheKey(vertex_shader, fragment_shader);
-	auto iter = m_index.find(key);
+	auto iter = FindEntry(key);
 	if (iter == m_index.end())
 		return CompileAndAddProgram(key, vertex_shader, fragment_shader, callback);
 
@@ -330,10 +377,63 @@ bool GLShaderCache::GetProgram(GLProgram* out_program, const std::string_view ve
 	return true;
 }
 
+bool GLShaderCache::GetProgramAsync(GLProgram* out_program, bool* out_pending, const std::string_view vertex_shader,
+	const std::string_view fragment_shader, const PreLinkCallback& callback /* = */)
+{
+	const bool cacheable = (m_program_binary_supported && m_blob_file);
+	if (cacheable && FindEntry(GetCacheKey(vertex_shader, fragment_shader)) != m_index.end())
+	{
+		*out_pending = false;
+		return GetProgram(out_program, vertex_shader, fragment_shader, callback);
+	}
+
+	GLProgram prog;
+	if (!prog.CompileAsync(vertex_shader, fragment_shader))
+		return false;
+
+	if (callback)
+		callback(prog);
+
+	if (cacheable)
+		prog.SetBinaryRetrievableHint();
+
+	prog.LinkAsync();
+
+	*out_program = std::move(prog);
+	*out_pending = true;
+	return true;
+}
+
+bool GLShaderCache::FinishAsyncProgram(
+	GLProgram* program, const std::string_view vertex_shader, const std::string_view fragment_shader)
+{
+	if (!program->FinishLink())
+		return false;
+
+	if (!m_program_binary_supported || !m_blob_file)
+		return true;
+
+	std::vector<u8> prog_data;
+	u32 prog_format = 0;
+	if (program->GetBinary(&prog_data, &prog_format))
+		WriteToBlobFile(GetCacheKey(vertex_shader, fragment_shader), prog_data, prog_format);
+
+	return true;
+}
+
 bool GLShaderCache::WriteToBlobFile(const CacheIndexKey& key, const std::vector<u8>& prog_data, u32 prog_format)
 {
-	if (!m_blob_file || std::fseek(m_blob_file, 0, SEEK_END) != 0)
+	if (!m_blob_file || !m_index_file)
+		return false;
+
+	// Other instances append to the same files, so pick the blob offset and write both files under the lock.
+	// The blob goes first, readers don't take the lock and will only see the index entry once the data is there.
+	FileSystem::SharedFileLock lock(m_index_file);
+	if (!ReadNewIndexEntries() || m_index.find(key) != m_index.end() || std::fseek(m_blob_file, 0, SEEK_END) != 0 ||
+		FileSystem::FSeek64(m_index_file, m_index_read_pos, SEEK_SET) != 0)
+	{
 		return false;
+	}
 
 	CacheIndexData data;
 	data.file_offset = static_cast<u32>(std::ftell(m_blob_file));
@@ -359,6 +459,7 @@ bool GLShaderCache::WriteToBlobFile(const CacheIndexKey& key, const std::vector<
 		return false;
 	}
 
+	m_index_read_pos += sizeof(entry);
 	m_index.emplace(key, data);
 	return true;
 }
@@ -455,7 +556,7 @@ std::optional<GLProgram> GLShaderCache::GetComputeProgram(const std::string_view
 	}
 
 	const auto key = GetCacheKey(glsl, std::string_view());
-	auto iter = m_index.find(key);
+	auto iter = FindEntry(key);
 	if (iter == m_index.end())
 		return CompileAndAddComputeProgram(key, glsl, callback);
 
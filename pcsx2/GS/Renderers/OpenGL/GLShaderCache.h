@@ -30,6 +30,13 @@ public:
 	bool GetProgram(GLProgram* out_program, const std::string_view vertex_shader,
 		const std::string_view fragment_shader, const PreLinkCallback& callback = {});
 
+	/// Returns a program which may still be compiling, cached binaries are always loaded immediately.
+	/// When *out_pending is set, poll GLProgram::IsCompletionPending() and then call FinishAsyncProgram().
+	bool GetProgramAsync(GLProgram* out_program, bool* out_pending, const std::string_view vertex_shader,
+		const std::string_view fragment_shader, const PreLinkCallback& callback = {});
+	bool FinishAsyncProgram(
+		GLProgram* program, const std::string_view vertex_shader, const std::string_view fragment_shader);
+
 	std::optional<GLProgram> GetComputeProgram(const std::string_view glsl, const PreLinkCallback& callback = {});
 	bool GetComputeProgram(GLProgram* out_program, const std::string_view glsl, const PreLinkCallback& callback = {});
 
@@ -74,6 +81,8 @@ private:
 
 	bool CreateNew(const std::string& index_filename, const std::string& blob_filename);
 	bool ReadExisting(const std::string& index_filename, const std::string& blob_filename);
+	bool ReadNewIndexEntries();
+	CacheIndex::const_iterator FindEntry(const CacheIndexKey& key);
 	bool Recreate();
 
 	bool WriteToBlobFile(const CacheIndexKey& key, const std::vector<u8>& prog_data, u32 prog_format);
@@ -90,6 +99,7 @@ private:
 
 	std::FILE* m_index_file = nullptr;
 	std::FILE* m_blob_file = nullptr;
+	s64 m_index_read_pos = 0; ///< End of the last complete index entry, other instances may append past it.
 
 	CacheIndex m_index;
 	bool m_program_binary_supported = false;
@@ -203,6 +203,23 @@ bool GSDeviceOGL::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 		Console.WriteLn("GL: Not using shader cache.");
 	}
 
+	m_async_shader_compile = GSConfig.AsyncShaderCompilation &&
+							 (GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile);
+	if (m_async_shader_compile)
+	{
+		// Let the driver pick the number of compiler threads.
+		if (GLAD_GL_KHR_parallel_shader_compile)
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+		else
+			glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+
+		Console.WriteLn("GL: Using asynchronous shader compilation.");
+	}
+	else if (GSConfig.AsyncShaderCompilation)
+	{
+		Console.Warning("GL: Asynchronous shader compilation requires KHR_parallel_shader_compile, ignoring.");
+	}
+
 	// because of fbo bindings below...
 	GLState::Clear();
 
@@ -360,6 +377,15 @@ bool GSDeviceOGL::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 				m_convert.ps[i].RegisterUniform("offset");
 				m_convert.ps[i].RegisterUniform("scale");
 			}
+			else if (static_cast<ShaderConvert>(i) == ShaderConvert::UNSWIZZLE_CT32)
+			{
+				m_convert.ps[i].RegisterUniform("Origin");
+				m_convert.ps[i].RegisterUniform("TA0");
+				m_convert.ps[i].RegisterUniform("AEM");
+				m_convert.ps[i].RegisterUniform("BP");
+				m_convert.ps[i].RegisterUniform("BW");
+				m_convert.ps[i].RegisterUniform("PSM");
+			}
 			else if (static_cast<ShaderConvert>(i) == ShaderConvert::DOWNSAMPLE_COPY)
 			{
 				m_convert.ps[i].RegisterUniform("ClampMin");
@@ -799,6 +825,7 @@ void GSDeviceOGL::DestroyResources()
 		glDeleteSamplers(1, &m_palette_ss);
 
 	m_programs.clear();
+	m_pending_programs.clear();
 
 	for (GSDepthStencilOGL* ds : m_om_dss)
 		delete ds;
@@ -1334,7 +1361,7 @@ std::string GSDeviceOGL::GetVSSource(VSSelector sel)
 	return src;
 }
 
-std::string GSDeviceOGL::GetPSSource(const PSSelector& sel)
+std::string GSDeviceOGL::GetPSSource(const PSSelector& sel, bool dynamic /* = false */)
 {
 	DevCon.WriteLn("GL: Compiling new pixel shader with selector 0x%" PRIX64 "%08X", sel.key_hi, sel.key_lo);
 
@@ -1393,6 +1420,7 @@ std::string GSDeviceOGL::GetPSSource(const PSSelector& sel)
 		+ fmt::format("#define PS_SCANMSK {}\n", sel.scanmsk)
 		+ fmt::format("#define PS_NO_COLOR {}\n", sel.no_color)
 		+ fmt::format("#define PS_NO_COLOR1 {}\n", sel.no_color1)
+		+ fmt::format("#define PS_DYNAMIC {}\n", static_cast<u32>(dynamic))
 	;
 
 	std::string src = GenGlslHeader("ps_main", GL_FRAGMENT_SHADER, macro);
@@ -1615,6 +1643,31 @@ void GSDeviceOGL::ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 off
 	DrawStretchRect(GSVector4::zero(), dRect, dTex->GetSize());
 }
 
+void GSDeviceOGL::UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM)
+{
+	CommitClear(sTex, false);
+
+	constexpr ShaderConvert shader = ShaderConvert::UNSWIZZLE_CT32;
+	GLProgram& prog = m_convert.ps[static_cast<int>(shader)];
+	prog.Bind();
+	prog.Uniform2f(0, static_cast<float>(origin.x), static_cast<float>(origin.y));
+	prog.Uniform1f(1, static_cast<float>(TA0) / 255.0f);
+	prog.Uniform1f(2, AEM ? 1.0f : 0.0f);
+	prog.Uniform1ui(3, BP);
+	prog.Uniform1ui(4, BW);
+	prog.Uniform1ui(5, PSM);
+
+	OMSetDepthStencilState(m_convert.dss);
+	OMSetBlendState(false);
+	OMSetColorMaskState();
+	OMSetRenderTargets(dTex, nullptr);
+
+	PSSetShaderResource(0, sTex);
+	PSSetSamplerState(m_convert.pt);
+
+	DrawStretchRect(GSVector4::zero(), GSVector4(dRect), dTex->GetSize());
+}
+
 void GSDeviceOGL::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
 {
 	CommitClear(sTex, false);
@@ -2358,6 +2411,30 @@ void GSDeviceOGL::SetupPipeline(const ProgramSelector& psel)
 		return;
 	}
 
+	if (m_async_shader_compile)
+	{
+		if (const GLProgram* prog = GetAsyncProgram(psel, false))
+		{
+			prog->Bind();
+			return;
+		}
+
+		// Draw with the ubershader while the specialized program compiles.
+		const ProgramSelector uber_psel = GetUberShaderSelector(psel);
+		if (const GLProgram* prog = GetAsyncProgram(uber_psel, false))
+		{
+			prog->Bind();
+			prog->Uniform1ui(0, GetUberShaderKey(psel.ps));
+			return;
+		}
+
+		// Neither is ready, which only happens for variants IsDrawPending() didn't predict.
+		GetAsyncProgram(psel, true)->Bind();
+		return;
+	}
+
+	g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
 	const std::string vs(GetVSSource(psel.vs));
 	const std::string ps(GetPSSource(psel.ps));
 
@@ -2367,6 +2444,102 @@ void GSDeviceOGL::SetupPipeline(const ProgramSelector& psel)
 	it->second.Bind();
 }
 
+GSDeviceOGL::ProgramSelector GSDeviceOGL::GetUberShaderSelector(const ProgramSelector& psel)
+{
+	// Texture function, alpha test and fog are branched on in the ubershader, see PS_DYNAMIC in tfx_fs.glsl.
+	ProgramSelector uber_psel = psel;
+	if (uber_psel.ps.tfx != 4)
+		uber_psel.ps.tfx = 0;
+	uber_psel.ps.tcc = 0;
+	uber_psel.ps.atst = 0;
+	uber_psel.ps.fog = 0;
+	uber_psel.uber = 1;
+	return uber_psel;
+}
+
+u32 GSDeviceOGL::GetUberShaderKey(const PSSelector& sel)
+{
+	return (sel.tfx & 3u) | (sel.tcc << 2) | (sel.atst << 3) | (sel.fog << 6);
+}
+
+GLProgram* GSDeviceOGL::GetAsyncProgram(const ProgramSelector& psel, bool wait)
+{
+	auto it = m_programs.find(psel);
+	if (it != m_programs.end())
+		return &it->second;
+
+	auto pending_it = m_pending_programs.find(psel);
+	if (pending_it == m_pending_programs.end())
+	{
+		g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
+		PendingProgram pending;
+		pending.vs = GetVSSource(psel.vs);
+		pending.ps = GetPSSource(psel.ps, psel.uber != 0);
+
+		bool is_pending = false;
+		if (!m_shader_cache.GetProgramAsync(&pending.prog, &is_pending, pending.vs, pending.ps) || !is_pending)
+		{
+			// Loaded from the cache, or failed, in which case it's bound invalid as with a sync compile.
+			it = m_programs.emplace(psel, std::move(pending.prog)).first;
+			if (psel.uber && it->second.IsValid())
+				it->second.RegisterUniform("DynamicKey");
+			return &it->second;
+		}
+
+		pending_it = m_pending_programs.emplace(psel, std::move(pending)).first;
+	}
+
+	if (!wait && pending_it->second.prog.IsCompletionPending())
+		return nullptr;
+
+	PendingProgram& pending = pending_it->second;
+	m_shader_cache.FinishAsyncProgram(&pending.prog, pending.vs, pending.ps);
+	it = m_programs.emplace(psel, std::move(pending.prog)).first;
+	m_pending_programs.erase(pending_it);
+	if (psel.uber && it->second.IsValid())
+		it->second.RegisterUniform("DynamicKey");
+	return &it->second;
+}
+
+bool GSDeviceOGL::IsProgramPending(const ProgramSelector& psel)
+{
+	// Either the specialized program or its ubershader will do.
+	return !GetAsyncProgram(psel, false) && !GetAsyncProgram(GetUberShaderSelector(psel), false);
+}
+
+bool GSDeviceOGL::IsDrawPending(const GSHWDrawConfig& config)
+{
+	ProgramSelector psel;
+	psel.vs = config.vs;
+	psel.ps.key_hi = config.ps.key_hi;
+	psel.ps.key_lo = config.ps.key_lo;
+	psel.uber = 0;
+	std::memset(psel.pad, 0, sizeof(psel.pad));
+
+	// RenderHW() switches to the colclip variant when a colclip target is carried over from the previous draw.
+	if (GetColorClipTexture() && config.colclip_mode != GSHWDrawConfig::ColClipMode::EarlyResolve)
+		psel.ps.colclip_hw = 1;
+
+	// Kick off every variant the draw needs before polling, so they compile in parallel.
+	bool pending = IsProgramPending(psel);
+	if (config.blend_multi_pass.enable)
+	{
+		ProgramSelector multi_psel = psel;
+		multi_psel.ps.blend_hw = config.blend_multi_pass.blend_hw;
+		multi_psel.ps.dither = config.blend_multi_pass.dither;
+		pending |= IsProgramPending(multi_psel);
+	}
+	if (config.alpha_second_pass.enable)
+	{
+		ProgramSelector second_psel = psel;
+		second_psel.ps = config.alpha_second_pass.ps;
+		pending |= IsProgramPending(second_psel);
+	}
+
+	return pending;
+}
+
 void GSDeviceOGL::SetupSampler(PSSamplerSelector ssel)
 {
 	PSSetSamplerState(m_ps_ss[ssel.key]);
@@ -2396,6 +2569,13 @@ static constexpr std::array<GLenum, 3> s_gl_blend_ops = { {
 
 void GSDeviceOGL::RenderHW(GSHWDrawConfig& config)
 {
+	// Drop the draw instead of stalling while its shaders are still being compiled.
+	if (m_async_shader_compile && IsDrawPending(config))
+	{
+		GL_INS("GL: Skipping draw, shader compile pending");
+		return;
+	}
+
 	if (!GLState::scissor.eq(config.scissor))
 	{
 		glScissor(config.scissor.x, config.scissor.y, config.scissor.width(), config.scissor.height());
@@ -2562,6 +2742,7 @@ void GSDeviceOGL::RenderHW(GSHWDrawConfig& config)
 	psel.vs = config.vs;
 	psel.ps.key_hi = config.ps.key_hi;
 	psel.ps.key_lo = config.ps.key_lo;
+	psel.uber = 0;
 	std::memset(psel.pad, 0, sizeof(psel.pad));
 
 	SetupPipeline(psel);
@@ -119,7 +119,8 @@ public:
 	{
 		PSSelector ps;
 		VSSelector vs;
-		u8 pad[3];
+		u8 uber; ///< Ubershader with tfx/tcc/atst/fog driven by a uniform, see GetUberShaderSelector().
+		u8 pad[2];
 
 		__fi bool operator==(const ProgramSelector& p) const { return BitEqual(*this, p); }
 		__fi bool operator!=(const ProgramSelector& p) const { return !BitEqual(*this, p); }
@@ -131,7 +132,7 @@ public:
 		__fi std::size_t operator()(const ProgramSelector& p) const noexcept
 		{
 			std::size_t h = 0;
-			HashCombine(h, p.vs.key, p.ps.key_hi, p.ps.key_lo);
+			HashCombine(h, p.vs.key, p.ps.key_hi, p.ps.key_lo, p.uber);
 			return h;
 		}
 	};
@@ -213,6 +214,14 @@ private:
 	GLuint m_ps_ss[1 << 8];
 	GSDepthStencilOGL* m_om_dss[1 << 5] = {};
 	std::unordered_map<ProgramSelector, GLProgram, ProgramSelectorHash> m_programs;
+	struct PendingProgram
+	{
+		GLProgram prog;
+		std::string vs;
+		std::string ps;
+	};
+	std::unordered_map<ProgramSelector, PendingProgram, ProgramSelectorHash> m_pending_programs;
+	bool m_async_shader_compile = false;
 	GLShaderCache m_shader_cache;
 
 	GLuint m_palette_ss = 0;
@@ -324,6 +333,7 @@ public:
 	void PresentRect(GSTexture* sTex, const GSVector4& sRect, GSTexture* dTex, const GSVector4& dRect, PresentShader shader, float shaderTime, bool linear) override;
 	void UpdateCLUTTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize) override;
 	void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM, GSTexture* dTex, u32 DBW, u32 DPSM) override;
+	void UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM) override;
 	void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) override;
 
 	void DrawMultiStretchRects(const MultiStretchRect* rects, u32 num_rects, GSTexture* dTex, ShaderConvert shader) override;
@@ -358,11 +368,16 @@ public:
 		const std::string_view macro_sel = std::string_view());
 	std::string GenGlslHeader(const std::string_view entry, GLenum type, const std::string_view macro);
 	std::string GetVSSource(VSSelector sel);
-	std::string GetPSSource(const PSSelector& sel);
+	std::string GetPSSource(const PSSelector& sel, bool dynamic = false);
 	GLuint CreateSampler(PSSamplerSelector sel);
 	GSDepthStencilOGL* CreateDepthStencil(OMDepthStencilSelector dssel);
 
 	void SetupPipeline(const ProgramSelector& psel);
+	static ProgramSelector GetUberShaderSelector(const ProgramSelector& psel);
+	static u32 GetUberShaderKey(const PSSelector& sel);
+	GLProgram* GetAsyncProgram(const ProgramSelector& psel, bool wait);
+	bool IsProgramPending(const ProgramSelector& psel);
+	bool IsDrawPending(const GSHWDrawConfig& config);
 	void SetupSampler(PSSamplerSelector ssel);
 	void SetupOM(OMDepthStencilSelector dssel);
 	GLuint GetSamplerID(PSSamplerSelector ssel);
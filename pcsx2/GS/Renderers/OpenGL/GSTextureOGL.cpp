@@ -209,7 +209,27 @@ bool GSTextureOGL::Update(const GSVector4i& r, const void* data, int pitch, int
 		const u32 row_length = CalcUploadRowLengthFromPitch(pitch);
 		const u32 upload_size = CalcUploadSize(r.height(), pitch);
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
-		glCompressedTextureSubImage2D(m_texture_id, layer, r.x, r.y, r.width(), r.height(), m_int_format, upload_size, data);
+
+		// Go through the upload ring as well when it fits, sourcing from client memory makes the driver
+		// copy synchronously, and some (Mesa) stall on the texture being in use.
+		if (sb && upload_size <= sb->GetChunkSize())
+		{
+			const auto map = sb->Map(TEXTURE_UPLOAD_ALIGNMENT, upload_size);
+			std::memcpy(map.pointer, data, upload_size);
+			sb->Unmap(upload_size);
+			sb->Bind();
+
+			glCompressedTextureSubImage2D(m_texture_id, layer, r.x, r.y, r.width(), r.height(), m_int_format,
+				upload_size, reinterpret_cast<void*>(static_cast<uintptr_t>(map.buffer_offset)));
+
+			sb->Unbind();
+		}
+		else
+		{
+			glCompressedTextureSubImage2D(m_texture_id, layer, r.x, r.y, r.width(), r.height(), m_int_format,
+				upload_size, data);
+		}
+
 		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 	}
 	else if (!sb || map_size > sb->GetChunkSize())
@@ -7,6 +7,7 @@
 #include "GS/Renderers/SW/GSRasterizer.h"
 
 #include "common/Console.h"
+#include "common/Timer.h"
 
 #include <fstream>
 
@@ -30,14 +31,82 @@ GSDrawScanline::GSDrawScanline()
 	, m_ds_map("GSDrawScanline")
 {
 	GSCodeReserve::ResetMemory();
+
+	// Only the keys are stored, the code itself still has to be generated for the running CPU.
+	m_sp_usage.Open("swsetup", sizeof(u64), USAGE_LIST_VERSION);
+	m_ds_usage.Open("swscanline", sizeof(u64), USAGE_LIST_VERSION);
+	PrecompileFunctions();
 }
 
 GSDrawScanline::~GSDrawScanline()
 {
+	RecordUsedFunctions();
+	m_sp_usage.Close();
+	m_ds_usage.Close();
+
 	if (const size_t used = GSCodeReserve::GetMemoryUsed(); used > 0)
 		DevCon.WriteLn("SW JIT generated %zu bytes of code", used);
 }
 
+void GSDrawScanline::ReloadUsageList()
+{
+	RecordUsedFunctions();
+
+	// Don't carry the previous game's functions over into the new list.
+	m_sp_map.ClearActive();
+	m_ds_map.ClearActive();
+
+	m_sp_usage.Reopen();
+	m_ds_usage.Reopen();
+	PrecompileFunctions();
+}
+
+void GSDrawScanline::RecordUsedFunctions()
+{
+	for (const u64 key : m_sp_map.GetActiveKeys())
+		m_sp_usage.Record(&key);
+	for (const u64 key : m_ds_map.GetActiveKeys())
+		m_ds_usage.Record(&key);
+}
+
+void GSDrawScanline::PrecompileFunctions()
+{
+#ifdef ENABLE_JIT_RASTERIZER
+	if (!m_sp_usage.HasPendingPrecompiles() && !m_ds_usage.HasPendingPrecompiles())
+		return;
+
+	Common::Timer timer;
+	u32 count = 0;
+
+	// Leave at least half of the code space for functions the list doesn't know about yet.
+	const auto have_space = []() { return (GSCodeReserve::GetMemoryUsed() < GSCodeReserve::GetMemorySize() / 2); };
+
+	while (const void* data = m_sp_usage.GetNextPrecompile())
+	{
+		if (!have_space())
+			break;
+
+		u64 key;
+		std::memcpy(&key, data, sizeof(key));
+		m_sp_map[key];
+		count++;
+	}
+
+	while (const void* data = m_ds_usage.GetNextPrecompile())
+	{
+		if (!have_space())
+			break;
+
+		u64 key;
+		std::memcpy(&key, data, sizeof(key));
+		m_ds_map[key];
+		count++;
+	}
+
+	DevCon.WriteLn("SW JIT precompiled %u functions in %.2f ms", count, timer.GetTimeMilliseconds());
+#endif
+}
+
 bool GSDrawScanline::ShouldUseCDrawScanline(u64 key)
 {
 	static std::map<u64, bool> s_use_c_draw_scanline;
@@ -51,10 +51,22 @@ public:
 	void UpdateDrawStats(u64 frame, u64 ticks, int actual, int total, int prims);
 	void PrintStats();
 
+	/// Saves the functions used by the previous game, and generates the ones used by the new game.
+	void ReloadUsageList();
+
 private:
+	/// Bump when the selector layout changes, so old usage lists are thrown away.
+	static constexpr u64 USAGE_LIST_VERSION = 1;
+
 	GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, u64, SetupPrimPtr> m_sp_map;
 	GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, u64, DrawScanlinePtr> m_ds_map;
 
+	GSPipelineUsageList m_sp_usage;
+	GSPipelineUsageList m_ds_usage;
+
+	void RecordUsedFunctions();
+	void PrecompileFunctions();
+
 	static void CSetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, GSScanlineLocalData& local);
 	static void CDrawScanline(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
 	static void CDrawEdge(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
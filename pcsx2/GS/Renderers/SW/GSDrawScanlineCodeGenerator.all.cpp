@@ -223,6 +223,13 @@ void GSDrawScanlineCodeGenerator::alltrue(const XYm& test)
 
 void GSDrawScanlineCodeGenerator::blend(const XYm& a, const XYm& b, const XYm& mask)
 {
+	if (hasAVX512)
+	{
+		// a = mask ? b : a
+		vpternlogd(a, b, mask, 0xd8);
+		return;
+	}
+
 	pand(b, mask);
 	pandn(mask, a);
 	if (hasAVX)
@@ -238,6 +245,13 @@ void GSDrawScanlineCodeGenerator::blend(const XYm& a, const XYm& b, const XYm& m
 
 void GSDrawScanlineCodeGenerator::blendr(const XYm& b, const XYm& a, const XYm& mask)
 {
+	if (hasAVX512)
+	{
+		// b = mask ? b : a
+		vpternlogd(b, a, mask, 0xe4);
+		return;
+	}
+
 	pand(b, mask);
 	pandn(mask, a);
 	por(b, mask);
@@ -47,7 +47,7 @@ public:
 	using AddressReg = Xbyak::Reg64;
 	using RipType = Xbyak::RegRip;
 
-	const bool hasAVX, hasAVX2, hasFMA;
+	const bool hasAVX, hasAVX2, hasAVX512, hasFMA;
 
 	const Xmm xmm0{0}, xmm1{1}, xmm2{2}, xmm3{3}, xmm4{4}, xmm5{5}, xmm6{6}, xmm7{7}, xmm8{8}, xmm9{9}, xmm10{10}, xmm11{11}, xmm12{12}, xmm13{13}, xmm14{14}, xmm15{15};
 	const Ymm ymm0{0}, ymm1{1}, ymm2{2}, ymm3{3}, ymm4{4}, ymm5{5}, ymm6{6}, ymm7{7}, ymm8{8}, ymm9{9}, ymm10{10}, ymm11{11}, ymm12{12}, ymm13{13}, ymm14{14}, ymm15{15};
@@ -63,6 +63,7 @@ public:
 		: actual(maxsize, code)
 		, hasAVX(g_cpu.vectorISA >= ProcessorFeatures::VectorISA::AVX)
 		, hasAVX2(g_cpu.vectorISA >= ProcessorFeatures::VectorISA::AVX2)
+		, hasAVX512(g_cpu.vectorISA >= ProcessorFeatures::VectorISA::AVX512F)
 		, hasFMA(g_cpu.hasFMA)
 	{
 	}
@@ -83,6 +84,7 @@ public:
 //   SSEONLY: available only on SSE (exception on AVX)
 //   AVX:     available only on AVX (exception on SSE)
 //   AVX2:    available only on AVX2 (exception on AVX/SSE)
+//   AVX512:  available only with AVX-512 (F/BW/DQ/VL), EVEX encoded, xmm/ymm 0-15 only
 //   FMA:     available only with FMA
 // SFORWARD forwards an SSE-AVX pair where the AVX variant takes the same number of registers (e.g. pshufd dst, src + vpshufd dst, src)
 // AFORWARD forwards an SSE-AVX pair where the AVX variant takes an extra destination register (e.g. shufps dst, src + vshufps dst, src, src)
@@ -118,6 +120,12 @@ public:
 	else \
 		pxFailRel("used AVX instruction in SSE code");
 
+#define ACTUAL_FORWARD_AVX512(name, ...) \
+	if (hasAVX512) \
+		actual.name(__VA_ARGS__); \
+	else \
+		pxFailRel("used AVX-512 instruction in AVX code");
+
 #define ACTUAL_FORWARD_FMA(name, ...) \
 	if (hasFMA) \
 		actual.name(__VA_ARGS__); \
@@ -333,6 +341,7 @@ public:
 	FORWARD(3, AVX2, vpgatherdd,     const Xmm&, const Address&, const Xmm&);
 	FORWARD(3, AVX2, vpsravd,        ARGS_XXO)
 	FORWARD(3, AVX2, vpsrlvd,        ARGS_XXO)
+	FORWARD(4, AVX512, vpternlogd,   const Xmm&, const Xmm&, const Operand&, u8)
 
 #undef ARGS_OI
 #undef ARGS_OO
@@ -355,6 +364,7 @@ public:
 #undef FORWARD2
 #undef FORWARD1
 #undef ACTUAL_FORWARD_FMA
+#undef ACTUAL_FORWARD_AVX512
 #undef ACTUAL_FORWARD_AVX2
 #undef ACTUAL_FORWARD_AVX
 #undef ACTUAL_FORWARD_SSE
@@ -6,12 +6,14 @@
 #include "GS/Renderers/SW/GSRasterizer.h"
 #include "GS/Renderers/SW/GSDrawScanline.h"
 #include "GS/GSExtra.h"
+#include "DebugTools/TraceCapture.h"
 #include "PerformanceMetrics.h"
 #include "VMManager.h"
 
 #include "common/AlignedMalloc.h"
 #include "common/Console.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #define ENABLE_DRAW_STATS 0
 
@@ -19,6 +21,9 @@ MULTI_ISA_UNSHARED_IMPL;
 
 int GSRasterizerData::s_counter = 0;
 
+// Number of scanline lanes per worker thread, for the threaded rasterizer to balance work with.
+static constexpr int LANES_PER_THREAD = 2;
+
 static int compute_best_thread_height(int threads)
 {
 	// - for more threads screen segments should be smaller to better distribute the pixels
@@ -456,6 +461,11 @@ void GSRasterizer::DrawTriangle(const GSVertexSW* vertex, const u16* index)
 	GSVector4 tbmin = tbf.min(m_fscissor_y);
 	GSVector4i tb = GSVector4i(tbmax.xzyw(tbmin)); // max(y0, t) max(y1, t) min(y1, b) min(y2, b)
 
+	// Skip the edge setup for triangles that don't touch any of our scanlines. Edges can
+	// spill into neighbouring rows, so those still go the long way round.
+	if (m_threads > 1 && !HasEdge() && (tb.x >= tb.w || !IsOneOfMyScanlines(tb.x, std::min(tb.w, 2047))))
+		return;
+
 	GSVertexSW2 dv0 = v1 - v0;
 	GSVertexSW2 dv1 = v2 - v0;
 	GSVertexSW2 dv2 = v2 - v1;
@@ -635,6 +645,11 @@ void GSRasterizer::DrawTriangle(const GSVertexSW* vertex, const u16* index)
 	GSVector4 tbmin = tbf.min(m_fscissor_y);
 	GSVector4i tb = GSVector4i(tbmax.xzyw(tbmin)); // max(y0, t) max(y1, t) min(y1, b) min(y2, b)
 
+	// Skip the edge setup for triangles that don't touch any of our scanlines. Edges can
+	// spill into neighbouring rows, so those still go the long way round.
+	if (m_threads > 1 && !HasEdge() && (tb.x >= tb.w || !IsOneOfMyScanlines(tb.x, std::min(tb.w, 2047))))
+		return;
+
 	GSVertexSW dv0 = v1 - v0;
 	GSVertexSW dv1 = v2 - v0;
 	GSVertexSW dv2 = v2 - v1;
@@ -795,7 +810,7 @@ void GSRasterizer::DrawSprite(const GSVertexSW* vertex, const u16* index)
 
 	r = r.rintersect(m_scissor);
 
-	if (r.rempty())
+	if (r.rempty() || (m_threads > 1 && !IsOneOfMyScanlines(r.top, std::min(r.bottom, 2047))))
 		return;
 
 	GSVertexSW scan = v[0];
@@ -1179,6 +1194,11 @@ int GSSingleRasterizer::GetPixels(bool reset /*= true*/)
 	return m_r.GetPixels(reset);
 }
 
+void GSSingleRasterizer::GameChanged()
+{
+	m_ds.ReloadUsageList();
+}
+
 void GSSingleRasterizer::PrintStats()
 {
 #ifdef ENABLE_DRAW_STATS
@@ -1188,16 +1208,16 @@ void GSSingleRasterizer::PrintStats()
 
 //
 
-GSRasterizerList::GSRasterizerList(int threads)
+GSRasterizerList::GSRasterizerList(int threads, int lanes)
 {
-	m_thread_height = compute_best_thread_height(threads);
+	m_thread_height = compute_best_thread_height(lanes);
 
 	const int rows = (2048 >> m_thread_height) + 16;
 	m_scanline = static_cast<u8*>(_aligned_malloc(rows, 64));
 
 	for (int i = 0; i < rows; i++)
 	{
-		m_scanline[i] = static_cast<u8>(i % threads);
+		m_scanline[i] = static_cast<u8>(i % lanes);
 	}
 
 	PerformanceMetrics::SetGSSWThreadCount(threads);
@@ -1206,12 +1226,21 @@ GSRasterizerList::GSRasterizerList(int threads)
 GSRasterizerList::~GSRasterizerList()
 {
 	PerformanceMetrics::SetGSSWThreadCount(0);
+
+	m_exit = true;
+	for (const std::unique_ptr<Worker>& worker : m_workers)
+		worker->sema.NotifyOfWork();
+	for (const std::unique_ptr<Worker>& worker : m_workers)
+		worker->thread.join();
+
 	_aligned_free(m_scanline);
 }
 
 void GSRasterizerList::OnWorkerStartup(int i, u64 affinity)
 {
-	Threading::SetNameOfCurrentThread(StringUtil::StdStringFromFormat("GS-SW-%d", i).c_str());
+	const std::string name = StringUtil::StdStringFromFormat("GS-SW-%d", i);
+	Threading::SetNameOfCurrentThread(name.c_str());
+	TraceCapture::SetThreadName(name.c_str());
 
 	Threading::ThreadHandle handle(Threading::ThreadHandle::GetForCallingThread());
 	if (affinity != 0)
@@ -1227,6 +1256,70 @@ void GSRasterizerList::OnWorkerShutdown(int i)
 {
 }
 
+void GSRasterizerList::WorkerThread(int i, u64 affinity)
+{
+	OnWorkerStartup(i, affinity);
+
+	Worker& worker = *m_workers[i];
+	for (;;)
+	{
+		// Spinning keeps the wake-up latency down, but burns a core for every worker while the GS is idle.
+		if (m_power_saving)
+			worker.sema.WaitForWork();
+		else
+			worker.sema.WaitForWorkWithSpin();
+		if (m_exit)
+			break;
+
+		TraceCapture::ScopedEvent trace("SW Rasterize");
+		while (ProcessLanes(i))
+			;
+	}
+
+	OnWorkerShutdown(i);
+}
+
+bool GSRasterizerList::TryDrainLane(int lane)
+{
+	Lane& l = *m_lanes[lane];
+	if (l.queue.empty() || l.owned.test_and_set(std::memory_order_acquire))
+		return false;
+
+	GSRasterizer& r = *m_r[lane];
+	auto draw = [&r](DataPtr& item) { r.Draw(*item.get()); };
+	while (l.queue.consume_one(draw))
+		;
+
+	l.owned.clear(std::memory_order_release);
+	return true;
+}
+
+bool GSRasterizerList::ProcessLanes(int i)
+{
+	// Lanes are interleaved across the workers, so each one starts on its own lanes and only steals
+	// from the others once those are empty. A lane which is already being drained is skipped, the
+	// owner won't go idle before it has emptied it.
+	const int num_lanes = static_cast<int>(m_lanes.size());
+	const int num_workers = static_cast<int>(m_workers.size());
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+	bool did_work = false;
+
+	for (int lane = i; lane < num_lanes; lane += num_workers)
+		did_work |= TryDrainLane(lane);
+
+	for (int offset = 1; offset < num_lanes; offset++)
+	{
+		const int lane = (i + offset) % num_lanes;
+		if ((lane % num_workers) != i)
+			did_work |= TryDrainLane(lane);
+	}
+
+	if (did_work)
+		m_workers[i]->busy_ticks.fetch_add(Common::Timer::GetCurrentValue() - start, std::memory_order_relaxed);
+
+	return did_work;
+}
+
 void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
 {
 	GSVector4i r = data->bbox.rintersect(data->scissor);
@@ -1241,12 +1334,18 @@ void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data
 	pxAssert(r.top >= 0 && r.top < 2048 && r.bottom >= 0 && r.bottom < 2048);
 
 	int top = r.top >> m_thread_height;
-	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + m_workers.size());
+	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + m_lanes.size());
 
 	while (top < bottom)
 	{
-		m_workers[m_scanline[top++]]->Push(data);
+		Lane& lane = *m_lanes[m_scanline[top++]];
+		while (!lane.queue.push(data))
+			std::this_thread::yield();
 	}
+
+	// Any idle worker can pick up the new lanes, not just the ones they're interleaved to.
+	for (const std::unique_ptr<Worker>& worker : m_workers)
+		worker->sema.NotifyOfWork();
 }
 
 void GSRasterizerList::Sync()
@@ -1255,18 +1354,22 @@ void GSRasterizerList::Sync()
 	{
 		for (size_t i = 0; i < m_workers.size(); i++)
 		{
-			m_workers[i]->Wait();
+			if (m_power_saving)
+				m_workers[i]->sema.WaitForEmpty();
+			else
+				m_workers[i]->sema.WaitForEmptyWithSpin();
 		}
 
+		pxAssert(IsSynced());
 		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
 	}
 }
 
 bool GSRasterizerList::IsSynced() const
 {
-	for (size_t i = 0; i < m_workers.size(); i++)
+	for (size_t i = 0; i < m_lanes.size(); i++)
 	{
-		if (!m_workers[i]->IsEmpty())
+		if (!m_lanes[i]->queue.empty())
 		{
 			return false;
 		}
@@ -1279,7 +1382,7 @@ int GSRasterizerList::GetPixels(bool reset)
 {
 	int pixels = 0;
 
-	for (size_t i = 0; i < m_workers.size(); i++)
+	for (size_t i = 0; i < m_r.size(); i++)
 	{
 		pixels += m_r[i]->GetPixels(reset);
 	}
@@ -1296,22 +1399,32 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 		return std::make_unique<GSSingleRasterizer>();
 	}
 
-	std::unique_ptr<GSRasterizerList> rl(new GSRasterizerList(threads));
+	// Split the screen into more lanes than there are threads, so that a worker which finishes early
+	// (e.g. on an efficiency core, or with a lighter part of the screen) has something left to steal.
+	const int lanes = (threads > 1) ? std::min(threads * LANES_PER_THREAD, 255) : 1;
+	std::unique_ptr<GSRasterizerList> rl(new GSRasterizerList(threads, lanes));
+	rl->m_power_saving = EmuConfig.EmulationSpeed.PowerSaving;
 
 	const std::vector<u32>& procs = VMManager::Internal::GetSoftwareRendererProcessorList();
 	const bool pin = (EmuConfig.EnableThreadPinning && static_cast<size_t>(threads) <= procs.size());
 	if (EmuConfig.EnableThreadPinning && !pin)
 		WARNING_LOG("Not pinning SW threads, we need {} processors, but only have {}", threads, procs.size());
 
+	for (int i = 0; i < lanes; i++)
+	{
+		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, lanes)));
+		rl->m_lanes.push_back(std::make_unique<Lane>());
+	}
+
+	for (int i = 0; i < threads; i++)
+		rl->m_workers.push_back(std::make_unique<Worker>());
+
 	for (int i = 0; i < threads; i++)
 	{
 		const u64 affinity = pin ? (static_cast<u64>(1u) << procs[i]) : 0;
-		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads)));
-		auto& r = *rl->m_r[i];
-		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
-			[i, affinity]() { GSRasterizerList::OnWorkerStartup(i, affinity); },
-			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
-			[i]() { GSRasterizerList::OnWorkerShutdown(i); })));
+		Worker& worker = *rl->m_workers[i];
+		PerformanceMetrics::SetGSSWThreadBusyCounter(i, &worker.busy_ticks);
+		worker.thread = std::thread(&GSRasterizerList::WorkerThread, rl.get(), i, affinity);
 	}
 
 	return rl;
@@ -1320,3 +1433,9 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 void GSRasterizerList::PrintStats()
 {
 }
+
+void GSRasterizerList::GameChanged()
+{
+	Sync();
+	m_ds.ReloadUsageList();
+}
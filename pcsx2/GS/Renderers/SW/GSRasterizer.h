@@ -11,6 +11,9 @@
 #include "GS/GSRingHeap.h"
 #include "GS/MultiISA.h"
 
+#include <atomic>
+#include <thread>
+
 MULTI_ISA_UNSHARED_START
 
 class GSDrawScanline;
@@ -130,6 +133,7 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual void GameChanged() = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -143,6 +147,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	void GameChanged() override;
 
 	void Draw(GSRasterizerData& data);
 
@@ -154,17 +159,39 @@ private:
 class GSRasterizerList final : public IRasterizer
 {
 protected:
-	using GSWorker = GSJobQueue<GSRingHeap::SharedPtr<GSRasterizerData>, 65536>;
+	using DataPtr = GSRingHeap::SharedPtr<GSRasterizerData>;
+
+	/// Draws for one interleaved set of scanline bands. Only one worker drains a lane at a time,
+	/// so the draws within a lane are always rasterized in order.
+	struct alignas(__cachelinesize) Lane
+	{
+		ringbuffer_base<DataPtr, 16384> queue;
+		std::atomic_flag owned = ATOMIC_FLAG_INIT;
+	};
+
+	struct alignas(__cachelinesize) Worker
+	{
+		std::thread thread;
+		Threading::WorkSema sema;
+		std::atomic<u64> busy_ticks{0};
+	};
 
 	GSDrawScanline m_ds;
 
-	// Worker threads depend on the rasterizers, so don't change the order.
+	// Workers depend on the lanes and rasterizers, so don't change the order.
 	std::vector<std::unique_ptr<GSRasterizer>> m_r;
-	std::vector<std::unique_ptr<GSWorker>> m_workers;
+	std::vector<std::unique_ptr<Lane>> m_lanes;
+	std::vector<std::unique_ptr<Worker>> m_workers;
 	u8* m_scanline;
 	int m_thread_height;
+	bool m_exit = false;
+	bool m_power_saving = false;
+
+	GSRasterizerList(int threads, int lanes);
 
-	GSRasterizerList(int threads);
+	void WorkerThread(int i, u64 affinity);
+	bool ProcessLanes(int i);
+	bool TryDrainLane(int lane);
 
 	static void OnWorkerStartup(int i, u64 affinity);
 	static void OnWorkerShutdown(int i);
@@ -181,6 +208,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	void GameChanged() override;
 };
 
 MULTI_ISA_UNSHARED_END
@@ -6,6 +6,7 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 
+#include "common/Console.h"
 #include "common/StringUtil.h"
 
 MULTI_ISA_UNSHARED_IMPL;
@@ -52,12 +53,22 @@ void GSRendererSW::Reset(bool hardware_reset)
 	GSRenderer::Reset(hardware_reset);
 }
 
+void GSRendererSW::GameChanged()
+{
+	m_rl->GameChanged();
+}
+
 void GSRendererSW::Destroy()
 {
 	// Need to destroy worker queue first to stop any pending thread work
 	m_rl.reset();
 	m_tc.reset();
 
+	const GSRingHeap::Stats heap_stats = m_vertex_heap.GetStats();
+	DevCon.WriteLnFmt("GSRendererSW: {} heap allocations, {} orphaned buffers ({} low usage), {} grows, rings {}KB/{}KB",
+		heap_stats.allocations, heap_stats.orphans, heap_stats.low_usage_orphans, heap_stats.grows,
+		heap_stats.ring_size[0] / 1024, heap_stats.ring_size[1] / 1024);
+
 	for (GSTexture*& tex : m_texture)
 	{
 		delete tex;
@@ -89,6 +100,10 @@ void GSRendererSW::VSync(u32 field, bool registers_written, bool idle_frame)
 	//
 	*/
 
+	const GSRingHeap::Stats heap_stats = m_vertex_heap.GetStats();
+	g_perfmon.Put(GSPerfMon::RingHeapOrphans, static_cast<double>(heap_stats.orphans - m_last_heap_orphans));
+	m_last_heap_orphans = heap_stats.orphans;
+
 	GSRenderer::VSync(field, registers_written, idle_frame);
 
 	m_tc->IncAge();
@@ -601,7 +616,7 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 		});
 	}
 
-	m_tc->InvalidatePages(pages, off.psm()); // if texture update runs on a thread and Sync(5) happens then this must come later
+	m_tc->InvalidateBlocks(off, r); // if texture update runs on a thread and Sync(5) happens then this must come later
 }
 
 void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut)
@@ -1528,7 +1543,7 @@ void GSRendererSW::SharedData::UpdateSource()
 		if (global.clut)
 		{
 			s = GetDrawDumpPath("%05d_f%05lld_itexp_%05x_%s.bmp", g_gs_renderer->s_n, frame, (int)g_gs_renderer->m_context->TEX0.CBP, GSUtil::GetPSMName(g_gs_renderer->m_context->TEX0.CPSM));
-			GSPng::Save((IsDevBuild || GSConfig.SaveAlpha) ? GSPng::RGB_A_PNG : GSPng::RGB_PNG, s, reinterpret_cast<const u8*>(global.clut), 256, 1, sizeof(u32) * 256, GSConfig.PNGCompressionLevel, false);
+			GSPng::SaveAsync((IsDevBuild || GSConfig.SaveAlpha) ? GSPng::RGB_A_PNG : GSPng::RGB_PNG, s, reinterpret_cast<const u8*>(global.clut), 256, 1, sizeof(u32) * 256, GSConfig.PNGCompressionLevel, false);
 		}
 	}
 }
@@ -50,6 +50,7 @@ protected:
 	std::unique_ptr<IRasterizer> m_rl;
 	std::unique_ptr<GSTextureCacheSW> m_tc;
 	GSRingHeap m_vertex_heap;
+	u64 m_last_heap_orphans = 0;
 	std::array<GSTexture*, 3> m_texture = {};
 	u8* m_output;
 	GSPixelOffset4* m_fzb;
@@ -61,6 +62,7 @@ protected:
 	GSVector4i m_dimx[8] = {};
 
 	void Reset(bool hardware_reset) override;
+	void GameChanged() override;
 	void VSync(u32 field, bool registers_written, bool idle_frame) override;
 	GSTexture* GetOutput(int i, float& scale, int& y_offset) override;
 	GSTexture* GetFeedbackOutput(float& scale) override;
@@ -62,28 +62,68 @@ void GSTextureCacheSW::InvalidatePages(const GSOffset::PageLooper& pages, u32 ps
 {
 	pages.loopPages([this, psm](u32 page)
 	{
-		for (Texture* t : m_map[page])
+		InvalidatePage(page, psm, 0xFFFFFFFFu);
+	});
+}
+
+void GSTextureCacheSW::InvalidateBlocks(const GSOffset& off, const GSVector4i& rect)
+{
+	const GSVector4i r = rect.ralign<Align_Outside>(GSLocalMemory::m_psm[off.psm()].bs);
+	const int bottom = r.bottom >> off.blockShiftY();
+	const int right = r.right >> off.blockShiftX();
+
+	for (GSOffset::BNHelper bn = off.bnMulti(r.left, r.top); bn.blkY() < bottom; bn.nextBlockY())
+	{
+		for (; bn.blkX() < right; bn.nextBlockX())
 		{
-			if (GSUtil::HasSharedBits(psm, t->m_sharedbits))
-			{
-				u32* RESTRICT valid = t->m_valid;
+			const u32 block = bn.value();
+			const u32 page = block >> 5;
 
-				if (t->m_repeating)
-				{
-					for (const GSVector2i& j : t->m_p2t[page])
-					{
-						valid[j.x] &= j.y;
-					}
-				}
-				else
-				{
-					valid[page] = 0;
-				}
+			if (m_dirty_blocks[page] == 0)
+				m_dirty_pages.push_back(page);
+
+			m_dirty_blocks[page] |= 1u << (block & 31);
+		}
+	}
+
+	const u32 psm = off.psm();
 
-				t->m_complete = false;
+	for (const u32 page : m_dirty_pages)
+	{
+		InvalidatePage(page, psm, m_dirty_blocks[page]);
+		m_dirty_blocks[page] = 0;
+	}
+
+	m_dirty_pages.clear();
+}
+
+void GSTextureCacheSW::InvalidatePage(u32 page, u32 psm, u32 blocks)
+{
+	for (Texture* t : m_map[page])
+	{
+		if (!GSUtil::HasSharedBits(psm, t->m_sharedbits))
+			continue;
+
+		u32* RESTRICT valid = t->m_valid;
+
+		if (t->m_repeating)
+		{
+			// The tile map only knows which tiles a page covers, not which blocks.
+			for (const GSVector2i& j : t->m_p2t[page])
+			{
+				valid[j.x] &= j.y;
 			}
+
+			t->m_complete = false;
 		}
-	});
+		else if (valid[page] & blocks)
+		{
+			// Blocks outside the write keep their converted data, and get skipped by Update().
+			valid[page] &= ~blocks;
+
+			t->m_complete = false;
+		}
+	}
 }
 
 void GSTextureCacheSW::RemoveAll()
@@ -132,7 +172,6 @@ GSTextureCacheSW::Texture::Texture(u32 tw0, const GIFRegTEX0& TEX0, const GIFReg
 	, m_tw(tw0)
 	, m_age(0)
 	, m_complete(false)
-	, m_p2t(nullptr)
 {
 	if (m_tw == 0)
 	{
@@ -173,7 +212,7 @@ void GSTextureCacheSW::Texture::Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIF
 	m_tw = tw0;
 	m_age = 0;
 	m_complete = false;
-	m_p2t = nullptr;
+	m_p2t.reset();
 	m_TEX0 = TEX0;
 	m_TEXA = TEXA;
 
@@ -324,7 +363,7 @@ bool GSTextureCacheSW::Texture::Save(const std::string& fn) const
 	if (psm.pal == 0)
 	{
 		// no clut => dump directly
-		return GSPng::Save(format, fn, src, w, h, src_pitch, GSConfig.PNGCompressionLevel);
+		return GSPng::SaveAsync(format, fn, src, w, h, src_pitch, GSConfig.PNGCompressionLevel);
 	}
 	else
 	{
@@ -339,7 +378,7 @@ bool GSTextureCacheSW::Texture::Save(const std::string& fn) const
 			src += src_pitch;
 		}
 
-		return GSPng::Save(format, fn, reinterpret_cast<const u8*>(dumptex.get()),
+		return GSPng::SaveAsync(format, fn, reinterpret_cast<const u8*>(dumptex.get()),
 			w, h, w * sizeof(u32), GSConfig.PNGCompressionLevel);
 	}
 }
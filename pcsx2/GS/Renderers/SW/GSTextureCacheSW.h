@@ -22,7 +22,7 @@ public:
 		u32 m_age;
 		bool m_complete;
 		bool m_repeating;
-		std::vector<GSVector2i>* m_p2t;
+		GSPage2TileMap m_p2t;
 		u32 m_valid[GS_MAX_PAGES];
 		std::array<u16, GS_MAX_PAGES> m_erase_it;
 		const u32* RESTRICT m_sharedbits;
@@ -44,6 +44,12 @@ protected:
 	std::unordered_set<Texture*> m_textures;
 	std::array<FastList<Texture*>, GS_MAX_PAGES> m_map;
 
+	// Scratch for InvalidateBlocks(), always cleared after use.
+	std::array<u32, GS_MAX_PAGES> m_dirty_blocks = {};
+	std::vector<u32> m_dirty_pages;
+
+	void InvalidatePage(u32 page, u32 psm, u32 blocks);
+
 public:
 	GSTextureCacheSW();
 	virtual ~GSTextureCacheSW();
@@ -52,6 +58,9 @@ public:
 
 	void InvalidatePages(const GSOffset::PageLooper& pages, u32 psm);
 
+	/// Only invalidates the blocks touched by r, for transfers which don't cover whole pages.
+	void InvalidateBlocks(const GSOffset& off, const GSVector4i& r);
+
 	void RemoveAll();
 	void IncAge();
 };
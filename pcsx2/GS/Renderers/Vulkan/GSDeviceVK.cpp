@@ -20,13 +20,17 @@
 #include "common/HostSys.h"
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
 
 #include "imgui.h"
 
+#include <algorithm>
 #include <bit>
 #include <limits>
 #include <mutex>
 #include <sstream>
+#include <tuple>
 
 // Tweakables
 enum : u32
@@ -410,6 +414,9 @@ bool GSDeviceVK::SelectDeviceExtensions(ExtensionList* extension_list, bool enab
 		SupportsExtension(VK_EXT_ATTACHMENT_FEEDBACK_LOOP_LAYOUT_EXTENSION_NAME, false);
 	m_optional_extensions.vk_ext_line_rasterization = SupportsExtension(VK_EXT_LINE_RASTERIZATION_EXTENSION_NAME, false);
 	m_optional_extensions.vk_khr_driver_properties = SupportsExtension(VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME, false);
+	m_optional_extensions.vk_ext_graphics_pipeline_library =
+		SupportsExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, false) &&
+		SupportsExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, false);
 
 	// glslang generates debug info instructions before phi nodes at the beginning of blocks when non-semantic debug info
 	// is enabled, triggering errors by spirv-val. Gate it by an environment variable if you want source debugging until
@@ -613,6 +620,8 @@ bool GSDeviceVK::CreateDevice(VkSurfaceKHR surface, bool enable_validation_layer
 		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ATTACHMENT_FEEDBACK_LOOP_LAYOUT_FEATURES_EXT};
 	VkPhysicalDeviceSwapchainMaintenance1FeaturesEXT swapchain_maintenance1_feature = {
 		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SWAPCHAIN_MAINTENANCE_1_FEATURES_EXT};
+	VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphics_pipeline_library_feature = {
+		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT};
 
 	if (m_optional_extensions.vk_ext_provoking_vertex)
 	{
@@ -639,6 +648,12 @@ bool GSDeviceVK::CreateDevice(VkSurfaceKHR surface, bool enable_validation_layer
 		swapchain_maintenance1_feature.swapchainMaintenance1 = VK_TRUE;
 		Vulkan::AddPointerToChain(&device_info, &swapchain_maintenance1_feature);
 	}
+	if (m_optional_extensions.vk_ext_graphics_pipeline_library)
+	{
+		// Required to be supported when the extension is exposed.
+		graphics_pipeline_library_feature.graphicsPipelineLibrary = VK_TRUE;
+		Vulkan::AddPointerToChain(&device_info, &graphics_pipeline_library_feature);
+	}
 
 	VkResult res = vkCreateDevice(m_physical_device, &device_info, nullptr, &m_device);
 	if (res != VK_SUCCESS)
@@ -708,6 +723,8 @@ bool GSDeviceVK::ProcessDeviceExtensions()
 		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SWAPCHAIN_MAINTENANCE_1_FEATURES_EXT, nullptr, VK_TRUE};
 	VkPhysicalDeviceAttachmentFeedbackLoopLayoutFeaturesEXT attachment_feedback_loop_feature = {
 		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ATTACHMENT_FEEDBACK_LOOP_LAYOUT_FEATURES_EXT};
+	VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphics_pipeline_library_feature = {
+		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT};
 
 	// add in optional feature structs
 	if (m_optional_extensions.vk_ext_provoking_vertex)
@@ -720,6 +737,8 @@ bool GSDeviceVK::ProcessDeviceExtensions()
 		Vulkan::AddPointerToChain(&features2, &attachment_feedback_loop_feature);
 	if (m_optional_extensions.vk_ext_swapchain_maintenance1)
 		Vulkan::AddPointerToChain(&features2, &swapchain_maintenance1_feature);
+	if (m_optional_extensions.vk_ext_graphics_pipeline_library)
+		Vulkan::AddPointerToChain(&features2, &graphics_pipeline_library_feature);
 
 	// query
 	vkGetPhysicalDeviceFeatures2(m_physical_device, &features2);
@@ -730,6 +749,8 @@ bool GSDeviceVK::ProcessDeviceExtensions()
 		(rasterization_order_access_feature.rasterizationOrderColorAttachmentAccess == VK_TRUE);
 	m_optional_extensions.vk_ext_attachment_feedback_loop_layout &=
 		(attachment_feedback_loop_feature.attachmentFeedbackLoopLayout == VK_TRUE);
+	m_optional_extensions.vk_ext_graphics_pipeline_library &=
+		(graphics_pipeline_library_feature.graphicsPipelineLibrary == VK_TRUE);
 
 	VkPhysicalDeviceProperties2 properties2 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
 
@@ -743,6 +764,11 @@ bool GSDeviceVK::ProcessDeviceExtensions()
 		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR};
 	Vulkan::AddPointerToChain(&properties2, &push_descriptor_properties);
 
+	VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT graphics_pipeline_library_properties = {
+		VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT};
+	if (m_optional_extensions.vk_ext_graphics_pipeline_library)
+		Vulkan::AddPointerToChain(&properties2, &graphics_pipeline_library_properties);
+
 	// query
 	vkGetPhysicalDeviceProperties2(m_physical_device, &properties2);
 
@@ -754,6 +780,14 @@ bool GSDeviceVK::ProcessDeviceExtensions()
 		return false;
 	}
 
+	// Without fast linking, linking libraries is no quicker than building the whole pipeline.
+	if (m_optional_extensions.vk_ext_graphics_pipeline_library &&
+		!graphics_pipeline_library_properties.graphicsPipelineLibraryFastLinking)
+	{
+		Console.Warning("VK: graphicsPipelineLibraryFastLinking is not supported.");
+		m_optional_extensions.vk_ext_graphics_pipeline_library = false;
+	}
+
 	if (m_optional_extensions.vk_ext_line_rasterization && !line_rasterization_feature.bresenhamLines)
 	{
 		Console.Warning("VK: bresenhamLines is not supported.");
@@ -813,6 +847,8 @@ bool GSDeviceVK::ProcessDeviceExtensions()
 		m_optional_extensions.vk_khr_driver_properties ? "supported" : "NOT supported");
 	Console.WriteLn("VK_EXT_attachment_feedback_loop_layout is %s",
 		m_optional_extensions.vk_ext_attachment_feedback_loop_layout ? "supported" : "NOT supported");
+	Console.WriteLn("VK_EXT_graphics_pipeline_library is %s",
+		m_optional_extensions.vk_ext_graphics_pipeline_library ? "supported" : "NOT supported");
 
 	return true;
 }
@@ -959,6 +995,16 @@ bool GSDeviceVK::CreateGlobalDescriptorPool()
 			m_gpu_timing_supported = false;
 			return false;
 		}
+
+		const VkQueryPoolCreateInfo breakdown_create_info = {VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO, nullptr, 0,
+			VK_QUERY_TYPE_TIMESTAMP, NUM_COMMAND_BUFFERS * MAX_GPU_TIMING_MARKERS, 0};
+		res = vkCreateQueryPool(m_device, &breakdown_create_info, nullptr, &m_breakdown_query_pool);
+		if (res != VK_SUCCESS)
+		{
+			LOG_VULKAN_ERROR(res, "vkCreateQueryPool failed: ");
+			m_gpu_timing_supported = false;
+			return false;
+		}
 	}
 
 	return true;
@@ -1018,6 +1064,13 @@ VkRenderPass GSDeviceVK::GetRenderPassForRestarting(VkRenderPass pass)
 }
 
 VkCommandBuffer GSDeviceVK::GetCurrentInitCommandBuffer()
+{
+	// Anything else recorded to the init buffer may depend on the uploads, so they have to go first.
+	FlushUploadBatch();
+	return BeginInitCommandBuffer();
+}
+
+VkCommandBuffer GSDeviceVK::BeginInitCommandBuffer()
 {
 	FrameResources& res = m_frame_resources[m_current_frame];
 	VkCommandBuffer buf = res.command_buffers[0];
@@ -1031,6 +1084,78 @@ VkCommandBuffer GSDeviceVK::GetCurrentInitCommandBuffer()
 	return buf;
 }
 
+void GSDeviceVK::AddUploadBatchImage(const VkImageMemoryBarrier& pre_barrier, VkPipelineStageFlags pre_src_stages,
+	const VkImageMemoryBarrier& post_barrier, VkPipelineStageFlags post_dst_stages)
+{
+	m_upload_batch_pre_barriers.push_back(pre_barrier);
+	m_upload_batch_post_barriers.push_back(post_barrier);
+	m_upload_batch_pre_src_stages |= pre_src_stages;
+	m_upload_batch_post_dst_stages |= post_dst_stages;
+}
+
+void GSDeviceVK::QueueBatchedUpload(VkImage image, VkBuffer buffer, const VkBufferImageCopy& region)
+{
+	m_upload_batch.push_back({image, buffer, region});
+}
+
+bool GSDeviceVK::IsUploadPendingForRegion(VkImage image, const VkBufferImageCopy& region) const
+{
+	// Destination regions of a single copy can't overlap, and there's no barrier between the copies.
+	const GSVector4i rect = GSVector4i(region.imageOffset.x, region.imageOffset.y,
+		region.imageOffset.x + static_cast<s32>(region.imageExtent.width),
+		region.imageOffset.y + static_cast<s32>(region.imageExtent.height));
+	for (const BatchedUpload& upload : m_upload_batch)
+	{
+		if (upload.image != image || upload.region.imageSubresource.mipLevel != region.imageSubresource.mipLevel)
+			continue;
+
+		const GSVector4i other = GSVector4i(upload.region.imageOffset.x, upload.region.imageOffset.y,
+			upload.region.imageOffset.x + static_cast<s32>(upload.region.imageExtent.width),
+			upload.region.imageOffset.y + static_cast<s32>(upload.region.imageExtent.height));
+		if (!rect.rintersect(other).rempty())
+			return true;
+	}
+
+	return false;
+}
+
+void GSDeviceVK::FlushUploadBatch()
+{
+	if (m_upload_batch.empty())
+		return;
+
+	const VkCommandBuffer cmdbuf = BeginInitCommandBuffer();
+	vkCmdPipelineBarrier(cmdbuf, m_upload_batch_pre_src_stages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+		nullptr, static_cast<u32>(m_upload_batch_pre_barriers.size()), m_upload_batch_pre_barriers.data());
+
+	// None of the regions for an image overlap, so the order doesn't matter, group them by destination.
+	std::stable_sort(m_upload_batch.begin(), m_upload_batch.end(), [](const BatchedUpload& lhs, const BatchedUpload& rhs) {
+		return std::tie(lhs.image, lhs.buffer) < std::tie(rhs.image, rhs.buffer);
+	});
+
+	for (auto it = m_upload_batch.begin(); it != m_upload_batch.end();)
+	{
+		const VkImage image = it->image;
+		const VkBuffer buffer = it->buffer;
+		m_upload_batch_regions.clear();
+		for (; it != m_upload_batch.end() && it->image == image && it->buffer == buffer; ++it)
+			m_upload_batch_regions.push_back(it->region);
+
+		vkCmdCopyBufferToImage(cmdbuf, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			static_cast<u32>(m_upload_batch_regions.size()), m_upload_batch_regions.data());
+	}
+
+	vkCmdPipelineBarrier(cmdbuf, VK_PIPELINE_STAGE_TRANSFER_BIT, m_upload_batch_post_dst_stages, 0, 0, nullptr, 0,
+		nullptr, static_cast<u32>(m_upload_batch_post_barriers.size()), m_upload_batch_post_barriers.data());
+
+	m_upload_batch.clear();
+	m_upload_batch_pre_barriers.clear();
+	m_upload_batch_post_barriers.clear();
+	m_upload_batch_pre_src_stages = 0;
+	m_upload_batch_post_dst_stages = 0;
+	m_upload_batch_counter++;
+}
+
 VkDescriptorSet GSDeviceVK::AllocatePersistentDescriptorSet(VkDescriptorSetLayout set_layout)
 {
 	VkDescriptorSetAllocateInfo allocate_info = {
@@ -1086,6 +1211,31 @@ bool GSDeviceVK::SetGPUTimingEnabled(bool enabled)
 	return (enabled == m_gpu_timing_enabled);
 }
 
+bool GSDeviceVK::SetGPUTimingBreakdownEnabled(bool enabled)
+{
+	m_gpu_timing_breakdown = enabled && m_gpu_timing_supported;
+	return (enabled == m_gpu_timing_breakdown);
+}
+
+void GSDeviceVK::WriteGPUTimingMarker()
+{
+	// Markers are only written when commands are actually recorded, so switching category
+	// back and forth without any work in between doesn't cost anything. The command buffer
+	// has no start marker if the breakdown was enabled after it began.
+	FrameResources& resources = m_frame_resources[m_current_frame];
+	const u32 count = resources.num_timing_markers;
+	if (count == 0 || count >= (MAX_GPU_TIMING_MARKERS - 1) ||
+		resources.timing_categories[count - 1] == m_gpu_timing_category)
+	{
+		return;
+	}
+
+	vkCmdWriteTimestamp(m_current_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, m_breakdown_query_pool,
+		m_current_frame * MAX_GPU_TIMING_MARKERS + count);
+	resources.timing_categories[count] = m_gpu_timing_category;
+	resources.num_timing_markers = count + 1;
+}
+
 void GSDeviceVK::ScanForCommandBufferCompletion()
 {
 	for (u32 check_index = (m_current_frame + 1) % NUM_COMMAND_BUFFERS; check_index != m_current_frame;
@@ -1141,6 +1291,8 @@ void GSDeviceVK::WaitForCommandBufferCompletion(u32 index)
 
 void GSDeviceVK::SubmitCommandBuffer(VKSwapChain* present_swap_chain)
 {
+	FlushUploadBatch();
+
 	FrameResources& resources = m_frame_resources[m_current_frame];
 
 	// End the current command buffer.
@@ -1162,6 +1314,13 @@ void GSDeviceVK::SubmitCommandBuffer(VKSwapChain* present_swap_chain)
 			m_current_frame * 2 + 1);
 	}
 
+	if (resources.num_timing_markers > 0)
+	{
+		vkCmdWriteTimestamp(m_current_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, m_breakdown_query_pool,
+			m_current_frame * MAX_GPU_TIMING_MARKERS + resources.num_timing_markers);
+		resources.num_timing_markers++;
+	}
+
 	res = vkEndCommandBuffer(resources.command_buffers[1]);
 	if (res != VK_SUCCESS)
 	{
@@ -1255,9 +1414,13 @@ void GSDeviceVK::SubmitCommandBuffer(VKSwapChain* present_swap_chain)
 
 	if (present_swap_chain)
 	{
-		const VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR, nullptr, 1,
+		VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR, nullptr, 1,
 			present_swap_chain->GetRenderingFinishedSemaphorePtr(), 1, present_swap_chain->GetSwapChainPtr(),
 			present_swap_chain->GetCurrentImageIndexPtr(), nullptr};
+		const VkSwapchainPresentModeInfoEXT present_mode_info = {VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_MODE_INFO_EXT,
+			nullptr, 1, present_swap_chain->GetPresentModePtr()};
+		if (present_swap_chain->HasCompatiblePresentModes())
+			Vulkan::AddPointerToChain(&present_info, &present_mode_info);
 
 		present_swap_chain->ResetImageAcquireResult();
 
@@ -1325,6 +1488,28 @@ void GSDeviceVK::CommandBufferCompleted(u32 index)
 			LOG_VULKAN_ERROR(res, "vkGetQueryPoolResults failed: ");
 		}
 	}
+
+	if (resources.num_timing_markers > 1)
+	{
+		const u32 count = resources.num_timing_markers;
+		std::array<u64, MAX_GPU_TIMING_MARKERS> timestamps;
+		const VkResult res = vkGetQueryPoolResults(m_device, m_breakdown_query_pool, index * MAX_GPU_TIMING_MARKERS,
+			count, sizeof(u64) * count, timestamps.data(), sizeof(u64), VK_QUERY_RESULT_64_BIT);
+		if (res == VK_SUCCESS)
+		{
+			const double period = static_cast<double>(m_device_properties.limits.timestampPeriod);
+			for (u32 i = 0; i < (count - 1); i++)
+			{
+				AddGPUTimingCategoryTime(
+					resources.timing_categories[i], (timestamps[i + 1] - timestamps[i]) * period / 1000000.0);
+			}
+		}
+		else
+		{
+			LOG_VULKAN_ERROR(res, "vkGetQueryPoolResults failed: ");
+		}
+	}
+	resources.num_timing_markers = 0;
 }
 
 void GSDeviceVK::MoveToNextCommandBuffer()
@@ -1367,6 +1552,17 @@ void GSDeviceVK::ActivateCommandBuffer(u32 index)
 			resources.command_buffers[1], VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, m_timestamp_query_pool, index * 2);
 	}
 
+	resources.num_timing_markers = 0;
+	if (m_gpu_timing_breakdown)
+	{
+		vkCmdResetQueryPool(resources.command_buffers[1], m_breakdown_query_pool, index * MAX_GPU_TIMING_MARKERS,
+			MAX_GPU_TIMING_MARKERS);
+		vkCmdWriteTimestamp(resources.command_buffers[1], VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, m_breakdown_query_pool,
+			index * MAX_GPU_TIMING_MARKERS);
+		resources.timing_categories[0] = m_gpu_timing_category;
+		resources.num_timing_markers = 1;
+	}
+
 	resources.fence_counter = m_next_fence_counter++;
 	resources.init_buffer_used = false;
 	resources.timestamp_written = wants_timestamp;
@@ -1414,6 +1610,12 @@ void GSDeviceVK::DeferFramebufferDestruction(VkFramebuffer object)
 	resources.cleanup_resources.push_back([this, object]() { vkDestroyFramebuffer(m_device, object, nullptr); });
 }
 
+void GSDeviceVK::DeferPipelineDestruction(VkPipeline object)
+{
+	FrameResources& resources = m_frame_resources[m_current_frame];
+	resources.cleanup_resources.push_back([this, object]() { vkDestroyPipeline(m_device, object, nullptr); });
+}
+
 void GSDeviceVK::DeferImageDestruction(VkImage object, VmaAllocation allocation)
 {
 	FrameResources& resources = m_frame_resources[m_current_frame];
@@ -2095,7 +2297,11 @@ bool GSDeviceVK::Create(GSVSyncMode vsync_mode, bool allow_present_throttle)
 	if (!CompileImGuiPipeline())
 		return false;
 
+	if (m_optional_extensions.vk_ext_graphics_pipeline_library)
+		StartTFXOptimizeThread();
+
 	InitializeState();
+	OpenPipelineUsageList("vk", sizeof(PipelineSelector));
 	return true;
 }
 
@@ -2264,7 +2470,9 @@ void GSDeviceVK::SetVSyncMode(GSVSyncMode mode, bool allow_present_throttle)
 	m_vsync_mode = mode;
 
 	// This swap chain should not be used by the current buffer, thus safe to destroy.
-	WaitForGPUIdle();
+	// Compatible modes are switched at present time, no need to wait for anything.
+	if (!m_swap_chain->CanSwitchPresentMode(present_mode))
+		WaitForGPUIdle();
 	if (!m_swap_chain->SetPresentMode(present_mode))
 	{
 		pxFailRel("Failed to update swap chain present mode.");
@@ -2370,6 +2578,9 @@ void GSDeviceVK::EndPresent()
 	MoveToNextCommandBuffer();
 
 	InvalidateCachedState();
+
+	InstallOptimizedTFXPipelines();
+	PrecompileTFXPipelines();
 }
 
 #ifdef ENABLE_OGL_DEBUG
@@ -3135,6 +3346,29 @@ void GSDeviceVK::ConvertToIndexedTexture(
 		m_convert[static_cast<int>(shader)], false, true);
 }
 
+void GSDeviceVK::UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin,
+	u32 BP, u32 BW, u32 PSM, u32 TA0, bool AEM)
+{
+	struct Uniforms
+	{
+		GSVector2 origin;
+		float ta0;
+		float aem;
+		u32 bp;
+		u32 bw;
+		u32 psm;
+		u32 pad1;
+	};
+
+	const Uniforms uniforms = {GSVector2(static_cast<float>(origin.x), static_cast<float>(origin.y)),
+		static_cast<float>(TA0) / 255.0f, AEM ? 1.0f : 0.0f, BP, BW, PSM, 0};
+	SetUtilityPushConstants(&uniforms, sizeof(uniforms));
+
+	const ShaderConvert shader = ShaderConvert::UNSWIZZLE_CT32;
+	DoStretchRect(static_cast<GSTextureVK*>(sTex), GSVector4::zero(), static_cast<GSTextureVK*>(dTex), GSVector4(dRect),
+		m_convert[static_cast<int>(shader)], false, true);
+}
+
 void GSDeviceVK::FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect)
 {
 	struct Uniforms
@@ -3758,6 +3992,33 @@ bool GSDeviceVK::CreatePipelineLayouts()
 	if ((m_tfx_pipeline_layout = plb.Create(dev)) == VK_NULL_HANDLE)
 		return false;
 	Vulkan::SetObjectName(dev, m_tfx_pipeline_layout, "TFX pipeline layout");
+
+	// Pushing the texture set through a template saves the driver parsing a write per binding on every draw.
+	// The textures are all in one array of image infos, indexed by binding.
+	if (vkCmdPushDescriptorSetWithTemplateKHR)
+	{
+		std::array<VkDescriptorUpdateTemplateEntry, NUM_TFX_TEXTURES> entries;
+		for (u32 i = 0; i < NUM_TFX_TEXTURES; i++)
+		{
+			entries[i] = {i, 0, 1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, i * sizeof(VkDescriptorImageInfo),
+				sizeof(VkDescriptorImageInfo)};
+		}
+		entries[TFX_TEXTURE_TEXTURE].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		if (m_features.texture_barrier && !UseFeedbackLoopLayout())
+			entries[TFX_TEXTURE_RT].descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+
+		const VkDescriptorUpdateTemplateCreateInfo ci = {VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+			nullptr, 0, NUM_TFX_TEXTURES, entries.data(), VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR,
+			m_tfx_texture_ds_layout, VK_PIPELINE_BIND_POINT_GRAPHICS, m_tfx_pipeline_layout,
+			TFX_DESCRIPTOR_SET_TEXTURES};
+		const VkResult res = vkCreateDescriptorUpdateTemplate(dev, &ci, nullptr, &m_tfx_texture_update_template);
+		if (res != VK_SUCCESS)
+		{
+			LOG_VULKAN_ERROR(res, "vkCreateDescriptorUpdateTemplate() failed: ");
+			m_tfx_texture_update_template = VK_NULL_HANDLE;
+		}
+	}
+
 	return true;
 }
 
@@ -4526,11 +4787,19 @@ bool GSDeviceVK::DoCAS(
 
 void GSDeviceVK::DestroyResources()
 {
+	StopTFXOptimizeThread();
+
 	if (m_tfx_ubo_descriptor_set != VK_NULL_HANDLE)
 		FreePersistentDescriptorSet(m_tfx_ubo_descriptor_set);
 
 	for (auto& it : m_tfx_pipelines)
 		vkDestroyPipeline(m_device, it.second, nullptr);
+	for (auto& libraries : m_tfx_pipeline_libraries)
+	{
+		for (auto& it : libraries)
+			vkDestroyPipeline(m_device, it.second, nullptr);
+		libraries.clear();
+	}
 	for (auto& it : m_tfx_fragment_shaders)
 		vkDestroyShaderModule(m_device, it.second, nullptr);
 	for (auto& it : m_tfx_vertex_shaders)
@@ -4610,6 +4879,8 @@ void GSDeviceVK::DestroyResources()
 	if (m_expand_index_buffer != VK_NULL_HANDLE)
 		vmaDestroyBuffer(m_allocator, m_expand_index_buffer, m_expand_index_buffer_allocation);
 
+	if (m_tfx_texture_update_template != VK_NULL_HANDLE)
+		vkDestroyDescriptorUpdateTemplate(m_device, m_tfx_texture_update_template, nullptr);
 	if (m_tfx_pipeline_layout != VK_NULL_HANDLE)
 		vkDestroyPipelineLayout(m_device, m_tfx_pipeline_layout, nullptr);
 	if (m_tfx_texture_ds_layout != VK_NULL_HANDLE)
@@ -4646,6 +4917,8 @@ void GSDeviceVK::DestroyResources()
 
 	if (m_timestamp_query_pool != VK_NULL_HANDLE)
 		vkDestroyQueryPool(m_device, m_timestamp_query_pool, nullptr);
+	if (m_breakdown_query_pool != VK_NULL_HANDLE)
+		vkDestroyQueryPool(m_device, m_breakdown_query_pool, nullptr);
 
 	if (m_global_descriptor_pool != VK_NULL_HANDLE)
 		vkDestroyDescriptorPool(m_device, m_global_descriptor_pool, nullptr);
@@ -4757,7 +5030,20 @@ VkShaderModule GSDeviceVK::GetTFXFragmentShader(const GSHWDrawConfig::PSSelector
 	return mod;
 }
 
-VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
+VkRenderPass GSDeviceVK::GetTFXPipelineRenderPass(const PipelineSelector& p)
+{
+	if (IsDATEModePrimIDInit(p.ps.date))
+	{
+		// DATE image prepass
+		return m_date_image_setup_render_passes[p.ds][0];
+	}
+
+	return GetTFXRenderPass(p.rt, p.ds, p.ps.colclip_hw, p.dss.date, p.IsRTFeedbackLoop(),
+		p.IsTestingAndSamplingDepth(), p.rt ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+		p.ds ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+}
+
+bool GSDeviceVK::FillTFXPipelineState(Vulkan::GraphicsPipelineBuilder& gpb, const PipelineSelector& p)
 {
 	static constexpr std::array<VkPrimitiveTopology, 3> topology_lookup = {{
 		VK_PRIMITIVE_TOPOLOGY_POINT_LIST, // Point
@@ -4777,27 +5063,13 @@ VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
 	VkShaderModule vs = GetTFXVertexShader(p.vs);
 	VkShaderModule fs = GetTFXFragmentShader(pps);
 	if (vs == VK_NULL_HANDLE || fs == VK_NULL_HANDLE)
-		return VK_NULL_HANDLE;
+		return false;
 
-	Vulkan::GraphicsPipelineBuilder gpb;
 	SetPipelineProvokingVertex(m_features, gpb);
 
 	// Common state
 	gpb.SetPipelineLayout(m_tfx_pipeline_layout);
-	if (IsDATEModePrimIDInit(p.ps.date))
-	{
-		// DATE image prepass
-		gpb.SetRenderPass(m_date_image_setup_render_passes[p.ds][0], 0);
-	}
-	else
-	{
-		gpb.SetRenderPass(
-			GetTFXRenderPass(p.rt, p.ds, p.ps.colclip_hw, p.dss.date,
-				p.IsRTFeedbackLoop(), p.IsTestingAndSamplingDepth(),
-				p.rt ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-				p.ds ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE),
-			0);
-	}
+	gpb.SetRenderPass(GetTFXPipelineRenderPass(p), 0);
 	gpb.SetPrimitiveTopology(topology_lookup[p.topology]);
 	gpb.SetRasterizationState(VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE, VK_FRONT_FACE_CLOCKWISE);
 	if (m_optional_extensions.vk_ext_line_rasterization &&
@@ -4874,6 +5146,15 @@ VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
 	if (m_features.framebuffer_fetch && p.IsRTFeedbackLoop())
 		gpb.AddBlendFlags(VK_PIPELINE_COLOR_BLEND_STATE_CREATE_RASTERIZATION_ORDER_ATTACHMENT_ACCESS_BIT_EXT);
 
+	return true;
+}
+
+VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
+{
+	Vulkan::GraphicsPipelineBuilder gpb;
+	if (!FillTFXPipelineState(gpb, p))
+		return VK_NULL_HANDLE;
+
 	VkPipeline pipeline = gpb.Create(m_device, g_vulkan_shader_cache->GetPipelineCache(true));
 	if (pipeline)
 	{
@@ -4884,17 +5165,202 @@ VkPipeline GSDeviceVK::CreateTFXPipeline(const PipelineSelector& p)
 	return pipeline;
 }
 
+VkPipeline GSDeviceVK::LinkTFXPipeline(const PipelineSelector& p)
+{
+	static constexpr std::array<VkGraphicsPipelineLibraryFlagsEXT, NUM_TFX_PIPELINE_LIBRARIES> library_flags = {{
+		VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+		VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+		VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+		VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+	}};
+
+	// Each part is keyed on only the selector bits which feed into its state, so e.g. a new blend mode
+	// only needs a new output interface, and reuses the already-compiled shaders.
+	const VkRenderPass render_pass = GetTFXPipelineRenderPass(p);
+	const bool blend_effective = p.bs.IsEffective(p.cms);
+	const bool prim_id_init = IsDATEModePrimIDInit(p.ps.date);
+	const bool rast_order = (m_features.framebuffer_fetch && p.IsRTFeedbackLoop());
+	const std::array<TFXPipelineLibraryKey, NUM_TFX_PIPELINE_LIBRARIES> keys = {{
+		{VK_NULL_HANDLE, p.topology, static_cast<u64>(p.vs.expand == GSHWDrawConfig::VSExpand::None)},
+		{render_pass, p.vs.key, p.topology},
+		{render_pass, p.ps.key_lo,
+			static_cast<u64>(p.ps.key_hi) | (static_cast<u64>(p.dss.key) << 32) |
+				(static_cast<u64>(blend_effective) << 40)},
+		{render_pass, blend_effective ? p.bs.key : 0u,
+			static_cast<u64>(p.cms.key) | (static_cast<u64>(prim_id_init) << 8) | (static_cast<u64>(rast_order) << 9)},
+	}};
+
+	const VkPipelineCache pipeline_cache = g_vulkan_shader_cache->GetPipelineCache(true);
+	std::array<VkPipeline, NUM_TFX_PIPELINE_LIBRARIES> libraries;
+	Vulkan::GraphicsPipelineBuilder gpb;
+	bool state_filled = false;
+	for (u32 i = 0; i < NUM_TFX_PIPELINE_LIBRARIES; i++)
+	{
+		const auto it = m_tfx_pipeline_libraries[i].find(keys[i]);
+		if (it != m_tfx_pipeline_libraries[i].end())
+		{
+			libraries[i] = it->second;
+			continue;
+		}
+
+		if (!state_filled)
+		{
+			if (!FillTFXPipelineState(gpb, p))
+				return VK_NULL_HANDLE;
+
+			gpb.AddPipelineFlags(VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT);
+			state_filled = true;
+		}
+
+		gpb.SetLibraryFlags(library_flags[i]);
+		libraries[i] = gpb.Create(m_device, pipeline_cache, false);
+		if (libraries[i] == VK_NULL_HANDLE)
+			return VK_NULL_HANDLE;
+
+		m_tfx_pipeline_libraries[i].emplace(keys[i], libraries[i]);
+	}
+
+	gpb.Clear();
+	gpb.SetPipelineLayout(m_tfx_pipeline_layout);
+	gpb.SetRenderPass(render_pass, 0);
+	for (VkPipeline library : libraries)
+		gpb.AddPipelineLibrary(library);
+
+	VkPipeline pipeline = gpb.Create(m_device, pipeline_cache);
+	if (pipeline == VK_NULL_HANDLE)
+		return VK_NULL_HANDLE;
+
+	Vulkan::SetObjectName(
+		m_device, pipeline, "Linked TFX Pipeline %08X/%" PRIX64 "%08X", p.vs.key, p.ps.key_hi, p.ps.key_lo);
+
+	{
+		std::unique_lock lock(m_tfx_optimize_mutex);
+		m_tfx_optimize_queue.push_back({p, libraries, render_pass, VK_NULL_HANDLE});
+	}
+	m_tfx_optimize_cv.notify_one();
+
+	return pipeline;
+}
+
+void GSDeviceVK::StartTFXOptimizeThread()
+{
+	m_tfx_optimize_pipeline_cache = g_vulkan_shader_cache->GetPipelineCache(true);
+	m_tfx_optimize_thread_running = true;
+	m_tfx_optimize_thread = std::thread(&GSDeviceVK::TFXOptimizeThreadEntryPoint, this);
+}
+
+void GSDeviceVK::StopTFXOptimizeThread()
+{
+	if (!m_tfx_optimize_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(m_tfx_optimize_mutex);
+		m_tfx_optimize_thread_running = false;
+		m_tfx_optimize_queue.clear();
+	}
+	m_tfx_optimize_cv.notify_one();
+	m_tfx_optimize_thread.join();
+
+	for (const TFXPipelineOptimizeRequest& req : m_tfx_optimized_pipelines)
+		vkDestroyPipeline(m_device, req.pipeline, nullptr);
+	m_tfx_optimized_pipelines.clear();
+}
+
+void GSDeviceVK::TFXOptimizeThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Vulkan Pipeline Optimizer");
+
+	Vulkan::GraphicsPipelineBuilder gpb;
+	std::unique_lock lock(m_tfx_optimize_mutex);
+	while (m_tfx_optimize_thread_running)
+	{
+		if (m_tfx_optimize_queue.empty())
+		{
+			m_tfx_optimize_cv.wait(lock);
+			continue;
+		}
+
+		TFXPipelineOptimizeRequest req = m_tfx_optimize_queue.front();
+		m_tfx_optimize_queue.pop_front();
+		lock.unlock();
+
+		gpb.SetPipelineLayout(m_tfx_pipeline_layout);
+		gpb.SetRenderPass(req.render_pass, 0);
+		for (VkPipeline library : req.libraries)
+			gpb.AddPipelineLibrary(library);
+		gpb.AddPipelineFlags(VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT);
+		req.pipeline = gpb.Create(m_device, m_tfx_optimize_pipeline_cache);
+
+		lock.lock();
+		if (req.pipeline != VK_NULL_HANDLE)
+			m_tfx_optimized_pipelines.push_back(req);
+	}
+}
+
+void GSDeviceVK::InstallOptimizedTFXPipelines()
+{
+	std::unique_lock lock(m_tfx_optimize_mutex);
+	for (const TFXPipelineOptimizeRequest& req : m_tfx_optimized_pipelines)
+	{
+		const auto it = m_tfx_pipelines.find(req.selector);
+		if (it == m_tfx_pipelines.end())
+		{
+			vkDestroyPipeline(m_device, req.pipeline, nullptr);
+			continue;
+		}
+
+		// The fast-linked pipeline may still be referenced by in-flight command buffers.
+		if (it->second != VK_NULL_HANDLE)
+			DeferPipelineDestruction(it->second);
+		it->second = req.pipeline;
+		Vulkan::SetObjectName(m_device, req.pipeline, "TFX Pipeline %08X/%" PRIX64 "%08X", req.selector.vs.key,
+			req.selector.ps.key_hi, req.selector.ps.key_lo);
+	}
+	m_tfx_optimized_pipelines.clear();
+}
+
 VkPipeline GSDeviceVK::GetTFXPipeline(const PipelineSelector& p)
 {
 	const auto it = m_tfx_pipelines.find(p);
 	if (it != m_tfx_pipelines.end())
 		return it->second;
 
-	VkPipeline pipeline = CreateTFXPipeline(p);
+	g_perfmon.Put(GSPerfMon::PipelineMisses, 1);
+
+	// Fast-link from pipeline libraries where we can, the optimized pipeline gets swapped in later.
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	if (m_optional_extensions.vk_ext_graphics_pipeline_library)
+		pipeline = LinkTFXPipeline(p);
+	if (pipeline == VK_NULL_HANDLE)
+		pipeline = CreateTFXPipeline(p);
+
 	m_tfx_pipelines.emplace(p, pipeline);
+	if (pipeline != VK_NULL_HANDLE)
+		m_pipeline_usage.Record(&p);
+
 	return pipeline;
 }
 
+void GSDeviceVK::PrecompileTFXPipelines()
+{
+	if (!m_pipeline_usage.HasPendingPrecompiles())
+		return;
+
+	// Spread the work over a few frames, so a long list doesn't stall presentation.
+	Common::Timer timer;
+	while (const void* data = m_pipeline_usage.GetNextPrecompile())
+	{
+		PipelineSelector p;
+		std::memcpy(&p, data, sizeof(p));
+		if (m_tfx_pipelines.find(p) == m_tfx_pipelines.end())
+			m_tfx_pipelines.emplace(p, CreateTFXPipeline(p));
+
+		if (timer.GetTimeMilliseconds() >= PIPELINE_PRECOMPILE_TIME_SLICE_MS)
+			break;
+	}
+}
+
 bool GSDeviceVK::BindDrawPipeline(const PipelineSelector& p)
 {
 	VkPipeline pipeline = GetTFXPipeline(p);
@@ -5339,7 +5805,8 @@ bool GSDeviceVK::ApplyTFXState(bool already_execed)
 	}
 
 	Vulkan::DescriptorSetUpdateBuilder dsub;
-	if (m_current_pipeline_layout != PipelineLayout::TFX)
+	const bool layout_changed = (m_current_pipeline_layout != PipelineLayout::TFX);
+	if (layout_changed)
 	{
 		m_current_pipeline_layout = PipelineLayout::TFX;
 		flags |= DIRTY_FLAG_TFX_UBO | DIRTY_FLAG_TFX_TEXTURES;
@@ -5358,7 +5825,51 @@ bool GSDeviceVK::ApplyTFXState(bool already_execed)
 			&m_tfx_ubo_descriptor_set, NUM_TFX_DYNAMIC_OFFSETS, m_tfx_dynamic_offsets.data());
 	}
 
-	if (flags & DIRTY_FLAG_TFX_TEXTURES)
+	if ((flags & DIRTY_FLAG_TFX_TEXTURES) && m_tfx_texture_update_template != VK_NULL_HANDLE)
+	{
+		// Only refresh the dirty bindings, the rest keep what was pushed last, same as the write path below.
+		// Textures often get swapped out and back between draws, so skip the push if nothing actually changed.
+		// Binding another layout disturbs the pushed set, so it always has to be pushed again after a switch.
+		bool changed = layout_changed;
+		const auto update = [this, &changed](u32 slot, VkSampler sampler, VkImageView view, VkImageLayout layout) {
+			VkDescriptorImageInfo& info = m_tfx_texture_descriptors[slot];
+			if (info.sampler == sampler && info.imageView == view && info.imageLayout == layout)
+				return;
+
+			info = {sampler, view, layout};
+			changed = true;
+		};
+
+		if (flags & DIRTY_FLAG_TFX_TEXTURE_TEX)
+		{
+			update(TFX_TEXTURE_TEXTURE, m_tfx_sampler, m_tfx_textures[TFX_TEXTURE_TEXTURE]->GetView(),
+				m_tfx_textures[TFX_TEXTURE_TEXTURE]->GetVkLayout());
+		}
+		if (flags & DIRTY_FLAG_TFX_TEXTURE_PALETTE)
+		{
+			update(TFX_TEXTURE_PALETTE, VK_NULL_HANDLE, m_tfx_textures[TFX_TEXTURE_PALETTE]->GetView(),
+				m_tfx_textures[TFX_TEXTURE_PALETTE]->GetVkLayout());
+		}
+		if (flags & DIRTY_FLAG_TFX_TEXTURE_RT)
+		{
+			update(TFX_TEXTURE_RT, VK_NULL_HANDLE, m_tfx_textures[TFX_TEXTURE_RT]->GetView(),
+				(m_features.texture_barrier && !UseFeedbackLoopLayout()) ?
+					VK_IMAGE_LAYOUT_GENERAL :
+					m_tfx_textures[TFX_TEXTURE_RT]->GetVkLayout());
+		}
+		if (flags & DIRTY_FLAG_TFX_TEXTURE_PRIMID)
+		{
+			update(TFX_TEXTURE_PRIMID, VK_NULL_HANDLE, m_tfx_textures[TFX_TEXTURE_PRIMID]->GetView(),
+				m_tfx_textures[TFX_TEXTURE_PRIMID]->GetVkLayout());
+		}
+
+		if (changed)
+		{
+			vkCmdPushDescriptorSetWithTemplateKHR(cmdbuf, m_tfx_texture_update_template, m_tfx_pipeline_layout,
+				TFX_DESCRIPTOR_SET_TEXTURES, m_tfx_texture_descriptors.data());
+		}
+	}
+	else if (flags & DIRTY_FLAG_TFX_TEXTURES)
 	{
 		if (flags & DIRTY_FLAG_TFX_TEXTURE_TEX)
 		{
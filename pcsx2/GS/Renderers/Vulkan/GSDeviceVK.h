@@ -15,6 +15,7 @@
 #include <array>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -25,12 +26,20 @@
 
 class VKSwapChain;
 
+namespace Vulkan
+{
+	class GraphicsPipelineBuilder;
+}
+
 class GSDeviceVK final : public GSDevice
 {
 public:
 	enum : u32
 	{
 		NUM_COMMAND_BUFFERS = 3,
+
+		/// Timestamps per command buffer for the GPU time breakdown, including the one at the end.
+		MAX_GPU_TIMING_MARKERS = 128,
 	};
 
 	struct OptionalExtensions
@@ -45,6 +54,7 @@ public:
 		bool vk_khr_driver_properties : 1;
 		bool vk_khr_shader_non_semantic_info : 1;
 		bool vk_ext_attachment_feedback_loop_layout : 1;
+		bool vk_ext_graphics_pipeline_library : 1;
 	};
 
 	// Global state accessors
@@ -95,10 +105,25 @@ public:
 
 	// These command buffers are allocated per-frame. They are valid until the command buffer
 	// is submitted, after that you should call these functions again.
-	__fi VkCommandBuffer GetCurrentCommandBuffer() const { return m_current_command_buffer; }
+	__fi VkCommandBuffer GetCurrentCommandBuffer()
+	{
+		if (m_gpu_timing_breakdown) [[unlikely]]
+			WriteGPUTimingMarker();
+		return m_current_command_buffer;
+	}
 	__fi VKStreamBuffer& GetTextureUploadBuffer() { return m_texture_stream_buffer; }
 	VkCommandBuffer GetCurrentInitCommandBuffer();
 
+	// Texture uploads to the init command buffer are batched, so all of them share one barrier before
+	// and after, and each destination gets a single vkCmdCopyBufferToImage(). The batch is recorded when
+	// the init command buffer is needed for anything else, or when it is submitted.
+	__fi u64 GetUploadBatchCounter() const { return m_upload_batch_counter; }
+	void AddUploadBatchImage(const VkImageMemoryBarrier& pre_barrier, VkPipelineStageFlags pre_src_stages,
+		const VkImageMemoryBarrier& post_barrier, VkPipelineStageFlags post_dst_stages);
+	void QueueBatchedUpload(VkImage image, VkBuffer buffer, const VkBufferImageCopy& region);
+	bool IsUploadPendingForRegion(VkImage image, const VkBufferImageCopy& region) const;
+	void FlushUploadBatch();
+
 	/// Allocates a descriptor set from the pool reserved for the current frame.
 	VkDescriptorSet AllocatePersistentDescriptorSet(VkDescriptorSetLayout set_layout);
 
@@ -125,6 +150,7 @@ public:
 	void DeferFramebufferDestruction(VkFramebuffer object);
 	void DeferImageDestruction(VkImage object, VmaAllocation allocation);
 	void DeferImageViewDestruction(VkImageView object);
+	void DeferPipelineDestruction(VkPipeline object);
 
 	// Wait for a fence to be completed.
 	// Also invokes callbacks for completion.
@@ -142,6 +168,7 @@ private:
 	void DisableDebugUtils();
 
 	void SubmitCommandBuffer(VKSwapChain* present_swap_chain);
+	VkCommandBuffer BeginInitCommandBuffer();
 	void MoveToNextCommandBuffer();
 
 	enum class WaitType
@@ -193,6 +220,7 @@ private:
 
 	void CommandBufferCompleted(u32 index);
 	void ActivateCommandBuffer(u32 index);
+	void WriteGPUTimingMarker();
 	void ScanForCommandBufferCompletion();
 	void WaitForCommandBufferCompletion(u32 index);
 
@@ -217,6 +245,10 @@ private:
 		bool needs_fence_wait = false;
 		bool timestamp_written = false;
 
+		// Category of the work following each breakdown timestamp.
+		std::array<GPUTimingCategory, MAX_GPU_TIMING_MARKERS> timing_categories;
+		u32 num_timing_markers = 0;
+
 		std::vector<std::function<void()>> cleanup_resources;
 	};
 
@@ -266,6 +298,7 @@ private:
 	bool m_spin_buffer_initialized = false;
 
 	VkQueryPool m_timestamp_query_pool = VK_NULL_HANDLE;
+	VkQueryPool m_breakdown_query_pool = VK_NULL_HANDLE;
 	float m_accumulated_gpu_time = 0.0f;
 	bool m_gpu_timing_enabled = false;
 	bool m_gpu_timing_supported = false;
@@ -273,6 +306,21 @@ private:
 	VkTimeDomainEXT m_calibrated_timestamp_type = VK_TIME_DOMAIN_DEVICE_EXT;
 
 	std::array<FrameResources, NUM_COMMAND_BUFFERS> m_frame_resources;
+
+	struct BatchedUpload
+	{
+		VkImage image;
+		VkBuffer buffer;
+		VkBufferImageCopy region;
+	};
+
+	std::vector<BatchedUpload> m_upload_batch;
+	std::vector<VkImageMemoryBarrier> m_upload_batch_pre_barriers;
+	std::vector<VkImageMemoryBarrier> m_upload_batch_post_barriers;
+	std::vector<VkBufferImageCopy> m_upload_batch_regions;
+	VkPipelineStageFlags m_upload_batch_pre_src_stages = 0;
+	VkPipelineStageFlags m_upload_batch_post_dst_stages = 0;
+	u64 m_upload_batch_counter = 1;
 	u64 m_next_fence_counter = 1;
 	u64 m_completed_fence_counter = 0;
 	u32 m_current_frame = 0;
@@ -349,6 +397,15 @@ public:
 
 		NUM_CAS_PIPELINES = 2,
 	};
+	enum TFX_PIPELINE_LIBRARY : u32
+	{
+		TFX_PIPELINE_LIBRARY_VERTEX_INPUT,
+		TFX_PIPELINE_LIBRARY_PRE_RASTERIZATION,
+		TFX_PIPELINE_LIBRARY_FRAGMENT_SHADER,
+		TFX_PIPELINE_LIBRARY_FRAGMENT_OUTPUT,
+
+		NUM_TFX_PIPELINE_LIBRARIES,
+	};
 	enum TFX_DESCRIPTOR_SET : u32
 	{
 		TFX_DESCRIPTOR_SET_UBO,
@@ -375,6 +432,7 @@ private:
 	VkDescriptorSetLayout m_tfx_ubo_ds_layout = VK_NULL_HANDLE;
 	VkDescriptorSetLayout m_tfx_texture_ds_layout = VK_NULL_HANDLE;
 	VkPipelineLayout m_tfx_pipeline_layout = VK_NULL_HANDLE;
+	VkDescriptorUpdateTemplate m_tfx_texture_update_template = VK_NULL_HANDLE;
 
 	VKStreamBuffer m_vertex_stream_buffer;
 	VKStreamBuffer m_index_stream_buffer;
@@ -427,6 +485,47 @@ private:
 
 	std::string m_tfx_source;
 
+	// Pipeline library parts for each subset of a TFX pipeline's state, used with VK_EXT_graphics_pipeline_library.
+	struct TFXPipelineLibraryKey
+	{
+		VkRenderPass render_pass;
+		u64 key_hi;
+		u64 key_lo;
+
+		__fi bool operator==(const TFXPipelineLibraryKey& k) const
+		{
+			return (render_pass == k.render_pass && key_hi == k.key_hi && key_lo == k.key_lo);
+		}
+	};
+	struct TFXPipelineLibraryKeyHash
+	{
+		std::size_t operator()(const TFXPipelineLibraryKey& e) const noexcept
+		{
+			std::size_t hash = 0;
+			HashCombine(hash, e.render_pass, e.key_hi, e.key_lo);
+			return hash;
+		}
+	};
+	std::array<std::unordered_map<TFXPipelineLibraryKey, VkPipeline, TFXPipelineLibraryKeyHash>,
+		NUM_TFX_PIPELINE_LIBRARIES>
+		m_tfx_pipeline_libraries;
+
+	// Fast-linked pipelines get relinked with link-time optimization on a worker thread, then swapped in.
+	struct TFXPipelineOptimizeRequest
+	{
+		PipelineSelector selector;
+		std::array<VkPipeline, NUM_TFX_PIPELINE_LIBRARIES> libraries;
+		VkRenderPass render_pass;
+		VkPipeline pipeline;
+	};
+	std::thread m_tfx_optimize_thread;
+	std::mutex m_tfx_optimize_mutex;
+	std::condition_variable m_tfx_optimize_cv;
+	std::deque<TFXPipelineOptimizeRequest> m_tfx_optimize_queue;
+	std::vector<TFXPipelineOptimizeRequest> m_tfx_optimized_pipelines;
+	VkPipelineCache m_tfx_optimize_pipeline_cache = VK_NULL_HANDLE;
+	bool m_tfx_optimize_thread_running = false;
+
 	GSTexture* CreateSurface(
 		GSTexture::Type type, int width, int height, int levels, GSTexture::Format format) override;
 
@@ -445,8 +544,16 @@ private:
 
 	VkShaderModule GetTFXVertexShader(GSHWDrawConfig::VSSelector sel);
 	VkShaderModule GetTFXFragmentShader(const GSHWDrawConfig::PSSelector& sel);
+	VkRenderPass GetTFXPipelineRenderPass(const PipelineSelector& p);
+	bool FillTFXPipelineState(Vulkan::GraphicsPipelineBuilder& gpb, const PipelineSelector& p);
 	VkPipeline CreateTFXPipeline(const PipelineSelector& p);
+	VkPipeline LinkTFXPipeline(const PipelineSelector& p);
 	VkPipeline GetTFXPipeline(const PipelineSelector& p);
+	void StartTFXOptimizeThread();
+	void StopTFXOptimizeThread();
+	void TFXOptimizeThreadEntryPoint();
+	void InstallOptimizedTFXPipelines();
+	void PrecompileTFXPipelines();
 
 	VkShaderModule GetUtilityVertexShader(const std::string& source, const char* replace_main);
 	VkShaderModule GetUtilityFragmentShader(const std::string& source, const char* replace_main);
@@ -513,6 +620,7 @@ public:
 
 	bool SetGPUTimingEnabled(bool enabled) override;
 	float GetAndResetAccumulatedGPUTime() override;
+	bool SetGPUTimingBreakdownEnabled(bool enabled) override;
 
 	void PushDebugGroup(const char* fmt, ...) override;
 	void PopDebugGroup() override;
@@ -549,6 +657,8 @@ public:
 		GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, GSTexture* dTex, u32 dOffset, u32 dSize) override;
 	void ConvertToIndexedTexture(GSTexture* sTex, float sScale, u32 offsetX, u32 offsetY, u32 SBW, u32 SPSM,
 		GSTexture* dTex, u32 DBW, u32 DPSM) override;
+	void UnswizzleTexture(GSTexture* sTex, GSTexture* dTex, const GSVector4i& dRect, const GSVector2i& origin, u32 BP,
+		u32 BW, u32 PSM, u32 TA0, bool AEM) override;
 	void FilteredDownsampleTexture(GSTexture* sTex, GSTexture* dTex, u32 downsample_factor, const GSVector2i& clamp_min, const GSVector4& dRect) override;
 
 	void SetupDATE(GSTexture* rt, GSTexture* ds, SetDATM datm, const GSVector4i& bbox);
@@ -682,6 +792,7 @@ private:
 	u8 m_blend_constant_color = 0;
 
 	std::array<const GSTextureVK*, NUM_TFX_TEXTURES> m_tfx_textures{};
+	std::array<VkDescriptorImageInfo, NUM_TFX_TEXTURES> m_tfx_texture_descriptors{}; // last pushed, for the template
 	VkSampler m_tfx_sampler = VK_NULL_HANDLE;
 	u32 m_tfx_sampler_sel = 0;
 	VkDescriptorSet m_tfx_ubo_descriptor_set = VK_NULL_HANDLE;
@@ -321,6 +321,40 @@ void GSTextureVK::UpdateFromBuffer(VkCommandBuffer cmdbuf, int level, u32 x, u32
 		TransitionSubresourcesToLayout(cmdbuf, level, 1, Layout::TransferDst, old_layout);
 }
 
+bool GSTextureVK::CanBatchUpload() const
+{
+	// Same condition as GetCommandBufferForUpdate() using the init command buffer.
+	return (m_type == Type::Texture && m_use_fence_counter != GSDeviceVK::GetInstance()->GetCurrentFenceCounter());
+}
+
+void GSTextureVK::QueueBatchedUpload(int level, u32 x, u32 y, u32 width, u32 height, u32 buffer_height,
+	u32 row_length, VkBuffer buffer, u32 buffer_offset)
+{
+	GSDeviceVK* const dev = GSDeviceVK::GetInstance();
+	const VkBufferImageCopy bic = {static_cast<VkDeviceSize>(buffer_offset), row_length, buffer_height,
+		{VK_IMAGE_ASPECT_COLOR_BIT, static_cast<u32>(level), 0u, 1u}, {static_cast<s32>(x), static_cast<s32>(y), 0},
+		{width, height, 1u}};
+
+	// Overwriting a region which is already queued needs a barrier in between, so send the batch off first.
+	if (m_upload_batch == dev->GetUploadBatchCounter() && dev->IsUploadPendingForRegion(m_image, bic))
+		dev->FlushUploadBatch();
+
+	// The batch transitions the whole image, and leaves it in the same layout as an unbatched upload would.
+	if (m_upload_batch != dev->GetUploadBatchCounter())
+	{
+		VkImageMemoryBarrier pre_barrier, post_barrier;
+		VkPipelineStageFlags pre_src_stages, post_dst_stages, unused_stages;
+		GetLayoutBarrier(0, m_mipmap_levels, m_layout, Layout::TransferDst, pre_barrier, pre_src_stages, unused_stages);
+		GetLayoutBarrier(0, m_mipmap_levels, Layout::TransferDst, Layout::ShaderReadOnly, post_barrier, unused_stages,
+			post_dst_stages);
+		dev->AddUploadBatchImage(pre_barrier, pre_src_stages, post_barrier, post_dst_stages);
+		m_upload_batch = dev->GetUploadBatchCounter();
+		m_layout = Layout::ShaderReadOnly;
+	}
+
+	dev->QueueBatchedUpload(m_image, buffer, bic);
+}
+
 bool GSTextureVK::Update(const GSVector4i& r, const void* data, int pitch, int layer)
 {
 	if (layer >= m_mipmap_levels)
@@ -364,6 +398,14 @@ bool GSTextureVK::Update(const GSVector4i& r, const void* data, int pitch, int l
 		sbuffer.CommitMemory(required_size);
 	}
 
+	if (CanBatchUpload())
+	{
+		QueueBatchedUpload(layer, r.x, r.y, width, height, Common::AlignUpPow2(height, GetCompressedBlockSize()),
+			CalcUploadRowLengthFromPitch(upload_pitch), buffer, buffer_offset);
+		m_needs_mipmaps_generated |= (layer == 0);
+		return true;
+	}
+
 	const VkCommandBuffer cmdbuf = GetCommandBufferForUpdate();
 	GL_PUSH("GSTextureVK::Update({%d,%d} %dx%d Lvl:%u", r.x, r.y, r.width(), r.height(), layer);
 
@@ -435,6 +477,15 @@ void GSTextureVK::Unmap()
 	const u32 buffer_offset = buffer.GetCurrentOffset();
 	buffer.CommitMemory(required_size);
 
+	if (CanBatchUpload())
+	{
+		QueueBatchedUpload(m_map_level, m_map_area.x, m_map_area.y, width, height,
+			Common::AlignUpPow2(height, GetCompressedBlockSize()), CalcUploadRowLengthFromPitch(pitch),
+			buffer.GetBuffer(), buffer_offset);
+		m_needs_mipmaps_generated |= (m_map_level == 0);
+		return;
+	}
+
 	const VkCommandBuffer cmdbuf = GetCommandBufferForUpdate();
 	GL_PUSH("GSTextureVK::Update({%d,%d} %dx%d Lvl:%u", m_map_area.x, m_map_area.y, m_map_area.width(),
 		m_map_area.height(), m_map_level);
@@ -560,6 +611,15 @@ void GSTextureVK::TransitionToLayout(VkCommandBuffer command_buffer, Layout new_
 
 void GSTextureVK::TransitionSubresourcesToLayout(
 	VkCommandBuffer command_buffer, int start_level, int num_levels, Layout old_layout, Layout new_layout)
+{
+	VkImageMemoryBarrier barrier;
+	VkPipelineStageFlags srcStageMask, dstStageMask;
+	GetLayoutBarrier(start_level, num_levels, old_layout, new_layout, barrier, srcStageMask, dstStageMask);
+	vkCmdPipelineBarrier(command_buffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void GSTextureVK::GetLayoutBarrier(int start_level, int num_levels, Layout old_layout, Layout new_layout,
+	VkImageMemoryBarrier& barrier, VkPipelineStageFlags& srcStageMask, VkPipelineStageFlags& dstStageMask) const
 {
 	VkImageAspectFlags aspect;
 	if (m_type == Type::DepthStencil)
@@ -572,13 +632,12 @@ void GSTextureVK::TransitionSubresourcesToLayout(
 		aspect = VK_IMAGE_ASPECT_COLOR_BIT;
 	}
 
-	VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr, 0, 0, GetVkImageLayout(old_layout),
+	barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr, 0, 0, GetVkImageLayout(old_layout),
 		GetVkImageLayout(new_layout), VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_image,
 		{aspect, static_cast<u32>(start_level), static_cast<u32>(num_levels), 0u, 1u}};
 
 	// srcStageMask -> Stages that must complete before the barrier
 	// dstStageMask -> Stages that must wait for after the barrier before beginning
-	VkPipelineStageFlags srcStageMask, dstStageMask;
 	switch (old_layout)
 	{
 		case Layout::Undefined:
@@ -733,7 +792,6 @@ void GSTextureVK::TransitionSubresourcesToLayout(
 			dstStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
 			break;
 	}
-	vkCmdPipelineBarrier(command_buffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
 }
 
 VkFramebuffer GSTextureVK::GetFramebuffer(bool feedback_loop)
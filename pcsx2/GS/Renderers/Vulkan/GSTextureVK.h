@@ -88,6 +88,13 @@ private:
 	void UpdateFromBuffer(VkCommandBuffer cmdbuf, int level, u32 x, u32 y, u32 width, u32 height, u32 buffer_height,
 		u32 row_length, VkBuffer buffer, u32 buffer_offset);
 
+	// Uploads which would go to the init command buffer are batched by the device instead.
+	bool CanBatchUpload() const;
+	void QueueBatchedUpload(int level, u32 x, u32 y, u32 width, u32 height, u32 buffer_height, u32 row_length,
+		VkBuffer buffer, u32 buffer_offset);
+	void GetLayoutBarrier(int start_level, int num_levels, Layout old_layout, Layout new_layout,
+		VkImageMemoryBarrier& barrier, VkPipelineStageFlags& srcStageMask, VkPipelineStageFlags& dstStageMask) const;
+
 	VkImage m_image = VK_NULL_HANDLE;
 	VmaAllocation m_allocation = VK_NULL_HANDLE;
 	VkImageView m_view = VK_NULL_HANDLE;
@@ -98,6 +105,9 @@ private:
 	// When this matches the current fence counter, the texture was used this command buffer.
 	u64 m_use_fence_counter = 0;
 
+	// Upload batch counter of the device when this texture's barriers were added to the batch.
+	u64 m_upload_batch = 0;
+
 	int m_map_level = std::numeric_limits<int>::max();
 	GSVector4i m_map_area = GSVector4i::zero();
 
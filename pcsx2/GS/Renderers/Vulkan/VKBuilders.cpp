@@ -264,6 +264,13 @@ void Vulkan::GraphicsPipelineBuilder::Clear()
 	m_line_rasterization_state = {};
 	m_line_rasterization_state.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_LINE_STATE_CREATE_INFO_EXT;
 
+	m_library_state = {};
+	m_library_state.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+
+	m_library_link_state = {};
+	m_library_link_state.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+	m_libraries = {};
+
 	// set defaults
 	SetNoCullRasterizationState();
 	SetNoDepthTestState();
@@ -279,8 +286,28 @@ void Vulkan::GraphicsPipelineBuilder::Clear()
 VkPipeline Vulkan::GraphicsPipelineBuilder::Create(
 	VkDevice device, VkPipelineCache pipeline_cache, bool clear /* = true */)
 {
+	// Libraries can only contain the shader stages which belong to the state subsets they're built with.
+	VkGraphicsPipelineCreateInfo ci = m_ci;
+	std::array<VkPipelineShaderStageCreateInfo, MAX_SHADER_STAGES> library_stages;
+	if (m_library_state.flags != 0)
+	{
+		ci.stageCount = 0;
+		ci.pStages = library_stages.data();
+		for (u32 i = 0; i < m_ci.stageCount; i++)
+		{
+			const VkGraphicsPipelineLibraryFlagsEXT required_flag =
+				(m_shader_stages[i].stage == VK_SHADER_STAGE_FRAGMENT_BIT) ?
+					VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT :
+					VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+			if (m_library_state.flags & required_flag)
+				library_stages[ci.stageCount++] = m_shader_stages[i];
+		}
+		if (ci.stageCount == 0)
+			ci.pStages = nullptr;
+	}
+
 	VkPipeline pipeline;
-	VkResult res = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &m_ci, nullptr, &pipeline);
+	VkResult res = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &ci, nullptr, &pipeline);
 	if (res != VK_SUCCESS)
 	{
 		LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines() failed: ");
@@ -571,6 +598,31 @@ void Vulkan::GraphicsPipelineBuilder::SetProvokingVertex(VkProvokingVertexModeEX
 	m_provoking_vertex.provokingVertexMode = mode;
 }
 
+void Vulkan::GraphicsPipelineBuilder::AddPipelineFlags(VkPipelineCreateFlags flags)
+{
+	m_ci.flags |= flags;
+}
+
+void Vulkan::GraphicsPipelineBuilder::SetLibraryFlags(VkGraphicsPipelineLibraryFlagsEXT flags)
+{
+	if (m_library_state.flags == 0)
+		AddPointerToChain(&m_ci, &m_library_state);
+
+	m_library_state.flags = flags;
+	m_ci.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+}
+
+void Vulkan::GraphicsPipelineBuilder::AddPipelineLibrary(VkPipeline library)
+{
+	pxAssert(m_library_link_state.libraryCount < MAX_PIPELINE_LIBRARIES);
+
+	if (m_library_link_state.libraryCount == 0)
+		AddPointerToChain(&m_ci, &m_library_link_state);
+
+	m_libraries[m_library_link_state.libraryCount++] = library;
+	m_library_link_state.pLibraries = m_libraries.data();
+}
+
 Vulkan::ComputePipelineBuilder::ComputePipelineBuilder()
 {
 	Clear();
@@ -81,7 +81,8 @@ namespace Vulkan
 			MAX_VERTEX_ATTRIBUTES = 16,
 			MAX_VERTEX_BUFFERS = 8,
 			MAX_ATTACHMENTS = 2,
-			MAX_DYNAMIC_STATE = 8
+			MAX_DYNAMIC_STATE = 8,
+			MAX_PIPELINE_LIBRARIES = 4
 		};
 
 		GraphicsPipelineBuilder();
@@ -141,6 +142,14 @@ namespace Vulkan
 
 		void SetProvokingVertex(VkProvokingVertexModeEXT mode);
 
+		void AddPipelineFlags(VkPipelineCreateFlags flags);
+
+		/// Creates a pipeline library containing only the specified state subsets, instead of a complete pipeline.
+		void SetLibraryFlags(VkGraphicsPipelineLibraryFlagsEXT flags);
+
+		/// Links the pipeline from previously-created libraries.
+		void AddPipelineLibrary(VkPipeline library);
+
 	private:
 		VkGraphicsPipelineCreateInfo m_ci;
 		std::array<VkPipelineShaderStageCreateInfo, MAX_SHADER_STAGES> m_shader_stages;
@@ -168,6 +177,10 @@ namespace Vulkan
 
 		VkPipelineRasterizationProvokingVertexStateCreateInfoEXT m_provoking_vertex;
 		VkPipelineRasterizationLineStateCreateInfoEXT m_line_rasterization_state;
+
+		VkGraphicsPipelineLibraryCreateInfoEXT m_library_state;
+		VkPipelineLibraryCreateInfoKHR m_library_link_state;
+		std::array<VkPipeline, MAX_PIPELINE_LIBRARIES> m_libraries;
 	};
 
 	class ComputePipelineBuilder
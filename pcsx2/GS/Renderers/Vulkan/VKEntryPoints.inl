@@ -222,6 +222,8 @@ VULKAN_DEVICE_ENTRY_POINT(vkGetBufferMemoryRequirements2, true)
 VULKAN_DEVICE_ENTRY_POINT(vkGetImageMemoryRequirements2, true)
 VULKAN_DEVICE_ENTRY_POINT(vkBindBufferMemory2, true)
 VULKAN_DEVICE_ENTRY_POINT(vkBindImageMemory2, true)
+VULKAN_DEVICE_ENTRY_POINT(vkCreateDescriptorUpdateTemplate, true)
+VULKAN_DEVICE_ENTRY_POINT(vkDestroyDescriptorUpdateTemplate, true)
 
 // Vulkan 1.3 functions.
 VULKAN_DEVICE_ENTRY_POINT(vkGetDeviceBufferMemoryRequirements, false)
@@ -237,6 +239,7 @@ VULKAN_DEVICE_ENTRY_POINT(vkGetCalibratedTimestampsEXT, false)
 
 // VK_KHR_push_descriptor
 VULKAN_DEVICE_ENTRY_POINT(vkCmdPushDescriptorSetKHR, false)
+VULKAN_DEVICE_ENTRY_POINT(vkCmdPushDescriptorSetWithTemplateKHR, false)
 
 // VK_EXT_swapchain_maintenance1
 VULKAN_DEVICE_ENTRY_POINT(vkReleaseSwapchainImagesEXT, false)
@@ -16,6 +16,7 @@
 #include "common/FileSystem.h"
 #include "common/MD5Digest.h"
 #include "common/Path.h"
+#include "common/Timer.h"
 
 #include "fmt/format.h"
 #include "shaderc/shaderc.h"
@@ -318,6 +319,20 @@ void VKShaderCache::Open()
 		const std::string index_filename = base_filename + ".idx";
 		const std::string blob_filename = base_filename + ".bin";
 
+		if (GSConfig.ReadOnlyShaderCache)
+		{
+			// Shared between several processes, never write back or replace anything.
+			if (!ReadExistingShaderCache(index_filename, blob_filename))
+				Console.Warning("Read-only shader cache is missing or invalid, continuing without it.");
+
+			const bool has_pipeline_cache = ReadExistingPipelineCache();
+			m_pipeline_cache_filename = {};
+			if (!has_pipeline_cache)
+				CreateNewPipelineCache();
+
+			return;
+		}
+
 		if (!ReadExistingShaderCache(index_filename, blob_filename))
 			CreateNewShaderCache(index_filename, blob_filename);
 
@@ -352,7 +367,7 @@ bool VKShaderCache::CreateNewShaderCache(const std::string& index_filename, cons
 		FileSystem::DeleteFilePath(blob_filename.c_str());
 	}
 
-	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "wb");
+	m_index_file = FileSystem::OpenSharedCFile(index_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_index_file)
 	{
 		Console.Error("Failed to open index file '%s' for writing", index_filename.c_str());
@@ -373,7 +388,7 @@ bool VKShaderCache::CreateNewShaderCache(const std::string& index_filename, cons
 		return false;
 	}
 
-	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "w+b");
+	m_blob_file = FileSystem::OpenSharedCFile(blob_filename.c_str(), "w+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_blob_file)
 	{
 		Console.Error("Failed to open blob file '%s' for writing", blob_filename.c_str());
@@ -383,12 +398,17 @@ bool VKShaderCache::CreateNewShaderCache(const std::string& index_filename, cons
 		return false;
 	}
 
+	m_index_read_pos = FileSystem::FTell64(m_index_file);
 	return true;
 }
 
 bool VKShaderCache::ReadExistingShaderCache(const std::string& index_filename, const std::string& blob_filename)
 {
-	m_index_file = FileSystem::OpenCFile(index_filename.c_str(), "r+b");
+	const bool read_only = GSConfig.ReadOnlyShaderCache;
+	// Writable caches can be shared by several instances, see CompileAndAddShaderSPV().
+	m_index_file = read_only ?
+					   FileSystem::OpenSharedCFile(index_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					   FileSystem::OpenSharedCFile(index_filename.c_str(), "r+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_index_file)
 	{
 		// special case here: when there's a sharing violation (i.e. two instances running),
@@ -420,7 +440,9 @@ bool VKShaderCache::ReadExistingShaderCache(const std::string& index_filename, c
 		return false;
 	}
 
-	m_blob_file = FileSystem::OpenCFile(blob_filename.c_str(), "a+b");
+	m_blob_file = read_only ?
+					  FileSystem::OpenSharedCFile(blob_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite) :
+					  FileSystem::OpenSharedCFile(blob_filename.c_str(), "a+b", FileSystem::FileShareMode::DenyNone);
 	if (!m_blob_file)
 	{
 		Console.Error("Blob file '%s' is missing", blob_filename.c_str());
@@ -429,37 +451,53 @@ bool VKShaderCache::ReadExistingShaderCache(const std::string& index_filename, c
 		return false;
 	}
 
-	std::fseek(m_blob_file, 0, SEEK_END);
-	const u32 blob_file_size = static_cast<u32>(std::ftell(m_blob_file));
+	m_index_read_pos = FileSystem::FTell64(m_index_file);
+	if (!ReadNewIndexEntries())
+	{
+		Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
+		m_index.clear();
+		std::fclose(m_blob_file);
+		m_blob_file = nullptr;
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+		return false;
+	}
+
+	if (read_only)
+	{
+		// new shaders won't be added, so the index isn't needed past this point
+		std::fclose(m_index_file);
+		m_index_file = nullptr;
+	}
+
+	Console.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
+	return true;
+}
+
+bool VKShaderCache::ReadNewIndexEntries()
+{
+	if (FileSystem::FSeek64(m_index_file, m_index_read_pos, SEEK_SET) != 0)
+		return false;
+
+	const s64 blob_file_size = FileSystem::FSize64(m_blob_file);
 
 	for (;;)
 	{
 		CacheIndexEntry entry;
-		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1 ||
-			(entry.file_offset + entry.blob_size) > blob_file_size)
+		if (std::fread(&entry, sizeof(entry), 1, m_index_file) != 1)
 		{
-			if (std::feof(m_index_file))
-				break;
-
-			Console.Error("Failed to read entry from '%s', corrupt file?", index_filename.c_str());
-			m_index.clear();
-			std::fclose(m_blob_file);
-			m_blob_file = nullptr;
-			std::fclose(m_index_file);
-			m_index_file = nullptr;
-			return false;
+			// A partial entry at the end is still being written by another instance.
+			return !std::ferror(m_index_file);
 		}
 
+		if ((static_cast<s64>(entry.file_offset) + entry.blob_size) > blob_file_size)
+			return false;
+
 		const CacheIndexKey key{entry.source_hash_low, entry.source_hash_high, entry.source_length, entry.shader_type};
 		const CacheIndexData data{entry.file_offset, entry.blob_size};
 		m_index.emplace(key, data);
+		m_index_read_pos += sizeof(entry);
 	}
-
-	// ensure we don't write before seeking
-	std::fseek(m_index_file, 0, SEEK_END);
-
-	Console.WriteLn("Read %zu entries from '%s'", m_index.size(), index_filename.c_str());
-	return true;
 }
 
 void VKShaderCache::CloseShaderCache()
@@ -553,10 +591,16 @@ bool VKShaderCache::FlushPipelineCache()
 	FILESYSTEM_STAT_DATA sd;
 	if (!FileSystem::StatFile(m_pipeline_cache_filename.c_str(), &sd) || sd.Size != static_cast<s64>(data_size))
 	{
+		// Other instances sharing the cache directory may be flushing at the same time, so write to a
+		// temporary file and rename it over the old one, readers then see either the old or the new cache.
 		Console.WriteLn("Writing %zu bytes to '%s'", data_size, m_pipeline_cache_filename.c_str());
-		if (!FileSystem::WriteBinaryFile(m_pipeline_cache_filename.c_str(), data.data(), data.size()))
+		const std::string temp_filename = fmt::format("{}.{:x}.tmp", m_pipeline_cache_filename,
+			static_cast<u64>(Common::Timer::GetCurrentValue()) ^ reinterpret_cast<uintptr_t>(this));
+		if (!FileSystem::WriteBinaryFile(temp_filename.c_str(), data.data(), data.size()) ||
+			!FileSystem::RenamePath(temp_filename.c_str(), m_pipeline_cache_filename.c_str()))
 		{
 			Console.Error("Failed to write pipeline cache to '%s'", m_pipeline_cache_filename.c_str());
+			FileSystem::DeleteFilePath(temp_filename.c_str());
 			return false;
 		}
 	}
@@ -625,7 +669,11 @@ std::optional<VKShaderCache::SPIRVCodeVector> VKShaderCache::GetShaderSPV(u32 ty
 	const auto key = GetCacheKey(type, shader_code);
 	auto iter = m_index.find(key);
 	if (iter == m_index.end())
-		return CompileAndAddShaderSPV(key, shader_code);
+	{
+		// Another instance sharing the cache might have compiled it already.
+		if (!m_index_file || !ReadNewIndexEntries() || (iter = m_index.find(key)) == m_index.end())
+			return CompileAndAddShaderSPV(key, shader_code);
+	}
 
 	std::optional<SPIRVCodeVector> spv = SPIRVCodeVector(iter->second.blob_size);
 
@@ -681,9 +729,18 @@ std::optional<VKShaderCache::SPIRVCodeVector> VKShaderCache::CompileAndAddShader
 	if (!spv.has_value())
 		return {};
 
-	if (!m_blob_file || std::fseek(m_blob_file, 0, SEEK_END) != 0)
+	if (!m_blob_file || !m_index_file)
 		return spv;
 
+	// Other instances append to the same files, so pick the blob offset and write both files under the lock.
+	// The blob goes first, readers don't take the lock and will only see the index entry once the data is there.
+	FileSystem::SharedFileLock lock(m_index_file);
+	if (!ReadNewIndexEntries() || m_index.find(key) != m_index.end() || std::fseek(m_blob_file, 0, SEEK_END) != 0 ||
+		FileSystem::FSeek64(m_index_file, m_index_read_pos, SEEK_SET) != 0)
+	{
+		return spv;
+	}
+
 	CacheIndexData data;
 	data.file_offset = static_cast<u32>(std::ftell(m_blob_file));
 	data.blob_size = static_cast<u32>(spv->size());
@@ -704,6 +761,7 @@ std::optional<VKShaderCache::SPIRVCodeVector> VKShaderCache::CompileAndAddShader
 		return spv;
 	}
 
+	m_index_read_pos += sizeof(entry);
 	m_index.emplace(key, data);
 	return spv;
 }
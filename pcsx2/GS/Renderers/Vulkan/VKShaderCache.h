@@ -79,6 +79,7 @@ private:
 
 	bool CreateNewShaderCache(const std::string& index_filename, const std::string& blob_filename);
 	bool ReadExistingShaderCache(const std::string& index_filename, const std::string& blob_filename);
+	bool ReadNewIndexEntries();
 	void CloseShaderCache();
 
 	bool CreateNewPipelineCache();
@@ -91,6 +92,7 @@ private:
 
 	std::FILE* m_index_file = nullptr;
 	std::FILE* m_blob_file = nullptr;
+	s64 m_index_read_pos = 0; ///< End of the last complete index entry, other instances may append past it.
 	std::string m_pipeline_cache_filename;
 
 	CacheIndex m_index;
@@ -364,6 +364,28 @@ bool VKSwapChain::CreateSwapChain()
 		return false;
 	}
 
+	// With VK_EXT_swapchain_maintenance1, find the present modes we can switch to later without recreating.
+	m_compatible_present_modes.clear();
+	if (GSDeviceVK::GetInstance()->GetOptionalExtensions().vk_ext_swapchain_maintenance1 &&
+		vkGetPhysicalDeviceSurfaceCapabilities2KHR)
+	{
+		VkSurfacePresentModeEXT present_mode_info = {VK_STRUCTURE_TYPE_SURFACE_PRESENT_MODE_EXT, nullptr, m_present_mode};
+		const VkPhysicalDeviceSurfaceInfo2KHR surface_info = {
+			VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SURFACE_INFO_2_KHR, &present_mode_info, m_surface};
+		VkSurfacePresentModeCompatibilityEXT compatibility = {VK_STRUCTURE_TYPE_SURFACE_PRESENT_MODE_COMPATIBILITY_EXT};
+		VkSurfaceCapabilities2KHR capabilities2 = {VK_STRUCTURE_TYPE_SURFACE_CAPABILITIES_2_KHR, &compatibility};
+		res = vkGetPhysicalDeviceSurfaceCapabilities2KHR(
+			GSDeviceVK::GetInstance()->GetPhysicalDevice(), &surface_info, &capabilities2);
+		if (res == VK_SUCCESS && compatibility.presentModeCount > 0)
+		{
+			m_compatible_present_modes.resize(compatibility.presentModeCount);
+			compatibility.pPresentModes = m_compatible_present_modes.data();
+			res = vkGetPhysicalDeviceSurfaceCapabilities2KHR(
+				GSDeviceVK::GetInstance()->GetPhysicalDevice(), &surface_info, &capabilities2);
+			m_compatible_present_modes.resize((res == VK_SUCCESS) ? compatibility.presentModeCount : 0);
+		}
+	}
+
 	// Store the old/current swap chain when recreating for resize
 	// Old swap chain is destroyed regardless of whether the create call succeeds
 	VkSwapchainKHR old_swap_chain = m_swap_chain;
@@ -415,6 +437,11 @@ bool VKSwapChain::CreateSwapChain()
 		Console.Error("Exclusive fullscreen control requested, but is not supported on this platform.");
 #endif
 
+	const VkSwapchainPresentModesCreateInfoEXT present_modes_info = {VK_STRUCTURE_TYPE_SWAPCHAIN_PRESENT_MODES_CREATE_INFO_EXT,
+		nullptr, static_cast<u32>(m_compatible_present_modes.size()), m_compatible_present_modes.data()};
+	if (!m_compatible_present_modes.empty())
+		Vulkan::AddPointerToChain(&swap_chain_info, &present_modes_info);
+
 	res = vkCreateSwapchainKHR(GSDeviceVK::GetInstance()->GetDevice(), &swap_chain_info, nullptr, &m_swap_chain);
 	if (res != VK_SUCCESS)
 	{
@@ -597,7 +624,14 @@ bool VKSwapChain::SetPresentMode(VkPresentModeKHR present_mode)
 	if (m_present_mode == present_mode)
 		return true;
 
+	// No need to recreate if we can just pass the new mode to vkQueuePresentKHR().
+	const bool can_switch = CanSwitchPresentMode(present_mode);
 	m_present_mode = present_mode;
+	if (can_switch)
+	{
+		DEV_LOG("Switching swap chain present mode to {}", PresentModeToString(m_present_mode));
+		return true;
+	}
 
 	// Recreate the swap chain with the new present mode.
 	INFO_LOG("Recreating swap chain to change present mode.");
@@ -612,6 +646,12 @@ bool VKSwapChain::SetPresentMode(VkPresentModeKHR present_mode)
 	return true;
 }
 
+bool VKSwapChain::CanSwitchPresentMode(VkPresentModeKHR present_mode) const
+{
+	return std::find(m_compatible_present_modes.begin(), m_compatible_present_modes.end(), present_mode) !=
+		   m_compatible_present_modes.end();
+}
+
 bool VKSwapChain::RecreateSurface(const WindowInfo& new_wi)
 {
 	// Destroy the old swap chain, images, and surface.
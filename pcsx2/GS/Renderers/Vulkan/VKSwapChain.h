@@ -73,8 +73,12 @@ public:
 	bool RecreateSurface(const WindowInfo& new_wi);
 	bool ResizeSwapChain(u32 new_width = 0, u32 new_height = 0, float new_scale = 1.0f);
 
-	// Change vsync enabled state. This may fail as it causes a swapchain recreation.
+	// Change vsync enabled state. This may fail as it causes a swapchain recreation, unless the swap chain was
+	// created with the mode as a compatible mode (VK_EXT_swapchain_maintenance1), where it's switched at present.
 	bool SetPresentMode(VkPresentModeKHR present_mode);
+	bool CanSwitchPresentMode(VkPresentModeKHR present_mode) const;
+	__fi bool HasCompatiblePresentModes() const { return !m_compatible_present_modes.empty(); }
+	__fi const VkPresentModeKHR* GetPresentModePtr() const { return &m_present_mode; }
 
 private:
 	VKSwapChain(const WindowInfo& wi, VkSurfaceKHR surface, VkPresentModeKHR present_mode,
@@ -106,6 +110,7 @@ private:
 	u32 m_current_semaphore = 0;
 
 	VkPresentModeKHR m_present_mode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+	std::vector<VkPresentModeKHR> m_compatible_present_modes;
 
 	std::optional<VkResult> m_image_acquire_result;
 	std::optional<bool> m_exclusive_fullscreen_control;
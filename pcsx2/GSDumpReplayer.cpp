@@ -36,9 +36,9 @@ static void GSDumpReplayerCpuExecute();
 static void GSDumpReplayerExitExecution();
 static void GSDumpReplayerCancelInstruction();
 static void GSDumpReplayerCpuClear(u32 addr, u32 size);
+static void GSDumpReplayerCpuClearWrittenPage(u32 page_addr, u32 write_addr);
 
 static std::unique_ptr<GSDumpFile> s_dump_file;
-static u32 s_current_packet = 0;
 static u32 s_dump_frame_number = 0;
 static s32 s_dump_loop_count = 0;
 static bool s_dump_running = false;
@@ -55,7 +55,8 @@ R5900cpu GSDumpReplayerCpu = {
 	GSDumpReplayerCpuExecute,
 	GSDumpReplayerExitExecution,
 	GSDumpReplayerCancelInstruction,
-	GSDumpReplayerCpuClear};
+	GSDumpReplayerCpuClear,
+	GSDumpReplayerCpuClearWrittenPage};
 
 static InterpVU0 gsDumpVU0;
 static InterpVU1 gsDumpVU1;
@@ -100,7 +101,7 @@ bool GSDumpReplayer::Initialize(const char* filename)
 		return false;
 	}
 
-	Console.WriteLn("(GSDumpReplayer) Read file in %.2f ms.", timer.GetTimeMilliseconds());
+	Console.WriteLn("(GSDumpReplayer) Read header in %.2f ms.", timer.GetTimeMilliseconds());
 
 	// We replace all CPUs.
 	Cpu = &GSDumpReplayerCpu;
@@ -134,7 +135,6 @@ bool GSDumpReplayer::ChangeDump(const char* filename)
 	}
 
 	s_dump_file = std::move(new_dump);
-	s_current_packet = 0;
 
 	// Don't forget to reset the GS!
 	GSDumpReplayerCpuReset();
@@ -194,8 +194,9 @@ void GSDumpReplayerCpuShutdown()
 void GSDumpReplayerCpuReset()
 {
 	s_needs_state_loaded = true;
-	s_current_packet = 0;
 	s_dump_frame_number = 0;
+	if (s_dump_file && !s_dump_file->SeekToFrame(0))
+		Host::ReportErrorAsync("GSDumpReplayer", "Failed to rewind dump.");
 }
 
 static void GSDumpReplayerLoadInitialState()
@@ -262,10 +263,10 @@ void GSDumpReplayerCpuStep()
 		s_needs_state_loaded = false;
 	}
 
-	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
-	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPackets().size());
-	if (s_current_packet == 0)
+	const GSDumpFile::GSData* next_packet = s_dump_file->GetNextPacket();
+	if (!next_packet)
 	{
+		// Loop back around to the start, without reloading the state.
 		s_dump_frame_number = 0;
 		if (s_dump_loop_count > 0)
 			s_dump_loop_count--;
@@ -273,9 +274,20 @@ void GSDumpReplayerCpuStep()
 		{
 			Host::RequestVMShutdown(false, false, false);
 			s_dump_running = false;
+			return;
+		}
+
+		if (!s_dump_file->SeekToFrame(0) || !(next_packet = s_dump_file->GetNextPacket()))
+		{
+			Host::ReportErrorAsync("GSDumpReplayer", "Failed to read packets from dump.");
+			Host::RequestVMShutdown(false, false, false);
+			s_dump_running = false;
+			return;
 		}
 	}
 
+	const GSDumpFile::GSData& packet = *next_packet;
+
 	switch (packet.id)
 	{
 		case GSDumpTypes::GSType::Transfer:
@@ -362,6 +374,10 @@ void GSDumpReplayerCpuClear(u32 addr, u32 size)
 {
 }
 
+void GSDumpReplayerCpuClearWrittenPage(u32 page_addr, u32 write_addr)
+{
+}
+
 void GSDumpReplayer::RenderUI()
 {
 	const float scale = ImGuiManager::GetGlobalScale();
@@ -388,11 +404,16 @@ void GSDumpReplayer::RenderUI()
 		position_y += text_size.y + spacing; \
 	} while (0)
 
+	// Totals aren't known for dumps without an index until they've been played through.
 	fmt::format_to(std::back_inserter(text), "Dump Frame: {}", s_dump_frame_number);
+	if (const u32 frame_count = s_dump_file->GetFrameCount(); frame_count > 0)
+		fmt::format_to(std::back_inserter(text), "/{}", frame_count);
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 	text.clear();
-	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, static_cast<u32>(s_dump_file->GetPackets().size()));
+	fmt::format_to(std::back_inserter(text), "Packet Number: {}", s_dump_file->GetCurrentPacket());
+	if (const u32 packet_count = s_dump_file->GetPacketCount(); packet_count > 0)
+		fmt::format_to(std::back_inserter(text), "/{}", packet_count);
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 #undef DRAW_LINE
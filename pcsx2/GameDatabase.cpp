@@ -20,7 +20,9 @@
 #include "ryml.hpp"
 #include "fmt/format.h"
 #include "fmt/ranges.h"
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <mutex>
 #include <optional>
 
@@ -33,13 +35,39 @@ namespace GameDatabaseSchema
 
 namespace GameDatabase
 {
+	struct IndexEntry
+	{
+		u32 offset;
+		u32 size;
+	};
+
+#pragma pack(push, 1)
+	struct IndexCacheHeader
+	{
+		u32 signature;
+		u32 version;
+		u32 num_entries;
+		u64 yaml_size;
+		u64 yaml_modification_time;
+	};
+#pragma pack(pop)
+
 	static void parseAndInsert(const std::string_view serial, const ryml::NodeRef& node);
+	static bool loadIndexCache(const FILESYSTEM_STAT_DATA& yaml_sd);
+	static void saveIndexCache(const FILESYSTEM_STAT_DATA& yaml_sd);
+	static void buildIndex(const std::string_view yaml);
 	static void initDatabase();
+	static const GameDatabaseSchema::GameEntry* loadEntry(const std::string& serial, const IndexEntry& entry);
 } // namespace GameDatabase
 
 static constexpr char GAMEDB_YAML_FILE_NAME[] = "GameIndex.yaml";
+static constexpr u32 GAMEDB_INDEX_CACHE_SIGNATURE = 0x58444247; // GBDX
+static constexpr u32 GAMEDB_INDEX_CACHE_VERSION = 1;
 
+// Byte ranges of each entry in the YAML file, entries are only parsed into s_game_db when looked up.
+static std::unordered_map<std::string, GameDatabase::IndexEntry> s_game_index;
 static std::unordered_map<std::string, GameDatabaseSchema::GameEntry> s_game_db;
+static std::mutex s_game_db_mutex;
 static std::once_flag s_load_once_flag;
 
 std::string GameDatabaseSchema::GameEntry::memcardFiltersAsString() const
@@ -235,7 +263,11 @@ void GameDatabase::parseAndInsert(const std::string_view serial, const ryml::Nod
 				std::none_of(gameEntry.speedHacks.begin(), gameEntry.speedHacks.end(),
 					[&id](const auto& it) { return it.first == id.value(); }))
 			{
-				gameEntry.speedHacks.emplace_back(id.value(), value.value());
+				// Profiles go first, so individual speedhacks for the same game can override them.
+				if (id.value() == SpeedHack::TimingProfile)
+					gameEntry.speedHacks.emplace(gameEntry.speedHacks.begin(), id.value(), value.value());
+				else
+					gameEntry.speedHacks.emplace_back(id.value(), value.value());
 			}
 			else
 			{
@@ -550,6 +582,16 @@ void GameDatabaseSchema::GameEntry::applyGameFixes(Pcsx2Config& config, bool app
 		// Legacy note - speedhacks are setup in the GameDB as integer values, but
 		// are effectively booleans like the gamefixes
 		config.Speedhacks.Set(it.first, it.second);
+		if (it.first == SpeedHack::TimingProfile)
+		{
+			const EETimingProfile profile = static_cast<EETimingProfile>(
+				std::clamp(it.second, 0, static_cast<int>(EETimingProfile::MaxCount) - 1));
+			Console.WriteLn("GameDB: Applying EE timing profile '%s' [cycle rate=%d, cycle skip=%u, instant VU1=%d]",
+				Pcsx2Config::SpeedhackOptions::GetTimingProfileName(profile), config.Speedhacks.EECycleRate,
+				config.Speedhacks.EECycleSkip, config.Speedhacks.vu1Instant ? 1 : 0);
+			continue;
+		}
+
 		Console.WriteLn("GameDB: Setting Speedhack '%s' to [mode=%d]",
 			Pcsx2Config::SpeedhackOptions::GetSpeedHackName(it.first), it.second);
 	}
@@ -939,7 +981,7 @@ void GameDatabaseSchema::GameEntry::applyGSHardwareFixes(Pcsx2Config::GSOptions&
 	}
 }
 
-void GameDatabase::initDatabase()
+static void setYamlCallbacks()
 {
 	ryml::Callbacks rymlCallbacks = ryml::get_callbacks();
 	rymlCallbacks.m_error = [](const char* msg, size_t msg_len, ryml::Location loc, void* userdata) {
@@ -950,38 +992,188 @@ void GameDatabase::initDatabase()
 	ryml::set_error_callback([](const char* msg, size_t msg_size) {
 		Console.Error(fmt::format("[GameDB YAML] Internal Parsing error: {}", std::string_view(msg, msg_size)));
 	});
+}
 
-	auto buf = FileSystem::ReadFileToString(Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME).c_str());
-	if (!buf.has_value())
+static std::string getIndexCacheFilename()
+{
+	return EmuFolders::Cache.empty() ? std::string() : Path::Combine(EmuFolders::Cache, "gamedb.cache");
+}
+
+bool GameDatabase::loadIndexCache(const FILESYSTEM_STAT_DATA& yaml_sd)
+{
+	const std::string filename = getIndexCacheFilename();
+	if (filename.empty())
+		return false;
+
+	const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(filename.c_str());
+	if (!data.has_value() || data->size() < sizeof(IndexCacheHeader))
+		return false;
+
+	IndexCacheHeader header;
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.signature != GAMEDB_INDEX_CACHE_SIGNATURE || header.version != GAMEDB_INDEX_CACHE_VERSION ||
+		header.yaml_size != static_cast<u64>(yaml_sd.Size) ||
+		header.yaml_modification_time != static_cast<u64>(yaml_sd.ModificationTime))
 	{
-		Console.Error("GameDB: Unable to open GameDB file, file does not exist.");
-		return;
+		return false;
 	}
 
-	ryml::Tree tree = ryml::parse_in_arena(ryml::to_csubstr(buf.value()));
-	ryml::NodeRef root = tree.rootref();
+	size_t pos = sizeof(header);
+	s_game_index.reserve(header.num_entries);
+	for (u32 i = 0; i < header.num_entries; i++)
+	{
+		IndexEntry entry;
+		u8 serial_length;
+		if ((data->size() - pos) < (sizeof(entry) + sizeof(serial_length)))
+			break;
+		std::memcpy(&entry, data->data() + pos, sizeof(entry));
+		serial_length = (*data)[pos + sizeof(entry)];
+		pos += sizeof(entry) + sizeof(serial_length);
+		if ((data->size() - pos) < serial_length)
+			break;
 
-	for (const ryml::NodeRef& n : root.children())
+		s_game_index.emplace(std::string(reinterpret_cast<const char*>(data->data() + pos), serial_length), entry);
+		pos += serial_length;
+	}
+
+	if (s_game_index.size() != header.num_entries || pos != data->size())
 	{
-		auto serial = StringUtil::toLower(std::string(n.key().str, n.key().len));
+		Console.Warning("GameDB: Index cache is corrupted, rebuilding.");
+		s_game_index.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void GameDatabase::saveIndexCache(const FILESYSTEM_STAT_DATA& yaml_sd)
+{
+	const std::string filename = getIndexCacheFilename();
+	if (filename.empty())
+		return;
+
+	IndexCacheHeader header;
+	header.signature = GAMEDB_INDEX_CACHE_SIGNATURE;
+	header.version = GAMEDB_INDEX_CACHE_VERSION;
+	header.num_entries = static_cast<u32>(s_game_index.size());
+	header.yaml_size = static_cast<u64>(yaml_sd.Size);
+	header.yaml_modification_time = static_cast<u64>(yaml_sd.ModificationTime);
+
+	std::vector<u8> data(sizeof(header));
+	std::memcpy(data.data(), &header, sizeof(header));
+	for (const auto& [serial, entry] : s_game_index)
+	{
+		const u8* entry_bytes = reinterpret_cast<const u8*>(&entry);
+		data.insert(data.end(), entry_bytes, entry_bytes + sizeof(entry));
+		data.push_back(static_cast<u8>(serial.size()));
+		data.insert(data.end(), serial.begin(), serial.end());
+	}
+
+	if (!FileSystem::WriteBinaryFile(filename.c_str(), data.data(), data.size()))
+		Console.Warning("GameDB: Failed to write index cache.");
+}
+
+void GameDatabase::buildIndex(const std::string_view yaml)
+{
+	// Every entry is a top-level map keyed by its serial, so an entry starts at the first unindented line
+	// which isn't a comment, and runs until the next one. Only the entries which are looked up get parsed.
+	std::string serial;
+	u32 entry_start = 0;
+	bool has_entry = false;
+	const auto finish_entry = [&](size_t end) {
+		if (!has_entry)
+			return;
 
 		// Serials and CRCs must be inserted as lower-case, as that is how they are retrieved
 		// this is because the application may pass a lowercase CRC or serial along
 		//
 		// However, YAML's keys are as expected case-sensitive, so we have to explicitly do our own duplicate checking
-		if (s_game_db.count(serial) == 1)
-		{
+		if (!s_game_index.emplace(serial, IndexEntry{entry_start, static_cast<u32>(end - entry_start)}).second)
 			Console.Error(fmt::format("GameDB: Duplicate serial '{}' found in GameDB. Skipping, Serials are case-insensitive!", serial));
-			continue;
+	};
+
+	size_t pos = 0;
+	while (pos < yaml.size())
+	{
+		size_t line_end = yaml.find('\n', pos);
+		if (line_end == std::string_view::npos)
+			line_end = yaml.size();
+
+		const char first = yaml[pos];
+		if (first != ' ' && first != '\t' && first != '#' && first != '\r' && first != '\n')
+		{
+			const std::string_view line = yaml.substr(pos, line_end - pos);
+			const size_t colon = line.find(':');
+			if (colon != std::string_view::npos && colon > 0)
+			{
+				finish_entry(pos);
+
+				std::string_view key = StringUtil::StripWhitespace(line.substr(0, colon));
+				if (key.size() >= 2 && (key.front() == '"' || key.front() == '\'') && key.back() == key.front())
+					key = key.substr(1, key.size() - 2);
+
+				serial = StringUtil::toLower(key);
+				entry_start = static_cast<u32>(pos);
+				has_entry = (serial.size() <= std::numeric_limits<u8>::max());
+			}
 		}
 
+		pos = line_end + 1;
+	}
+
+	finish_entry(yaml.size());
+}
+
+void GameDatabase::initDatabase()
+{
+	const std::string path = Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME);
+	FILESYSTEM_STAT_DATA sd;
+	if (!FileSystem::StatFile(path.c_str(), &sd))
+	{
+		Console.Error("GameDB: Unable to open GameDB file, file does not exist.");
+		return;
+	}
+
+	if (loadIndexCache(sd))
+		return;
+
+	auto buf = FileSystem::ReadFileToString(path.c_str());
+	if (!buf.has_value())
+	{
+		Console.Error("GameDB: Unable to open GameDB file, file does not exist.");
+		return;
+	}
+
+	buildIndex(buf.value());
+	saveIndexCache(sd);
+}
+
+const GameDatabaseSchema::GameEntry* GameDatabase::loadEntry(const std::string& serial, const IndexEntry& entry)
+{
+	auto fp = FileSystem::OpenManagedCFile(Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME).c_str(), "rb");
+	std::string buf(entry.size, '\0');
+	if (!fp || FileSystem::FSeek64(fp.get(), entry.offset, SEEK_SET) != 0 ||
+		std::fread(buf.data(), entry.size, 1, fp.get()) != 1)
+	{
+		Console.Error(fmt::format("GameDB: Failed to read entry for '{}'.", serial));
+		return nullptr;
+	}
+
+	setYamlCallbacks();
+
+	ryml::Tree tree = ryml::parse_in_arena(ryml::to_csubstr(buf));
+	ryml::NodeRef root = tree.rootref();
+	for (const ryml::NodeRef& n : root.children())
+	{
 		if (n.is_map())
-		{
 			parseAndInsert(serial, n);
-		}
+		break;
 	}
 
 	ryml::reset_callbacks();
+
+	auto iter = s_game_db.find(serial);
+	return (iter != s_game_db.end()) ? &iter->second : nullptr;
 }
 
 void GameDatabase::ensureLoaded()
@@ -990,7 +1182,7 @@ void GameDatabase::ensureLoaded()
 		Common::Timer timer;
 		Console.WriteLn(fmt::format("GameDB: Has not been initialized yet, initializing..."));
 		initDatabase();
-		Console.WriteLn("GameDB: %zu games on record (loaded in %.2fms)", s_game_db.size(), timer.GetTimeMilliseconds());
+		Console.WriteLn("GameDB: %zu games on record (indexed in %.2fms)", s_game_index.size(), timer.GetTimeMilliseconds());
 	});
 }
 
@@ -998,8 +1190,22 @@ const GameDatabaseSchema::GameEntry* GameDatabase::findGame(const std::string_vi
 {
 	GameDatabase::ensureLoaded();
 
-	auto iter = s_game_db.find(StringUtil::toLower(serial));
-	return (iter != s_game_db.end()) ? &iter->second : nullptr;
+	const std::string lserial = StringUtil::toLower(serial);
+	std::unique_lock lock(s_game_db_mutex);
+	auto iter = s_game_db.find(lserial);
+	if (iter != s_game_db.end())
+		return &iter->second;
+
+	const auto index_iter = s_game_index.find(lserial);
+	if (index_iter == s_game_index.end())
+		return nullptr;
+
+	// Entries are parsed on first use, and stay in the map so returned pointers remain valid.
+	const GameDatabaseSchema::GameEntry* entry = loadEntry(lserial, index_iter->second);
+	if (!entry)
+		s_game_index.erase(index_iter);
+
+	return entry;
 }
 
 bool GameDatabase::TrackHash::parseHash(const std::string_view str)
@@ -63,7 +63,8 @@ namespace GameList
 
 	static bool GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry);
 	static void ScanDirectory(const char* path, bool recursive, bool only_cache, const std::vector<std::string>& excluded_paths,
-		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress);
+		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, UnorderedStringSet& seen_paths,
+		ProgressCallback* progress);
 	static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
 	static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
@@ -642,7 +643,8 @@ static bool IsPathExcluded(const std::vector<std::string>& excluded_paths, const
 }
 
 void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache, const std::vector<std::string>& excluded_paths,
-	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress)
+	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, UnorderedStringSet& seen_paths,
+	ProgressCallback* progress)
 {
 	Console.WriteLn("Scanning %s%s", path, recursive ? " (recursively)" : "");
 
@@ -674,8 +676,13 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 			continue;
 		}
 
+		// Paths are compared case-insensitively, the same as GetEntryForPath(), but without walking every
+		// entry found so far. Otherwise refreshing a large library is quadratic in the number of files.
+		if (!seen_paths.insert(StringUtil::toLower(ffd.FileName)).second)
+			continue;
+
 		std::unique_lock lock(s_mutex);
-		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
+		if (AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
 		{
 			continue;
 		}
@@ -844,6 +851,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 	const PlayedTimeMap played_time(LoadPlayedTimeMap(GetPlayedTimeFile()));
 	INISettingsInterface custom_attributes_ini(GetCustomPropertiesFile());
 	custom_attributes_ini.Load();
+	UnorderedStringSet seen_paths;
 
 	if (!dirs.empty() || !recursive_dirs.empty())
 	{
@@ -857,7 +865,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 			if (progress->IsCancelled())
 				break;
 
-			ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, played_time, custom_attributes_ini, progress);
+			ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, played_time, custom_attributes_ini, seen_paths, progress);
 			progress->SetProgressValue(++directory_counter);
 		}
 		for (const std::string& dir : recursive_dirs)
@@ -865,7 +873,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 			if (progress->IsCancelled())
 				break;
 
-			ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, played_time, custom_attributes_ini, progress);
+			ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, played_time, custom_attributes_ini, seen_paths, progress);
 			progress->SetProgressValue(++directory_counter);
 		}
 	}
@@ -1341,6 +1349,10 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
 		return false;
 	}
 
+	// Covers are small, so the time is mostly spent waiting on round trips. Keep a few in flight.
+	static constexpr u32 MAX_PARALLEL_COVER_DOWNLOADS = 4;
+	downloader->SetMaxActiveRequests(MAX_PARALLEL_COVER_DOWNLOADS);
+
 	progress->SetCancellable(true);
 	progress->SetProgressRange(static_cast<u32>(download_urls.size()));
 
@@ -1362,11 +1374,14 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
 			progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Downloading cover for {0} [{1}]..."), entry->title, entry->serial).c_str());
 		}
 
-		// we could actually do a few in parallel here...
+		downloader->WaitForRequestCountBelow(MAX_PARALLEL_COVER_DOWNLOADS);
+
 		std::string filename = Path::URLDecode(url);
 		downloader->CreateRequest(
-			std::move(url), [use_serial, &save_callback, entry_path = std::move(entry_path), filename = std::move(filename)](
+			std::move(url), [use_serial, progress, &save_callback, entry_path = std::move(entry_path), filename = std::move(filename)](
 								s32 status_code, const std::string& content_type, HTTPDownloader::Request::Data data) {
+				progress->IncrementProgressValue();
+
 				if (status_code != HTTPDownloader::HTTP_STATUS_OK || data.empty())
 					return;
 
@@ -1397,10 +1412,9 @@ bool GameList::DownloadCovers(const std::vector<std::string>& url_templates, boo
 				if (FileSystem::WriteBinaryFile(write_path.c_str(), data.data(), data.size()) && save_callback)
 					save_callback(entry, std::move(write_path));
 			});
-		downloader->WaitForAllRequests();
-		progress->IncrementProgressValue();
 	}
 
+	downloader->WaitForAllRequests();
 	return true;
 }
 
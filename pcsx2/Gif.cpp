@@ -304,7 +304,10 @@ static u32 WRITERING_DMA(u32* pMem, u32 qwc)
 {
 	const u32 originalQwc = qwc;
 
-	if (gifRegs.stat.IMT)
+	// When nothing else could observe the difference, the whole tag is transferred at once.
+	const bool batch = dmacCanBatchTransfer(DMAC_GIF);
+
+	if (gifRegs.stat.IMT && !batch)
 	{
 		// Splitting by 8qw can be really slow, so on bigger packets be less picky.
 		// Games seem to be more concerned with other channels finishing before PATH 3 finishes
@@ -317,7 +320,7 @@ static u32 WRITERING_DMA(u32* pMem, u32 qwc)
 	}
 	// If the packet is larger than 8qw, try to time the packet somewhat so any "finish" signals don't fire way too early and GIF syncs with other units.
 	// (Mana Khemia exhibits flickering characters without).
-	else if (qwc > 8)
+	else if (qwc > 8 && !batch)
 		qwc -= 8;
 
 	uint size;
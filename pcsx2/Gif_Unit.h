@@ -313,7 +313,10 @@ struct Gif_Path
 
 	void CopyGSPacketData(u8* pMem, u32 size, bool aligned = false)
 	{
-		if (curSize + size > buffSize)
+		// Data which would end past the wrap limit gets moved to the front again by ExecuteGSPacket,
+		// so wrap first unless the partial packet is bigger than the incoming data (large PATH3 uploads).
+		const u32 pendingSize = curSize - (curOffset - gsPack.size);
+		if (curSize + size > buffSize || (curSize + size > buffLimit && pendingSize < size))
 		{ // Move gsPack to front of buffer
 			GUNIT_LOG("CopyGSPacketData: Realigning packet!");
 			RealignPacket();
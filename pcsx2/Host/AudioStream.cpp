@@ -220,6 +220,38 @@ std::optional<AudioExpansionMode> AudioStream::ParseExpansionMode(const char* na
 	return std::nullopt;
 }
 
+static constexpr const std::array s_stretch_algorithm_names = {
+	"SoundTouch",
+	"Resample",
+};
+static constexpr const std::array s_stretch_algorithm_display_names = {
+	TRANSLATE_NOOP("AudioStream", "SoundTouch (Keeps Pitch)"),
+	TRANSLATE_NOOP("AudioStream", "Resample (Fast, Pitch Follows Speed)"),
+};
+
+const char* AudioStream::GetStretchAlgorithmName(AudioStretchAlgorithm algorithm)
+{
+	return (static_cast<u32>(algorithm) < s_stretch_algorithm_names.size()) ? s_stretch_algorithm_names[static_cast<u32>(algorithm)] : "";
+}
+
+const char* AudioStream::GetStretchAlgorithmDisplayName(AudioStretchAlgorithm algorithm)
+{
+	return (static_cast<u32>(algorithm) < s_stretch_algorithm_display_names.size()) ?
+			   Host::TranslateToCString("AudioStream", s_stretch_algorithm_display_names[static_cast<u32>(algorithm)]) :
+			   "";
+}
+
+std::optional<AudioStretchAlgorithm> AudioStream::ParseStretchAlgorithm(const char* name)
+{
+	for (u8 i = 0; i < static_cast<u8>(AudioStretchAlgorithm::Count); i++)
+	{
+		if (std::strcmp(name, s_stretch_algorithm_names[i]) == 0)
+			return static_cast<AudioStretchAlgorithm>(i);
+	}
+
+	return std::nullopt;
+}
+
 u32 AudioStream::GetBufferedFramesRelaxed() const
 {
 	const u32 rpos = m_rpos.load(std::memory_order_relaxed);
@@ -255,6 +287,7 @@ void AudioStream::ReadFrames(SampleType* samples, u32 num_frames)
 		silence_frames = frames_to_read - available_frames;
 		frames_to_read = available_frames;
 		m_filling = true;
+		m_underrun_count.fetch_add(1, std::memory_order_relaxed);
 
 		if (IsStretchEnabled())
 			StretchUnderrun();
@@ -422,6 +455,11 @@ void AudioStream::AllocateBuffer()
 	const u32 multiplier = IsStretchEnabled() ? 16 : 1;
 	m_buffer_size = GetAlignedBufferSize(((m_parameters.buffer_ms * multiplier) * m_sample_rate) / 1000);
 	m_target_buffer_size = GetAlignedBufferSize((m_sample_rate * m_parameters.buffer_ms) / 1000u);
+	m_adaptive_frames = 0;
+	m_adaptive_clean_intervals = 0;
+	m_adaptive_min_buffered = std::numeric_limits<u32>::max();
+	m_adaptive_underruns = m_underrun_count.load(std::memory_order_relaxed);
+	m_target_buffer_ms.store(GetMSForBufferSize(m_sample_rate, m_target_buffer_size), std::memory_order_relaxed);
 
 	m_buffer = std::make_unique<s16[]>(m_buffer_size * m_internal_channels);
 	m_staging_buffer = std::make_unique<s16[]>(CHUNK_SIZE * m_internal_channels);
@@ -458,9 +496,8 @@ void AudioStream::EmptyBuffer()
 
 	if (IsStretchEnabled())
 	{
-		m_soundtouch->clear();
-		if (IsStretchEnabled())
-			m_soundtouch->setTempo(m_nominal_rate);
+		StretchClear();
+		SetStretchTempo(m_nominal_rate);
 	}
 
 	m_wpos.store(m_rpos.load(std::memory_order_acquire), std::memory_order_release);
@@ -483,7 +520,7 @@ void AudioStream::UpdateTargetTempo(float tempo)
 	m_average_position = AVERAGING_WINDOW;
 	m_average_available = AVERAGING_WINDOW;
 	std::fill_n(m_average_fullness.data(), AVERAGING_WINDOW, tempo);
-	m_soundtouch->setTempo(tempo);
+	SetStretchTempo(tempo);
 	m_stretch_reset = 0;
 	m_stretch_inactive = false;
 	m_stretch_ok_count = 0;
@@ -671,18 +708,27 @@ void AudioStream::StretchAllocate()
 	if (!IsStretchEnabled())
 		return;
 
-	m_soundtouch = std::make_unique<soundtouch::SoundTouch>();
-	m_soundtouch->setSampleRate(m_sample_rate);
-	m_soundtouch->setChannels(m_internal_channels);
+	if (m_parameters.stretch_algorithm == AudioStretchAlgorithm::SoundTouch)
+	{
+		m_soundtouch = std::make_unique<soundtouch::SoundTouch>();
+		m_soundtouch->setSampleRate(m_sample_rate);
+		m_soundtouch->setChannels(m_internal_channels);
 
-	m_soundtouch->setSetting(SETTING_USE_QUICKSEEK, m_parameters.stretch_use_quickseek);
-	m_soundtouch->setSetting(SETTING_USE_AA_FILTER, m_parameters.stretch_use_aa_filter);
+		m_soundtouch->setSetting(SETTING_USE_QUICKSEEK, m_parameters.stretch_use_quickseek);
+		m_soundtouch->setSetting(SETTING_USE_AA_FILTER, m_parameters.stretch_use_aa_filter);
 
-	m_soundtouch->setSetting(SETTING_SEQUENCE_MS, m_parameters.stretch_sequence_length_ms);
-	m_soundtouch->setSetting(SETTING_SEEKWINDOW_MS, m_parameters.stretch_seekwindow_ms);
-	m_soundtouch->setSetting(SETTING_OVERLAP_MS, m_parameters.stretch_overlap_ms);
+		m_soundtouch->setSetting(SETTING_SEQUENCE_MS, m_parameters.stretch_sequence_length_ms);
+		m_soundtouch->setSetting(SETTING_SEEKWINDOW_MS, m_parameters.stretch_seekwindow_ms);
+		m_soundtouch->setSetting(SETTING_OVERLAP_MS, m_parameters.stretch_overlap_ms);
+	}
+	else
+	{
+		// The input block can be m_float_buffer, so the output needs its own buffer.
+		m_resample_buffer = std::make_unique<float[]>(CHUNK_SIZE * m_internal_channels);
+	}
 
-	m_soundtouch->setTempo(m_nominal_rate);
+	StretchClear();
+	SetStretchTempo(m_nominal_rate);
 
 	m_stretch_reset = STRETCH_RESET_THRESHOLD;
 	m_stretch_inactive = false;
@@ -697,23 +743,57 @@ void AudioStream::StretchAllocate()
 void AudioStream::StretchDestroy()
 {
 	m_soundtouch.reset();
+	m_resample_buffer.reset();
+}
+
+void AudioStream::StretchClear()
+{
+	if (m_soundtouch)
+	{
+		m_soundtouch->clear();
+	}
+	else
+	{
+		m_resample_pos = 0.0f;
+		m_resample_last.fill(0.0f);
+	}
+}
+
+void AudioStream::SetStretchTempo(float tempo)
+{
+	if (m_soundtouch)
+		m_soundtouch->setTempo(tempo);
+	else
+		m_resample_tempo = tempo;
 }
 
 void AudioStream::StretchWriteBlock(const float* block)
 {
 	if (IsStretchEnabled())
 	{
-		m_soundtouch->putSamples(block, CHUNK_SIZE);
+		if (m_soundtouch)
+		{
+			m_soundtouch->putSamples(block, CHUNK_SIZE);
 
-		u32 tempProgress;
-		while (tempProgress = m_soundtouch->receiveSamples(m_float_buffer.get(), CHUNK_SIZE), tempProgress != 0)
+			u32 tempProgress;
+			while (tempProgress = m_soundtouch->receiveSamples(m_float_buffer.get(), CHUNK_SIZE), tempProgress != 0)
+			{
+				FloatChunkToS16(m_staging_buffer.get(), m_float_buffer.get(), tempProgress * m_internal_channels);
+				InternalWriteFrames(m_staging_buffer.get(), tempProgress);
+			}
+		}
+		else
 		{
-			FloatChunkToS16(m_staging_buffer.get(), m_float_buffer.get(), tempProgress * m_internal_channels);
-			InternalWriteFrames(m_staging_buffer.get(), tempProgress);
+			ResampleWriteBlock(block);
 		}
 
 		if (IsStretchEnabled())
+		{
+			if (m_parameters.adaptive_buffer)
+				UpdateAdaptiveBufferTarget();
+
 			UpdateStretchTempo();
+		}
 	}
 	else
 	{
@@ -722,6 +802,49 @@ void AudioStream::StretchWriteBlock(const float* block)
 	}
 }
 
+void AudioStream::ResampleWriteBlock(const float* block)
+{
+	// Past this the pitch change gets silly, let the overrun/underrun handling catch up instead.
+	static constexpr float MIN_TEMPO = 0.5f;
+	static constexpr float MAX_TEMPO = 2.0f;
+
+	const u32 channels = m_internal_channels;
+	const float step = std::clamp(m_resample_tempo, MIN_TEMPO, MAX_TEMPO);
+	const float end = static_cast<float>(CHUNK_SIZE);
+	float* const out = m_resample_buffer.get();
+
+	// Position 0 is the last frame of the previous block, so every output frame has two input frames to blend.
+	float pos = m_resample_pos;
+	u32 out_frames = 0;
+	while (pos < end)
+	{
+		const u32 index = static_cast<u32>(pos);
+		const float frac = pos - static_cast<float>(index);
+		const float* const a = (index == 0) ? m_resample_last.data() : &block[(index - 1) * channels];
+		const float* const b = &block[index * channels];
+		float* const dst = &out[out_frames * channels];
+		for (u32 c = 0; c < channels; c++)
+			dst[c] = a[c] + (b[c] - a[c]) * frac;
+
+		pos += step;
+		if (++out_frames == CHUNK_SIZE)
+		{
+			FloatChunkToS16(m_staging_buffer.get(), out, CHUNK_SIZE * channels);
+			InternalWriteFrames(m_staging_buffer.get(), CHUNK_SIZE);
+			out_frames = 0;
+		}
+	}
+
+	if (out_frames > 0)
+	{
+		FloatChunkToS16(m_staging_buffer.get(), out, out_frames * channels);
+		InternalWriteFrames(m_staging_buffer.get(), out_frames);
+	}
+
+	m_resample_pos = pos - end;
+	std::memcpy(m_resample_last.data(), &block[(CHUNK_SIZE - 1) * channels], channels * sizeof(float));
+}
+
 float AudioStream::AddAndGetAverageTempo(float val)
 {
 	if (m_stretch_reset >= STRETCH_RESET_THRESHOLD)
@@ -830,12 +953,60 @@ void AudioStream::UpdateStretchTempo()
 		iterations++;
 	}
 
-	m_soundtouch->setTempo(tempo);
+	SetStretchTempo(tempo);
 
 	if (m_stretch_reset >= STRETCH_RESET_THRESHOLD)
 		m_stretch_reset = 0;
 }
 
+void AudioStream::UpdateAdaptiveBufferTarget()
+{
+	// Underruns, or the buffer running nearly dry, grow the target quickly. Clean intervals
+	// give the latency back one step at a time.
+	static constexpr float GROW_FACTOR = 1.5f;
+	static constexpr float JITTER_THRESHOLD = 0.25f;
+	static constexpr u32 CLEAN_INTERVALS_BEFORE_SHRINK = 2;
+
+	m_adaptive_min_buffered = std::min(m_adaptive_min_buffered, GetBufferedFramesRelaxed());
+	m_adaptive_frames += CHUNK_SIZE;
+	if (m_adaptive_frames < GetBufferSizeForMS(m_sample_rate, ADAPTIVE_INTERVAL_MS))
+		return;
+
+	const u32 underruns = m_underrun_count.load(std::memory_order_relaxed);
+	const bool had_underrun = (underruns != m_adaptive_underruns);
+	const bool had_jitter = (m_adaptive_min_buffered < static_cast<u32>(m_target_buffer_size * JITTER_THRESHOLD));
+
+	// Never go above what the stretcher has room for, or above what the user asked for by a large margin.
+	const u32 min_size = GetBufferSizeForMS(m_sample_rate, ADAPTIVE_MIN_BUFFER_MS);
+	const u32 max_size = std::min(GetBufferSizeForMS(m_sample_rate, m_parameters.buffer_ms * ADAPTIVE_MAX_BUFFER_FACTOR),
+		m_buffer_size / 2);
+
+	u32 new_size = m_target_buffer_size;
+	if (had_underrun || had_jitter)
+	{
+		new_size = GetAlignedBufferSize(static_cast<u32>(new_size * GROW_FACTOR));
+		m_adaptive_clean_intervals = 0;
+	}
+	else if (++m_adaptive_clean_intervals >= CLEAN_INTERVALS_BEFORE_SHRINK)
+	{
+		new_size = (new_size > CHUNK_SIZE) ? (new_size - CHUNK_SIZE) : new_size;
+		m_adaptive_clean_intervals = 0;
+	}
+
+	new_size = std::clamp(new_size, min_size, std::max(min_size, max_size));
+	if (new_size != m_target_buffer_size)
+	{
+		LOG_UNDERRUN("Adaptive buffer target {} -> {} frames (underrun: {}, min buffered: {})", m_target_buffer_size,
+			new_size, had_underrun, m_adaptive_min_buffered);
+		m_target_buffer_size = new_size;
+		m_target_buffer_ms.store(GetMSForBufferSize(m_sample_rate, new_size), std::memory_order_relaxed);
+	}
+
+	m_adaptive_frames = 0;
+	m_adaptive_underruns = underruns;
+	m_adaptive_min_buffered = std::numeric_limits<u32>::max();
+}
+
 void AudioStream::StretchUnderrun()
 {
 	// Didn't produce enough frames in time.
@@ -864,6 +1035,8 @@ void AudioStreamParameters::LoadSave(SettingsWrapper& wrap, const char* section)
 	stretch_overlap_ms = static_cast<u16>(std::clamp<int>(wrap.EntryBitfield(section, "StretchOverlapMS", DEFAULT_STRETCH_OVERLAP), 0, std::numeric_limits<u16>::max()));
 	stretch_use_quickseek = wrap.EntryBitBool(section, "StretchUseQuickSeek", DEFAULT_STRETCH_USE_QUICKSEEK);
 	stretch_use_aa_filter = wrap.EntryBitBool(section, "StretchUseAAFilter", DEFAULT_STRETCH_USE_AA_FILTER);
+	adaptive_buffer = wrap.EntryBitBool(section, "AdaptiveBufferSize", DEFAULT_ADAPTIVE_BUFFER);
+	wrap.EnumEntry(section, "StretchAlgorithm", stretch_algorithm, &AudioStream::ParseStretchAlgorithm, &AudioStream::GetStretchAlgorithmName, DEFAULT_STRETCH_ALGORITHM);
 
 	expand_block_size = static_cast<u16>(std::clamp<int>(wrap.EntryBitfield(section, "ExpandBlockSize", DEFAULT_EXPAND_BLOCK_SIZE), 0, std::numeric_limits<u16>::max()));
 	wrap.Entry(section, "ExpandCircularWrap", expand_circular_wrap, DEFAULT_EXPAND_CIRCULAR_WRAP);
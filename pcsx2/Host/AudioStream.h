@@ -57,6 +57,10 @@ public:
 	static const char* GetExpansionModeDisplayName(AudioExpansionMode mode);
 	static std::optional<AudioExpansionMode> ParseExpansionMode(const char* name);
 
+	static const char* GetStretchAlgorithmName(AudioStretchAlgorithm algorithm);
+	static const char* GetStretchAlgorithmDisplayName(AudioStretchAlgorithm algorithm);
+	static std::optional<AudioStretchAlgorithm> ParseStretchAlgorithm(const char* name);
+
 	__fi u32 GetSampleRate() const { return m_sample_rate; }
 	__fi u32 GetInternalChannels() const { return m_internal_channels; }
 	__fi u32 GetOutputChannels() const { return m_internal_channels; }
@@ -71,6 +75,12 @@ public:
 
 	u32 GetBufferedFramesRelaxed() const;
 
+	/// Number of times the host ran out of audio since the stream was created. Safe to call from any thread.
+	__fi u32 GetUnderrunCount() const { return m_underrun_count.load(std::memory_order_relaxed); }
+
+	/// Buffer level the stretcher is currently aiming for, in milliseconds. Safe to call from any thread.
+	__fi u32 GetTargetBufferMS() const { return m_target_buffer_ms.load(std::memory_order_relaxed); }
+
 	/// Temporarily pauses the stream, preventing it from requesting data.
 	virtual void SetPaused(bool paused);
 
@@ -139,6 +149,10 @@ private:
 	static constexpr u32 STRETCH_RESET_THRESHOLD = 5;
 	static constexpr u32 TARGET_IPS = 691;
 
+	static constexpr u32 ADAPTIVE_INTERVAL_MS = 1000;
+	static constexpr u32 ADAPTIVE_MIN_BUFFER_MS = 10;
+	static constexpr u32 ADAPTIVE_MAX_BUFFER_FACTOR = 4;
+
 	static std::vector<std::pair<std::string, std::string>> GetCubebDriverNames();
 	static std::vector<DeviceInfo> GetCubebOutputDevices(const char* driver);
 	static std::unique_ptr<AudioStream> CreateCubebAudioStream(u32 sample_rate, const AudioStreamParameters& parameters,
@@ -159,9 +173,16 @@ private:
 	void StretchWriteBlock(const float* block);
 	void StretchUnderrun();
 	void StretchOverrun();
+	void StretchClear();
+	void SetStretchTempo(float tempo);
+
+	/// Speed-follow alternative to SoundTouch: plays the input back faster or slower with linear interpolation.
+	/// Pitch follows the tempo, but it's a fraction of the cost, which matters on low-end hosts.
+	void ResampleWriteBlock(const float* block);
 
 	float AddAndGetAverageTempo(float val);
 	void UpdateStretchTempo();
+	void UpdateAdaptiveBufferTarget();
 
 	u32 m_buffer_size = 0;
 	std::unique_ptr<s16[]> m_buffer;
@@ -172,6 +193,13 @@ private:
 
 	std::unique_ptr<soundtouch::SoundTouch> m_soundtouch;
 
+	// State for AudioStretchAlgorithm::Resample. The position is relative to m_resample_last, the final frame
+	// of the previous block.
+	float m_resample_tempo = 1.0f;
+	float m_resample_pos = 0.0f;
+	std::array<float, MAX_OUTPUT_CHANNELS> m_resample_last = {};
+	std::unique_ptr<float[]> m_resample_buffer;
+
 	u32 m_target_buffer_size = 0;
 	u32 m_stretch_reset = STRETCH_RESET_THRESHOLD;
 
@@ -185,6 +213,13 @@ private:
 
 	std::array<float, AVERAGING_BUFFER_SIZE> m_average_fullness = {};
 
+	std::atomic<u32> m_underrun_count{0};
+	std::atomic<u32> m_target_buffer_ms{0};
+	u32 m_adaptive_underruns = 0;
+	u32 m_adaptive_frames = 0;
+	u32 m_adaptive_min_buffered = 0;
+	u32 m_adaptive_clean_intervals = 0;
+
 	// temporary staging buffer, used for timestretching
 	std::unique_ptr<s16[]> m_staging_buffer;
 
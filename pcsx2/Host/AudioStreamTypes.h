@@ -26,6 +26,13 @@ enum class AudioExpansionMode : u8
 	Count
 };
 
+enum class AudioStretchAlgorithm : u8
+{
+	SoundTouch,
+	Resample,
+	Count
+};
+
 struct AudioStreamParameters
 {
 	AudioExpansionMode expansion_mode = DEFAULT_EXPANSION_MODE;
@@ -38,6 +45,8 @@ struct AudioStreamParameters
 	u16 stretch_overlap_ms = DEFAULT_STRETCH_OVERLAP;
 	bool stretch_use_quickseek = DEFAULT_STRETCH_USE_QUICKSEEK;
 	bool stretch_use_aa_filter = DEFAULT_STRETCH_USE_AA_FILTER;
+	bool adaptive_buffer = DEFAULT_ADAPTIVE_BUFFER;
+	AudioStretchAlgorithm stretch_algorithm = DEFAULT_STRETCH_ALGORITHM;
 
 	float expand_circular_wrap = DEFAULT_EXPAND_CIRCULAR_WRAP;
 	float expand_shift = DEFAULT_EXPAND_SHIFT;
@@ -72,6 +81,9 @@ struct AudioStreamParameters
 
 	static constexpr bool DEFAULT_STRETCH_USE_QUICKSEEK = false;
 	static constexpr bool DEFAULT_STRETCH_USE_AA_FILTER = false;
+	static constexpr AudioStretchAlgorithm DEFAULT_STRETCH_ALGORITHM = AudioStretchAlgorithm::SoundTouch;
+
+	static constexpr bool DEFAULT_ADAPTIVE_BUFFER = false;
 
 	void LoadSave(SettingsWrapper& wrap, const char* section);
 
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Achievements.h"
+#include "DebugTools/GuestProfiler.h"
+#include "DebugTools/TraceCapture.h"
 #include "GS.h"
 #include "Host.h"
 #include "IconsFontAwesome6.h"
@@ -9,6 +11,7 @@
 #include "ImGui/ImGuiOverlays.h"
 #include "Input/InputManager.h"
 #include "Recording/InputRecording.h"
+#include "Rewind.h"
 #include "SPU2/spu2.h"
 #include "VMManager.h"
 #include "SIO/Memcard/MemoryCardFile.h"
@@ -212,6 +215,16 @@ DEFINE_HOTKEY("SwapMemCards", TRANSLATE_NOOP("Hotkeys", "System"),
 				FileMcd_Swap();
 			});
 	})
+DEFINE_HOTKEY("ToggleGuestProfiler", TRANSLATE_NOOP("Hotkeys", "System"),
+	TRANSLATE_NOOP("Hotkeys", "Toggle Guest Profiler"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+			GuestProfiler::Toggle();
+	})
+DEFINE_HOTKEY("ToggleTraceCapture", TRANSLATE_NOOP("Hotkeys", "System"),
+	TRANSLATE_NOOP("Hotkeys", "Toggle Trace Capture"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+			TraceCapture::Toggle();
+	})
 DEFINE_HOTKEY("InputRecToggleMode", TRANSLATE_NOOP("Hotkeys", "System"),
 	TRANSLATE_NOOP("Hotkeys", "Toggle Input Recording Mode"), [](s32 pressed) {
 		if (!pressed && VMManager::HasValidVM())
@@ -242,6 +255,11 @@ DEFINE_HOTKEY("LoadBackupStateFromSlot", TRANSLATE_NOOP("Hotkeys", "Save States"
 		if (!pressed && VMManager::HasValidVM())
 			SaveStateSelectorUI::LoadCurrentBackupSlot();
 	})
+DEFINE_HOTKEY("Rewind", TRANSLATE_NOOP("Hotkeys", "Save States"), TRANSLATE_NOOP("Hotkeys", "Rewind (Hold)"),
+	[](s32 pressed) {
+		if (VMManager::HasValidVM())
+			Rewind::SetRewinding(pressed > 0);
+	})
 DEFINE_HOTKEY("SaveStateAndSelectNextSlot", TRANSLATE_NOOP("Hotkeys", "Save States"),
 	TRANSLATE_NOOP("Hotkeys", "Save State and Select Next Slot"), [](s32 pressed) {
 		if (!pressed && VMManager::HasValidVM())
@@ -204,6 +204,42 @@ mem32_t hwRead32_page_0F_INTC_HACK(u32 mem)
 	return retval;
 }
 
+bool hwIsDirectRead32(u32 mem)
+{
+	// Reads are logged by the page handlers.
+	if (IsDevBuild && EmuConfig.Trace.Enabled)
+		return false;
+
+	if ((mem & 0xffff0003) != 0x10000000)
+		return false;
+
+	switch ((mem >> 12) & 0x0f)
+	{
+		case 0x03:
+			// GIF registers, VIF has its own read handler.
+			if (mem >= EEMemoryMap::VIF0_Start)
+				return false;
+			return !(CHECK_OPHFLAGHACK && mem == GIF_STAT);
+
+		case 0x08:
+		case 0x09:
+		case 0x0a:
+		case 0x0b:
+		case 0x0c:
+		case 0x0d:
+		case 0x0e:
+			// DMA channels and the DMAC control registers, except for the VIF FIFO hack in _hwRead32.
+			return !(CHECK_VIFFIFOHACK && mem == (D1_CHCR + 0x10));
+
+		case 0x0f:
+			// INTC_STAT is handled by the caller, since it depends on the INTC spin hack.
+			return (mem == INTC_MASK);
+
+		default:
+			return false;
+	}
+}
+
 // --------------------------------------------------------------------------------------
 //  hwRead8 / hwRead16 / hwRead64 / hwRead128
 // --------------------------------------------------------------------------------------
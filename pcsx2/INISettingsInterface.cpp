@@ -84,6 +84,7 @@ bool INISettingsInterface::Load()
 	if (fp)
 		err = m_ini.LoadFile(fp.get());
 
+	BumpRevision();
 	return (err == SI_OK);
 }
 
@@ -131,6 +132,7 @@ bool INISettingsInterface::Save(Error* error)
 
 void INISettingsInterface::Clear()
 {
+	BumpRevision();
 	m_ini.Reset();
 }
 
@@ -232,36 +234,42 @@ bool INISettingsInterface::GetStringValue(const char* section, const char* key,
 void INISettingsInterface::SetIntValue(const char* section, const char* key, int value)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetValue(section, key, StringUtil::ToChars(value).c_str(), nullptr, true);
 }
 
 void INISettingsInterface::SetUIntValue(const char* section, const char* key, uint value)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetValue(section, key, StringUtil::ToChars(value).c_str(), nullptr, true);
 }
 
 void INISettingsInterface::SetFloatValue(const char* section, const char* key, float value)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetValue(section, key, StringUtil::ToChars(value).c_str(), nullptr, true);
 }
 
 void INISettingsInterface::SetDoubleValue(const char* section, const char* key, double value)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetValue(section, key, StringUtil::ToChars(value).c_str(), nullptr, true);
 }
 
 void INISettingsInterface::SetBoolValue(const char* section, const char* key, bool value)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetBoolValue(section, key, value, nullptr, true);
 }
 
 void INISettingsInterface::SetStringValue(const char* section, const char* key, const char* value)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetValue(section, key, value, nullptr, true);
 }
 
@@ -273,12 +281,14 @@ bool INISettingsInterface::ContainsValue(const char* section, const char* key) c
 void INISettingsInterface::DeleteValue(const char* section, const char* key)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.Delete(section, key);
 }
 
 void INISettingsInterface::ClearSection(const char* section)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.Delete(section, nullptr);
 	m_ini.SetValue(section, nullptr, nullptr);
 }
@@ -289,6 +299,7 @@ void INISettingsInterface::RemoveSection(const char* section)
 		return;
 
 	m_dirty = true;
+	BumpRevision();
 	m_ini.Delete(section, nullptr);
 }
 
@@ -302,6 +313,7 @@ void INISettingsInterface::RemoveEmptySections()
 			continue;
 
 		m_dirty = true;
+		BumpRevision();
 		m_ini.Delete(entry.pItem, nullptr);
 	}
 }
@@ -322,6 +334,7 @@ std::vector<std::string> INISettingsInterface::GetStringList(const char* section
 void INISettingsInterface::SetStringList(const char* section, const char* key, const std::vector<std::string>& items)
 {
 	m_dirty = true;
+	BumpRevision();
 	m_ini.Delete(section, key);
 
 	for (const std::string& sv : items)
@@ -331,6 +344,7 @@ void INISettingsInterface::SetStringList(const char* section, const char* key, c
 bool INISettingsInterface::RemoveFromStringList(const char* section, const char* key, const char* item)
 {
 	m_dirty = true;
+	BumpRevision();
 	return m_ini.DeleteValue(section, key, item, true);
 }
 
@@ -345,6 +359,7 @@ bool INISettingsInterface::AddToStringList(const char* section, const char* key,
 	}
 
 	m_dirty = true;
+	BumpRevision();
 	m_ini.SetValue(section, key, item, nullptr, false);
 	return true;
 }
@@ -380,6 +395,7 @@ std::vector<std::pair<std::string, std::string>> INISettingsInterface::GetKeyVal
 
 void INISettingsInterface::SetKeyValueList(const char* section, const std::vector<std::pair<std::string, std::string>>& items)
 {
+	BumpRevision();
 	m_ini.Delete(section, nullptr);
 	for (const std::pair<std::string, std::string>& item : items)
 		m_ini.SetValue(section, item.first.c_str(), item.second.c_str(), nullptr, false);
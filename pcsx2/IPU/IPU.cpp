@@ -10,6 +10,11 @@
 #include <limits.h>
 #include "Config.h"
 
+#include "common/Threading.h"
+
+#include <atomic>
+#include <utility>
+
 // the BP doesn't advance and returns -1 if there is no data to be read
 alignas(16) tIPU_cmd ipu_cmd;
 alignas(16) tIPU_BP g_BP;
@@ -18,6 +23,19 @@ IPUStatus IPUCoreStatus;
 
 static void (*IPUWorker)();
 
+// Threaded IPU: the core runs on its own thread once kicked, and owns all IPU state until
+// the EE thread syncs with it. Its side effects on the rest of the EE are held in
+// s_ipu_pending_events meanwhile, so the EE only ever sees them at a sync point.
+static Threading::Thread s_ipu_thread;
+static Threading::WorkSema s_ipu_thread_sema;
+static std::atomic_bool s_ipu_thread_shutdown{false};
+static bool s_ipu_thread_busy = false;
+static bool s_ipu_thread_sync_event = false;
+static u32 s_ipu_pending_events = 0;
+
+// How long the EE runs before it picks up the results of a kick, unless it touches the IPU first.
+static constexpr int IPU_THREAD_SYNC_CYCLES = 512;
+
 // Color conversion stuff, the memory layout is a total hack
 // convert_data_buffer is a pointer to the internal rgb struct (the first param in convert_init_t)
 //char convert_data_buffer[sizeof(convert_rgb_t)];
@@ -78,10 +96,129 @@ void tIPU_cmd::clear()
 	current = 0xffffffff;
 }
 
+static void ipuThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("IPU");
+
+	for (;;)
+	{
+		s_ipu_thread_sema.WaitForWork();
+		if (s_ipu_thread_shutdown.load(std::memory_order_acquire))
+			break;
+
+		IPUWorker();
+	}
+}
+
+static void ipuVDECStarted()
+{
+	static int count = 0;
+	if (count++ > 5)
+	{
+		if (!FMVstarted)
+		{
+			EnableFMV = true;
+			FMVstarted = true;
+		}
+		count = 0;
+	}
+	eecount_on_last_vdec = cpuRegs.cycle;
+}
+
+static void ipuApplyEvents()
+{
+	const u32 events = std::exchange(s_ipu_pending_events, 0);
+
+	if (events & IPU_EVENT_VDEC)
+		ipuVDECStarted();
+
+	if (events & IPU_EVENT_DATA_REQUEST)
+	{
+		if (ipu1ch.chcr.STR && cpuRegs.eCycle[4] == 0x9999)
+			CPU_INT(DMAC_TO_IPU, std::min(8U, ipu1ch.qwc));
+	}
+
+	if (events & IPU_EVENT_DATA_READY)
+	{
+		if (ipu0ch.chcr.STR)
+			IPU_INT_FROM(1);
+	}
+
+	if (events & IPU_EVENT_PROCESS)
+	{
+		// A pending sync event becomes the reschedule, it is already due sooner than a fresh one.
+		if (s_ipu_thread_sync_event)
+			s_ipu_thread_sync_event = false;
+		else
+			IPU_INT_PROCESS(64); // Should probably be much higher, but myst 3 doesn't like it right now.
+	}
+
+	if (events & IPU_EVENT_IRQ)
+		hwIntcIrq(INTC_IPU);
+}
+
+void IPUPostEvent(u32 events)
+{
+	s_ipu_pending_events |= events;
+	if (!s_ipu_thread_busy)
+		ipuApplyEvents();
+}
+
+void ipuThreadSync()
+{
+	if (!s_ipu_thread_busy)
+		return;
+
+	s_ipu_thread_sema.WaitForEmpty();
+	s_ipu_thread_busy = false;
+	ipuApplyEvents();
+}
+
+bool ipuThreadSyncEvent()
+{
+	const bool sync_only = std::exchange(s_ipu_thread_sync_event, false);
+	ipuThreadSync();
+	return sync_only;
+}
+
+void ipuThreadShutdown()
+{
+	ipuThreadSync();
+	if (!s_ipu_thread.Joinable())
+		return;
+
+	s_ipu_thread_shutdown.store(true, std::memory_order_release);
+	s_ipu_thread_sema.NotifyOfWork();
+	s_ipu_thread.Join();
+}
+
 __fi void IPUProcessInterrupt()
 {
-	if (ipuRegs.ctrl.BUSY)
+	ipuThreadSync();
+	if (!ipuRegs.ctrl.BUSY)
+		return;
+
+	if (!EmuConfig.Speedhacks.ipuThread)
+	{
 		IPUWorker();
+		return;
+	}
+
+	if (!s_ipu_thread.Joinable())
+	{
+		s_ipu_thread_sema.Reset();
+		s_ipu_thread_shutdown.store(false, std::memory_order_release);
+		s_ipu_thread.Start(&ipuThreadEntryPoint);
+	}
+
+	s_ipu_thread_busy = true;
+	s_ipu_thread_sema.NotifyOfWork();
+
+	if (!(cpuRegs.interrupt & (1 << IPU_PROCESS)))
+	{
+		s_ipu_thread_sync_event = true;
+		CPU_INT(IPU_PROCESS, IPU_THREAD_SYNC_CYCLES);
+	}
 }
 
 /////////////////////////////////////////////////////////
@@ -89,6 +226,8 @@ __fi void IPUProcessInterrupt()
 
 void ipuReset()
 {
+	ipuThreadSync();
+	s_ipu_thread_sync_event = false;
 	IPUWorker = MULTI_ISA_SELECT(IPUWorker);
 	std::memset(&ipuRegs, 0, sizeof(ipuRegs));
 	std::memset(&g_BP, 0, sizeof(g_BP));
@@ -122,9 +261,14 @@ bool SaveStateBase::ipuFreeze()
 {
 	// Get a report of the status of the ipu variables when saving and loading savestates.
 	//ReportIPU();
+	ipuThreadSync();
 	if (!FreezeTag("IPU"))
 		return false;
 
+	// A pending IPU_PROCESS in the loaded state is always a real one.
+	if (IsLoading())
+		s_ipu_thread_sync_event = false;
+
 	Freeze(ipu_fifo);
 
 	Freeze(g_BP);
@@ -221,6 +365,8 @@ __fi u32 ipuRead32(u32 mem)
 	pxAssert((mem & ~0xff) == 0x10002000);
 	mem &= 0xff;	// ipu repeats every 0x100
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD) : // IPU_CMD
@@ -271,6 +417,8 @@ __fi u64 ipuRead64(u32 mem)
 	pxAssert((mem & ~0xff) == 0x10002000);
 	mem &= 0xff;	// ipu repeats every 0x100
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD): // IPU_CMD
@@ -331,6 +479,8 @@ __fi bool ipuWrite32(u32 mem, u32 value)
 	pxAssert((mem & ~0xfff) == 0x10002000);
 	mem &= 0xfff;
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD): // IPU_CMD
@@ -366,6 +516,8 @@ __fi bool ipuWrite64(u32 mem, u64 value)
 	pxAssert((mem & ~0xfff) == 0x10002000);
 	mem &= 0xfff;
 
+	ipuThreadSync();
+
 	switch (mem)
 	{
 		ipucase(IPU_CMD):
@@ -529,5 +681,5 @@ __fi void IPUCMD_WRITE(u32 val)
 		IPU_INT_PROCESS(64);
 	}
 	else
-		IPUWorker();
+		IPUProcessInterrupt();
 }
@@ -297,3 +297,22 @@ extern void IPUCMD_WRITE(u32 val);
 extern void ipuSoftReset();
 extern void IPUProcessInterrupt();
 
+// Side effects of the IPU core on the rest of the EE. Applied right away, unless the core
+// is running on the IPU thread, then they wait for the EE thread to sync with it.
+enum IPUEvent : u32
+{
+	IPU_EVENT_PROCESS = 1 << 0, // core wants to run again
+	IPU_EVENT_DATA_REQUEST = 1 << 1, // input FIFO is running dry, kick IPU1 DMA
+	IPU_EVENT_DATA_READY = 1 << 2, // output FIFO has data, kick IPU0 DMA
+	IPU_EVENT_IRQ = 1 << 3, // command finished
+	IPU_EVENT_VDEC = 1 << 4, // VDEC executed (FMV detection)
+};
+
+extern void IPUPostEvent(u32 events);
+
+// Waits for the IPU thread to go idle and applies its pending events, a no-op when it isn't running.
+extern void ipuThreadSync();
+// Called for IPU_PROCESS, returns true if the event was only scheduled to sync with the IPU thread.
+extern bool ipuThreadSyncEvent();
+extern void ipuThreadShutdown();
+
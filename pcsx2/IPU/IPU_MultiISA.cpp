@@ -13,20 +13,13 @@
 #include "IPU/IPUdma.h"
 #include "IPU/yuv2rgb.h"
 #include "IPU/IPU_MultiISA.h"
+#include "GS/GSVector.h"
 
 // the IPU is fixed to 16 byte strides (128-bit / QWC resolution):
 static const uint decoder_stride = 16;
 
 #if MULTI_ISA_COMPILE_ONCE
 
-static constexpr std::array<u8, 1024> make_clip_lut()
-{
-	std::array<u8, 1024> lut = {};
-	for (int i = -384; i < 640; i++)
-		lut[i+384] = (i < 0) ? 0 : ((i > 255) ? 255 : i);
-	return lut;
-}
-
 static constexpr mpeg2_scan_pack make_scan_pack()
 {
 	constexpr u8 mpeg2_scan_norm[64] = {
@@ -57,7 +50,6 @@ static constexpr mpeg2_scan_pack make_scan_pack()
 	return pack;
 }
 
-alignas(16) const std::array<u8, 1024> g_idct_clip_lut = make_clip_lut();
 alignas(16) const mpeg2_scan_pack mpeg2_scan = make_scan_pack();
 
 #endif
@@ -206,138 +198,147 @@ __ri static u8 getBits8(u8 *address, bool advance)
  * column inputs are 16-bit values.
  */
 
-__fi static void BUTTERFLY(int& t0, int& t1, int w0, int w1, int d0, int d1)
+__fi static void BUTTERFLY(GSVector4i& t0, GSVector4i& t1, int w0, int w1, const GSVector4i& d0, const GSVector4i& d1)
 {
-	int tmp = w0 * (d0 + d1);
-	t0 = tmp + (w1 - w0) * d1;
-	t1 = tmp - (w1 + w0) * d0;
+	const GSVector4i tmp = d0.add32(d1).mul32l(GSVector4i(w0));
+	t0 = tmp.add32(d1.mul32l(GSVector4i(w1 - w0)));
+	t1 = tmp.sub32(d0.mul32l(GSVector4i(w1 + w0)));
 }
 
-__ri static void IDCT_Block(s16* block)
+// One 8-point pass over four lines at once, d[i] holds coefficient i of each line as 32-bit lanes.
+// The row and column passes only differ in their rounding.
+template <bool columns>
+__fi static void IDCT_Pass(GSVector4i* d)
 {
-	for (int i = 0; i < 8; i++)
+	GSVector4i a0, a1, a2, a3;
 	{
-		s16* const rblock = block + 8 * i;
-		if (!(rblock[1] | ((s32*)rblock)[1] | ((s32*)rblock)[2] |
-				((s32*)rblock)[3]))
-		{
-			u32 tmp = (u16)(rblock[0] << 3);
-			tmp |= tmp << 16;
-			((s32*)rblock)[0] = tmp;
-			((s32*)rblock)[1] = tmp;
-			((s32*)rblock)[2] = tmp;
-			((s32*)rblock)[3] = tmp;
-			continue;
-		}
+		const GSVector4i d0 = d[0].sll32<11>().add32(GSVector4i(columns ? 65536 : 128));
+		const GSVector4i d1 = d[1];
+		const GSVector4i d2 = d[2].sll32<11>();
+		const GSVector4i d3 = d[3];
+		const GSVector4i t0 = d0.add32(d2);
+		const GSVector4i t1 = d0.sub32(d2);
+		GSVector4i t2, t3;
+		BUTTERFLY(t2, t3, W6, W2, d3, d1);
+		a0 = t0.add32(t2);
+		a1 = t1.add32(t3);
+		a2 = t1.sub32(t3);
+		a3 = t0.sub32(t2);
+	}
 
-		int a0, a1, a2, a3;
+	GSVector4i b0, b1, b2, b3;
+	{
+		const GSVector4i d0 = d[4];
+		const GSVector4i d1 = d[5];
+		const GSVector4i d2 = d[6];
+		const GSVector4i d3 = d[7];
+		GSVector4i t0, t1, t2, t3;
+		BUTTERFLY(t0, t1, W7, W1, d3, d0);
+		BUTTERFLY(t2, t3, W3, W5, d1, d2);
+		b0 = t0.add32(t2);
+		b3 = t1.add32(t3);
+		if constexpr (columns)
 		{
-			const int d0 = (rblock[0] << 11) + 128;
-			const int d1 = rblock[1];
-			const int d2 = rblock[2] << 11;
-			const int d3 = rblock[3];
-			int t0 = d0 + d2;
-			int t1 = d0 - d2;
-			int t2, t3;
-			BUTTERFLY(t2, t3, W6, W2, d3, d1);
-			a0 = t0 + t2;
-			a1 = t1 + t3;
-			a2 = t1 - t3;
-			a3 = t0 - t2;
+			t0 = t0.sub32(t2).sra32<8>();
+			t1 = t1.sub32(t3).sra32<8>();
+			b1 = t0.add32(t1).mul32l(GSVector4i(181));
+			b2 = t0.sub32(t1).mul32l(GSVector4i(181));
 		}
-
-		int b0, b1, b2, b3;
+		else
 		{
-			const int d0 = rblock[4];
-			const int d1 = rblock[5];
-			const int d2 = rblock[6];
-			const int d3 = rblock[7];
-			int t0, t1, t2, t3;
-			BUTTERFLY(t0, t1, W7, W1, d3, d0);
-			BUTTERFLY(t2, t3, W3, W5, d1, d2);
-			b0 = t0 + t2;
-			b3 = t1 + t3;
-			t0 -= t2;
-			t1 -= t3;
-			b1 = ((t0 + t1) * 181) >> 8;
-			b2 = ((t0 - t1) * 181) >> 8;
+			t0 = t0.sub32(t2);
+			t1 = t1.sub32(t3);
+			b1 = t0.add32(t1).mul32l(GSVector4i(181)).sra32<8>();
+			b2 = t0.sub32(t1).mul32l(GSVector4i(181)).sra32<8>();
 		}
-
-		rblock[0] = (a0 + b0) >> 8;
-		rblock[1] = (a1 + b1) >> 8;
-		rblock[2] = (a2 + b2) >> 8;
-		rblock[3] = (a3 + b3) >> 8;
-		rblock[4] = (a3 - b3) >> 8;
-		rblock[5] = (a2 - b2) >> 8;
-		rblock[6] = (a1 - b1) >> 8;
-		rblock[7] = (a0 - b0) >> 8;
 	}
 
+	constexpr int shift = columns ? 17 : 8;
+	d[0] = a0.add32(b0).sra32<shift>();
+	d[1] = a1.add32(b1).sra32<shift>();
+	d[2] = a2.add32(b2).sra32<shift>();
+	d[3] = a3.add32(b3).sra32<shift>();
+	d[4] = a3.sub32(b3).sra32<shift>();
+	d[5] = a2.sub32(b2).sra32<shift>();
+	d[6] = a1.sub32(b1).sra32<shift>();
+	d[7] = a0.sub32(b0).sra32<shift>();
+}
+
+// Runs a pass over all eight lines, lane j of v[i] is coefficient i of line j.
+template <bool columns>
+__fi static void IDCT_Pass16(GSVector4i* v)
+{
+	GSVector4i lo[8], hi[8];
 	for (int i = 0; i < 8; i++)
 	{
-		s16* const cblock = block + i;
+		lo[i] = v[i].i16to32();
+		hi[i] = v[i].uph64().i16to32();
+	}
 
-		int a0, a1, a2, a3;
-		{
-			const int d0 = (cblock[8 * 0] << 11) + 65536;
-			const int d1 = cblock[8 * 1];
-			const int d2 = cblock[8 * 2] << 11;
-			const int d3 = cblock[8 * 3];
-			const int t0 = d0 + d2;
-			const int t1 = d0 - d2;
-			int t2;
-			int t3;
-			BUTTERFLY(t2, t3, W6, W2, d3, d1);
-			a0 = t0 + t2;
-			a1 = t1 + t3;
-			a2 = t1 - t3;
-			a3 = t0 - t2;
-		}
+	IDCT_Pass<columns>(lo);
+	IDCT_Pass<columns>(hi);
 
-		int b0, b1, b2, b3;
-		{
-			const int d0 = cblock[8 * 4];
-			const int d1 = cblock[8 * 5];
-			const int d2 = cblock[8 * 6];
-			const int d3 = cblock[8 * 7];
-			int t0, t1, t2, t3;
-			BUTTERFLY(t0, t1, W7, W1, d3, d0);
-			BUTTERFLY(t2, t3, W3, W5, d1, d2);
-			b0 = t0 + t2;
-			b3 = t1 + t3;
-			t0 = (t0 - t2) >> 8;
-			t1 = (t1 - t3) >> 8;
-			b1 = (t0 + t1) * 181;
-			b2 = (t0 - t1) * 181;
-		}
+	// Results are truncated to 16 bits, not saturated, same as storing an int into the s16 block.
+	for (int i = 0; i < 8; i++)
+		v[i] = lo[i].sll32<16>().sra32<16>().ps32(hi[i].sll32<16>().sra32<16>());
+}
 
-		cblock[8 * 0] = (a0 + b0) >> 17;
-		cblock[8 * 1] = (a1 + b1) >> 17;
-		cblock[8 * 2] = (a2 + b2) >> 17;
-		cblock[8 * 3] = (a3 + b3) >> 17;
-		cblock[8 * 4] = (a3 - b3) >> 17;
-		cblock[8 * 5] = (a2 - b2) >> 17;
-		cblock[8 * 6] = (a1 - b1) >> 17;
-		cblock[8 * 7] = (a0 - b0) >> 17;
-	}
+__fi static void IDCT_Transpose(GSVector4i* r)
+{
+	const GSVector4i t0 = r[0].upl16(r[1]);
+	const GSVector4i t1 = r[0].uph16(r[1]);
+	const GSVector4i t2 = r[2].upl16(r[3]);
+	const GSVector4i t3 = r[2].uph16(r[3]);
+	const GSVector4i t4 = r[4].upl16(r[5]);
+	const GSVector4i t5 = r[4].uph16(r[5]);
+	const GSVector4i t6 = r[6].upl16(r[7]);
+	const GSVector4i t7 = r[6].uph16(r[7]);
+
+	const GSVector4i u0 = t0.upl32(t2);
+	const GSVector4i u1 = t0.uph32(t2);
+	const GSVector4i u2 = t1.upl32(t3);
+	const GSVector4i u3 = t1.uph32(t3);
+	const GSVector4i u4 = t4.upl32(t6);
+	const GSVector4i u5 = t4.uph32(t6);
+	const GSVector4i u6 = t5.upl32(t7);
+	const GSVector4i u7 = t5.uph32(t7);
+
+	r[0] = u0.upl64(u4);
+	r[1] = u0.uph64(u4);
+	r[2] = u1.upl64(u5);
+	r[3] = u1.uph64(u5);
+	r[4] = u2.upl64(u6);
+	r[5] = u2.uph64(u6);
+	r[6] = u3.upl64(u7);
+	r[7] = u3.uph64(u7);
+}
+
+// Leaves the result in rows, one 8x16-bit row per vector.
+__ri static void IDCT_Block(const s16* block, GSVector4i* rows)
+{
+	for (int i = 0; i < 8; i++)
+		rows[i] = GSVector4i::load<true>(block + 8 * i);
+
+	// Row pass, done across the transposed block so every lane handles one row.
+	IDCT_Transpose(rows);
+	IDCT_Pass16<false>(rows);
+	IDCT_Transpose(rows);
+
+	// Column pass, every lane handles one column.
+	IDCT_Pass16<true>(rows);
 }
 
 __ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
 {
-	IDCT_Block(block);
+	GSVector4i rows[8];
+	IDCT_Block(block, rows);
 
+	// Saturating to u8 gives the 0..255 clamp the output needs.
+	const GSVector4i zero = GSVector4i::zero();
 	for (int i = 0; i < 8; i++)
 	{
-		dest[0] = (g_idct_clip_lut.data() + 384)[block[0]];
-		dest[1] = (g_idct_clip_lut.data() + 384)[block[1]];
-		dest[2] = (g_idct_clip_lut.data() + 384)[block[2]];
-		dest[3] = (g_idct_clip_lut.data() + 384)[block[3]];
-		dest[4] = (g_idct_clip_lut.data() + 384)[block[4]];
-		dest[5] = (g_idct_clip_lut.data() + 384)[block[5]];
-		dest[6] = (g_idct_clip_lut.data() + 384)[block[6]];
-		dest[7] = (g_idct_clip_lut.data() + 384)[block[7]];
-
-		std::memset(block, 0, 16);
+		GSVector4i::storel(dest, rows[i].pu16());
+		GSVector4i::store<true>(block, zero);
 
 		dest += stride;
 		block += 8;
@@ -352,13 +353,14 @@ __ri static void IDCT_Add(const int last, s16* block, s16* dest, const int strid
 
 	if (last != 129 || (block[0] & 7) == 4)
 	{
-		IDCT_Block(block);
+		GSVector4i rows[8];
+		IDCT_Block(block, rows);
 
-		const r128 zero = r128_zero();
+		const GSVector4i zero = GSVector4i::zero();
 		for (int i = 0; i < 8; i++)
 		{
-			r128_store(dest, r128_load(block));
-			r128_store(block, zero);
+			GSVector4i::store<true>(dest, rows[i]);
+			GSVector4i::store<true>(block, zero);
 
 			dest += stride;
 			block += 8;
@@ -1103,7 +1105,7 @@ __ri static bool mpeg2sliceIDEC()
 					ready_to_decode = false;
 					IPUCoreStatus.WaitingOnIPUFrom = false;
 					IPUCoreStatus.WaitingOnIPUTo = false;
-					IPU_INT_PROCESS( 64); // Should probably be much higher, but myst 3 doesn't like it right now.
+					IPUPostEvent(IPU_EVENT_PROCESS);
 					ipu_cmd.pos[1] = 2;
 					return false;
 				}
@@ -1518,7 +1520,7 @@ __fi static bool mpeg2_slice()
 			ready_to_decode = false;
 			IPUCoreStatus.WaitingOnIPUFrom = false;
 			IPUCoreStatus.WaitingOnIPUTo = false;
-			IPU_INT_PROCESS( 64); // Should probably be much higher, but myst 3 doesn't like it right now.
+			IPUPostEvent(IPU_EVENT_PROCESS);
 			return false;
 		}
 
@@ -1604,15 +1606,7 @@ __fi static bool mpeg2_slice()
 
 __fi static bool ipuVDEC(u32 val)
 {
-	static int count = 0;
-	if (count++ > 5) {
-		if (!FMVstarted) {
-			EnableFMV = true;
-			FMVstarted = true;
-		}
-		count = 0;
-	}
-	eecount_on_last_vdec = cpuRegs.cycle;
+	IPUPostEvent(IPU_EVENT_VDEC);
 
 	switch (ipu_cmd.pos[0])
 	{
@@ -2002,7 +1996,7 @@ __noinline void IPUWorker()
 	IPU_LOG("IPU Command finished");
 	ipuRegs.ctrl.BUSY = 0;
 	//ipu_cmd.current = 0xffffffff;
-	hwIntcIrq(INTC_IPU);
+	IPUPostEvent(IPU_EVENT_IRQ);
 }
 
 MULTI_ISA_UNSHARED_END
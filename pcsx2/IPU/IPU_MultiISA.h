@@ -161,5 +161,4 @@ struct mpeg2_scan_pack
 	u8 alt[64];
 };
 
-alignas(16) extern const std::array<u8, 1024> g_idct_clip_lut;
 alignas(16) extern const mpeg2_scan_pack mpeg2_scan;
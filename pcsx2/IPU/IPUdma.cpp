@@ -16,6 +16,7 @@ void ipuDmaReset()
 
 bool SaveStateBase::ipuDmaFreeze()
 {
+	ipuThreadSync();
 	if (!FreezeTag("IPUdma"))
 		return false;
 
@@ -69,6 +70,7 @@ void IPU1dma()
 	{
 		// IPU isn't expecting any data, so put it in to wait mode.
 		cpuRegs.eCycle[4] = 0x9999;
+		eeEventDeadline.Invalidate();
 		CPU_SET_DMASTALL(DMAC_TO_IPU, true);
 
 		// Shouldn't Happen.
@@ -125,6 +127,7 @@ void IPU1dma()
 	else
 	{
 			cpuRegs.eCycle[4] = 0x9999;
+			eeEventDeadline.Invalidate();
 			CPU_SET_DMASTALL(DMAC_TO_IPU, true);
 	}
 
@@ -201,6 +204,8 @@ void IPU0dma()
 
 __fi void dmaIPU0() // fromIPU
 {
+	ipuThreadSync();
+
 	//if (dmacRegs.ctrl.STS == STS_fromIPU) DevCon.Warning("DMA Stall enabled on IPU0");
 
 	if (dmacRegs.ctrl.STS == STS_fromIPU)   // STS == fromIPU - Initial settings
@@ -232,6 +237,7 @@ __fi void dmaIPU0() // fromIPU
 __fi void dmaIPU1() // toIPU
 {
 	IPU_LOG("IPU1DMAStart QWC %x, MADR %x, CHCR %x, TADR %x", ipu1ch.qwc, ipu1ch.madr, ipu1ch.chcr._u32, ipu1ch.tadr);
+	ipuThreadSync();
 	CPU_SET_DMASTALL(DMAC_TO_IPU, false);
 
 	if (ipu1ch.chcr.MOD == CHAIN_MODE)  //Chain Mode
@@ -268,12 +274,16 @@ __fi void dmaIPU1() // toIPU
 
 void ipuCMDProcess()
 {
+	if (ipuThreadSyncEvent())
+		return;
+
 	IPUProcessInterrupt();
 }
 
 void ipu0Interrupt()
 {
 	IPU_LOG("ipu0Interrupt: %x", cpuRegs.cycle);
+	ipuThreadSync();
 
 	if(ipu0ch.qwc > 0)
 	{
@@ -290,6 +300,7 @@ void ipu0Interrupt()
 __fi void ipu1Interrupt()
 {
 	IPU_LOG("ipu1Interrupt %x:", cpuRegs.cycle);
+	ipuThreadSync();
 
 	if(!IPU1Status.DMAFinished || IPU1Status.InProgress)  //Sanity Check
 	{
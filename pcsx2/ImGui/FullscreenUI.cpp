@@ -3636,6 +3636,9 @@ void FullscreenUI::DrawInterfaceSettingsPage()
 		FSUI_CSTR("Shows the CPU usage based on threads in the top-right corner of the display."), "EmuCore/GS", "OsdShowCPU", false);
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_IMAGE, "Show GPU Usage"),
 		FSUI_CSTR("Shows the host's GPU usage in the top-right corner of the display."), "EmuCore/GS", "OsdShowGPU", false);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_IMAGE, "Show GPU Time Breakdown"),
+		FSUI_CSTR("Shows how much GPU time is spent on draws, conversions, readbacks, post-processing and presentation."),
+		"EmuCore/GS", "OsdShowGPUBreakdown", false);
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_PF_MONITOR_CODE, "Show Resolution"),
 		FSUI_CSTR("Shows the resolution of the game in the top-right corner of the display."), "EmuCore/GS",
 		"OsdShowResolution", false);
@@ -3662,6 +3665,9 @@ void FullscreenUI::DrawInterfaceSettingsPage()
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_PF_MONITOR_CODE, "Show Hardware Info"),
 		FSUI_CSTR("Shows the current system hardware information on the OSD."), "EmuCore/GS", "OsdShowHardwareInfo",
 		false);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_MICROCHIP, "Show Memory Usage"),
+		FSUI_CSTR("Shows how much memory the emulator and each of its subsystems are using on the OSD."), "EmuCore/GS",
+		"OsdShowMemoryUsage", false);
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_TRIANGLE_EXCLAMATION, "Warn About Unsafe Settings"),
 		FSUI_CSTR("Displays warnings when settings are enabled which may break games."), "EmuCore", "WarnAboutUnsafeSettings", true);
 
@@ -3751,6 +3757,9 @@ void FullscreenUI::DrawBIOSSettingsPage()
 	MenuHeading(FSUI_CSTR("Options and Patches"));
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_FORWARD_FAST, "Fast Boot"), FSUI_CSTR("Skips the intro screen, and bypasses region checks."),
 		"EmuCore", "EnableFastBoot", true);
+	DrawToggleSetting(bsi, FSUI_CSTR("Cache BIOS Startup"),
+		FSUI_CSTR("Restores the state after BIOS startup on later fast boots, instead of running it again."), "EmuCore",
+		"EnableFastBootSnapshot", false, GetEffectiveBoolSetting(bsi, "EmuCore", "EnableFastBoot", true));
 
 	EndMenuButtons();
 }
@@ -3839,9 +3848,15 @@ void FullscreenUI::DrawEmulationSettingsPage()
 		ee_cycle_skip_settings, std::size(ee_cycle_skip_settings), true);
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_USERS, "Enable MTVU (Multi-Threaded VU1)"),
 		FSUI_CSTR("Generally a speedup on CPUs with 4 or more cores. Safe for most games, but a few are incompatible and may hang."), "EmuCore/Speedhacks", "vuThread", false);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_VIDEO, "Enable Threaded IPU"),
+		FSUI_CSTR("Decodes FMVs on a separate thread while the EE keeps running. May upset games sensitive to IPU timing."), "EmuCore/Speedhacks",
+		"ipuThread", false);
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_LOCATION_PIN_LOCK, "Thread Pinning"),
 		FSUI_CSTR("Pins emulation threads to CPU cores to potentially improve performance/frame time variance."), "EmuCore",
 		"EnableThreadPinning", false);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_MICROCHIP, "Use Huge Pages"),
+		FSUI_CSTR("Backs emulated memory and recompiled code with huge pages where the host supports it, reducing TLB misses."), "EmuCore",
+		"EnableHugePages", false);
 	DrawToggleSetting(
 		bsi, FSUI_ICONSTR(ICON_FA_FACE_ROLLING_EYES, "Enable Cheats"), FSUI_CSTR("Enables loading cheats from pnach files."), "EmuCore", "EnableCheats", false);
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_HARD_DRIVE, "Enable Host Filesystem"),
@@ -3855,6 +3870,18 @@ void FullscreenUI::DrawEmulationSettingsPage()
 
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPACT_DISC, "Enable CDVD Precaching"), FSUI_CSTR("Loads the disc image into RAM before starting the virtual machine."),
 		"EmuCore", "CdvdPrecache", false);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPACT_DISC, "Precache in Background"),
+		FSUI_CSTR("Starts the game immediately and loads the disc image into RAM while it runs, as far as available memory allows."),
+		"EmuCore", "CdvdBackgroundPrecache", false, GetEffectiveBoolSetting(bsi, "EmuCore", "CdvdPrecache", false));
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPACT_DISC, "Predict Disc Reads"),
+		FSUI_CSTR("Records which parts of the disc each game reads, and prefetches them on later runs before they are needed."),
+		"EmuCore", "CdvdReadPrediction", false);
+	DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_MICROCHIP, "Disc Decompression Threads"),
+		FSUI_CSTR("Decompresses CHD and CSO images ahead of sequential reads on this many threads. 0 disables parallel decompression."), "EmuCore",
+		"CdvdDecompressThreads", 2, 0, 16);
+	DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPACT_DISC, "CHD Prefetch Depth"),
+		FSUI_CSTR("Maximum number of CHD hunks to decompress ahead of the current read position."), "EmuCore", "CdvdPrefetchDepth", 32, 1,
+		256, FSUI_CSTR("%d hunks"));
 
 	MenuHeading(FSUI_CSTR("Frame Pacing/Latency Control"));
 
@@ -3881,6 +3908,12 @@ void FullscreenUI::DrawEmulationSettingsPage()
 		FSUI_CSTR("Disables PCSX2's internal frame timing, and uses host vsync instead."), "EmuCore/GS", "UseVSyncForTiming", false,
 		GetEffectiveBoolSetting(bsi, "EmuCore/GS", "VsyncEnable", false) && GetEffectiveBoolSetting(bsi, "EmuCore/GS", "SyncToHostRefreshRate", false));
 
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_GAMEPAD, "Reduce Input Latency"),
+		FSUI_CSTR("Delays the start of each frame so that input is read as late as possible."), "Framerate", "ReduceInputLatency", false);
+
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_BATTERY_HALF, "Power Saving Mode"),
+		FSUI_CSTR("Sleeps instead of spinning while waiting for frames, reducing CPU usage."), "Framerate", "PowerSaving", false);
+
 	EndMenuButtons();
 }
 
@@ -4186,6 +4219,9 @@ void FullscreenUI::DrawGraphicsSettingsPage(SettingsInterface* bsi, bool show_ad
 		DrawStringListSetting(bsi, FSUI_ICONSTR(ICON_FA_ARROW_UP_RIGHT_FROM_SQUARE, "Internal Resolution"),
 			FSUI_CSTR("Multiplies the render resolution by the specified factor (upscaling)."), "EmuCore/GS", "upscale_multiplier",
 			"1.000000", s_resolution_options, s_resolution_values, std::size(s_resolution_options), true);
+		DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_GAUGE_HIGH, "Dynamic Resolution"),
+			FSUI_CSTR("Lowers the internal resolution, then skips frames, when the GPU can't keep up with full speed."), "EmuCore/GS",
+			"DynamicResolution", false);
 		DrawIntListSetting(bsi, FSUI_ICONSTR(ICON_FA_TABLE_CELLS_LARGE, "Bilinear Filtering"),
 			FSUI_CSTR("Selects where bilinear filtering is utilized when rendering textures."), "EmuCore/GS", "filter",
 			static_cast<int>(BiFiltering::PS2), s_bilinear_options, std::size(s_bilinear_options), true);
@@ -4455,6 +4491,10 @@ void FullscreenUI::DrawGraphicsSettingsPage(SettingsInterface* bsi, bool show_ad
 			FSUI_CSTR("Skips displaying frames that don't change in 25/30fps games. Can improve speed, but increase input lag/make frame pacing "
 					  "worse."),
 			"EmuCore/GS", "SkipDuplicateFrames", false);
+		DrawToggleSetting(bsi, FSUI_CSTR("Throttle Presentation When Uncapped"),
+			FSUI_CSTR("Only presents as many frames as the display can show when fast forwarding or running uncapped. Speeds up "
+					  "fast forwarding when the GPU is the bottleneck."),
+			"EmuCore/GS", "ThrottleUncappedPresentation", false);
 		DrawToggleSetting(bsi, FSUI_CSTR("Disable Mailbox Presentation"),
 			FSUI_CSTR("Forces the use of FIFO over Mailbox presentation, i.e. double buffering instead of triple buffering. "
 					  "Usually results in worse frame pacing."),
@@ -4478,10 +4518,16 @@ void FullscreenUI::DrawGraphicsSettingsPage(SettingsInterface* bsi, bool show_ad
 			s_generic_options, std::size(s_generic_options), true, -1);
 		DrawIntListSetting(bsi, FSUI_CSTR("GS Dump Compression"), FSUI_CSTR("Sets the compression algorithm for GS dumps."), "EmuCore/GS",
 			"GSDumpCompression", static_cast<int>(GSDumpCompressionMethod::LZMA), s_gsdump_compression, std::size(s_gsdump_compression), true);
+		DrawIntSpinBoxSetting(bsi, FSUI_CSTR("GS Dump Replay Buffer"),
+			FSUI_CSTR("Keeps the last few seconds of GS data in memory, to be saved as a GS dump with a hotkey. 0 is disabled."),
+			"EmuCore/GS", "GSDumpReplayBuffer", 0, 0, 300, 5, FSUI_CSTR("%d s"));
 		DrawToggleSetting(bsi, FSUI_CSTR("Disable Framebuffer Fetch"),
 			FSUI_CSTR("Prevents the usage of framebuffer fetch when supported by host GPU."), "EmuCore/GS", "DisableFramebufferFetch", false);
 		DrawToggleSetting(bsi, FSUI_CSTR("Disable Shader Cache"), FSUI_CSTR("Prevents the loading and saving of shaders/pipelines to disk."),
 			"EmuCore/GS", "DisableShaderCache", false);
+		DrawToggleSetting(bsi, FSUI_CSTR("Asynchronous Shader Compilation"),
+			FSUI_CSTR("Compiles shaders in the background on OpenGL, skipping draws until they are ready."), "EmuCore/GS",
+			"AsyncShaderCompilation", false);
 		DrawToggleSetting(bsi, FSUI_CSTR("Disable Vertex Shader Expand"), FSUI_CSTR("Falls back to the CPU for expanding sprites/lines."),
 			"EmuCore/GS", "DisableVertexShaderExpand", false);
 		DrawIntListSetting(bsi, FSUI_CSTR("Texture Preloading"),
@@ -4489,6 +4535,15 @@ void FullscreenUI::DrawGraphicsSettingsPage(SettingsInterface* bsi, bool show_ad
 				"Uploads full textures to the GPU on use, rather than only the utilized regions. Can improve performance in some games."),
 			"EmuCore/GS", "texture_preloading", static_cast<int>(TexturePreloadingLevel::Off), s_preloading_options,
 			std::size(s_preloading_options), true);
+		DrawIntSpinBoxSetting(bsi, FSUI_CSTR("Hash Cache Budget"),
+			FSUI_CSTR("Limits the video memory used by preloaded textures, evicting the least recently used first. 0 is unlimited."),
+			"EmuCore/GS", "HashCacheBudget", 0, 0, 4096, 64, FSUI_CSTR("%d MB"));
+		DrawIntSpinBoxSetting(bsi, FSUI_CSTR("VRAM Budget"),
+			FSUI_CSTR("Limits the video memory used by the texture cache, writing idle targets back to GS memory when exceeded. 0 is unlimited."),
+			"EmuCore/GS", "VRAMBudget", 0, 0, 16384, 256, FSUI_CSTR("%d MB"));
+		DrawToggleSetting(bsi, FSUI_CSTR("GPU Texture Unswizzle"),
+			FSUI_CSTR("Unswizzles 32-bit and 24-bit textures on the GPU from a copy of GS memory instead of on the CPU."), "EmuCore/GS",
+			"GPUTextureUnswizzle", false);
 		DrawFloatRangeSetting(bsi, FSUI_CSTR("NTSC Frame Rate"), FSUI_CSTR("Determines what frame rate NTSC games run at."),
 							  "EmuCore/GS", "FrameRateNTSC", 59.94f, 10.0f, 300.0f, "%.2f Hz");
 		DrawFloatRangeSetting(bsi, FSUI_CSTR("PAL Frame Rate"), FSUI_CSTR("Determines what frame rate PAL games run at."),
@@ -4533,9 +4588,17 @@ void FullscreenUI::DrawAudioSettingsPage()
 		"SPU2/Output", "SyncMode", Pcsx2Config::SPU2Options::DEFAULT_SYNC_MODE,
 		&Pcsx2Config::SPU2Options::ParseSyncMode, &Pcsx2Config::SPU2Options::GetSyncModeName,
 		&Pcsx2Config::SPU2Options::GetSyncModeDisplayName, Pcsx2Config::SPU2Options::SPU2SyncMode::Count);
+	DrawEnumSetting(bsi, FSUI_ICONSTR(ICON_FA_ARROWS_SPIN, "Time Stretch Algorithm"),
+		FSUI_CSTR("Determines how audio is kept in sync when time stretching. Resample is much cheaper, but the pitch follows the speed."),
+		"SPU2/Output", "StretchAlgorithm", AudioStreamParameters::DEFAULT_STRETCH_ALGORITHM,
+		&AudioStream::ParseStretchAlgorithm, &AudioStream::GetStretchAlgorithmName,
+		&AudioStream::GetStretchAlgorithmDisplayName, AudioStretchAlgorithm::Count);
 	DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_BUCKET, "Buffer Size"),
 		FSUI_CSTR("Determines the amount of audio buffered before being pulled by the host API."),
 		"SPU2/Output", "BufferMS", AudioStreamParameters::DEFAULT_BUFFER_MS, 10, 500, FSUI_CSTR("%d ms"));
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_BUCKET, "Adaptive Buffer Size"),
+		FSUI_CSTR("Lowers the buffer size while the host keeps up, and raises it again when audio runs dry."),
+		"SPU2/Output", "AdaptiveBufferSize", AudioStreamParameters::DEFAULT_ADAPTIVE_BUFFER);
 	if (!GetEffectiveBoolSetting(bsi, "Audio", "OutputLatencyMinimal", AudioStreamParameters::DEFAULT_OUTPUT_LATENCY_MINIMAL))
 	{
 		DrawIntRangeSetting(
@@ -4547,6 +4610,9 @@ void FullscreenUI::DrawAudioSettingsPage()
 	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_STOPWATCH, "Minimal Output Latency"),
 		FSUI_CSTR("When enabled, the minimum supported output latency will be used for the host API."),
 		"SPU2/Output", "OutputLatencyMinimal", AudioStreamParameters::DEFAULT_OUTPUT_LATENCY_MINIMAL);
+	DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_MICROCHIP, "Threaded Audio Output"),
+		FSUI_CSTR("Moves resampling, time stretching and expansion of the audio output to a separate thread."),
+		"SPU2/Output", "ThreadedOutput", false);
 
 	EndMenuButtons();
 }
@@ -5427,6 +5493,12 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable Fast Memory Access"),
 			FSUI_CSTR("Uses backpatching to avoid register flushing on every memory access."), "EmuCore/CPU/Recompiler", "EnableFastmem",
 			true);
+		DrawToggleSetting(bsi, FSUI_CSTR("Enable Persistent Block Cache"),
+			FSUI_CSTR("Remembers which code blocks a game compiled, and compiles them up front on the next boot."),
+			"EmuCore/CPU/Recompiler", "EnableEEBlockCache", false);
+		DrawToggleSetting(bsi, FSUI_CSTR("Enable Hot Block Recompilation"),
+			FSUI_CSTR("Recompiles frequently executed code into larger blocks, keeping registers and constants across block boundaries."),
+			"EmuCore/CPU/Recompiler", "EnableEEHotBlocks", false);
 
 		MenuHeading(FSUI_CSTR("Vector Units"));
 		DrawIntListSetting(bsi, FSUI_CSTR("VU0 Rounding Mode"),
@@ -5452,6 +5524,12 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable Instant VU1"),
 			FSUI_CSTR("Runs VU1 instantly. Provides a modest speed improvement in most games. Safe for most games, but a few games may exhibit graphical errors."),
 			"EmuCore/Speedhacks", "vu1Instant", true);
+		DrawToggleSetting(bsi, FSUI_CSTR("Enable Persistent VU1 Program Cache"),
+			FSUI_CSTR("Remembers which VU1 microprograms a game ran, and compiles them up front on the next boot."),
+			"EmuCore/CPU/Recompiler", "EnableVUProgramCache", false);
+		DrawToggleSetting(bsi, FSUI_CSTR("Enable Persistent VIF Unpack Cache"),
+			FSUI_CSTR("Remembers which VIF unpack variants a game used, and generates them up front on the next boot."),
+			"EmuCore/CPU/Recompiler", "EnableVIFUnpackCache", false);
 
 		MenuHeading(FSUI_CSTR("I/O Processor"));
 		DrawToggleSetting(bsi, FSUI_CSTR("Enable IOP Recompiler"),
@@ -5463,6 +5541,18 @@ void FullscreenUI::DrawAdvancedSettingsPage()
 			"SavestateCompressionType", static_cast<int>(SavestateCompressionMethod::Zstandard), s_savestate_compression_type, std::size(s_savestate_compression_type), true);
 		DrawIntListSetting(bsi, FSUI_ICONSTR(ICON_FA_COMPRESS, "Compression Level"), FSUI_CSTR("Sets the compression level for savestate."), "EmuCore",
 			"SavestateCompressionRatio", static_cast<int>(SavestateCompressionLevel::Medium), s_savestate_compression_ratio, std::size(s_savestate_compression_ratio), true);
+		DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_CLOCK_ROTATE_LEFT, "Enable Rewind"),
+			FSUI_CSTR("Keeps recent states in memory so the game can be rewound with the rewind hotkey."), "EmuCore", "EnableRewind", false);
+		const bool rewind_enabled = GetEffectiveBoolSetting(bsi, "EmuCore", "EnableRewind", false);
+		DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_STOPWATCH, "Rewind Save Frequency"),
+			FSUI_CSTR("Number of frames between rewind states. Lower values rewind more smoothly, but use more memory and CPU time."),
+			"EmuCore", "RewindFrequency", 10, 1, 600, FSUI_CSTR("%d frames"), rewind_enabled);
+		DrawIntRangeSetting(bsi, FSUI_ICONSTR(ICON_FA_DATABASE, "Rewind Buffer Size"),
+			FSUI_CSTR("Maximum amount of memory used for rewind states. The oldest states are discarded once it is reached."), "EmuCore",
+			"RewindBufferSize", 512, 64, 8192, FSUI_CSTR("%d MB"), rewind_enabled);
+		DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_IMAGES, "Save Texture Cache Layout"),
+			FSUI_CSTR("Stores the hardware renderer's render targets in savestates, so they are rebuilt on load instead of over the following frames."),
+			"EmuCore", "SaveTextureCacheTargets", false);
 
 		MenuHeading(FSUI_CSTR("Graphics"));
 		DrawToggleSetting(bsi, FSUI_ICONSTR(ICON_FA_BUG, "Use Debug Device"), FSUI_CSTR("Enables API-level validation of graphics commands."), "EmuCore/GS",
@@ -5568,6 +5658,8 @@ void FullscreenUI::DrawGameFixesSettingsPage()
 		false, false, ImGuiFullscreen::LAYOUT_MENU_BUTTON_HEIGHT_NO_SUMMARY);
 
 	DrawToggleSetting(bsi, FSUI_CSTR("FPU Multiply Hack"), FSUI_CSTR("For Tales of Destiny."), "EmuCore/Gamefixes", "FpuMulHack", false);
+	DrawToggleSetting(bsi, FSUI_CSTR("Accurate Single-Precision FPU"),
+		FSUI_CSTR("PS2-like overflow clamping and flags without the cost of full FPU mode."), "EmuCore/Gamefixes", "FpuAccurateHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("Use Software Renderer For FMVs"),
 		FSUI_CSTR("Needed for some games with complex FMV rendering."), "EmuCore/Gamefixes", "SoftwareRendererFMVHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("Skip MPEG Hack"), FSUI_CSTR("Skips videos/FMVs in games to avoid game hanging/freezes."),
@@ -5588,12 +5680,21 @@ void FullscreenUI::DrawGameFixesSettingsPage()
 	DrawToggleSetting(bsi, FSUI_CSTR("DMA Busy Hack"),
 		FSUI_CSTR("Known to affect following games: Mana Khemia 1, Metal Saga, Pilot Down Behind Enemy Lines."), "EmuCore/Gamefixes",
 		"DMABusyHack", false);
+	DrawToggleSetting(bsi, FSUI_CSTR("Split DMA Transfers"),
+		FSUI_CSTR("Splits GIF and VIF1 DMA transfers into short slices even when nothing else is running on the DMAC. Slower, for games sensitive to DMA timing."),
+		"EmuCore/Gamefixes", "DMASliceHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("Delay VIF1 Stalls"), FSUI_CSTR("For SOCOM 2 HUD and Spy Hunter loading hang."),
 		"EmuCore/Gamefixes", "VIF1StallHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("Emulate VIF FIFO"),
 		FSUI_CSTR("Simulate VIF1 FIFO read ahead. Known to affect following games: Test Drive Unlimited, Transformers."), "EmuCore/Gamefixes", "VIFFIFOHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("Full VU0 Synchronization"), FSUI_CSTR("Forces tight VU0 sync on every COP2 instruction."),
 		"EmuCore/Gamefixes", "FullVU0SyncHack", false);
+	DrawToggleSetting(bsi, FSUI_CSTR("MTVU Stale VU1 Reads"),
+		FSUI_CSTR("Lets reads of VU1 memory skip waiting for the MTVU thread. Only for games known to poll VU1 safely."),
+		"EmuCore/Gamefixes", "MTVUStaleReadHack", false);
+	DrawToggleSetting(bsi, FSUI_CSTR("Emulate EE Data Cache"),
+		FSUI_CSTR("Emulates the EE data cache in the interpreter and recompiler. Slower, only for games which rely on it."),
+		"EmuCore/Gamefixes", "EECacheHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("VU I Bit Hack"),
 		FSUI_CSTR("Avoids constant recompilation in some games. Known to affect the following games: Scarface The World is Yours, Crash Tag Team Racing."), "EmuCore/Gamefixes", "IbitHack", false);
 	DrawToggleSetting(bsi, FSUI_CSTR("VU Add Hack"),
@@ -8102,6 +8203,7 @@ TRANSLATE_NOOP("FullscreenUI", "Shows the current emulation speed of the system
 TRANSLATE_NOOP("FullscreenUI", "Shows the number of video frames (or v-syncs) displayed per second by the system in the top-right corner of the display.");
 TRANSLATE_NOOP("FullscreenUI", "Shows the CPU usage based on threads in the top-right corner of the display.");
 TRANSLATE_NOOP("FullscreenUI", "Shows the host's GPU usage in the top-right corner of the display.");
+TRANSLATE_NOOP("FullscreenUI", "Shows how much GPU time is spent on draws, conversions, readbacks, post-processing and presentation.");
 TRANSLATE_NOOP("FullscreenUI", "Shows the resolution of the game in the top-right corner of the display.");
 TRANSLATE_NOOP("FullscreenUI", "Shows statistics about GS (primitives, draw calls) in the top-right corner of the display.");
 TRANSLATE_NOOP("FullscreenUI", "Shows indicators when fast forwarding, pausing, and other abnormal states are active.");
@@ -8111,6 +8213,7 @@ TRANSLATE_NOOP("FullscreenUI", "Shows the current configuration in the bottom-ri
 TRANSLATE_NOOP("FullscreenUI", "Shows the current controller state of the system in the bottom-left corner of the display.");
 TRANSLATE_NOOP("FullscreenUI", "Shows a visual history of frame times in the upper-left corner of the display.");
 TRANSLATE_NOOP("FullscreenUI", "Shows the current system hardware information on the OSD.");
+TRANSLATE_NOOP("FullscreenUI", "Shows how much memory the emulator and each of its subsystems are using on the OSD.");
 TRANSLATE_NOOP("FullscreenUI", "Displays warnings when settings are enabled which may break games.");
 TRANSLATE_NOOP("FullscreenUI", "Determines where on-screen display messages are positioned.");
 TRANSLATE_NOOP("FullscreenUI", "Determines where performance statistics are positioned.");
@@ -8134,12 +8237,18 @@ TRANSLATE_NOOP("FullscreenUI", "Enables loading cheats from pnach files.");
 TRANSLATE_NOOP("FullscreenUI", "Enables access to files from the host: namespace in the virtual machine.");
 TRANSLATE_NOOP("FullscreenUI", "Fast disc access, less loading times. Not recommended.");
 TRANSLATE_NOOP("FullscreenUI", "Loads the disc image into RAM before starting the virtual machine.");
+TRANSLATE_NOOP("FullscreenUI", "Starts the game immediately and loads the disc image into RAM while it runs, as far as available memory allows.");
+TRANSLATE_NOOP("FullscreenUI", "Decompresses CHD and CSO images ahead of sequential reads on this many threads. 0 disables parallel decompression.");
+TRANSLATE_NOOP("FullscreenUI", "Maximum number of CHD hunks to decompress ahead of the current read position.");
+TRANSLATE_NOOP("FullscreenUI", "%d hunks");
 TRANSLATE_NOOP("FullscreenUI", "Frame Pacing/Latency Control");
 TRANSLATE_NOOP("FullscreenUI", "Sets the number of frames which can be queued.");
 TRANSLATE_NOOP("FullscreenUI", "Synchronize EE and GS threads after each frame. Lowest input latency, but increases system requirements.");
 TRANSLATE_NOOP("FullscreenUI", "Synchronizes frame presentation with host refresh.");
 TRANSLATE_NOOP("FullscreenUI", "Speeds up emulation so that the guest refresh rate matches the host.");
 TRANSLATE_NOOP("FullscreenUI", "Disables PCSX2's internal frame timing, and uses host vsync instead.");
+TRANSLATE_NOOP("FullscreenUI", "Delays the start of each frame so that input is read as late as possible.");
+TRANSLATE_NOOP("FullscreenUI", "Sleeps instead of spinning while waiting for frames, reducing CPU usage.");
 TRANSLATE_NOOP("FullscreenUI", "Graphics API");
 TRANSLATE_NOOP("FullscreenUI", "Selects the API used to render the emulated GS.");
 TRANSLATE_NOOP("FullscreenUI", "Display");
@@ -8161,6 +8270,8 @@ TRANSLATE_NOOP("FullscreenUI", "Enables the option to show the overscan area on
 TRANSLATE_NOOP("FullscreenUI", "Enables internal Anti-Blur hacks. Less accurate to PS2 rendering but will make a lot of games look less blurry.");
 TRANSLATE_NOOP("FullscreenUI", "Rendering");
 TRANSLATE_NOOP("FullscreenUI", "Multiplies the render resolution by the specified factor (upscaling).");
+TRANSLATE_NOOP("FullscreenUI", "Dynamic Resolution");
+TRANSLATE_NOOP("FullscreenUI", "Lowers the internal resolution, then skips frames, when the GPU can't keep up with full speed.");
 TRANSLATE_NOOP("FullscreenUI", "Selects where bilinear filtering is utilized when rendering textures.");
 TRANSLATE_NOOP("FullscreenUI", "Selects where trilinear filtering is utilized when rendering textures.");
 TRANSLATE_NOOP("FullscreenUI", "Selects where anisotropic filtering is utilized when rendering textures.");
@@ -8248,6 +8359,10 @@ TRANSLATE_NOOP("FullscreenUI", "Applies a shader which replicates the visual eff
 TRANSLATE_NOOP("FullscreenUI", "Advanced");
 TRANSLATE_NOOP("FullscreenUI", "Skip Presenting Duplicate Frames");
 TRANSLATE_NOOP("FullscreenUI", "Skips displaying frames that don't change in 25/30fps games. Can improve speed, but increase input lag/make frame pacing worse.");
+TRANSLATE_NOOP("FullscreenUI", "Throttle Presentation When Uncapped");
+TRANSLATE_NOOP("FullscreenUI", "Cache BIOS Startup");
+TRANSLATE_NOOP("FullscreenUI", "Restores the state after BIOS startup on later fast boots, instead of running it again.");
+TRANSLATE_NOOP("FullscreenUI", "Only presents as many frames as the display can show when fast forwarding or running uncapped. Speeds up fast forwarding when the GPU is the bottleneck.");
 TRANSLATE_NOOP("FullscreenUI", "Disable Mailbox Presentation");
 TRANSLATE_NOOP("FullscreenUI", "Forces the use of FIFO over Mailbox presentation, i.e. double buffering instead of triple buffering. Usually results in worse frame pacing.");
 TRANSLATE_NOOP("FullscreenUI", "Extended Upscaling Multipliers");
@@ -8264,10 +8379,19 @@ TRANSLATE_NOOP("FullscreenUI", "Disable Framebuffer Fetch");
 TRANSLATE_NOOP("FullscreenUI", "Prevents the usage of framebuffer fetch when supported by host GPU.");
 TRANSLATE_NOOP("FullscreenUI", "Disable Shader Cache");
 TRANSLATE_NOOP("FullscreenUI", "Prevents the loading and saving of shaders/pipelines to disk.");
+TRANSLATE_NOOP("FullscreenUI", "Asynchronous Shader Compilation");
+TRANSLATE_NOOP("FullscreenUI", "Compiles shaders in the background on OpenGL, skipping draws until they are ready.");
 TRANSLATE_NOOP("FullscreenUI", "Disable Vertex Shader Expand");
 TRANSLATE_NOOP("FullscreenUI", "Falls back to the CPU for expanding sprites/lines.");
 TRANSLATE_NOOP("FullscreenUI", "Texture Preloading");
 TRANSLATE_NOOP("FullscreenUI", "Uploads full textures to the GPU on use, rather than only the utilized regions. Can improve performance in some games.");
+TRANSLATE_NOOP("FullscreenUI", "Hash Cache Budget");
+TRANSLATE_NOOP("FullscreenUI", "Limits the video memory used by preloaded textures, evicting the least recently used first. 0 is unlimited.");
+TRANSLATE_NOOP("FullscreenUI", "VRAM Budget");
+TRANSLATE_NOOP("FullscreenUI", "Limits the video memory used by the texture cache, writing idle targets back to GS memory when exceeded. 0 is unlimited.");
+TRANSLATE_NOOP("FullscreenUI", "%d MB");
+TRANSLATE_NOOP("FullscreenUI", "GPU Texture Unswizzle");
+TRANSLATE_NOOP("FullscreenUI", "Unswizzles 32-bit and 24-bit textures on the GPU from a copy of GS memory instead of on the CPU.");
 TRANSLATE_NOOP("FullscreenUI", "NTSC Frame Rate");
 TRANSLATE_NOOP("FullscreenUI", "Determines what frame rate NTSC games run at.");
 TRANSLATE_NOOP("FullscreenUI", "PAL Frame Rate");
@@ -8280,6 +8404,7 @@ TRANSLATE_NOOP("FullscreenUI", "Backend Settings");
 TRANSLATE_NOOP("FullscreenUI", "The audio backend determines how frames produced by the emulator are submitted to the host.");
 TRANSLATE_NOOP("FullscreenUI", "Determines how audio is expanded from stereo to surround for supported games.");
 TRANSLATE_NOOP("FullscreenUI", "Changes when SPU samples are generated relative to system emulation.");
+TRANSLATE_NOOP("FullscreenUI", "Determines how audio is kept in sync when time stretching. Resample is much cheaper, but the pitch follows the speed.");
 TRANSLATE_NOOP("FullscreenUI", "Determines the amount of audio buffered before being pulled by the host API.");
 TRANSLATE_NOOP("FullscreenUI", "%d ms");
 TRANSLATE_NOOP("FullscreenUI", "Determines how much latency there is between the audio being picked up by the host API, and played through speakers.");
@@ -8337,6 +8462,10 @@ TRANSLATE_NOOP("FullscreenUI", "Enable Wait Loop Detection");
 TRANSLATE_NOOP("FullscreenUI", "Moderate speedup for some games, with no known side effects.");
 TRANSLATE_NOOP("FullscreenUI", "Enable Fast Memory Access");
 TRANSLATE_NOOP("FullscreenUI", "Uses backpatching to avoid register flushing on every memory access.");
+TRANSLATE_NOOP("FullscreenUI", "Enable Persistent Block Cache");
+TRANSLATE_NOOP("FullscreenUI", "Remembers which code blocks a game compiled, and compiles them up front on the next boot.");
+TRANSLATE_NOOP("FullscreenUI", "Enable Hot Block Recompilation");
+TRANSLATE_NOOP("FullscreenUI", "Recompiles frequently executed code into larger blocks, keeping registers and constants across block boundaries.");
 TRANSLATE_NOOP("FullscreenUI", "Vector Units");
 TRANSLATE_NOOP("FullscreenUI", "VU0 Rounding Mode");
 TRANSLATE_NOOP("FullscreenUI", "VU0 Clamping Mode");
@@ -8349,6 +8478,10 @@ TRANSLATE_NOOP("FullscreenUI", "Enable VU Flag Optimization");
 TRANSLATE_NOOP("FullscreenUI", "Good speedup and high compatibility, may cause graphical errors.");
 TRANSLATE_NOOP("FullscreenUI", "Enable Instant VU1");
 TRANSLATE_NOOP("FullscreenUI", "Runs VU1 instantly. Provides a modest speed improvement in most games. Safe for most games, but a few games may exhibit graphical errors.");
+TRANSLATE_NOOP("FullscreenUI", "Enable Persistent VU1 Program Cache");
+TRANSLATE_NOOP("FullscreenUI", "Remembers which VU1 microprograms a game ran, and compiles them up front on the next boot.");
+TRANSLATE_NOOP("FullscreenUI", "Enable Persistent VIF Unpack Cache");
+TRANSLATE_NOOP("FullscreenUI", "Remembers which VIF unpack variants a game used, and generates them up front on the next boot.");
 TRANSLATE_NOOP("FullscreenUI", "I/O Processor");
 TRANSLATE_NOOP("FullscreenUI", "Enable IOP Recompiler");
 TRANSLATE_NOOP("FullscreenUI", "Performs just-in-time binary translation of 32-bit MIPS-I machine code to native code.");
@@ -8385,12 +8518,16 @@ TRANSLATE_NOOP("FullscreenUI", "Emulate GIF FIFO");
 TRANSLATE_NOOP("FullscreenUI", "Correct but slower. Known to affect the following games: Fifa Street 2.");
 TRANSLATE_NOOP("FullscreenUI", "DMA Busy Hack");
 TRANSLATE_NOOP("FullscreenUI", "Known to affect following games: Mana Khemia 1, Metal Saga, Pilot Down Behind Enemy Lines.");
+TRANSLATE_NOOP("FullscreenUI", "Split DMA Transfers");
+TRANSLATE_NOOP("FullscreenUI", "Splits GIF and VIF1 DMA transfers into short slices even when nothing else is running on the DMAC. Slower, for games sensitive to DMA timing.");
 TRANSLATE_NOOP("FullscreenUI", "Delay VIF1 Stalls");
 TRANSLATE_NOOP("FullscreenUI", "For SOCOM 2 HUD and Spy Hunter loading hang.");
 TRANSLATE_NOOP("FullscreenUI", "Emulate VIF FIFO");
 TRANSLATE_NOOP("FullscreenUI", "Simulate VIF1 FIFO read ahead. Known to affect following games: Test Drive Unlimited, Transformers.");
 TRANSLATE_NOOP("FullscreenUI", "Full VU0 Synchronization");
 TRANSLATE_NOOP("FullscreenUI", "Forces tight VU0 sync on every COP2 instruction.");
+TRANSLATE_NOOP("FullscreenUI", "MTVU Stale VU1 Reads");
+TRANSLATE_NOOP("FullscreenUI", "Lets reads of VU1 memory skip waiting for the MTVU thread. Only for games known to poll VU1 safely.");
 TRANSLATE_NOOP("FullscreenUI", "VU I Bit Hack");
 TRANSLATE_NOOP("FullscreenUI", "Avoids constant recompilation in some games. Known to affect the following games: Scarface The World is Yours, Crash Tag Team Racing.");
 TRANSLATE_NOOP("FullscreenUI", "VU Add Hack");
@@ -8752,6 +8889,7 @@ TRANSLATE_NOOP("FullscreenUI", "Show Speed");
 TRANSLATE_NOOP("FullscreenUI", "Show FPS");
 TRANSLATE_NOOP("FullscreenUI", "Show CPU Usage");
 TRANSLATE_NOOP("FullscreenUI", "Show GPU Usage");
+TRANSLATE_NOOP("FullscreenUI", "Show GPU Time Breakdown");
 TRANSLATE_NOOP("FullscreenUI", "Show Resolution");
 TRANSLATE_NOOP("FullscreenUI", "Show GS Statistics");
 TRANSLATE_NOOP("FullscreenUI", "Show Status Indicators");
@@ -8761,6 +8899,7 @@ TRANSLATE_NOOP("FullscreenUI", "Show Settings");
 TRANSLATE_NOOP("FullscreenUI", "Show Inputs");
 TRANSLATE_NOOP("FullscreenUI", "Show Frame Times");
 TRANSLATE_NOOP("FullscreenUI", "Show Hardware Info");
+TRANSLATE_NOOP("FullscreenUI", "Show Memory Usage");
 TRANSLATE_NOOP("FullscreenUI", "Warn About Unsafe Settings");
 TRANSLATE_NOOP("FullscreenUI", "OSD Messages Position");
 TRANSLATE_NOOP("FullscreenUI", "OSD Performance Position");
@@ -8777,11 +8916,16 @@ TRANSLATE_NOOP("FullscreenUI", "Thread Pinning");
 TRANSLATE_NOOP("FullscreenUI", "Enable Host Filesystem");
 TRANSLATE_NOOP("FullscreenUI", "Enable Fast CDVD");
 TRANSLATE_NOOP("FullscreenUI", "Enable CDVD Precaching");
+TRANSLATE_NOOP("FullscreenUI", "Precache in Background");
+TRANSLATE_NOOP("FullscreenUI", "Disc Decompression Threads");
+TRANSLATE_NOOP("FullscreenUI", "CHD Prefetch Depth");
 TRANSLATE_NOOP("FullscreenUI", "Maximum Frame Latency");
 TRANSLATE_NOOP("FullscreenUI", "Optimal Frame Pacing");
 TRANSLATE_NOOP("FullscreenUI", "Vertical Sync (VSync)");
 TRANSLATE_NOOP("FullscreenUI", "Sync to Host Refresh Rate");
 TRANSLATE_NOOP("FullscreenUI", "Use Host VSync Timing");
+TRANSLATE_NOOP("FullscreenUI", "Reduce Input Latency");
+TRANSLATE_NOOP("FullscreenUI", "Power Saving Mode");
 TRANSLATE_NOOP("FullscreenUI", "Aspect Ratio");
 TRANSLATE_NOOP("FullscreenUI", "FMV Aspect Ratio Override");
 TRANSLATE_NOOP("FullscreenUI", "Deinterlacing");
@@ -8828,6 +8972,7 @@ TRANSLATE_NOOP("FullscreenUI", "Mute All Sound");
 TRANSLATE_NOOP("FullscreenUI", "Audio Backend");
 TRANSLATE_NOOP("FullscreenUI", "Expansion");
 TRANSLATE_NOOP("FullscreenUI", "Synchronization");
+TRANSLATE_NOOP("FullscreenUI", "Time Stretch Algorithm");
 TRANSLATE_NOOP("FullscreenUI", "Buffer Size");
 TRANSLATE_NOOP("FullscreenUI", "Output Latency");
 TRANSLATE_NOOP("FullscreenUI", "Minimal Output Latency");
@@ -8950,5 +9095,22 @@ TRANSLATE_NOOP("FullscreenUI", "Game not loaded or no RetroAchievements availabl
 TRANSLATE_NOOP("FullscreenUI", "Card Enabled");
 TRANSLATE_NOOP("FullscreenUI", "Card Name");
 TRANSLATE_NOOP("FullscreenUI", "Eject Card");
+TRANSLATE_NOOP("FullscreenUI", "Enable Rewind");
+TRANSLATE_NOOP("FullscreenUI", "Keeps recent states in memory so the game can be rewound with the rewind hotkey.");
+TRANSLATE_NOOP("FullscreenUI", "Rewind Save Frequency");
+TRANSLATE_NOOP("FullscreenUI", "Number of frames between rewind states. Lower values rewind more smoothly, but use more memory and CPU time.");
+TRANSLATE_NOOP("FullscreenUI", "%d frames");
+TRANSLATE_NOOP("FullscreenUI", "Rewind Buffer Size");
+TRANSLATE_NOOP("FullscreenUI", "Maximum amount of memory used for rewind states. The oldest states are discarded once it is reached.");
+TRANSLATE_NOOP("FullscreenUI", "Use Huge Pages");
+TRANSLATE_NOOP("FullscreenUI", "Backs emulated memory and recompiled code with huge pages where the host supports it, reducing TLB misses.");
+TRANSLATE_NOOP("FullscreenUI", "Save Texture Cache Layout");
+TRANSLATE_NOOP("FullscreenUI", "Stores the hardware renderer's render targets in savestates, so they are rebuilt on load instead of over the following frames.");
+TRANSLATE_NOOP("FullscreenUI", "Threaded Audio Output");
+TRANSLATE_NOOP("FullscreenUI", "Moves resampling, time stretching and expansion of the audio output to a separate thread.");
+TRANSLATE_NOOP("FullscreenUI", "Adaptive Buffer Size");
+TRANSLATE_NOOP("FullscreenUI", "Lowers the buffer size while the host keeps up, and raises it again when audio runs dry.");
+TRANSLATE_NOOP("FullscreenUI", "Enable Threaded IPU");
+TRANSLATE_NOOP("FullscreenUI", "Decodes FMVs on a separate thread while the EE keeps running. May upset games sensitive to IPU timing.");
 // TRANSLATION-STRING-AREA-END
 #endif
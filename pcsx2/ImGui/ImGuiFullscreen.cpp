@@ -97,6 +97,7 @@ namespace ImGuiFullscreen
 	static std::mutex s_texture_load_mutex;
 	static std::condition_variable s_texture_load_cv;
 	static std::deque<std::string> s_texture_load_queue;
+	static constexpr size_t MAX_PENDING_TEXTURE_LOADS = 64;
 	static std::deque<std::tuple<std::string, ImVec2, SvgScaling>> s_svg_texture_load_queue;
 	static std::deque<std::pair<std::string, RGBA8Image>> s_texture_upload_queue;
 	static Threading::Thread s_texture_load_thread;
@@ -369,6 +370,16 @@ GSTexture* ImGuiFullscreen::GetCachedTextureAsync(std::string_view name)
 		// queue the actual load
 		std::unique_lock lock(s_texture_load_mutex);
 		s_texture_load_queue.emplace_back(name);
+
+		// When scrolling quickly through the game grid, most of the queue is for covers which have already
+		// gone off-screen. Drop the oldest requests and their placeholders, so they get requested again if
+		// they come back into view, instead of delaying the visible ones and then evicting them from the cache.
+		while (s_texture_load_queue.size() > MAX_PENDING_TEXTURE_LOADS)
+		{
+			s_texture_cache.Remove(s_texture_load_queue.front());
+			s_texture_load_queue.pop_front();
+		}
+
 		s_texture_load_cv.notify_one();
 	}
 
@@ -578,8 +589,9 @@ void ImGuiFullscreen::TextureLoaderThread()
 
 		while (!s_texture_load_queue.empty())
 		{
-			std::string path(std::move(s_texture_load_queue.front()));
-			s_texture_load_queue.pop_front();
+			// newest first, those are the ones currently on screen
+			std::string path(std::move(s_texture_load_queue.back()));
+			s_texture_load_queue.pop_back();
 
 			lock.unlock();
 			std::optional<RGBA8Image> image(LoadTextureImage(path.c_str()));
@@ -7,6 +7,7 @@
 #include "GS.h"
 #include "GS/GS.h"
 #include "GS/GSCapture.h"
+#include "GS/GSPerfMon.h"
 #include "GS/GSVector.h"
 #include "GS/Renderers/Common/GSDevice.h"
 #include "Host.h"
@@ -36,6 +37,7 @@
 #include "fmt/format.h"
 #include "imgui.h"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
@@ -113,6 +115,23 @@ bool ShouldUseLeftAlignment(OsdOverlayPos position)
 	return (position == OsdOverlayPos::TopLeft || position == OsdOverlayPos::CenterLeft || position == OsdOverlayPos::BottomLeft);
 }
 
+namespace
+{
+	// The frame time graph only changes when a new sample comes in, so its points are kept
+	// around between frames and drawn as one polyline, instead of going through PlotEx().
+	struct FrameTimeGraph
+	{
+		std::array<ImVec2, PerformanceMetrics::NUM_FRAME_TIME_SAMPLES> points;
+		u64 frame_number = std::numeric_limits<u64>::max();
+		ImVec2 pos;
+		ImVec2 size;
+		float min = 0.0f;
+		float max = 0.0f;
+	};
+} // namespace
+
+static FrameTimeGraph s_frame_time_graph;
+
 namespace ImGuiManager
 {
 	static void FormatProcessorStat(SmallStringBase& text, double usage, double time);
@@ -283,6 +302,11 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			if (!text.empty())
 				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
+			text.clear();
+			GSgetCacheStats(text);
+			if (!text.empty())
+				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+
 			text.clear();
 			text.append_format("{} QF | Min: {:.2f}ms | Avg: {:.2f}ms | Max: {:.2f}ms",
 				MTGS::GetCurrentVsyncQueueSize() - 1, // we subtract one for the current frame
@@ -290,6 +314,14 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				PerformanceMetrics::GetAverageFrameTime(),
 				PerformanceMetrics::GetMaximumFrameTime());
 			DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+
+			text.clear();
+			text.append_format("MTGS: {:.1f} Wakes | {:.1f} Syncs | Stall: {:.2f}ms | Sync: {:.2f}ms",
+				PerformanceMetrics::GetMTGSWakesPerFrame(),
+				PerformanceMetrics::GetMTGSSyncsPerFrame(),
+				PerformanceMetrics::GetMTGSStallTime(),
+				PerformanceMetrics::GetMTGSSyncTime());
+			DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 		}
 
 		if (GSConfig.OsdShowResolution)
@@ -324,6 +356,29 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 		}
 
+		if (GSConfig.OsdShowMemoryUsage)
+		{
+			static constexpr float MB = 1.0f / static_cast<float>(_1mb);
+
+			text.clear();
+			text.append_format("Memory: {:.1f} MB", static_cast<float>(PerformanceMetrics::GetProcessMemoryUsage()) * MB);
+			DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+
+			// Skip the categories which aren't in use, e.g. the texture cache with the SW renderer.
+			for (u32 i = 0; i < static_cast<u32>(PerformanceMetrics::MemoryUsageCategory::Count); i++)
+			{
+				const PerformanceMetrics::MemoryUsageCategory category = static_cast<PerformanceMetrics::MemoryUsageCategory>(i);
+				const u64 usage = PerformanceMetrics::GetMemoryUsage(category);
+				if (usage == 0)
+					continue;
+
+				text.clear();
+				text.append_format("  {}: {:.1f} MB", PerformanceMetrics::GetMemoryUsageCategoryName(category),
+					static_cast<float>(usage) * MB);
+				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+		}
+
 		if (GSConfig.OsdShowCPU)
 		{
 			text.clear();
@@ -360,6 +415,20 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				FormatProcessorStat(text, PerformanceMetrics::GetCaptureThreadUsage(), PerformanceMetrics::GetCaptureThreadAverageTime());
 				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 			}
+
+			if (const u32 fastmem_faults = PerformanceMetrics::GetFastmemFaultCount(); fastmem_faults > 0)
+			{
+				text.clear();
+				text.append_format("Fastmem: {:.1f} Faults | {} Total | {} Slow Blocks",
+					PerformanceMetrics::GetFastmemFaultsPerFrame(), fastmem_faults,
+					PerformanceMetrics::GetFastmemSlowBlockCount());
+				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+
+			text.clear();
+			text.append_format("Audio: {} ms buffered | {} ms target | {} Underruns", PerformanceMetrics::GetAudioBufferedMS(),
+				PerformanceMetrics::GetAudioTargetBufferMS(), PerformanceMetrics::GetAudioUnderrunCount());
+			DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 		}
 
 		if (GSConfig.OsdShowGPU)
@@ -369,6 +438,25 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 		}
 
+		if (GSConfig.OsdShowGPUBreakdown)
+		{
+			static constexpr std::array<std::pair<const char*, GSPerfMon::counter_t>, 6> categories = {{
+				{"Conversions", GSPerfMon::GPUTimeConversion},
+				{"Draws", GSPerfMon::GPUTimeDraw},
+				{"Shuffles", GSPerfMon::GPUTimeShuffle},
+				{"Readbacks", GSPerfMon::GPUTimeReadback},
+				{"Post-Processing", GSPerfMon::GPUTimePostProcess},
+				{"Present", GSPerfMon::GPUTimePresent},
+			}};
+
+			for (const auto& [name, counter] : categories)
+			{
+				text.clear();
+				text.append_format("{}: {:.2f}ms", name, g_perfmon.Get(counter));
+				DRAW_LINE(fixed_font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
+			}
+		}
+
 		if (GSConfig.OsdShowIndicators)
 		{
 			const float target_speed = VMManager::GetTargetSpeed();
@@ -403,27 +491,53 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 			ImGui::PushFont(fixed_font, font_size);
 			if (ImGui::Begin("##frame_times", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs))
 			{
-				auto [min, max] = GetMinMax(PerformanceMetrics::GetFrameTimeHistory());
+				ImDrawList* win_dl = ImGui::GetCurrentWindow()->DrawList;
+				const ImVec2 wpos(ImGui::GetCurrentWindow()->Pos);
 
-				// add a little bit of space either side, so we're not constantly resizing
-				if ((max - min) < 4.0f)
+				FrameTimeGraph& graph = s_frame_time_graph;
+				const u64 frame_number = PerformanceMetrics::GetFrameNumber();
+				const bool new_sample = (graph.frame_number != frame_number);
+				if (new_sample)
 				{
-					min = min - std::fmod(min, 1.0f);
-					max = max - std::fmod(max, 1.0f) + 1.0f;
-					min = std::max(min - 2.0f, 0.0f);
-					max += 2.0f;
+					auto [min, max] = GetMinMax(PerformanceMetrics::GetFrameTimeHistory());
+
+					// add a little bit of space either side, so we're not constantly resizing
+					if ((max - min) < 4.0f)
+					{
+						min = min - std::fmod(min, 1.0f);
+						max = max - std::fmod(max, 1.0f) + 1.0f;
+						min = std::max(min - 2.0f, 0.0f);
+						max += 2.0f;
+					}
+
+					graph.frame_number = frame_number;
+					graph.min = min;
+					graph.max = max;
 				}
 
-				ImGui::PlotEx(
-					ImGuiPlotType_Lines, "##frame_times",
-					[](void*, int idx) -> float {
-						return PerformanceMetrics::GetFrameTimeHistory()[(
-							(PerformanceMetrics::GetFrameTimeHistoryPos() + idx) % PerformanceMetrics::NUM_FRAME_TIME_SAMPLES)];
-					},
-					nullptr, PerformanceMetrics::NUM_FRAME_TIME_SAMPLES, 0, nullptr, min, max, history_size);
+				if (new_sample || graph.pos.x != wpos.x || graph.pos.y != wpos.y ||
+					graph.size.x != history_size.x || graph.size.y != history_size.y)
+				{
+					const PerformanceMetrics::FrameTimeHistory& history = PerformanceMetrics::GetFrameTimeHistory();
+					const u32 history_pos = PerformanceMetrics::GetFrameTimeHistoryPos();
+					const float inv_range = (graph.max != graph.min) ? (1.0f / (graph.max - graph.min)) : 0.0f;
+					const float step = history_size.x / static_cast<float>(PerformanceMetrics::NUM_FRAME_TIME_SAMPLES - 1);
+					for (u32 i = 0; i < PerformanceMetrics::NUM_FRAME_TIME_SAMPLES; i++)
+					{
+						const float value = history[(history_pos + i) % PerformanceMetrics::NUM_FRAME_TIME_SAMPLES];
+						const float t = std::clamp((value - graph.min) * inv_range, 0.0f, 1.0f);
+						graph.points[i] = ImVec2(wpos.x + step * static_cast<float>(i), wpos.y + (1.0f - t) * history_size.y);
+					}
 
-				ImDrawList* win_dl = ImGui::GetCurrentWindow()->DrawList;
-				const ImVec2 wpos(ImGui::GetCurrentWindow()->Pos);
+					graph.pos = wpos;
+					graph.size = history_size;
+				}
+
+				win_dl->AddPolyline(graph.points.data(), static_cast<int>(graph.points.size()),
+					ImGui::GetColorU32(ImGuiCol_PlotLines), ImDrawFlags_None, 1.0f);
+
+				const float min = graph.min;
+				const float max = graph.max;
 
 				text.clear();
 				text.append_format("Max: {:.1f} ms", max);
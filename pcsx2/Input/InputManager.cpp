@@ -139,6 +139,10 @@ static InputInterceptHook::Callback m_event_intercept_callback;
 // Input sources. Keyboard/mouse don't exist here.
 static std::array<std::unique_ptr<InputSource>, static_cast<u32>(InputSourceType::Count)> s_input_sources;
 
+// Time of the last external source poll, used to throttle polls when the pads are read.
+static u64 s_last_poll_time = 0;
+static const u64 s_latch_poll_interval = Common::Timer::ConvertMillisecondsToValue(1.0);
+
 // ------------------------------------------------------------------------
 // Hotkeys
 // ------------------------------------------------------------------------
@@ -1631,12 +1635,34 @@ void InputManager::PollSources()
 			s_input_sources[i]->PollEvents();
 	}
 
+	s_last_poll_time = Common::Timer::GetCurrentValue();
+
 	GenerateRelativeMouseEvents();
 
 	if (VMManager::GetState() == VMState::Running && !s_pad_vibration_array.empty())
 		UpdateContinuedVibration();
 }
 
+void InputManager::LatchSources()
+{
+	if (!EmuConfig.EmulationSpeed.ReduceInputLatency)
+		return;
+
+	// Only the external sources are polled here. Relative mouse movement and vibration
+	// are still accumulated once per frame, and keyboard/mouse events arrive from the host.
+	const u64 current_time = Common::Timer::GetCurrentValue();
+	if ((current_time - s_last_poll_time) < s_latch_poll_interval)
+		return;
+
+	for (u32 i = FIRST_EXTERNAL_INPUT_SOURCE; i < LAST_EXTERNAL_INPUT_SOURCE; i++)
+	{
+		if (s_input_sources[i]->IsInitialized())
+			s_input_sources[i]->PollEvents();
+	}
+
+	s_last_poll_time = current_time;
+}
+
 
 std::vector<std::pair<std::string, std::string>> InputManager::EnumerateDevices()
 {
@@ -257,6 +257,10 @@ namespace InputManager
 	/// Polls input sources for events (e.g. external controllers).
 	void PollSources();
 
+	/// Polls external input sources again right before the game reads a pad, when input latency reduction is
+	/// enabled. Throttled so that games which read the pads many times per frame do not poll on every read.
+	void LatchSources();
+
 	/// Returns true if any bindings exist for the specified key.
 	/// Can be safely called on another thread.
 	bool HasAnyBindingsForKey(InputBindingKey key);
@@ -26,6 +26,28 @@ static u32 intLastBranchTo;
 
 static void intEventTest();
 
+// Decoding walks up to three levels of opcode tables, but only depends on the instruction word,
+// so remember the result for recently executed words. No invalidation is needed when code changes.
+struct DecodeCacheEntry
+{
+	u32 code;
+	const OPCODE* opcode;
+};
+static constexpr u32 DECODE_CACHE_SIZE = 4096;
+static DecodeCacheEntry s_decode_cache[DECODE_CACHE_SIZE];
+
+static __fi const OPCODE& intDecode(u32 code)
+{
+	DecodeCacheEntry& entry = s_decode_cache[(code ^ (code >> 16)) & (DECODE_CACHE_SIZE - 1)];
+	if (entry.code != code || !entry.opcode) [[unlikely]]
+	{
+		entry.code = code;
+		entry.opcode = &GetInstruction(code);
+	}
+
+	return *entry.opcode;
+}
+
 void intUpdateCPUCycles()
 {
 	const bool lowcycles = (cpuBlockCycles <= 40);
@@ -171,7 +193,7 @@ static void execI()
 	// interprete instruction
 	cpuRegs.code = memRead32( pc );
 
-	const OPCODE& opcode = GetCurrentInstruction();
+	const OPCODE& opcode = intDecode(cpuRegs.code);
 #if 0
 	static long int runs = 0;
 	//use this to find out what opcodes your game uses. very slow! (rama)
@@ -661,6 +683,10 @@ static void intClear(u32 Addr, u32 Size)
 {
 }
 
+static void intClearWrittenPage(u32 PageAddr, u32 WriteAddr)
+{
+}
+
 static void intShutdown() {
 }
 
@@ -676,5 +702,6 @@ R5900cpu intCpu =
 	intSafeExitExecution,
 	intCancelInstruction,
 
-	intClear
+	intClear,
+	intClearWrittenPage
 };
@@ -11,90 +11,104 @@ LayeredSettingsInterface::LayeredSettingsInterface() = default;
 
 LayeredSettingsInterface::~LayeredSettingsInterface() = default;
 
-bool LayeredSettingsInterface::Save(Error* error)
+void LayeredSettingsInterface::SetLayer(Layer layer, SettingsInterface* sif)
 {
-	pxFailRel("Attempting to save layered settings interface");
-	return false;
+	std::unique_lock lock(m_cache_mutex);
+	m_layers[layer] = sif;
+	m_cache.clear();
+	m_cache_revisions[layer] = sif ? sif->GetRevision() : 0;
 }
 
-void LayeredSettingsInterface::Clear()
+void LayeredSettingsInterface::ValidateCache() const
 {
-	pxFailRel("Attempting to clear layered settings interface");
-}
+	bool changed = false;
+	for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
+	{
+		const u32 revision = m_layers[layer] ? m_layers[layer]->GetRevision() : 0;
+		changed |= (m_cache_revisions[layer] != revision);
+		m_cache_revisions[layer] = revision;
+	}
 
-bool LayeredSettingsInterface::IsEmpty()
-{
-	return false;
+	if (changed)
+		m_cache.clear();
 }
 
-bool LayeredSettingsInterface::GetIntValue(const char* section, const char* key, int* value) const
+template <typename T>
+bool LayeredSettingsInterface::GetCachedValue(const char* section, const char* key, T* value, Getter<T> getter) const
 {
-	for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
+	std::unique_lock lock(m_cache_mutex);
+	ValidateCache();
+
+	// Type goes in the key as well, since the same key can parse as one type but not another.
+	SmallString cache_key;
+	cache_key.format("{}\n{}\n{}", section, key, CachedValue(T()).index());
+
+	if (const auto it = m_cache.find(cache_key.view()); it != m_cache.end())
 	{
-		if (SettingsInterface* sif = m_layers[layer])
+		if (const T* cached = std::get_if<T>(&it->second))
 		{
-			if (sif->GetIntValue(section, key, value))
-				return true;
+			*value = *cached;
+			return true;
 		}
-	}
 
-	return false;
-}
+		return false;
+	}
 
-bool LayeredSettingsInterface::GetUIntValue(const char* section, const char* key, uint* value) const
-{
 	for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
 	{
 		if (SettingsInterface* sif = m_layers[layer])
 		{
-			if (sif->GetUIntValue(section, key, value))
+			if ((sif->*getter)(section, key, value))
+			{
+				m_cache.emplace(cache_key.view(), *value);
 				return true;
+			}
 		}
 	}
 
+	m_cache.emplace(cache_key.view(), std::monostate());
 	return false;
 }
 
-bool LayeredSettingsInterface::GetFloatValue(const char* section, const char* key, float* value) const
+bool LayeredSettingsInterface::Save(Error* error)
 {
-	for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
-	{
-		if (SettingsInterface* sif = m_layers[layer])
-		{
-			if (sif->GetFloatValue(section, key, value))
-				return true;
-		}
-	}
-
+	pxFailRel("Attempting to save layered settings interface");
 	return false;
 }
 
-bool LayeredSettingsInterface::GetDoubleValue(const char* section, const char* key, double* value) const
+void LayeredSettingsInterface::Clear()
 {
-	for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
-	{
-		if (SettingsInterface* sif = m_layers[layer])
-		{
-			if (sif->GetDoubleValue(section, key, value))
-				return true;
-		}
-	}
+	pxFailRel("Attempting to clear layered settings interface");
+}
 
+bool LayeredSettingsInterface::IsEmpty()
+{
 	return false;
 }
 
-bool LayeredSettingsInterface::GetBoolValue(const char* section, const char* key, bool* value) const
+bool LayeredSettingsInterface::GetIntValue(const char* section, const char* key, int* value) const
 {
-	for (u32 layer = FIRST_LAYER; layer <= LAST_LAYER; layer++)
-	{
-		if (SettingsInterface* sif = m_layers[layer])
-		{
-			if (sif->GetBoolValue(section, key, value))
-				return true;
-		}
-	}
+	return GetCachedValue<int>(section, key, value, &SettingsInterface::GetIntValue);
+}
 
-	return false;
+bool LayeredSettingsInterface::GetUIntValue(const char* section, const char* key, uint* value) const
+{
+	return GetCachedValue<uint>(section, key, value, &SettingsInterface::GetUIntValue);
+}
+
+bool LayeredSettingsInterface::GetFloatValue(const char* section, const char* key, float* value) const
+{
+	return GetCachedValue<float>(section, key, value, &SettingsInterface::GetFloatValue);
+}
+
+bool LayeredSettingsInterface::GetDoubleValue(const char* section, const char* key, double* value) const
+{
+	return GetCachedValue<double>(section, key, value, &SettingsInterface::GetDoubleValue);
+}
+
+bool LayeredSettingsInterface::GetBoolValue(const char* section, const char* key, bool* value) const
+{
+	return GetCachedValue<bool>(section, key, value, &SettingsInterface::GetBoolValue);
 }
 
 bool LayeredSettingsInterface::GetStringValue(const char* section, const char* key, std::string* value) const
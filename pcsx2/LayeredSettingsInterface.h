@@ -6,6 +6,11 @@
 #include "common/SettingsInterface.h"
 
 #include <array>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
 
 class LayeredSettingsInterface final : public SettingsInterface
 {
@@ -23,7 +28,7 @@ public:
 	~LayeredSettingsInterface() override;
 
 	SettingsInterface* GetLayer(Layer layer) const { return m_layers[layer]; }
-	void SetLayer(Layer layer, SettingsInterface* sif) { m_layers[layer] = sif; }
+	void SetLayer(Layer layer, SettingsInterface* sif);
 
 	bool Save(Error* error = nullptr) override;
 
@@ -71,5 +76,26 @@ private:
 	static constexpr Layer FIRST_LAYER = LAYER_CMDLINE;
 	static constexpr Layer LAST_LAYER = LAYER_BASE;
 
+	// Scalar lookups are cached, keyed by section, key and type, until any of the layers change. A missing
+	// value is cached as std::monostate. Strings aren't cached, callers copy them out anyway.
+	using CachedValue = std::variant<std::monostate, int, uint, float, double, bool>;
+
+	struct CacheKeyHash
+	{
+		using is_transparent = void;
+		size_t operator()(std::string_view sv) const { return std::hash<std::string_view>()(sv); }
+	};
+
+	template <typename T>
+	using Getter = bool (SettingsInterface::*)(const char*, const char*, T*) const;
+
+	template <typename T>
+	bool GetCachedValue(const char* section, const char* key, T* value, Getter<T> getter) const;
+	void ValidateCache() const;
+
 	std::array<SettingsInterface*, NUM_LAYERS> m_layers{};
+
+	mutable std::mutex m_cache_mutex;
+	mutable std::unordered_map<std::string, CachedValue, CacheKeyHash, std::equal_to<>> m_cache;
+	mutable std::array<u32, NUM_LAYERS> m_cache_revisions{};
 };
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include "DebugTools/TraceCapture.h"
 #include "GS.h"
 #include "Gif_Unit.h"
 #include "MTGS.h"
@@ -12,6 +13,7 @@
 #include "common/FPControl.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/WrappedMemCopy.h"
 
 #include <list>
@@ -89,6 +91,17 @@ namespace MTGS
 	// has more than one command in it when the thread is kicked.
 	static int s_CopyDataTally;
 
+	// Number of qwords which can be queued before the GS thread is kicked. Vsyncs, stalls
+	// and WaitGS() always kick regardless, so this only bounds the latency of bulk data.
+	static constexpr int WakeWatermark = 0x2000;
+
+	// Submission counters, read (and reset) by the performance metrics once per update.
+	// SetEvent() and WaitGS() can also be called from the MTVU thread, hence atomics.
+	static std::atomic<u32> s_wake_count{0};
+	static std::atomic<u32> s_sync_count{0};
+	static std::atomic<u64> s_stall_time{0};
+	static std::atomic<u64> s_sync_time{0};
+
 #ifdef RINGBUF_DEBUG_STACK
 	static std::mutex s_lock_Stack;
 	static std::list<uint> ringposStack;
@@ -99,6 +112,7 @@ namespace MTGS
 	static std::atomic_bool s_shutdown_flag{false};
 	static std::atomic_bool s_run_idle_flag{false};
 	static Threading::UserspaceSemaphore s_open_or_close_done;
+	static bool s_open_pending = false; // only accessed on the CPU thread
 } // namespace MTGS
 
 // =====================================================================================================
@@ -144,6 +158,7 @@ void MTGS::ShutdownThread()
 void MTGS::ThreadEntryPoint()
 {
 	Threading::SetNameOfCurrentThread("GS");
+	TraceCapture::SetThreadName("MTGS");
 
 	// Explicitly set rounding mode to default (nearest, FTZ off).
 	// Otherwise it appears to get inherited from the EE thread on Linux.
@@ -329,6 +344,10 @@ void MTGS::MainLoop()
 		}
 		else
 		{
+			// Use the gap until the EE sends more packets to get textures ready for upcoming draws.
+			while (s_ReadPos.load(std::memory_order_relaxed) == s_WritePos.load(std::memory_order_acquire) && GSRunIdleWork())
+				;
+
 			mtvu_lock.unlock();
 			s_sem_event.WaitForWork();
 			mtvu_lock.lock();
@@ -339,6 +358,8 @@ void MTGS::MainLoop()
 
 		// note: m_ReadPos is intentionally not volatile, because it should only
 		// ever be modified by this thread.
+		// One event per drain of the ring, individual packets would overflow the trace buffer within a few frames.
+		TraceCapture::ScopedEvent trace("GS Ring");
 		while (s_ReadPos.load(std::memory_order_relaxed) != s_WritePos.load(std::memory_order_acquire))
 		{
 			const unsigned int local_ReadPos = s_ReadPos.load(std::memory_order_relaxed);
@@ -477,6 +498,7 @@ void MTGS::MainLoop()
 					{
 						case Command::VSync:
 						{
+							TraceCapture::ScopedEvent trace("GS VSync");
 							const int qsize = tag.data[0];
 							ringposinc += qsize;
 
@@ -612,6 +634,7 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 		return;
 
 	Gif_Path& path = gifUnit.gifPath[GIF_PATH_1];
+	const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
 
 	// Both m_ReadPos and m_WritePos can be relaxed as we only want to test if the queue is empty but
 	// we don't want to access the content of the queue
@@ -644,6 +667,9 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 			pxFailRel("MTGS Thread Died");
 	}
 
+	s_sync_count.fetch_add(1, std::memory_order_relaxed);
+	s_sync_time.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
+
 	pxAssert(!(weakWait && syncRegs) && "No synchronization for this!");
 
 	if (syncRegs)
@@ -657,10 +683,21 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 // For use in loops that wait on the GS thread to do certain things.
 void MTGS::SetEvent()
 {
-	s_sem_event.NotifyOfWork();
+	if (s_sem_event.NotifyOfWork())
+		s_wake_count.fetch_add(1, std::memory_order_relaxed);
 	s_CopyDataTally = 0;
 }
 
+MTGS::SubmissionStats MTGS::ConsumeSubmissionStats()
+{
+	SubmissionStats stats;
+	stats.wakes = s_wake_count.exchange(0, std::memory_order_relaxed);
+	stats.syncs = s_sync_count.exchange(0, std::memory_order_relaxed);
+	stats.stall_time = s_stall_time.exchange(0, std::memory_order_relaxed);
+	stats.sync_time = s_sync_time.exchange(0, std::memory_order_relaxed);
+	return stats;
+}
+
 u8* MTGS::GetDataPacketPtr()
 {
 	return (u8*)&RingBuffer[s_packet_writepos & RingBufferMask];
@@ -688,7 +725,7 @@ void MTGS::SendDataPacket()
 	else
 	{
 		s_CopyDataTally += s_packet_size;
-		if (s_CopyDataTally > 0x2000)
+		if (s_CopyDataTally > WakeWatermark)
 			SetEvent();
 	}
 
@@ -731,6 +768,8 @@ void MTGS::GenericStall(uint size)
 		// the next packet will likely stall up too.  So lets set a condition for the MTGS
 		// thread to wake up the EE once there's a sizable chunk of the ringbuffer emptied.
 
+		const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+
 		uint somedone = (RingBufferSize - freeroom) / 4;
 		if (somedone < size + 1)
 			somedone = size + 1;
@@ -783,6 +822,8 @@ void MTGS::GenericStall(uint size)
 					break;
 			}
 		}
+
+		s_stall_time.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
 	}
 }
 
@@ -849,7 +890,7 @@ void MTGS::SendSimpleGSPacket(Command type, u32 offset, u32 size, GIF_PATH path)
 	if (!IsDevBuild || !EmuConfig.GS.SynchronousMTGS) [[likely]]
 	{
 		s_CopyDataTally += size / 16;
-		if (s_CopyDataTally > 0x2000)
+		if (s_CopyDataTally > WakeWatermark)
 			SetEvent();
 	}
 }
@@ -868,19 +909,29 @@ void MTGS::SendPointerPacket(Command type, u32 data0, void* data1)
 	_FinishSimplePacket();
 }
 
-bool MTGS::WaitForOpen()
+void MTGS::BeginOpen()
 {
-	if (IsOpen())
-		return true;
+	if (s_open_pending || IsOpen())
+		return;
 
 	StartThread();
 
 	// request open, and kick the thread.
 	s_open_flag.store(true, std::memory_order_release);
 	s_sem_event.NotifyOfWork();
+	s_open_pending = true;
+}
+
+bool MTGS::WaitForOpen()
+{
+	if (!s_open_pending && IsOpen())
+		return true;
+
+	BeginOpen();
 
 	// wait for it to finish its stuff
 	s_open_or_close_done.Wait();
+	s_open_pending = false;
 
 	// did we succeed?
 	const bool result = s_open_flag.load(std::memory_order_acquire);
@@ -892,6 +943,10 @@ bool MTGS::WaitForOpen()
 
 void MTGS::WaitForClose()
 {
+	// an open which is still in flight has to finish before we can ask for a close
+	if (s_open_pending)
+		WaitForOpen();
+
 	if (!IsOpen())
 		return;
 
@@ -58,11 +58,25 @@ namespace MTGS
 	void WaitGS(bool syncRegs = true, bool weakWait = false, bool isMTVU = false);
 	void ResetGS(bool hardware_reset);
 
+	/// Asks the GS thread to open without waiting for it, so the CPU thread can bring up other
+	/// subsystems while the device is created and the shader cache is loaded. WaitForOpen() gets the result.
+	void BeginOpen();
 	bool WaitForOpen();
 	void WaitForClose();
 	void Freeze(FreezeAction mode, FreezeData& data);
 
 	int GetCurrentVsyncQueueSize();
+
+	struct SubmissionStats
+	{
+		u32 wakes; // number of times the GS thread had to be woken from sleep
+		u32 syncs; // number of full WaitGS() synchronizations
+		u64 stall_time; // Common::Timer ticks the producer spent waiting on ring space
+		u64 sync_time; // Common::Timer ticks the producer spent in WaitGS()
+	};
+
+	/// Returns the submission counters accumulated since the last call, and resets them.
+	SubmissionStats ConsumeSubmissionStats();
 	void PostVsyncStart(bool registers_written);
 	void InitAndReadFIFO(u8* mem, u32 qwc);
 
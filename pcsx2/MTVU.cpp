@@ -2,12 +2,17 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "DebugTools/TraceCapture.h"
 #include "Gif_Unit.h"
 #include "MTVU.h"
 #include "VMManager.h"
 #include "Vif_Dynarec.h"
 
+#include "common/Timer.h"
+
+#include <algorithm>
 #include <thread>
+#include <vector>
 
 VU_Thread vu1Thread;
 
@@ -28,6 +33,7 @@ enum MTVU_EVENT
 	MTVU_VIF_WRITE_ROW,  // Write to Vif row reg
 	MTVU_VIF_UNPACK,     // Execute Vif Unpack
 	MTVU_NULL_PACKET,    // Go back to beginning of buffer
+	MTVU_PADDING,        // Skip to the next cache line
 	MTVU_RESET
 };
 
@@ -109,6 +115,8 @@ void VU_Thread::Close()
 	m_shutdown_flag.store(true, std::memory_order_release);
 	semaEvent.NotifyOfWork();
 	m_thread.Join();
+
+	LogSyncPoints();
 }
 
 void VU_Thread::Reset()
@@ -116,8 +124,10 @@ void VU_Thread::Reset()
 	vuCycleIdx = 0;
 	m_ato_write_pos = 0;
 	m_write_pos = 0;
+	m_commit_pos = 0;
 	m_ato_read_pos = 0;
 	m_read_pos = 0;
+	m_ee_writes_pending = false;
 	std::memset(&vif, 0, sizeof(vif));
 	std::memset(&vifRegs, 0, sizeof(vifRegs));
 	for (size_t i = 0; i < 4; ++i)
@@ -128,6 +138,7 @@ void VU_Thread::Reset()
 void VU_Thread::ExecuteRingBuffer()
 {
 	Threading::SetNameOfCurrentThread("MTVU");
+	TraceCapture::SetThreadName("MTVU");
 
 	for (;;)
 	{
@@ -142,6 +153,7 @@ void VU_Thread::ExecuteRingBuffer()
 			{
 				case MTVU_VU_EXECUTE:
 				{
+					TraceCapture::ScopedEvent trace("VU1 Execute");
 					VU1.cycle = 0;
 					s32 addr = Read();
 					vifRegs.top = Read();
@@ -154,6 +166,7 @@ void VU_Thread::ExecuteRingBuffer()
 					gifUnit.gifPath[GIF_PATH_1].FinishGSPacketMTVU();
 					semaXGkick.Post(); // Tell MTGS a path1 packet is complete
 					vuCycles[vuCycleIdx].store(VU1.cycle, std::memory_order_release);
+					m_executed_cycles.store(m_executed_cycles.load(std::memory_order_relaxed) + VU1.cycle, std::memory_order_relaxed);
 					vuCycleIdx = (vuCycleIdx + 1) & 3;
 					break;
 				}
@@ -197,6 +210,9 @@ void VU_Thread::ExecuteRingBuffer()
 				case MTVU_NULL_PACKET:
 					m_read_pos = 0;
 					break;
+				case MTVU_PADDING:
+					m_read_pos = Common::AlignUpPow2(m_read_pos, line_size);
+					break;
 					jNO_DEFAULT;
 			}
 
@@ -224,12 +240,20 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 		if (readPos > m_write_pos + size + _4kb)
 			break; // Enough free front space
 		{          // Let MTVU run to free up buffer space
+			// Anything still batched up has to be published first, or MTVU
+			// would never get to the packets blocking us. No padding here,
+			// the space for it has not been checked yet.
+			if (m_commit_pos != m_write_pos)
+				CommitWritePos();
 			KickStart();
-			// Locking might trigger a full flush of the ring buffer. Yield
-			// will be more aggressive, and only flush the minimal size.
-			// Performance will be smoother but it will consume extra CPU cycle
-			// on the EE thread (not an issue on 4 cores).
-			std::this_thread::yield();
+
+			// Sleep until MTVU moves its read position. The flag tells it
+			// to wake us, re-check afterwards so a move between the first
+			// load and setting the flag is not missed.
+			m_ato_space_waiting.store(true, std::memory_order_seq_cst);
+			if (m_ato_read_pos.load(std::memory_order_seq_cst) == readPos)
+				m_ato_read_pos.wait(readPos, std::memory_order_acquire);
+			m_ato_space_waiting.store(false, std::memory_order_relaxed);
 		}
 	}
 }
@@ -239,9 +263,12 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 void VU_Thread::ReserveSpace(s32 size)
 {
 	pxAssert(m_write_pos < buffer_size);
-	pxAssert(size < buffer_size);
 	pxAssert(size > 0);
 
+	// Leave room to pad the batch out to a cache line when it's committed.
+	size += line_size;
+	pxAssert(size < buffer_size);
+
 	if (m_write_pos + size > (buffer_size - 1))
 	{
 		WaitOnSize(1); // Size of MTVU_NULL_PACKET
@@ -275,6 +302,7 @@ __fi u32* VU_Thread::GetWritePtr()
 
 __fi void VU_Thread::CommitWritePos()
 {
+	m_commit_pos = m_write_pos;
 	m_ato_write_pos.store(m_write_pos, std::memory_order_release);
 
 	if (MTVU_ALWAYS_KICK)
@@ -283,9 +311,20 @@ __fi void VU_Thread::CommitWritePos()
 		WaitVU();
 }
 
+// Publishes the pending packets once a batch worth has been queued up,
+// so consecutive small writes share a single commit and wake-up
+__fi void VU_Thread::CommitBatch()
+{
+	if ((m_write_pos - m_commit_pos) >= batch_size)
+		Flush();
+}
+
 __fi void VU_Thread::CommitReadPos()
 {
-	m_ato_read_pos.store(m_read_pos, std::memory_order_release);
+	// Pairs with WaitOnSize(), the store has to be visible before checking for a sleeping EE thread.
+	m_ato_read_pos.store(m_read_pos, std::memory_order_seq_cst);
+	if (m_ato_space_waiting.load(std::memory_order_seq_cst))
+		m_ato_read_pos.notify_one();
 }
 
 __fi u32 VU_Thread::Read()
@@ -429,13 +468,62 @@ void VU_Thread::KickStart()
 
 bool VU_Thread::IsDone()
 {
-	return GetReadPos() == GetWritePos();
+	return GetReadPos() == m_write_pos;
+}
+
+void VU_Thread::Flush()
+{
+	if (m_commit_pos == m_write_pos)
+		return;
+
+	if (m_write_pos & (line_size - 1))
+	{
+		Write(MTVU_PADDING);
+		m_write_pos = Common::AlignUpPow2(m_write_pos, line_size);
+	}
+
+	CommitWritePos();
+	KickStart();
 }
 
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
+	Flush();
+
+	const bool busy = !IsDone();
+	const Common::Timer::Value start = busy ? Common::Timer::GetCurrentValue() : 0;
 	semaEvent.WaitForEmpty();
+	m_ee_writes_pending = false;
+
+	if (busy)
+	{
+		SyncPoint& sp = m_sync_points[cpuRegs.pc];
+		sp.count++;
+		sp.ticks += Common::Timer::GetCurrentValue() - start;
+	}
+}
+
+// Reports where the EE spent the most time waiting on MTVU, these are the
+// candidates for the MTVUStaleRead gamefix. The PC is the one of the
+// current recompiled block, not necessarily the exact load.
+void VU_Thread::LogSyncPoints()
+{
+	if (m_sync_points.empty())
+		return;
+
+	std::vector<std::pair<u32, SyncPoint>> points(m_sync_points.begin(), m_sync_points.end());
+	std::sort(points.begin(), points.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.second.ticks > rhs.second.ticks; });
+
+	DevCon.WriteLn("MTVU: EE waited on the VU thread at %zu PCs:", points.size());
+	for (size_t i = 0; i < std::min<size_t>(points.size(), 10); i++)
+	{
+		DevCon.WriteLn("  %08X: %u waits, %.2f ms", points[i].first, points[i].second.count,
+			Common::Timer::ConvertValueToMilliseconds(points[i].second.ticks));
+	}
+
+	m_sync_points.clear();
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
@@ -448,9 +536,8 @@ void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
 	Write(vif_top);
 	Write(vif_itop);
 	Write(fbrst);
-	CommitWritePos();
+	Flush();
 	gifUnit.TransferGSPacketData(GIF_TRANS_MTVU, NULL, 0);
-	KickStart();
 	u32 cycles = std::max(Get_vuCycles(), 4u);
 	u32 skip_cycles = std::min(cycles, 3000u);
 	cpuRegs.cycle += skip_cycles * EmuConfig.Speedhacks.EECycleSkip;
@@ -474,8 +561,8 @@ void VU_Thread::VifUnpack(vifStruct& _vif, VIFregisters& _vifRegs, const u8* dat
 	WriteRegs(&_vifRegs);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	m_ee_writes_pending = true;
+	CommitBatch();
 }
 
 void VU_Thread::WriteMicroMem(u32 vu_micro_addr, const void* data, u32 size)
@@ -486,8 +573,7 @@ void VU_Thread::WriteMicroMem(u32 vu_micro_addr, const void* data, u32 size)
 	Write(vu_micro_addr);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	CommitBatch();
 }
 
 void VU_Thread::WriteDataMem(u32 vu_data_addr, const void* data, u32 size)
@@ -498,8 +584,8 @@ void VU_Thread::WriteDataMem(u32 vu_data_addr, const void* data, u32 size)
 	Write(vu_data_addr);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	m_ee_writes_pending = true;
+	CommitBatch();
 }
 
 void VU_Thread::WriteVIRegs(REG_VI* viRegs)
@@ -508,8 +594,7 @@ void VU_Thread::WriteVIRegs(REG_VI* viRegs)
 	ReserveSpace(1 + size_u32(32));
 	Write(MTVU_VU_WRITE_VIREGS);
 	Write(viRegs, size_u32(32));
-	CommitWritePos();
-	KickStart();
+	CommitBatch();
 }
 
 void VU_Thread::WriteVFRegs(VECTOR* vfRegs)
@@ -518,8 +603,7 @@ void VU_Thread::WriteVFRegs(VECTOR* vfRegs)
 	ReserveSpace(1 + size_u32(32*4));
 	Write(MTVU_VU_WRITE_VFREGS);
 	Write(vfRegs, size_u32(32*4));
-	CommitWritePos();
-	KickStart();
+	CommitBatch();
 }
 
 void VU_Thread::WriteCol(vifStruct& _vif)
@@ -528,8 +612,8 @@ void VU_Thread::WriteCol(vifStruct& _vif)
 	ReserveSpace(1 + size_u32(sizeof(_vif.MaskCol)));
 	Write(MTVU_VIF_WRITE_COL);
 	Write(&_vif.MaskCol, sizeof(_vif.MaskCol));
-	CommitWritePos();
-	KickStart();
+	m_ee_writes_pending = true;
+	CommitBatch();
 }
 
 void VU_Thread::WriteRow(vifStruct& _vif)
@@ -538,6 +622,6 @@ void VU_Thread::WriteRow(vifStruct& _vif)
 	ReserveSpace(1 + size_u32(sizeof(_vif.MaskRow)));
 	Write(MTVU_VIF_WRITE_ROW);
 	Write(&_vif.MaskRow, sizeof(_vif.MaskRow));
-	CommitWritePos();
-	KickStart();
+	m_ee_writes_pending = true;
+	CommitBatch();
 }
@@ -8,6 +8,7 @@
 #include "VUmicro.h"
 
 #include <thread>
+#include <unordered_map>
 
 #define MTVU_LOG(...) do{} while(0)
 //#define MTVU_LOG DevCon.WriteLn
@@ -16,8 +17,14 @@
 // - This class should only be accessed from the EE thread...
 // - buffer_size must be power of 2
 // - ring-buffer has no complete pending packets when read_pos==write_pos
+// - small packets are batched up on the EE side, and only published once
+//   batch_size words are pending or the EE needs the VU thread to catch up
+// - every batch is padded out to a cache line, so the EE never writes to a
+//   line the VU thread is still reading from
 class VU_Thread final {
 	static const s32 buffer_size = (_1mb * 16) / sizeof(s32);
+	static const s32 line_size = __cachelinesize / sizeof(s32);
+	static const s32 batch_size = _4kb / sizeof(s32);
 
 	u32 buffer[buffer_size];
 	// Note: keep atomic on separate cache line to avoid CPU conflict
@@ -25,11 +32,27 @@ class VU_Thread final {
 	alignas(__cachelinesize) std::atomic<int> m_ato_write_pos;    // Only modified by EE thread
 	alignas(__cachelinesize) int  m_read_pos; // temporary read pos (local to the VU thread)
 	int  m_write_pos; // temporary write pos (local to the EE thread)
+	int  m_commit_pos; // last write pos published to the VU thread (local to the EE thread)
+	alignas(__cachelinesize) std::atomic_bool m_ato_space_waiting{false}; // EE thread is sleeping on m_ato_read_pos
 	Threading::WorkSema semaEvent;
 	std::atomic_bool m_shutdown_flag{false};
 
 	Threading::Thread m_thread;
 
+	// EE thread queued writes to VU1 data memory or VIF1 row/col since the last WaitVU()
+	bool m_ee_writes_pending = false;
+
+	// EE PCs which had to wait for MTVU to drain, logged on Close()
+	struct SyncPoint
+	{
+		u32 count;
+		u64 ticks;
+	};
+	std::unordered_map<u32, SyncPoint> m_sync_points;
+
+	// VU1 cycles of all programs executed on the thread, for throughput measurements
+	std::atomic<u64> m_executed_cycles{0};
+
 public:
 	alignas(16)  vifStruct        vif;
 	alignas(16)  VIFregisters     vifRegs;
@@ -54,6 +77,10 @@ public:
 	~VU_Thread();
 
 	__fi const Threading::ThreadHandle& GetThreadHandle() const { return m_thread; }
+	static constexpr size_t GetRingSize() { return sizeof(buffer); }
+
+	/// Returns the VU1 cycles executed on the thread so far.
+	__fi u64 GetExecutedCycles() const { return m_executed_cycles.load(std::memory_order_relaxed); }
 
 	/// Returns true if the VU thread has been started.
 	__fi bool IsOpen() const { return m_thread.Joinable(); }
@@ -72,9 +99,17 @@ public:
 	// Used for assertions...
 	bool IsDone();
 
+	// Publishes any batched packets to MTVU and kicks it
+	void Flush();
+
 	// Waits till MTVU is done processing
 	void WaitVU();
 
+	// Returns true if an EE read of VU1 data memory or VIF1 row/col may skip WaitVU(),
+	// and see whatever MTVU has written so far. Only with the MTVUStaleRead gamefix,
+	// and never while the EE's own writes to that state are still queued up.
+	__fi bool CanReadStale() const { return CHECK_MTVUSTALEREADHACK && !m_ee_writes_pending; }
+
 	void Get_MTVUChanges();
 
 	void ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst);
@@ -107,6 +142,7 @@ private:
 	u32* GetWritePtr();
 
 	void CommitWritePos();
+	void CommitBatch();
 	void CommitReadPos();
 
 	u32 Read();
@@ -118,6 +154,8 @@ private:
 	void WriteRegs(VIFregisters* src);
 
 	u32 Get_vuCycles();
+
+	void LogSyncPoints();
 };
 
 extern VU_Thread vu1Thread;
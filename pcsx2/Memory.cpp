@@ -59,6 +59,7 @@ namespace SysMemory
 	static u8* s_data_memory;
 	static void* s_data_memory_file_handle;
 	static u8* s_code_memory;
+	static bool s_huge_pages_enabled;
 } // namespace SysMemory
 
 static void memAllocate();
@@ -214,6 +215,26 @@ void SysMemory::DumpMemoryMap()
 #undef DUMP_REGION
 }
 
+void SysMemory::SetHugePagesEnabled(bool enabled)
+{
+	if (!s_data_memory || !s_code_memory || s_huge_pages_enabled == enabled)
+		return;
+
+	s_huge_pages_enabled = enabled;
+
+	// Fastmem views map individual 4K pages of the data memory, so they can't use huge pages themselves,
+	// but the direct mapping used by the interpreters, VU and recompiler fallbacks still benefits.
+	const bool data_result = HostSys::AdviseHugePages(s_data_memory, HostMemoryMap::MainSize, enabled);
+	const bool code_result = HostSys::AdviseHugePages(s_code_memory, HostMemoryMap::CodeSize, enabled);
+	if (!enabled)
+		return;
+
+	if (data_result && code_result)
+		Console.WriteLn("Requested huge pages for data and code memory.");
+	else
+		Console.Warning("Huge pages are not available on this host, using normal pages.");
+}
+
 void SysMemory::ReleaseMemoryMap()
 {
 	if (s_code_memory)
@@ -233,6 +254,8 @@ void SysMemory::ReleaseMemoryMap()
 		HostSys::DestroySharedMemory(s_data_memory_file_handle);
 		s_data_memory_file_handle = nullptr;
 	}
+
+	s_huge_pages_enabled = false;
 }
 
 bool SysMemory::Allocate()
@@ -946,25 +969,25 @@ template<int vunum> static void TAKES_R128 vuMicroWrite128(u32 addr, r128 data)
 template<int vunum> static mem8_t vuDataRead8(u32 addr) {
 	VURegs* vu = vunum ?  &VU1 :  &VU0;
 	addr      &= vunum ? 0x3fff: 0xfff;
-	if (vunum && THREAD_VU1) vu1Thread.WaitVU();
+	if (vunum && THREAD_VU1 && !vu1Thread.CanReadStale()) vu1Thread.WaitVU();
 	return vu->Mem[addr];
 }
 template<int vunum> static mem16_t vuDataRead16(u32 addr) {
 	VURegs* vu = vunum ?  &VU1 :  &VU0;
 	addr      &= vunum ? 0x3fff: 0xfff;
-	if (vunum && THREAD_VU1) vu1Thread.WaitVU();
+	if (vunum && THREAD_VU1 && !vu1Thread.CanReadStale()) vu1Thread.WaitVU();
 	return *(u16*)&vu->Mem[addr];
 }
 template<int vunum> static mem32_t vuDataRead32(u32 addr) {
 	VURegs* vu = vunum ?  &VU1 :  &VU0;
 	addr      &= vunum ? 0x3fff: 0xfff;
-	if (vunum && THREAD_VU1) vu1Thread.WaitVU();
+	if (vunum && THREAD_VU1 && !vu1Thread.CanReadStale()) vu1Thread.WaitVU();
 	return *(u32*)&vu->Mem[addr];
 }
 template<int vunum> static mem64_t vuDataRead64(u32 addr) {
 	VURegs* vu = vunum ?  &VU1 :  &VU0;
 	addr      &= vunum ? 0x3fff: 0xfff;
-	if (vunum && THREAD_VU1) vu1Thread.WaitVU();
+	if (vunum && THREAD_VU1 && !vu1Thread.CanReadStale()) vu1Thread.WaitVU();
 	return *(u64*)&vu->Mem[addr];
 }
 template<int vunum> static RETURNS_R128 vuDataRead128(u32 addr) {
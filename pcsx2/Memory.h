@@ -110,6 +110,9 @@ namespace SysMemory
 	/// Returns the file mapping which backs the data memory.
 	void* GetDataFileHandle();
 
+	/// Requests huge page backing for the data and code memory, to reduce TLB misses. Falls back to normal pages if unavailable.
+	void SetHugePagesEnabled(bool enabled);
+
 	// clang-format off
 
 	//////////////////////////////////////////////////////////////////////////
@@ -3,16 +3,21 @@
 
 #include "BuildVersion.h"
 #include "Common.h"
+#include "Counters.h"
 #include "Host.h"
 #include "Memory.h"
 #include "Elfheader.h"
 #include "PINE.h"
+#include "PerformanceMetrics.h"
 #include "VMManager.h"
 #include "common/Threading.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <mutex>
 #include <span>
 #include <sys/types.h>
 #include <thread>
@@ -108,6 +113,28 @@ namespace PINEServer
 	// Whether the socket processing thread should stop executing/is stopped.
 	static std::atomic_bool s_end{true};
 
+	/**
+	 * Frame synchronization state.
+	 * MsgFrameSync parks the socket thread until the next vsync, the CPU
+	 * thread then waits at the vsync until the rest of the message has been
+	 * processed, so every read in it observes the same frame.
+	 */
+	static std::mutex s_frame_sync_mutex;
+	static std::condition_variable s_frame_sync_cv;
+	static std::atomic_bool s_frame_sync_requested{false};
+	static bool s_frame_sync_active = false;
+
+	/**
+	 * How long MsgFrameSync waits for a vsync, e.g. when the VM is paused.
+	 */
+	static constexpr std::chrono::milliseconds FRAME_SYNC_WAIT_TIMEOUT{1000};
+
+	/**
+	 * How long the CPU thread is held at a vsync for a client, so a stalled
+	 * client can't hang the emulator.
+	 */
+	static constexpr std::chrono::milliseconds FRAME_SYNC_HOLD_TIMEOUT{100};
+
 	/**
 	 * Maximum memory used by an IPC message request.
 	 * Equivalent to 50,000 Write64 requests.
@@ -157,6 +184,9 @@ namespace PINEServer
 		MsgUUID = 0xD, /**< Returns the game UUID. */
 		MsgGameVersion = 0xE, /**< Returns the game verion. */
 		MsgStatus = 0xF, /**< Returns the emulator status. */
+		MsgFrameSync = 0x10, /**< Waits for the next vsync and holds the VM there for the rest of the message. */
+		MsgReadBlock = 0x11, /**< Reads a contiguous block of memory. */
+		MsgMemoryUsage = 0x12, /**< Returns the process memory usage, followed by each subsystem's usage. */
 		MsgUnimplemented = 0xFF /**< Unimplemented IPC message. */
 	};
 
@@ -221,6 +251,17 @@ namespace PINEServer
 	 */
 	bool AcceptClient();
 
+	/**
+	 * Blocks until the CPU thread reaches the next vsync.
+	 * return value: false if no vsync happened before the timeout.
+	 */
+	static bool WaitForFrameSync();
+
+	/**
+	 * Lets the CPU thread continue after a MsgFrameSync.
+	 */
+	static void ReleaseFrameSync();
+
 	/**
 	 * Converts a primitive value to bytes in little endian
 	 * res_vector: the vector to modify
@@ -471,6 +512,9 @@ void PINEServer::ClientLoop()
 		{
 			res = ParseCommand(ipc_buffer_span.subspan(4), s_ret_buffer, (u32)end_length - 4);
 
+			// don't keep the VM waiting on the socket
+			ReleaseFrameSync();
+
 			// if we cannot send back our answer restart the socket
 			if (write_portable(s_msgsock, res.buffer.data(), res.size) < 0)
 				return;
@@ -482,6 +526,13 @@ void PINEServer::Deinitialize()
 {
 	s_end.store(true, std::memory_order_release);
 
+	{
+		std::unique_lock lock(s_frame_sync_mutex);
+		s_frame_sync_requested.store(false, std::memory_order_relaxed);
+		s_frame_sync_active = false;
+	}
+	s_frame_sync_cv.notify_all();
+
 #ifndef _WIN32
 	if (!s_socket_name.empty())
 	{
@@ -506,6 +557,53 @@ void PINEServer::Deinitialize()
 		s_thread.join();
 }
 
+void PINEServer::VSync()
+{
+	if (!s_frame_sync_requested.load(std::memory_order_acquire))
+		return;
+
+	std::unique_lock lock(s_frame_sync_mutex);
+	if (!s_frame_sync_requested.load(std::memory_order_relaxed))
+		return;
+
+	s_frame_sync_requested.store(false, std::memory_order_relaxed);
+	s_frame_sync_active = true;
+	s_frame_sync_cv.notify_all();
+
+	s_frame_sync_cv.wait_for(lock, FRAME_SYNC_HOLD_TIMEOUT, []() { return !s_frame_sync_active; });
+	s_frame_sync_active = false;
+}
+
+bool PINEServer::WaitForFrameSync()
+{
+	std::unique_lock lock(s_frame_sync_mutex);
+
+	// a second MsgFrameSync in the same message moves on to the following frame
+	if (s_frame_sync_active)
+	{
+		s_frame_sync_active = false;
+		s_frame_sync_cv.notify_all();
+	}
+
+	s_frame_sync_requested.store(true, std::memory_order_release);
+	s_frame_sync_cv.wait_for(lock, FRAME_SYNC_WAIT_TIMEOUT,
+		[]() { return s_frame_sync_active || s_end.load(std::memory_order_acquire); });
+	s_frame_sync_requested.store(false, std::memory_order_relaxed);
+	return s_frame_sync_active;
+}
+
+void PINEServer::ReleaseFrameSync()
+{
+	{
+		std::unique_lock lock(s_frame_sync_mutex);
+		if (!s_frame_sync_active)
+			return;
+
+		s_frame_sync_active = false;
+	}
+	s_frame_sync_cv.notify_all();
+}
+
 PINEServer::IPCBuffer PINEServer::ParseCommand(std::span<u8> buf, std::vector<u8>& ret_buffer, u32 buf_size)
 {
 	u32 ret_cnt = 5;
@@ -738,6 +836,51 @@ PINEServer::IPCBuffer PINEServer::ParseCommand(std::span<u8> buf, std::vector<u8
 				ret_cnt += 4;
 				break;
 			}
+			case MsgFrameSync:
+			{
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 0, ret_cnt, 4, buf_size)) [[unlikely]]
+					goto error;
+				if (!WaitForFrameSync())
+					goto error;
+				ToResultVector(ret_buffer, static_cast<u32>(g_FrameCount), ret_cnt);
+				ret_cnt += 4;
+				break;
+			}
+			case MsgReadBlock:
+			{
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 a = FromSpan<u32>(buf, buf_cnt);
+				const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+				if (size > MAX_IPC_RETURN_SIZE || !SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size)) [[unlikely]]
+					goto error;
+				// blocks touching MMIO have to go through the individual reads
+				if (!vtlb_memSafeReadBytes(a, &ret_buffer[ret_cnt], size))
+					goto error;
+				ret_cnt += size;
+				buf_cnt += 8;
+				break;
+			}
+			case MsgMemoryUsage:
+			{
+				// u32 category count, u64 process usage, then a u64 per category, all in bytes.
+				static constexpr u32 count = static_cast<u32>(PerformanceMetrics::MemoryUsageCategory::Count);
+				if (!SafetyChecks(buf_cnt, 0, ret_cnt, 4 + 8 + count * 8, buf_size)) [[unlikely]]
+					goto error;
+				ToResultVector(ret_buffer, count, ret_cnt);
+				ToResultVector(ret_buffer, PerformanceMetrics::GetProcessMemoryUsage(), ret_cnt + 4);
+				ret_cnt += 12;
+				for (u32 i = 0; i < count; i++)
+				{
+					ToResultVector(ret_buffer, PerformanceMetrics::GetMemoryUsage(static_cast<PerformanceMetrics::MemoryUsageCategory>(i)), ret_cnt);
+					ret_cnt += 8;
+				}
+				break;
+			}
 			default:
 			{
 			error:
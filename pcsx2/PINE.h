@@ -19,4 +19,8 @@ namespace PINEServer
 
 	bool Initialize(int slot = PINE_DEFAULT_SLOT);
 	void Deinitialize();
+
+	// Called by the CPU thread on every vsync, holds the VM briefly if a
+	// client is waiting on MsgFrameSync.
+	void VSync();
 } // namespace PINEServer
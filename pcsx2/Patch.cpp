@@ -27,6 +27,7 @@
 #include <memory>
 #include <span>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 namespace Patch
@@ -128,6 +129,31 @@ namespace Patch
 	using ActivePatchList = std::vector<const PatchCommand*>;
 	using EnablePatchList = std::vector<std::string>;
 
+	// Plain EE writes to adjacent addresses are merged into one run, so they can be compared
+	// and written with a single memcpy per page instead of one memory access per patch.
+	struct CompiledPatchRun
+	{
+		u32 addr;
+		u32 size; // zero if the patches have to go through ApplyPatch()
+		u32 data_offset;
+		u32 first;
+		u32 count;
+	};
+
+	struct CompiledPatchList
+	{
+		ActivePatchList commands;
+		std::vector<CompiledPatchRun> runs;
+		std::vector<u8> data;
+	};
+
+	// Dynamic patches sharing the offset of their first pattern word, keyed by that word's value.
+	struct DynamicPatchGroup
+	{
+		u32 offset;
+		std::unordered_map<u32, std::vector<const DynamicPatch*>> patches;
+	};
+
 	namespace PatchFunc
 	{
 		static void patch(PatchGroup* group, const std::string_view cmd, const std::string_view param);
@@ -158,6 +184,11 @@ namespace Patch
 	static void ReloadEnabledLists();
 	static u32 EnablePatches(const PatchList& patches, const EnablePatchList& enable_list, const EnablePatchList& enable_immediately_list);
 
+	static u32 GetPatchWriteSize(const PatchCommand* p);
+	static void AppendPatchBytes(std::vector<u8>& data, const PatchCommand* p);
+	static void CompilePatchLists();
+	static void IndexDynamicPatches();
+
 	static void ApplyPatch(const PatchCommand* p);
 	static void ApplyDynaPatch(const DynamicPatch& patch, u32 address);
 	static void writeCheat();
@@ -181,6 +212,9 @@ namespace Patch
 	static ActivePatchList s_active_patches;
 	static std::vector<DynamicPatch> s_active_gamedb_dynamic_patches;
 	static std::vector<DynamicPatch> s_active_pnach_dynamic_patches;
+	static std::array<CompiledPatchList, PPT_END_MARKER> s_compiled_patches;
+	static std::vector<const DynamicPatch*> s_unconditional_dynamic_patches;
+	static std::vector<DynamicPatchGroup> s_dynamic_patch_index;
 	static EnablePatchList s_enabled_cheats;
 	static EnablePatchList s_enabled_patches;
 	static EnablePatchList s_just_enabled_cheats;
@@ -776,6 +810,9 @@ void Patch::UpdateActivePatches(bool reload_enabled_list, bool verbose, bool ver
 			TRANSLATE_PLURAL_STR("Patch", "%n cheat patches are active.", "OSD Message", c_count));
 	}
 
+	CompilePatchLists();
+	IndexDynamicPatches();
+
 	// Display message on first boot when we load patches.
 	// Except when it's just GameDB.
 	const bool just_gamedb = (p_count == 0 && c_count == 0 && gp_count > 0);
@@ -854,6 +891,9 @@ void Patch::UnloadPatches()
 	s_active_patches = {};
 	s_active_pnach_dynamic_patches = {};
 	s_active_gamedb_dynamic_patches = {};
+	s_compiled_patches = {};
+	s_unconditional_dynamic_patches = {};
+	s_dynamic_patch_index = {};
 	s_enabled_patches = {};
 	s_enabled_cheats = {};
 	decltype(s_cheat_patches)().swap(s_cheat_patches);
@@ -1076,13 +1116,126 @@ void Patch::PatchFunc::dpatch(PatchGroup* group, const std::string_view cmd, con
 	group->dpatches.push_back(dpatch);
 }
 
+u32 Patch::GetPatchWriteSize(const PatchCommand* p)
+{
+	switch (p->type)
+	{
+		case BYTE_T:
+			return 1;
+		case SHORT_T:
+		case SHORT_BE_T:
+			return 2;
+		case WORD_T:
+		case WORD_BE_T:
+			return 4;
+		case DOUBLE_T:
+		case DOUBLE_BE_T:
+			return 8;
+		case BYTES_T:
+			return static_cast<u32>(p->data);
+		default:
+			return 0;
+	}
+}
+
+void Patch::AppendPatchBytes(std::vector<u8>& data, const PatchCommand* p)
+{
+	u64 value;
+	switch (p->type)
+	{
+		case SHORT_BE_T:
+			value = ByteSwap(static_cast<u16>(p->data));
+			break;
+		case WORD_BE_T:
+			value = ByteSwap(static_cast<u32>(p->data));
+			break;
+		case DOUBLE_BE_T:
+			value = ByteSwap(p->data);
+			break;
+		case BYTES_T:
+			data.insert(data.end(), p->data_ptr, p->data_ptr + static_cast<u32>(p->data));
+			return;
+		default:
+			value = p->data;
+			break;
+	}
+
+	const u8* bytes = reinterpret_cast<const u8*>(&value);
+	data.insert(data.end(), bytes, bytes + GetPatchWriteSize(p));
+}
+
+void Patch::CompilePatchLists()
+{
+	for (CompiledPatchList& list : s_compiled_patches)
+	{
+		list.commands.clear();
+		list.runs.clear();
+		list.data.clear();
+	}
+
+	for (const PatchCommand* p : s_active_patches)
+		s_compiled_patches[p->placetopatch].commands.push_back(p);
+
+	for (CompiledPatchList& list : s_compiled_patches)
+	{
+		// Extended patches carry state between commands, so their order has to be kept as-is. Otherwise only
+		// overlapping writes care about order, and sorting by address brings patches for the same page together.
+		if (std::none_of(list.commands.begin(), list.commands.end(), [](const PatchCommand* p) { return p->type == EXTENDED_T; }))
+		{
+			ActivePatchList sorted(list.commands);
+			std::stable_sort(sorted.begin(), sorted.end(), [](const PatchCommand* lhs, const PatchCommand* rhs) {
+				return (lhs->cpu != rhs->cpu) ? (lhs->cpu < rhs->cpu) : (lhs->addr < rhs->addr);
+			});
+
+			bool overlaps = false;
+			for (size_t i = 1; i < sorted.size() && !overlaps; i++)
+			{
+				overlaps = (sorted[i]->cpu == sorted[i - 1]->cpu &&
+							sorted[i - 1]->addr + GetPatchWriteSize(sorted[i - 1]) > sorted[i]->addr);
+			}
+			if (!overlaps)
+				list.commands = std::move(sorted);
+		}
+
+		for (u32 i = 0; i < static_cast<u32>(list.commands.size()); i++)
+		{
+			const PatchCommand* p = list.commands[i];
+			const u32 size = (p->cpu == CPU_EE) ? GetPatchWriteSize(p) : 0;
+			if (size > 0 && !list.runs.empty() && list.runs.back().size > 0 &&
+				(list.runs.back().addr + list.runs.back().size) == p->addr)
+			{
+				CompiledPatchRun& run = list.runs.back();
+				run.size += size;
+				run.count++;
+			}
+			else
+			{
+				list.runs.push_back({p->addr, size, static_cast<u32>(list.data.size()), i, 1});
+			}
+
+			if (size > 0)
+				AppendPatchBytes(list.data, p);
+		}
+	}
+}
+
 // This is for applying patches directly to memory
 void Patch::ApplyLoadedPatches(patch_place_type place)
 {
-	for (const PatchCommand* i : s_active_patches)
+	const CompiledPatchList& list = s_compiled_patches[place];
+	for (const CompiledPatchRun& run : list.runs)
 	{
-		if (i->placetopatch == place)
-			ApplyPatch(i);
+		if (run.size > 0)
+		{
+			// We compare before writing so the rec doesn't get upset and invalidate when there's no change.
+			const u8* data = &list.data[run.data_offset];
+			if (vtlb_memSafeCmpBytes(run.addr, data, run.size) == 0 || vtlb_memSafeWriteBytes(run.addr, data, run.size))
+				continue;
+		}
+
+		// Handler mapped memory, IOP and extended patches go through the regular memory accessors.
+		for (u32 i = 0; i < run.count; i++)
+			ApplyPatch(list.commands[run.first + i]);
 	}
 }
 
@@ -1091,18 +1244,56 @@ bool Patch::IsGloballyToggleablePatch(const PatchInfo& patch_info)
 	return patch_info.name == WS_PATCH_NAME || patch_info.name == NI_PATCH_NAME;
 }
 
+void Patch::IndexDynamicPatches()
+{
+	s_unconditional_dynamic_patches.clear();
+	s_dynamic_patch_index.clear();
+
+	const auto add_patch = [](const DynamicPatch& patch) {
+		if (patch.pattern.empty())
+		{
+			s_unconditional_dynamic_patches.push_back(&patch);
+			return;
+		}
+
+		const DynamicPatchEntry& first = patch.pattern.front();
+		auto it = std::find_if(s_dynamic_patch_index.begin(), s_dynamic_patch_index.end(),
+			[&first](const DynamicPatchGroup& group) { return group.offset == first.offset; });
+		if (it == s_dynamic_patch_index.end())
+			it = s_dynamic_patch_index.insert(s_dynamic_patch_index.end(), DynamicPatchGroup{first.offset, {}});
+
+		it->patches[first.value].push_back(&patch);
+	};
+
+	for (const DynamicPatch& patch : s_active_pnach_dynamic_patches)
+		add_patch(patch);
+	for (const DynamicPatch& patch : s_active_gamedb_dynamic_patches)
+		add_patch(patch);
+}
+
 void Patch::ApplyDynamicPatches(u32 pc)
 {
-	for (const auto& dynpatch : s_active_pnach_dynamic_patches)
-		ApplyDynaPatch(dynpatch, pc);
-	for (const auto& dynpatch : s_active_gamedb_dynamic_patches)
-		ApplyDynaPatch(dynpatch, pc);
+	for (const DynamicPatch* dynpatch : s_unconditional_dynamic_patches)
+		ApplyDynaPatch(*dynpatch, pc);
+
+	// Only patches whose first pattern word matches the code at this PC can apply, so look those up directly.
+	for (const DynamicPatchGroup& group : s_dynamic_patch_index)
+	{
+		const auto it = group.patches.find(*static_cast<u32*>(PSM(pc + group.offset)));
+		if (it == group.patches.end())
+			continue;
+
+		for (const DynamicPatch* dynpatch : it->second)
+			ApplyDynaPatch(*dynpatch, pc);
+	}
 }
 
 void Patch::LoadDynamicPatches(const std::vector<DynamicPatch>& patches)
 {
 	for (const DynamicPatch& it : patches)
 		s_active_gamedb_dynamic_patches.push_back(it);
+
+	IndexDynamicPatches();
 }
 
 static u32 SkipCount = 0, IterationCount = 0;
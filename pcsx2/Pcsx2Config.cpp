@@ -222,6 +222,7 @@ bool TraceLogsMISC::operator!=(const TraceLogsMISC& right) const
 TraceLogFilters::TraceLogFilters()
 {
 	Enabled = false;
+	Buffered = false;
 }
 
 void TraceLogFilters::LoadSave(SettingsWrapper& wrap)
@@ -229,6 +230,7 @@ void TraceLogFilters::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapSection("EmuCore/TraceLog");
 
 	SettingsWrapEntry(Enabled);
+	SettingsWrapEntry(Buffered);
 
 	SettingsWrapBitBool(EE.bios);
 	SettingsWrapBitBool(EE.memory);
@@ -311,7 +313,7 @@ void TraceLogFilters::SyncToConfig() const
 
 bool TraceLogFilters::operator==(const TraceLogFilters& right) const
 {
-	return OpEqu(Enabled) && OpEqu(EE) && OpEqu(IOP) && OpEqu(MISC);
+	return OpEqu(Enabled) && OpEqu(Buffered) && OpEqu(EE) && OpEqu(IOP) && OpEqu(MISC);
 }
 
 bool TraceLogFilters::operator!=(const TraceLogFilters& right) const
@@ -324,6 +326,13 @@ static constexpr const char* s_speed_hack_names[] = {
 	"instantVU1",
 	"mtvu",
 	"eeCycleRate",
+	"timingProfile",
+};
+
+static constexpr const char* s_ee_timing_profile_names[] = {
+	"Default",
+	"Accurate",
+	"Throughput",
 };
 
 const char* Pcsx2Config::SpeedhackOptions::GetSpeedHackName(SpeedHack id)
@@ -361,10 +370,44 @@ void Pcsx2Config::SpeedhackOptions::Set(SpeedHack id, int value)
 		case SpeedHack::EECycleRate:
 			EECycleRate = static_cast<int>(std::clamp<int>(value, MIN_EE_CYCLE_RATE, MAX_EE_CYCLE_RATE));
 			break;
+		case SpeedHack::TimingProfile:
+			ApplyTimingProfile(static_cast<EETimingProfile>(std::clamp<int>(value, 0, static_cast<int>(EETimingProfile::MaxCount) - 1)));
+			break;
 			jNO_DEFAULT
 	}
 }
 
+void Pcsx2Config::SpeedhackOptions::ApplyTimingProfile(EETimingProfile profile)
+{
+	switch (profile)
+	{
+		case EETimingProfile::Accurate:
+			EECycleRate = 0;
+			EECycleSkip = 0;
+			vu1Instant = false;
+			break;
+
+		case EETimingProfile::Throughput:
+			// Same as the mildest cycle rate and skip settings, which are the ones that rarely break games.
+			EECycleRate = -1;
+			EECycleSkip = 1;
+			vu1Instant = true;
+			WaitLoop = true;
+			IntcStat = true;
+			break;
+
+		case EETimingProfile::Default:
+		default:
+			break;
+	}
+}
+
+const char* Pcsx2Config::SpeedhackOptions::GetTimingProfileName(EETimingProfile profile)
+{
+	pxAssert(static_cast<u32>(profile) < std::size(s_ee_timing_profile_names));
+	return s_ee_timing_profile_names[static_cast<u32>(profile)];
+}
+
 bool Pcsx2Config::SpeedhackOptions::operator==(const SpeedhackOptions& right) const
 {
 	return OpEqu(bitset) && OpEqu(EECycleRate) && OpEqu(EECycleSkip);
@@ -407,6 +450,7 @@ void Pcsx2Config::SpeedhackOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(vuFlagHack);
 	SettingsWrapBitBool(vuThread);
 	SettingsWrapBitBool(vu1Instant);
+	SettingsWrapBitBool(ipuThread);
 
 	EECycleRate = std::clamp(EECycleRate, MIN_EE_CYCLE_RATE, MAX_EE_CYCLE_RATE);
 	EECycleSkip = std::min(EECycleSkip, MAX_EE_CYCLE_SKIP);
@@ -453,6 +497,10 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU0 = true;
 	EnableVU1 = true;
 	EnableFastmem = true;
+	EnableEEBlockCache = false;
+	EnableEEHotBlocks = false;
+	EnableVUProgramCache = false;
+	EnableVIFUnpackCache = false;
 	PauseOnTLBMiss = false;
 
 	// vu and fpu clamping default to standard overflow.
@@ -531,6 +579,10 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU0);
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
+	SettingsWrapBitBool(EnableEEBlockCache);
+	SettingsWrapBitBool(EnableEEHotBlocks);
+	SettingsWrapBitBool(EnableVUProgramCache);
+	SettingsWrapBitBool(EnableVIFUnpackCache);
 	SettingsWrapBitBool(PauseOnTLBMiss);
 
 	SettingsWrapBitBool(vu0Overflow);
@@ -720,9 +772,13 @@ Pcsx2Config::GSOptions::GSOptions()
 	UseDebugDevice = false;
 	UseBlitSwapChain = false;
 	DisableShaderCache = false;
+	ReadOnlyShaderCache = false;
+	AsyncShaderCompilation = false;
 	DisableFramebufferFetch = false;
 	DisableVertexShaderExpand = false;
 	SkipDuplicateFrames = false;
+	ThrottleUncappedPresentation = false;
+	DynamicResolution = false;
 	OsdMessagesPos = OsdOverlayPos::TopLeft;
 	OsdPerformancePos = OsdOverlayPos::TopRight;
 	OsdShowSpeed = false;
@@ -730,6 +786,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	OsdShowVPS = false;
 	OsdShowCPU = false;
 	OsdShowGPU = false;
+	OsdShowGPUBreakdown = false;
 	OsdShowResolution = false;
 	OsdShowGSStats = false;
 	OsdShowIndicators = true;
@@ -738,6 +795,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	OsdShowFrameTimes = false;
 	OsdShowVersion = false;
 	OsdShowHardwareInfo = false;
+	OsdShowMemoryUsage = false;
 	OsdShowVideoCapture = true;
 	OsdShowInputRec = true;
 
@@ -745,6 +803,7 @@ Pcsx2Config::GSOptions::GSOptions()
 	HWSpinGPUForReadbacks = false;
 	HWSpinCPUForReadbacks = false;
 	GPUPaletteConversion = false;
+	GPUTextureUnswizzle = false;
 	AutoFlushSW = true;
 	PreloadFrameWithGSData = false;
 	Mipmap = true;
@@ -825,6 +884,9 @@ bool Pcsx2Config::GSOptions::OptionsAreEqual(const GSOptions& right) const
 		OpEqu(MaxAnisotropy) &&
 		OpEqu(SWExtraThreads) &&
 		OpEqu(SWExtraThreadsHeight) &&
+		OpEqu(HashCacheBudget) &&
+		OpEqu(VRAMBudget) &&
+		OpEqu(GSDumpReplayBuffer) &&
 		OpEqu(TriFilter) &&
 		OpEqu(TVShader) &&
 		OpEqu(GetSkipCountFunctionId) &&
@@ -894,6 +956,8 @@ bool Pcsx2Config::GSOptions::RestartOptionsAreEqual(const GSOptions& right) cons
 		   OpEqu(UseDebugDevice) &&
 		   OpEqu(UseBlitSwapChain) &&
 		   OpEqu(DisableShaderCache) &&
+		   OpEqu(ReadOnlyShaderCache) &&
+		   OpEqu(AsyncShaderCompilation) &&
 		   OpEqu(DisableFramebufferFetch) &&
 		   OpEqu(DisableVertexShaderExpand) &&
 		   OpEqu(OverrideTextureBarriers) &&
@@ -939,14 +1003,19 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(UseDebugDevice);
 	SettingsWrapBitBool(UseBlitSwapChain);
 	SettingsWrapBitBool(DisableShaderCache);
+	SettingsWrapBitBool(ReadOnlyShaderCache);
+	SettingsWrapBitBool(AsyncShaderCompilation);
 	SettingsWrapBitBool(DisableFramebufferFetch);
 	SettingsWrapBitBool(DisableVertexShaderExpand);
 	SettingsWrapBitBool(SkipDuplicateFrames);
+	SettingsWrapBitBool(ThrottleUncappedPresentation);
+	SettingsWrapBitBool(DynamicResolution);
 	SettingsWrapBitBool(OsdShowSpeed);
 	SettingsWrapBitBool(OsdShowFPS);
 	SettingsWrapBitBool(OsdShowVPS);
 	SettingsWrapBitBool(OsdShowCPU);
 	SettingsWrapBitBool(OsdShowGPU);
+	SettingsWrapBitBool(OsdShowGPUBreakdown);
 	SettingsWrapBitBool(OsdShowResolution);
 	SettingsWrapBitBool(OsdShowGSStats);
 	SettingsWrapBitBool(OsdShowIndicators);
@@ -955,12 +1024,14 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(OsdShowFrameTimes);
 	SettingsWrapBitBool(OsdShowVersion);
 	SettingsWrapBitBool(OsdShowHardwareInfo);
+	SettingsWrapBitBool(OsdShowMemoryUsage);
 	SettingsWrapBitBool(OsdShowVideoCapture);
 	SettingsWrapBitBool(OsdShowInputRec);
 
 	SettingsWrapBitBool(HWSpinGPUForReadbacks);
 	SettingsWrapBitBool(HWSpinCPUForReadbacks);
 	SettingsWrapBitBoolEx(GPUPaletteConversion, "paltex");
+	SettingsWrapBitBool(GPUTextureUnswizzle);
 	SettingsWrapBitBoolEx(AutoFlushSW, "autoflush_sw");
 	SettingsWrapBitBoolEx(PreloadFrameWithGSData, "preload_frame_with_gs_data");
 	SettingsWrapBitBoolEx(Mipmap, "mipmap");
@@ -1025,6 +1096,9 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitfieldEx(MaxAnisotropy, "MaxAnisotropy");
 	SettingsWrapBitfieldEx(SWExtraThreads, "extrathreads");
 	SettingsWrapBitfieldEx(SWExtraThreadsHeight, "extrathreads_height");
+	SettingsWrapBitfieldEx(HashCacheBudget, "HashCacheBudget");
+	SettingsWrapBitfieldEx(VRAMBudget, "VRAMBudget");
+	SettingsWrapBitfieldEx(GSDumpReplayBuffer, "GSDumpReplayBuffer");
 	SettingsWrapBitfieldEx(TVShader, "TVShader");
 	SettingsWrapBitfieldEx(SkipDrawStart, "UserHacks_SkipDraw_Start");
 	SettingsWrapBitfieldEx(SkipDrawEnd, "UserHacks_SkipDraw_End");
@@ -1229,6 +1303,7 @@ void Pcsx2Config::SPU2Options::LoadSave(SettingsWrapper& wrap)
 		SettingsWrapEntry(OutputVolume);
 		SettingsWrapEntry(FastForwardVolume);
 		SettingsWrapEntry(OutputMuted);
+		SettingsWrapEntry(ThreadedOutput);
 		SettingsWrapParsedEnum(Backend, "Backend", &AudioStream::ParseBackendName, &AudioStream::GetBackendName);
 		SettingsWrapParsedEnum(SyncMode, "SyncMode", &ParseSyncMode, &GetSyncModeName);
 		SettingsWrapEntry(DriverName);
@@ -1248,6 +1323,7 @@ bool Pcsx2Config::SPU2Options::operator==(const SPU2Options& right) const
 		   OpEqu(OutputVolume) &&
 		   OpEqu(FastForwardVolume) &&
 		   OpEqu(OutputMuted) &&
+		   OpEqu(ThreadedOutput) &&
 		   OpEqu(Backend) &&
 		   OpEqu(StreamParameters) &&
 		   OpEqu(DriverName) &&
@@ -1439,6 +1515,10 @@ static const char* const tbl_GamefixNames[] =
 		"XGKick",
 		"BlitInternalFPS",
 		"FullVU0Sync",
+		"MTVUStaleRead",
+		"EECache",
+		"FpuAccurate",
+		"DMASlice",
 };
 
 const char* Pcsx2Config::GamefixOptions::GetGameFixName(GamefixId id)
@@ -1481,6 +1561,10 @@ void Pcsx2Config::GamefixOptions::Set(GamefixId id, bool enabled)
 		case Fix_VUOverflow:          VUOverflowHack          = enabled; break;
 		case Fix_BlitInternalFPS:     BlitInternalFPSHack     = enabled; break;
 		case Fix_FullVU0Sync:         FullVU0SyncHack         = enabled; break;
+		case Fix_MTVUStaleRead:       MTVUStaleReadHack       = enabled; break;
+		case Fix_EECache:             EECacheHack             = enabled; break;
+		case Fix_FpuAccurate:         FpuAccurateHack         = enabled; break;
+		case Fix_DMASlice:            DMASliceHack            = enabled; break;
 		default:                                                         break;
 			// clang-format on
 	}
@@ -1519,6 +1603,10 @@ bool Pcsx2Config::GamefixOptions::Get(GamefixId id) const
 		case Fix_VUOverflow:          return VUOverflowHack;
 		case Fix_BlitInternalFPS:     return BlitInternalFPSHack;
 		case Fix_FullVU0Sync:         return FullVU0SyncHack;
+		case Fix_MTVUStaleRead:       return MTVUStaleReadHack;
+		case Fix_EECache:             return EECacheHack;
+		case Fix_FpuAccurate:         return FpuAccurateHack;
+		case Fix_DMASlice:            return DMASliceHack;
 		default:                      return false;
 			// clang-format on
 	}
@@ -1547,6 +1635,10 @@ void Pcsx2Config::GamefixOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(VUOverflowHack);
 	SettingsWrapBitBool(BlitInternalFPSHack);
 	SettingsWrapBitBool(FullVU0SyncHack);
+	SettingsWrapBitBool(MTVUStaleReadHack);
+	SettingsWrapBitBool(EECacheHack);
+	SettingsWrapBitBool(FpuAccurateHack);
+	SettingsWrapBitBool(DMASliceHack);
 }
 
 const char* Pcsx2Config::DebugAnalysisOptions::RunConditionNames[] = {
@@ -1641,6 +1733,12 @@ void Pcsx2Config::SavestateOptions::LoadSave(SettingsWrapper& wrap)
 
 	SettingsWrapIntEnumEx(CompressionType, "SavestateCompressionType");
 	SettingsWrapIntEnumEx(CompressionRatio, "SavestateCompressionRatio");
+
+	SettingsWrapEntry(EnableRewind);
+	SettingsWrapEntry(RewindFrequency);
+	SettingsWrapEntry(RewindBufferSize);
+
+	SettingsWrapEntry(SaveTextureCacheTargets);
 }
 
 bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) const
@@ -1650,7 +1748,8 @@ bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) co
 
 bool Pcsx2Config::SavestateOptions::operator==(const SavestateOptions& right) const
 {
-	return OpEqu(CompressionType) && OpEqu(CompressionRatio);
+	return OpEqu(CompressionType) && OpEqu(CompressionRatio) && OpEqu(EnableRewind) && OpEqu(RewindFrequency) &&
+		   OpEqu(RewindBufferSize) && OpEqu(SaveTextureCacheTargets);
 };
 
 Pcsx2Config::FilenameOptions::FilenameOptions()
@@ -1697,6 +1796,8 @@ void Pcsx2Config::EmulationSpeedOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapEntry(NominalScalar);
 	SettingsWrapEntry(TurboScalar);
 	SettingsWrapEntry(SlomoScalar);
+	SettingsWrapBitBool(ReduceInputLatency);
+	SettingsWrapBitBool(PowerSaving);
 
 	// This was in the wrong place... but we can't change it without breaking existing configs.
 	//SettingsWrapBitBool(SyncToHostRefreshRate);
@@ -1934,6 +2035,10 @@ Pcsx2Config::Pcsx2Config()
 
 	GzipIsoIndexTemplate = "$(f).pindex.tmp";
 	PINESlot = 28011;
+	SharedSnapshotWidth = 320;
+	SharedSnapshotHeight = 240;
+	CdvdDecompressThreads = 2;
+	CdvdPrefetchDepth = 32;
 	RtcYear = 0;
 	RtcMonth = 1;
 	RtcDay = 1;
@@ -1949,14 +2054,19 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 	SettingsWrapBitBool(CdvdVerboseReads);
 	SettingsWrapBitBool(CdvdDumpBlocks);
 	SettingsWrapBitBool(CdvdPrecache);
+	SettingsWrapBitBool(CdvdBackgroundPrecache);
+	SettingsWrapBitBool(CdvdReadPrediction);
 	SettingsWrapBitBool(EnablePatches);
 	SettingsWrapBitBool(EnableCheats);
 	SettingsWrapBitBool(EnablePINE);
+	SettingsWrapBitBool(EnableSharedSnapshot);
 	SettingsWrapBitBool(EnableWideScreenPatches);
 	SettingsWrapBitBool(EnableNoInterlacingPatches);
 	SettingsWrapBitBool(EnableFastBoot);
 	SettingsWrapBitBool(EnableFastBootFastForward);
+	SettingsWrapBitBool(EnableFastBootSnapshot);
 	SettingsWrapBitBool(EnableThreadPinning);
+	SettingsWrapBitBool(EnableHugePages);
 	SettingsWrapBitBool(EnableRecordingTools);
 	SettingsWrapBitBool(EnableGameFixes);
 	SettingsWrapBitBool(SaveStateOnShutdown);
@@ -1990,6 +2100,11 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 
 	SettingsWrapEntry(GzipIsoIndexTemplate);
 	SettingsWrapEntry(PINESlot);
+	SettingsWrapEntry(SharedSnapshotWidth);
+	SettingsWrapEntry(SharedSnapshotHeight);
+	SettingsWrapEntry(SharedSnapshotRanges);
+	SettingsWrapEntry(CdvdDecompressThreads);
+	SettingsWrapEntry(CdvdPrefetchDepth);
 	SettingsWrapEntry(RtcYear);
 	SettingsWrapEntry(RtcMonth);
 	SettingsWrapEntry(RtcDay);
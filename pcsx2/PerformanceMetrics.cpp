@@ -1,19 +1,29 @@
 // SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <atomic>
 #include <chrono>
 #include <vector>
 
+#include "common/HostSys.h"
 #include "common/Timer.h"
 #include "common/Threading.h"
 
 #include "PerformanceMetrics.h"
 
 #include "GS.h"
+#include "CDVD/ThreadedFileReader.h"
 #include "GS/GSCapture.h"
+#include "GS/Renderers/Common/GSDevice.h"
+#include "GS/Renderers/HW/GSTextureCache.h"
+#include "Memory.h"
 #include "MTGS.h"
 #include "MTVU.h"
+#include "R3000A.h"
+#include "R5900.h"
+#include "SPU2/spu2.h"
 #include "VMManager.h"
+#include "vtlb.h"
 
 static const float UPDATE_INTERVAL = 0.5f;
 
@@ -54,13 +64,36 @@ static float s_vu_thread_time = 0.0f;
 static float s_capture_thread_usage = 0.0f;
 static float s_capture_thread_time = 0.0f;
 
+static float s_mtgs_wakes_per_frame = 0.0f;
+static float s_mtgs_syncs_per_frame = 0.0f;
+static float s_mtgs_stall_time = 0.0f;
+static float s_mtgs_sync_time = 0.0f;
+
+static u32 s_last_fastmem_faults = 0;
+static float s_fastmem_faults_per_frame = 0.0f;
+
+// emulated cycles since, and host thread time at, the start of the session, see BeginCPUThroughput()
+static u32 s_throughput_last_ee_cycle = 0;
+static u32 s_throughput_last_iop_cycle = 0;
+static u64 s_throughput_ee_cycles = 0;
+static u64 s_throughput_iop_cycles = 0;
+static u64 s_throughput_vu1_cycles = 0;
+static u64 s_throughput_cpu_time = 0;
+static u64 s_throughput_vu_time = 0;
+
+// Written on the GS thread, read by the UI and PINE.
+static std::array<std::atomic<u64>, static_cast<size_t>(PerformanceMetrics::MemoryUsageCategory::Count)> s_memory_usage = {};
+static std::atomic<u64> s_process_memory_usage{0};
+
 static PerformanceMetrics::FrameTimeHistory s_frame_time_history;
 static u32 s_frame_time_history_pos = 0;
 
 struct GSSWThreadStats
 {
 	Threading::ThreadHandle handle;
+	const std::atomic<u64>* busy_ticks = nullptr;
 	u64 last_cpu_time = 0;
+	u64 last_busy_ticks = 0;
 	double usage = 0.0;
 	double time = 0.0;
 };
@@ -68,6 +101,7 @@ std::vector<GSSWThreadStats> s_gs_sw_threads;
 
 static float s_average_gpu_time = 0.0f;
 static float s_accumulated_gpu_time = 0.0f;
+static float s_last_gpu_time = 0.0f;
 static float s_gpu_usage = 0.0f;
 static u32 s_presents_since_last_update = 0;
 
@@ -92,6 +126,7 @@ void PerformanceMetrics::Clear()
 	s_capture_thread_time = 0.0f;
 
 	s_average_gpu_time = 0.0f;
+	s_last_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
 
 	s_frame_number = 0;
@@ -123,7 +158,48 @@ void PerformanceMetrics::Reset()
 	s_last_capture_time = GSCapture::IsCapturing() ? GSCapture::GetEncoderThreadHandle().GetCPUTime() : 0;
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
+	{
 		stat.last_cpu_time = stat.handle.GetCPUTime();
+		stat.last_busy_ticks = stat.busy_ticks ? stat.busy_ticks->load(std::memory_order_relaxed) : 0;
+	}
+
+	MTGS::ConsumeSubmissionStats();
+	s_last_fastmem_faults = vtlb_GetFastmemFaultCount();
+}
+
+static void SetMemoryUsage(PerformanceMetrics::MemoryUsageCategory category, u64 bytes)
+{
+	s_memory_usage[static_cast<size_t>(category)].store(bytes, std::memory_order_relaxed);
+}
+
+static void SetCodeMemoryUsage(PerformanceMetrics::MemoryUsageCategory category, const u8* start, const u8* end)
+{
+	SetMemoryUsage(category, HostSys::GetResidentSize(start, static_cast<size_t>(end - start)));
+}
+
+static void UpdateMemoryUsage()
+{
+	using PerformanceMetrics::MemoryUsageCategory;
+
+	SetCodeMemoryUsage(MemoryUsageCategory::EERecompiler, SysMemory::GetEERec(), SysMemory::GetEERecEnd());
+	SetCodeMemoryUsage(MemoryUsageCategory::IOPRecompiler, SysMemory::GetIOPRec(), SysMemory::GetIOPRecEnd());
+	SetCodeMemoryUsage(MemoryUsageCategory::VU0Recompiler, SysMemory::GetVU0Rec(), SysMemory::GetVU0RecEnd());
+	SetCodeMemoryUsage(MemoryUsageCategory::VU1Recompiler, SysMemory::GetVU1Rec(), SysMemory::GetVU1RecEnd());
+	SetCodeMemoryUsage(MemoryUsageCategory::VIFUnpackRecompiler, SysMemory::GetVIFUnpackRec(), SysMemory::GetVIFUnpackRecEnd());
+	SetCodeMemoryUsage(MemoryUsageCategory::SWRecompiler, SysMemory::GetSWRec(), SysMemory::GetSWRecEnd());
+
+	// The texture cache only exists with the hardware renderers.
+	SetMemoryUsage(MemoryUsageCategory::GSSourceTextures, g_texture_cache ? g_texture_cache->GetSourceMemoryUsage() : 0);
+	SetMemoryUsage(MemoryUsageCategory::GSTargetTextures, g_texture_cache ? g_texture_cache->GetTargetMemoryUsage() : 0);
+	SetMemoryUsage(MemoryUsageCategory::GSHashCache, g_texture_cache ? g_texture_cache->GetTotalHashCacheMemoryUsage() : 0);
+	SetMemoryUsage(MemoryUsageCategory::GSTexturePool, g_gs_device ? g_gs_device->GetPoolMemoryUsage() : 0);
+
+	SetMemoryUsage(MemoryUsageCategory::MTGSRing, MTGS::RingBufferSize * sizeof(u128));
+	SetMemoryUsage(MemoryUsageCategory::MTVURing, THREAD_VU1 ? VU_Thread::GetRingSize() : 0);
+	SetMemoryUsage(MemoryUsageCategory::DiscPrecache, ThreadedFileReader::GetPrecacheMemoryUsage());
+	SetMemoryUsage(MemoryUsageCategory::AudioBuffers, SPU2::GetOutputMemoryUsage());
+
+	s_process_memory_usage.store(GetProcessResidentMemory(), std::memory_order_relaxed);
 }
 
 void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_skipping_present)
@@ -214,6 +290,17 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 
 	for (GSSWThreadStats& thread : s_gs_sw_threads)
 	{
+		// Prefer the time the worker actually spent rasterizing, CPU time also counts spinning while idle.
+		if (thread.busy_ticks)
+		{
+			const u64 busy_ticks = thread.busy_ticks->load(std::memory_order_relaxed);
+			const u64 delta = busy_ticks - thread.last_busy_ticks;
+			thread.last_busy_ticks = busy_ticks;
+			thread.usage = 100.0 * static_cast<double>(delta) / static_cast<double>(ticks_diff);
+			thread.time = Common::Timer::ConvertValueToMilliseconds(delta) / static_cast<double>(s_frames_since_last_update);
+			continue;
+		}
+
 		const u64 time = thread.handle.GetCPUTime();
 		const u64 delta = time - thread.last_cpu_time;
 		thread.last_cpu_time = time;
@@ -221,6 +308,19 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 		thread.time = static_cast<double>(delta) * time_divider;
 	}
 
+	const MTGS::SubmissionStats mtgs_stats = MTGS::ConsumeSubmissionStats();
+	const float frame_divider = 1.0f / static_cast<float>(s_frames_since_last_update);
+	s_mtgs_wakes_per_frame = static_cast<float>(mtgs_stats.wakes) * frame_divider;
+	s_mtgs_syncs_per_frame = static_cast<float>(mtgs_stats.syncs) * frame_divider;
+	s_mtgs_stall_time = static_cast<float>(Common::Timer::ConvertValueToMilliseconds(mtgs_stats.stall_time)) * frame_divider;
+	s_mtgs_sync_time = static_cast<float>(Common::Timer::ConvertValueToMilliseconds(mtgs_stats.sync_time)) * frame_divider;
+
+	const u32 fastmem_faults = vtlb_GetFastmemFaultCount();
+	s_fastmem_faults_per_frame = static_cast<float>(fastmem_faults - s_last_fastmem_faults) * frame_divider;
+	s_last_fastmem_faults = fastmem_faults;
+
+	UpdateMemoryUsage();
+
 	s_frames_since_last_update = 0;
 	s_unskipped_frames_since_last_update = 0;
 	s_presents_since_last_update = 0;
@@ -231,6 +331,7 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 void PerformanceMetrics::OnGPUPresent(float gpu_time)
 {
 	s_accumulated_gpu_time += gpu_time;
+	s_last_gpu_time = gpu_time;
 	s_presents_since_last_update++;
 }
 
@@ -240,6 +341,57 @@ void PerformanceMetrics::SetCPUThread(Threading::ThreadHandle thread)
 	s_cpu_thread_handle = std::move(thread);
 }
 
+void PerformanceMetrics::BeginCPUThroughput()
+{
+	s_throughput_last_ee_cycle = cpuRegs.cycle;
+	s_throughput_last_iop_cycle = psxRegs.cycle;
+	s_throughput_ee_cycles = 0;
+	s_throughput_iop_cycles = 0;
+	s_throughput_cpu_time = s_cpu_thread_handle.GetCPUTime();
+	s_throughput_vu1_cycles = THREAD_VU1 ? vu1Thread.GetExecutedCycles() : 0;
+	s_throughput_vu_time = THREAD_VU1 ? vu1Thread.GetThreadHandle().GetCPUTime() : 0;
+}
+
+void PerformanceMetrics::UpdateCPUThroughput()
+{
+	// Anything over a second of emulated time came from loading a state rather than from running code.
+	const u32 ee_delta = cpuRegs.cycle - s_throughput_last_ee_cycle;
+	const u32 iop_delta = psxRegs.cycle - s_throughput_last_iop_cycle;
+	if (ee_delta <= PS2CLK && iop_delta <= static_cast<u64>(PSXCLK))
+	{
+		s_throughput_ee_cycles += ee_delta;
+		s_throughput_iop_cycles += iop_delta;
+	}
+	s_throughput_last_ee_cycle = cpuRegs.cycle;
+	s_throughput_last_iop_cycle = psxRegs.cycle;
+}
+
+void PerformanceMetrics::LogCPUThroughput()
+{
+	UpdateCPUThroughput();
+
+	// CPU time rather than wall time, so pauses, throttling and waiting on the GS don't count against the recompilers.
+	const double ticks_per_second = static_cast<double>(Threading::GetThreadTicksPerSecond());
+	const double cpu_seconds = static_cast<double>(s_cpu_thread_handle.GetCPUTime() - s_throughput_cpu_time) / ticks_per_second;
+	if (cpu_seconds <= 0.0)
+		return;
+
+	Console.WriteLnFmt("EE thread: {:.2f}s CPU time, EE {:.2f} Mcycles/s, IOP {:.2f} Mcycles/s", cpu_seconds,
+		static_cast<double>(s_throughput_ee_cycles) / cpu_seconds / 1e6,
+		static_cast<double>(s_throughput_iop_cycles) / cpu_seconds / 1e6);
+
+	if (!THREAD_VU1)
+		return;
+
+	const double vu_seconds = static_cast<double>(vu1Thread.GetThreadHandle().GetCPUTime() - s_throughput_vu_time) / ticks_per_second;
+	if (vu_seconds <= 0.0)
+		return;
+
+	const u64 vu1_cycles = vu1Thread.GetExecutedCycles() - s_throughput_vu1_cycles;
+	Console.WriteLnFmt("MTVU thread: {:.2f}s CPU time, VU1 {:.2f} Mcycles/s",
+		vu_seconds, static_cast<double>(vu1_cycles) / vu_seconds / 1e6);
+}
+
 void PerformanceMetrics::SetGSSWThreadCount(u32 count)
 {
 	s_gs_sw_threads.clear();
@@ -252,6 +404,12 @@ void PerformanceMetrics::SetGSSWThread(u32 index, Threading::ThreadHandle thread
 	s_gs_sw_threads[index].handle = std::move(thread);
 }
 
+void PerformanceMetrics::SetGSSWThreadBusyCounter(u32 index, const std::atomic<u64>* busy_ticks)
+{
+	s_gs_sw_threads[index].busy_ticks = busy_ticks;
+	s_gs_sw_threads[index].last_busy_ticks = busy_ticks ? busy_ticks->load(std::memory_order_relaxed) : 0;
+}
+
 u64 PerformanceMetrics::GetFrameNumber()
 {
 	return s_frame_number;
@@ -317,6 +475,56 @@ float PerformanceMetrics::GetGSThreadAverageTime()
 	return s_gs_thread_time;
 }
 
+float PerformanceMetrics::GetMTGSWakesPerFrame()
+{
+	return s_mtgs_wakes_per_frame;
+}
+
+float PerformanceMetrics::GetMTGSSyncsPerFrame()
+{
+	return s_mtgs_syncs_per_frame;
+}
+
+float PerformanceMetrics::GetMTGSStallTime()
+{
+	return s_mtgs_stall_time;
+}
+
+float PerformanceMetrics::GetMTGSSyncTime()
+{
+	return s_mtgs_sync_time;
+}
+
+float PerformanceMetrics::GetFastmemFaultsPerFrame()
+{
+	return s_fastmem_faults_per_frame;
+}
+
+u32 PerformanceMetrics::GetFastmemFaultCount()
+{
+	return vtlb_GetFastmemFaultCount();
+}
+
+u32 PerformanceMetrics::GetFastmemSlowBlockCount()
+{
+	return vtlb_GetFastmemSlowBlockCount();
+}
+
+u32 PerformanceMetrics::GetAudioBufferedMS()
+{
+	return SPU2::GetOutputBufferedMS();
+}
+
+u32 PerformanceMetrics::GetAudioTargetBufferMS()
+{
+	return SPU2::GetOutputTargetBufferMS();
+}
+
+u32 PerformanceMetrics::GetAudioUnderrunCount()
+{
+	return SPU2::GetOutputUnderrunCount();
+}
+
 float PerformanceMetrics::GetVUThreadUsage()
 {
 	return s_vu_thread_usage;
@@ -362,6 +570,44 @@ float PerformanceMetrics::GetGPUAverageTime()
 	return s_average_gpu_time;
 }
 
+float PerformanceMetrics::GetLastGPUTime()
+{
+	return s_last_gpu_time;
+}
+
+const char* PerformanceMetrics::GetMemoryUsageCategoryName(MemoryUsageCategory category)
+{
+	static constexpr const char* names[] = {
+		"EE Recompiler",
+		"IOP Recompiler",
+		"VU0 Recompiler",
+		"VU1 Recompiler",
+		"VIF Unpack Recompiler",
+		"SW Renderer JIT",
+		"GS Source Textures",
+		"GS Target Textures",
+		"GS Hash Cache",
+		"GS Texture Pool",
+		"MTGS Ring Buffer",
+		"MTVU Ring Buffer",
+		"Disc Precache",
+		"Audio Buffers",
+	};
+	static_assert(std::size(names) == static_cast<size_t>(MemoryUsageCategory::Count));
+
+	return names[static_cast<size_t>(category)];
+}
+
+u64 PerformanceMetrics::GetMemoryUsage(MemoryUsageCategory category)
+{
+	return s_memory_usage[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+u64 PerformanceMetrics::GetProcessMemoryUsage()
+{
+	return s_process_memory_usage.load(std::memory_order_relaxed);
+}
+
 const PerformanceMetrics::FrameTimeHistory& PerformanceMetrics::GetFrameTimeHistory()
 {
 	return s_frame_time_history;
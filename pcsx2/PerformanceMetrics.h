@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include "common/Threading.h"
 
 namespace PerformanceMetrics
@@ -15,6 +16,25 @@ namespace PerformanceMetrics
 		DISPFBBlit
 	};
 
+	enum class MemoryUsageCategory : u8
+	{
+		EERecompiler,
+		IOPRecompiler,
+		VU0Recompiler,
+		VU1Recompiler,
+		VIFUnpackRecompiler,
+		SWRecompiler,
+		GSSourceTextures,
+		GSTargetTextures,
+		GSHashCache,
+		GSTexturePool,
+		MTGSRing,
+		MTVURing,
+		DiscPrecache,
+		AudioBuffers,
+		Count
+	};
+
 	static constexpr u32 NUM_FRAME_TIME_SAMPLES = 150;
 	using FrameTimeHistory = std::array<float, NUM_FRAME_TIME_SAMPLES>;
 
@@ -26,10 +46,22 @@ namespace PerformanceMetrics
 	/// Sets the EE thread for CPU usage calculations.
 	void SetCPUThread(Threading::ThreadHandle thread);
 
+	/// Starts measuring emulated cycles against the host CPU time of the EE and VU threads. CPU thread only.
+	void BeginCPUThroughput();
+
+	/// Accumulates the emulated cycles, called once per vsync since the 32-bit cycle counters wrap quickly.
+	void UpdateCPUThroughput();
+
+	/// Logs the emulated cycles per second of host CPU time since BeginCPUThroughput(). CPU thread only.
+	void LogCPUThroughput();
+
 	/// Sets timers for GS software threads.
 	void SetGSSWThreadCount(u32 count);
 	void SetGSSWThread(u32 index, Threading::ThreadHandle thread);
 
+	/// Lets the usage of a SW rasterizer thread be measured from the time it spends working, in Common::Timer ticks.
+	void SetGSSWThreadBusyCounter(u32 index, const std::atomic<u64>* busy_ticks);
+
 	u64 GetFrameNumber();
 
 	InternalFPSMethod GetInternalFPSMethod();
@@ -51,6 +83,20 @@ namespace PerformanceMetrics
 	float GetCaptureThreadUsage();
 	float GetCaptureThreadAverageTime();
 
+	float GetMTGSWakesPerFrame();
+	float GetMTGSSyncsPerFrame();
+	float GetMTGSStallTime();
+	float GetMTGSSyncTime();
+
+	float GetFastmemFaultsPerFrame();
+	u32 GetFastmemFaultCount();
+	u32 GetFastmemSlowBlockCount();
+
+	/// Audio waiting to be played by the host, and the level the output stream is aiming for, in milliseconds.
+	u32 GetAudioBufferedMS();
+	u32 GetAudioTargetBufferMS();
+	u32 GetAudioUnderrunCount();
+
 	u32 GetGSSWThreadCount();
 	double GetGSSWThreadUsage(u32 index);
 	double GetGSSWThreadAverageTime(u32 index);
@@ -58,6 +104,17 @@ namespace PerformanceMetrics
 	float GetGPUUsage();
 	float GetGPUAverageTime();
 
+	/// GPU time of the most recently presented frame, in milliseconds. Only updated when GPU timing is enabled.
+	float GetLastGPUTime();
+
+	/// Memory used by each subsystem, in bytes. Sampled with the other metrics, safe to read from any thread.
+	/// Recompiler code areas only count pages which are resident, not the whole reservation.
+	const char* GetMemoryUsageCategoryName(MemoryUsageCategory category);
+	u64 GetMemoryUsage(MemoryUsageCategory category);
+
+	/// Resident set size of the whole process, in bytes.
+	u64 GetProcessMemoryUsage();
+
 	const FrameTimeHistory& GetFrameTimeHistory();
 	u32 GetFrameTimeHistoryPos();
 } // namespace PerformanceMetrics
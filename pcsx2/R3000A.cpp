@@ -31,6 +31,10 @@ bool iopEventAction = false;
 static constexpr uint iopWaitCycles = 384; // Keep inline with EE wait cycle max.
 
 bool iopEventTestIsActive = false;
+EventDeadlineCache iopEventDeadline = {};
+
+// Every IOP event is run by _psxTestInterrupts().
+static constexpr u32 IOP_POLLED_EVENTS = (1u << (IopEvt_USB + 1)) - 1;
 
 alignas(16) psxRegisters psxRegs;
 
@@ -46,6 +50,7 @@ void psxReset()
 	psxRegs.iopCycleEE = -1;
 	psxRegs.iopCycleEECarry = 0;
 	psxRegs.iopNextEventCycle = psxRegs.cycle + 4;
+	iopEventDeadline.Invalidate();
 
 	psxHwReset();
 	PSXCLK = 36864000;
@@ -130,10 +135,12 @@ __fi void PSX_INT( IopEventId n, s32 ecycle )
 	//if (ecycle > 8192 && n != 19)
 	//	DevCon.Warning( "IOP cycles high: %d, n %d", ecycle, n );
 
+	const bool was_pending = (psxRegs.interrupt & (1 << n)) != 0;
 	psxRegs.interrupt |= 1 << n;
 
 	psxRegs.sCycle[n] = psxRegs.cycle;
 	psxRegs.eCycle[n] = ecycle;
+	iopEventDeadline.Schedule(1u << n, was_pending, psxRegs.interrupt, IOP_POLLED_EVENTS, psxRegs.cycle + ecycle);
 
 	psxSetNextBranchDelta(ecycle);
 	const float mutiplier = static_cast<float>(PS2CLK) / static_cast<float>(PSXCLK);
@@ -180,6 +187,15 @@ static __fi void Sio0TestEvent(IopEventId n)
 
 static __fi void _psxTestInterrupts()
 {
+	// Nothing due since the last scan, so the only work would be scheduling the next event test.
+	if (iopEventDeadline.NothingDue(psxRegs.interrupt, psxRegs.cycle))
+	{
+		if (iopEventDeadline.has_deadline)
+			psxSetNextBranch(psxRegs.cycle, static_cast<s32>(iopEventDeadline.deadline - psxRegs.cycle));
+
+		return;
+	}
+
 	IopTestEvent(IopEvt_SIF0,		sif0Interrupt);	// SIF0
 	IopTestEvent(IopEvt_SIF1,		sif1Interrupt);	// SIF1
 	IopTestEvent(IopEvt_SIF2,		sif2Interrupt);	// SIF2
@@ -202,6 +218,8 @@ static __fi void _psxTestInterrupts()
 		IopTestEvent(IopEvt_DEV9,		dev9Interrupt);
 		IopTestEvent(IopEvt_USB,		usbInterrupt);
 	}
+
+	iopEventDeadline.Update(psxRegs.interrupt, IOP_POLLED_EVENTS, psxRegs.sCycle, psxRegs.eCycle, psxRegs.cycle);
 }
 
 __ri void iopEventTest()
@@ -44,6 +44,13 @@ static constexpr uint eeWaitCycles = 3072;
 
 bool eeEventTestIsActive = false;
 EE_intProcessStatus eeRunInterruptScan = INT_NOT_RUNNING;
+EventDeadlineCache eeEventDeadline = {};
+
+// Events run by _cpuTestInterrupts(), the others are only used as DMAC status bits.
+static constexpr u32 EE_POLLED_EVENTS = (1u << VU_MTVU_BUSY) | (1u << DMAC_VIF1) | (1u << DMAC_GIF) | (1u << DMAC_SIF0) |
+	(1u << DMAC_SIF1) | (1u << DMAC_VIF0) | (1u << DMAC_FROM_IPU) | (1u << DMAC_TO_IPU) | (1u << IPU_PROCESS) |
+	(1u << DMAC_FROM_SPR) | (1u << DMAC_TO_SPR) | (1u << DMAC_MFIFO_VIF) | (1u << DMAC_MFIFO_GIF) |
+	(1u << VIF_VU0_FINISH) | (1u << VIF_VU1_FINISH);
 
 u32 g_eeloadMain = 0, g_eeloadExec = 0, g_osdsys_str = 0;
 
@@ -73,6 +80,7 @@ void cpuReset()
 	cpuRegs.nextEventCycle = cpuRegs.cycle + 4;
 	EEsCycle = 0;
 	EEoCycle = cpuRegs.cycle;
+	eeEventDeadline.Invalidate();
 
 	psxReset();
 	pgifInit();
@@ -266,6 +274,15 @@ static __fi bool _cpuTestInterrupts()
 		return false;
 	}
 
+	// Nothing due since the last scan, so the only work would be scheduling the next event test.
+	if (!CHECK_INSTANTDMAHACK && eeEventDeadline.NothingDue(cpuRegs.interrupt, cpuRegs.cycle))
+	{
+		if (eeEventDeadline.has_deadline)
+			cpuSetNextEvent(cpuRegs.cycle, static_cast<s32>(eeEventDeadline.deadline - cpuRegs.cycle));
+
+		return ((cpuRegs.interrupt & 0x1FFFF) & ~cpuRegs.dmastall) != 0;
+	}
+
 	eeRunInterruptScan = INT_RUNNING;
 
 	while (eeRunInterruptScan == INT_RUNNING)
@@ -308,6 +325,7 @@ static __fi bool _cpuTestInterrupts()
 	}
 
 	eeRunInterruptScan = INT_NOT_RUNNING;
+	eeEventDeadline.Update(cpuRegs.interrupt, EE_POLLED_EVENTS, cpuRegs.sCycle, cpuRegs.eCycle, cpuRegs.cycle);
 
 	if ((cpuRegs.interrupt & 0x1FFFF) & ~cpuRegs.dmastall)
 		return true;
@@ -537,9 +555,11 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 	if (CHECK_EETIMINGHACK && n < VIF_VU0_FINISH)
 		ecycle = 8;
 
+	const bool was_pending = (cpuRegs.interrupt & (1 << n)) != 0;
 	cpuRegs.interrupt |= 1 << n;
 	cpuRegs.sCycle[n] = cpuRegs.cycle;
 	cpuRegs.eCycle[n] = ecycle;
+	eeEventDeadline.Schedule(1u << n, was_pending, cpuRegs.interrupt, EE_POLLED_EVENTS, cpuRegs.cycle + ecycle);
 
 	// Interrupt is happening soon: make sure both EE and IOP are aware.
 
@@ -602,6 +622,11 @@ void eeloadHook()
 {
 	std::string elfname;
 	int argc = cpuRegs.GPR.n.a0.SD[0];
+
+	// Nothing disc specific has run yet on the first call, so this is where fast boot snapshots are taken.
+	if (!argc && VMManager::Internal::IsFastBootInProgress())
+		VMManager::Internal::SaveFastBootSnapshotOnCPUThread();
+
 	if (argc) // calls to EELOAD *after* the first one during the startup process will come here
 	{
 #if DEBUG_LAUNCHARG
@@ -808,6 +833,10 @@ int isMemcheckNeeded(u32 pc)
 	if (isBranchOrJump(addr))
 		addr += 4;
 
+	// With the watched pages protected, only instructions which have faulted on them can hit a memcheck.
+	if (vtlb_IsMemcheckProtectionActive() && !vtlb_IsFaultingPC(addr))
+		return 0;
+
 	u32 op = memRead32(addr);
 	const OPCODE& opcode = GetInstruction(op);
 
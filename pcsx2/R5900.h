@@ -5,7 +5,10 @@
 
 #include "common/Pcsx2Defs.h"
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <limits>
 
 // --------------------------------------------------------------------------------------
 //  EE Bios function name tables.
@@ -349,6 +352,10 @@ struct R5900cpu
 	// resets, since TLB remaps affect more than just the code they contain (code that
 	// may reference the remapped blocks via memory loads/stores, for example).
 	void (*Clear)(u32 Addr, u32 Size);
+
+	// Called when a write hits a write-protected code page, before the write goes through.
+	// PageAddr is the physical address of the page and WriteAddr the address being written.
+	void (*ClearWrittenPage)(u32 PageAddr, u32 WriteAddr);
 };
 
 extern R5900cpu *Cpu;
@@ -362,6 +369,65 @@ enum EE_intProcessStatus
 	INT_REQ_LOOP
 };
 
+// Nearest deadline of the pending scheduled events, shared by the EE and IOP. An event test which
+// finds nothing due can then schedule the next test without polling every source. Sources which
+// clear their bit directly change the pending mask, which makes the next event test rescan.
+struct EventDeadlineCache
+{
+	u32 mask;     // pending events when the deadline was computed
+	u32 deadline; // cycle of the nearest polled event
+	bool has_deadline;
+	bool valid;
+
+	void Invalidate() { valid = false; }
+
+	// Returns true if the pending events haven't changed since the last scan, and none are due yet.
+	bool NothingDue(u32 interrupt, u32 cycle) const
+	{
+		return valid && interrupt == mask && (!has_deadline || static_cast<s32>(deadline - cycle) > 0);
+	}
+
+	// Recomputes the deadline after a scan, only events in polled are run by the scan.
+	template <typename DeltaType>
+	void Update(u32 interrupt, u32 polled, const u32* start, const DeltaType* delta, u32 cycle)
+	{
+		s32 nearest = std::numeric_limits<s32>::max();
+		for (u32 pending = interrupt & polled; pending != 0; pending &= pending - 1)
+		{
+			const u32 n = std::countr_zero(pending);
+			nearest = std::min(nearest, static_cast<s32>(start[n] + static_cast<u32>(delta[n]) - cycle));
+		}
+
+		mask = interrupt;
+		deadline = cycle + nearest;
+		has_deadline = (interrupt & polled) != 0;
+		valid = true;
+	}
+
+	// Adds a newly scheduled event, re-scheduling an already pending one can move its deadline either way.
+	void Schedule(u32 bit, bool was_pending, u32 interrupt, u32 polled, u32 event_cycle)
+	{
+		if (!valid)
+			return;
+
+		if (was_pending)
+		{
+			valid = false;
+			return;
+		}
+
+		mask = interrupt;
+		if ((bit & polled) && (!has_deadline || static_cast<s32>(event_cycle - deadline) < 0))
+		{
+			deadline = event_cycle;
+			has_deadline = true;
+		}
+	}
+};
+
+extern EventDeadlineCache eeEventDeadline;
+extern EventDeadlineCache iopEventDeadline;
+
 enum EE_EventType
 {
 	DMAC_VIF0	= 0,
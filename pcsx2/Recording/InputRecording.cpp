@@ -33,6 +33,11 @@ bool SaveStateBase::InputRecordingFreeze()
 #include "fmt/format.h"
 #include "GS.h"
 #include "Host.h"
+#include "Memory.h"
+#include "R3000A.h"
+#include "R5900.h"
+
+#include "xxhash.h"
 
 InputRecording g_InputRecording;
 
@@ -235,6 +240,7 @@ void InputRecording::incFrameCounter()
 		stop();
 		return;
 	}
+	checkFrameHash();
 	m_frame_counter++;
 
 	if (m_controls.isReplaying())
@@ -382,10 +388,59 @@ const InputRecordingFile& InputRecording::getData() const
 	return m_file;
 }
 
+void InputRecording::setCheckpointInterval(u32 frames)
+{
+	m_checkpoint_interval = frames;
+}
+
+std::optional<u32> InputRecording::getFirstDesyncFrame() const
+{
+	return m_first_desync_frame;
+}
+
+void InputRecording::checkFrameHash()
+{
+	if (m_controls.isRecording())
+	{
+		m_file.writeFrameHash(m_frame_counter, computeFrameHash());
+		return;
+	}
+
+	const std::optional<u64> recorded = m_file.readFrameHash(m_frame_counter);
+	if (recorded.has_value() && recorded.value() != computeFrameHash() && !m_first_desync_frame.has_value())
+	{
+		m_first_desync_frame = m_frame_counter;
+		InputRec::log(fmt::format(TRANSLATE_FS("InputRecording", "Replay desynced at frame {}"), m_frame_counter),
+			Host::OSD_ERROR_DURATION);
+	}
+
+	if (m_checkpoint_interval > 0 && m_frame_counter > 0 && (m_frame_counter % m_checkpoint_interval) == 0)
+	{
+		const std::string path = fmt::format("{}_frame{:08}.p2s", m_file.getFilename(), m_frame_counter);
+		InputRec::consoleLog(fmt::format("Saving checkpoint for frame {} to {}", m_frame_counter, path));
+		VMManager::SaveState(path.c_str());
+	}
+}
+
+u64 InputRecording::computeFrameHash()
+{
+	// Desyncs show up in memory or the CPU registers quickly, and hashing both RAMs is cheap compared to a frame.
+	u64 hash = XXH3_64bits(eeMem->Main, Ps2MemSize::MainRam);
+	hash = XXH3_64bits_withSeed(iopMem->Main, Ps2MemSize::IopRam, hash);
+	hash = XXH3_64bits_withSeed(&cpuRegs.GPR, sizeof(cpuRegs.GPR), hash);
+	hash = XXH3_64bits_withSeed(&cpuRegs.pc, sizeof(cpuRegs.pc), hash);
+	hash = XXH3_64bits_withSeed(&psxRegs.GPR, sizeof(psxRegs.GPR), hash);
+	hash = XXH3_64bits_withSeed(&psxRegs.pc, sizeof(psxRegs.pc), hash);
+
+	// Zero marks frames without a hash in the file.
+	return (hash != 0) ? hash : 1;
+}
+
 void InputRecording::initializeState()
 {
 	m_frame_counter = 0;
 	m_watching_for_rerecords = false;
+	m_first_desync_frame.reset();
 	InformGSThread();
 }
 
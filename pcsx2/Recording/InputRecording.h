@@ -44,6 +44,11 @@ public:
 	InputRecordingControls& getControls();
 	const InputRecordingFile& getData() const;
 
+	// Saves a state every N frames while replaying, so long recordings can be validated in segments
+	void setCheckpointInterval(u32 frames);
+	// Returns the first replayed frame whose emulated state didn't match the recorded hash
+	std::optional<u32> getFirstDesyncFrame() const;
+
 private:
 	InputRecordingControls m_controls;
 	InputRecordingFile m_file;
@@ -62,8 +67,13 @@ private:
 	// Either 0 for a power-on movie, or the g_FrameCount that is stored on the starting frame
 	u32 m_starting_frame = 0;
 
+	u32 m_checkpoint_interval = 0;
+	std::optional<u32> m_first_desync_frame;
+
 	void initializeState();
 	void closeActiveFile();
+	void checkFrameHash();
+	static u64 computeFrameHash();
 };
 
 extern InputRecording g_InputRecording;
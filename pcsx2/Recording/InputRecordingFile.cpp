@@ -57,6 +57,11 @@ bool InputRecordingFile::close() noexcept
 	}
 	fclose(m_recordingFile);
 	m_recordingFile = nullptr;
+	if (m_hashFile != nullptr)
+	{
+		fclose(m_hashFile);
+		m_hashFile = nullptr;
+	}
 	m_filename.clear();
 	return true;
 }
@@ -101,6 +106,11 @@ bool InputRecordingFile::openNew(const std::string& path, bool fromSavestate)
 		return false;
 	}
 
+	if ((m_hashFile = FileSystem::OpenCFile(getFrameHashPath(path).c_str(), "wb+")) == nullptr)
+	{
+		InputRec::consoleLog(fmt::format("Frame hash file opening failed, desyncs won't be detectable. Error - {}", strerror(errno)));
+	}
+
 	m_filename = path;
 	m_totalFrames = 0;
 	m_undoCount = 0;
@@ -125,6 +135,15 @@ bool InputRecordingFile::openExisting(const std::string& path)
 		return false;
 	}
 
+	// Older recordings don't have any hashes, they still replay fine.
+	const std::string hash_path = getFrameHashPath(path);
+	if (FileSystem::FileExists(hash_path.c_str()))
+		m_hashFile = FileSystem::OpenCFile(hash_path.c_str(), "rb+");
+	if (m_hashFile == nullptr)
+	{
+		InputRec::consoleLog("No frame hashes found for input recording, desyncs won't be detected");
+	}
+
 	m_filename = path;
 	InputRecording::InformGSThread();
 	return true;
@@ -216,6 +235,35 @@ bool InputRecordingFile::writePadData(const uint frame, const PadData data) cons
 	return true;
 }
 
+std::optional<u64> InputRecordingFile::readFrameHash(const u32 frame) const
+{
+	u64 hash;
+	if (m_hashFile == nullptr ||
+		FileSystem::FSeek64(m_hashFile, static_cast<s64>(frame) * sizeof(hash), SEEK_SET) != 0 ||
+		fread(&hash, sizeof(hash), 1, m_hashFile) != 1)
+	{
+		return std::nullopt;
+	}
+
+	// Frames which were never written read back as zero when a later frame was.
+	if (hash == 0)
+	{
+		return std::nullopt;
+	}
+	return hash;
+}
+
+bool InputRecordingFile::writeFrameHash(const u32 frame, const u64 hash) const
+{
+	if (m_hashFile == nullptr ||
+		FileSystem::FSeek64(m_hashFile, static_cast<s64>(frame) * sizeof(hash), SEEK_SET) != 0 ||
+		fwrite(&hash, sizeof(hash), 1, m_hashFile) != 1)
+	{
+		return false;
+	}
+	return true;
+}
+
 void InputRecordingFile::logRecordingMetadata()
 {
 	InputRec::consoleMultiLog({fmt::format("File: {}", getFilename()),
@@ -253,6 +301,11 @@ size_t InputRecordingFile::getRecordingBlockSeekPoint(const u32 frame) const noe
 	return s_headerSize + sizeof(bool) + frame * s_inputBytesPerFrame;
 }
 
+std::string InputRecordingFile::getFrameHashPath(const std::string& path)
+{
+	return fmt::format("{}.hashes", path);
+}
+
 bool InputRecordingFile::verifyRecordingFileHeader()
 {
 	if (m_recordingFile == nullptr)
@@ -64,6 +64,11 @@ public:
 	bool writeHeader() const;
 	// Writes the current frame's input data to the file so it can be replayed
 	bool writePadData(const uint frame, const PadData data) const;
+	// Frame hashes are kept in a separate file next to the recording, so the format stays compatible.
+	// Reads the hash of the emulated state at the end of the given frame, if one was stored
+	std::optional<u64> readFrameHash(const u32 frame) const;
+	// Stores the hash of the emulated state at the end of the given frame
+	bool writeFrameHash(const u32 frame, const u64 hash) const;
 
 
 	// Retrieve the input recording's filename (not the path)
@@ -89,6 +94,7 @@ private:
 
 	std::string m_filename = "";
 	FILE* m_recordingFile = nullptr;
+	FILE* m_hashFile = nullptr;
 	bool m_savestate = false;
 
 	// An signed 32-bit frame limit is equivalent to 1.13 years of continuous 60fps footage
@@ -97,5 +103,6 @@ private:
 
 	// Calculates the position of the current frame in the input recording
 	size_t getRecordingBlockSeekPoint(const u32 frame) const noexcept;
+	static std::string getFrameHashPath(const std::string& path);
 	bool verifyRecordingFileHeader();
 };
@@ -0,0 +1,496 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Achievements.h"
+#include "GSDumpReplayer.h"
+#include "Host.h"
+#include "Recording/InputRecording.h"
+#include "Rewind.h"
+#include "SIO/Sio.h"
+#include "SaveState.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "IconsFontAwesome6.h"
+#include "fmt/format.h"
+
+#include <zstd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Rewind
+{
+	struct Snapshot
+	{
+		std::vector<u8> data; // zstd compressed state, or delta against the keyframe
+		std::vector<ArchiveEntry> entries;
+		u32 state_size; // size of the uncompressed state
+		u32 payload_size; // size of the uncompressed data
+		bool keyframe;
+	};
+
+	static void StartWorkerThread();
+	static void StopWorkerThread();
+	static void WorkerThread();
+	static void CaptureState();
+	static Snapshot EncodeState(const ArchiveEntryList& list);
+	static bool DecodeSnapshot(const Snapshot& snap, std::vector<u8>& dst);
+	static void DecodeReference();
+	static void TrimToBudget();
+	static void Clear();
+
+	// Comparing and storing the state in pages keeps the work for a snapshot close to a memcpy
+	// when most of memory is unchanged, and lets zstd collapse the zeroed parts of changed pages.
+	static constexpr u32 DELTA_PAGE_SIZE = 4096;
+
+	// Deltas grow as the game moves further from its keyframe, so start a new one regularly.
+	static constexpr u32 MAX_DELTAS_PER_KEYFRAME = 30;
+
+	// Speed over ratio, this runs several times a second.
+	static constexpr int COMPRESSION_LEVEL = 1;
+
+	static std::mutex s_mutex;
+	static std::condition_variable s_work_cv;
+	static std::condition_variable s_done_cv;
+	static std::thread s_worker_thread;
+	static bool s_worker_shutdown = false;
+	static bool s_worker_busy = false;
+	static std::unique_ptr<ArchiveEntryList> s_pending_state;
+
+	static std::deque<Snapshot> s_snapshots;
+	static size_t s_memory_usage = 0;
+
+	// Only touched by the worker thread, or with the worker idle and s_mutex held.
+	static std::vector<u8> s_reference; // decompressed copy of the newest keyframe
+	static size_t s_reference_compressed_size = 0;
+	static u32 s_deltas_since_keyframe = 0;
+	static std::vector<u8> s_scratch;
+	static ZSTD_CCtx* s_cctx = nullptr;
+
+	// CPU thread only.
+	static std::unique_ptr<ArchiveEntryList> s_load_list;
+	static u32 s_frames_since_capture = 0;
+	static std::atomic_bool s_rewinding{false};
+	static bool s_empty_message_shown = false;
+} // namespace Rewind
+
+void Rewind::StartWorkerThread()
+{
+	if (s_worker_thread.joinable())
+		return;
+
+	s_worker_shutdown = false;
+	s_worker_thread = std::thread(&Rewind::WorkerThread);
+}
+
+void Rewind::StopWorkerThread()
+{
+	if (!s_worker_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(s_mutex);
+		s_worker_shutdown = true;
+		s_work_cv.notify_one();
+	}
+
+	s_worker_thread.join();
+	s_worker_shutdown = false;
+}
+
+void Rewind::WorkerThread()
+{
+	Threading::SetNameOfCurrentThread("Rewind Compress");
+
+	s_cctx = ZSTD_createCCtx();
+
+	std::unique_lock lock(s_mutex);
+	for (;;)
+	{
+		s_work_cv.wait(lock, []() { return s_worker_shutdown || s_pending_state; });
+		if (s_worker_shutdown)
+			break;
+
+		std::unique_ptr<ArchiveEntryList> list = std::move(s_pending_state);
+		s_worker_busy = true;
+		lock.unlock();
+
+		Common::Timer timer;
+		Snapshot snap = EncodeState(*list);
+		SaveState_ReleaseBuffer(std::move(list));
+
+		lock.lock();
+		if (!snap.data.empty())
+		{
+			DevCon.WriteLn("Rewind: %s of %u bytes compressed to %zu bytes in %.2f ms", snap.keyframe ? "keyframe" : "delta",
+				snap.state_size, snap.data.size(), timer.GetTimeMilliseconds());
+
+			s_memory_usage += snap.data.size();
+			s_snapshots.push_back(std::move(snap));
+			TrimToBudget();
+		}
+
+		s_worker_busy = false;
+		s_done_cv.notify_all();
+	}
+
+	s_pending_state.reset();
+	lock.unlock();
+
+	ZSTD_freeCCtx(s_cctx);
+	s_cctx = nullptr;
+}
+
+static u32 GetStateSize(const ArchiveEntryList& list)
+{
+	size_t size = 0;
+	for (uint i = 0; i < static_cast<uint>(list.GetLength()); i++)
+		size = std::max<size_t>(size, list[i].GetDataIndex() + list[i].GetDataSize());
+
+	return static_cast<u32>(std::min(size, list.GetBuffer().size()));
+}
+
+Rewind::Snapshot Rewind::EncodeState(const ArchiveEntryList& list)
+{
+	Snapshot snap;
+	snap.state_size = GetStateSize(list);
+	snap.entries.reserve(list.GetLength());
+	for (uint i = 0; i < static_cast<uint>(list.GetLength()); i++)
+		snap.entries.push_back(list[i]);
+
+	const u8* state = list.GetBuffer().data();
+	snap.keyframe = (s_reference.empty() || s_deltas_since_keyframe >= MAX_DELTAS_PER_KEYFRAME);
+
+	const u8* payload;
+	if (snap.keyframe)
+	{
+		payload = state;
+		snap.payload_size = snap.state_size;
+	}
+	else
+	{
+		// Layout is a bitmap of the pages which changed, followed by those pages XORed with the keyframe.
+		const u32 num_pages = (snap.state_size + DELTA_PAGE_SIZE - 1) / DELTA_PAGE_SIZE;
+		const u32 bitmap_size = ((num_pages + 63) / 64) * sizeof(u64);
+		s_scratch.resize(bitmap_size + static_cast<size_t>(num_pages) * DELTA_PAGE_SIZE);
+		std::memset(s_scratch.data(), 0, bitmap_size);
+
+		u64* bitmap = reinterpret_cast<u64*>(s_scratch.data());
+		u8* out = s_scratch.data() + bitmap_size;
+		for (u32 page = 0; page < num_pages; page++)
+		{
+			const u32 offset = page * DELTA_PAGE_SIZE;
+			const u32 len = std::min(DELTA_PAGE_SIZE, snap.state_size - offset);
+			const u32 ref_len = (offset < s_reference.size()) ?
+									std::min<u32>(len, static_cast<u32>(s_reference.size() - offset)) :
+									0;
+			const u8* cur = state + offset;
+			const u8* ref = s_reference.data() + offset;
+			if (ref_len == len && std::memcmp(cur, ref, len) == 0)
+				continue;
+
+			bitmap[page / 64] |= (static_cast<u64>(1) << (page % 64));
+			for (u32 i = 0; i < ref_len; i++)
+				out[i] = cur[i] ^ ref[i];
+			std::memcpy(out + ref_len, cur + ref_len, len - ref_len);
+			out += len;
+		}
+
+		payload = s_scratch.data();
+		snap.payload_size = static_cast<u32>(out - s_scratch.data());
+	}
+
+	snap.data.resize(ZSTD_compressBound(snap.payload_size));
+	const size_t compressed_size =
+		ZSTD_compressCCtx(s_cctx, snap.data.data(), snap.data.size(), payload, snap.payload_size, COMPRESSION_LEVEL);
+	if (ZSTD_isError(compressed_size))
+	{
+		Console.Error("Rewind: Failed to compress state: %s", ZSTD_getErrorName(compressed_size));
+		snap.data.clear();
+		return snap;
+	}
+
+	snap.data.resize(compressed_size);
+	snap.data.shrink_to_fit();
+
+	if (snap.keyframe)
+	{
+		s_reference.assign(state, state + snap.state_size);
+		s_reference_compressed_size = compressed_size;
+		s_deltas_since_keyframe = 0;
+	}
+	else
+	{
+		// Once a delta is as large as half a keyframe, a fresh keyframe is cheaper.
+		s_deltas_since_keyframe++;
+		if (compressed_size > (s_reference_compressed_size / 2))
+			s_deltas_since_keyframe = MAX_DELTAS_PER_KEYFRAME;
+	}
+
+	return snap;
+}
+
+bool Rewind::DecodeSnapshot(const Snapshot& snap, std::vector<u8>& dst)
+{
+	if (snap.keyframe)
+	{
+		dst.resize(snap.state_size);
+		const size_t size = ZSTD_decompress(dst.data(), dst.size(), snap.data.data(), snap.data.size());
+		return (!ZSTD_isError(size) && size == snap.state_size);
+	}
+
+	s_scratch.resize(snap.payload_size);
+	const size_t size = ZSTD_decompress(s_scratch.data(), s_scratch.size(), snap.data.data(), snap.data.size());
+	if (ZSTD_isError(size) || size != snap.payload_size)
+		return false;
+
+	const u32 num_pages = (snap.state_size + DELTA_PAGE_SIZE - 1) / DELTA_PAGE_SIZE;
+	const u32 bitmap_size = ((num_pages + 63) / 64) * sizeof(u64);
+	if (snap.payload_size < bitmap_size)
+		return false;
+
+	// Start from the keyframe, zero extending it if the state has grown since.
+	dst.resize(snap.state_size);
+	const size_t ref_size = std::min<size_t>(s_reference.size(), snap.state_size);
+	std::memcpy(dst.data(), s_reference.data(), ref_size);
+	std::memset(dst.data() + ref_size, 0, snap.state_size - ref_size);
+
+	const u64* bitmap = reinterpret_cast<const u64*>(s_scratch.data());
+	const u8* in = s_scratch.data() + bitmap_size;
+	const u8* in_end = s_scratch.data() + snap.payload_size;
+	for (u32 page = 0; page < num_pages; page++)
+	{
+		if (!(bitmap[page / 64] & (static_cast<u64>(1) << (page % 64))))
+			continue;
+
+		const u32 offset = page * DELTA_PAGE_SIZE;
+		const u32 len = std::min(DELTA_PAGE_SIZE, snap.state_size - offset);
+		if (static_cast<size_t>(in_end - in) < len)
+			return false;
+
+		u8* out = dst.data() + offset;
+		for (u32 i = 0; i < len; i++)
+			out[i] ^= in[i];
+		in += len;
+	}
+
+	return true;
+}
+
+void Rewind::DecodeReference()
+{
+	// Deltas are always taken against the newest keyframe, so that's the one to keep decompressed.
+	for (auto it = s_snapshots.rbegin(); it != s_snapshots.rend(); ++it)
+	{
+		if (!it->keyframe)
+			continue;
+
+		if (DecodeSnapshot(*it, s_reference))
+		{
+			s_reference_compressed_size = it->data.size();
+			s_deltas_since_keyframe = static_cast<u32>(it - s_snapshots.rbegin());
+			return;
+		}
+
+		Console.Error("Rewind: Failed to decompress keyframe.");
+		break;
+	}
+
+	// Without a keyframe none of the remaining deltas can be restored either.
+	s_snapshots.clear();
+	s_memory_usage = 0;
+	s_reference = {};
+	s_reference_compressed_size = 0;
+	s_deltas_since_keyframe = 0;
+}
+
+void Rewind::TrimToBudget()
+{
+	const size_t budget = static_cast<size_t>(EmuConfig.Savestate.RewindBufferSize) * _1mb;
+	while (s_memory_usage > budget && !s_snapshots.empty())
+	{
+		// Deltas are useless without their keyframe, so drop the whole group.
+		do
+		{
+			s_memory_usage -= s_snapshots.front().data.size();
+			s_snapshots.pop_front();
+		} while (!s_snapshots.empty() && !s_snapshots.front().keyframe);
+	}
+
+	if (s_snapshots.empty())
+	{
+		s_reference = {};
+		s_reference_compressed_size = 0;
+		s_deltas_since_keyframe = 0;
+	}
+}
+
+void Rewind::Clear()
+{
+	std::unique_lock lock(s_mutex);
+	s_done_cv.wait(lock, []() { return !s_worker_busy; });
+
+	s_pending_state.reset();
+	s_snapshots.clear();
+	s_memory_usage = 0;
+	s_reference = {};
+	s_reference_compressed_size = 0;
+	s_deltas_since_keyframe = 0;
+	s_scratch = {};
+}
+
+void Rewind::CaptureState()
+{
+	// The worker falling behind means compression can't keep up with the interval, skip this one.
+	{
+		std::unique_lock lock(s_mutex);
+		if (s_pending_state)
+			return;
+	}
+
+	Common::Timer timer;
+	Error error;
+	std::unique_ptr<ArchiveEntryList> list = SaveState_DownloadState(&error);
+	if (!list)
+	{
+		Console.Error(fmt::format("Rewind: Failed to capture state: {}", error.GetDescription()));
+		return;
+	}
+
+	DevCon.WriteLn("Rewind: Captured state in %.2f ms", timer.GetTimeMilliseconds());
+
+	StartWorkerThread();
+
+	std::unique_lock lock(s_mutex);
+	s_pending_state = std::move(list);
+	s_work_cv.notify_one();
+}
+
+void Rewind::FrameUpdate()
+{
+	if (!EmuConfig.Savestate.EnableRewind || GSDumpReplayer::IsReplayingDump() || Achievements::IsHardcoreModeActive())
+		return;
+
+	if (s_rewinding.load(std::memory_order_relaxed))
+	{
+		LoadPreviousState();
+		return;
+	}
+
+	s_empty_message_shown = false;
+
+	if (++s_frames_since_capture < std::max(EmuConfig.Savestate.RewindFrequency, 1u))
+		return;
+
+	s_frames_since_capture = 0;
+	CaptureState();
+}
+
+void Rewind::UpdateSettings()
+{
+	if (!EmuConfig.Savestate.EnableRewind)
+	{
+		Shutdown();
+		return;
+	}
+
+	std::unique_lock lock(s_mutex);
+	s_done_cv.wait(lock, []() { return !s_worker_busy; });
+	TrimToBudget();
+}
+
+void Rewind::Shutdown()
+{
+	StopWorkerThread();
+	Clear();
+
+	s_load_list.reset();
+	s_frames_since_capture = 0;
+	s_rewinding.store(false, std::memory_order_relaxed);
+	s_empty_message_shown = false;
+}
+
+void Rewind::SetRewinding(bool enabled)
+{
+	s_rewinding.store(enabled, std::memory_order_relaxed);
+}
+
+bool Rewind::LoadPreviousState()
+{
+	if (g_InputRecording.isActive() || MemcardBusy::IsBusy())
+		return false;
+
+	if (!s_load_list)
+		s_load_list = std::make_unique<ArchiveEntryList>();
+
+	{
+		std::unique_lock lock(s_mutex);
+		s_done_cv.wait(lock, []() { return !s_worker_busy; });
+		s_pending_state.reset();
+
+		if (s_snapshots.empty())
+		{
+			if (!s_empty_message_shown)
+			{
+				Host::AddIconOSDMessage("Rewind", ICON_FA_CLOCK_ROTATE_LEFT,
+					TRANSLATE_STR("Rewind", "No more rewind states available."), Host::OSD_QUICK_DURATION);
+				s_empty_message_shown = true;
+			}
+
+			return false;
+		}
+
+		Snapshot snap = std::move(s_snapshots.back());
+		s_snapshots.pop_back();
+		s_memory_usage -= snap.data.size();
+
+		s_load_list->Clear();
+		if (!DecodeSnapshot(snap, s_load_list->GetBuffer()))
+		{
+			Console.Error("Rewind: Failed to decompress state.");
+			return false;
+		}
+
+		for (const ArchiveEntry& entry : snap.entries)
+			s_load_list->Add(entry);
+
+		// Popping a keyframe means the deltas before it belong to the previous one.
+		if (snap.keyframe)
+			DecodeReference();
+		else if (s_deltas_since_keyframe > 0)
+			s_deltas_since_keyframe--;
+	}
+
+	Error error;
+	if (!SaveState_LoadFromMemory(*s_load_list, &error))
+	{
+		Host::AddIconOSDMessage("Rewind", ICON_FA_TRIANGLE_EXCLAMATION,
+			fmt::format(TRANSLATE_FS("Rewind", "Failed to rewind: {}."), error.GetDescription()), Host::OSD_ERROR_DURATION);
+		return false;
+	}
+
+	s_frames_since_capture = 0;
+	return true;
+}
+
+u32 Rewind::GetStateCount()
+{
+	std::unique_lock lock(s_mutex);
+	return static_cast<u32>(s_snapshots.size());
+}
+
+size_t Rewind::GetMemoryUsage()
+{
+	std::unique_lock lock(s_mutex);
+	return s_memory_usage;
+}
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Types.h"
+
+#include <cstddef>
+
+/// In-memory ring of periodic save states, used to step the VM back in time.
+/// Keyframes hold a full compressed state, the snapshots in between only hold the
+/// pages which differ from the most recent keyframe.
+namespace Rewind
+{
+	/// Captures a snapshot every few frames, or steps back while rewinding. Called on the CPU thread once per frame.
+	void FrameUpdate();
+
+	/// Drops or trims the buffer after the rewind settings change.
+	void UpdateSettings();
+
+	/// Stops the compression thread and frees all snapshots.
+	void Shutdown();
+
+	/// Starts or stops rewinding, one snapshot is loaded per frame while active.
+	void SetRewinding(bool enabled);
+
+	/// Loads the most recent snapshot and removes it from the buffer.
+	bool LoadPreviousState();
+
+	/// Returns the number of snapshots in the buffer.
+	u32 GetStateCount();
+
+	/// Returns the compressed size of all snapshots in bytes.
+	size_t GetMemoryUsage();
+} // namespace Rewind
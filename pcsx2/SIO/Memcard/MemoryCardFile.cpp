@@ -166,6 +166,20 @@ protected:
 	bool m_ispsx[8] = {};
 	u32 m_chkaddr = 0;
 
+	// Games erase a block and then program its pages one command at a time.
+	// The most recently accessed erase block is kept in memory and written back
+	// when another block is accessed, or a few frames after the last write.
+	static constexpr u32 InvalidBlock = 0xFFFFFFFFu;
+	static constexpr int FramesAfterWriteUntilFlush = 2;
+	struct CachedEraseBlock
+	{
+		u8 data[MC2_ERASE_SIZE];
+		u32 adr = InvalidBlock;
+		bool dirty = false;
+	};
+	CachedEraseBlock m_block[8];
+	int m_framesUntilFlush[8] = {};
+
 public:
 	FileMemoryCard();
 	~FileMemoryCard();
@@ -183,10 +197,17 @@ public:
 	s32 Save(uint slot, const u8* src, u32 adr, int size);
 	s32 EraseBlock(uint slot, u32 adr);
 	u64 GetCRC(uint slot);
+	void NextFrame(uint slot);
 
 protected:
 	bool Seek(std::FILE* f, u32 adr);
 	bool Create(const char* mcdFile, uint sizeInMB);
+
+	// Returns the cached data for [adr, adr + size), switching the cached block if needed.
+	// Returns nullptr for PSX cards, ranges crossing an erase block, and I/O errors.
+	u8* GetCachedBlockData(uint slot, u32 adr, int size, bool load);
+	bool FlushBlock(uint slot);
+	void InvalidateBlock(uint slot);
 };
 
 uint FileMcd_GetMtapPort(uint slot)
@@ -324,6 +345,9 @@ void FileMemoryCard::Open()
 		else // Load checksum
 		{
 			m_fileSize[slot] = FileSystem::FSize64(m_file[slot]);
+			m_block[slot].adr = InvalidBlock;
+			m_block[slot].dirty = false;
+			m_framesUntilFlush[slot] = 0;
 
 			Console.WriteLnFmt(Color_Green, "McdSlot {} [File]: {} [{} MB, {}]", slot, Path::GetFileName(fname),
 				(m_fileSize[slot] + (MCD_SIZE + 1)) / MC2_MBSIZE,
@@ -350,6 +374,8 @@ void FileMemoryCard::Close()
 		if (!m_file[slot])
 			continue;
 
+		InvalidateBlock(slot);
+
 		// Store checksum
 		if (!m_ispsx[slot] && FileSystem::FSeek64(m_file[slot], m_chkaddr, SEEK_SET) == 0)
 			std::fwrite(&m_chksum[slot], sizeof(m_chksum[slot]), 1, m_file[slot]);
@@ -375,6 +401,53 @@ bool FileMemoryCard::Seek(std::FILE* f, u32 adr)
 	return (FileSystem::FSeek64(f, adr, SEEK_SET) == 0);
 }
 
+u8* FileMemoryCard::GetCachedBlockData(uint slot, u32 adr, int size, bool load)
+{
+	const u32 base = adr - (adr % MC2_ERASE_SIZE);
+	if (m_ispsx[slot] || size <= 0 || adr + size > base + MC2_ERASE_SIZE)
+		return nullptr;
+
+	CachedEraseBlock& block = m_block[slot];
+	if (block.adr != base)
+	{
+		if (!FlushBlock(slot))
+			return nullptr;
+
+		block.adr = InvalidBlock;
+		if (load && (!Seek(m_file[slot], base) || std::fread(block.data, sizeof(block.data), 1, m_file[slot]) != 1))
+			return nullptr;
+
+		block.adr = base;
+	}
+
+	return &block.data[adr - base];
+}
+
+bool FileMemoryCard::FlushBlock(uint slot)
+{
+	CachedEraseBlock& block = m_block[slot];
+	if (!block.dirty)
+		return true;
+
+	if (!Seek(m_file[slot], block.adr) || std::fwrite(block.data, sizeof(block.data), 1, m_file[slot]) != 1 ||
+		std::fflush(m_file[slot]) != 0)
+	{
+		Console.Error("(FileMcd) Failed to write erase block %08X. (%d)", block.adr, slot);
+		return false;
+	}
+
+	block.dirty = false;
+	return true;
+}
+
+void FileMemoryCard::InvalidateBlock(uint slot)
+{
+	FlushBlock(slot);
+	m_block[slot].adr = InvalidBlock;
+	m_block[slot].dirty = false;
+	m_framesUntilFlush[slot] = 0;
+}
+
 // returns FALSE if an error occurred (either permission denied or disk full)
 bool FileMemoryCard::Create(const char* mcdFile, uint sizeInMB)
 {
@@ -432,6 +505,14 @@ s32 FileMemoryCard::Read(uint slot, u8* dest, u32 adr, int size)
 		memset(dest, 0, size);
 		return 1;
 	}
+
+	if (const u8* cached = GetCachedBlockData(slot, adr, size, true))
+	{
+		std::memcpy(dest, cached, size);
+		return 1;
+	}
+
+	InvalidateBlock(slot);
 	if (!Seek(mcfp, adr))
 		return 0;
 	return std::fread(dest, size, 1, mcfp) == 1;
@@ -447,6 +528,10 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 		return 1;
 	}
 
+	u8* const cached = GetCachedBlockData(slot, adr, size, true);
+	if (!cached)
+		InvalidateBlock(slot);
+
 	if (m_ispsx[slot])
 	{
 		if (static_cast<int>(m_currentdata.size()) < size)
@@ -456,14 +541,22 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 	}
 	else
 	{
-		if (!Seek(mcfp, adr))
-			return 0;
 		if (static_cast<int>(m_currentdata.size()) < size)
 			m_currentdata.resize(size);
 
-		const size_t read_result = std::fread(m_currentdata.data(), size, 1, mcfp);
-		if (read_result == 0)
-			Host::ReportErrorAsync("Memory Card Read Failed", "Error reading memory card.");
+		if (cached)
+		{
+			std::memcpy(m_currentdata.data(), cached, size);
+		}
+		else
+		{
+			if (!Seek(mcfp, adr))
+				return 0;
+
+			const size_t read_result = std::fread(m_currentdata.data(), size, 1, mcfp);
+			if (read_result == 0)
+				Host::ReportErrorAsync("Memory Card Read Failed", "Error reading memory card.");
+		}
 
 		for (int i = 0; i < size; i++)
 		{
@@ -485,10 +578,23 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 		}
 	}
 
-	if (!Seek(mcfp, adr))
-		return 0;
+	bool written;
+	if (cached)
+	{
+		std::memcpy(cached, m_currentdata.data(), size);
+		m_block[slot].dirty = true;
+		m_framesUntilFlush[slot] = FramesAfterWriteUntilFlush;
+		written = true;
+	}
+	else
+	{
+		if (!Seek(mcfp, adr))
+			return 0;
+
+		written = (std::fwrite(m_currentdata.data(), size, 1, mcfp) == 1);
+	}
 
-	if (std::fwrite(m_currentdata.data(), size, 1, mcfp) == 1)
+	if (written)
 	{
 		static auto last = std::chrono::time_point<std::chrono::system_clock>();
 
@@ -516,6 +622,16 @@ s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
 		return 1;
 	}
 
+	// The whole block is overwritten, so there is no need to read it first.
+	if (u8* cached = GetCachedBlockData(slot, adr, MC2_ERASE_SIZE, false))
+	{
+		std::memset(cached, 0xff, MC2_ERASE_SIZE);
+		m_block[slot].dirty = true;
+		m_framesUntilFlush[slot] = FramesAfterWriteUntilFlush;
+		return 1;
+	}
+
+	InvalidateBlock(slot);
 	if (!Seek(mcfp, adr))
 		return 0;
 
@@ -563,6 +679,12 @@ u64 FileMemoryCard::GetCRC(uint slot)
 	return retval;
 }
 
+void FileMemoryCard::NextFrame(uint slot)
+{
+	if (m_framesUntilFlush[slot] > 0 && --m_framesUntilFlush[slot] == 0)
+		FlushBlock(slot);
+}
+
 // --------------------------------------------------------------------------------------
 //  MemoryCard Component API Bindings
 // --------------------------------------------------------------------------------------
@@ -802,9 +924,9 @@ void FileMcd_NextFrame(uint port, uint slot)
 	const uint combinedSlot = FileMcd_ConvertToSlot(port, slot);
 	switch (EmuConfig.Mcd[combinedSlot].Type)
 	{
-		//case MemoryCardType::MemoryCard_File:
-		//	Mcd::impl.NextFrame( combinedSlot );
-		//	break;
+		case MemoryCardType::File:
+			Mcd::impl.NextFrame(combinedSlot);
+			break;
 		case MemoryCardType::Folder:
 			Mcd::implFolder.NextFrame(combinedSlot);
 			break;
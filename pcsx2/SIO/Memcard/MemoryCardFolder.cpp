@@ -1222,18 +1222,18 @@ void FolderMemoryCard::FlushFileEntries()
 {
 	// Flush all file entry data from the cache into m_fileEntryDict.
 	const u32 rootDirCluster = m_superBlock.data.rootdir_cluster;
-	FlushCluster(rootDirCluster + m_superBlock.data.alloc_offset);
+	const bool rootEntriesChanged = FlushCluster(rootDirCluster + m_superBlock.data.alloc_offset);
 	MemoryCardFileEntryCluster* rootEntries = &m_fileEntryDict[rootDirCluster];
 	if (rootEntries->entries[0].IsValid() && rootEntries->entries[0].IsUsed())
 	{
-		FlushFileEntries(rootDirCluster, rootEntries->entries[0].entry.data.length);
+		FlushFileEntries(rootDirCluster, rootEntries->entries[0].entry.data.length, rootEntriesChanged);
 	}
 }
 
-void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath, MemoryCardFileMetadataReference* parent)
+void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const bool entriesChanged, const std::string& dirPath, MemoryCardFileMetadataReference* parent)
 {
-	// flush the current cluster
-	FlushCluster(dirCluster + m_superBlock.data.alloc_offset);
+	// The metadata and index files only mirror the entries in this cluster, so when the game didn't write
+	// to the cluster there is nothing to update. This avoids rewriting the index of every file on every flush.
 
 	// if either of the current entries is a subdir, flush that too
 	MemoryCardFileEntryCluster* entries = &m_fileEntryDict[dirCluster];
@@ -1252,7 +1252,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 					bool filenameCleaned = FileAccessHelper::CleanMemcardFilename(cleanName);
 					const std::string subDirPath(Path::Combine(dirPath, cleanName));
 
-					if (m_performFileWrites)
+					if (m_performFileWrites && entriesChanged)
 					{
 						// if this directory has nonstandard metadata, write that to the file system
 						const std::string fullSubDirPath(Path::Combine(m_folderName, subDirPath));
@@ -1329,7 +1329,9 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 
 					MemoryCardFileMetadataReference* dirRef = AddDirEntryToMetadataQuickAccess(entry, parent);
 
-					FlushFileEntries(entry->entry.data.cluster, entry->entry.data.length, subDirPath, dirRef);
+					const u32 subDirCluster = entry->entry.data.cluster;
+					const bool subDirEntriesChanged = FlushCluster(subDirCluster + m_superBlock.data.alloc_offset);
+					FlushFileEntries(subDirCluster, entry->entry.data.length, subDirEntriesChanged, subDirPath, dirRef);
 				}
 			}
 			else if (entry->IsFile())
@@ -1339,7 +1341,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 				if (entry->entry.data.length == 0)
 				{
 					// empty files need to be explicitly created, as there will be no data cluster referencing it later
-					if (m_performFileWrites)
+					if (m_performFileWrites && entriesChanged)
 					{
 						char cleanName[sizeof(entry->entry.data.name)];
 						memcpy(cleanName, (const char*)entry->entry.data.name, sizeof(cleanName));
@@ -1359,7 +1361,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 					}
 				}
 
-				if (m_performFileWrites)
+				if (m_performFileWrites && entriesChanged)
 				{
 					FileAccessHelper::WriteIndex(m_folderName, entry, parent);
 				}
@@ -1371,7 +1373,9 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 	const u32 nextCluster = m_fat.data[0][0][dirCluster];
 	if (nextCluster != (LastDataCluster | DataClusterInUseMask))
 	{
-		FlushFileEntries(nextCluster & NextDataClusterMask, remainingFiles - 2, dirPath, parent);
+		const u32 nextDirCluster = nextCluster & NextDataClusterMask;
+		const bool nextEntriesChanged = FlushCluster(nextDirCluster + m_superBlock.data.alloc_offset);
+		FlushFileEntries(nextDirCluster, remainingFiles - 2, nextEntriesChanged, dirPath, parent);
 	}
 }
 
@@ -485,7 +485,8 @@ protected:
 	void FlushFileEntries();
 
 	// flush a directory's file entries and all its subdirectories to the internal data
-	void FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath = {}, MemoryCardFileMetadataReference* parent = nullptr);
+	// the caller flushes dirCluster itself, host file system metadata is only rewritten when entriesChanged is set
+	void FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const bool entriesChanged, const std::string& dirPath = {}, MemoryCardFileMetadataReference* parent = nullptr);
 
 	// "delete" (prepend '_pcsx2_deleted_' to) any files that exist in oldFileEntries but no longer exist in m_fileEntryDict
 	// also calls RemoveUnchangedDataFromCache() since both operate on comparing with the old file entires
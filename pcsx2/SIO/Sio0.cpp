@@ -2,9 +2,11 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "Input/InputManager.h"
 #include "IopDma.h"
 #include "IopHw.h"
 #include "R3000A.h"
+#include "Recording/InputRecording.h"
 #include "SIO/Memcard/MemoryCardProtocol.h"
 #include "SIO/Pad/Pad.h"
 #include "SIO/Pad/PadBase.h"
@@ -164,6 +166,8 @@ void Sio0::SetTxData(u8 cmd)
 			sioMode = cmd;
 			currentPad = Pad::GetPad(port, slot);
 			currentPad->SoftReset();
+			if (sioMode == SioMode::PAD && !g_InputRecording.isActive())
+				InputManager::LatchSources();
 			mcd = &mcds[port][slot];
 			SetAcknowledge(true);
 			break;
@@ -4,6 +4,7 @@
 #include "Common.h"
 #include "Host.h"
 #include "IopDma.h"
+#include "Input/InputManager.h"
 #include "Recording/InputRecording.h"
 #include "SIO/Memcard/MemoryCardProtocol.h"
 #include "SIO/Multitap/MultitapProtocol.h"
@@ -163,6 +164,10 @@ void Sio2::Pad()
 	g_Sio2FifoOut.push_back(0xff);
 	pad->SoftReset();
 
+	// Sample the controllers as late as possible, unless a recording dictates the pad state.
+	if (!g_InputRecording.isActive())
+		InputManager::LatchSources();
+
 	// Then for every byte in g_Sio2FifoIn, pass to PAD and see what it kicks back to us.
 	while (!g_Sio2FifoIn.empty())
 	{
@@ -89,6 +89,12 @@ int g_counter_cache_ignores = 0;
 #define XAFLAG_LOOP (1ul << 1)
 #define XAFLAG_LOOP_START (1ul << 2)
 
+static __forceinline void StopVoice(V_Core& thiscore, uint voiceidx)
+{
+	thiscore.Voices[voiceidx].Stop();
+	ActiveVoices[thiscore.Index] &= ~(1u << voiceidx);
+}
+
 static __forceinline s32 GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 {
 	V_Voice& vc(thiscore.Voices[voiceidx]);
@@ -125,7 +131,7 @@ static __forceinline s32 GetNextDataBuffered(V_Core& thiscore, uint voiceidx)
 				vc.NextA = vc.LoopStartA | 1;
 				if (!(vc.LoopFlags & XAFLAG_LOOP))
 				{
-					vc.Stop();
+					StopVoice(thiscore, voiceidx);
 
 					if (IsDevBuild)
 					{
@@ -293,7 +299,7 @@ static __forceinline void CalculateADSR(V_Core& thiscore, uint voiceidx)
 			if (SPU2::MsgVoiceOff())
 				SPU2::ConLog("* SPU2: Voice Off by ADSR: %d \n", voiceidx);
 		}
-		vc.Stop();
+		StopVoice(thiscore, voiceidx);
 	}
 
 	pxAssume(vc.ADSR.Value >= 0); // ADSR should never be negative...
@@ -310,7 +316,8 @@ __forceinline static s32 GaussianInterpolate(s32 pv4, s32 pv3, s32 pv2, s32 pv1,
 	return out;
 }
 
-static __forceinline s32 GetVoiceValues(V_Core& thiscore, uint voiceidx)
+// Advances the voice to the current sample position and returns the interpolation table index.
+static __forceinline s32 AdvanceVoiceSamples(V_Core& thiscore, uint voiceidx)
 {
 	V_Voice& vc(thiscore.Voices[voiceidx]);
 
@@ -325,7 +332,15 @@ static __forceinline s32 GetVoiceValues(V_Core& thiscore, uint voiceidx)
 
 	const s32 mu = vc.SP + 0x1000;
 
-	return GaussianInterpolate(vc.PV4, vc.PV3, vc.PV2, vc.PV1, (mu & 0x0ff0) >> 4);
+	return (mu & 0x0ff0) >> 4;
+}
+
+static __forceinline s32 GetVoiceValues(V_Core& thiscore, uint voiceidx)
+{
+	V_Voice& vc(thiscore.Voices[voiceidx]);
+	const s32 i = AdvanceVoiceSamples(thiscore, voiceidx);
+
+	return GaussianInterpolate(vc.PV4, vc.PV3, vc.PV2, vc.PV1, i);
 }
 
 // This is Dr. Hell's noise algorithm as implemented in pcsxr
@@ -455,23 +470,148 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 	return voiceOut;
 }
 
+// Runs the sequential part of MixVoice (volume slides, pitch, decoding and ADSR) and stages the
+// results for MixVoiceBlock. Returns true if the voice is playing.
+static __forceinline bool StageVoice(uint coreidx, uint voiceidx, V_VoiceMixBlock& block)
+{
+	V_Core& thiscore(Cores[coreidx]);
+	V_Voice& vc(thiscore.Voices[voiceidx]);
+
+	pxAssertMsg((vc.SCurrent <= 28) && (vc.SCurrent != 0), "Current sample should always range from 1->28");
+
+	vc.Volume.Update();
+	UpdatePitch(coreidx, voiceidx);
+
+	const std::array<int16_t, 4>* coefs = nullptr;
+	s32 noise = 0;
+	s32 envelope = 0;
+	const bool playing = (vc.ADSR.Phase > V_ADSR::PHASE_STOPPED);
+
+	if (playing)
+	{
+		if (vc.Noise)
+			noise = GetNoiseValues(thiscore);
+		else
+			coefs = &interpTable[AdvanceVoiceSamples(thiscore, voiceidx)];
+
+		CalculateADSR(thiscore, voiceidx);
+		envelope = vc.ADSR.Value;
+	}
+	else
+	{
+		while (vc.SP >= 0)
+			GetNextDataDummy(thiscore, voiceidx); // Dummy is enough
+	}
+
+	block.Coefs[0][voiceidx] = coefs ? (*coefs)[0] : 0;
+	block.Coefs[1][voiceidx] = coefs ? (*coefs)[1] : 0;
+	block.Coefs[2][voiceidx] = coefs ? (*coefs)[2] : 0;
+	block.Coefs[3][voiceidx] = coefs ? (*coefs)[3] : 0;
+	block.Samples[0][voiceidx] = vc.PV4;
+	block.Samples[1][voiceidx] = vc.PV3;
+	block.Samples[2][voiceidx] = vc.PV2;
+	block.Samples[3][voiceidx] = vc.PV1;
+	block.Noise[voiceidx] = noise;
+	block.Envelope[voiceidx] = envelope;
+	block.VolL[voiceidx] = vc.Volume.Left.Value;
+	block.VolR[voiceidx] = vc.Volume.Right.Value;
+	block.Gates[0][voiceidx] = thiscore.VoiceGates[voiceidx].DryL;
+	block.Gates[1][voiceidx] = thiscore.VoiceGates[voiceidx].DryR;
+	block.Gates[2][voiceidx] = thiscore.VoiceGates[voiceidx].WetL;
+	block.Gates[3][voiceidx] = thiscore.VoiceGates[voiceidx].WetR;
+
+	return playing;
+}
+
+// A stopped voice outputs silence, but its volume slides, pitch, and address keep running, since
+// games can read NextA and the address still raises IRQs and sets ENDX as it passes block ends.
+static __forceinline void AdvanceStoppedVoice(uint coreidx, uint voiceidx)
+{
+	V_Core& thiscore(Cores[coreidx]);
+	V_Voice& vc(thiscore.Voices[voiceidx]);
+
+	vc.Volume.Update();
+	UpdatePitch(coreidx, voiceidx);
+
+	while (vc.SP >= 0)
+		GetNextDataDummy(thiscore, voiceidx); // Dummy is enough
+}
+
 const VoiceMixSet VoiceMixSet::Empty((StereoOut32()), (StereoOut32())); // Don't use SteroOut32::Empty because C++ doesn't make any dep/order checks on global initializers.
 
+static V_VoiceMixBlock s_voice_mix_blocks[2];
+
 static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
 
+	// Pitch modulation makes a voice depend on the output of the one before it, so those
+	// have to be mixed one voice at a time.
+	bool modulated = false;
+	for (uint voiceidx = 1; voiceidx < V_Core::NumVoices; ++voiceidx)
+		modulated |= (thiscore.Voices[voiceidx].Modulated != 0);
+
+	if (modulated)
+	{
+		for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+		{
+			StereoOut32 VVal(MixVoice(coreidx, voiceidx));
+
+			// Note: Results from MixVoice are ranged at 16 bits.
+
+			dest.Dry.Left += VVal.Left & thiscore.VoiceGates[voiceidx].DryL;
+			dest.Dry.Right += VVal.Right & thiscore.VoiceGates[voiceidx].DryR;
+			dest.Wet.Left += VVal.Left & thiscore.VoiceGates[voiceidx].WetL;
+			dest.Wet.Right += VVal.Right & thiscore.VoiceGates[voiceidx].WetR;
+		}
+
+		return;
+	}
+
+	V_VoiceMixBlock& block = s_voice_mix_blocks[coreidx];
+	const u32 active = ActiveVoices[coreidx];
+	u32 playing = 0;
+
+	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+	{
+		pxAssertMsg(((active >> voiceidx) & 1) == (thiscore.Voices[voiceidx].ADSR.Phase > V_ADSR::PHASE_STOPPED),
+			"Active voice mask is out of sync with the ADSR phase");
+
+		if (active & (1u << voiceidx))
+		{
+			playing |= static_cast<u32>(StageVoice(coreidx, voiceidx, block)) << voiceidx;
+		}
+		else
+		{
+			// Only the envelope needs clearing, it scales everything else in the block to zero.
+			AdvanceStoppedVoice(coreidx, voiceidx);
+			block.Envelope[voiceidx] = 0;
+		}
+	}
+
+	if (playing == 0)
+	{
+		spu2M_WriteFast(((0 == coreidx) ? 0x400 : 0xc00) + OutPos, 0);
+		spu2M_WriteFast(((0 == coreidx) ? 0x600 : 0xe00) + OutPos, 0);
+		return;
+	}
+
+	MixVoiceBlock(block, dest);
+
 	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
 	{
-		StereoOut32 VVal(MixVoice(coreidx, voiceidx));
+		if (!(playing & (1u << voiceidx)))
+			continue;
 
-		// Note: Results from MixVoice are ranged at 16 bits.
+		thiscore.Voices[voiceidx].OutX = block.Out[voiceidx];
 
-		dest.Dry.Left += VVal.Left & thiscore.VoiceGates[voiceidx].DryL;
-		dest.Dry.Right += VVal.Right & thiscore.VoiceGates[voiceidx].DryR;
-		dest.Wet.Left += VVal.Left & thiscore.VoiceGates[voiceidx].WetL;
-		dest.Wet.Right += VVal.Right & thiscore.VoiceGates[voiceidx].WetR;
+		if (IsDevBuild)
+			DebugCores[coreidx].Voices[voiceidx].displayPeak = std::max(DebugCores[coreidx].Voices[voiceidx].displayPeak, (s32)block.Out[voiceidx]);
 	}
+
+	// Write-back of raw voice data (post ADSR applied), stopped voices always output zero.
+	spu2M_WriteFast(((0 == coreidx) ? 0x400 : 0xc00) + OutPos, block.Out[1]);
+	spu2M_WriteFast(((0 == coreidx) ? 0x600 : 0xe00) + OutPos, block.Out[3]);
 }
 
 StereoOut32 V_Core::Mix(const VoiceMixSet& inVoices, const StereoOut32& Input, const StereoOut32& Ext)
@@ -7,6 +7,7 @@
 #include "common/Console.h"
 
 #include <array>
+#include <cstring>
 
 void V_Core::AnalyzeReverbPreset()
 {
@@ -43,16 +44,117 @@ void V_Core::AnalyzeReverbPreset()
 	Console.WriteLn("----------------------------------------------------------");
 }
 
-__forceinline s32 V_Core::RevbGetIndexer(s32 offset)
+namespace
 {
-	u32 start = EffectsStartA & 0x3f'ffff;
-	u32 end = (EffectsEndA & 0x3f'ffff) | 0xffff;
+	// Work area locations used by one step of the reverb network.
+	enum ReverbTap : u32
+	{
+		TAP_SAME_SRC,
+		TAP_SAME_DST,
+		TAP_SAME_PRV,
+		TAP_DIFF_SRC,
+		TAP_DIFF_DST,
+		TAP_DIFF_PRV,
+		TAP_COMB1_SRC,
+		TAP_COMB2_SRC,
+		TAP_COMB3_SRC,
+		TAP_COMB4_SRC,
+		TAP_APF1_SRC,
+		TAP_APF1_DST,
+		TAP_APF2_SRC,
+		TAP_APF2_DST,
+		NUM_REVERB_TAPS,
+
+		// Padded to a whole number of vectors, the spare slots repeat TAP_SAME_SRC.
+		NUM_REVERB_TAP_SLOTS = 16,
+	};
+
+	// Each tap address is ((Cycles / 2) + offset) modulo the work area size. The counter only moves
+	// forward by one between samples of the same channel, so instead of dividing for every tap on
+	// every sample, the previous indices are stepped and only recomputed when something changes.
+	struct alignas(16) ReverbTapState
+	{
+		u32 offsets[NUM_REVERB_TAP_SLOTS]; // Register values the indices were computed from
+		u32 sums[NUM_REVERB_TAP_SLOTS]; // Counter plus offset, wrapping at 32 bits like the original sum
+		u32 indices[NUM_REVERB_TAP_SLOTS]; // sums modulo the work area size
+		u32 start;
+		u32 size;
+		u32 counter;
+		bool valid;
+	};
+} // namespace
+
+static ReverbTapState s_reverb_taps[2][2];
+
+static __forceinline void GetReverbTapAddresses(const V_Core& core, bool right, u32* addresses)
+{
+	const V_Reverb& revb = core.Revb;
+	const u32 start = core.EffectsStartA & 0x3f'ffff;
+	const u32 end = (core.EffectsEndA & 0x3f'ffff) | 0xffff;
+	const u32 size = (end - start) + 1;
+	const u32 counter = Cycles >> 1;
+
+	alignas(16) const u32 offsets[NUM_REVERB_TAP_SLOTS] = {
+		right ? revb.SAME_R_SRC : revb.SAME_L_SRC,
+		right ? revb.SAME_R_DST : revb.SAME_L_DST,
+		right ? revb.SAME_R_DST - 1 : revb.SAME_L_DST - 1,
+		right ? revb.DIFF_L_SRC : revb.DIFF_R_SRC,
+		right ? revb.DIFF_R_DST : revb.DIFF_L_DST,
+		right ? revb.DIFF_R_DST - 1 : revb.DIFF_L_DST - 1,
+		right ? revb.COMB1_R_SRC : revb.COMB1_L_SRC,
+		right ? revb.COMB2_R_SRC : revb.COMB2_L_SRC,
+		right ? revb.COMB3_R_SRC : revb.COMB3_L_SRC,
+		right ? revb.COMB4_R_SRC : revb.COMB4_L_SRC,
+		right ? (revb.APF1_R_DST - revb.APF1_SIZE) : (revb.APF1_L_DST - revb.APF1_SIZE),
+		right ? revb.APF1_R_DST : revb.APF1_L_DST,
+		right ? (revb.APF2_R_DST - revb.APF2_SIZE) : (revb.APF2_L_DST - revb.APF2_SIZE),
+		right ? revb.APF2_R_DST : revb.APF2_L_DST,
+		right ? revb.SAME_R_SRC : revb.SAME_L_SRC,
+		right ? revb.SAME_R_SRC : revb.SAME_L_SRC,
+	};
+
+	ReverbTapState& taps = s_reverb_taps[core.Index][right];
+
+	GSVector4i changed = GSVector4i::zero();
+	for (u32 i = 0; i < NUM_REVERB_TAP_SLOTS; i += 4)
+		changed = changed | ~GSVector4i::load<true>(&offsets[i]).eq32(GSVector4i::load<true>(&taps.offsets[i]));
+
+	if (taps.valid && changed.allfalse() && taps.start == start && taps.size == size && counter == taps.counter + 1)
+	{
+		const GSVector4i one = GSVector4i::cxpr(1);
+		const GSVector4i vsize = GSVector4i(static_cast<int>(size));
+		for (u32 i = 0; i < NUM_REVERB_TAP_SLOTS; i += 4)
+		{
+			const GSVector4i sum = GSVector4i::load<true>(&taps.sums[i]).add32(one);
+			GSVector4i index = GSVector4i::load<true>(&taps.indices[i]).add32(one);
+
+			// A wrapped sum restarts at zero, otherwise the index wraps at the end of the work area.
+			index = index.andnot(sum.eq32(GSVector4i::zero()) | index.eq32(vsize));
+
+			GSVector4i::store<true>(&taps.sums[i], sum);
+			GSVector4i::store<true>(&taps.indices[i], index);
+		}
+	}
+	else
+	{
+		std::memcpy(taps.offsets, offsets, sizeof(offsets));
+		for (u32 i = 0; i < NUM_REVERB_TAP_SLOTS; i++)
+		{
+			taps.sums[i] = counter + offsets[i];
+			taps.indices[i] = taps.sums[i] % size;
+		}
 
-	u32 x = ((Cycles >> 1) + offset) % ((end - start) + 1);
+		taps.start = start;
+		taps.size = size;
+		taps.valid = true;
+	}
 
-	x += start;
+	taps.counter = counter;
 
-	return x & 0xf'ffff;
+	const GSVector4i vstart = GSVector4i(static_cast<int>(start));
+	const GSVector4i mask = GSVector4i::cxpr(0xf'ffff);
+	for (u32 i = 0; i < NUM_REVERB_TAP_SLOTS; i += 4)
+		GSVector4i::store<false>(&addresses[i], GSVector4i::load<true>(&taps.indices[i]).add32(vstart) & mask);
 }
 
 StereoOut32 V_Core::DoReverb(StereoOut32 Input)
@@ -73,23 +175,21 @@ StereoOut32 V_Core::DoReverb(StereoOut32 Input)
 
 	// Calculate the read/write addresses we'll be needing for this session of reverb.
 
-	const u32 same_src = RevbGetIndexer(R ? Revb.SAME_R_SRC : Revb.SAME_L_SRC);
-	const u32 same_dst = RevbGetIndexer(R ? Revb.SAME_R_DST : Revb.SAME_L_DST);
-	const u32 same_prv = RevbGetIndexer(R ? Revb.SAME_R_DST - 1 : Revb.SAME_L_DST - 1);
+	alignas(16) u32 taps[NUM_REVERB_TAP_SLOTS];
+	GetReverbTapAddresses(*this, R, taps);
 
-	const u32 diff_src = RevbGetIndexer(R ? Revb.DIFF_L_SRC : Revb.DIFF_R_SRC);
-	const u32 diff_dst = RevbGetIndexer(R ? Revb.DIFF_R_DST : Revb.DIFF_L_DST);
-	const u32 diff_prv = RevbGetIndexer(R ? Revb.DIFF_R_DST - 1 : Revb.DIFF_L_DST - 1);
+	const u32 same_src = taps[TAP_SAME_SRC];
+	const u32 same_dst = taps[TAP_SAME_DST];
+	const u32 same_prv = taps[TAP_SAME_PRV];
 
-	const u32 comb1_src = RevbGetIndexer(R ? Revb.COMB1_R_SRC : Revb.COMB1_L_SRC);
-	const u32 comb2_src = RevbGetIndexer(R ? Revb.COMB2_R_SRC : Revb.COMB2_L_SRC);
-	const u32 comb3_src = RevbGetIndexer(R ? Revb.COMB3_R_SRC : Revb.COMB3_L_SRC);
-	const u32 comb4_src = RevbGetIndexer(R ? Revb.COMB4_R_SRC : Revb.COMB4_L_SRC);
+	const u32 diff_src = taps[TAP_DIFF_SRC];
+	const u32 diff_dst = taps[TAP_DIFF_DST];
+	const u32 diff_prv = taps[TAP_DIFF_PRV];
 
-	const u32 apf1_src = RevbGetIndexer(R ? (Revb.APF1_R_DST - Revb.APF1_SIZE) : (Revb.APF1_L_DST - Revb.APF1_SIZE));
-	const u32 apf1_dst = RevbGetIndexer(R ? Revb.APF1_R_DST : Revb.APF1_L_DST);
-	const u32 apf2_src = RevbGetIndexer(R ? (Revb.APF2_R_DST - Revb.APF2_SIZE) : (Revb.APF2_L_DST - Revb.APF2_SIZE));
-	const u32 apf2_dst = RevbGetIndexer(R ? Revb.APF2_R_DST : Revb.APF2_L_DST);
+	const u32 apf1_src = taps[TAP_APF1_SRC];
+	const u32 apf1_dst = taps[TAP_APF1_DST];
+	const u32 apf2_src = taps[TAP_APF2_SRC];
+	const u32 apf2_dst = taps[TAP_APF2_DST];
 
 	// -----------------------------------------
 	//          Optimized IRQ Testing !
@@ -104,15 +204,12 @@ StereoOut32 V_Core::DoReverb(StereoOut32 Input)
 	{
 		if (FxEnable && Cores[i].IRQEnable && ((Cores[i].IRQA >= EffectsStartA) && (Cores[i].IRQA <= EffectsEndA)))
 		{
-			if ((Cores[i].IRQA == same_src) || (Cores[i].IRQA == diff_src) ||
-				(Cores[i].IRQA == same_dst) || (Cores[i].IRQA == diff_dst) ||
-				(Cores[i].IRQA == same_prv) || (Cores[i].IRQA == diff_prv) ||
-
-				(Cores[i].IRQA == comb1_src) || (Cores[i].IRQA == comb2_src) ||
-				(Cores[i].IRQA == comb3_src) || (Cores[i].IRQA == comb4_src) ||
+			const GSVector4i irqa = GSVector4i(static_cast<int>(Cores[i].IRQA));
+			GSVector4i hit = GSVector4i::zero();
+			for (u32 j = 0; j < NUM_REVERB_TAP_SLOTS; j += 4)
+				hit = hit | GSVector4i::load<true>(&taps[j]).eq32(irqa);
 
-				(Cores[i].IRQA == apf1_dst) || (Cores[i].IRQA == apf1_src) ||
-				(Cores[i].IRQA == apf2_dst) || (Cores[i].IRQA == apf2_src))
+			if (!hit.allfalse())
 			{
 				//printf("Core %d IRQ Called (Reverb). IRQA = %x\n",i,addr);
 				SetIrqCall(i);
@@ -131,7 +228,11 @@ StereoOut32 V_Core::DoReverb(StereoOut32 Input)
 	same = MUL(Revb.IIR_VOL, in + MUL(Revb.WALL_VOL, _spu2mem[same_src]) - _spu2mem[same_prv]) + _spu2mem[same_prv];
 	diff = MUL(Revb.IIR_VOL, in + MUL(Revb.WALL_VOL, _spu2mem[diff_src]) - _spu2mem[diff_prv]) + _spu2mem[diff_prv];
 
-	out = MUL(Revb.COMB1_VOL, _spu2mem[comb1_src]) + MUL(Revb.COMB2_VOL, _spu2mem[comb2_src]) + MUL(Revb.COMB3_VOL, _spu2mem[comb3_src]) + MUL(Revb.COMB4_VOL, _spu2mem[comb4_src]);
+	// The four comb taps are independent of each other, so scale them together.
+	const GSVector4i comb_in(_spu2mem[taps[TAP_COMB1_SRC]], _spu2mem[taps[TAP_COMB2_SRC]], _spu2mem[taps[TAP_COMB3_SRC]], _spu2mem[taps[TAP_COMB4_SRC]]);
+	const GSVector4i comb_vol(Revb.COMB1_VOL, Revb.COMB2_VOL, Revb.COMB3_VOL, Revb.COMB4_VOL);
+	const GSVector4i comb = comb_in.mul32l(comb_vol).sra32<15>();
+	out = comb.extract32<0>() + comb.extract32<1>() + comb.extract32<2>() + comb.extract32<3>();
 
 	apf1 = out - MUL(Revb.APF1_VOL, _spu2mem[apf1_src]);
 	out = _spu2mem[apf1_src] + MUL(Revb.APF1_VOL, apf1);
@@ -526,7 +526,6 @@ struct V_Core
 
 	StereoOut32 Mix(const VoiceMixSet& inVoices, const StereoOut32& Input, const StereoOut32& Ext);
 	StereoOut32 DoReverb(StereoOut32 Input);
-	s32 RevbGetIndexer(s32 offset);
 
 	StereoOut32 ReadInput();
 	StereoOut32 ReadInput_HiFi();
@@ -576,15 +575,36 @@ struct V_Core
 	void FinishDMAwrite();
 };
 
+// Voice state of one core for a single output sample, laid out as structure-of-arrays so the
+// interpolation, envelope, volume and gate stages can run across several voices at once.
+// Filled by the mixer after each voice has advanced its decoder and ADSR.
+struct alignas(32) V_VoiceMixBlock
+{
+	s32 Coefs[4][V_Core::NumVoices]; // Gaussian taps, zero for noise and stopped voices
+	s32 Samples[4][V_Core::NumVoices]; // PV4 through PV1
+	s32 Noise[V_Core::NumVoices]; // Noise source value, zero unless the voice plays noise
+	s32 Envelope[V_Core::NumVoices]; // ADSR level, zero for stopped voices
+	s32 VolL[V_Core::NumVoices];
+	s32 VolR[V_Core::NumVoices];
+	s32 Gates[4][V_Core::NumVoices]; // DryL, DryR, WetL, WetR
+	s32 Out[V_Core::NumVoices]; // Post-ADSR voice output, written by MixVoiceBlock
+};
+
 MULTI_ISA_DEF(
 	StereoOut32 ReverbUpsample(V_Core& core);
 	s32 ReverbDownsample(V_Core& core, bool right);
+	void MixVoiceBlock(V_VoiceMixBlock& block, VoiceMixSet& dest);
 )
 
 extern StereoOut32 (*ReverbUpsample)(V_Core& core);
 extern s32 (*ReverbDownsample)(V_Core& core, bool right);
+extern void (*MixVoiceBlock)(V_VoiceMixBlock& block, VoiceMixSet& dest);
 
 extern V_Core Cores[2];
+
+// One bit per voice which isn't in PHASE_STOPPED, kept up to date on key on and whenever a voice
+// stops, so the mixer can skip silent voices. Kept outside of V_Core to not change the savestate layout.
+extern u32 ActiveVoices[2];
 extern V_SPDIF Spdif;
 
 // Output Buffer Writing Position (the same for all data);
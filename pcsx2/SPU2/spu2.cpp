@@ -5,6 +5,7 @@
 #include "SPU2/defs.h"
 #include "SPU2/Debug.h"
 #include "SPU2/Dma.h"
+#include "DebugTools/TraceCapture.h"
 #include "Host/AudioStream.h"
 #include "Host.h"
 #include "GS/GSCapture.h"
@@ -13,6 +14,10 @@
 #include "VMManager.h"
 
 #include "common/Error.h"
+#include "common/Threading.h"
+
+#include <atomic>
+#include <thread>
 
 const StereoOut32 StereoOut32::Empty(0, 0);
 
@@ -22,6 +27,10 @@ namespace SPU2
 	static void UpdateSampleRate();
 	static float GetNominalRate();
 	static void InternalReset(bool psxmode);
+	static void StartOutputThread();
+	static void StopOutputThread();
+	static void SyncOutputThread();
+	static void OutputThreadEntryPoint();
 } // namespace SPU2
 
 u32 lClocks = 0;
@@ -33,6 +42,22 @@ static std::unique_ptr<AudioStream> s_output_stream;
 static std::array<s16, AudioStream::CHUNK_SIZE * 2> s_current_chunk;
 static u32 s_current_chunk_pos;
 
+// Finished chunks are handed to the output thread through this ring when threaded output is on,
+// so resampling, stretching and expansion run off the CPU thread.
+static constexpr u32 OUTPUT_QUEUE_CHUNKS = 32;
+static std::array<std::array<s16, AudioStream::CHUNK_SIZE * 2>, OUTPUT_QUEUE_CHUNKS> s_output_queue;
+static std::atomic<u32> s_output_queue_read{0};
+static std::atomic<u32> s_output_queue_write{0};
+static Threading::WorkSema s_output_thread_sema;
+static std::thread s_output_thread;
+static std::atomic_bool s_output_thread_exit{false};
+
+// Output stats, published from the CPU thread for the performance overlay.
+static std::atomic<u32> s_output_buffered_ms{0};
+static std::atomic<u32> s_output_target_ms{0};
+static std::atomic<u32> s_output_underruns{0};
+static std::atomic<u64> s_output_memory_usage{0};
+
 u32 SPU2::GetConsoleSampleRate()
 {
 	return s_psxmode ? PSX_SAMPLE_RATE : SAMPLE_RATE;
@@ -97,6 +122,8 @@ void SPU2writeDMA7Mem(u16* pMem, u32 size)
 
 void SPU2::CreateOutputStream()
 {
+	StopOutputThread();
+
 	// Persist volume through stream recreates.
 	const u32 volume = s_output_stream ? s_output_stream->GetOutputVolume() : GetResetVolume();
 	const u32 sample_rate = GetConsoleSampleRate();
@@ -116,7 +143,66 @@ void SPU2::CreateOutputStream()
 
 	s_output_stream->SetOutputVolume(volume);
 	s_output_stream->SetNominalRate(GetNominalRate());
+
+	// The queue is static, but it's only touched with threaded output.
+	const u64 stream_buffer_size = static_cast<u64>(s_output_stream->GetBufferSize()) * s_output_stream->GetInternalChannels() * sizeof(s16);
+	s_output_memory_usage.store(stream_buffer_size + (EmuConfig.SPU2.ThreadedOutput ? sizeof(s_output_queue) : 0),
+		std::memory_order_relaxed);
 	s_output_stream->SetPaused(VMManager::GetState() == VMState::Paused);
+
+	if (EmuConfig.SPU2.ThreadedOutput)
+		StartOutputThread();
+}
+
+void SPU2::StartOutputThread()
+{
+	if (s_output_thread.joinable())
+		return;
+
+	s_output_queue_read.store(0, std::memory_order_relaxed);
+	s_output_queue_write.store(0, std::memory_order_relaxed);
+	s_output_thread_exit.store(false, std::memory_order_relaxed);
+	s_output_thread_sema.Reset();
+	s_output_thread = std::thread(&SPU2::OutputThreadEntryPoint);
+}
+
+void SPU2::StopOutputThread()
+{
+	if (!s_output_thread.joinable())
+		return;
+
+	s_output_thread_sema.WaitForEmpty();
+	s_output_thread_exit.store(true, std::memory_order_release);
+	s_output_thread_sema.NotifyOfWork();
+	s_output_thread.join();
+}
+
+void SPU2::SyncOutputThread()
+{
+	// The stream isn't thread safe, anything touching it from the CPU thread waits for queued chunks first.
+	if (s_output_thread.joinable())
+		s_output_thread_sema.WaitForEmpty();
+}
+
+void SPU2::OutputThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("SPU2 Output");
+	TraceCapture::SetThreadName("SPU2 Output");
+
+	for (;;)
+	{
+		s_output_thread_sema.WaitForWork();
+		if (s_output_thread_exit.load(std::memory_order_acquire))
+			break;
+
+		TraceCapture::ScopedEvent trace("Audio Output");
+		u32 read = s_output_queue_read.load(std::memory_order_relaxed);
+		while (read != s_output_queue_write.load(std::memory_order_acquire))
+		{
+			s_output_stream->WriteChunk(s_output_queue[read % OUTPUT_QUEUE_CHUNKS].data());
+			s_output_queue_read.store(++read, std::memory_order_release);
+		}
+	}
 }
 
 void SPU2::UpdateSampleRate()
@@ -141,6 +227,7 @@ u32 SPU2::GetOutputVolume()
 
 void SPU2::SetOutputVolume(u32 volume)
 {
+	SyncOutputThread();
 	s_output_stream->SetOutputVolume(volume);
 }
 
@@ -160,9 +247,30 @@ float SPU2::GetNominalRate()
 
 void SPU2::SetOutputPaused(bool paused)
 {
+	SyncOutputThread();
 	s_output_stream->SetPaused(paused);
 }
 
+u32 SPU2::GetOutputBufferedMS()
+{
+	return s_output_buffered_ms.load(std::memory_order_relaxed);
+}
+
+u32 SPU2::GetOutputTargetBufferMS()
+{
+	return s_output_target_ms.load(std::memory_order_relaxed);
+}
+
+u32 SPU2::GetOutputUnderrunCount()
+{
+	return s_output_underruns.load(std::memory_order_relaxed);
+}
+
+u64 SPU2::GetOutputMemoryUsage()
+{
+	return s_output_memory_usage.load(std::memory_order_relaxed);
+}
+
 void SPU2::SetAudioCaptureActive(bool active)
 {
 	s_audio_capture_active = active;
@@ -202,6 +310,8 @@ void SPU2::OnTargetSpeedChanged()
 	if (!s_output_stream)
 		return;
 
+	SyncOutputThread();
+
 	if (!s_output_stream->IsStretchEnabled())
 	{
 		s_output_stream->EmptyBuffer();
@@ -243,7 +353,9 @@ void SPU2::Close()
 {
 	FileLog("[%10d] SPU2 Close\n", Cycles);
 
+	StopOutputThread();
 	s_output_stream.reset();
+	s_output_memory_usage.store(0, std::memory_order_relaxed);
 
 #ifdef PCSX2_DEVBUILD
 	WaveDump::Close();
@@ -280,9 +392,21 @@ void SPU2::CheckForConfigChanges(const Pcsx2Config& old_config)
 	{
 		CreateOutputStream();
 	}
-	else if (opts.IsTimeStretchEnabled() != oldopts.IsTimeStretchEnabled())
+	else
 	{
-		s_output_stream->SetStretchEnabled(opts.IsTimeStretchEnabled());
+		if (opts.IsTimeStretchEnabled() != oldopts.IsTimeStretchEnabled())
+		{
+			SyncOutputThread();
+			s_output_stream->SetStretchEnabled(opts.IsTimeStretchEnabled());
+		}
+
+		if (opts.ThreadedOutput != oldopts.ThreadedOutput)
+		{
+			if (opts.ThreadedOutput)
+				StartOutputThread();
+			else
+				StopOutputThread();
+		}
 	}
 
 #ifdef PCSX2_DEVBUILD
@@ -421,9 +545,28 @@ __forceinline void spu2Output(StereoOut32 out)
 	{
 		s_current_chunk_pos = 0;
 
-		s_output_stream->WriteChunk(s_current_chunk.data());
+		if (s_output_thread.joinable())
+		{
+			// Wait rather than drop audio if the output thread has fallen a whole queue behind.
+			const u32 write = s_output_queue_write.load(std::memory_order_relaxed);
+			while ((write - s_output_queue_read.load(std::memory_order_acquire)) == OUTPUT_QUEUE_CHUNKS)
+				s_output_thread_sema.WaitForEmptyWithSpin();
+
+			s_output_queue[write % OUTPUT_QUEUE_CHUNKS] = s_current_chunk;
+			s_output_queue_write.store(write + 1, std::memory_order_release);
+			s_output_thread_sema.NotifyOfWork();
+		}
+		else
+		{
+			s_output_stream->WriteChunk(s_current_chunk.data());
+		}
 
 		if (SPU2::IsAudioCaptureActive()) [[unlikely]]
 			GSCapture::DeliverAudioPacket(s_current_chunk.data());
+
+		s_output_buffered_ms.store((s_output_stream->GetBufferedFramesRelaxed() * 1000u) / s_output_stream->GetSampleRate(),
+			std::memory_order_relaxed);
+		s_output_target_ms.store(s_output_stream->GetTargetBufferMS(), std::memory_order_relaxed);
+		s_output_underruns.store(s_output_stream->GetUnderrunCount(), std::memory_order_relaxed);
 	}
 }
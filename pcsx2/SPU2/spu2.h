@@ -42,6 +42,18 @@ u32 GetResetVolume();
 /// Pauses/resumes the output stream.
 void SetOutputPaused(bool paused);
 
+/// Returns the amount of audio waiting to be played by the host, in milliseconds.
+u32 GetOutputBufferedMS();
+
+/// Returns the buffer level the output stream is aiming for, in milliseconds.
+u32 GetOutputTargetBufferMS();
+
+/// Returns the number of times the host ran out of audio since the output stream was created.
+u32 GetOutputUnderrunCount();
+
+/// Returns the size of the output stream buffers and the output thread queue, in bytes.
+u64 GetOutputMemoryUsage();
+
 /// Clears output buffers in no-sync mode, prevents long delays after fast forwarding.
 void OnTargetSpeedChanged();
 
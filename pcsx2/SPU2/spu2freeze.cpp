@@ -150,10 +150,13 @@ s32 SPU2Savestate::ThawIt(DataBlock& spud)
 
 		for (int c = 0; c < 2; c++)
 		{
+			ActiveVoices[c] = 0;
 			for (int v = 0; v < 24; v++)
 			{
 				const int cacheIdx = Cores[c].Voices[v].NextA / pcm_WordsPerBlock;
 				Cores[c].Voices[v].SBuffer = pcm_cache_data[cacheIdx].Sampledata;
+				if (Cores[c].Voices[v].ADSR.Phase > V_ADSR::PHASE_STOPPED)
+					ActiveVoices[c] |= (1u << v);
 			}
 		}
 	}
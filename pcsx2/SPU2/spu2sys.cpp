@@ -24,6 +24,7 @@ s16 _spu2mem[0x200000 / sizeof(s16)];
 
 V_CoreDebug DebugCores[2];
 V_Core Cores[2];
+u32 ActiveVoices[2];
 V_SPDIF Spdif;
 
 StereoOut32 DCFilterIn, DCFilterOut;
@@ -37,6 +38,7 @@ static bool has_to_call_irq[2] = { false, false };
 static bool has_to_call_irq_dma[2] = { false, false };
 StereoOut32 (*ReverbUpsample)(V_Core& core);
 s32 (*ReverbDownsample)(V_Core& core, bool right);
+void (*MixVoiceBlock)(V_VoiceMixBlock& block, VoiceMixSet& dest);
 
 
 static bool psxmode = false;
@@ -105,6 +107,7 @@ void V_Core::Init(int index)
 
 	ReverbDownsample = MULTI_ISA_SELECT(ReverbDownsample);
 	ReverbUpsample = MULTI_ISA_SELECT(ReverbUpsample);
+	MixVoiceBlock = MULTI_ISA_SELECT(MixVoiceBlock);
 
 	//memset(this, 0, sizeof(V_Core));
 	// Explicitly initializing variables instead.
@@ -192,6 +195,8 @@ void V_Core::Init(int index)
 		Voices[v].LoopStartA = 0x2800;
 	}
 
+	ActiveVoices[index] = 0;
+
 	DMAICounter = 0;
 	AdmaInProgress = false;
 
@@ -233,6 +238,7 @@ __forceinline static bool StartQueuedVoice(uint coreidx, uint voiceidx)
 	}
 
 	vc.ADSR.Attack();
+	ActiveVoices[coreidx] |= (1u << voiceidx);
 	vc.SCurrent = 28;
 	vc.LoopMode = 0;
 
@@ -254,6 +260,21 @@ __forceinline static bool StartQueuedVoice(uint coreidx, uint voiceidx)
 	return true;
 }
 
+// Mixes up to the given number of ticks back to back. Stops early when the mixer flags an IRQ,
+// since that has to be delivered before the following tick. Only valid while no key ons are queued.
+static __forceinline u32 MixTickRun(u32 ticks)
+{
+	u32 mixed = 0;
+	while (mixed < ticks && !has_to_call_irq[0] && !has_to_call_irq[1])
+	{
+		Cycles++;
+		spu2Mix();
+		mixed++;
+	}
+
+	return mixed;
+}
+
 __forceinline void TimeUpdate(u32 cClocks)
 {
 	u32 dClocks = cClocks - lClocks;
@@ -299,13 +320,27 @@ __forceinline void TimeUpdate(u32 cClocks)
 		Cycles++;
 
 		// Start Queued Voices, they start after 2T (Tested on real HW)
-		for(int c = 0; c < 2; c++)
+		for (int c = 0; c < 2; c++)
+		{
+			if (!Cores[c].KeyOn)
+				continue;
+
 			for (int v = 0; v < 24; v++)
 				if(Cores[c].KeyOn & (1 << v))
 					if(StartQueuedVoice(c, v))
 						Cores[c].KeyOn &= ~(1 << v);
+		}
 
 		spu2Mix();
+
+		// Registers and DMA can't change until we return, so once no key ons are queued the only thing
+		// which needs attention between ticks is an IRQ raised by the mixer. Mix the rest in one run.
+		if (!Cores[0].KeyOn && !Cores[1].KeyOn)
+		{
+			const u32 mixed = MixTickRun(dClocks / TickInterval);
+			dClocks -= mixed * TickInterval;
+			lClocks += mixed * TickInterval;
+		}
 	}
 
 	//Update DMA4 interrupt delay counter
@@ -1301,6 +1336,7 @@ static void RegWrite_Core(u16 value)
 					Cores[1].Voices[v].LoopStartA = 0x6FFFF;
 					Cores[1].Voices[v].Modulated = 0;
 				}
+				ActiveVoices[1] = 0;
 				return;
 			}
 			thiscore.AutoDMACtrl = value;
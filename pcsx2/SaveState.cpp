@@ -40,8 +40,15 @@
 
 #include "fmt/format.h"
 
+#include <atomic>
 #include <csetjmp>
+#include <functional>
+#include <mutex>
 #include <png.h>
+#include <span>
+#include <thread>
+#include <zlib.h>
+#include <zstd.h>
 
 using namespace R5900;
 
@@ -185,6 +192,11 @@ bool SaveStateBase::FreezeInternals(Error* error)
 
 	Freeze(cpuRegs);		// cpu regs + COP0
 	Freeze(psxRegs);		// iop regs
+	if (IsLoading())
+	{
+		eeEventDeadline.Invalidate();
+		iopEventDeadline.Invalidate();
+	}
 	Freeze(fpuRegs);
 	Freeze(tlb);			// tlbs
 	Freeze(cachedTlbs);		// cached tlbs
@@ -313,9 +325,10 @@ void memSavingState::FreezeMem(void* data, int size)
 // --------------------------------------------------------------------------------------
 //  memLoadingState  (implementations)
 // --------------------------------------------------------------------------------------
-memLoadingState::memLoadingState(const VmStateBuffer& load_from)
+memLoadingState::memLoadingState(const VmStateBuffer& load_from, u32 offset)
 	: SaveStateBase(const_cast<VmStateBuffer&>(load_from))
 {
+	m_idx = static_cast<int>(offset);
 }
 
 // Loading of state data from a memory buffer...
@@ -356,28 +369,27 @@ static int SysState_MTGSFreeze(FreezeAction mode, freezeData* fP)
 static constexpr SysState_Component SPU2_{ "SPU2", SPU2freeze };
 static constexpr SysState_Component GS{ "GS", SysState_MTGSFreeze };
 
-static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
+static bool SysState_ComponentFreezeIn(std::span<const u8> data, SysState_Component comp)
 {
-	if (!zf)
+	if (data.empty())
 		return true;
 
 	freezeData fP = { 0, nullptr };
 	if (comp.freeze(FreezeAction::Size, &fP) != 0)
 		fP.size = 0;
 
-	Console.WriteLn("  Loading %s", comp.name);
+	DevCon.WriteLn("  Loading %s", comp.name);
 
-	std::unique_ptr<u8[]> data;
 	if (fP.size > 0)
 	{
-		data = std::make_unique<u8[]>(fP.size);
-		fP.data = data.get();
-
-		if (zip_fread(zf, data.get(), fP.size) != static_cast<zip_int64_t>(fP.size))
+		if (data.size() < static_cast<size_t>(fP.size))
 		{
 			Console.Error(fmt::format("* {}: Failed to decompress save data", comp.name));
 			return false;
 		}
+
+		// freeze functions take a mutable pointer, but only read from it when loading.
+		fP.data = const_cast<u8*>(data.data());
 	}
 
 	if (comp.freeze(FreezeAction::Load, &fP) != 0)
@@ -404,7 +416,7 @@ static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Componen
 	const int size = fP.size;
 	writer.PrepBlock(size);
 
-	Console.WriteLn("  Saving %s", comp.name);
+	DevCon.WriteLn("  Saving %s", comp.name);
 
 	fP.data = writer.GetBlockPtr();
 	if (comp.freeze(FreezeAction::Save, &fP) != 0)
@@ -417,17 +429,8 @@ static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Componen
 	return true;
 }
 
-static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool(*do_state_func)(StateWrapper&))
+static bool SysState_ComponentFreezeInNew(std::span<const u8> data, const char* name, bool(*do_state_func)(StateWrapper&))
 {
-	// TODO: We could decompress on the fly here for a little bit more speed.
-	std::vector<u8> data;
-	if (zf)
-	{
-		std::optional<std::vector<u8>> optdata(ReadBinaryFileInZip(zf));
-		if (optdata.has_value())
-			data = std::move(optdata.value());
-	}
-
 	StateWrapper::ReadOnlyMemoryStream stream(data.empty() ? nullptr : data.data(), data.size());
 	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
 
@@ -436,6 +439,19 @@ static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool
 
 static bool SysState_ComponentFreezeOutNew(SaveStateBase& writer, const char* name, u32 reserve, bool (*do_state_func)(StateWrapper&))
 {
+	// Write straight into the state buffer, and only go through a temporary one if the component outgrew the reservation.
+	writer.PrepBlock(reserve);
+	if (writer.IsOkay())
+	{
+		StateWrapper::MemoryStream direct_stream(writer.GetBlockPtr(), reserve);
+		StateWrapper direct_sw(&direct_stream, StateWrapper::Mode::Write, g_SaveVersion);
+		if (do_state_func(direct_sw) && direct_sw.IsGood())
+		{
+			writer.CommitBlock(static_cast<int>(direct_stream.GetPosition()));
+			return true;
+		}
+	}
+
 	StateWrapper::VectorMemoryStream stream(reserve);
 	StateWrapper sw(&stream, StateWrapper::Mode::Write, g_SaveVersion);
 
@@ -465,11 +481,31 @@ public:
 	virtual ~BaseSavestateEntry() = default;
 
 	virtual const char* GetFilename() const = 0;
-	virtual bool FreezeIn(zip_file_t* zf) const = 0;
+	virtual bool FreezeIn(zip_file_t* zf) const;
+	virtual bool FreezeInFromMemory(std::span<const u8> data) const = 0;
 	virtual bool FreezeOut(SaveStateBase& writer) const = 0;
 	virtual bool IsRequired() const = 0;
+
+	/// Memory which the entry can be decompressed straight into, if it has a fixed size.
+	virtual std::span<u8> GetDirectBuffer() const { return {}; }
 };
 
+bool BaseSavestateEntry::FreezeIn(zip_file_t* zf) const
+{
+	// TODO: We could decompress on the fly here for a little bit more speed.
+	std::vector<u8> data;
+	if (zf)
+	{
+		std::optional<std::vector<u8>> optdata(ReadBinaryFileInZip(zf));
+		if (!optdata.has_value())
+			return false;
+
+		data = std::move(optdata.value());
+	}
+
+	return FreezeInFromMemory(data);
+}
+
 class MemorySavestateEntry : public BaseSavestateEntry
 {
 protected:
@@ -478,8 +514,10 @@ protected:
 
 public:
 	virtual bool FreezeIn(zip_file_t* zf) const;
+	virtual bool FreezeInFromMemory(std::span<const u8> data) const;
 	virtual bool FreezeOut(SaveStateBase& writer) const;
 	virtual bool IsRequired() const { return true; }
+	virtual std::span<u8> GetDirectBuffer() const { return std::span<u8>(GetDataPtr(), GetDataSize()); }
 
 protected:
 	virtual u8* GetDataPtr() const = 0;
@@ -499,6 +537,22 @@ bool MemorySavestateEntry::FreezeIn(zip_file_t* zf) const
 	return true;
 }
 
+bool MemorySavestateEntry::FreezeInFromMemory(std::span<const u8> data) const
+{
+	const u32 expectedSize = GetDataSize();
+	const u32 bytesRead = static_cast<u32>(std::min<size_t>(data.size(), expectedSize));
+	if (bytesRead != expectedSize)
+	{
+		Console.WriteLn(Color_Yellow, " '%s' is incomplete (expected 0x%x bytes, loading only 0x%x bytes)",
+			GetFilename(), expectedSize, bytesRead);
+	}
+
+	if (bytesRead > 0)
+		std::memcpy(GetDataPtr(), data.data(), bytesRead);
+
+	return true;
+}
+
 bool MemorySavestateEntry::FreezeOut(SaveStateBase& writer) const
 {
 	writer.FreezeMem(GetDataPtr(), GetDataSize());
@@ -615,7 +669,7 @@ public:
 	~SavestateEntry_SPU2() override = default;
 
 	const char* GetFilename() const override { return "SPU2.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeIn(zf, SPU2_); }
+	bool FreezeInFromMemory(std::span<const u8> data) const override { return SysState_ComponentFreezeIn(data, SPU2_); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOut(writer, SPU2_); }
 	bool IsRequired() const override { return true; }
 };
@@ -626,7 +680,7 @@ public:
 	~SavestateEntry_USB() override = default;
 
 	const char* GetFilename() const override { return "USB.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "USB", &USB::DoState); }
+	bool FreezeInFromMemory(std::span<const u8> data) const override { return SysState_ComponentFreezeInNew(data, "USB", &USB::DoState); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "USB", 16 * 1024, &USB::DoState); }
 	bool IsRequired() const override { return false; }
 };
@@ -637,7 +691,7 @@ public:
 	~SavestateEntry_PAD() override = default;
 
 	const char* GetFilename() const override { return "PAD.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "PAD", &Pad::Freeze); }
+	bool FreezeInFromMemory(std::span<const u8> data) const override { return SysState_ComponentFreezeInNew(data, "PAD", &Pad::Freeze); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "PAD", 16 * 1024, &Pad::Freeze); }
 	bool IsRequired() const override { return true; }
 };
@@ -648,11 +702,57 @@ public:
 	~SavestateEntry_GS() = default;
 
 	const char* GetFilename() const { return "GS.bin"; }
-	bool FreezeIn(zip_file_t* zf) const { return SysState_ComponentFreezeIn(zf, GS); }
+	bool FreezeInFromMemory(std::span<const u8> data) const { return SysState_ComponentFreezeIn(data, GS); }
 	bool FreezeOut(SaveStateBase& writer) const { return SysState_ComponentFreezeOut(writer, GS); }
 	bool IsRequired() const { return true; }
 };
 
+// Optional, lets the hardware renderer recreate its targets straight after loading rather than
+// rediscovering them draw by draw. Older builds simply ignore the extra file.
+class SavestateEntry_GSTextureCache final : public BaseSavestateEntry
+{
+public:
+	~SavestateEntry_GSTextureCache() override = default;
+
+	const char* GetFilename() const override { return "GSTextureCache.bin"; }
+
+	bool FreezeIn(zip_file_t* zf) const override
+	{
+		if (!zf)
+			return true;
+
+		return BaseSavestateEntry::FreezeIn(zf);
+	}
+
+	bool FreezeInFromMemory(std::span<const u8> data) const override
+	{
+		if (data.empty())
+			return true;
+
+		MTGS::RunOnGSThread([data = std::vector<u8>(data.begin(), data.end())]() {
+			GSRestoreTextureCacheTargets(data);
+		});
+		return true;
+	}
+
+	bool FreezeOut(SaveStateBase& writer) const override
+	{
+		if (!EmuConfig.Savestate.SaveTextureCacheTargets)
+			return true;
+
+		std::vector<u8> data;
+		MTGS::RunOnGSThread([&data]() { GSSaveTextureCacheTargets(&data); });
+		MTGS::WaitGS(false);
+
+		if (!data.empty())
+			writer.FreezeMem(data.data(), static_cast<int>(data.size()));
+
+		return writer.IsOkay();
+	}
+
+	bool IsRequired() const override { return false; }
+};
+
 class SaveStateEntry_Achievements final : public BaseSavestateEntry
 {
 	~SaveStateEntry_Achievements() override = default;
@@ -660,18 +760,19 @@ class SaveStateEntry_Achievements final : public BaseSavestateEntry
 	const char* GetFilename() const override { return "Achievements.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override
 	{
+		// don't bother decompressing the entry if it's not going to be used.
 		if (!Achievements::IsActive())
 			return true;
 
-		std::optional<std::vector<u8>> data;
-		if (zf)
-			data = ReadBinaryFileInZip(zf);
+		return BaseSavestateEntry::FreezeIn(zf);
+	}
 
-		if (data.has_value())
-			Achievements::LoadState(data.value());
-		else
-			Achievements::LoadState(std::span<const u8>());
+	bool FreezeInFromMemory(std::span<const u8> data) const override
+	{
+		if (!Achievements::IsActive())
+			return true;
 
+		Achievements::LoadState(data);
 		return true;
 	}
 
@@ -706,13 +807,60 @@ static const std::unique_ptr<BaseSavestateEntry> SavestateEntries[] = {
 	std::unique_ptr<BaseSavestateEntry>(new SavestateEntry_USB),
 	std::unique_ptr<BaseSavestateEntry>(new SavestateEntry_PAD),
 	std::unique_ptr<BaseSavestateEntry>(new SavestateEntry_GS),
+	std::unique_ptr<BaseSavestateEntry>(new SavestateEntry_GSTextureCache),
 	std::unique_ptr<BaseSavestateEntry>(new SaveStateEntry_Achievements),
 };
 
+// Freezing into a freshly allocated 64MB buffer means zero-filling and faulting in every page on the
+// CPU thread, which is most of the stall when saving. Keep the buffers from previous saves around
+// instead, one for the state being captured and one for a state still being compressed.
+static constexpr size_t SAVE_STATE_BUFFER_SIZE = 64 * _1mb;
+static constexpr size_t MAX_POOLED_SAVE_STATE_BUFFERS = 2;
+static std::mutex s_state_buffer_mutex;
+static std::vector<std::unique_ptr<ArchiveEntryList>> s_state_buffers;
+
+static std::unique_ptr<ArchiveEntryList> SaveState_AllocateBuffer()
+{
+	{
+		std::unique_lock lock(s_state_buffer_mutex);
+		if (!s_state_buffers.empty())
+		{
+			std::unique_ptr<ArchiveEntryList> list = std::move(s_state_buffers.back());
+			s_state_buffers.pop_back();
+			return list;
+		}
+	}
+
+	std::unique_ptr<ArchiveEntryList> list = std::make_unique<ArchiveEntryList>();
+	list->GetBuffer().resize(SAVE_STATE_BUFFER_SIZE);
+	return list;
+}
+
+void SaveState_ReleaseBuffer(std::unique_ptr<ArchiveEntryList> list)
+{
+	// Compression can finish after the VM has shut down, don't hang on to the memory then.
+	if (!VMManager::HasValidVM())
+		return;
+
+	list->Clear();
+
+	std::unique_lock lock(s_state_buffer_mutex);
+	if (s_state_buffers.size() < MAX_POOLED_SAVE_STATE_BUFFERS)
+		s_state_buffers.push_back(std::move(list));
+}
+
+void SaveState_FreeBuffers()
+{
+	std::vector<std::unique_ptr<ArchiveEntryList>> buffers;
+	{
+		std::unique_lock lock(s_state_buffer_mutex);
+		buffers.swap(s_state_buffers);
+	}
+}
+
 std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 {
-	std::unique_ptr<ArchiveEntryList> destlist = std::make_unique<ArchiveEntryList>();
-	destlist->GetBuffer().resize(1024 * 1024 * 64);
+	std::unique_ptr<ArchiveEntryList> destlist = SaveState_AllocateBuffer();
 
 	memSavingState saveme(destlist->GetBuffer());
 	ArchiveEntry internals(EntryFilename_InternalStructures);
@@ -920,6 +1068,297 @@ static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height,
 	return true;
 }
 
+// --------------------------------------------------------------------------------------
+//  Parallel zstd entries
+// --------------------------------------------------------------------------------------
+// Zstandard entries are split into chunks which are compressed as independent frames on all cores.
+// Concatenated frames are still a single valid zstd stream, so libzip (and older builds) read them
+// as before, but when loading the frames can be decompressed in parallel as well.
+static constexpr size_t PARALLEL_CHUNK_SIZE = 2 * _1mb;
+
+static void SaveState_RunParallel(size_t count, const std::function<void(size_t)>& func)
+{
+	const size_t num_threads = std::min<size_t>(count, std::max(std::thread::hardware_concurrency(), 1u));
+	std::atomic<size_t> next_index{0};
+	const auto worker = [&next_index, count, &func]() {
+		for (size_t i = next_index.fetch_add(1, std::memory_order_relaxed); i < count;
+			 i = next_index.fetch_add(1, std::memory_order_relaxed))
+		{
+			func(i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(num_threads);
+	for (size_t i = 1; i < num_threads; i++)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+namespace
+{
+	struct PrecompressedEntry
+	{
+		std::vector<u8> data;
+		u64 uncompressed_size = 0;
+		u32 crc = 0;
+		size_t position = 0;
+		zip_error_t error;
+	};
+} // namespace
+
+// Source for data which is already zstd compressed. Since the stat reports the compression method and
+// CRC, libzip copies it into the archive as-is instead of compressing it again.
+static zip_int64_t SaveState_PrecompressedSourceCallback(void* userdata, void* data, zip_uint64_t len, zip_source_cmd_t cmd)
+{
+	PrecompressedEntry* entry = static_cast<PrecompressedEntry*>(userdata);
+	switch (cmd)
+	{
+		case ZIP_SOURCE_OPEN:
+			entry->position = 0;
+			return 0;
+
+		case ZIP_SOURCE_READ:
+		{
+			const size_t count = std::min<size_t>(len, entry->data.size() - entry->position);
+			std::memcpy(data, entry->data.data() + entry->position, count);
+			entry->position += count;
+			return static_cast<zip_int64_t>(count);
+		}
+
+		case ZIP_SOURCE_CLOSE:
+			return 0;
+
+		case ZIP_SOURCE_STAT:
+		{
+			if (len < sizeof(zip_stat_t))
+			{
+				zip_error_set(&entry->error, ZIP_ER_INVAL, 0);
+				return -1;
+			}
+
+			zip_stat_t* st = static_cast<zip_stat_t*>(data);
+			zip_stat_init(st);
+			st->valid = ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_COMP_METHOD | ZIP_STAT_CRC | ZIP_STAT_ENCRYPTION_METHOD;
+			st->size = entry->uncompressed_size;
+			st->comp_size = entry->data.size();
+			st->comp_method = ZIP_CM_ZSTD;
+			st->crc = entry->crc;
+			st->encryption_method = ZIP_EM_NONE;
+			return sizeof(zip_stat_t);
+		}
+
+		case ZIP_SOURCE_GET_FILE_ATTRIBUTES:
+		{
+			if (len < sizeof(zip_file_attributes_t))
+			{
+				zip_error_set(&entry->error, ZIP_ER_INVAL, 0);
+				return -1;
+			}
+
+			// same version libzip's own zstd compression reports, it sets no general purpose flags.
+			zip_file_attributes_t* attributes = static_cast<zip_file_attributes_t*>(data);
+			attributes->valid |= ZIP_FILE_ATTRIBUTES_VERSION_NEEDED;
+			attributes->version_needed = 63;
+			return 0;
+		}
+
+		case ZIP_SOURCE_ERROR:
+			return zip_error_to_data(&entry->error, data, len);
+
+		case ZIP_SOURCE_FREE:
+			zip_error_fini(&entry->error);
+			delete entry;
+			return 0;
+
+		case ZIP_SOURCE_SUPPORTS:
+			return zip_source_make_command_bitmap(ZIP_SOURCE_OPEN, ZIP_SOURCE_READ, ZIP_SOURCE_CLOSE, ZIP_SOURCE_STAT,
+				ZIP_SOURCE_GET_FILE_ATTRIBUTES, ZIP_SOURCE_ERROR, ZIP_SOURCE_FREE, ZIP_SOURCE_SUPPORTS, -1);
+
+		default:
+			zip_error_set(&entry->error, ZIP_ER_OPNOTSUPP, 0);
+			return -1;
+	}
+}
+
+static bool SaveState_AddEntriesParallel(zip_t* zf, ArchiveEntryList* srclist, u32 compression_level)
+{
+	struct Chunk
+	{
+		uint entry;
+		size_t offset;
+		size_t size;
+		std::vector<u8> data;
+		u32 crc;
+	};
+
+	std::vector<Chunk> chunks;
+	const uint listlen = srclist->GetLength();
+	for (uint i = 0; i < listlen; ++i)
+	{
+		const size_t size = (*srclist)[i].GetDataSize();
+		for (size_t offset = 0; offset < size; offset += PARALLEL_CHUNK_SIZE)
+			chunks.push_back(Chunk{i, offset, std::min(PARALLEL_CHUNK_SIZE, size - offset), {}, 0});
+	}
+
+	std::atomic_bool failed{false};
+	SaveState_RunParallel(chunks.size(), [srclist, compression_level, &chunks, &failed](size_t index) {
+		Chunk& chunk = chunks[index];
+		const u8* src = srclist->GetPtr((*srclist)[chunk.entry].GetDataIndex()) + chunk.offset;
+
+		chunk.data.resize(ZSTD_compressBound(chunk.size));
+		const size_t compressed_size =
+			ZSTD_compress(chunk.data.data(), chunk.data.size(), src, chunk.size, static_cast<int>(compression_level));
+		if (ZSTD_isError(compressed_size))
+		{
+			Console.Error("Failed to compress save state chunk: %s", ZSTD_getErrorName(compressed_size));
+			failed.store(true, std::memory_order_relaxed);
+			return;
+		}
+
+		chunk.data.resize(compressed_size);
+		chunk.crc = static_cast<u32>(crc32(0, src, static_cast<uInt>(chunk.size)));
+	});
+	if (failed.load(std::memory_order_relaxed))
+		return false;
+
+	for (size_t first = 0; first < chunks.size();)
+	{
+		const uint entry_index = chunks[first].entry;
+		size_t last = first;
+		size_t compressed_size = 0;
+		for (; last < chunks.size() && chunks[last].entry == entry_index; last++)
+			compressed_size += chunks[last].data.size();
+
+		PrecompressedEntry* pe = new PrecompressedEntry();
+		zip_error_init(&pe->error);
+		pe->data.reserve(compressed_size);
+		for (size_t i = first; i < last; i++)
+		{
+			const Chunk& chunk = chunks[i];
+			pe->data.insert(pe->data.end(), chunk.data.begin(), chunk.data.end());
+			pe->crc = (i == first) ? chunk.crc : static_cast<u32>(crc32_combine(pe->crc, chunk.crc, static_cast<z_off_t>(chunk.size)));
+			pe->uncompressed_size += chunk.size;
+		}
+		first = last;
+
+		zip_error_t ze = {};
+		zip_source_t* const zs = zip_source_function_create(&SaveState_PrecompressedSourceCallback, pe, &ze);
+		if (!zs)
+		{
+			zip_error_fini(&pe->error);
+			delete pe;
+			return false;
+		}
+
+		// NOTE: Source should not be freed if successful. The compression method is picked up from the source.
+		const s64 fi = zip_file_add(zf, (*srclist)[entry_index].GetFilename().c_str(), zs, ZIP_FL_ENC_UTF_8);
+		if (fi < 0)
+		{
+			zip_source_free(zs);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Decompresses an entry written by SaveState_AddEntriesParallel() on all cores. Returns false if the entry
+// isn't made up of several zstd frames with known sizes, in which case it should be read through libzip.
+// If direct is the same size as the entry, it's decompressed there instead of into data, which is left empty.
+// direct may have been partially overwritten on failure.
+static bool SaveState_ReadEntryParallel(zip_t* zf, s64 index, std::vector<u8>* data, std::span<u8> direct)
+{
+	static constexpr zip_uint64_t required = ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_COMP_METHOD | ZIP_STAT_CRC;
+
+	zip_stat_t zst;
+	if (zip_stat_index(zf, index, 0, &zst) != 0 || (zst.valid & required) != required ||
+		zst.comp_method != ZIP_CM_ZSTD || zst.size <= PARALLEL_CHUNK_SIZE)
+	{
+		return false;
+	}
+
+	auto zff = zip_fopen_index_managed(zf, index, ZIP_FL_COMPRESSED);
+	if (!zff)
+		return false;
+
+	std::vector<u8> compressed(zst.comp_size);
+	if (zip_fread(zff.get(), compressed.data(), compressed.size()) != static_cast<zip_int64_t>(compressed.size()))
+		return false;
+
+	struct Frame
+	{
+		size_t src_offset;
+		size_t src_size;
+		size_t dst_offset;
+		size_t dst_size;
+		u32 crc;
+	};
+
+	std::vector<Frame> frames;
+	size_t src_offset = 0;
+	size_t dst_offset = 0;
+	while (src_offset < compressed.size())
+	{
+		const u8* src = compressed.data() + src_offset;
+		const size_t src_size = ZSTD_findFrameCompressedSize(src, compressed.size() - src_offset);
+		if (ZSTD_isError(src_size))
+			return false;
+
+		const unsigned long long dst_size = ZSTD_getFrameContentSize(src, src_size);
+		if (dst_size == ZSTD_CONTENTSIZE_UNKNOWN || dst_size == ZSTD_CONTENTSIZE_ERROR ||
+			dst_size > (zst.size - dst_offset))
+		{
+			return false;
+		}
+
+		frames.push_back(Frame{src_offset, src_size, dst_offset, static_cast<size_t>(dst_size), 0});
+		src_offset += src_size;
+		dst_offset += static_cast<size_t>(dst_size);
+	}
+
+	if (frames.size() < 2 || dst_offset != zst.size)
+		return false;
+
+	// Skips an allocation and copy of the whole entry, eeMem is 32MB.
+	u8* dst_base;
+	if (direct.size() == zst.size)
+	{
+		dst_base = direct.data();
+	}
+	else
+	{
+		data->resize(zst.size);
+		dst_base = data->data();
+	}
+
+	std::atomic_bool failed{false};
+	SaveState_RunParallel(frames.size(), [&compressed, &frames, &failed, dst_base](size_t i) {
+		Frame& frame = frames[i];
+		u8* dst = dst_base + frame.dst_offset;
+		const size_t size = ZSTD_decompress(dst, frame.dst_size, compressed.data() + frame.src_offset, frame.src_size);
+		if (ZSTD_isError(size) || size != frame.dst_size)
+		{
+			failed.store(true, std::memory_order_relaxed);
+			return;
+		}
+
+		frame.crc = static_cast<u32>(crc32(0, dst, static_cast<uInt>(frame.dst_size)));
+	});
+	if (failed.load(std::memory_order_relaxed))
+		return false;
+
+	u32 crc = frames[0].crc;
+	for (size_t i = 1; i < frames.size(); i++)
+		crc = static_cast<u32>(crc32_combine(crc, frames[i].crc, static_cast<z_off_t>(frames[i].dst_size)));
+
+	return (crc == zst.crc);
+}
+
 // --------------------------------------------------------------------------------------
 //  CompressThread_VmState
 // --------------------------------------------------------------------------------------
@@ -1008,25 +1447,33 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 		zip_set_file_compression(zf, fi, compression, compression_level);
 	}
 
-	const uint listlen = srclist->GetLength();
-	for (uint i = 0; i < listlen; ++i)
+	if (compression == ZIP_CM_ZSTD)
 	{
-		const ArchiveEntry& entry = (*srclist)[i];
-		if (!entry.GetDataSize())
-			continue;
-
-		zip_source_t* const zs = zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
-		if (!zs)
+		if (!SaveState_AddEntriesParallel(zf, srclist, compression_level))
 			return false;
-
-		const s64 fi = zip_file_add(zf, entry.GetFilename().c_str(), zs, ZIP_FL_ENC_UTF_8);
-		if (fi < 0)
+	}
+	else
+	{
+		const uint listlen = srclist->GetLength();
+		for (uint i = 0; i < listlen; ++i)
 		{
-			zip_source_free(zs);
-			return false;
-		}
+			const ArchiveEntry& entry = (*srclist)[i];
+			if (!entry.GetDataSize())
+				continue;
 
-		zip_set_file_compression(zf, fi, compression, compression_level);
+			zip_source_t* const zs = zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
+			if (!zs)
+				return false;
+
+			const s64 fi = zip_file_add(zf, entry.GetFilename().c_str(), zs, ZIP_FL_ENC_UTF_8);
+			if (fi < 0)
+			{
+				zip_source_free(zs);
+				return false;
+			}
+
+			zip_set_file_compression(zf, fi, compression, compression_level);
+		}
 	}
 
 	if (screenshot)
@@ -1062,6 +1509,7 @@ bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_
 
 	// force the zip to close, this is the expensive part with libzip.
 	zip_close(zf);
+	SaveState_ReleaseBuffer(std::move(srclist));
 	return true;
 }
 
@@ -1134,6 +1582,18 @@ static zip_int64_t CheckFileExistsInState(zip_t* zf, const char* name, bool requ
 	return index;
 }
 
+static bool LoadInternalStructuresState(const std::vector<u8>& buffer, u32 offset, Error* error)
+{
+	memLoadingState state(buffer, offset);
+	if (!state.FreezeBios())
+		return false;
+	
+	if (!state.FreezeInternals(error))
+		return false;
+
+	return true;
+}
+
 static bool LoadInternalStructuresState(zip_t* zf, s64 index, Error* error)
 {
 	zip_stat_t zst;
@@ -1149,14 +1609,7 @@ static bool LoadInternalStructuresState(zip_t* zf, s64 index, Error* error)
 	if (zip_fread(zff.get(), buffer.data(), buffer.size()) != static_cast<zip_int64_t>(buffer.size()))
 		return false;
 
-	memLoadingState state(buffer);
-	if (!state.FreezeBios())
-		return false;
-	
-	if (!state.FreezeInternals(error))
-		return false;
-
-	return true;
+	return LoadInternalStructuresState(buffer, 0, error);
 }
 
 bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
@@ -1219,6 +1672,23 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 			continue;
 		}
 
+		std::vector<u8> data;
+		if (SaveState_ReadEntryParallel(zf.get(), entryIndices[i], &data, SavestateEntries[i]->GetDirectBuffer()))
+		{
+			// Already decompressed in place.
+			if (data.empty())
+				continue;
+
+			if (!SavestateEntries[i]->FreezeInFromMemory(data))
+			{
+				Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
+				VMManager::Reset();
+				return false;
+			}
+
+			continue;
+		}
+
 		auto zff = zip_fopen_index_managed(zf.get(), entryIndices[i], 0);
 		if (!zff || !SavestateEntries[i]->FreezeIn(zff.get()))
 		{
@@ -1231,3 +1701,68 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 	PostLoadPrep();
 	return true;
 }
+
+static const ArchiveEntry* FindEntryInList(const ArchiveEntryList& list, const char* name)
+{
+	for (size_t i = 0; i < list.GetLength(); i++)
+	{
+		if (list[static_cast<uint>(i)].GetFilename() == name)
+			return &list[static_cast<uint>(i)];
+	}
+
+	return nullptr;
+}
+
+static std::span<const u8> GetEntryDataInList(const ArchiveEntryList& list, const ArchiveEntry& entry)
+{
+	if (entry.GetDataSize() == 0 || (entry.GetDataIndex() + entry.GetDataSize()) > list.GetBuffer().size())
+		return {};
+
+	return std::span<const u8>(list.GetBuffer().data() + entry.GetDataIndex(), entry.GetDataSize());
+}
+
+bool SaveState_LoadFromMemory(const ArchiveEntryList& list, Error* error)
+{
+	const ArchiveEntry* internals = FindEntryInList(list, EntryFilename_InternalStructures);
+	const ArchiveEntry* entries[std::size(SavestateEntries)];
+
+	bool allPresent = (internals != nullptr);
+	for (u32 i = 0; i < std::size(SavestateEntries) && allPresent; i++)
+	{
+		entries[i] = FindEntryInList(list, SavestateEntries[i]->GetFilename());
+		if (!entries[i] && SavestateEntries[i]->IsRequired())
+			allPresent = false;
+	}
+	if (!allPresent)
+	{
+		Error::SetString(error, "Some required components were not found or are incomplete.");
+		return false;
+	}
+
+	PreLoadPrep();
+
+	// Read the internals in place, in-memory states are loaded often enough (rewind) for the copy to show up.
+	if (internals->GetDataIndex() + internals->GetDataSize() > list.GetBuffer().size() ||
+		!LoadInternalStructuresState(list.GetBuffer(), static_cast<u32>(internals->GetDataIndex()), error))
+	{
+		if (!error->IsValid())
+			Error::SetString(error, "Save state corruption in internal structures.");
+
+		VMManager::Reset();
+		return false;
+	}
+
+	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+	{
+		const std::span<const u8> data = entries[i] ? GetEntryDataInList(list, *entries[i]) : std::span<const u8>();
+		if (!SavestateEntries[i]->FreezeInFromMemory(data))
+		{
+			Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
+			VMManager::Reset();
+			return false;
+		}
+	}
+
+	PostLoadPrep();
+	return true;
+}
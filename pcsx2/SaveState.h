@@ -56,6 +56,13 @@ extern std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot();
 extern bool SaveState_ZipToDisk(std::unique_ptr<ArchiveEntryList> srclist, std::unique_ptr<SaveStateScreenshotData> screenshot, const char* filename);
 extern bool SaveState_ReadScreenshot(const std::string& filename, u32* out_width, u32* out_height, std::vector<u32>* out_pixels);
 extern bool SaveState_UnzipFromDisk(const std::string& filename, Error* error);
+extern bool SaveState_LoadFromMemory(const ArchiveEntryList& list, Error* error);
+
+// Returns a state buffer from SaveState_DownloadState() for reuse by later saves.
+extern void SaveState_ReleaseBuffer(std::unique_ptr<ArchiveEntryList> list);
+
+// Releases the buffers kept around from previous saves.
+extern void SaveState_FreeBuffers();
 
 // --------------------------------------------------------------------------------------
 //  SaveStateBase class
@@ -306,6 +313,11 @@ public:
 		return &m_data[idx];
 	}
 
+	void Clear()
+	{
+		m_list.clear();
+	}
+
 	ArchiveEntryList& Add(const ArchiveEntry& src)
 	{
 		m_list.push_back(src);
@@ -347,7 +359,7 @@ public:
 class memLoadingState final : public SaveStateBase
 {
 public:
-	memLoadingState(const VmStateBuffer& load_from);
+	memLoadingState(const VmStateBuffer& load_from, u32 offset = 0);
 	~memLoadingState() override = default;
 
 	void FreezeMem(void* data, int size) override;
@@ -0,0 +1,294 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Counters.h"
+#include "GS/GS.h"
+#include "MTGS.h"
+#include "Memory.h"
+#include "SharedSnapshot.h"
+
+#include "common/BitUtils.h"
+#include "common/Console.h"
+#include "common/StringUtil.h"
+
+#include "fmt/format.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace SharedSnapshot
+{
+	static bool ParseRanges(std::string_view ranges, std::vector<Range>* out);
+	static bool CreateMapping(size_t size);
+	static void DestroyMapping();
+
+	static void BeginWrite(u32& sequence);
+	static void EndWrite(u32& sequence);
+
+	static void CaptureFrame(u64 frame_number);
+
+	static Header* s_header = nullptr;
+	static size_t s_size = 0;
+	static int s_slot = 0;
+	static std::string s_ranges_string;
+
+	// Private copies, other processes can write to the header.
+	static std::vector<Range> s_ranges;
+	static u32 s_frame_width = 0;
+	static u32 s_frame_height = 0;
+	static u32 s_frame_offset = 0;
+	static u32 s_frame_capacity = 0;
+
+#ifdef _WIN32
+	static HANDLE s_mapping = nullptr;
+#else
+	static std::string s_shm_name;
+#endif
+
+	// Only touched on the GS thread.
+	static std::vector<u32> s_frame_pixels;
+} // namespace SharedSnapshot
+
+bool SharedSnapshot::IsInitialized()
+{
+	return (s_header != nullptr);
+}
+
+int SharedSnapshot::GetSlot()
+{
+	return s_slot;
+}
+
+bool SharedSnapshot::NeedsReinitialize(int slot, u32 frame_width, u32 frame_height, std::string_view ranges)
+{
+	return (!s_header || s_slot != slot || s_frame_width != frame_width || s_frame_height != frame_height ||
+			s_ranges_string != ranges);
+}
+
+bool SharedSnapshot::ParseRanges(std::string_view ranges, std::vector<Range>* out)
+{
+	for (const std::string_view token : StringUtil::SplitString(ranges, ','))
+	{
+		const std::string_view::size_type sep = token.find(':');
+		if (sep == std::string_view::npos)
+			return false;
+
+		const std::optional<u32> address = StringUtil::FromChars<u32>(StringUtil::StripWhitespace(token.substr(0, sep)), 16);
+		const std::optional<u32> size = StringUtil::FromChars<u32>(StringUtil::StripWhitespace(token.substr(sep + 1)), 16);
+		if (!address.has_value() || !size.has_value() || size.value() == 0 ||
+			address.value() >= Ps2MemSize::MainRam || size.value() > (Ps2MemSize::MainRam - address.value()))
+		{
+			return false;
+		}
+
+		if (out->size() == MAX_RANGES)
+			return false;
+
+		out->push_back({address.value(), size.value(), 0, 0});
+	}
+
+	return true;
+}
+
+bool SharedSnapshot::Initialize(int slot, u32 frame_width, u32 frame_height, std::string_view ranges)
+{
+	Deinitialize();
+
+	std::vector<Range> parsed_ranges;
+	if (!ParseRanges(ranges, &parsed_ranges))
+	{
+		Console.ErrorFmt("(SharedSnapshot) Invalid memory ranges '{}', expected a list of hex address:size pairs.", ranges);
+		return false;
+	}
+
+	// Keep every section 64 byte aligned, so readers can copy them with wide loads.
+	size_t size = Common::AlignUpPow2(sizeof(Header), 64);
+	const size_t frame_offset = size;
+	const size_t frame_capacity = static_cast<size_t>(frame_width) * frame_height * sizeof(u32);
+	size += Common::AlignUpPow2(frame_capacity, 64);
+	for (Range& range : parsed_ranges)
+	{
+		range.offset = static_cast<u32>(size);
+		size += Common::AlignUpPow2(static_cast<size_t>(range.size), 64);
+	}
+
+	s_slot = slot;
+	if (!CreateMapping(size))
+		return false;
+
+	std::memset(s_header, 0, sizeof(Header));
+	s_header->magic = MAGIC;
+	s_header->version = VERSION;
+	s_header->size = static_cast<u32>(size);
+	s_header->frame_width = frame_width;
+	s_header->frame_height = frame_height;
+	s_header->frame_offset = static_cast<u32>(frame_offset);
+	s_header->frame_capacity = static_cast<u32>(frame_capacity);
+	s_header->num_ranges = static_cast<u32>(parsed_ranges.size());
+	std::copy(parsed_ranges.begin(), parsed_ranges.end(), s_header->ranges);
+
+	s_ranges_string = ranges;
+	s_ranges = std::move(parsed_ranges);
+	s_frame_width = frame_width;
+	s_frame_height = frame_height;
+	s_frame_offset = static_cast<u32>(frame_offset);
+	s_frame_capacity = static_cast<u32>(frame_capacity);
+	Console.WriteLnFmt("(SharedSnapshot) Publishing {}x{} frames and {} memory ranges in slot {} ({} bytes).",
+		frame_width, frame_height, s_ranges.size(), slot, size);
+	return true;
+}
+
+void SharedSnapshot::Deinitialize()
+{
+	if (!s_header)
+		return;
+
+	// A frame capture may still be queued, it writes through the mapping.
+	if (MTGS::IsOpen())
+		MTGS::WaitGS(false, false, false);
+
+	DestroyMapping();
+	s_ranges_string.clear();
+	s_ranges.clear();
+	s_frame_capacity = 0;
+}
+
+#ifdef _WIN32
+
+bool SharedSnapshot::CreateMapping(size_t size)
+{
+	const std::wstring name = StringUtil::UTF8StringToWideString(fmt::format("pcsx2_snapshot_{}", s_slot));
+	s_mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<u64>(size) >> 32),
+		static_cast<DWORD>(size), name.c_str());
+	if (!s_mapping)
+	{
+		Console.ErrorFmt("(SharedSnapshot) CreateFileMappingW() failed: {}", GetLastError());
+		return false;
+	}
+
+	s_header = static_cast<Header*>(MapViewOfFile(s_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+	if (!s_header)
+	{
+		Console.ErrorFmt("(SharedSnapshot) MapViewOfFile() failed: {}", GetLastError());
+		CloseHandle(s_mapping);
+		s_mapping = nullptr;
+		return false;
+	}
+
+	s_size = size;
+	return true;
+}
+
+void SharedSnapshot::DestroyMapping()
+{
+	UnmapViewOfFile(s_header);
+	CloseHandle(s_mapping);
+	s_header = nullptr;
+	s_mapping = nullptr;
+	s_size = 0;
+}
+
+#else
+
+bool SharedSnapshot::CreateMapping(size_t size)
+{
+	s_shm_name = fmt::format("/pcsx2_snapshot_{}", s_slot);
+
+	// Unlike HostSys::CreateSharedMemory(), the name has to stay around for other processes to open it.
+	const int fd = shm_open(s_shm_name.c_str(), O_CREAT | O_RDWR, 0600);
+	if (fd < 0)
+	{
+		Console.ErrorFmt("(SharedSnapshot) shm_open({}) failed: {}", s_shm_name, errno);
+		return false;
+	}
+
+	void* ptr = MAP_FAILED;
+	if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+		ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	else
+		Console.ErrorFmt("(SharedSnapshot) ftruncate({}) failed: {}", size, errno);
+
+	close(fd);
+	if (ptr == MAP_FAILED)
+	{
+		shm_unlink(s_shm_name.c_str());
+		return false;
+	}
+
+	s_header = static_cast<Header*>(ptr);
+	s_size = size;
+	return true;
+}
+
+void SharedSnapshot::DestroyMapping()
+{
+	munmap(s_header, s_size);
+	shm_unlink(s_shm_name.c_str());
+	s_header = nullptr;
+	s_size = 0;
+}
+
+#endif
+
+void SharedSnapshot::BeginWrite(u32& sequence)
+{
+	std::atomic_ref<u32> ref(sequence);
+	ref.store(ref.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SharedSnapshot::EndWrite(u32& sequence)
+{
+	std::atomic_ref<u32> ref(sequence);
+	ref.store(ref.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void SharedSnapshot::VSync()
+{
+	if (!s_header)
+		return;
+
+	u8* const base = reinterpret_cast<u8*>(s_header);
+	if (!s_ranges.empty())
+	{
+		BeginWrite(s_header->memory_sequence);
+		for (const Range& range : s_ranges)
+			std::memcpy(base + range.offset, eeMem->Main + range.address, range.size);
+		s_header->memory_frame_number = g_FrameCount;
+		EndWrite(s_header->memory_sequence);
+	}
+
+	if (s_frame_capacity > 0 && MTGS::IsOpen())
+		MTGS::RunOnGSThread([frame_number = static_cast<u64>(g_FrameCount)]() { CaptureFrame(frame_number); });
+}
+
+void SharedSnapshot::CaptureFrame(u64 frame_number)
+{
+	if (!s_header)
+		return;
+
+	// The GPU scales it down for us, we only have to read back the small copy.
+	u32 width, height;
+	if (!GSSaveSnapshotToMemory(s_frame_width, s_frame_height, true, false, &width, &height, &s_frame_pixels))
+		return;
+
+	const size_t size = static_cast<size_t>(width) * height * sizeof(u32);
+	if (size > s_frame_capacity)
+		return;
+
+	BeginWrite(s_header->frame_sequence);
+	std::memcpy(reinterpret_cast<u8*>(s_header) + s_frame_offset, s_frame_pixels.data(), size);
+	s_header->frame_number = frame_number;
+	EndWrite(s_header->frame_sequence);
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Types.h"
+
+#include <string_view>
+
+/// Publishes a downscaled copy of the current frame and a set of EE memory ranges through a named
+/// shared memory region, so external tools can read them without going through PINE.
+///
+/// The region is named "pcsx2_snapshot_<PINE slot>" ("/pcsx2_snapshot_<slot>" for shm_open()), and
+/// starts with a Header. The frame and memory sections each have their own sequence counter, which
+/// is odd while the section is being written. Readers should load the counter, copy the section,
+/// and retry if the counter changed or was odd.
+namespace SharedSnapshot
+{
+	static constexpr u32 MAGIC = 0x53325350; // 'PS2S'
+	static constexpr u32 VERSION = 1;
+	static constexpr u32 MAX_RANGES = 16;
+
+	struct Range
+	{
+		u32 address; ///< Physical EE address.
+		u32 size; ///< Size in bytes.
+		u32 offset; ///< Offset of the copy from the start of the region.
+		u32 reserved;
+	};
+
+	struct Header
+	{
+		u32 magic;
+		u32 version;
+		u32 size; ///< Size of the whole region in bytes.
+		u32 reserved;
+
+		// Updated on the GS thread after each vsync.
+		u32 frame_sequence;
+		u32 frame_width;
+		u32 frame_height;
+		u32 frame_offset; ///< RGBA8 pixels, width * 4 bytes per row.
+		u32 frame_capacity;
+		u32 frame_reserved;
+		u64 frame_number;
+
+		// Updated on the CPU thread at each vsync.
+		u32 memory_sequence;
+		u32 num_ranges;
+		u64 memory_frame_number;
+		Range ranges[MAX_RANGES];
+	};
+
+	bool IsInitialized();
+	int GetSlot();
+
+	/// Creates the region. ranges is a comma separated list of "address:size" pairs, in hex.
+	bool Initialize(int slot, u32 frame_width, u32 frame_height, std::string_view ranges);
+	void Deinitialize();
+
+	/// Returns true if the region was created with different settings.
+	bool NeedsReinitialize(int slot, u32 frame_width, u32 frame_height, std::string_view ranges);
+
+	/// Copies the memory ranges and queues a frame capture. Called by the CPU thread on every vsync.
+	void VSync();
+} // namespace SharedSnapshot
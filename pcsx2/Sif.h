@@ -127,6 +127,22 @@ struct sifFifo
 		}
 		SIF_LOG("  SIF - %d = %d (pos=%d)", words, size, readPos);
 	}
+	// Accounts for data which was copied directly between EE and IOP memory while the FIFO
+	// was empty. Only the last QW is kept, since that's what the junk data is made up of.
+	void bypass(const u32 *lastQW, int words)
+	{
+		writePos = (writePos + words) & (FIFO_SIF_W - 1);
+		readPos = writePos;
+		std::memcpy(&data[(writePos - 4) & (FIFO_SIF_W - 1)], lastQW, 16);
+		SIF_LOG("  SIF bypass %d (pos=%d)", words, writePos);
+	}
+
+	// Returns true if the FIFO is empty and QW aligned, so it can be bypassed.
+	bool can_bypass() const
+	{
+		return (size == 0 && readPos == writePos && (writePos & 3) == 0);
+	}
+
 	void clear()
 	{
 		std::memset(data, 0, sizeof(data));
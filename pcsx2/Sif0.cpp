@@ -75,6 +75,50 @@ static __fi bool WriteIOPtoFifo()
 	return true;
 }
 
+// Copy large packets straight from IOP to EE memory when the FIFO is empty, instead of
+// cycling them through the FIFO a few words at a time. The cycle counts end up the same.
+static __fi bool BulkIOPtoEE()
+{
+	if (!sif0.iop.busy || !sif0.ee.busy || !sif0ch.chcr.STR || !sif0.fifo.can_bypass())
+		return false;
+
+	const u32 ee_addr = sif0ch.madr & 0x1ffffff0;
+	const u32 iop_addr = hw_dma9.madr & 0x1fffff;
+	if (DMA_TAG(sif0ch.madr).SPR || ee_addr >= Ps2MemSize::ExposedRam)
+		return false;
+
+	s32 qwc = std::min<s32>(sif0ch.qwc, sif0.iop.counter >> 2);
+	qwc = std::min<s32>(qwc, (Ps2MemSize::ExposedRam - ee_addr) >> 4);
+	qwc = std::min<s32>(qwc, (0x200000 - iop_addr) >> 4);
+
+	// Small packets go through the FIFO, they make up most of the SIF command traffic.
+	if (qwc < (FIFO_SIF_W >> 2))
+		return false;
+
+	SIF_LOG("SIF0 bulk transfer: %lX qw from IOP %08X to EE %08X", qwc, hw_dma9.madr, sif0ch.madr);
+
+	const u32 words = qwc << 2;
+	const u8* src = iopPhysMem(hw_dma9.madr);
+	std::memcpy(&eeMem->Main[ee_addr], src, qwc << 4);
+	sif0.fifo.bypass(reinterpret_cast<const u32*>(src + ((qwc - 1) << 4)), words);
+
+	hw_dma9.madr += words << 2;
+	sif0.iop.cycles += words;
+	sif0.iop.counter -= words;
+
+	sif0ch.madr += qwc << 4;
+	sif0.ee.cycles += qwc;
+	sif0ch.qwc -= qwc;
+
+	if (sif0ch.qwc == 0 && dmacRegs.ctrl.STS == STS_SIF0)
+	{
+		if ((sif0ch.chcr.MOD == NORMAL_MODE) || ((sif0ch.chcr.TAG >> 28) & 0x7) == TAG_CNTS)
+			dmacRegs.stadr.ADDR = sif0ch.madr;
+	}
+
+	return true;
+}
+
 // Read Fifo into an ee tag, transfer it to sif0ch, and process it.
 static __fi bool ProcessEETag()
 {
@@ -300,6 +344,9 @@ __fi void SIF0Dma()
 		//I realise this is very hacky in a way but its an easy way of checking if both are doing something
 		BusyCheck = 0;
 
+		if (BulkIOPtoEE())
+			BusyCheck++;
+
 		if (sif0.iop.counter == 0 && sif0.iop.writeJunk && sif0.fifo.sif_free() >= sif0.iop.writeJunk)
 		{
 			SIF_LOG("Writing Junk %d", sif0.iop.writeJunk);
@@ -13,10 +13,23 @@
 #include "R3000A.h"
 #include "R5900.h"
 
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifndef _WIN32
 #include <sys/time.h>
@@ -27,8 +40,198 @@ using namespace R5900;
 TraceLogPack TraceLogging;
 ConsoleLogPack ConsoleLogging;
 
+// --------------------------------------------------------------------------------------
+//  TraceBuffer
+// --------------------------------------------------------------------------------------
+// Every emitting thread gets a single-producer ring of fixed-size records, so the hot path
+// is a vsnprintf and two atomic stores. When a ring is full the record is dropped and counted,
+// rather than stalling the emulator and changing the timing we are trying to observe.
+namespace TraceBuffer
+{
+	static constexpr u32 RECORD_SIZE = 256;
+	static constexpr u32 RING_SIZE = 8192; // must be a power of two
+
+	struct Record
+	{
+		u64 timestamp;
+		u32 length;
+		char text[RECORD_SIZE - sizeof(u64) - sizeof(u32)];
+	};
+
+	struct Ring
+	{
+		std::atomic<u32> head{0};
+		std::atomic<u32> tail{0};
+		std::atomic<u32> dropped{0};
+		std::unique_ptr<Record[]> records = std::make_unique<Record[]>(RING_SIZE);
+	};
+
+	static void Push(const char* prefix, const char* fmt, va_list args);
+	static bool Drain(std::vector<Record>& batch);
+	static void WriterThread();
+
+	static std::mutex s_rings_mutex;
+	static std::vector<std::shared_ptr<Ring>> s_rings;
+	static std::atomic<u32> s_generation{0};
+	static std::atomic_bool s_open{false};
+	static std::thread s_writer_thread;
+	static std::FILE* s_file = nullptr;
+	static u64 s_start_time = 0;
+
+	// Rings are shared with s_rings, so a thread can keep writing to a ring from a previous
+	// session after Close() without touching freed memory. The generation makes it re-register.
+	static thread_local std::shared_ptr<Ring> t_ring;
+	static thread_local u32 t_ring_generation = 0;
+} // namespace TraceBuffer
+
+void TraceBuffer::Open(std::string path)
+{
+	if (s_open.load(std::memory_order_relaxed))
+		return;
+
+	Error error;
+	s_file = FileSystem::OpenCFile(path.c_str(), "wb", &error);
+	if (!s_file)
+	{
+		Console.ErrorFmt("Failed to open trace file '{}': {}", path, error.GetDescription());
+		return;
+	}
+
+	{
+		std::unique_lock lock(s_rings_mutex);
+		s_rings.clear();
+		s_generation.fetch_add(1, std::memory_order_release);
+	}
+
+	s_start_time = Common::Timer::GetCurrentValue();
+	s_open.store(true, std::memory_order_release);
+	s_writer_thread = std::thread(&TraceBuffer::WriterThread);
+	Console.WriteLnFmt("Writing buffered trace logs to '{}'.", path);
+}
+
+void TraceBuffer::Close()
+{
+	if (!s_open.load(std::memory_order_relaxed))
+		return;
+
+	s_open.store(false, std::memory_order_release);
+	s_writer_thread.join();
+
+	std::fclose(s_file);
+	s_file = nullptr;
+
+	std::unique_lock lock(s_rings_mutex);
+	s_rings.clear();
+}
+
+bool TraceBuffer::IsOpen()
+{
+	return s_open.load(std::memory_order_acquire);
+}
+
+void TraceBuffer::Push(const char* prefix, const char* fmt, va_list args)
+{
+	const u32 generation = s_generation.load(std::memory_order_acquire);
+	if (!t_ring || t_ring_generation != generation)
+	{
+		t_ring = std::make_shared<Ring>();
+		t_ring_generation = generation;
+
+		std::unique_lock lock(s_rings_mutex);
+		s_rings.push_back(t_ring);
+	}
+
+	Ring& ring = *t_ring;
+	const u32 head = ring.head.load(std::memory_order_relaxed);
+	if ((head - ring.tail.load(std::memory_order_acquire)) >= RING_SIZE)
+	{
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Record& rec = ring.records[head & (RING_SIZE - 1)];
+	rec.timestamp = Common::Timer::GetCurrentValue();
+
+	int length = std::snprintf(rec.text, sizeof(rec.text), "%-8s: ", prefix);
+	if (length >= 0 && static_cast<u32>(length) < sizeof(rec.text))
+	{
+		const int msg_length = std::vsnprintf(rec.text + length, sizeof(rec.text) - length, fmt, args);
+		if (msg_length > 0)
+			length += msg_length;
+	}
+
+	rec.length = std::min<u32>(static_cast<u32>(std::max(length, 0)), sizeof(rec.text) - 1);
+	while (rec.length > 0 && rec.text[rec.length - 1] == '\n')
+		rec.length--;
+
+	ring.head.store(head + 1, std::memory_order_release);
+}
+
+bool TraceBuffer::Drain(std::vector<Record>& batch)
+{
+	u32 dropped = 0;
+	batch.clear();
+
+	{
+		std::unique_lock lock(s_rings_mutex);
+		for (const std::shared_ptr<Ring>& ring : s_rings)
+		{
+			const u32 head = ring->head.load(std::memory_order_acquire);
+			u32 tail = ring->tail.load(std::memory_order_relaxed);
+			for (; tail != head; tail++)
+				batch.push_back(ring->records[tail & (RING_SIZE - 1)]);
+			ring->tail.store(tail, std::memory_order_release);
+
+			dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+		}
+	}
+
+	// Messages from different threads are only ordered within each batch.
+	std::stable_sort(batch.begin(), batch.end(), [](const Record& lhs, const Record& rhs) {
+		return lhs.timestamp < rhs.timestamp;
+	});
+
+	for (const Record& rec : batch)
+	{
+		const double seconds = Common::Timer::ConvertValueToSeconds(rec.timestamp - s_start_time);
+		std::fprintf(s_file, "[%10.4f] %.*s\n", seconds, static_cast<int>(rec.length), rec.text);
+	}
+
+	if (dropped > 0)
+		std::fprintf(s_file, "*** %u trace messages dropped, the writer could not keep up ***\n", dropped);
+
+	return !batch.empty() || dropped > 0;
+}
+
+void TraceBuffer::WriterThread()
+{
+	Threading::SetNameOfCurrentThread("Trace Writer");
+
+	std::vector<Record> batch;
+	batch.reserve(RING_SIZE);
+
+	while (s_open.load(std::memory_order_acquire))
+	{
+		if (!Drain(batch))
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Pick up anything written before Close().
+	Drain(batch);
+	std::fflush(s_file);
+}
+
 bool TraceLog::Write(const char* fmt, ...) const
 {
+	if (TraceBuffer::IsOpen())
+	{
+		va_list args;
+		va_start(args, fmt);
+		TraceBuffer::Push(Descriptor.Prefix.c_str(), fmt, args);
+		va_end(args);
+		return false;
+	}
+
 	auto prefixed_str = fmt::format("{:<8}: {}", Descriptor.Prefix, fmt);
 	va_list args;
 	va_start(args, fmt);
@@ -40,6 +243,15 @@ bool TraceLog::Write(const char* fmt, ...) const
 
 bool TraceLog::Write(ConsoleColors color, const char* fmt, ...) const
 {
+	if (TraceBuffer::IsOpen())
+	{
+		va_list args;
+		va_start(args, fmt);
+		TraceBuffer::Push(Descriptor.Prefix.c_str(), fmt, args);
+		va_end(args);
+		return false;
+	}
+
 	auto prefixed_str = fmt::format("{:<8}: {}", Descriptor.Prefix, fmt);
 	va_list args;
 	va_start(args, fmt);
@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Counters.h"
+#include "GS/GS.h"
+#include "IopMem.h"
+#include "MTGS.h"
+#include "Memory.h"
+#include "R3000A.h"
+#include "R5900.h"
+#include "StateHash.h"
+#include "VUmicro.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/Threading.h"
+
+#include "fmt/format.h"
+#include "xxhash.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace StateHash
+{
+	enum class Region : u32
+	{
+		EERAM,
+		IOPRAM,
+		VU0Mem,
+		VU1Mem,
+		EERegs,
+		IOPRegs,
+		VURegs,
+		Count
+	};
+
+	static constexpr std::array<const char*, static_cast<size_t>(Region::Count)> s_region_names = {{
+		"ee", "iop", "vu0", "vu1", "ee_regs", "iop_regs", "vu_regs",
+	}};
+
+	struct Frame
+	{
+		std::vector<u8> data;
+		std::array<std::pair<u32, u32>, static_cast<size_t>(Region::Count)> regions; // offset and size in data
+		u64 gs_hash;
+		u32 number;
+	};
+
+	static void WorkerThread();
+	static void AppendData(Frame& frame, const void* src, size_t size);
+	static void CopyRegion(Frame& frame, Region region, std::initializer_list<std::pair<const void*, size_t>> sources);
+	static void WriteFrame(const Frame& frame);
+
+	// Frames in flight, the CPU thread waits when all of them are queued rather than dropping
+	// frames, since a gap in the log would hide where the divergence started.
+	static constexpr u32 MAX_QUEUED_FRAMES = 4;
+
+	static std::mutex s_mutex;
+	static std::condition_variable s_work_cv;
+	static std::condition_variable s_free_cv;
+	static std::thread s_worker_thread;
+	static bool s_worker_shutdown = false;
+	static std::deque<std::unique_ptr<Frame>> s_queued_frames;
+	static std::vector<std::unique_ptr<Frame>> s_free_frames;
+	static u32 s_frames_in_flight = 0;
+
+	// Only touched by the worker thread while active.
+	static FileSystem::ManagedCFilePtr s_file;
+} // namespace StateHash
+
+bool StateHash::Start(const std::string& path, Error* error)
+{
+	Stop();
+
+	s_file = FileSystem::OpenManagedCFile(path.c_str(), "wb", error);
+	if (!s_file)
+		return false;
+
+	std::fprintf(s_file.get(), "# frame");
+	for (const char* name : s_region_names)
+		std::fprintf(s_file.get(), " %s", name);
+	std::fprintf(s_file.get(), " gs\n");
+
+	s_worker_shutdown = false;
+	s_worker_thread = std::thread(&StateHash::WorkerThread);
+	Console.WriteLn(fmt::format("StateHash: Logging frame hashes to {}", path));
+	return true;
+}
+
+void StateHash::Stop()
+{
+	if (!s_worker_thread.joinable())
+		return;
+
+	// Frames can still be waiting for their GS hash.
+	MTGS::WaitGS(false, false, false);
+
+	{
+		std::unique_lock lock(s_mutex);
+		s_worker_shutdown = true;
+		s_work_cv.notify_one();
+	}
+
+	s_worker_thread.join();
+	s_worker_shutdown = false;
+	s_free_frames.clear();
+	s_frames_in_flight = 0;
+	s_file.reset();
+}
+
+bool StateHash::IsActive()
+{
+	return s_worker_thread.joinable();
+}
+
+void StateHash::AppendData(Frame& frame, const void* src, size_t size)
+{
+	const size_t offset = frame.data.size();
+	frame.data.resize(offset + size);
+	std::memcpy(frame.data.data() + offset, src, size);
+}
+
+void StateHash::CopyRegion(Frame& frame, Region region, std::initializer_list<std::pair<const void*, size_t>> sources)
+{
+	const size_t offset = frame.data.size();
+	for (const auto& [src, size] : sources)
+		AppendData(frame, src, size);
+
+	frame.regions[static_cast<size_t>(region)] = {static_cast<u32>(offset), static_cast<u32>(frame.data.size() - offset)};
+}
+
+void StateHash::FrameUpdate()
+{
+	if (!IsActive())
+		return;
+
+	std::unique_ptr<Frame> frame;
+	{
+		std::unique_lock lock(s_mutex);
+		s_free_cv.wait(lock, []() { return s_frames_in_flight < MAX_QUEUED_FRAMES; });
+		s_frames_in_flight++;
+		if (!s_free_frames.empty())
+		{
+			frame = std::move(s_free_frames.back());
+			s_free_frames.pop_back();
+		}
+	}
+
+	if (!frame)
+		frame = std::make_unique<Frame>();
+
+	// Copying is the only part which has to stall the CPU thread, hashing happens on the worker.
+	frame->number = g_FrameCount;
+	frame->data.clear();
+	CopyRegion(*frame, Region::EERAM, {{eeMem->Main, Ps2MemSize::MainRam}});
+	CopyRegion(*frame, Region::IOPRAM, {{iopMem->Main, Ps2MemSize::IopRam}});
+	CopyRegion(*frame, Region::VU0Mem, {{vuRegs[0].Mem, VU0_MEMSIZE}});
+	CopyRegion(*frame, Region::VU1Mem, {{vuRegs[1].Mem, VU1_MEMSIZE}});
+
+	// Only the architectural state, the bookkeeping fields around it differ between the interpreters and recompilers.
+	CopyRegion(*frame, Region::EERegs,
+		{{&cpuRegs.GPR, sizeof(cpuRegs.GPR)}, {&cpuRegs.HI, sizeof(cpuRegs.HI)}, {&cpuRegs.LO, sizeof(cpuRegs.LO)},
+			{&cpuRegs.pc, sizeof(cpuRegs.pc)}, {&fpuRegs.fpr, sizeof(fpuRegs.fpr)}});
+	CopyRegion(*frame, Region::IOPRegs, {{&psxRegs.GPR, sizeof(psxRegs.GPR)}, {&psxRegs.pc, sizeof(psxRegs.pc)}});
+	CopyRegion(*frame, Region::VURegs,
+		{{vuRegs[0].VF, sizeof(vuRegs[0].VF)}, {vuRegs[0].VI, sizeof(vuRegs[0].VI)}, {vuRegs[1].VF, sizeof(vuRegs[1].VF)},
+			{vuRegs[1].VI, sizeof(vuRegs[1].VI)}});
+
+	// GS memory lives on the GS thread, so hash it there once the frame's packets have been processed.
+	// The GS thread processes commands in order, so frames still reach the worker in sequence.
+	MTGS::RunOnGSThread([frame = frame.release()]() {
+		frame->gs_hash = GSHashLocalMemory();
+
+		std::unique_lock lock(s_mutex);
+		s_queued_frames.emplace_back(frame);
+		s_work_cv.notify_one();
+	});
+}
+
+void StateHash::WriteFrame(const Frame& frame)
+{
+	std::fprintf(s_file.get(), "%u", frame.number);
+	for (const auto& [offset, size] : frame.regions)
+		std::fprintf(s_file.get(), " %016llx", static_cast<unsigned long long>(XXH3_64bits(frame.data.data() + offset, size)));
+	std::fprintf(s_file.get(), " %016llx\n", static_cast<unsigned long long>(frame.gs_hash));
+}
+
+void StateHash::WorkerThread()
+{
+	Threading::SetNameOfCurrentThread("State Hash");
+
+	std::unique_lock lock(s_mutex);
+	for (;;)
+	{
+		s_work_cv.wait(lock, []() { return s_worker_shutdown || !s_queued_frames.empty(); });
+		if (s_queued_frames.empty())
+			break;
+
+		std::unique_ptr<Frame> frame = std::move(s_queued_frames.front());
+		s_queued_frames.pop_front();
+		lock.unlock();
+
+		WriteFrame(*frame);
+
+		lock.lock();
+		s_free_frames.push_back(std::move(frame));
+		s_frames_in_flight--;
+		s_free_cv.notify_one();
+	}
+
+	lock.unlock();
+	std::fflush(s_file.get());
+}
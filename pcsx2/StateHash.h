@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include <string>
+
+class Error;
+
+/// Writes a line of hashes of guest memory and CPU registers for every frame, so the logs of
+/// two builds (or two runs) can be diffed to find the first frame and subsystem which diverges.
+namespace StateHash
+{
+	/// Starts logging to the given file, replacing its contents.
+	bool Start(const std::string& path, Error* error);
+
+	/// Waits for pending frames to be written, then closes the log.
+	void Stop();
+
+	/// Returns true if frames are currently being logged.
+	bool IsActive();
+
+	/// Copies the state for the current frame, and queues it to be hashed. Called on the CPU thread at vsync.
+	void FrameUpdate();
+} // namespace StateHash
@@ -7,6 +7,7 @@
 
 #include <jpeglib.h>
 
+#include <algorithm>
 #include <csetjmp>
 
 namespace
@@ -16,8 +17,18 @@ namespace
 		jpeg_error_mgr err;
 		jmp_buf jbuf;
 	};
+
+	struct MemCallback
+	{
+		jpeg_destination_mgr mgr;
+		std::vector<u8>* buffer;
+		size_t buffer_used;
+	};
 } // namespace
 
+// Scanline/plane scratch memory for the camera thread, kept around between frames.
+static thread_local std::vector<u8> s_scratch;
+
 static bool HandleJPEGError(JPEGErrorHandler* eh)
 {
 	jpeg_std_error(&eh->err);
@@ -36,26 +47,14 @@ static bool HandleJPEGError(JPEGErrorHandler* eh)
 	return false;
 }
 
-bool CompressCamJPEG(std::vector<u8>* buffer, const u8* image, u32 width, u32 height, int quality)
+static void SetupMemDestination(MemCallback* cb, std::vector<u8>* buffer)
 {
-	struct MemCallback
-	{
-		jpeg_destination_mgr mgr;
-		std::vector<u8>* buffer;
-		size_t buffer_used;
-	};
-
-	JPEGErrorHandler err;
-	if (!HandleJPEGError(&err))
-		return false;
-
-	MemCallback cb;
-	cb.buffer = buffer;
-	cb.buffer_used = 0;
-	cb.mgr.next_output_byte = buffer->data();
-	cb.mgr.free_in_buffer = buffer->size();
-	cb.mgr.init_destination = [](j_compress_ptr cinfo) {};
-	cb.mgr.empty_output_buffer = [](j_compress_ptr cinfo) -> boolean {
+	cb->buffer = buffer;
+	cb->buffer_used = 0;
+	cb->mgr.next_output_byte = buffer->data();
+	cb->mgr.free_in_buffer = buffer->size();
+	cb->mgr.init_destination = [](j_compress_ptr cinfo) {};
+	cb->mgr.empty_output_buffer = [](j_compress_ptr cinfo) -> boolean {
 		MemCallback* cb = (MemCallback*)cinfo->dest;
 
 		// double size
@@ -65,40 +64,106 @@ bool CompressCamJPEG(std::vector<u8>* buffer, const u8* image, u32 width, u32 he
 		cb->mgr.free_in_buffer = cb->buffer->size() - cb->buffer_used;
 		return TRUE;
 	};
-	cb.mgr.term_destination = [](j_compress_ptr cinfo) {
+	cb->mgr.term_destination = [](j_compress_ptr cinfo) {
 		MemCallback* cb = (MemCallback*)cinfo->dest;
 
 		// get final size
 		cb->buffer->resize(cb->buffer->size() - cb->mgr.free_in_buffer);
 	};
+}
+
+static void SetupCompress(jpeg_compress_struct* info, u32 width, u32 height, int quality, J_COLOR_SPACE in_color_space)
+{
+	info->image_width = width;
+	info->image_height = height;
+	info->in_color_space = in_color_space;
+	info->input_components = 3;
+
+	jpeg_set_defaults(info);
+	jpeg_set_quality(info, quality, TRUE);
+
+	// H2V1
+	info->comp_info[0].h_samp_factor = 2;
+	info->comp_info[0].v_samp_factor = 1;
+	info->comp_info[1].h_samp_factor = 1;
+	info->comp_info[1].v_samp_factor = 1;
+	info->comp_info[2].h_samp_factor = 1;
+	info->comp_info[2].v_samp_factor = 1;
+}
+
+bool CompressCamJPEG(std::vector<u8>* buffer, const u8* image, u32 width, u32 height, int quality)
+{
+	JPEGErrorHandler err;
+	if (!HandleJPEGError(&err))
+		return false;
+
+	MemCallback cb;
+	SetupMemDestination(&cb, buffer);
 
 	jpeg_compress_struct info;
 	info.err = &err.err;
 	jpeg_create_compress(&info);
 	info.dest = &cb.mgr;
 
-	info.image_width = width;
-	info.image_height = height;
-	info.in_color_space = JCS_RGB;
-	info.input_components = 3;
+	SetupCompress(&info, width, height, quality, JCS_RGB);
+	jpeg_start_compress(&info, TRUE);
 
-	jpeg_set_defaults(&info);
-	jpeg_set_quality(&info, quality, TRUE);
+	bool result = true;
+	for (u32 y = 0; y < info.image_height; y++)
+	{
+		u8* scanline_buffer[1] = { const_cast<u8*>(image + (y * width * 3)) };
+		if (jpeg_write_scanlines(&info, scanline_buffer, 1) != 1)
+		{
+			Console.ErrorFmt("jpeg_write_scanlines() failed at row {}", y);
+			result = false;
+			break;
+		}
+	}
 
-	// H2V1
-	info.comp_info[0].h_samp_factor = 2;
-	info.comp_info[0].v_samp_factor = 1;
-	info.comp_info[1].h_samp_factor = 1;
-	info.comp_info[1].v_samp_factor = 1;
-	info.comp_info[2].h_samp_factor = 1;
-	info.comp_info[2].v_samp_factor = 1;
+	jpeg_finish_compress(&info);
+	jpeg_destroy_compress(&info);
+	return result;
+}
+
+bool CompressCamJPEGBGR(std::vector<u8>* buffer, const u8* image, u32 width, u32 height, int quality, bool flip_y)
+{
+	JPEGErrorHandler err;
+	if (!HandleJPEGError(&err))
+		return false;
+
+	MemCallback cb;
+	SetupMemDestination(&cb, buffer);
+
+	jpeg_compress_struct info;
+	info.err = &err.err;
+	jpeg_create_compress(&info);
+	info.dest = &cb.mgr;
+
+#ifdef JCS_EXTENSIONS
+	// libjpeg-turbo can take BGR directly, so the rows can be passed straight through.
+	SetupCompress(&info, width, height, quality, JCS_EXT_BGR);
+#else
+	SetupCompress(&info, width, height, quality, JCS_RGB);
+	s_scratch.resize(width * 3);
+#endif
 
 	jpeg_start_compress(&info, TRUE);
 
 	bool result = true;
 	for (u32 y = 0; y < info.image_height; y++)
 	{
-		u8* scanline_buffer[1] = { const_cast<u8*>(image + (y * width * 3)) };
+		const u8* row = image + ((flip_y ? (height - y - 1) : y) * width * 3);
+#ifdef JCS_EXTENSIONS
+		u8* scanline_buffer[1] = { const_cast<u8*>(row) };
+#else
+		for (u32 x = 0; x < width; x++)
+		{
+			s_scratch[x * 3 + 0] = row[x * 3 + 2];
+			s_scratch[x * 3 + 1] = row[x * 3 + 1];
+			s_scratch[x * 3 + 2] = row[x * 3 + 0];
+		}
+		u8* scanline_buffer[1] = { s_scratch.data() };
+#endif
 		if (jpeg_write_scanlines(&info, scanline_buffer, 1) != 1)
 		{
 			Console.ErrorFmt("jpeg_write_scanlines() failed at row {}", y);
@@ -112,6 +177,78 @@ bool CompressCamJPEG(std::vector<u8>* buffer, const u8* image, u32 width, u32 he
 	return result;
 }
 
+bool CompressCamJPEGYUYV(std::vector<u8>* buffer, const u8* yuyv, u32 width, u32 height, int quality)
+{
+	JPEGErrorHandler err;
+	if (!HandleJPEGError(&err))
+		return false;
+
+	MemCallback cb;
+	SetupMemDestination(&cb, buffer);
+
+	jpeg_compress_struct info;
+	info.err = &err.err;
+	jpeg_create_compress(&info);
+	info.dest = &cb.mgr;
+
+	// YUYV is already H2V1 subsampled YCbCr, so hand the planes over as raw data and skip
+	// the colour conversion and downsampling passes entirely.
+	SetupCompress(&info, width, height, quality, JCS_YCbCr);
+	info.raw_data_in = TRUE;
+
+	jpeg_start_compress(&info, TRUE);
+
+	// libjpeg reads whole blocks, so the planes are padded out to the MCU width.
+	const u32 luma_stride = info.comp_info[0].width_in_blocks * DCTSIZE;
+	const u32 chroma_stride = info.comp_info[1].width_in_blocks * DCTSIZE;
+	s_scratch.resize((luma_stride + chroma_stride * 2) * DCTSIZE);
+
+	JSAMPROW y_rows[DCTSIZE], cb_rows[DCTSIZE], cr_rows[DCTSIZE];
+	for (u32 i = 0; i < DCTSIZE; i++)
+	{
+		y_rows[i] = s_scratch.data() + (luma_stride * i);
+		cb_rows[i] = s_scratch.data() + (luma_stride * DCTSIZE) + (chroma_stride * i);
+		cr_rows[i] = s_scratch.data() + ((luma_stride + chroma_stride) * DCTSIZE) + (chroma_stride * i);
+	}
+	JSAMPARRAY planes[3] = { y_rows, cb_rows, cr_rows };
+
+	const u32 pairs = width / 2;
+	bool result = true;
+	for (u32 y = 0; y < height; y += DCTSIZE)
+	{
+		for (u32 i = 0; i < DCTSIZE; i++)
+		{
+			// Bottom edge repeats the last row.
+			const u8* src = yuyv + (std::min(y + i, height - 1) * width * 2);
+			for (u32 x = 0; x < pairs; x++)
+			{
+				y_rows[i][x * 2 + 0] = src[x * 4 + 0];
+				cb_rows[i][x] = src[x * 4 + 1];
+				y_rows[i][x * 2 + 1] = src[x * 4 + 2];
+				cr_rows[i][x] = src[x * 4 + 3];
+			}
+			for (u32 x = pairs * 2; x < luma_stride; x++)
+				y_rows[i][x] = y_rows[i][pairs * 2 - 1];
+			for (u32 x = pairs; x < chroma_stride; x++)
+			{
+				cb_rows[i][x] = cb_rows[i][pairs - 1];
+				cr_rows[i][x] = cr_rows[i][pairs - 1];
+			}
+		}
+
+		if (jpeg_write_raw_data(&info, planes, DCTSIZE) != DCTSIZE)
+		{
+			Console.ErrorFmt("jpeg_write_raw_data() failed at row {}", y);
+			result = false;
+			break;
+		}
+	}
+
+	jpeg_finish_compress(&info);
+	jpeg_destroy_compress(&info);
+	return result;
+}
+
 bool DecompressCamJPEG(std::vector<u8>* buffer, u32* width, u32* height, const u8* data, size_t data_size)
 {
 	JPEGErrorHandler err;
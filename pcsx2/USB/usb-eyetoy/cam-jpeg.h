@@ -6,4 +6,6 @@
 #include <vector>
 
 bool CompressCamJPEG(std::vector<u8>* buffer, const u8* image, u32 width, u32 height, int quality);
+bool CompressCamJPEGBGR(std::vector<u8>* buffer, const u8* image, u32 width, u32 height, int quality, bool flip_y);
+bool CompressCamJPEGYUYV(std::vector<u8>* buffer, const u8* yuyv, u32 width, u32 height, int quality);
 bool DecompressCamJPEG(std::vector<u8>* buffer, u32* width, u32* height, const u8* data, size_t data_size);
\ No newline at end of file
@@ -63,13 +63,19 @@ namespace usb_eyetoy
 			mpeg_mutex.unlock();
 		}
 
+		// Only touched by the capture thread, reused between frames.
+		static std::vector<u8> s_compr_buffer;
+		static std::vector<u8> s_rgb_buffer;
+
 		static void process_image(const unsigned char* data, int size)
 		{
+			std::vector<u8>& comprBuf = s_compr_buffer;
+			std::vector<u8>& rgbData = s_rgb_buffer;
 			constexpr int bytesPerPixel = 3;
 			const size_t comprBufSize = frame_width * frame_height * bytesPerPixel;
 			if (pixelformat == V4L2_PIX_FMT_YUYV)
 			{
-				std::vector<u8> comprBuf(comprBufSize);
+				comprBuf.resize(comprBufSize);
 				if (frame_format == format_mpeg)
 				{
 					const size_t comprLen = jo_write_mpeg(comprBuf.data(), data, frame_width, frame_height, JO_YUYV, mirroring_enabled ? JO_FLIP_X : JO_NONE, JO_NONE);
@@ -77,39 +83,8 @@ namespace usb_eyetoy
 				}
 				else if (frame_format == format_jpeg)
 				{
-					unsigned char* data2 = (unsigned char*)calloc(1, comprBufSize);
-					for (int y = 0; y < frame_height; y++)
-					{
-						for (int x = 0; x < frame_width; x += 2)
-						{
-							const unsigned char* src = data + (y * frame_width + x) * 2;
-							unsigned char* dst = data2 + (y * frame_width + x) * bytesPerPixel;
-
-							int y1 = (int) src[0] << 8;
-							int u  = (int) src[1] - 128;
-							int y2 = (int) src[2] << 8;
-							int v  = (int) src[3] - 128;
-
-							int r  = (y1 + (259 * v) >> 8);
-							int g  = (y1 - (88 * u) - (183 * v)) >> 8;
-							int b  = (y1 + (454 * u)) >> 8;
-							dst[0] = (r > 255) ? 255 : ((r < 0) ? 0 : r);
-							dst[1] = (g > 255) ? 255 : ((g < 0) ? 0 : g);
-							dst[2] = (b > 255) ? 255 : ((b < 0) ? 0 : b);
-
-							r = (y2 + (259 * v) >> 8);
-							g = (y2 - (88 * u) - (183 * v)) >> 8;
-							b = (y2 + (454 * u)) >> 8;
-							dst[3] = (r > 255) ? 255 : ((r < 0) ? 0 : r);
-							dst[4] = (g > 255) ? 255 : ((g < 0) ? 0 : g);
-							dst[5] = (b > 255) ? 255 : ((b < 0) ? 0 : b);
-						}
-					}
-
-					if (!CompressCamJPEG(&comprBuf, data2, frame_width, frame_height, 80))
+					if (!CompressCamJPEGYUYV(&comprBuf, data, frame_width, frame_height, 80))
 						comprBuf.clear();
-
-					free(data2);
 				}
 				else if (frame_format == format_yuv400)
 				{
@@ -143,11 +118,10 @@ namespace usb_eyetoy
 			{
 				if (frame_format == format_mpeg)
 				{
-					std::vector<u8> rgbData;
 					u32 width, height;
 					if (DecompressCamJPEG(&rgbData, &width, &height, data, size))
 					{
-						std::vector<u8> comprBuf(comprBufSize);
+						comprBuf.resize(comprBufSize);
 						const size_t comprLen = jo_write_mpeg(comprBuf.data(), rgbData.data(), frame_width, frame_height, JO_RGB24, mirroring_enabled ? JO_FLIP_X : JO_NONE, JO_NONE);
 						store_mpeg_frame(comprBuf.data(), comprLen);
 					}
@@ -158,12 +132,11 @@ namespace usb_eyetoy
 				}
 				else if (frame_format == format_yuv400)
 				{
-					std::vector<u8> rgbData;
 					u32 width, height;
 					if (DecompressCamJPEG(&rgbData, &width, &height, data, size))
 					{
 						const size_t comprLen = 80 * 64;
-						std::vector<u8> comprBuf(comprLen);
+						comprBuf.resize(comprLen);
 						int in_pos = 0;
 						for (int my = 0; my < 8; my++)
 							for (int mx = 0; mx < 10; mx++)
@@ -380,13 +380,17 @@ namespace usb_eyetoy
 			mpeg_mutex.unlock();
 		}
 
+		// Only touched by the DirectShow callback, reused between frames.
+		static std::vector<u8> s_compr_buffer;
+
 		void dshow_callback(unsigned char* data, int len, int bitsperpixel)
 		{
+			std::vector<u8>& comprBuf = s_compr_buffer;
 			if (bitsperpixel == 24)
 			{
 				const int bytesPerPixel = 3;
 				const size_t comprBufSize = frame_width * frame_height * bytesPerPixel;
-				std::vector<u8> comprBuf(comprBufSize);
+				comprBuf.resize(comprBufSize);
 				if (frame_format == format_mpeg)
 				{
 					const size_t comprLen = jo_write_mpeg(
@@ -396,23 +400,8 @@ namespace usb_eyetoy
 				else if (frame_format == format_jpeg)
 				{
 					// flip Y - always required on windows
-					unsigned char* data2 = (unsigned char*)calloc(1, comprBufSize);
-					for (int y = 0; y < frame_height; y++)
-					{
-						for (int x = 0; x < frame_width; x++)
-						{
-							unsigned char* src = data + (y * frame_width + x) * bytesPerPixel;
-							unsigned char* dst = data2 + ((frame_height - y - 1) * frame_width + x) * bytesPerPixel;
-							dst[0] = src[2];
-							dst[1] = src[1];
-							dst[2] = src[0];
-						}
-					}
-
-					if (!CompressCamJPEG(&comprBuf, data2, frame_width, frame_height, 80))
+					if (!CompressCamJPEGBGR(&comprBuf, data, frame_width, frame_height, 80, true))
 						comprBuf.clear();
-
-					free(data2);
 				}
 				else if (frame_format == format_yuv400)
 				{
@@ -13,9 +13,13 @@
 #include "common/Console.h"
 #include "common/FileSystem.h"
 
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #define le32_to_cpu(x) (x)
 #define cpu_to_le32(x) (x)
@@ -193,6 +197,33 @@ namespace usb_msd
 		bool valid;
 	} ReqState;
 
+	// READ_10/READ_12 data is read from the image on a worker thread, so the IOP doesn't wait
+	// on the host disk. IN packets are NAKed until the data is there, and the OHCI retries them.
+	// Sequential reads also fetch the blocks which follow them, so the next command is served
+	// straight from memory.
+	static constexpr size_t READ_AHEAD_SIZE = 256 * 1024;
+
+	struct MSDReader
+	{
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool shutdown = false;
+		bool pending = false; // worker is filling the cache
+		bool failed = false;
+
+		// Blocks read from the image, covering the current command and what was read ahead of it.
+		std::vector<u8> cache;
+		int64_t cache_offset = 0;
+		size_t cache_size = 0;
+		size_t request_size = 0;
+
+		// Current READ command, served from the cache.
+		bool active = false;
+		size_t pos = 0;
+		int64_t last_end = -1;
+	};
+
 	typedef struct MSDState
 	{
 		USBDevice dev;
@@ -226,8 +257,97 @@ namespace usb_msd
 
 		USBDesc desc;
 		USBDescDevice desc_dev;
+
+		MSDReader reader;
 	} MSDState;
 
+	static void usb_msd_reader_thread(MSDState* s)
+	{
+		MSDReader& r = s->reader;
+		std::unique_lock lock(r.mutex);
+		for (;;)
+		{
+			r.cv.wait(lock, [&r]() { return r.shutdown || r.pending; });
+			if (r.shutdown)
+				break;
+
+			// The emulation thread leaves the cache and file alone while a read is pending.
+			const int64_t offset = r.cache_offset;
+			const size_t request_size = r.request_size;
+			lock.unlock();
+
+			size_t read_size = 0;
+			if (FileSystem::FSeek64(s->file, offset, SEEK_SET) == 0)
+				read_size = std::fread(r.cache.data(), 1, r.cache.size(), s->file);
+
+			lock.lock();
+			r.cache_size = read_size;
+			r.failed = (read_size < request_size);
+			r.pending = false;
+			r.cv.notify_all();
+		}
+	}
+
+	static void usb_msd_reader_wait(MSDState* s)
+	{
+		MSDReader& r = s->reader;
+		std::unique_lock lock(r.mutex);
+		r.cv.wait(lock, [&r]() { return !r.pending; });
+	}
+
+	// Drops the cache, needed before anything else touches the image file.
+	static void usb_msd_reader_reset(MSDState* s)
+	{
+		usb_msd_reader_wait(s);
+
+		MSDReader& r = s->reader;
+		r.active = false;
+		r.failed = false;
+		r.cache_size = 0;
+		r.last_end = -1;
+	}
+
+	static void usb_msd_reader_start(MSDState* s, int64_t offset, size_t size)
+	{
+		usb_msd_reader_wait(s);
+
+		MSDReader& r = s->reader;
+		std::unique_lock lock(r.mutex);
+		r.active = true;
+		r.failed = false;
+
+		if (offset >= r.cache_offset && (offset + static_cast<int64_t>(size)) <= (r.cache_offset + static_cast<int64_t>(r.cache_size)))
+		{
+			r.pos = static_cast<size_t>(offset - r.cache_offset);
+		}
+		else
+		{
+			size_t total = size;
+			if (offset == r.last_end && (offset + static_cast<int64_t>(size)) < s->file_size)
+				total += std::min<size_t>(READ_AHEAD_SIZE, static_cast<size_t>(s->file_size - offset - size));
+
+			r.cache.resize(total);
+			r.cache_offset = offset;
+			r.cache_size = 0;
+			r.request_size = size;
+			r.pos = 0;
+			r.pending = true;
+			r.cv.notify_all();
+		}
+
+		r.last_end = offset + static_cast<int64_t>(size);
+	}
+
+	static bool usb_msd_reader_ready(MSDState* s)
+	{
+		MSDReader& r = s->reader;
+		if (!r.active)
+			return true;
+
+		std::unique_lock lock(r.mutex);
+		return !r.pending;
+	}
+
 // SCSI opcodes
 #define TEST_UNIT_READY 0x00
 #define REZERO_UNIT 0x01
@@ -413,6 +533,7 @@ namespace usb_msd
 		MSDState* s = USB_CONTAINER_OF(dev, MSDState, dev);
 
 		s->f.mode = USB_MSDM_CBW;
+		usb_msd_reader_reset(s);
 	}
 
 #ifndef bswap32
@@ -549,6 +670,23 @@ namespace usb_msd
 					}
 					break;
 				case USB_MSDM_DATAIN:
+					if (s->reader.active)
+					{
+						// usb_msd_reader_ready() was checked by the caller.
+						if (s->reader.failed)
+						{
+							s->f.result = COMMAND_FAILED;
+							set_sense(s, SENSE_CODE(UNRECOVERED_READ_ERROR));
+							goto fail;
+						}
+						len = std::min<size_t>(p->buffer_size - p->actual_length, s->f.data_len);
+						usb_packet_copy(p, s->reader.cache.data() + s->reader.pos, len);
+						s->reader.pos += len;
+						break;
+					}
+
+					// No read in flight for this command, e.g. after loading a state.
+					usb_msd_reader_wait(s);
 					if ((file_ret = fread(s->f.buf, 1, p->buffer_size, s->file)) < p->buffer_size)
 					{
 						s->f.result = COMMAND_FAILED;
@@ -583,6 +721,7 @@ namespace usb_msd
 		uint32_t *last_lba, *blk_len;
 
 		s->f.last_cmd = cbw->cmd[0];
+		s->reader.active = false;
 
 		s->f.result = COMMAND_PASSED;
 		s->f.off = 0;
@@ -704,17 +843,15 @@ namespace usb_msd
 				if (xfer_len == 0) // nothing to do
 					break;
 
-				if (FileSystem::FSeek64(s->file, lba * LBA_BLOCK_SIZE, SEEK_SET) != 0)
+				if ((lba + xfer_len) * LBA_BLOCK_SIZE > s->file_size)
 				{
 					s->f.result = COMMAND_FAILED;
-					//TODO use errno
-					if ((lba + xfer_len) * LBA_BLOCK_SIZE > s->file_size)
-						set_sense(s, SENSE_CODE(OUT_OF_RANGE));
-					else
-						set_sense(s, SENSE_CODE(NO_SEEK_COMPLETE));
+					set_sense(s, SENSE_CODE(OUT_OF_RANGE));
 					return;
 				}
 
+				usb_msd_reader_start(s, lba * LBA_BLOCK_SIZE, xfer_len * LBA_BLOCK_SIZE);
+
 				//memset(s->f.buf, 0, sizeof(s->f.buf));
 				//Or do actual reading in USB_MSDM_DATAIN?
 				//TODO probably dont set data_len to read length
@@ -737,6 +874,8 @@ namespace usb_msd
 
 				if (xfer_len == 0) //nothing to do
 					break;
+
+				usb_msd_reader_reset(s);
 				if (FileSystem::FSeek64(s->file, lba * LBA_BLOCK_SIZE, SEEK_SET) != 0)
 				{
 					s->f.result = COMMAND_FAILED;
@@ -942,6 +1081,13 @@ namespace usb_msd
 						break;
 
 					case USB_MSDM_DATAIN:
+						if (!usb_msd_reader_ready(s))
+						{
+							// Still reading from the image, have the controller retry later.
+							p->status = USB_RET_NAK;
+							break;
+						}
+
 						//if (s->scsi_len)
 						{
 							usb_msd_copy_data(s, p);
@@ -977,6 +1123,16 @@ namespace usb_msd
 	static void usb_msd_handle_destroy(USBDevice* dev)
 	{
 		MSDState* s = USB_CONTAINER_OF(dev, MSDState, dev);
+		if (s && s->reader.thread.joinable())
+		{
+			{
+				std::unique_lock lock(s->reader.mutex);
+				s->reader.shutdown = true;
+				s->reader.cv.notify_all();
+			}
+			s->reader.thread.join();
+		}
+
 		if (s && s->file)
 		{
 			fclose(s->file);
@@ -1162,6 +1318,9 @@ namespace usb_msd
 		s->f.mtime = sd.ModificationTime;
 		s->f.last_cmd = -1;
 
+		if (type == IOMEGA_ZIP_100)
+			s->reader.thread = std::thread(usb_msd_reader_thread, s);
+
 		s->dev.klass.cancel_packet = usb_msd_cancel_io;
 		s->dev.klass.handle_attach = usb_desc_attach;
 		s->dev.klass.handle_reset = usb_msd_handle_reset;
@@ -1209,6 +1368,10 @@ namespace usb_msd
 		const u64 old_mtime = s->f.mtime;
 		sw.DoPOD(&s->f);
 
+		// Reads in flight aren't part of the state, they fall back to reading synchronously.
+		if (sw.IsReading())
+			usb_msd_reader_reset(s);
+
 		// resetting port to try to avoid possible data corruption
 		if (sw.IsReading() && old_mtime != s->f.mtime)
 		{
@@ -5,10 +5,13 @@
 #include "BuildVersion.h"
 #include "CDVD/CDVD.h"
 #include "CDVD/IsoReader.h"
+#include "COP0.h"
 #include "Counters.h"
 #include "DEV9/DEV9.h"
 #include "DebugTools/DebugInterface.h"
+#include "DebugTools/GuestProfiler.h"
 #include "DebugTools/SymbolImporter.h"
+#include "DebugTools/TraceCapture.h"
 #include "Elfheader.h"
 #include "FW.h"
 #include "GS.h"
@@ -18,6 +21,7 @@
 #include "GameList.h"
 #include "Host.h"
 #include "INISettingsInterface.h"
+#include "IPU/IPU.h"
 #include "ImGui/FullscreenUI.h"
 #include "ImGui/ImGuiOverlays.h"
 #include "Input/InputManager.h"
@@ -25,18 +29,21 @@
 #include "MTGS.h"
 #include "MTVU.h"
 #include "PINE.h"
+#include "SharedSnapshot.h"
 #include "Patch.h"
 #include "PerformanceMetrics.h"
 #include "R3000A.h"
 #include "R5900.h"
 #include "Recording/InputRecording.h"
 #include "Recording/InputRecordingControls.h"
+#include "Rewind.h"
 #include "SIO/Memcard/MemoryCardFile.h"
 #include "SIO/Pad/Pad.h"
 #include "SIO/Sio.h"
 #include "SIO/Sio0.h"
 #include "SIO/Sio2.h"
 #include "SPU2/spu2.h"
+#include "StateHash.h"
 #include "USB/USB.h"
 #include "Vif_Dynarec.h"
 #include "VMManager.h"
@@ -63,6 +70,7 @@
 #include <atomic>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
@@ -114,13 +122,16 @@ namespace VMManager
 
 	static std::string GetCurrentSaveStateFileName(s32 slot, bool backup = false);
 	static bool DoLoadState(const char* filename);
+	static bool CanUseFastBootSnapshot();
+	static std::string GetFastBootSnapshotPath();
+	static bool LoadFastBootSnapshot();
 	static bool DoSaveState(const char* filename, s32 slot_for_message, bool zip_on_thread, bool backup_old_state);
 	static void ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 		std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, const char* filename,
-		s32 slot_for_message);
+		s32 slot_for_message, bool backup_old_state);
 	static void ZipSaveStateOnThread(std::unique_ptr<ArchiveEntryList> elist,
 		std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, std::string filename,
-		s32 slot_for_message);
+		s32 slot_for_message, bool backup_old_state);
 
 	static void LoadSettings();
 	static void LoadCoreSettings(SettingsInterface& si);
@@ -131,6 +142,8 @@ namespace VMManager
 	static void ResetResumeTimestamp();
 	static void SaveSessionTime(const std::string& prev_serial);
 	static void ReloadPINE();
+	static void ReloadSharedSnapshot();
+	static void ReloadCDVDReadProfile();
 
 	static float GetTargetSpeedForLimiterMode(LimiterModeType mode);
 	static void ResetFrameLimiter();
@@ -177,12 +190,15 @@ static std::string s_elf_override;
 static std::string s_input_profile_name;
 static u32 s_frame_advance_count = 0;
 static bool s_fast_boot_requested = false;
+static bool s_fast_boot_snapshot_done = false;
 static bool s_gs_open_on_initialize = false;
 static bool s_thread_affinities_set = false;
 
 static LimiterModeType s_limiter_mode = LimiterModeType::Nominal;
 static s64 s_limiter_ticks_per_frame = 0;
 static u64 s_limiter_frame_start = 0;
+static u64 s_limiter_work_start = 0;
+static s64 s_limiter_predicted_work = 0;
 static float s_target_speed = 0.0f;
 static bool s_target_speed_can_sync_to_host = false;
 static bool s_target_speed_synced_to_host = false;
@@ -372,8 +388,12 @@ const std::string& VMManager::GetCurrentELF()
 bool VMManager::Internal::CPUThreadInitialize()
 {
 	Threading::SetNameOfCurrentThread("CPU Thread");
+	TraceCapture::SetThreadName("EE");
 	PerformanceMetrics::SetCPUThread(Threading::ThreadHandle::GetForCallingThread());
 
+	// Keep console and file I/O off the CPU thread, heavy IOP/EE printf output would otherwise stall emulation.
+	Log::SetAsyncOutputEnabled(true);
+
 	// On Win32, we have a bunch of things which use COM (e.g. SDL, XAudio2, etc).
 	// We need to initialize COM first, before anything else does, because otherwise they might
 	// initialize it in single-threaded/apartment mode, which can't be changed to multithreaded.
@@ -411,11 +431,13 @@ bool VMManager::Internal::CPUThreadInitialize()
 	// We want settings loaded so we choose the correct renderer for big picture mode.
 	// This also sorts out input sources.
 	LoadSettings();
+	SysMemory::SetHugePagesEnabled(EmuConfig.EnableHugePages);
 
 	if (EmuConfig.Achievements.Enabled)
 		Achievements::Initialize();
 
 	ReloadPINE();
+	ReloadSharedSnapshot();
 
 	if (EmuConfig.EnableDiscordPresence)
 		InitializeDiscordPresence();
@@ -432,11 +454,14 @@ void VMManager::Internal::CPUThreadShutdown()
 	ShutdownDiscordPresence();
 
 	PINEServer::Deinitialize();
+	SharedSnapshot::Deinitialize();
 
 	Achievements::Shutdown(false);
 
 	InputManager::CloseSources();
 	WaitForSaveStateFlush();
+	SaveState_FreeBuffers();
+	TraceBuffer::Close();
 
 	PerformanceMetrics::SetCPUThread(Threading::ThreadHandle());
 
@@ -453,6 +478,8 @@ void VMManager::Internal::CPUThreadShutdown()
 	CoUninitialize();
 #endif
 
+	Log::SetAsyncOutputEnabled(false);
+
 	// Ensure emulog gets flushed.
 	Log::SetFileOutputLevel(LOGLEVEL_NONE, std::string());
 
@@ -518,6 +545,11 @@ void VMManager::UpdateLoggingSettings(SettingsInterface& si)
 		std::string path = Path::Combine(EmuFolders::Logs, "emulog.txt");
 		Log::SetFileOutputLevel(file_logging_enabled ? EmuConfig.Trace.Enabled ? LOGLEVEL_TRACE : level : LOGLEVEL_NONE, std::move(path));
 	}
+
+	if (EmuConfig.Trace.Enabled && EmuConfig.Trace.Buffered)
+		TraceBuffer::Open(Path::Combine(EmuFolders::Logs, "emutrace.txt"));
+	else
+		TraceBuffer::Close();
 }
 
 void VMManager::SetDefaultLoggingSettings(SettingsInterface& si)
@@ -1118,6 +1150,8 @@ void VMManager::UpdateDiscDetails(bool booting)
 	{
 		Achievements::GameChanged(s_disc_crc, s_current_crc);
 		ReloadPINE();
+		ReloadSharedSnapshot();
+		ReloadCDVDReadProfile();
 		UpdateDiscordPresence(s_state.load(std::memory_order_relaxed) == VMState::Initializing);
 		FileMcd_Reopen(memcardFilters.empty() ? s_disc_serial : memcardFilters);
 	}
@@ -1248,10 +1282,13 @@ bool VMManager::AutoDetectSource(const std::string& filename)
 void VMManager::PrecacheCDVDFile()
 {
 	Error error;
-	std::unique_ptr<ProgressCallback> progress = Host::CreateHostProgressCallback();
-	if (!DoCDVDprecache(progress.get(), &error))
+	std::unique_ptr<ProgressCallback> progress;
+	if (!EmuConfig.CdvdBackgroundPrecache)
+		progress = Host::CreateHostProgressCallback();
+
+	if (!DoCDVDprecache(progress.get(), EmuConfig.CdvdBackgroundPrecache, &error))
 	{
-		if (progress->IsCancelled())
+		if (progress && progress->IsCancelled())
 		{
 			Host::AddIconOSDMessage("PrecacheCDVDFile", ICON_FA_COMPACT_DISC,
 				TRANSLATE_STR("VMManager", "CDVD precaching was cancelled."),
@@ -1469,14 +1506,13 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 	SysMemory::Reset();
 	cpuReset();
 
+	// The GS device and shader cache take the longest to come up, so let the GS thread work on
+	// them while we open the subsystems which don't depend on it. This has to happen after the
+	// memory reset above, since the GS thread copies the privileged registers when opening.
 	Console.WriteLn("Opening GS...");
 	s_gs_open_on_initialize = MTGS::IsOpen();
-	if (!s_gs_open_on_initialize && !MTGS::WaitForOpen())
-	{
-		// we assume GS is going to report its own error
-		Console.WriteLn("Failed to open GS.");
-		return false;
-	}
+	if (!s_gs_open_on_initialize)
+		MTGS::BeginOpen();
 
 	ScopedGuard close_gs = []() {
 		if (!s_gs_open_on_initialize)
@@ -1531,6 +1567,14 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 		DEV9shutdown();
 	};
 
+	// USB devices can set up software cursors, which need the GS.
+	if (!s_gs_open_on_initialize && !MTGS::WaitForOpen())
+	{
+		// we assume GS is going to report its own error
+		Console.WriteLn("Failed to open GS.");
+		return false;
+	}
+
 	Console.WriteLn("Opening USB...");
 	if (!USBopen())
 	{
@@ -1575,6 +1619,7 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 	SetEmuThreadAffinities();
 
 	// do we want to load state?
+	s_fast_boot_snapshot_done = false;
 	if (!GSDumpReplayer::IsReplayingDump() && !state_to_load.empty())
 	{
 		if (!DoLoadState(state_to_load.c_str()))
@@ -1583,8 +1628,13 @@ bool VMManager::Initialize(VMBootParameters boot_params)
 			return false;
 		}
 	}
+	else if (CanUseFastBootSnapshot())
+	{
+		LoadFastBootSnapshot();
+	}
 
 	PerformanceMetrics::Clear();
+	PerformanceMetrics::BeginCPUThroughput();
 	return true;
 }
 
@@ -1612,6 +1662,12 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (g_InputRecording.isActive())
 		g_InputRecording.stop();
 
+	StateHash::Stop();
+	GuestProfiler::Stop();
+	TraceCapture::Stop();
+	PerformanceMetrics::LogCPUThroughput();
+	LogTLBWriteStats();
+
 	SaveSessionTime(s_disc_serial);
 	s_elf_override = {};
 	ClearELFInfo();
@@ -1638,6 +1694,7 @@ void VMManager::Shutdown(bool save_resume_state)
 	vtlb_Shutdown();
 	USBclose();
 	SPU2::Close();
+	ipuThreadShutdown();
 	Pad::Shutdown();
 	g_Sio2.Shutdown();
 	g_Sio0.Shutdown();
@@ -1667,6 +1724,9 @@ void VMManager::Shutdown(bool save_resume_state)
 	else
 		cdvdSaveNVRAM();
 
+	Rewind::Shutdown();
+	SaveState_FreeBuffers();
+
 	s_state.store(VMState::Shutdown, std::memory_order_release);
 	FullscreenUI::OnVMDestroyed();
 	SaveStateSelectorUI::Clear();
@@ -1810,6 +1870,84 @@ std::string VMManager::GetCurrentSaveStateFileName(s32 slot, bool backup)
 	return GetSaveStateFileName(s_disc_serial.c_str(), s_disc_crc, slot, backup);
 }
 
+bool VMManager::CanUseFastBootSnapshot()
+{
+	// The snapshot resumes in the middle of EELOAD, which the interpreter wouldn't pick up as a hook.
+	return (EmuConfig.EnableFastBootSnapshot && Internal::IsFastBootInProgress() && EmuConfig.Cpu.Recompiler.EnableEE &&
+			BiosChecksum != 0 && !g_InputRecording.isActive() && !Achievements::IsHardcoreModeActive());
+}
+
+std::string VMManager::GetFastBootSnapshotPath()
+{
+	// The IOP may have looked at the disc while booting, so keep separate snapshots per disc type.
+	return Path::Combine(EmuFolders::Cache, fmt::format("fastboot_{:08X}_{:04X}_{}_{}_{:08X}.p2s", BiosChecksum,
+												BiosVersion, static_cast<u32>(cdvd.DiscType),
+												static_cast<u32>(EmuConfig.Cpu.ExtraMemory), g_SaveVersion));
+}
+
+bool VMManager::LoadFastBootSnapshot()
+{
+	const std::string path = GetFastBootSnapshotPath();
+	if (!FileSystem::FileExists(path.c_str()))
+		return false;
+
+	Common::Timer timer;
+
+	// The clock would be stuck at the time the snapshot was created.
+	const cdvdRTC rtc = cdvd.RTC;
+
+	Error error;
+	if (!SaveState_UnzipFromDisk(path, &error))
+	{
+		// VM was reset by the failed load, so we boot normally and create a new snapshot.
+		Console.Error(fmt::format("Failed to load fast boot snapshot '{}': {}", Path::GetFileName(path), error.GetDescription()));
+		FileSystem::DeleteFilePath(path.c_str());
+		return false;
+	}
+
+	cdvd.RTC = rtc;
+	cdvdRedetectDisk();
+
+	// Usually found when EELOAD's start is recompiled, which we skipped.
+	g_eeloadMain = cpuRegs.pc;
+	s_fast_boot_snapshot_done = true;
+
+	Console.WriteLn(Color_StrongGreen, fmt::format("Restored fast boot snapshot {} in {:.2f} ms.", Path::GetFileName(path),
+										   timer.GetTimeMilliseconds()));
+	return true;
+}
+
+void VMManager::Internal::SaveFastBootSnapshotOnCPUThread()
+{
+	if (s_fast_boot_snapshot_done || !CanUseFastBootSnapshot())
+		return;
+
+	s_fast_boot_snapshot_done = true;
+
+	const std::string path = GetFastBootSnapshotPath();
+	if (FileSystem::FileExists(path.c_str()))
+		return;
+
+	// We're called at the start of EELOAD's main, the PC isn't written back when jumping between linked blocks.
+	cpuRegs.pc = g_eeloadMain;
+
+	Error error;
+	std::unique_ptr<ArchiveEntryList> elist = SaveState_DownloadState(&error);
+	if (!elist)
+	{
+		Console.Error(fmt::format("Failed to create fast boot snapshot: {}", error.GetDescription()));
+		return;
+	}
+
+	if (!SaveState_ZipToDisk(std::move(elist), nullptr, path.c_str()))
+	{
+		Console.Error(fmt::format("Failed to write fast boot snapshot '{}'", Path::GetFileName(path)));
+		return;
+	}
+
+	Console.WriteLn(Color_StrongGreen, fmt::format("Saved fast boot snapshot {}.", Path::GetFileName(path)));
+}
+
 bool VMManager::DoLoadState(const char* filename)
 {
 	if (GSDumpReplayer::IsReplayingDump())
@@ -1854,29 +1992,18 @@ bool VMManager::DoSaveState(const char* filename, s32 slot_for_message, bool zip
 
 	std::unique_ptr<SaveStateScreenshotData> screenshot = SaveState_SaveScreenshot();
 
-	if (FileSystem::FileExists(filename) && backup_old_state)
-	{
-		const std::string backup_filename(fmt::format("{}.backup", filename));
-		Console.WriteLn(fmt::format("Creating save state backup {}...", backup_filename));
-		if (!FileSystem::RenamePath(filename, backup_filename.c_str()))
-		{
-			Host::AddIconOSDMessage(osd_key, ICON_FA_TRIANGLE_EXCLAMATION,
-				fmt::format(
-					TRANSLATE_FS("VMManager", "Failed to back up old save state {}."), Path::GetFileName(filename)),
-				Host::OSD_ERROR_DURATION);
-		}
-	}
-
+	// Backing up the old state is file I/O too, so it happens alongside compression.
 	if (zip_on_thread)
 	{
 		// lock order here is important; the thread could exit before we resume here.
 		std::unique_lock lock(s_save_state_threads_mutex);
 		s_save_state_threads.emplace_back(&VMManager::ZipSaveStateOnThread, std::move(elist), std::move(screenshot),
-			std::move(osd_key), std::string(filename), slot_for_message);
+			std::move(osd_key), std::string(filename), slot_for_message, backup_old_state);
 	}
 	else
 	{
-		ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename, slot_for_message);
+		ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename, slot_for_message,
+			backup_old_state);
 	}
 
 	Host::OnSaveStateSaved(filename);
@@ -1886,10 +2013,23 @@ bool VMManager::DoSaveState(const char* filename, s32 slot_for_message, bool zip
 
 void VMManager::ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 	std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, const char* filename,
-	s32 slot_for_message)
+	s32 slot_for_message, bool backup_old_state)
 {
 	Common::Timer timer;
 
+	if (backup_old_state && FileSystem::FileExists(filename))
+	{
+		const std::string backup_filename(fmt::format("{}.backup", filename));
+		Console.WriteLn(fmt::format("Creating save state backup {}...", backup_filename));
+		if (!FileSystem::RenamePath(filename, backup_filename.c_str()))
+		{
+			Host::AddIconOSDMessage(osd_key, ICON_FA_TRIANGLE_EXCLAMATION,
+				fmt::format(
+					TRANSLATE_FS("VMManager", "Failed to back up old save state {}."), Path::GetFileName(filename)),
+				Host::OSD_ERROR_DURATION);
+		}
+	}
+
 	if (SaveState_ZipToDisk(std::move(elist), std::move(screenshot), filename))
 	{
 		if (slot_for_message >= 0 && VMManager::HasValidVM())
@@ -1911,9 +2051,10 @@ void VMManager::ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 
 void VMManager::ZipSaveStateOnThread(std::unique_ptr<ArchiveEntryList> elist,
 	std::unique_ptr<SaveStateScreenshotData> screenshot, std::string osd_key, std::string filename,
-	s32 slot_for_message)
+	s32 slot_for_message, bool backup_old_state)
 {
-	ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename.c_str(), slot_for_message);
+	ZipSaveState(std::move(elist), std::move(screenshot), std::move(osd_key), filename.c_str(), slot_for_message,
+		backup_old_state);
 
 	// remove ourselves from the thread list. if we're joining, we might not be in there.
 	const auto this_id = std::this_thread::get_id();
@@ -2169,6 +2310,35 @@ float VMManager::GetFrameRate()
 void VMManager::ResetFrameLimiter()
 {
 	s_limiter_frame_start = GetCPUTicks();
+	s_limiter_work_start = 0;
+}
+
+/// Waits for the limiter to reach the specified tick. Normally whole milliseconds are slept off and the
+/// remainder is spun, in power saving mode the OS timer is trusted for the whole wait instead.
+static void LimiterWaitUntil(u64 end)
+{
+	if (EmuConfig.EmulationSpeed.PowerSaving)
+	{
+		Threading::SleepUntil(end);
+		return;
+	}
+
+	const u64 now = GetCPUTicks();
+	if (end <= now)
+		return;
+
+	// If any integer value of milliseconds exists, sleep it off.
+	// Prior comments suggested that 1-2 ms sleeps were inaccurate on some OSes;
+	// further testing suggests instead that this was utter bullshit.
+	const s32 msec = static_cast<s32>(((end - now) * 1000) / GetTickFrequency());
+	if (msec > 1)
+		Threading::Sleep(msec - 1);
+
+	// Conversion to milliseconds loses some precision; after sleeping off whole milliseconds,
+	// spin the thread without sleeping until we finally reach our expected end time.
+	while (GetCPUTicks() < end)
+	{
+	}
 }
 
 void VMManager::Internal::Throttle()
@@ -2182,6 +2352,17 @@ void VMManager::Internal::Throttle()
 	const u64 iEnd = GetCPUTicks(); // The current tick we actually stopped on.
 	const s64 sDeltaTime = iEnd - uExpectedEnd; // The diff between when we stopped and when we expected to.
 
+	// Track how long the frame took to emulate for DelayFrameStart(). Rise straight away on a slow frame,
+	// but only decay slowly, so a single quick frame doesn't make us start the next one too late.
+	if (s_limiter_work_start != 0)
+	{
+		const s64 work = static_cast<s64>(iEnd - s_limiter_work_start);
+		if (work > s_limiter_predicted_work)
+			s_limiter_predicted_work = work;
+		else
+			s_limiter_predicted_work -= (s_limiter_predicted_work - work) / 16;
+	}
+
 	// If frame ran too long...
 	if (sDeltaTime >= s_limiter_ticks_per_frame)
 	{
@@ -2190,25 +2371,27 @@ void VMManager::Internal::Throttle()
 		return;
 	}
 
-	// Conversion of delta from CPU ticks (microseconds) to milliseconds
-	const s32 msec = static_cast<s32>((sDeltaTime * -1000) / static_cast<s64>(GetTickFrequency()));
+	LimiterWaitUntil(uExpectedEnd);
 
-	// If any integer value of milliseconds exists, sleep it off.
-	// Prior comments suggested that 1-2 ms sleeps were inaccurate on some OSes;
-	// further testing suggests instead that this was utter bullshit.
-	if (msec > 1)
-	{
-		Threading::Sleep(msec - 1);
-	}
+	// Finally, set our next frame start to when this one ends
+	s_limiter_frame_start = uExpectedEnd;
+}
 
-	// Conversion to milliseconds loses some precision; after sleeping off whole milliseconds,
-	// spin the thread without sleeping until we finally reach our expected end time.
-	while (GetCPUTicks() < uExpectedEnd)
+void VMManager::Internal::DelayFrameStart()
+{
+	if (!EmuConfig.EmulationSpeed.ReduceInputLatency || s_target_speed == 0.0f || s_use_vsync_for_timing)
 	{
+		s_limiter_work_start = 0;
+		return;
 	}
 
-	// Finally, set our next frame start to when this one ends
-	s_limiter_frame_start = uExpectedEnd;
+	// Keep an eighth of a frame spare for spikes and for the GS thread to finish off the frame.
+	const s64 margin = s_limiter_ticks_per_frame / 8;
+	const u64 wake_time = s_limiter_frame_start + static_cast<u64>(std::max<s64>(s_limiter_ticks_per_frame - s_limiter_predicted_work - margin, 0));
+
+	LimiterWaitUntil(wake_time);
+
+	s_limiter_work_start = GetCPUTicks();
 }
 
 void VMManager::Internal::FrameRateChanged()
@@ -2598,6 +2781,8 @@ void VMManager::ShutdownCPUProviders()
 	{
 		dVifRelease(1);
 		dVifRelease(0);
+		dVifCloseUnpackCache(1);
+		dVifCloseUnpackCache(0);
 	}
 
 #ifdef _M_X86 // TODO(Stenzek): Remove me once EE/VU/IOP recs are added.
@@ -2816,6 +3001,11 @@ void VMManager::Internal::EntryPointCompilingOnCPUThread()
 
 void VMManager::Internal::VSyncOnCPUThread()
 {
+	TraceCapture::MarkFrame("EE Frame");
+	TraceCapture::ScopedEvent trace("EE VSync");
+
+	PerformanceMetrics::UpdateCPUThroughput();
+
 	Pad::UpdateMacroButtons();
 
 	Patch::ApplyLoadedPatches(Patch::PPT_CONTINUOUSLY);
@@ -2835,6 +3025,9 @@ void VMManager::Internal::VSyncOnCPUThread()
 
 	Achievements::FrameUpdate();
 
+	PINEServer::VSync();
+	SharedSnapshot::VSync();
+
 	PollDiscordPresence();
 }
 
@@ -2842,6 +3035,8 @@ void VMManager::Internal::PollInputOnCPUThread()
 {
 	Host::PumpMessagesOnCPUThread();
 	InputManager::PollSources();
+	Rewind::FrameUpdate();
+	StateHash::FrameUpdate();
 
 	if (EmuConfig.EnableRecordingTools)
 	{
@@ -3016,6 +3211,20 @@ void VMManager::CheckForMiscConfigChanges(const Pcsx2Config& old_config)
 			ShutdownDiscordPresence();
 	}
 
+	if (EmuConfig.EnableHugePages != old_config.EnableHugePages)
+		SysMemory::SetHugePagesEnabled(EmuConfig.EnableHugePages);
+
+	if (EmuConfig.EnableSharedSnapshot != old_config.EnableSharedSnapshot ||
+		EmuConfig.SharedSnapshotWidth != old_config.SharedSnapshotWidth ||
+		EmuConfig.SharedSnapshotHeight != old_config.SharedSnapshotHeight ||
+		EmuConfig.SharedSnapshotRanges != old_config.SharedSnapshotRanges)
+	{
+		ReloadSharedSnapshot();
+	}
+
+	if (HasValidVM() && EmuConfig.CdvdReadPrediction != old_config.CdvdReadPrediction)
+		ReloadCDVDReadProfile();
+
 	if (HasValidVM() && (EmuConfig.EnableThreadPinning != old_config.EnableThreadPinning ||
 							(s_thread_affinities_set && EmuConfig.Speedhacks.vuThread != old_config.Speedhacks.vuThread)))
 	{
@@ -3034,6 +3243,9 @@ void VMManager::CheckForConfigChanges(const Pcsx2Config& old_config)
 		CheckForDEV9ConfigChanges(old_config);
 		CheckForMemoryCardConfigChanges(old_config);
 		USB::CheckForConfigChanges(old_config);
+
+		if (EmuConfig.Savestate != old_config.Savestate)
+			Rewind::UpdateSettings();
 	}
 
 	// For the big picture UI, we still need to update GS settings, since it's running,
@@ -3093,6 +3305,7 @@ void VMManager::EnforceAchievementsChallengeModeSettings()
 	// Input recording/playback is probably an issue.
 	EmuConfig.EnableRecordingTools = false;
 	EmuConfig.EnablePINE = false;
+	EmuConfig.EnableSharedSnapshot = false;
 
 	// Framerates should be at default.
 	EmuConfig.GS.FramerateNTSC = Pcsx2Config::GSOptions::DEFAULT_FRAME_RATE_NTSC;
@@ -3417,7 +3630,15 @@ void VMManager::SetTimerResolutionIncreased(bool enabled)
 
 #endif
 
-static std::vector<u32> s_processor_list;
+struct PinnableProcessor
+{
+	u32 id; // OS processor id
+	u32 cache_domain; // first processor sharing the last level cache, i.e. the CCX/CCD
+	u64 frequency;
+};
+
+// Physical cores only, fastest cache domain first, then fastest cores within each domain.
+static std::vector<PinnableProcessor> s_processor_list;
 static std::vector<u32> s_software_renderer_processor_list;
 static std::once_flag s_processor_list_initialized;
 
@@ -3434,6 +3655,16 @@ static u32 GetProcessorIdForProcessor(const cpuinfo_processor* proc)
 #endif
 }
 
+static u32 GetCacheDomainForProcessor(const cpuinfo_processor* proc)
+{
+	if (proc->cache.l3)
+		return proc->cache.l3->processor_start;
+	else if (proc->cache.l2)
+		return proc->cache.l2->processor_start;
+	else
+		return proc->cluster ? proc->cluster->processor_start : 0;
+}
+
 static void InitializeProcessorList()
 {
 	if (!cpuinfo_initialize())
@@ -3442,11 +3673,11 @@ static void InitializeProcessorList()
 		return;
 	}
 
-	INFO_LOG("Processor count: {} cores, {} processors, {} clusters",
-		cpuinfo_get_cores_count(), cpuinfo_get_processors_count(), cpuinfo_get_clusters_count());
+	INFO_LOG("Processor count: {} cores, {} processors, {} clusters, {} L3 caches",
+		cpuinfo_get_cores_count(), cpuinfo_get_processors_count(), cpuinfo_get_clusters_count(), cpuinfo_get_l3_caches_count());
 
 	const u32 processor_count = cpuinfo_get_processors_count();
-	std::vector<const cpuinfo_processor*> processors;
+	std::vector<PinnableProcessor> processors;
 	for (u32 i = 0; i < processor_count; i++)
 	{
 		// Ignore hyperthreads/SMT. They're not helpful for pinning.
@@ -3454,23 +3685,59 @@ static void InitializeProcessorList()
 		if (!proc || proc->smt_id != 0)
 			continue;
 
-		processors.push_back(proc);
+		processors.push_back({GetProcessorIdForProcessor(proc), GetCacheDomainForProcessor(proc), proc->core->frequency});
+	}
+
+	// Rank the cache domains by their fastest core, then by how many of those cores they have. On hybrid
+	// CPUs this picks the P cores, and on multi-CCD CPUs it keeps the EE, VU and GS threads on one CCD,
+	// rather than bouncing shared data across the fabric.
+	struct DomainRank
+	{
+		u64 max_frequency = 0;
+		u32 fast_cores = 0;
+	};
+	std::unordered_map<u32, DomainRank> domains;
+	for (const PinnableProcessor& proc : processors)
+	{
+		DomainRank& rank = domains[proc.cache_domain];
+		if (proc.frequency > rank.max_frequency)
+		{
+			rank.max_frequency = proc.frequency;
+			rank.fast_cores = 0;
+		}
+		rank.fast_cores += static_cast<u32>(proc.frequency == rank.max_frequency);
 	}
 
-	// Prioritize faster cores in heterogeneous CPUs.
 	std::sort(processors.begin(), processors.end(),
-		[](const cpuinfo_processor* lhs, const cpuinfo_processor* rhs) {
-			return (lhs->core->frequency > rhs->core->frequency);
+		[&domains](const PinnableProcessor& lhs, const PinnableProcessor& rhs) {
+			if (lhs.cache_domain != rhs.cache_domain)
+			{
+				const DomainRank& lrank = domains[lhs.cache_domain];
+				const DomainRank& rrank = domains[rhs.cache_domain];
+				if (lrank.max_frequency != rrank.max_frequency)
+					return (lrank.max_frequency > rrank.max_frequency);
+				if (lrank.fast_cores != rrank.fast_cores)
+					return (lrank.fast_cores > rrank.fast_cores);
+				return (lhs.cache_domain < rhs.cache_domain);
+			}
+
+			// Prioritize faster cores in heterogeneous CPUs.
+			if (lhs.frequency != rhs.frequency)
+				return (lhs.frequency > rhs.frequency);
+
+			return (lhs.id < rhs.id);
 		});
 
 	SmallString str;
 	str.assign("Ordered processor list: ");
 	s_processor_list.reserve(processors.size());
-	for (const cpuinfo_processor* proc : processors)
+	for (const PinnableProcessor& proc : processors)
 	{
-		const u32 proc_id = GetProcessorIdForProcessor(proc);
-		str.append_format("{}{}", (proc == processors.front()) ? "" : ", ", proc_id);
-		s_processor_list.push_back(proc_id);
+		// cache domains are separated with |
+		if (!s_processor_list.empty())
+			str.append((proc.cache_domain != s_processor_list.back().cache_domain) ? " | " : ", ");
+		str.append_format("{}", proc.id);
+		s_processor_list.push_back(proc);
 	}
 	Console.WriteLn(str.view());
 }
@@ -3578,7 +3845,8 @@ void VMManager::SetEmuThreadAffinities()
 	}
 
 	const bool mtvu = EmuConfig.Speedhacks.vuThread;
-	if (!new_pin_enable || s_processor_list.size() < (mtvu ? 3 : 2))
+	const size_t main_threads = mtvu ? 3 : 2;
+	if (!new_pin_enable || s_processor_list.size() < main_threads)
 	{
 		if (new_pin_enable)
 			ERROR_LOG("Insufficient processors for thread pinning.");
@@ -3590,20 +3858,23 @@ void VMManager::SetEmuThreadAffinities()
 		return;
 	}
 
-	// steal vu's thread if mtvu is off
-	const u32 ee_index = s_processor_list[0];
-	const u32 vu_index = s_processor_list[1];
-	const u32 gs_index = s_processor_list[mtvu ? 2 : 1];
-	INFO_LOG("Processor order assignment: EE={}, VU={}, GS={}", ee_index, vu_index, gs_index);
+	// The list is sorted with the fastest cache domain first, so EE and VU end up sharing a L3 where possible,
+	// with the GS next to them. steal vu's thread if mtvu is off
+	const PinnableProcessor& ee_proc = s_processor_list[0];
+	const PinnableProcessor& vu_proc = s_processor_list[1];
+	const PinnableProcessor& gs_proc = s_processor_list[mtvu ? 2 : 1];
+	INFO_LOG("Processor order assignment: EE={}, VU={}, GS={}", ee_proc.id, vu_proc.id, gs_proc.id);
+	if (mtvu && ee_proc.cache_domain != vu_proc.cache_domain)
+		WARNING_LOG("  EE and VU threads are in different cache domains, not enough cores in the fastest one.");
 
-	const u64 ee_affinity = static_cast<u64>(1) << ee_index;
-	INFO_LOG("  EE thread is on processor {} (0x{:x})", ee_index, ee_affinity);
+	const u64 ee_affinity = static_cast<u64>(1) << ee_proc.id;
+	INFO_LOG("  EE thread is on processor {} (0x{:x})", ee_proc.id, ee_affinity);
 	s_vm_thread_handle.SetAffinity(ee_affinity);
 
 	if (EmuConfig.Speedhacks.vuThread)
 	{
-		const u64 vu_affinity = static_cast<u64>(1) << vu_index;
-		INFO_LOG("  VU thread is on processor {} (0x{:x})", vu_index, vu_affinity);
+		const u64 vu_affinity = static_cast<u64>(1) << vu_proc.id;
+		INFO_LOG("  VU thread is on processor {} (0x{:x})", vu_proc.id, vu_affinity);
 		vu1Thread.GetThreadHandle().SetAffinity(vu_affinity);
 	}
 	else
@@ -3611,28 +3882,29 @@ void VMManager::SetEmuThreadAffinities()
 		vu1Thread.GetThreadHandle().SetAffinity(0);
 	}
 
-	const u64 gs_affinity = static_cast<u64>(1) << gs_index;
-	INFO_LOG("  GS thread is on processor {} (0x{:x})", gs_index, gs_affinity);
+	const u64 gs_affinity = static_cast<u64>(1) << gs_proc.id;
+	INFO_LOG("  GS thread is on processor {} (0x{:x})", gs_proc.id, gs_affinity);
 	MTGS::GetThreadHandle().SetAffinity(gs_affinity);
 
-	// Try to find some threads for the software renderer.
-	// They should be in the same cluster as the main GS thread. If they're not, for example,
-	// we had 4 P cores and 6 E cores, let the OS schedule them instead.
-	s_software_renderer_processor_list.reserve(s_processor_list.size() - (mtvu ? 3 : 2));
-	const u32 gs_cluster_id = cpuinfo_get_processor(gs_index)->cluster->cluster_id;
-	for (size_t i = mtvu ? 3 : 2; i < s_processor_list.size(); i++)
+	// The software renderer gets the remaining cores, ones sharing the GS thread's cache first since they
+	// read the same local memory. Slower cores and other cache domains are fine now that idle workers
+	// steal scanlines from busy ones.
+	s_software_renderer_processor_list.clear();
+	s_software_renderer_processor_list.reserve(s_processor_list.size() - main_threads);
+	for (size_t i = main_threads; i < s_processor_list.size(); i++)
 	{
-		const u32 proc_index = s_processor_list[i];
-		const u32 proc_cluster_id = cpuinfo_get_processor(proc_index)->cluster->cluster_id;
-		if (proc_cluster_id != gs_cluster_id)
-		{
-			WARNING_LOG("  Only using {} SW threads, processor {} is in cluster {}, but the GS thread is in cluster {}",
-				s_software_renderer_processor_list.size(), proc_index, proc_cluster_id, gs_cluster_id);
-			break;
-		}
-
-		s_software_renderer_processor_list.push_back(proc_index);
+		if (s_processor_list[i].cache_domain == gs_proc.cache_domain)
+			s_software_renderer_processor_list.push_back(s_processor_list[i].id);
 	}
+	const size_t near_gs_count = s_software_renderer_processor_list.size();
+	for (size_t i = main_threads; i < s_processor_list.size(); i++)
+	{
+		if (s_processor_list[i].cache_domain != gs_proc.cache_domain)
+			s_software_renderer_processor_list.push_back(s_processor_list[i].id);
+	}
+
+	INFO_LOG("  {} processors available for SW threads, {} sharing a cache with the GS thread.",
+		s_software_renderer_processor_list.size(), near_gs_count);
 }
 
 const std::vector<u32>& VMManager::Internal::GetSoftwareRendererProcessorList()
@@ -3654,6 +3926,26 @@ void VMManager::ReloadPINE()
 		PINEServer::Initialize(EmuConfig.PINESlot);
 }
 
+void VMManager::ReloadSharedSnapshot()
+{
+	const u32 width = static_cast<u32>(std::max(EmuConfig.SharedSnapshotWidth, 0));
+	const u32 height = static_cast<u32>(std::max(EmuConfig.SharedSnapshotHeight, 0));
+	if (!EmuConfig.EnableSharedSnapshot)
+	{
+		SharedSnapshot::Deinitialize();
+		return;
+	}
+
+	if (SharedSnapshot::NeedsReinitialize(EmuConfig.PINESlot, width, height, EmuConfig.SharedSnapshotRanges))
+		SharedSnapshot::Initialize(EmuConfig.PINESlot, width, height, EmuConfig.SharedSnapshotRanges);
+}
+
+void VMManager::ReloadCDVDReadProfile()
+{
+	const bool enabled = EmuConfig.CdvdReadPrediction && CDVDsys_GetSourceType() == CDVD_SourceType::Iso;
+	ISOsetReadProfile(enabled ? s_disc_serial : std::string());
+}
+
 void VMManager::InitializeDiscordPresence()
 {
 	if (s_discord_presence_active)
@@ -267,6 +267,9 @@ namespace VMManager
 		/// Disables fast boot if it was requested, and found to be incompatible.
 		void DisableFastBoot();
 
+		/// Saves the machine state on EELOAD's first entry for later fast boots with the same BIOS, if enabled.
+		void SaveFastBootSnapshotOnCPUThread();
+
 		/// Returns true if the current ELF has started executing.
 		bool HasBootedELF();
 
@@ -279,6 +282,9 @@ namespace VMManager
 		/// Throttles execution, or limits the frame rate.
 		void Throttle();
 
+		/// Holds off the start of the next frame when reducing input latency, so input is polled closer to the deadline.
+		void DelayFrameStart();
+
 		/// Resets/clears all execution/code caches.
 		void ClearCPUExecutionCaches();
 
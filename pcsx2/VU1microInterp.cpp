@@ -29,6 +29,32 @@ void _vu1ExecLower(VURegs* VU, u32* ptr)
 
 int vu1branch = 0;
 
+static VUDecodedPair s_vu1_decoded[VU1_PROGSIZE / 8];
+
+static __fi const VUDecodedPair& _vu1Decode(VURegs* VU, const u32* ptr, u32 pc)
+{
+	VUDecodedPair& pair = s_vu1_decoded[(pc >> 3) & (std::size(s_vu1_decoded) - 1)];
+	const u64 code = (static_cast<u64>(ptr[1]) << 32) | ptr[0];
+	if (pair.valid && pair.code == code) [[likely]]
+		return pair;
+
+	pair = {};
+	pair.code = code;
+	pair.valid = true;
+
+	VU->code = ptr[1];
+	VU1regs_UPPER_OPCODE[VU->code & 0x3f](&pair.uregs);
+
+	// With the I flag set the lower word is a float constant, not an instruction.
+	if (!(ptr[1] & 0x80000000))
+	{
+		VU->code = ptr[0];
+		VU1regs_LOWER_OPCODE[VU->code >> 25](&pair.lregs);
+	}
+
+	return pair;
+}
+
 static void _vu1Exec(VURegs* VU)
 {
 	_VURegsNum lregs;
@@ -36,6 +62,7 @@ static void _vu1Exec(VURegs* VU)
 	u32* ptr;
 
 	ptr = (u32*)&VU->Micro[VU->VI[REG_TPC].UL];
+	const VUDecodedPair& decoded = _vu1Decode(VU, ptr, VU->VI[REG_TPC].UL);
 	VU->VI[REG_TPC].UL += 8;
 
 	if (ptr[1] & 0x40000000) // E flag
@@ -64,7 +91,7 @@ static void _vu1Exec(VURegs* VU)
 	//VUM_LOG("VU->cycle = %d (flags st=%x;mac=%x;clip=%x,q=%f)", VU->cycle, VU->statusflag, VU->macflag, VU->clipflag, VU->q.F);
 
 	VU->code = ptr[1];
-	VU1regs_UPPER_OPCODE[VU->code & 0x3f](&uregs);
+	uregs = decoded.uregs;
 
 	u32 cyclesBeforeOp = VU1.cycle-1;
 
@@ -96,8 +123,7 @@ static void _vu1Exec(VURegs* VU)
 		int discard = 0;
 
 		VU->code = ptr[0];
-		lregs.cycles = 0;
-		VU1regs_LOWER_OPCODE[VU->code >> 25](&lregs);
+		lregs = decoded.lregs;
 
 		_vuTestLowerStalls(VU, &lregs);
 		_vuTestPipes(VU);
@@ -18,6 +18,17 @@ struct _VURegsNum {
 	int cycles;
 };
 
+// Register usage of an upper/lower instruction pair. It only depends on the instruction words, so the
+// interpreters cache it per micro memory slot, keyed on the words so any kind of write to micro memory
+// (VIF MPG, savestates, the debugger) is picked up without having to be tracked.
+struct VUDecodedPair
+{
+	u64 code;
+	bool valid;
+	_VURegsNum uregs;
+	_VURegsNum lregs;
+};
+
 using FnPtr_VuVoid = void (*)();
 using FnPtr_VuRegsN = void(*)(_VURegsNum *VUregsn);
 
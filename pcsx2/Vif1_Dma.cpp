@@ -420,6 +420,11 @@ __fi void vif1Interrupt()
 
 		if ((vif1.inprogress & 0x1) == 0)
 			vif1SetupTransfer();
+
+		// Transfer the tag's data right away instead of in the next event.
+		if ((vif1.inprogress & 0x1) && !vif1.waitforvu && !vif1Regs.stat.VGW && dmacCanBatchTransfer(DMAC_VIF1))
+			_VIF1chain();
+
 		if (vif1ch.chcr.DIR)
 			vif1Regs.stat.FQC = std::min(vif1ch.qwc, (u32)16);
 
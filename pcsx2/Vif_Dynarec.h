@@ -13,6 +13,7 @@ typedef void (*nVifrecCall)(uptr dest, uptr src);
 extern void _nVifUnpack(int idx, const u8* data, uint mode, bool isFill);
 extern void dVifReset(int idx);
 extern void dVifRelease(int idx);
+extern void dVifPrecompile(int idx, const nVifBlock& key);
 extern void VifUnpackSSE_Init();
 
 _vifT extern void dVifUnpack(const u8* data, bool isFill);
@@ -33,12 +34,21 @@ struct nVifStruct
 
 	HashBucket              vifBlocks;   // Vif Blocks
 
+	// Lookup statistics since the last reset of vifBlocks
+	u64                     blockHits;
+	u64                     blockMisses;
+	u32                     blockCompiles;
 
 	nVifStruct() = default;
 };
 
 extern void resetNewVif(int idx);
 
+// Unpack cache: remembers the unpack configurations a game used, and compiles them when it boots again
+extern void dVifRetireBlocks(int idx);
+extern void dVifOpenUnpackCache(int idx);
+extern void dVifCloseUnpackCache(int idx);
+
 alignas(16) extern nVifStruct nVif[2];
 alignas(16) extern nVifCall nVifUpk[(2 * 2 * 16) * 4]; // ([USN][Masking][Unpack Type]) [curCycle]
 alignas(16) extern u32      nVifMask[3][4][4];         // [MaskNumber][CycleNumber][Vector]
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <bit>
 #include "common/AlignedMalloc.h"
 
 // nVifBlock - Ordered for Hashing; the 'num' and 'upkType' fields are
@@ -50,11 +51,16 @@ class HashBucket
 {
 protected:
 	std::array<nVifBlock*, hSize> m_bucket;
+	std::array<u16, hSize> m_size; // Blocks in each chain, not counting the empty cell
+
+	// Chains grow in powers of two, so inserting doesn't reallocate every time
+	static __fi u32 chain_capacity(u32 size) { return std::bit_ceil(size + 1); }
 
 public:
 	HashBucket()
 	{
 		m_bucket.fill(nullptr);
+		m_size.fill(0);
 	}
 
 	~HashBucket() { clear(); }
@@ -79,42 +85,47 @@ public:
 	{
 		u32 b = dataPtr.hash_key;
 
-		u32 size = bucket_size(dataPtr);
+		u32 size = m_size[b];
 
 		// Warning there is an extra +1 due to the empty cell
 		// Performance note: 64B align to reduce cache miss penalty in `find`
-		if ((m_bucket[b] = (nVifBlock*)pcsx2_aligned_realloc(m_bucket[b], sizeof(nVifBlock) * (size + 2), 64, sizeof(nVifBlock) * (size + 1))) == NULL)
+		if ((size + 2) > chain_capacity(size))
 		{
-			pxFailRel("Failed to allocate HashBucket Chain");
+			if ((m_bucket[b] = (nVifBlock*)pcsx2_aligned_realloc(m_bucket[b], sizeof(nVifBlock) * chain_capacity(size + 1), 64, sizeof(nVifBlock) * (size + 1))) == NULL)
+			{
+				pxFailRel("Failed to allocate HashBucket Chain");
+			}
 		}
 
 		// Replace the empty cell by the new block and create a new empty cell
 		memcpy(&m_bucket[b][size++], &dataPtr, sizeof(nVifBlock));
 		memset(&m_bucket[b][size], 0, sizeof(nVifBlock));
+		m_size[b] = static_cast<u16>(size);
 
 		if (size > 3)
 			DevCon.Warning("recVifUnpk: Bucket 0x%04x has %d micro-programs", b, size);
 	}
 
-	u32 bucket_size(const nVifBlock& dataPtr)
+	u32 bucket_size(const nVifBlock& dataPtr) const
 	{
-		nVifBlock* chainpos = m_bucket[dataPtr.hash_key];
-
-		u32 size = 0;
+		return m_size[dataPtr.hash_key];
+	}
 
-		while (chainpos->startPtr != 0)
+	template <typename F>
+	void for_each(const F& func) const
+	{
+		for (u32 b = 0; b < hSize; b++)
 		{
-			size++;
-			chainpos++;
+			for (u32 i = 0; i < m_size[b]; i++)
+				func(m_bucket[b][i]);
 		}
-
-		return size;
 	}
 
 	void clear()
 	{
 		for (auto& bucket : m_bucket)
 			safe_aligned_free(bucket);
+		m_size.fill(0);
 	}
 
 	void reset()
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "MTVU.h"
 #include "Vif_Dma.h"
 #include "Vif_Dynarec.h"
 
@@ -64,6 +65,10 @@ _vifT static __fi bool vifTransfer(u32 *data, int size, bool TTE) {
 	vifX.vifpacketsize = size;
 	vifTransferLoop<idx>(data);
 
+	// Hand everything this packet queued up for MTVU over in one go.
+	if (idx && THREAD_VU1)
+		vu1Thread.Flush();
+
 	transferred += size - vifX.vifpacketsize;
 
 	//Make this a minimum of 1 cycle so if it's the end of the packet it doesnt just fall through.
@@ -6,35 +6,44 @@
 #include "Vif_Dma.h"
 #include "Vif_Dynarec.h"
 #include "MTVU.h"
+#include "VMManager.h"
+#include "GS/GSVector.h"
 
-enum UnpackOffset {
-	OFFSET_X = 0,
-	OFFSET_Y = 1,
-	OFFSET_Z = 2,
-	OFFSET_W = 3
-};
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <tuple>
 
-static __fi u32 setVifRow(vifStruct& vif, u32 reg, u32 data) {
-	vif.MaskRow._u32[reg] = data;
-	return data;
+static __fi GSVector4i getVifMaskLanes(u32 mask, u32 cl)
+{
+	const u32 m = mask >> (std::min<u32>(cl, 3) * 8);
+	return GSVector4i(m, m >> 2, m >> 4, m >> 6) & GSVector4i(3);
 }
 
+// Writes one vector, all four fields at once.
 // cycle derives from vif.cl
 // mode derives from vifRegs.mode
 template< uint idx, uint mode, bool doMask >
-static __ri void writeXYZW(u32 offnum, u32 &dest, u32 data) {
-	int n = 0;
-
+static __ri void writeXYZW(u32* dest, const GSVector4i& data) {
 	vifStruct& vif = MTVU_VifX;
 
-	if (doMask) {
-		const VIFregisters& regs = MTVU_VifXRegs;
-		switch (vif.cl) {
-			case 0:  n = (regs.mask >> (offnum * 2)) & 0x3;		break;
-			case 1:  n = (regs.mask >> ( 8 + (offnum * 2))) & 0x3;	break;
-			case 2:  n = (regs.mask >> (16 + (offnum * 2))) & 0x3;	break;
-			default: n = (regs.mask >> (24 + (offnum * 2))) & 0x3;	break;
-		}
+	const GSVector4i row = GSVector4i::load<true>(&vif.MaskRow);
+	GSVector4i value;
+	switch (mode) {
+		case 1:  value = data.add32(row); break;
+		case 2:  value = row.add32(data); break;
+		default: value = data; break;
+	}
+
+	if (!doMask) {
+		if (mode == 2 || mode == 3)
+			GSVector4i::store<true>(&vif.MaskRow, value);
+		GSVector4i::store<true>(dest, value);
+		return;
 	}
 
 	// Four possible types of masking are handled below:
@@ -42,33 +51,34 @@ static __ri void writeXYZW(u32 offnum, u32 &dest, u32 data) {
 	//   1 - MaskRow
 	//   2 - MaskCol
 	//   3 - Write protect
-
-	switch (n) {
-		case 0:
-			switch (mode) {
-				case 1:  dest = data + vif.MaskRow._u32[offnum]; break;
-				case 2:  dest = setVifRow(vif, offnum, vif.MaskRow._u32[offnum] + data); break;
-				case 3:  dest = setVifRow(vif, offnum, data); break;
-				default: dest = data; break;
-			}
-			break;
-		case 1: dest = vif.MaskRow._u32[offnum]; break;
-		case 2: dest = vif.MaskCol._u32[std::min(vif.cl,3)]; break;
-		case 3: break;
-	}
+	const GSVector4i n = getVifMaskLanes(MTVU_VifXRegs.mask, vif.cl);
+	const GSVector4i is_data = n.eq32(GSVector4i::zero());
+	const GSVector4i col = GSVector4i(static_cast<int>(vif.MaskCol._u32[std::min(vif.cl, 3)]));
+
+	// The row only takes the fields which were written with data.
+	if (mode == 2 || mode == 3)
+		GSVector4i::store<true>(&vif.MaskRow, row.blend8(value, is_data));
+
+	GSVector4i result = GSVector4i::load<true>(dest);
+	result = result.blend8(value, is_data);
+	result = result.blend8(row, n.eq32(GSVector4i(1)));
+	result = result.blend8(col, n.eq32(GSVector4i(2)));
+	GSVector4i::store<true>(dest, result);
 }
 #define tParam idx,mode,doMask
 
+// Source elements are widened the same way the scalar assignment to u32 did, sign extending the signed types.
+template <class T>
+static __fi int vifElem(const T* src, int i)
+{
+	return static_cast<int>(static_cast<u32>(src[i]));
+}
+
 template < uint idx, uint mode, bool doMask, class T >
 static void UNPACK_S(u32* dest, const T* src)
 {
-	u32 data = *src;
-
 	//S-# will always be a complete packet, no matter what. So we can skip the offset bits
-	writeXYZW<tParam>(OFFSET_X, *(dest+0), data);
-	writeXYZW<tParam>(OFFSET_Y, *(dest+1), data);
-	writeXYZW<tParam>(OFFSET_Z, *(dest+2), data);
-	writeXYZW<tParam>(OFFSET_W, *(dest+3), data);
+	writeXYZW<tParam>(dest, GSVector4i(vifElem(src, 0)));
 }
 
 // The PS2 console actually writes v1v0v1v0 for all V2 unpacks -- the second v1v0 pair
@@ -76,10 +86,9 @@ static void UNPACK_S(u32* dest, const T* src)
 template < uint idx, uint mode, bool doMask, class T >
 static void UNPACK_V2(u32* dest, const T* src)
 {
-	writeXYZW<tParam>(OFFSET_X, *(dest+0), *(src+0));
-	writeXYZW<tParam>(OFFSET_Y, *(dest+1), *(src+1));
-	writeXYZW<tParam>(OFFSET_Z, *(dest+2), *(src+0));
-	writeXYZW<tParam>(OFFSET_W, *(dest+3), *(src+1));
+	const int x = vifElem(src, 0);
+	const int y = vifElem(src, 1);
+	writeXYZW<tParam>(dest, GSVector4i(x, y, x, y));
 }
 
 // V3 and V4 unpacks both use the V4 unpack logic, even though most of the OFFSET_W fields
@@ -88,22 +97,17 @@ static void UNPACK_V2(u32* dest, const T* src)
 template < uint idx, uint mode, bool doMask, class T >
 static void UNPACK_V4(u32* dest, const T* src)
 {
-	writeXYZW<tParam>(OFFSET_X, *(dest+0), *(src+0));
-	writeXYZW<tParam>(OFFSET_Y, *(dest+1), *(src+1));
-	writeXYZW<tParam>(OFFSET_Z, *(dest+2), *(src+2));
-	writeXYZW<tParam>(OFFSET_W, *(dest+3), *(src+3));
+	writeXYZW<tParam>(dest, GSVector4i(vifElem(src, 0), vifElem(src, 1), vifElem(src, 2), vifElem(src, 3)));
 }
 
 // V4_5 unpacks do not support the MODE register, and act as mode==0 always.
 template< uint idx, bool doMask >
 static void UNPACK_V4_5(u32 *dest, const u32* src)
 {
-	u32 data = *src;
-
-	writeXYZW<idx,0,doMask>(OFFSET_X, *(dest+0),	((data & 0x001f) << 3));
-	writeXYZW<idx,0,doMask>(OFFSET_Y, *(dest+1),	((data & 0x03e0) >> 2));
-	writeXYZW<idx,0,doMask>(OFFSET_Z, *(dest+2),	((data & 0x7c00) >> 7));
-	writeXYZW<idx,0,doMask>(OFFSET_W, *(dest+3),	((data & 0x8000) >> 8));
+	const u32 data = *src;
+	const GSVector4i v = GSVector4i(static_cast<int>(data << 3), static_cast<int>(data >> 2), static_cast<int>(data >> 7),
+		static_cast<int>(data >> 8)) & GSVector4i(0xf8, 0xf8, 0xf8, 0x80);
+	writeXYZW<idx,0,doMask>(dest, v);
 }
 
 // =====================================================================================================
@@ -308,7 +312,188 @@ void resetNewVif(int idx)
 	std::memset(nVif[idx].buffer, 0, sizeof(nVif[idx].buffer));
 
 	if (newVifDynaRec)
+	{
 		dVifReset(idx);
+		dVifOpenUnpackCache(idx);
+	}
+}
+
+// ----------------------------------------------------------------------------
+//  Unpack Cache
+// ----------------------------------------------------------------------------
+// The generated routines embed host addresses, so only the block keys are stored. Each key
+// fully describes its routine, and they are compiled again when the game boots.
+
+namespace
+{
+#pragma pack(push, 1)
+	struct UnpackCacheHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 num_unpacks;
+	};
+
+	struct UnpackCacheRecord
+	{
+		u16 hash_key;
+		u32 key0;
+		u32 key1;
+
+		bool operator<(const UnpackCacheRecord& rhs) const
+		{
+			return std::tie(hash_key, key0, key1) < std::tie(rhs.hash_key, rhs.key0, rhs.key1);
+		}
+		bool operator==(const UnpackCacheRecord& rhs) const
+		{
+			return (hash_key == rhs.hash_key && key0 == rhs.key0 && key1 == rhs.key1);
+		}
+	};
+#pragma pack(pop)
+} // namespace
+
+static constexpr u32 UNPACK_CACHE_MAGIC = 0x4B505556; // VUPK
+static constexpr u32 UNPACK_CACHE_VERSION = 1;
+static constexpr u32 UNPACK_CACHE_MAX_UNPACKS = 16384;
+
+static std::string s_unpack_cache_path[2];
+static std::vector<UnpackCacheRecord> s_unpack_cache[2];
+
+static std::string dVifGetUnpackCachePath(int idx)
+{
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (serial.empty() && crc == 0)
+		return {};
+
+	return Path::Combine(EmuFolders::Cache, fmt::format("vif{}_unpacks_{}_{:08X}.bin", idx, serial.empty() ? "NOSERIAL" : serial, crc));
+}
+
+static void dVifSortUnpacks(std::vector<UnpackCacheRecord>& unpacks)
+{
+	std::sort(unpacks.begin(), unpacks.end());
+	unpacks.erase(std::unique(unpacks.begin(), unpacks.end()), unpacks.end());
+	if (unpacks.size() > UNPACK_CACHE_MAX_UNPACKS)
+		unpacks.resize(UNPACK_CACHE_MAX_UNPACKS);
+}
+
+static void dVifReadUnpackCache(int idx)
+{
+	std::vector<UnpackCacheRecord>& unpacks = s_unpack_cache[idx];
+	unpacks.clear();
+
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_unpack_cache_path[idx].c_str());
+	if (!data.has_value())
+		return;
+
+	UnpackCacheHeader header;
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != UNPACK_CACHE_MAGIC || header.version != UNPACK_CACHE_VERSION ||
+		header.num_unpacks > UNPACK_CACHE_MAX_UNPACKS ||
+		(data->size() - sizeof(header)) < (header.num_unpacks * sizeof(UnpackCacheRecord)))
+	{
+		Console.Warning("nVif%d: Ignoring invalid unpack cache '%s'", idx, s_unpack_cache_path[idx].c_str());
+		return;
+	}
+
+	unpacks.resize(header.num_unpacks);
+	std::memcpy(unpacks.data(), data->data() + sizeof(header), header.num_unpacks * sizeof(UnpackCacheRecord));
+	dVifSortUnpacks(unpacks);
+}
+
+static void dVifWriteUnpackCache(int idx)
+{
+	const std::vector<UnpackCacheRecord>& unpacks = s_unpack_cache[idx];
+	if (s_unpack_cache_path[idx].empty() || unpacks.empty())
+		return;
+
+	const UnpackCacheHeader header = {UNPACK_CACHE_MAGIC, UNPACK_CACHE_VERSION, static_cast<u32>(unpacks.size())};
+
+	std::vector<u8> data(sizeof(header) + unpacks.size() * sizeof(UnpackCacheRecord));
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), unpacks.data(), unpacks.size() * sizeof(UnpackCacheRecord));
+
+	if (!FileSystem::WriteBinaryFile(s_unpack_cache_path[idx].c_str(), data.data(), data.size()))
+	{
+		Console.Error("nVif%d: Failed to write unpack cache '%s'", idx, s_unpack_cache_path[idx].c_str());
+		return;
+	}
+
+	DevCon.WriteLn("nVif%d: Wrote %zu unpacks to '%s'", idx, unpacks.size(), s_unpack_cache_path[idx].c_str());
+}
+
+void dVifRetireBlocks(int idx)
+{
+	nVifStruct& v = nVif[idx];
+	if (v.blockHits || v.blockMisses || v.blockCompiles)
+	{
+		DevCon.WriteLn("nVif%d: %" PRIu64 " block hits, %" PRIu64 " misses, %u blocks compiled",
+			idx, v.blockHits, v.blockMisses, v.blockCompiles);
+	}
+
+	v.blockHits = 0;
+	v.blockMisses = 0;
+	v.blockCompiles = 0;
+
+	if (s_unpack_cache_path[idx].empty())
+		return;
+
+	std::vector<UnpackCacheRecord>& unpacks = s_unpack_cache[idx];
+	v.vifBlocks.for_each([&unpacks](const nVifBlock& block) {
+		unpacks.push_back({block.hash_key, block.key0, block.key1});
+	});
+	dVifSortUnpacks(unpacks);
+}
+
+void dVifOpenUnpackCache(int idx)
+{
+	dVifCloseUnpackCache(idx);
+	if (!EmuConfig.Cpu.Recompiler.EnableVIFUnpackCache)
+		return;
+
+	s_unpack_cache_path[idx] = dVifGetUnpackCachePath(idx);
+	if (s_unpack_cache_path[idx].empty())
+		return;
+
+	dVifReadUnpackCache(idx);
+	if (s_unpack_cache[idx].empty())
+		return;
+
+	Common::Timer timer;
+	nVifStruct& v = nVif[idx];
+
+	// Leave at least half of the code buffer for unpacks which are discovered during gameplay.
+	const u8* preload_end = v.recWritePtr + (v.recEndPtr - v.recWritePtr) / 2;
+
+	u32 compiled = 0;
+	for (const UnpackCacheRecord& record : s_unpack_cache[idx])
+	{
+		if (v.recWritePtr >= preload_end)
+			break;
+
+		nVifBlock block = {};
+		block.hash_key = record.hash_key;
+		block.key0 = record.key0;
+		block.key1 = record.key1;
+		dVifPrecompile(idx, block);
+		compiled++;
+	}
+
+	Console.WriteLn(Color_Orange, "nVif%d: Precompiled %u unpacks in %.2f ms", idx, compiled, timer.GetTimeMilliseconds());
+}
+
+void dVifCloseUnpackCache(int idx)
+{
+	if (s_unpack_cache_path[idx].empty())
+		return;
+
+	dVifRetireBlocks(idx);
+	dVifWriteUnpackCache(idx);
+	s_unpack_cache_path[idx] = {};
+	s_unpack_cache[idx] = {};
 }
 
 void releaseNewVif(int idx)
@@ -8,6 +8,15 @@
 
 #include "common/Assertions.h"
 
+// There are no EE, IOP or VU recompilers for ARM64 yet, so the CPU providers
+// in VMManager fall back to the interpreters on this host. Anything that only
+// exists for the x86 recs is stubbed out here. Once they are ported, a backend
+// needs to take over:
+//  - iR5900/iR3000A: block dispatch through recLUT and BaseBlocks, plus the
+//    load/store fastmem backpatching below.
+//  - microVU: its microRegInfo state, which vuJITFreeze() writes as zeros for
+//    now so save states stay compatible with x86 builds.
+
 void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr)
 {
   pxFailRel("Not implemented.");
@@ -22,6 +22,10 @@ extern mem32_t _hwRead32(u32 mem);
 extern mem16_t hwRead16_page_0F_INTC_HACK(u32 mem);
 extern mem32_t hwRead32_page_0F_INTC_HACK(u32 mem);
 
+// Returns true if a 32 bit read of the given physical address always returns the raw eeHw
+// contents, which lets the recompiler load constant address registers without calling out.
+extern bool hwIsDirectRead32(u32 mem);
+
 
 // hw write functions
 template<uint page> extern void hwWrite8  (u32 mem, u8  value);
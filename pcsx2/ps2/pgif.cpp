@@ -305,6 +305,30 @@ void rb_gp0_Get(u32* data)
 	}
 }
 
+// Copies a run of words straight from IOP RAM into the ring buffer, as many as fit without wrapping
+// and without going over PGIF_DAT_RB_LEAVE_FREE. This avoids an iopMemRead32() and ringBufPut() per word.
+// Returns 0 when the source isn't plain RAM or the FIFO is full, the caller then falls back to single words.
+static u32 ringBufPutFromIopRam(struct ringBuf_t* rb, u32 addr, u32 words)
+{
+	if ((addr & 3) != 0 || addr >= Ps2MemSize::IopRam)
+		return 0;
+
+	const int free = rb->size - PGIF_DAT_RB_LEAVE_FREE - rb->count;
+	if (free <= 0)
+		return 0;
+
+	words = std::min({words, static_cast<u32>(free), static_cast<u32>(rb->size - rb->head), (Ps2MemSize::IopRam - addr) / 4});
+	if (words == 0)
+		return 0;
+
+	std::memcpy(rb->buf + rb->head, iopPhysMem(addr), words * sizeof(u32));
+	rb->head += words;
+	if (rb->head >= rb->size)
+		rb->head = 0; //wrap back when the end is reached
+	rb->count += words;
+	return words;
+}
+
 //PS1 GPU registers I/O handlers:
 
 void psxGPUw(int addr, u32 data)
@@ -544,6 +568,13 @@ void drainPgpuDmaLl()
 			dma.ll_dma.next_address = dmaRegs.madr.address;
 		}
 	}
+	else if (const u32 copied = ringBufPutFromIopRam(&rb_gp0, dma.ll_dma.data_read_address, dma.ll_dma.total_words - dma.ll_dma.current_word))
+	{
+		//We are in the middle of linked list transfer, and the rest of the packet is in RAM
+		PGPU_DMA_LOG("PGPU LL DMA %u words  addr %08X ", copied, dma.ll_dma.data_read_address);
+		dma.ll_dma.data_read_address += copied * 4;
+		dma.ll_dma.current_word += copied;
+	}
 	else
 	{
 		//We are in the middle of linked list transfer
@@ -564,7 +595,26 @@ void drainPgpuDmaNrToGpu()
 	if (rb_gp0.count >= ((rb_gp0.size) - PGIF_DAT_RB_LEAVE_FREE))
 		return;
 
-	if (dma.normal.current_word < dma.normal.total_words)
+	const u32 block_size = dmaRegs.bcr.bit.block_size;
+	const u32 copied = (dma.normal.current_word < dma.normal.total_words && block_size != 0) ?
+		ringBufPutFromIopRam(&rb_gp0, dma.normal.address, dma.normal.total_words - dma.normal.current_word) : 0;
+
+	if (copied > 0)
+	{
+		PGPU_DMA_LOG("To GPU Normal DMA %u words  addr %08X ", copied, dma.normal.address);
+		if (dmaRegs.chcr.bits.MAS)
+		{
+			DevCon.Error("Unimplemented backward memory step on TO GPU DMA");
+		}
+
+		// decrease block amount once for every full block drained.
+		const u32 blocks_before = dma.normal.current_word / block_size;
+		dmaRegs.madr.address += copied * 4;
+		dma.normal.address += copied * 4;
+		dma.normal.current_word += copied;
+		dmaRegs.bcr.bit.block_amount -= (dma.normal.current_word / block_size) - blocks_before;
+	}
+	else if (dma.normal.current_word < dma.normal.total_words)
 	{
 		u32 data = iopMemRead32(dma.normal.address);
 		PGPU_DMA_LOG( "To GPU Normal DMA data= %08X  addr %08X ", data, dma.ll_dma.data_read_address);
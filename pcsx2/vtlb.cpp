@@ -23,6 +23,7 @@
 #include "IopMem.h"
 #include "Host.h"
 #include "VMManager.h"
+#include "DebugTools/Breakpoints.h"
 
 #include "common/BitUtils.h"
 #include "common/Error.h"
@@ -31,6 +32,7 @@
 
 #include "GS/GSVector.h"
 
+#include <atomic>
 #include <bit>
 #include <map>
 #include <unordered_set>
@@ -64,6 +66,7 @@ struct FastmemVirtualMapping
 struct LoadstoreBackpatchInfo
 {
 	u32 guest_pc;
+	u32 block_pc;
 	u32 gpr_bitmask;
 	u32 fpr_bitmask;
 	u8 code_size;
@@ -84,6 +87,18 @@ static std::vector<u32> s_fastmem_virtual_mapping; // maps vaddr -> mainmem offs
 static std::unordered_multimap<u32, u32> s_fastmem_physical_mapping; // maps mainmem offset -> vaddr
 static std::unordered_map<uptr, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
+static std::unordered_map<u32, u32> s_fastmem_block_faults; // maps block start pc -> faults in the block
+
+// Once a block has faulted this many times it's likely doing MMIO through a pointer, so rather than
+// taking a signal for every loadstore in it, the whole block gets recompiled with slowmem.
+static constexpr u32 FASTMEM_BLOCK_FAULT_THRESHOLD = 3;
+
+static std::atomic<u32> s_fastmem_fault_count{0};
+
+// Main memory pages (as offsets) which contain an EE memcheck, mapped to whether reads need to fault too.
+static std::unordered_map<u32, bool> s_memcheck_pages;
+static bool s_memcheck_protection_active = false;
+static std::atomic<u32> s_fastmem_slow_block_count{0};
 
 vtlb_private::VTLBPhysical vtlb_private::VTLBPhysical::fromPointer(sptr ptr)
 {
@@ -169,27 +184,24 @@ DataType vtlb_memRead(u32 addr)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(addr))
 		{
-			if (CHECK_CACHE && CheckCache(addr))
+			switch (DataSize)
 			{
-				switch (DataSize)
-				{
-					case 8:
-						return readCache8(addr);
-						break;
-					case 16:
-						return readCache16(addr);
-						break;
-					case 32:
-						return readCache32(addr);
-						break;
-					case 64:
-						return readCache64(addr);
-						break;
-
-						jNO_DEFAULT;
-				}
+				case 8:
+					return readCache8(addr);
+					break;
+				case 16:
+					return readCache16(addr);
+					break;
+				case 32:
+					return readCache32(addr);
+					break;
+				case 64:
+					return readCache64(addr);
+					break;
+
+					jNO_DEFAULT;
 			}
 		}
 
@@ -224,12 +236,9 @@ RETURNS_R128 vtlb_memRead128(u32 mem)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(mem))
 		{
-			if (CHECK_CACHE && CheckCache(mem))
-			{
-				return readCache128(mem);
-			}
+			return readCache128(mem);
 		}
 
 		return r128_load(reinterpret_cast<const void*>(vmv.assumePtr(mem)));
@@ -252,25 +261,22 @@ void vtlb_memWrite(u32 addr, DataType data)
 
 	if (!vmv.isHandler(addr))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(addr))
 		{
-			if (CHECK_CACHE && CheckCache(addr))
+			switch (DataSize)
 			{
-				switch (DataSize)
-				{
-					case 8:
-						writeCache8(addr, data);
-						return;
-					case 16:
-						writeCache16(addr, data);
-						return;
-					case 32:
-						writeCache32(addr, data);
-						return;
-					case 64:
-						writeCache64(addr, data);
-						return;
-				}
+				case 8:
+					writeCache8(addr, data);
+					return;
+				case 16:
+					writeCache16(addr, data);
+					return;
+				case 32:
+					writeCache32(addr, data);
+					return;
+				case 64:
+					writeCache64(addr, data);
+					return;
 			}
 		}
 
@@ -291,14 +297,11 @@ void TAKES_R128 vtlb_memWrite128(u32 mem, r128 value)
 
 	if (!vmv.isHandler(mem))
 	{
-		if (!CHECK_EEREC)
+		if (CHECK_CACHE && CheckCache(mem))
 		{
-			if (CHECK_CACHE && CheckCache(mem))
-			{
-				alignas(16) const u128 r = r128_to_u128(value);
-				writeCache128(mem, &r);
-				return;
-			}
+			alignas(16) const u128 r = r128_to_u128(value);
+			writeCache128(mem, &r);
+			return;
 		}
 
 		r128_store_unaligned((void*)vmv.assumePtr(mem), value);
@@ -574,7 +577,7 @@ static void TAKES_R128 vtlbUnmappedVWriteLg(u32 addr, r128 data) { vtlb_Miss(add
 template <typename OperandType>
 static OperandType vtlbUnmappedPReadSm(u32 addr) {
 	vtlb_BusError(addr, 0);
-	if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)){
+	if (CHECK_CACHE && CheckCache(addr)){
 		switch (sizeof(OperandType)) {
 			case 1: return readCache8(addr, false);
 			case 2: return readCache16(addr, false);
@@ -585,12 +588,12 @@ static OperandType vtlbUnmappedPReadSm(u32 addr) {
 	}
 	return 0;
 }
-static RETURNS_R128 vtlbUnmappedPReadLg(u32 addr) { vtlb_BusError(addr, 0); if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)){ return readCache128(addr, false); } return r128_zero(); }
+static RETURNS_R128 vtlbUnmappedPReadLg(u32 addr) { vtlb_BusError(addr, 0); if (CHECK_CACHE && CheckCache(addr)){ return readCache128(addr, false); } return r128_zero(); }
 
 template <typename OperandType>
 static void vtlbUnmappedPWriteSm(u32 addr, OperandType data) {
 	vtlb_BusError(addr, 1);
-	if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)) {
+	if (CHECK_CACHE && CheckCache(addr)) {
 		switch (sizeof(OperandType)) {
 			case 1: writeCache8(addr, data, false); break;
 			case 2: writeCache16(addr, data, false); break;
@@ -600,7 +603,7 @@ static void vtlbUnmappedPWriteSm(u32 addr, OperandType data) {
 		}
 	}
 }
-static void TAKES_R128 vtlbUnmappedPWriteLg(u32 addr, r128 data) { vtlb_BusError(addr, 1); if (!CHECK_EEREC && CHECK_CACHE && CheckCache(addr)) { writeCache128(addr, reinterpret_cast<mem128_t*>(&data) /*Safe??*/, false); }}
+static void TAKES_R128 vtlbUnmappedPWriteLg(u32 addr, r128 data) { vtlb_BusError(addr, 1); if (CHECK_CACHE && CheckCache(addr)) { writeCache128(addr, reinterpret_cast<mem128_t*>(&data) /*Safe??*/, false); }}
 // clang-format on
 
 // --------------------------------------------------------------------------------------
@@ -915,6 +918,22 @@ static bool vtlb_GetMainMemoryOffset(u32 paddr, u32* mainmem_offset, u32* mainme
 	return vtlb_GetMainMemoryOffsetFromPtr(vm.raw(), mainmem_offset, mainmem_size, prot);
 }
 
+static PageProtectionMode vtlb_ApplyMemcheckProtection(u32 mainmem_offset, PageProtectionMode prot)
+{
+	if (s_memcheck_pages.empty()) [[likely]]
+		return prot;
+
+	const auto it = s_memcheck_pages.find(mainmem_offset & ~VTLB_PAGE_MASK);
+	if (it == s_memcheck_pages.end())
+		return prot;
+
+	prot.Write(false);
+	if (it->second)
+		prot.Read(false);
+
+	return prot;
+}
+
 static void vtlb_CreateFastmemMapping(u32 vaddr, u32 mainmem_offset, const PageProtectionMode& mode)
 {
 	FASTMEM_LOG("Create fastmem mapping @ vaddr %08X mainmem %08X", vaddr, mainmem_offset);
@@ -953,7 +972,7 @@ static void vtlb_CreateFastmemMapping(u32 vaddr, u32 mainmem_offset, const PageP
 		const u32 host_offset = vtlb_HostAlignOffset(mainmem_offset);
 
 		if (!s_fastmem_area->Map(SysMemory::GetDataFileHandle(), host_offset,
-				s_fastmem_area->PagePointer(host_page), __pagesize, mode))
+				s_fastmem_area->PagePointer(host_page), __pagesize, vtlb_ApplyMemcheckProtection(mainmem_offset, mode)))
 		{
 			Console.Error("Failed to map vaddr %08X to mainmem offset %08X", vtlb_HostAlignOffset(vaddr), host_offset);
 			s_fastmem_virtual_mapping[page] = NO_FASTMEM_MAPPING;
@@ -1084,18 +1103,129 @@ void vtlb_UpdateFastmemProtection(u32 paddr, u32 size, PageProtectionMode prot)
 			FASTMEM_LOG("  valias %08X (size %u)", it->second, VTLB_PAGE_SIZE);
 
 			if (vtlb_IsHostAligned(it->second))
-				HostSys::MemProtect(s_fastmem_area->OffsetPointer(it->second), __pagesize, prot);
+				HostSys::MemProtect(s_fastmem_area->OffsetPointer(it->second), __pagesize, vtlb_ApplyMemcheckProtection(current_mainmem, prot));
+		}
+	}
+}
+
+static void vtlb_ProtectFastmemAliases(u32 mainmem_offset, const PageProtectionMode& prot)
+{
+	auto range = s_fastmem_physical_mapping.equal_range(mainmem_offset);
+	for (auto it = range.first; it != range.second; ++it)
+		HostSys::MemProtect(s_fastmem_area->OffsetPointer(it->second), __pagesize, prot);
+}
+
+static PageProtectionMode vtlb_GetDefaultFastmemProtection(u32 mainmem_offset)
+{
+	const u32 eemem_offset = mainmem_offset - HostMemoryMap::EEmemOffset;
+	if (mainmem_offset >= HostMemoryMap::EEmemOffset && eemem_offset < Ps2MemSize::ExposedRam)
+		return PageProtectionMode().Read().Write(mmap_GetRamPageInfo(eemem_offset) != ProtMode_Write);
+
+	return PageAccess_ReadWrite();
+}
+
+void vtlb_UpdateMemcheckProtection()
+{
+	// Put back whatever protection the previous set of memchecks replaced.
+	std::unordered_map<u32, bool> old_pages = std::move(s_memcheck_pages);
+	s_memcheck_pages.clear();
+	s_memcheck_protection_active = false;
+	for (const auto& [mainmem_offset, needs_read] : old_pages)
+		vtlb_ProtectFastmemAliases(mainmem_offset, vtlb_GetDefaultFastmemProtection(mainmem_offset));
+
+	// Faults are only precise per host page, so fall back to checking every access when they don't match ours.
+	if (!CHECK_FASTMEM || CHECK_CACHE || vtlb_MismatchedHostPageSize() || s_fastmem_virtual_mapping.empty())
+		return;
+
+	const std::vector<MemCheck> checks = CBreakPoints::GetMemChecks(BREAKPOINT_EE);
+	if (checks.empty())
+		return;
+
+	for (const MemCheck& check : checks)
+	{
+		if (check.result == MEMCHECK_IGNORE)
+			continue;
+
+		// Every watched page needs a fastmem mapping, otherwise accesses to it would never fault.
+		const u32 start = standardizeBreakpointAddress(check.start);
+		const u32 end = std::max(standardizeBreakpointAddress(check.end), start + 1);
+		for (u32 page = start / VTLB_PAGE_SIZE; page <= (end - 1) / VTLB_PAGE_SIZE; page++)
+		{
+			if (s_fastmem_virtual_mapping[page] == NO_FASTMEM_MAPPING)
+			{
+				s_memcheck_pages.clear();
+				DevCon.WriteLn("vtlb: Memcheck at %08X is not in fastmem, checking all memory accesses.", page * VTLB_PAGE_SIZE);
+				return;
+			}
+
+			bool& needs_read = s_memcheck_pages[s_fastmem_virtual_mapping[page]];
+			needs_read |= (check.memCond & MEMCHECK_READ) != 0;
 		}
 	}
+
+	for (const auto& [mainmem_offset, needs_read] : s_memcheck_pages)
+		vtlb_ProtectFastmemAliases(mainmem_offset, vtlb_ApplyMemcheckProtection(mainmem_offset, vtlb_GetDefaultFastmemProtection(mainmem_offset)));
+
+	s_memcheck_protection_active = true;
+	DevCon.WriteLn("vtlb: Watching %zu pages for memchecks.", s_memcheck_pages.size());
+}
+
+bool vtlb_IsMemcheckProtectionActive()
+{
+	return s_memcheck_protection_active;
+}
+
+// The faulting access itself goes through the backpatched slowmem path unchecked, so catch it here.
+// The recompiled block is instrumented from then on, but this first hit can only pause at the next event test.
+static void vtlb_CheckMemcheckFault(u32 guest_pc, u32 guest_addr, u32 size, bool is_write)
+{
+	const u32 addr = standardizeBreakpointAddress(guest_addr);
+	std::vector<MemCheck> checks = CBreakPoints::GetMemChecks(BREAKPOINT_EE);
+	for (MemCheck& check : checks)
+	{
+		if (!(check.result & MEMCHECK_BREAK))
+			continue;
+		if (!(check.memCond & (is_write ? MEMCHECK_WRITE : MEMCHECK_READ)))
+			continue;
+
+		const u32 start = standardizeBreakpointAddress(check.start);
+		const u32 end = std::max(standardizeBreakpointAddress(check.end), start + 1);
+		if (addr >= end || start >= addr + size)
+			continue;
+
+		if (check.hasCond && !check.cond.Evaluate())
+			continue;
+
+		if (check.result & MEMCHECK_LOG)
+			DevCon.WriteLn("Hit %s breakpoint @0x%x", is_write ? "store" : "load", guest_pc);
+
+		CBreakPoints::SetBreakpointTriggered(true, BREAKPOINT_EE);
+		VMManager::SetPaused(true);
+		Cpu->ExitExecution();
+		return;
+	}
 }
 
 void vtlb_ClearLoadStoreInfo()
 {
 	s_fastmem_backpatch_info.clear();
 	s_fastmem_faulting_pcs.clear();
+	s_fastmem_block_faults.clear();
+	s_fastmem_slow_block_count.store(0, std::memory_order_relaxed);
+}
+
+void vtlb_ClearLoadStoreInfo(uptr code_start, uptr code_end)
+{
+	for (auto it = s_fastmem_backpatch_info.begin(); it != s_fastmem_backpatch_info.end();)
+	{
+		if (it->first >= code_start && it->first < code_end)
+			it = s_fastmem_backpatch_info.erase(it);
+		else
+			++it;
+	}
 }
 
-void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr)
+void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 block_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr)
 {
 	pxAssert(code_size < std::numeric_limits<u8>::max());
 
@@ -1103,7 +1233,7 @@ void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 g
 	if (iter != s_fastmem_backpatch_info.end())
 		s_fastmem_backpatch_info.erase(iter);
 
-	LoadstoreBackpatchInfo info{guest_pc, gpr_bitmask, fpr_bitmask, static_cast<u8>(code_size), address_register, data_register, size_in_bits, is_signed, is_load, is_fpr};
+	LoadstoreBackpatchInfo info{guest_pc, block_pc, gpr_bitmask, fpr_bitmask, static_cast<u8>(code_size), address_register, data_register, size_in_bits, is_signed, is_load, is_fpr};
 	s_fastmem_backpatch_info.emplace(code_address, info);
 }
 
@@ -1120,6 +1250,8 @@ bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 
 	const LoadstoreBackpatchInfo& info = iter->second;
 	const u32 guest_addr = static_cast<u32>(fault_address - fastmem_start);
+	if (s_memcheck_protection_active)
+		vtlb_CheckMemcheckFault(info.guest_pc, guest_addr, info.size_in_bits / 8, !info.is_load);
 	vtlb_DynBackpatchLoadStore(code_address, info.code_size, info.guest_pc, guest_addr,
 		info.gpr_bitmask, info.fpr_bitmask, info.address_register, info.data_register,
 		info.size_in_bits, info.is_signed, info.is_load, info.is_fpr);
@@ -1128,8 +1260,31 @@ bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 	Cpu->Clear(info.guest_pc, 1);
 
 	// and store the pc in the faulting list, so that we don't emit another fastmem loadstore
+	const u32 block_pc = info.block_pc;
 	s_fastmem_faulting_pcs.insert(info.guest_pc);
 	s_fastmem_backpatch_info.erase(iter);
+	s_fastmem_fault_count.fetch_add(1, std::memory_order_relaxed);
+
+	// if the block keeps faulting, switch every fastmem loadstore in it over at once
+	if (++s_fastmem_block_faults[block_pc] == FASTMEM_BLOCK_FAULT_THRESHOLD)
+	{
+		for (auto it = s_fastmem_backpatch_info.begin(); it != s_fastmem_backpatch_info.end();)
+		{
+			if (it->second.block_pc == block_pc)
+			{
+				s_fastmem_faulting_pcs.insert(it->second.guest_pc);
+				it = s_fastmem_backpatch_info.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		s_fastmem_slow_block_count.fetch_add(1, std::memory_order_relaxed);
+		DevCon.WriteLn("vtlb: Block at 0x%08X faulted %u times, recompiling with slowmem.", block_pc, FASTMEM_BLOCK_FAULT_THRESHOLD);
+	}
+
 	return true;
 }
 
@@ -1138,6 +1293,16 @@ bool vtlb_IsFaultingPC(u32 guest_pc)
 	return (s_fastmem_faulting_pcs.find(guest_pc) != s_fastmem_faulting_pcs.end());
 }
 
+u32 vtlb_GetFastmemFaultCount()
+{
+	return s_fastmem_fault_count.load(std::memory_order_relaxed);
+}
+
+u32 vtlb_GetFastmemSlowBlockCount()
+{
+	return s_fastmem_slow_block_count.load(std::memory_order_relaxed);
+}
+
 //virtual mappings
 //TODO: Add invalid paddr checks
 void vtlb_VMap(u32 vaddr, u32 paddr, u32 size)
@@ -1416,9 +1581,14 @@ struct vtlb_PageProtectionInfo
 	u32 ReverseRamMap;
 
 	vtlb_ProtectionMode Mode;
+
+	// Unique value assigned each time the page enters write protection. Stays constant for
+	// as long as the page is unmodified, so other code can use it to cache page contents.
+	u32 WriteStamp;
 };
 
 alignas(16) static vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::TotalRam >> __pageshift];
+static u32 s_page_write_stamp = 0;
 
 
 // returns:
@@ -1442,6 +1612,31 @@ vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr)
 	return m_PageProtectInfo[rampage].Mode;
 }
 
+// returns:
+//  0 - page isn't under write protection, its contents may change at any time
+//  Or the stamp assigned when the page was protected, which changes once it's written
+//
+u32 mmap_GetRamPageWriteStamp(u32 paddr)
+{
+	if (!eeMem)
+		return 0;
+
+	paddr &= ~0xfff;
+
+	uptr ptr = (uptr)PSM(paddr);
+	uptr rampage = ptr - (uptr)eeMem->Main;
+
+	if (!ptr || rampage >= Ps2MemSize::ExposedRam)
+		return 0;
+
+	rampage >>= __pageshift;
+
+	if (m_PageProtectInfo[rampage].Mode != ProtMode_Write)
+		return 0;
+
+	return m_PageProtectInfo[rampage].WriteStamp;
+}
+
 // paddr - physically mapped PS2 address
 void mmap_MarkCountedRamPage(u32 paddr)
 {
@@ -1466,13 +1661,17 @@ void mmap_MarkCountedRamPage(u32 paddr)
 		paddr >> __pageshift);
 
 	m_PageProtectInfo[rampage].Mode = ProtMode_Write;
+	if (++s_page_write_stamp == 0)
+		s_page_write_stamp = 1;
+	m_PageProtectInfo[rampage].WriteStamp = s_page_write_stamp;
 	HostSys::MemProtect(&eeMem->Main[rampage << __pageshift], __pagesize, PageAccess_ReadOnly());
 	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadOnly());
 }
 
 // offset - offset of address relative to psM.
-// All recompiled blocks belonging to the page are cleared, and any new blocks recompiled
-// from code residing in this page will use manual protection.
+// Recompiled blocks overlapping the written line are cleared, the rest of the page's blocks
+// check their code on entry from now on, and any new blocks recompiled from code residing
+// in this page will use manual protection.
 static __fi void mmap_ClearCpuBlock(uint offset)
 {
 	pxAssert(eeMem);
@@ -1487,7 +1686,7 @@ static __fi void mmap_ClearCpuBlock(uint offset)
 	HostSys::MemProtect(&eeMem->Main[rampage << __pageshift], __pagesize, PageAccess_ReadWrite());
 	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadWrite());
 	m_PageProtectInfo[rampage].Mode = ProtMode_Manual;
-	Cpu->Clear(m_PageProtectInfo[rampage].ReverseRamMap, __pagesize);
+	Cpu->ClearWrittenPage(m_PageProtectInfo[rampage].ReverseRamMap, m_PageProtectInfo[rampage].ReverseRamMap + (offset & __pagemask));
 }
 
 PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exception_pc, void* fault_address, bool is_write)
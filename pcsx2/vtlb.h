@@ -77,10 +77,21 @@ extern void vtlb_UpdateFastmemProtection(u32 paddr, u32 size, PageProtectionMode
 extern bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address);
 
 extern void vtlb_ClearLoadStoreInfo();
-extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
+extern void vtlb_ClearLoadStoreInfo(uptr code_start, uptr code_end);
+extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 block_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern bool vtlb_IsFaultingPC(u32 guest_pc);
 
+/// Write/read protects the fastmem pages containing EE memchecks, so that only accesses which fault need checking.
+/// Returns false from vtlb_IsMemcheckProtectionActive() when some memcheck can't be covered this way.
+extern void vtlb_UpdateMemcheckProtection();
+extern bool vtlb_IsMemcheckProtectionActive();
+
+/// Total number of fastmem faults which were backpatched, and blocks switched to slowmem after repeated faults.
+/// Safe to call from any thread.
+extern u32 vtlb_GetFastmemFaultCount();
+extern u32 vtlb_GetFastmemSlowBlockCount();
+
 //Memory functions
 
 template< typename DataType >
@@ -229,6 +240,7 @@ enum vtlb_ProtectionMode
 };
 
 extern vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr);
+extern u32 mmap_GetRamPageWriteStamp(u32 paddr);
 extern void mmap_MarkCountedRamPage(u32 paddr);
 extern void mmap_ResetBlockTracking();
 
@@ -2,6 +2,18 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "BaseblockEx.h"
+#include "Config.h"
+#include "DebugTools/Debug.h"
+#include "VMManager.h"
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <vector>
 
 BASEBLOCKEX* BaseBlocks::New(u32 startpc, uptr fnptr)
 {
@@ -57,12 +69,108 @@ BASEBLOCKEX* BaseBlocks::GetByX86(uptr ip)
 }
 #endif
 
-void BaseBlocks::Link(u32 pc, s32* jumpptr)
+void BaseBlocks::Link(u32 pc, s32* jumpptr, u32 owner)
 {
 	BASEBLOCKEX* targetblock = Get(pc);
 	if (targetblock && targetblock->startpc == pc)
 		*jumpptr = (s32)(targetblock->fnptr - (sptr)(jumpptr + 1));
 	else
 		*jumpptr = (s32)(recompiler - (sptr)(jumpptr + 1));
-	links.insert(std::pair<u32, uptr>(pc, (uptr)jumpptr));
+	const linkiter_t link = links.insert(std::pair<u32, uptr>(pc, (uptr)jumpptr));
+	owned_links.insert(std::pair<u32, linkiter_t>(owner, link));
+}
+
+void BaseBlocks::UnlinkInbound(u32 startpc)
+{
+	std::pair<linkiter_t, linkiter_t> range = links.equal_range(startpc);
+	for (linkiter_t i = range.first; i != range.second; ++i)
+		*(u32*)i->second = recompiler - (i->second + 4);
+}
+
+void BaseBlocks::RemoveOutbound(u32 startpc)
+{
+	const auto range = owned_links.equal_range(startpc);
+	for (auto i = range.first; i != range.second; ++i)
+	{
+		*(u32*)i->second->second = dispatcher - (i->second->second + 4);
+		links.erase(i->second);
+	}
+	owned_links.erase(range.first, range.second);
+}
+
+void BaseBlocks::Relink(BASEBLOCKEX* block, uptr fnptr)
+{
+	std::pair<linkiter_t, linkiter_t> range = links.equal_range(block->startpc);
+	for (linkiter_t i = range.first; i != range.second; ++i)
+		*(u32*)i->second = fnptr - (i->second + 4);
+
+	block->fnptr = fnptr;
+}
+
+void BaseBlocks::RemoveLinksInRange(uptr start, uptr end)
+{
+	for (auto i = owned_links.begin(); i != owned_links.end();)
+	{
+		const uptr jumpptr = i->second->second;
+		if (jumpptr >= start && jumpptr < end)
+		{
+			links.erase(i->second);
+			i = owned_links.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+u32* WaitLoopList::Add(u32 startpc, u32 endpc)
+{
+	const auto it = m_index.find(startpc);
+	if (it != m_index.end())
+	{
+		m_loops[it->second].endpc = endpc;
+		return &m_loops[it->second].hits;
+	}
+
+	if (m_count == MAX_LOOPS)
+		return nullptr;
+
+	m_index.emplace(startpc, m_count);
+	m_loops[m_count] = {startpc, endpc, 0};
+	return &m_loops[m_count++].hits;
+}
+
+void WaitLoopList::Export(const char* cpu_name)
+{
+	std::vector<Loop> loops;
+	for (u32 i = 0; i < m_count; i++)
+	{
+		if (m_loops[i].hits != 0)
+			loops.push_back(m_loops[i]);
+		m_loops[i].hits = 0;
+	}
+
+	if (loops.empty() || !ConsoleLogging.eeRecPerf.IsActive())
+		return;
+
+	std::sort(loops.begin(), loops.end(), [](const Loop& lhs, const Loop& rhs) { return lhs.hits > rhs.hits; });
+
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+
+	std::string yaml = fmt::format("# Wait loops skipped by the {} recompiler, busiest first.\n", cpu_name);
+	yaml += fmt::format("{}:\n  waitLoops:\n    {}:\n", serial.empty() ? "NOSERIAL" : serial, cpu_name);
+	for (const Loop& loop : loops)
+		yaml += fmt::format("      - {{ start: 0x{:08X}, end: 0x{:08X}, hits: {} }}\n", loop.startpc, loop.endpc, loop.hits);
+
+	const std::string path = Path::Combine(EmuFolders::Logs,
+		fmt::format("{}_waitloops_{}_{:08X}.yaml", cpu_name, serial.empty() ? "NOSERIAL" : serial, crc));
+	if (!FileSystem::WriteStringToFile(path.c_str(), yaml))
+	{
+		Console.Error("Failed to write wait loop list '%s'", path.c_str());
+		return;
+	}
+
+	Console.WriteLn("(%s) Wrote %zu wait loops to '%s'", cpu_name, loops.size(), path.c_str());
 }
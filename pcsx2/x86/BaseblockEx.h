@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstring>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "common/Assertions.h"
 
@@ -145,19 +148,28 @@ protected:
 
 	// switch to a hash map later?
 	std::multimap<u32, uptr> links;
+
+	// Reverse index of links, by the start pc of the block whose code holds the jump. Lets a removed
+	// block drop its own jumps without scanning every link.
+	std::multimap<u32, linkiter_t> owned_links;
+
 	uptr recompiler;
+	uptr dispatcher;
 	BaseBlockArray blocks;
 
 public:
 	BaseBlocks()
 		: recompiler(0)
+		, dispatcher(0)
 		, blocks(0x4000)
 	{
 	}
 
-	void SetJITCompile(const void *recompiler_)
+	// dispatcher looks the pc up again, for jumps out of removed code whose target may still be compiled.
+	void SetJITCompile(const void *recompiler_, const void* dispatcher_)
 	{
 		recompiler = reinterpret_cast<uptr>(recompiler_);
+		dispatcher = reinterpret_cast<uptr>(dispatcher_);
 	}
 
 	BASEBLOCKEX* New(u32 startpc, uptr fnptr);
@@ -196,10 +208,7 @@ public:
 		{
 			pxAssert(idx <= last);
 
-			//u32 startpc = blocks[idx].startpc;
-			std::pair<linkiter_t, linkiter_t> range = links.equal_range(blocks[idx].startpc);
-			for (linkiter_t i = range.first; i != range.second; ++i)
-				*(u32*)i->second = recompiler - (i->second + 4);
+			UnlinkInbound(blocks[idx].startpc);
 
 			if (IsDevBuild)
 			{
@@ -213,17 +222,97 @@ public:
 			}
 		} while (idx++ < last);
 
-		// TODO: remove links from this block?
+		// The removed code is dead, so forget the jumps in it too.
+		for (idx = first; idx <= last; idx++)
+			RemoveOutbound(blocks[idx].startpc);
+
 		blocks.erase(first, last + 1);
 	}
 
-	void Link(u32 pc, s32* jumpptr);
+	// Removes every block matching pred in a single pass, relinking jumps to them to the recompiler.
+	template <typename F>
+	u32 RemoveIf(const F& pred)
+	{
+		const u32 count = blocks.size();
+		u32 kept = 0;
+		for (u32 idx = 0; idx < count; idx++)
+		{
+			if (!pred(blocks[idx]))
+			{
+				if (kept != idx)
+					blocks[kept] = blocks[idx];
+				kept++;
+				continue;
+			}
+
+			UnlinkInbound(blocks[idx].startpc);
+			removed_pcs.push_back(blocks[idx].startpc);
+		}
+
+		for (const u32 startpc : removed_pcs)
+			RemoveOutbound(startpc);
+		removed_pcs.clear();
+
+		if (kept != count)
+			blocks.erase(kept, count);
+		return count - kept;
+	}
+
+	// Links the jump at jumpptr, which is part of the code of the block starting at owner, to pc.
+	void Link(u32 pc, s32* jumpptr, u32 owner);
+
+	// Points the block, and every jump linked to it, at a new entry point.
+	void Relink(BASEBLOCKEX* block, uptr fnptr);
+
+	// Forgets every link whose jump lives in [start, end), so the code there can be overwritten.
+	void RemoveLinksInRange(uptr start, uptr end);
 
 	__fi void Reset()
 	{
 		blocks.clear();
 		links.clear();
+		owned_links.clear();
 	}
+
+protected:
+	// Points every jump into the block starting at startpc back at the recompiler.
+	void UnlinkInbound(u32 startpc);
+
+	// Forgets the jumps in the code of the block starting at startpc. They're pointed at the dispatcher,
+	// since the removed code can still be running if it was invalidated from an event or exception.
+	void RemoveOutbound(u32 startpc);
+
+	std::vector<u32> removed_pcs;
+};
+
+// Polling loops which a recompiler skips ahead through with the WaitLoop speedhack.
+// The generated code bumps a hit counter per loop, so the busiest loops of a game can
+// be written out and reviewed. The counters live in the list itself, which has to be
+// a global so the recompiled code can address them directly.
+class WaitLoopList
+{
+public:
+	static constexpr u32 MAX_LOOPS = 1024;
+
+	struct Loop
+	{
+		u32 startpc;
+		u32 endpc;
+		u32 hits;
+	};
+
+	/// Registers a detected loop, returns the counter for the generated code to increment,
+	/// or nullptr if the list is full.
+	u32* Add(u32 startpc, u32 endpc);
+
+	/// Writes the loops which were hit to the log folder as a GameDB style fragment, and
+	/// zeroes the counters. Only done while the EE recompiler performance log is enabled.
+	void Export(const char* cpu_name);
+
+private:
+	std::array<Loop, MAX_LOOPS> m_loops;
+	std::unordered_map<u32, u32> m_index;
+	u32 m_count = 0;
 };
 
 #define PC_GETBLOCK_(x, reclut) ((BASEBLOCK*)(reclut[((u32)(x)) >> 16] + (x) * (sizeof(BASEBLOCK) / 4)))
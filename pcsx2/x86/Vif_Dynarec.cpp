@@ -8,6 +8,7 @@
 
 void dVifReset(int idx)
 {
+	dVifRetireBlocks(idx);
 	nVif[idx].vifBlocks.reset();
 
 	const size_t offset = idx ? HostMemoryMap::VIF1recOffset : HostMemoryMap::VIF0recOffset;
@@ -18,6 +19,7 @@ void dVifReset(int idx)
 
 void dVifRelease(int idx)
 {
+	dVifRetireBlocks(idx);
 	nVif[idx].vifBlocks.clear();
 }
 
@@ -439,6 +441,7 @@ _vifT __fi nVifBlock* dVifCompile(nVifBlock& block, bool isFill)
 	block.startPtr = (uptr)xGetAlignedCallTarget();
 	block.length = dVifComputeLength(block.cl, block.wl, block.num, isFill);
 	v.vifBlocks.add(block);
+	v.blockCompiles++;
 
 	VifUnpackSSE_Dynarec(v, block).CompileRoutine();
 
@@ -489,7 +492,14 @@ _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 	// Seach in cache before trying to compile the block
 	nVifBlock* b = v.vifBlocks.find(block);
 	if (!b) [[unlikely]]
+	{
+		v.blockMisses++;
 		b = dVifCompile<idx>(block, isFill);
+	}
+	else
+	{
+		v.blockHits++;
+	}
 
 	{ // Execute the block
 		const VURegs& VU = vuRegs[idx];
@@ -514,3 +524,17 @@ _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 
 template void dVifUnpack<0>(const u8* data, bool isFill);
 template void dVifUnpack<1>(const u8* data, bool isFill);
+
+void dVifPrecompile(int idx, const nVifBlock& key)
+{
+	nVifBlock block = key;
+	if (nVif[idx].vifBlocks.find(block))
+		return;
+
+	const int wl = block.wl ? block.wl : 256;
+	const bool isFill = (block.cl < wl);
+	if (idx)
+		dVifCompile<1>(block, isFill);
+	else
+		dVifCompile<0>(block, isFill);
+}
@@ -345,7 +345,11 @@ __fi void fpuFloat3(int regd) // +NaN -> +fMax, -NaN -> -fMax, +Inf -> +fMax, -I
 
 __fi void fpuFloat(int regd) // +/-NaN -> +fMax, +Inf -> +fMax, -Inf -> -fMax
 {
-	if (CHECK_FPU_OVERFLOW)
+	if (CHECK_FPU_ACCURATE)
+	{
+		fpuFloat3(regd);
+	}
+	else if (CHECK_FPU_OVERFLOW)
 	{
 		xMIN.SS(xRegisterSSE(regd), ptr[&g_maxvals[0]]); // MIN() must be before MAX()! So that NaN's become +Maximum
 		xMAX.SS(xRegisterSSE(regd), ptr[&g_minvals[0]]);
@@ -360,9 +364,34 @@ __fi void fpuFloat2(int regd) // +NaN -> +fMax, -NaN -> -fMax, +Inf -> +fMax, -I
 	}
 }
 
-void ClampValues(int regd)
+// PS2 floats have no Inf/NaN, an overflowed result saturates to the signed maximum and raises O/SO.
+// Checked on the single-precision result with integer ops, instead of converting through doubles.
+static void fpuCheckOverflow(int regd, bool acc)
 {
-	fpuFloat(regd);
+	xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO | FPUflagU)); // Clear O and U flags
+	if (acc)
+		xAND(ptr32[&fpuRegs.ACCflag], ~1);
+
+	xMOVD(eax, xRegisterSSE(regd));
+	xAND(eax, 0x7fffffff);
+	xCMP(eax, 0x7f800000);
+	xForwardJB8 no_overflow;
+
+	xAND.PS(xRegisterSSE(regd), ptr[&s_neg[0]]); // Get the sign bit
+	xOR.PS(xRegisterSSE(regd), ptr[&g_maxvals[0]]); // regd = +/- Maximum
+	xOR(ptr32[&fpuRegs.fprc[31]], FPUflagO | FPUflagSO);
+	if (acc)
+		xOR(ptr32[&fpuRegs.ACCflag], 1);
+
+	no_overflow.SetTarget();
+}
+
+void ClampValues(int regd, bool acc = false)
+{
+	if (CHECK_FPU_ACCURATE)
+		fpuCheckOverflow(regd, acc);
+	else
+		fpuFloat(regd);
 }
 //------------------------------------------------------------------
 
@@ -657,7 +686,7 @@ void recADDA_S_xmm(int info)
 {
 	EE::Profiler.EmitOp(eeOpcode::ADDA_F);
 	//xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO|FPUflagU)); // Clear O and U flags
-	ClampValues(recCommutativeOp(info, EEREC_ACC, 0));
+	ClampValues(recCommutativeOp(info, EEREC_ACC, 0), true);
 }
 
 FPURECOMPILE_CONSTCODE(ADDA_S, XMMINFO_WRITEACC | XMMINFO_READS | XMMINFO_READT);
@@ -1360,7 +1389,7 @@ void recMADDtemp(int info, int regd)
 			break;
 	}
 
-	ClampValues(regd);
+	ClampValues(regd, (info & PROCESS_EE_ACC) && regd == EEREC_ACC);
 	_freeXMMreg(t0reg);
 }
 
@@ -1580,7 +1609,7 @@ void recMSUBtemp(int info, int regd)
 			break;
 	}
 
-	ClampValues(regd);
+	ClampValues(regd, (info & PROCESS_EE_ACC) && regd == EEREC_ACC);
 	_freeXMMreg(t0reg);
 }
 
@@ -1620,7 +1649,7 @@ void recMULA_S_xmm(int info)
 {
 	EE::Profiler.EmitOp(eeOpcode::MULA_F);
 	//xAND(ptr32[&fpuRegs.fprc[31]], ~(FPUflagO|FPUflagU)); // Clear O and U flags
-	ClampValues(recCommutativeOp(info, EEREC_ACC, 1));
+	ClampValues(recCommutativeOp(info, EEREC_ACC, 1), true);
 }
 
 FPURECOMPILE_CONSTCODE(MULA_S, XMMINFO_WRITEACC | XMMINFO_READS | XMMINFO_READT);
@@ -1710,7 +1739,7 @@ void recSUBop(int info, int regd)
 			break;
 	}
 
-	ClampValues(regd);
+	ClampValues(regd, (info & PROCESS_EE_ACC) && regd == EEREC_ACC);
 	_freeXMMreg(t0reg);
 }
 
@@ -16,6 +16,76 @@ namespace Dynarec {
 namespace OpcodeImpl {
 namespace MMI {
 
+// Divides eax by ecx, leaving the quotient in eax and the remainder in edx.
+// Division by zero and overflow produce the EE's results instead of an x86 exception, same as recDIVsuper.
+static void recPDIVLane(bool sign)
+{
+	u8* end1 = nullptr;
+	if (sign)
+	{
+		xCMP(eax, 0x80000000);
+		u8* cont1 = JNE8(0);
+		xCMP(ecx, 0xffffffff);
+		u8* cont2 = JNE8(0);
+		//overflow case:
+		xXOR(edx, edx); //EAX remains 0x80000000
+		end1 = JMP8(0);
+
+		x86SetJ8(cont1);
+		x86SetJ8(cont2);
+	}
+
+	xCMP(ecx, 0);
+	u8* cont3 = JNE8(0);
+	//divide by zero
+	xMOV(edx, eax);
+	if (sign) //set EAX to (EAX < 0)?1:-1
+	{
+		xSAR(eax, 31); //(EAX < 0)?-1:0
+		xSHL(eax, 1); //(EAX < 0)?-2:0
+		xNOT(eax); //(EAX < 0)?1:-1
+	}
+	else
+		xMOV(eax, 0xffffffff);
+	u8* end2 = JMP8(0);
+
+	x86SetJ8(cont3);
+	if (sign)
+	{
+		xCDQ();
+		xDIV(ecx);
+	}
+	else
+	{
+		xXOR(edx, edx);
+		xUDIV(ecx);
+	}
+
+	if (sign)
+		x86SetJ8(end1);
+	x86SetJ8(end2);
+}
+
+// PDIVW/PDIVUW: divides words 0 and 2, results are sign extended into the lower word of each LO/HI doubleword.
+static void recPDIVWsuper(bool sign)
+{
+	int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITELO | XMMINFO_WRITEHI);
+
+	for (u8 lane = 0; lane < 2; lane++)
+	{
+		xPEXTR.D(eax, xRegisterSSE(EEREC_S), lane * 2);
+		xPEXTR.D(ecx, xRegisterSSE(EEREC_T), lane * 2);
+		recPDIVLane(sign);
+		xPINSR.D(xRegisterSSE(EEREC_LO), eax, lane);
+		xPINSR.D(xRegisterSSE(EEREC_HI), edx, lane);
+	}
+
+	xPMOVSX.DQ(xRegisterSSE(EEREC_LO), xRegisterSSE(EEREC_LO));
+	xPMOVSX.DQ(xRegisterSSE(EEREC_HI), xRegisterSSE(EEREC_HI));
+
+	_clearNeededXMMregs();
+}
+
 #ifndef MMI_RECOMPILE
 
 REC_FUNC_DEL(PLZCW, _Rd_);
@@ -1653,8 +1723,7 @@ void recPDIVW()
 {
 	EE::Profiler.EmitOp(eeOpcode::PDIVW);
 
-	_deleteEEreg(_Rd_, 0);
-	recCall(Interp::PDIVW);
+	recPDIVWsuper(true);
 }
 
 ////////////////////////////////////////////////////
@@ -1662,8 +1731,20 @@ void recPDIVBW()
 {
 	EE::Profiler.EmitOp(eeOpcode::PDIVBW);
 
-	_deleteEEreg(_Rd_, 0);
-	recCall(Interp::PDIVBW); //--
+	int info = eeRecompileCodeXMM(XMMINFO_READS | XMMINFO_READT | XMMINFO_WRITELO | XMMINFO_WRITEHI);
+
+	// every word of rs is divided by the sign extended lower halfword of rt
+	xPEXTR.W(ecx, xRegisterSSE(EEREC_T), 0);
+	xMOVSX(ecx, cx);
+	for (u8 lane = 0; lane < 4; lane++)
+	{
+		xPEXTR.D(eax, xRegisterSSE(EEREC_S), lane);
+		recPDIVLane(true);
+		xPINSR.D(xRegisterSSE(EEREC_LO), eax, lane);
+		xPINSR.D(xRegisterSSE(EEREC_HI), edx, lane);
+	}
+
+	_clearNeededXMMregs();
 }
 
 ////////////////////////////////////////////////////
@@ -2236,8 +2317,7 @@ void recPDIVUW()
 {
 	EE::Profiler.EmitOp(eeOpcode::PDIVUW);
 
-	_deleteEEreg(_Rd_, 0);
-	recCall(Interp::PDIVUW);
+	recPDIVWsuper(false);
 }
 
 ////////////////////////////////////////////////////
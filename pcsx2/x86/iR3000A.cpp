@@ -25,6 +25,7 @@
 #include "common/Path.h"
 #include "common/Perf.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/SymbolGuardian.h"
 
 //#define DUMP_BLOCKS 1
 //#define TRACE_BLOCKS 1
@@ -70,6 +71,8 @@ static BASEBLOCKEX* s_pCurBlockEx = nullptr;
 static u32 s_nEndBlock = 0; // what psxpc the current block ends
 static u32 s_branchTo;
 static bool s_nBlockFF;
+static WaitLoopList s_wait_loops;
+static u32* s_wait_loop_hits = nullptr; // counter of the wait loop being compiled
 
 static u32 s_saveConstRegs[32];
 static u32 s_saveHasConstReg = 0, s_saveFlushedConstReg = 0;
@@ -236,7 +239,7 @@ static void _DynGen_Dispatchers()
 	iopJITCompile = _DynGen_JITCompile();
 	iopEnterRecompiledCode = _DynGen_EnterRecompiledCode();
 
-	recBlocks.SetJITCompile(iopJITCompile);
+	recBlocks.SetJITCompile(iopJITCompile, iopDispatcherReg);
 
 	Perf::any.Register(start, xGetPtr() - start, "IOP Dispatcher");
 }
@@ -883,6 +886,8 @@ void recResetIOP()
 {
 	DevCon.WriteLn("iR3000A Recompiler reset.");
 
+	s_wait_loops.Export("iop");
+
 	xSetPtr(SysMemory::GetIOPRec());
 	_DynGen_Dispatchers();
 	recPtr = xGetPtr();
@@ -940,6 +945,8 @@ void recResetIOP()
 
 static void recShutdown()
 {
+	s_wait_loops.Export("iop");
+
 	safe_aligned_free(m_recBlockAlloc);
 
 	safe_free(s_pInstCache);
@@ -1107,7 +1114,7 @@ void psxSetBranchImm(u32 imm)
 	_psxFlushCall(FLUSH_EVERYTHING);
 	iPsxBranchTest(imm, imm <= psxpc);
 
-	recBlocks.Link(HWADDR(imm), xJcc32());
+	recBlocks.Link(HWADDR(imm), xJcc32(), s_pCurBlockEx->startpc);
 }
 
 static __fi u32 psxScaleBlockCycles()
@@ -1146,6 +1153,9 @@ static void iPsxBranchTest(u32 newpc, u32 cpuBranch)
 
 	if (EmuConfig.Speedhacks.WaitLoop && s_nBlockFF && newpc == s_branchTo)
 	{
+		if (s_wait_loop_hits)
+			xADD(ptr32[s_wait_loop_hits], 1);
+
 		xMOV(eax, ptr32[&psxRegs.cycle]);
 		xMOV(ecx, eax);
 		xMOV(edx, ptr32[&psxRegs.iopCycleEE]);
@@ -1665,25 +1675,89 @@ static void iopRecRecompile(const u32 startpc)
 
 StartRecomp:
 
+	// Same rules as the EE: as long as a loop doesn't write to a register it's already read
+	// (excepting registers initialised with constants or memory loads) or use any instructions
+	// which alter the machine state apart from registers, it will do the same thing on every
+	// iteration, so it can skip ahead to the next event.
 	s_nBlockFF = false;
 	if (s_branchTo == startpc)
 	{
 		s_nBlockFF = true;
+
+		u32 reads = 0, loads = 1;
+
 		for (i = startpc; i < s_nEndBlock; i += 4)
 		{
-			if (i != s_nEndBlock - 8)
+			if (i == s_nEndBlock - 8)
+				continue;
+			psxRegs.code = iopMemRead32(i);
+			const u32 opcode = psxRegs.code >> 26;
+			// nop
+			if (psxRegs.code == 0)
+				continue;
+			// imm arithmetic
+			else if ((opcode & 070) == 010)
+			{
+				if (loads & 1 << _Rs_)
+				{
+					loads |= 1 << _Rt_;
+					continue;
+				}
+				else
+					reads |= 1 << _Rs_;
+				if (reads & 1 << _Rt_)
+				{
+					s_nBlockFF = false;
+					break;
+				}
+			}
+			// common register arithmetic instructions
+			else if (opcode == 0 && (_Funct_ & 060) == 040 && (_Funct_ & 076) != 050)
+			{
+				if (loads & 1 << _Rs_ && loads & 1 << _Rt_)
+				{
+					loads |= 1 << _Rd_;
+					continue;
+				}
+				else
+					reads |= 1 << _Rs_ | 1 << _Rt_;
+				if (reads & 1 << _Rd_)
+				{
+					s_nBlockFF = false;
+					break;
+				}
+			}
+			// loads
+			else if ((opcode & 070) == 040)
 			{
-				switch (iopMemRead32(i))
+				if (loads & 1 << _Rs_)
 				{
-					case 0: // nop
-						break;
-					default:
-						s_nBlockFF = false;
+					loads |= 1 << _Rt_;
+					continue;
+				}
+				else
+					reads |= 1 << _Rs_;
+				if (reads & 1 << _Rt_)
+				{
+					s_nBlockFF = false;
+					break;
 				}
 			}
+			// mfc0, mfc2, cfc2
+			else if ((opcode == 020 || opcode == 022) && _Rs_ < 4)
+			{
+				loads |= 1 << _Rt_;
+			}
+			else
+			{
+				s_nBlockFF = false;
+				break;
+			}
 		}
 	}
 
+	s_wait_loop_hits = (EmuConfig.Speedhacks.WaitLoop && s_nBlockFF) ? s_wait_loops.Add(startpc, s_nEndBlock) : nullptr;
+
 	// rec info //
 	{
 		EEINST* pcur;
@@ -1744,7 +1818,7 @@ StartRecomp:
 			pxAssert(psxpc == s_nEndBlock);
 			_psxFlushCall(FLUSH_EVERYTHING);
 			xMOV(ptr32[&psxRegs.pc], psxpc);
-			recBlocks.Link(HWADDR(s_nEndBlock), xJcc32());
+			recBlocks.Link(HWADDR(s_nEndBlock), xJcc32(), s_pCurBlockEx->startpc);
 			psxbranch = 3;
 		}
 	}
@@ -1754,7 +1828,12 @@ StartRecomp:
 	pxAssert(xGetPtr() - recPtr < _64kb);
 	s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
-	Perf::iop.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	if (Perf::IsEnabled())
+	{
+		const FunctionInfo function = R3000SymbolGuardian.FunctionOverlappingAddress(s_pCurBlockEx->startpc);
+		Perf::iop.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc,
+			function.name.c_str(), function.address.value);
+	}
 
 	recPtr = xGetPtr();
 
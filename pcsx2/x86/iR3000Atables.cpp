@@ -7,6 +7,7 @@
 #include "IopMem.h"
 #include "IopDma.h"
 #include "IopGte.h"
+#include "SPU2/spu2.h"
 
 #include "common/Console.h"
 
@@ -1075,65 +1076,206 @@ static void rpsxCalcStoreOperand()
 		xMOV(arg2regd, ptr32[&psxRegs.GPR.r[_Rt_]]);
 }
 
-static void rpsxLoad(int size, bool sign)
+// Hardware pages at 0x1f80xxxx without a handler in iopMemRead/iopMemWrite, which
+// just access iopHw (this includes the scratchpad).
+static bool rpsxIsPlainHwAddress(u32 addr)
 {
-	rpsxCalcAddressOperand();
+	addr &= 0x1fffffff;
+	if ((addr >> 16) != 0x1f80)
+		return false;
 
-	if (_Rt_ != 0)
-	{
-		PSX_DEL_CONST(_Rt_);
-		_deletePSXtoX86reg(_Rt_, DELETE_REG_FREE_NO_WRITEBACK);
+	const u32 page = addr & 0xf000;
+	return (page != 0x1000 && page != 0x3000 && page != 0x8000);
+}
+
+// Returns the handler iopMemRead would end up calling for a constant address, so the
+// address decode can be skipped. The DMA, timer and SIO registers live in the paged
+// handlers, SPU2 is only accessible in 16 bit mode.
+static const void* rpsxGetConstReadHandler(u32 addr, int size)
+{
+	addr &= 0x1fffffff;
+	if ((addr >> 16) == 0x1f90)
+		return (size == 16) ? (const void*)SPU2read : nullptr;
+	if ((addr >> 16) != 0x1f80)
+		return nullptr;
+
+	switch (addr & 0xf000)
+	{
+		case 0x1000:
+			return (size == 8) ? (const void*)IopMemory::iopHwRead8_Page1 :
+				   (size == 16) ? (const void*)IopMemory::iopHwRead16_Page1 :
+								  (const void*)IopMemory::iopHwRead32_Page1;
+		case 0x3000:
+			return (size == 8) ? (const void*)IopMemory::iopHwRead8_Page3 :
+				   (size == 16) ? (const void*)IopMemory::iopHwRead16_Page3 :
+								  (const void*)IopMemory::iopHwRead32_Page3;
+		case 0x8000:
+			return (size == 8) ? (const void*)IopMemory::iopHwRead8_Page8 :
+				   (size == 16) ? (const void*)IopMemory::iopHwRead16_Page8 :
+								  (const void*)IopMemory::iopHwRead32_Page8;
+		default:
+			return nullptr;
 	}
+}
 
-	_psxFlushCall(FLUSH_FULLVTLB);
-	xTEST(arg1regd, 0x10000000);
-	xForwardJZ8 is_ram_read;
+static const void* rpsxGetConstWriteHandler(u32 addr, int size)
+{
+	addr &= 0x1fffffff;
+	if ((addr >> 16) == 0x1f90)
+		return (size == 16) ? (const void*)SPU2write : nullptr;
+	if ((addr >> 16) != 0x1f80)
+		return nullptr;
 
+	switch (addr & 0xf000)
+	{
+		case 0x1000:
+			return (size == 8) ? (const void*)IopMemory::iopHwWrite8_Page1 :
+				   (size == 16) ? (const void*)IopMemory::iopHwWrite16_Page1 :
+								  (const void*)IopMemory::iopHwWrite32_Page1;
+		case 0x3000:
+			return (size == 8) ? (const void*)IopMemory::iopHwWrite8_Page3 :
+				   (size == 16) ? (const void*)IopMemory::iopHwWrite16_Page3 :
+								  (const void*)IopMemory::iopHwWrite32_Page3;
+		case 0x8000:
+			return (size == 8) ? (const void*)IopMemory::iopHwWrite8_Page8 :
+				   (size == 16) ? (const void*)IopMemory::iopHwWrite16_Page8 :
+								  (const void*)IopMemory::iopHwWrite32_Page8;
+		default:
+			return nullptr;
+	}
+}
+
+// Loads from a constant address below 0x10000000 always take the psM path in
+// rpsxLoad(), so they can be read directly without flushing for a call. The same
+// goes for the hardware pages which iopMemRead reads straight from iopHw.
+static bool rpsxConstLoad(int size, bool sign)
+{
+	if (!PSX_IS_CONST1(_Rs_))
+		return false;
+
+	const u32 addr = g_psxConstRegs[_Rs_] + _Imm_;
+	const bool hw = rpsxIsPlainHwAddress(addr);
+	if ((addr & 0x10000000) && !hw)
+		return false;
+
+	// a dummy read from RAM has no side effects
+	if (_Rt_ == 0)
+		return true;
+
+	PSX_DEL_CONST(_Rt_);
+
+	u8* ptr = hw ? &psxHu8(addr) : &iopMem->Main[addr & 0x1fffff];
+	int rt = rpsxAllocRegIfUsed(_Rt_, MODE_WRITE);
+	if (rt < 0)
+	{
+		_freeX86reg(eax);
+		rt = eax.GetId();
+	}
+
+	const xRegister32 dreg(rt);
 	switch (size)
 	{
 		case 8:
-			xFastCall((void*)iopMemRead8);
+			sign ? xMOVSX(dreg, ptr8[ptr]) : xMOVZX(dreg, ptr8[ptr]);
 			break;
 		case 16:
-			xFastCall((void*)iopMemRead16);
+			sign ? xMOVSX(dreg, ptr16[ptr]) : xMOVZX(dreg, ptr16[ptr]);
 			break;
 		case 32:
-			xFastCall((void*)iopMemRead32);
+			xMOV(dreg, ptr32[ptr]);
 			break;
-
 			jNO_DEFAULT
 	}
 
-	if (_Rt_ == 0)
-	{
-		// dummy read
-		is_ram_read.SetTarget();
-		return;
-	}
+	// if not caching, write back
+	if (rt == eax.GetId())
+		xMOV(ptr32[&psxRegs.GPR.r[_Rt_]], eax);
 
-	xForwardJump8 done;
-	is_ram_read.SetTarget();
+	return true;
+}
 
-	// read from psM directly
-	xAND(arg1regd, 0x1fffff);
+static void rpsxLoad(int size, bool sign)
+{
+	if (rpsxConstLoad(size, sign))
+		return;
 
-	auto addr = xComplexAddress(rax, iopMem->Main, arg1reg);
-	switch (size)
+	const void* handler = PSX_IS_CONST1(_Rs_) ? rpsxGetConstReadHandler(g_psxConstRegs[_Rs_] + _Imm_, size) : nullptr;
+	if (handler)
 	{
-		case 8:
-			xMOVZX(eax, ptr8[addr]);
-			break;
-		case 16:
-			xMOVZX(eax, ptr16[addr]);
-			break;
-		case 32:
-			xMOV(eax, ptr32[addr]);
-			break;
+		// constant hardware register, call the page handler directly
+		const u32 addr = (g_psxConstRegs[_Rs_] + _Imm_) & 0x1fffffff;
+		if (_Rt_ != 0)
+		{
+			PSX_DEL_CONST(_Rt_);
+			_deletePSXtoX86reg(_Rt_, DELETE_REG_FREE_NO_WRITEBACK);
+		}
 
-			jNO_DEFAULT
+		_psxFlushCall(FLUSH_FULLVTLB);
+		xFastCall(handler, addr);
+
+		if (_Rt_ == 0)
+			return;
 	}
+	else
+	{
+		rpsxCalcAddressOperand();
 
-	done.SetTarget();
+		if (_Rt_ != 0)
+		{
+			PSX_DEL_CONST(_Rt_);
+			_deletePSXtoX86reg(_Rt_, DELETE_REG_FREE_NO_WRITEBACK);
+		}
+
+		_psxFlushCall(FLUSH_FULLVTLB);
+		xTEST(arg1regd, 0x10000000);
+		xForwardJZ8 is_ram_read;
+
+		switch (size)
+		{
+			case 8:
+				xFastCall((void*)iopMemRead8);
+				break;
+			case 16:
+				xFastCall((void*)iopMemRead16);
+				break;
+			case 32:
+				xFastCall((void*)iopMemRead32);
+				break;
+
+				jNO_DEFAULT
+		}
+
+		if (_Rt_ == 0)
+		{
+			// dummy read
+			is_ram_read.SetTarget();
+			return;
+		}
+
+		xForwardJump8 done;
+		is_ram_read.SetTarget();
+
+		// read from psM directly
+		xAND(arg1regd, 0x1fffff);
+
+		auto addr = xComplexAddress(rax, iopMem->Main, arg1reg);
+		switch (size)
+		{
+			case 8:
+				xMOVZX(eax, ptr8[addr]);
+				break;
+			case 16:
+				xMOVZX(eax, ptr16[addr]);
+				break;
+			case 32:
+				xMOV(eax, ptr32[addr]);
+				break;
+
+				jNO_DEFAULT
+		}
+
+		done.SetTarget();
+	}
 
 	const int rt = rpsxAllocRegIfUsed(_Rt_, MODE_WRITE);
 	const xRegister32 dreg((rt < 0) ? eax.GetId() : rt);
@@ -1189,8 +1331,51 @@ static void rpsxLW()
 	rpsxLoad(32, false);
 }
 
+// Stores to constant hardware addresses either go straight to iopHw, or call the
+// page handler without going through iopMemWrite. RAM stores still need the
+// generic path for the cache isolation check and block invalidation.
+static bool rpsxConstStore(int size)
+{
+	if (!PSX_IS_CONST1(_Rs_))
+		return false;
+
+	const u32 addr = (g_psxConstRegs[_Rs_] + _Imm_) & 0x1fffffff;
+	if (rpsxIsPlainHwAddress(addr))
+	{
+		const int rt = _allocX86reg(X86TYPE_PSX, _Rt_, MODE_READ);
+		switch (size)
+		{
+			case 8:
+				xMOV(ptr8[&psxHu8(addr)], xRegister8(xRegister32(rt)));
+				break;
+			case 16:
+				xMOV(ptr16[&psxHu16(addr)], xRegister16(rt));
+				break;
+			case 32:
+				xMOV(ptr32[&psxHu32(addr)], xRegister32(rt));
+				break;
+				jNO_DEFAULT
+		}
+		return true;
+	}
+
+	const void* handler = rpsxGetConstWriteHandler(addr, size);
+	if (!handler)
+		return false;
+
+	rpsxCalcStoreOperand();
+	_psxFlushCall(FLUSH_FULLVTLB);
+	_freeX86reg(arg1regd);
+	xMOV(arg1regd, addr);
+	xFastCall(handler);
+	return true;
+}
+
 static void rpsxSB()
 {
+	if (rpsxConstStore(8))
+		return;
+
 	rpsxCalcAddressOperand();
 	rpsxCalcStoreOperand();
 	_psxFlushCall(FLUSH_FULLVTLB);
@@ -1199,6 +1384,9 @@ static void rpsxSB()
 
 static void rpsxSH()
 {
+	if (rpsxConstStore(16))
+		return;
+
 	rpsxCalcAddressOperand();
 	rpsxCalcStoreOperand();
 	_psxFlushCall(FLUSH_FULLVTLB);
@@ -1215,6 +1403,9 @@ static void rpsxSW()
 		return;
 	}
 
+	if (rpsxConstStore(32))
+		return;
+
 	rpsxCalcAddressOperand();
 	rpsxCalcStoreOperand();
 	_psxFlushCall(FLUSH_FULLVTLB);
@@ -18,6 +18,7 @@ extern u32 maxrecmem;
 extern u32 pc;             // recompiler pc
 extern int g_branch;       // set for branch
 extern u32 target;         // branch target
+extern u32 s_nStartBlock;  // pc the current block starts at
 extern u32 s_nBlockCycles; // cycles of current block recompiling
 extern bool s_nBlockInterlocked; // Current block has VU0 interlocking
 
@@ -67,6 +68,10 @@ void recompileNextInstruction(bool delayslot, bool swapped_delay_slot);
 void SetBranchReg(u32 reg);
 void SetBranchImm(u32 imm);
 
+// Continues the current block at target instead of ending it, if the jump at jumppc was
+// selected as a trace jump when the block was scanned.
+bool recTryTraceJump(u32 jumppc, u32 target);
+
 void iFlushCall(int flushtype);
 void recBranchCall(void (*func)());
 void recCall(void (*func)());
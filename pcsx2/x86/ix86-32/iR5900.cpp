@@ -4,6 +4,7 @@
 #include "Common.h"
 #include "CDVD/CDVD.h"
 #include "DebugTools/Breakpoints.h"
+#include "DebugTools/SymbolGuardian.h"
 #include "Elfheader.h"
 #include "GS.h"
 #include "Memory.h"
@@ -16,10 +17,17 @@
 #include "x86/iR5900.h"
 #include "x86/iR5900Analysis.h"
 
+#include "GS/GSXXH.h"
+
 #include "common/AlignedMalloc.h"
 #include "common/FastJmp.h"
+#include "common/FileSystem.h"
 #include "common/HeapArray.h"
+#include "common/Path.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
 
 // Only for MOVQ workaround.
 #include "common/emitter/internal.h"
@@ -37,6 +45,9 @@
 #include <zlib.h>
 #endif
 
+#include <unordered_map>
+#include <unordered_set>
+
 using namespace x86Emitter;
 using namespace R5900;
 
@@ -82,14 +93,29 @@ static BASEBLOCK* recROM2 = nullptr; // also here
 static BaseBlocks recBlocks;
 static u8* recPtr = nullptr;
 static u8* recPtrEnd = nullptr;
+
+// Once the code cache fills up, allocation wraps around to the start and the oldest code is
+// evicted a region at a time just ahead of recPtr, instead of resetting the whole cache.
+// Nothing between recPtr and recEvictPtr is referenced by a live block.
+static constexpr u32 CODE_EVICT_REGIONS = 16;
+static constexpr u32 CODE_EVICT_HEADROOM = 2 * _64kb;
+static u8* recCodeStart = nullptr;
+static u8* recEvictPtr = nullptr;
+
+// Blocks compiled under write protection which lost it to a write elsewhere on their page.
+// They enter through a stub checking their code, the compiled code itself is kept here.
+static std::unordered_map<u32, std::pair<uptr, u32>> s_checked_blocks; // startpc -> code, size in bytes
 EEINST* s_pInstCache = nullptr;
 static u32 s_nInstCacheSize = 0;
 
 static BASEBLOCK* s_pCurBlock = nullptr;
 static BASEBLOCKEX* s_pCurBlockEx = nullptr;
+u32 s_nStartBlock = 0; // what pc the current block starts
 u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
+static WaitLoopList s_wait_loops;
+static u32* s_wait_loop_hits = nullptr; // counter of the wait loop being compiled
 
 // save states for branches
 GPR_reg64 s_saveConstRegs[32];
@@ -346,6 +372,7 @@ void recCall(void (*func)())
 static void recRecompile(const u32 startpc);
 static void dyna_block_discard(u32 start, u32 sz);
 static void dyna_page_reset(u32 start, u32 sz);
+static void recPromoteHotBlock();
 
 static const void* DispatcherEvent = nullptr;
 static const void* DispatcherReg = nullptr;
@@ -353,6 +380,7 @@ static const void* JITCompile = nullptr;
 static const void* EnterRecompiledCode = nullptr;
 static const void* DispatchBlockDiscard = nullptr;
 static const void* DispatchPageReset = nullptr;
+static const void* DispatchBlockPromote = nullptr;
 
 static void recEventTest()
 {
@@ -461,6 +489,14 @@ static const void* _DynGen_DispatchPageReset()
 	return retval;
 }
 
+static const void* _DynGen_DispatchBlockPromote()
+{
+	u8* retval = xGetPtr();
+	xFastCall((const void*)recPromoteHotBlock);
+	xJMP(DispatcherReg);
+	return retval;
+}
+
 static void _DynGen_Dispatchers()
 {
 	const u8* start = xGetAlignedCallTarget();
@@ -474,8 +510,9 @@ static void _DynGen_Dispatchers()
 	EnterRecompiledCode = _DynGen_EnterRecompiledCode();
 	DispatchBlockDiscard = _DynGen_DispatchBlockDiscard();
 	DispatchPageReset = _DynGen_DispatchPageReset();
+	DispatchBlockPromote = _DynGen_DispatchBlockPromote();
 
-	recBlocks.SetJITCompile(JITCompile);
+	recBlocks.SetJITCompile(JITCompile, DispatcherReg);
 
 	Perf::any.Register(start, static_cast<u32>(xGetPtr() - start), "EE Dispatcher");
 }
@@ -551,6 +588,8 @@ static void recReserve()
 {
 	recPtr = SysMemory::GetEERec();
 	recPtrEnd = SysMemory::GetEERecEnd() - _64kb;
+	recCodeStart = recPtr;
+	recEvictPtr = SysMemory::GetEERecEnd();
 	recReserveRAM();
 
 	pxAssertRel(!s_pInstCache, "InstCache not allocated");
@@ -563,10 +602,331 @@ static void recReserve()
 alignas(16) static u16 manual_page[Ps2MemSize::TotalRam >> 12];
 alignas(16) static u8 manual_counter[Ps2MemSize::TotalRam >> 12];
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Persistent block cache
+//
+// The generated host code is not position independent (it references host globals, the
+// dispatchers and other blocks directly), so rather than the code itself we persist the
+// layout of the blocks a game compiled: the guest start address, the block size, and a hash
+// of the guest instructions. When the same game boots again, every block whose guest code
+// still matches is compiled up front as soon as the ELF entry point is reached, instead of
+// piecemeal on first execution during gameplay.
+
+namespace
+{
+#pragma pack(push, 1)
+	struct BlockCacheHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 num_entries;
+	};
+
+	struct BlockCacheEntry
+	{
+		u32 startpc;
+		u32 size;
+		u64 hash;
+	};
+#pragma pack(pop)
+} // namespace
+
+static constexpr u32 BLOCK_CACHE_MAGIC = 0x43424545; // EEBC
+static constexpr u32 BLOCK_CACHE_VERSION = 1;
+static constexpr u32 BLOCK_CACHE_MAX_ENTRIES = 0x40000;
+
+static std::string s_block_cache_path;
+static std::vector<BlockCacheEntry> s_block_cache_loaded;
+static std::vector<BlockCacheEntry> s_block_cache_session;
+static bool s_block_cache_preload_pending = false;
+
+static std::string recGetBlockCachePath()
+{
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (serial.empty() && crc == 0)
+		return {};
+
+	return Path::Combine(EmuFolders::Cache, fmt::format("ee_blocks_{}_{:08X}.bin", serial.empty() ? "NOSERIAL" : serial, crc));
+}
+
+static bool recIsCacheableBlock(u32 startpc, u32 size)
+{
+	// Only direct-mapped main RAM is persisted, the BIOS and TLB-mapped code are not worth it.
+	return (size > 0 && startpc < Ps2MemSize::ExposedRam && (startpc + size * 4) <= Ps2MemSize::ExposedRam);
+}
+
+static void recLoadBlockCache()
+{
+	s_block_cache_loaded.clear();
+
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_block_cache_path.c_str());
+	if (!data.has_value())
+		return;
+
+	BlockCacheHeader header;
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != BLOCK_CACHE_MAGIC || header.version != BLOCK_CACHE_VERSION ||
+		header.num_entries > BLOCK_CACHE_MAX_ENTRIES ||
+		data->size() != (sizeof(header) + header.num_entries * sizeof(BlockCacheEntry)))
+	{
+		Console.Warning("(recBlockCache) Ignoring invalid block cache '%s'", s_block_cache_path.c_str());
+		return;
+	}
+
+	s_block_cache_loaded.resize(header.num_entries);
+	std::memcpy(s_block_cache_loaded.data(), data->data() + sizeof(header), header.num_entries * sizeof(BlockCacheEntry));
+}
+
+static void recSaveBlockCache()
+{
+	if (s_block_cache_path.empty() || s_block_cache_session.empty())
+		return;
+
+	// Blocks compiled this session replace stale entries for the same address.
+	std::vector<BlockCacheEntry> entries;
+	entries.reserve(s_block_cache_loaded.size() + s_block_cache_session.size());
+	entries.insert(entries.end(), s_block_cache_session.rbegin(), s_block_cache_session.rend());
+	entries.insert(entries.end(), s_block_cache_loaded.begin(), s_block_cache_loaded.end());
+	std::stable_sort(entries.begin(), entries.end(),
+		[](const BlockCacheEntry& lhs, const BlockCacheEntry& rhs) { return lhs.startpc < rhs.startpc; });
+	entries.erase(std::unique(entries.begin(), entries.end(),
+					  [](const BlockCacheEntry& lhs, const BlockCacheEntry& rhs) { return lhs.startpc == rhs.startpc; }),
+		entries.end());
+	if (entries.size() > BLOCK_CACHE_MAX_ENTRIES)
+		entries.resize(BLOCK_CACHE_MAX_ENTRIES);
+
+	const BlockCacheHeader header = {BLOCK_CACHE_MAGIC, BLOCK_CACHE_VERSION, static_cast<u32>(entries.size())};
+	std::vector<u8> data(sizeof(header) + entries.size() * sizeof(BlockCacheEntry));
+	std::memcpy(data.data(), &header, sizeof(header));
+	std::memcpy(data.data() + sizeof(header), entries.data(), entries.size() * sizeof(BlockCacheEntry));
+	if (!FileSystem::WriteBinaryFile(s_block_cache_path.c_str(), data.data(), data.size()))
+	{
+		Console.Error("(recBlockCache) Failed to write block cache '%s'", s_block_cache_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("(recBlockCache) Wrote %zu blocks to '%s'", entries.size(), s_block_cache_path.c_str());
+	s_block_cache_loaded = std::move(entries);
+	s_block_cache_session.clear();
+}
+
+static void recCloseBlockCache()
+{
+	recSaveBlockCache();
+	s_block_cache_path = {};
+	s_block_cache_loaded = {};
+	s_block_cache_session = {};
+	s_block_cache_preload_pending = false;
+}
+
+static void recRecordCachedBlock(u32 startpc, u32 size)
+{
+	if (s_block_cache_path.empty() || !recIsCacheableBlock(startpc, size))
+		return;
+
+	const u8* code = static_cast<const u8*>(PSM(startpc));
+	if (!code)
+		return;
+
+	s_block_cache_session.push_back({startpc, size, GSXXH3_64bits(code, size * 4)});
+}
+
+static void recPreloadCachedBlocks()
+{
+	Common::Timer timer;
+	u32 compiled = 0, stale = 0;
+
+	// Leave at least half of the code buffer for blocks which are discovered during gameplay.
+	const u8* preload_end = recPtr + (recPtrEnd - recPtr) / 2;
+
+	for (const BlockCacheEntry& entry : s_block_cache_loaded)
+	{
+		if (recPtr >= preload_end || eeRecNeedsReset)
+			break;
+
+		if (!recIsCacheableBlock(entry.startpc, entry.size) || PC_GETBLOCK(entry.startpc)->GetFnptr() != (uptr)JITCompile)
+			continue;
+
+		const u8* code = static_cast<const u8*>(PSM(entry.startpc));
+		if (!code || GSXXH3_64bits(code, entry.size * 4) != entry.hash)
+		{
+			stale++;
+			continue;
+		}
+
+		recRecompile(entry.startpc);
+		compiled++;
+	}
+
+	Console.WriteLn(Color_StrongBlack, "(recBlockCache) Precompiled %u blocks (%u stale) in %.2f ms", compiled, stale,
+		timer.GetTimeMilliseconds());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Hot block recompilation
+//
+// Blocks are cut short when they run into the start of a block which has already been
+// compiled, so that the code isn't translated twice. The cost is a full register flush and
+// a linked jump at the boundary, which adds up for code that runs all the time. Blocks which
+// were split this way count their executions, and once they pass HOT_BLOCK_THRESHOLD they are
+// recompiled as a second tier which continues through the existing blocks, keeping register
+// allocation and constant propagation going across the old boundary.
+
+static constexpr u16 HOT_BLOCK_THRESHOLD = 1024;
+static constexpr u32 HOT_BLOCK_COUNTERS = 0x4000;
+
+// Counters are hashed by address; a collision only gets a block promoted a little earlier.
+alignas(16) static u16 s_hot_block_counter[HOT_BLOCK_COUNTERS];
+static std::unordered_set<u32> s_hot_blocks;
+static std::vector<u32> s_hot_block_fused;
+
+static __fi u16& recHotBlockCounter(u32 startpc)
+{
+	return s_hot_block_counter[(HWADDR(startpc) >> 2) & (HOT_BLOCK_COUNTERS - 1)];
+}
+
+static __fi bool recIsHotBlock(u32 startpc)
+{
+	return !s_hot_blocks.empty() && s_hot_blocks.find(HWADDR(startpc)) != s_hot_blocks.end();
+}
+
+static void recEmitHotBlockCounter(u32 startpc)
+{
+	recHotBlockCounter(startpc) = HOT_BLOCK_THRESHOLD;
+	xSUB(ptr16[&recHotBlockCounter(startpc)], 1);
+	xJZ(DispatchBlockPromote);
+}
+
+// Hot blocks also follow forward jumps within their page, forming a superblock out of
+// code which would otherwise be a chain of blocks linked by jumps. The block covers the
+// whole address range from its start to its end, gaps included, so that clearing and
+// self-modifying code detection stay conservative.
+static constexpr u32 MAX_TRACE_JUMPS = 4;
+
+static std::vector<std::pair<u32, u32>> s_trace_jumps; // jump pc, target
+static std::vector<std::pair<u32, uptr>> s_trace_kept_blocks;
+static bool s_trace_blocks_exist = false;
+
+static bool recCanTraceJump(u32 startpc, u32 jumppc, u32 target)
+{
+	if (EmuConfig.Gamefixes.GoemonTlbHack || target <= (jumppc + 4) || (target & ~0xfffu) != (startpc & ~0xfffu))
+		return false;
+
+	// The delay slot has to be an ordinary instruction.
+	const u32 code = memRead32(jumppc + 4);
+	const u32 opcode = code >> 26;
+	const u32 funct = code & 0x3f;
+	if ((opcode >= 1 && opcode <= 7) || (opcode >= 16 && opcode <= 18) || (opcode >= 20 && opcode <= 23))
+		return false;
+	if (opcode == 0 && (funct == 8 || funct == 9 || funct == 12 || funct == 13))
+		return false;
+
+	return true;
+}
+
+bool recTryTraceJump(u32 jumppc, u32 target)
+{
+	for (const auto& [trace_pc, trace_target] : s_trace_jumps)
+	{
+		if (trace_pc == jumppc && trace_target == target)
+		{
+			pc = target;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// A promoted block may only go through blocks which end where it does, otherwise the blocks
+// overlapping an address would no longer be contiguous for recClear().
+static bool recCanFuseHotBlock(u32 endpc)
+{
+	for (const u32 fused_pc : s_hot_block_fused)
+	{
+		if (fused_pc >= endpc)
+			break;
+
+		const BASEBLOCKEX* fused = recBlocks.Get(HWADDR(fused_pc));
+		if (!fused || fused->startpc != HWADDR(fused_pc) || (fused->startpc + fused->size * 4) != HWADDR(endpc))
+			return false;
+	}
+
+	return true;
+}
+
+// Code density of everything compiled since the last reset, a smaller ratio means less
+// i-cache pressure and fewer cache resets on games with a large code footprint.
+static u64 s_code_guest_insts = 0;
+static u64 s_code_host_bytes = 0;
+
+static void recReportCodeDensity()
+{
+	if (s_code_guest_insts > 0)
+	{
+		DevCon.WriteLn("EE/iR5900 Code density: %llu instructions in %llu bytes (%.2f bytes/instruction)",
+			s_code_guest_insts, s_code_host_bytes, static_cast<double>(s_code_host_bytes) / static_cast<double>(s_code_guest_insts));
+	}
+
+	s_code_guest_insts = 0;
+	s_code_host_bytes = 0;
+}
+
+// Drops every block whose code overlaps [start, end), along with the links and fastmem info
+// pointing into that range. Blocks in there which are still needed get recompiled on demand.
+static void recEvictCode(const u8* start, const u8* end)
+{
+	const auto overlaps = [start, end](uptr code, u32 size) {
+		return (code < reinterpret_cast<uptr>(end) && (code + size) > reinterpret_cast<uptr>(start));
+	};
+
+	const u32 evicted = recBlocks.RemoveIf([&overlaps](const BASEBLOCKEX& block) {
+		const auto checked = s_checked_blocks.find(block.startpc);
+		if (!overlaps(block.fnptr, block.x86size) &&
+			(checked == s_checked_blocks.end() || !overlaps(checked->second.first, checked->second.second)))
+		{
+			return false;
+		}
+
+		// Only a block's start pc points at its code.
+		PC_GETBLOCK(block.startpc)->SetFnptr((uptr)JITCompile);
+		return true;
+	});
+
+	recBlocks.RemoveLinksInRange(reinterpret_cast<uptr>(start), reinterpret_cast<uptr>(end));
+	vtlb_ClearLoadStoreInfo(reinterpret_cast<uptr>(start), reinterpret_cast<uptr>(end));
+
+	eeRecPerfLog.Write("Evicted %u blocks in code cache range %p-%p", evicted, start, end);
+}
+
+static void recReclaimCodeSpace()
+{
+	if (recPtr >= recPtrEnd)
+	{
+		DevCon.WriteLn("EE/iR5900 Code cache full, evicting oldest code");
+		recPtr = recCodeStart;
+		recEvictPtr = recCodeStart;
+	}
+
+	const uptr region_size = static_cast<uptr>(recPtrEnd - recCodeStart) / CODE_EVICT_REGIONS;
+	u8* const cache_end = SysMemory::GetEERecEnd();
+	while (recEvictPtr < cache_end && (recPtr + CODE_EVICT_HEADROOM) > recEvictPtr)
+	{
+		u8* const evict_end = (static_cast<uptr>(cache_end - recEvictPtr) > region_size) ? (recEvictPtr + region_size) : cache_end;
+		recEvictCode(recEvictPtr, evict_end);
+		recEvictPtr = evict_end;
+	}
+}
+
 ////////////////////////////////////////////////////
 static void recResetRaw()
 {
 	Console.WriteLn(Color_StrongBlack, "EE/iR5900 Recompiler Reset");
+	recReportCodeDensity();
 
 	if (CHECK_EXTRAMEM != extraRam)
 	{
@@ -580,6 +940,8 @@ static void recResetRaw()
 	_DynGen_Dispatchers();
 	vtlb_DynGenDispatchers();
 	recPtr = xGetPtr();
+	recCodeStart = recPtr;
+	recEvictPtr = SysMemory::GetEERecEnd();
 
 	ClearRecLUT(reinterpret_cast<BASEBLOCK*>(recLutReserve_RAM.data()), recLutSize);
 	recRAMCopy.fill(0);
@@ -591,16 +953,25 @@ static void recResetRaw()
 
 	recBlocks.Reset();
 	vtlb_ClearLoadStoreInfo();
+	vtlb_UpdateMemcheckProtection();
 
 	g_branch = 0;
 	g_resetEeScalingStats = true;
 
 	memset(manual_page, 0, sizeof(manual_page));
 	memset(manual_counter, 0, sizeof(manual_counter));
+
+	s_hot_blocks.clear();
+	s_trace_blocks_exist = false;
+	s_checked_blocks.clear();
 }
 
 void recShutdown()
 {
+	recCloseBlockCache();
+	s_wait_loops.Export("ee");
+	recReportCodeDensity();
+
 	recRAMCopy.deallocate();
 	recLutReserve_RAM.deallocate();
 
@@ -652,6 +1023,11 @@ static void recSafeExitExecution()
 
 static void recResetEE()
 {
+	// Resets come from the VM being reset or a new ELF starting, so whatever is running next
+	// is a different program. Cache-full evictions from recRecompile() don't go through here.
+	recCloseBlockCache();
+	s_wait_loops.Export("ee");
+
 	if (eeCpuExecuting)
 	{
 		// get outta here as soon as we can
@@ -761,6 +1137,16 @@ void recClear(u32 addr, u32 size)
 
 		if (blockend <= addr)
 		{
+			// Blocks in the gap of a trace block end before it does, keep walking the page.
+			if (s_trace_blocks_exist && blockstart >= (addr & ~0xfffu))
+			{
+				if (toRemoveLast != blockidx)
+					recBlocks.Remove((blockidx + 1), toRemoveLast);
+				s_trace_kept_blocks.emplace_back(blockstart, pexblock->fnptr);
+				toRemoveLast = --blockidx;
+				continue;
+			}
+
 			lowerextent = std::max(lowerextent, blockend);
 			break;
 		}
@@ -793,6 +1179,10 @@ void recClear(u32 addr, u32 size)
 
 	if (upperextent > lowerextent)
 		ClearRecLUT(PC_GETBLOCK(lowerextent), upperextent - lowerextent);
+
+	for (const auto& [blockstart, fnptr] : s_trace_kept_blocks)
+		PC_GETBLOCK(blockstart)->SetFnptr(fnptr);
+	s_trace_kept_blocks.clear();
 }
 
 
@@ -885,8 +1275,9 @@ void SetBranchImm(u32 imm)
 
 u8* recBeginThunk()
 {
-	// if recPtr reached the mem limit reset whole mem
-	if (recPtr >= recPtrEnd)
+	// Thunks are emitted from the fault handler where nothing can be evicted, so fall back
+	// to a full reset once they start eating into the headroom kept ahead of recPtr.
+	if (recPtr >= recPtrEnd || (recPtr + _64kb) > recEvictPtr)
 		eeRecNeedsReset = true;
 
 	xSetPtr(recPtr);
@@ -1360,6 +1751,9 @@ static void iBranchTest(u32 newpc)
 
 	if (EmuConfig.Speedhacks.WaitLoop && s_nBlockFF && newpc == s_branchTo)
 	{
+		if (s_wait_loop_hits)
+			xADD(ptr32[s_wait_loop_hits], 1);
+
 		xMOV(eax, ptr32[&cpuRegs.nextEventCycle]);
 		xADD(ptr32[&cpuRegs.cycle], scaleblockcycles());
 		xCMP(eax, ptr32[&cpuRegs.cycle]);
@@ -1378,7 +1772,7 @@ static void iBranchTest(u32 newpc)
 		if (newpc == 0xffffffff)
 			xJS(DispatcherReg);
 		else
-			recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed));
+			recBlocks.Link(HWADDR(newpc), xJcc32(Jcc_Signed), s_pCurBlockEx->startpc);
 
 		xJMP((void*)DispatcherEvent);
 	}
@@ -2001,6 +2395,88 @@ void dyna_page_reset(u32 start, u32 sz)
 	mmap_MarkCountedRamPage(start);
 }
 
+// Writes to a write protected page only invalidate the blocks overlapping the written line.
+// Protection is dropped for the whole page, so the other blocks are switched over to check
+// their code against recRAMCopy on entry, which is the same test a manual block does but
+// without recompiling them.
+static constexpr u32 CODE_WRITE_LINE_SIZE = 128;
+static constexpr u32 MAX_CHECKED_BLOCKS_PER_PAGE = 64;
+
+static bool recCheckBlockCode(u32 startpc, u32 size)
+{
+	return (std::memcmp(&recRAMCopy[startpc / 4], PSM(startpc), size * 4) == 0);
+}
+
+static void recClearWrittenPage(u32 pageaddr, u32 writeaddr)
+{
+	const u32 line = writeaddr & ~(CODE_WRITE_LINE_SIZE - 1);
+
+	std::vector<std::pair<u32, u32>> cleared, kept;
+	for (int i = recBlocks.LastIndex(pageaddr + __pagesize - 4); const BASEBLOCKEX* block = recBlocks[i]; i--)
+	{
+		if (block->startpc < pageaddr)
+			break;
+
+		const u32 blockend = block->startpc + block->size * 4;
+		if (block->startpc < (line + CODE_WRITE_LINE_SIZE) && blockend > line)
+			cleared.emplace_back(block->startpc, block->size);
+		else
+			kept.emplace_back(block->startpc, block->size);
+	}
+
+	if (kept.size() > MAX_CHECKED_BLOCKS_PER_PAGE)
+	{
+		recClear(pageaddr, __pagesize);
+		return;
+	}
+
+	for (const auto& [startpc, size] : cleared)
+		recClear(startpc, std::max<u32>(size, 1));
+
+	if (kept.empty())
+		return;
+
+	recBeginThunk();
+
+	for (const auto& [startpc, size] : kept)
+	{
+		BASEBLOCKEX* block = recBlocks.Get(startpc);
+		if (!block || block->startpc != startpc)
+			continue;
+
+		u8* entry = xGetPtr();
+		xFastCall((void*)recCheckBlockCode, startpc, size);
+		xMOV(arg1regd, startpc);
+		xMOV(arg2regd, size);
+		xTEST(al, al);
+		xJZ(DispatchBlockDiscard);
+		xJMP((void*)block->fnptr);
+
+		s_checked_blocks[startpc] = {block->fnptr, block->x86size};
+		PC_GETBLOCK(startpc)->SetFnptr((uptr)entry);
+		recBlocks.Relink(block, (uptr)entry);
+	}
+
+	recEndThunk();
+
+	eeRecPerfLog.Write("Write to protected page @ %08X : cleared %zu blocks, %zu blocks now checked", writeaddr,
+		cleared.size(), kept.size());
+}
+
+// Called when a counted block has run often enough to be recompiled as a hot block.
+// cpuRegs.pc is the start of the block, since the counter is checked in the prologue.
+static void recPromoteHotBlock()
+{
+	const u32 startpc = cpuRegs.pc;
+	const BASEBLOCKEX* block = recBlocks.Get(HWADDR(startpc));
+	if (!block || block->startpc != HWADDR(startpc))
+		return;
+
+	eeRecPerfLog.Write("Promoting hot block @ %08X : size=%d insts", startpc, block->size);
+	s_hot_blocks.insert(HWADDR(startpc));
+	recClear(startpc, std::max<u32>(block->size, 1));
+}
+
 static void memory_protect_recompiled_code(u32 startpc, u32 size)
 {
 	u32 inpage_ptr = HWADDR(startpc);
@@ -2120,6 +2596,9 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 
 	DevCon.WriteLn("[EE] Skipping timeout loop at 0x%08X -> 0x%08X", s_pCurBlockEx->startpc, s_nEndBlock);
 
+	if (u32* hits = s_wait_loops.Add(s_pCurBlockEx->startpc, s_nEndBlock))
+		xADD(ptr32[hits], 1);
+
 	// basically, if the time it takes the loop to run is shorter than the
 	// time to the next event, then we want to skip ahead to the event, but
 	// update v0 to reflect how long the loop would have run for.
@@ -2155,7 +2634,7 @@ static bool recSkipTimeoutLoop(s32 reg, bool is_timeout_loop)
 	xMOV(ptr32[&cpuRegs.GPR.r[reg].UL[0]], edx); // write back new value of v0
 	xJNZ((void*)DispatcherEvent); // jump to dispatcher if new v0 is not zero (i.e. an event)
 	xMOV(ptr32[&cpuRegs.pc], s_nEndBlock); // otherwise end of loop
-	recBlocks.Link(HWADDR(s_nEndBlock), xJcc32());
+	recBlocks.Link(HWADDR(s_nEndBlock), xJcc32(), s_pCurBlockEx->startpc);
 
 	g_branch = 1;
 	pc = s_nEndBlock;
@@ -2170,11 +2649,8 @@ static void recRecompile(const u32 startpc)
 
 	pxAssert(startpc);
 
-	// if recPtr reached the mem limit reset whole mem
-	if (recPtr >= recPtrEnd)
-		eeRecNeedsReset = true;
-
-	if (HWADDR(startpc) == VMManager::Internal::GetCurrentELFEntryPoint())
+	const bool is_entry_point = (HWADDR(startpc) == VMManager::Internal::GetCurrentELFEntryPoint());
+	if (is_entry_point)
 		VMManager::Internal::EntryPointCompilingOnCPUThread();
 
 	if (eeRecNeedsReset)
@@ -2183,10 +2659,24 @@ static void recRecompile(const u32 startpc)
 		recResetRaw();
 	}
 
+	// if recPtr reached the mem limit, reclaim the oldest code
+	recReclaimCodeSpace();
+
+	if (is_entry_point && s_block_cache_path.empty() && EmuConfig.Cpu.Recompiler.EnableEEBlockCache)
+	{
+		s_block_cache_path = recGetBlockCachePath();
+		if (!s_block_cache_path.empty())
+		{
+			recLoadBlockCache();
+			s_block_cache_preload_pending = !s_block_cache_loaded.empty();
+		}
+	}
+
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
 
 	s_pCurBlock = PC_GETBLOCK(startpc);
+	s_nStartBlock = startpc;
 
 	pxAssert(s_pCurBlock->GetFnptr() == (uptr)JITCompile);
 
@@ -2194,6 +2684,7 @@ static void recRecompile(const u32 startpc)
 	pxAssert(!s_pCurBlockEx || s_pCurBlockEx->startpc != HWADDR(startpc));
 
 	s_pCurBlockEx = recBlocks.New(HWADDR(startpc), (uptr)recPtr);
+	s_checked_blocks.erase(HWADDR(startpc));
 
 	pxAssert(s_pCurBlockEx);
 
@@ -2265,6 +2756,16 @@ static void recRecompile(const u32 startpc)
 	s_nEndBlock = 0xffffffff;
 	s_branchTo = -1;
 
+	// Blocks which emitted hooks above can't be restarted through promotion.
+	const bool is_hot_block = EmuConfig.Cpu.Recompiler.EnableEEHotBlocks && recIsHotBlock(startpc);
+	const bool can_promote = EmuConfig.Cpu.Recompiler.EnableEEHotBlocks && !is_hot_block &&
+							 HWADDR(startpc) < Ps2MemSize::ExposedRam && xGetPtr() == recPtr;
+	bool split_at_block = false;
+	bool ends_in_trace_jump = false;
+	bool has_cop2_in_scan = false;
+	s_hot_block_fused.clear();
+	s_trace_jumps.clear();
+
 	// Timeout loop speedhack.
 	// God of War 2 and other games (e.g. NFS series) have these timeout loops which just spin for a few thousand
 	// iterations, usually after kicking something which results in an IRQ, but instead of cancelling the loop,
@@ -2319,9 +2820,17 @@ static void recRecompile(const u32 startpc)
 
 			if (pblock->GetFnptr() != (uptr)JITCompile)
 			{
-				willbranch3 = 1;
-				s_nEndBlock = i;
-				break;
+				if (is_hot_block)
+				{
+					s_hot_block_fused.push_back(i);
+				}
+				else
+				{
+					willbranch3 = 1;
+					s_nEndBlock = i;
+					split_at_block = true;
+					break;
+				}
 			}
 		}
 
@@ -2350,6 +2859,8 @@ static void recRecompile(const u32 startpc)
 			}
 		}
 
+		has_cop2_in_scan |= (_Opcode_ == 022 || _Opcode_ == 066 || _Opcode_ == 076);
+
 		switch (cpuRegs.code >> 26)
 		{
 			case 0: // special
@@ -2383,6 +2894,18 @@ static void recRecompile(const u32 startpc)
 			case 2: // J
 			case 3: // JAL
 				s_branchTo = (_InstrucTarget_ << 2) | ((i + 4) & 0xf0000000);
+				if ((cpuRegs.code >> 26) == 2 && EmuConfig.Cpu.Recompiler.EnableEEHotBlocks &&
+					recCanTraceJump(startpc, i, s_branchTo))
+				{
+					if (is_hot_block && s_trace_jumps.size() < MAX_TRACE_JUMPS)
+					{
+						s_trace_jumps.emplace_back(i, s_branchTo);
+						i = s_branchTo;
+						continue;
+					}
+
+					ends_in_trace_jump = true;
+				}
 				s_nEndBlock = i + 8;
 				goto StartRecomp;
 
@@ -2437,12 +2960,41 @@ static void recRecompile(const u32 startpc)
 
 StartRecomp:
 
+	// The trace has to end after the last jump target, and going through blocks after a
+	// trace jump is not supported. COP2 passes also assume straight-line code.
+	if (!s_trace_jumps.empty() &&
+		(s_nEndBlock <= s_trace_jumps.back().second || has_cop2_in_scan ||
+			(!s_hot_block_fused.empty() && s_hot_block_fused.back() > s_trace_jumps.front().first)))
+	{
+		willbranch3 = 0;
+		s_nEndBlock = s_trace_jumps.front().first + 8;
+		s_branchTo = s_trace_jumps.front().second;
+		s_trace_jumps.clear();
+		while (!s_hot_block_fused.empty() && s_hot_block_fused.back() >= s_nEndBlock)
+			s_hot_block_fused.pop_back();
+	}
+	if (!s_trace_jumps.empty())
+	{
+		is_timeout_loop = false;
+		s_trace_blocks_exist = true;
+		eeRecPerfLog.Write("Trace block @ %08X : %zu jumps, ends at %08X", startpc, s_trace_jumps.size(), s_nEndBlock);
+	}
+
+	// Fall back to splitting at the first existing block if going through them isn't safe.
+	if (!s_hot_block_fused.empty() && !recCanFuseHotBlock(s_nEndBlock))
+	{
+		willbranch3 = 1;
+		s_nEndBlock = s_hot_block_fused.front();
+		s_branchTo = -1;
+		is_timeout_loop = false;
+	}
+
 	// The idea here is that as long as a loop doesn't write to a register it's already read
 	// (excepting registers initialised with constants or memory loads) or use any instructions
 	// which alter the machine state apart from registers, it will do the same thing on every
 	// iteration.
 	s_nBlockFF = false;
-	if (s_branchTo == startpc)
+	if (s_branchTo == startpc && s_trace_jumps.empty())
 	{
 		s_nBlockFF = true;
 
@@ -2524,6 +3076,10 @@ StartRecomp:
 		is_timeout_loop = false;
 	}
 
+	s_wait_loop_hits = (EmuConfig.Speedhacks.WaitLoop && s_nBlockFF) ? s_wait_loops.Add(startpc, s_nEndBlock) : nullptr;
+	if (s_wait_loop_hits)
+		eeRecPerfLog.Write("Wait loop @ %08X -> %08X", startpc, s_nEndBlock);
+
 	// rec info //
 	bool has_cop2_instructions = false;
 	{
@@ -2535,18 +3091,32 @@ StartRecomp:
 			pxAssert(s_pInstCache != NULL);
 		}
 
-		EEINST* pcur = s_pInstCache + (s_nEndBlock - startpc) / 4;
+		// Trace blocks skip the gaps, so the instruction info is laid out in execution order.
+		u32 num_insts = (s_nEndBlock - startpc) / 4;
+		for (const auto& [trace_pc, trace_target] : s_trace_jumps)
+			num_insts -= (trace_target - (trace_pc + 8)) / 4;
+
+		EEINST* pcur = s_pInstCache + num_insts;
 		_recClearInst(pcur);
 		pcur->info = 0;
 
-		for (i = s_nEndBlock; i > startpc; i -= 4)
+		// Lookahead past the end of a trace reads the end state.
+		for (u32 j = num_insts + 1; j <= (s_nEndBlock - startpc) / 4; j++)
+			s_pInstCache[j] = *pcur;
+
+		for (size_t seg = s_trace_jumps.size() + 1; seg-- > 0;)
 		{
-			cpuRegs.code = *(int*)PSM(i - 4);
-			pcur[-1] = pcur[0];
-			recBackpropBSC(cpuRegs.code, pcur - 1, pcur);
-			pcur--;
+			const u32 seg_start = (seg == 0) ? startpc : s_trace_jumps[seg - 1].second;
+			const u32 seg_end = (seg == s_trace_jumps.size()) ? s_nEndBlock : (s_trace_jumps[seg].first + 8);
+			for (i = seg_end; i > seg_start; i -= 4)
+			{
+				cpuRegs.code = *(int*)PSM(i - 4);
+				pcur[-1] = pcur[0];
+				recBackpropBSC(cpuRegs.code, pcur - 1, pcur);
+				pcur--;
 
-			has_cop2_instructions |= (_Opcode_ == 022 || _Opcode_ == 066 || _Opcode_ == 076);
+				has_cop2_instructions |= (_Opcode_ == 022 || _Opcode_ == 066 || _Opcode_ == 076);
+			}
 		}
 	}
 
@@ -2584,6 +3154,9 @@ StartRecomp:
 	// Skip Recompilation if sceMpegIsEnd Pattern detected
 	const bool doRecompilation = !skipMPEG_By_Pattern(startpc) && !recSkipTimeoutLoop(timeout_reg, is_timeout_loop);
 
+	if (doRecompilation && can_promote && (split_at_block || ends_in_trace_jump))
+		recEmitHotBlockCounter(startpc);
+
 	if (doRecompilation)
 	{
 		// Finally: Generate x86 recompiled code!
@@ -2652,7 +3225,11 @@ StartRecomp:
 			if (oldBlock->startpc >= HWADDR(pc))
 				continue;
 			if ((oldBlock->startpc + oldBlock->size * 4) <= HWADDR(startpc))
+			{
+				if (s_trace_blocks_exist && oldBlock->startpc >= (HWADDR(startpc) & ~0xfffu))
+					continue;
 				break;
+			}
 
 			if (memcmp(&recRAMCopy[oldBlock->startpc / 4], PSM(oldBlock->startpc),
 					oldBlock->size * 4))
@@ -2706,7 +3283,7 @@ StartRecomp:
 			{
 				xMOV(ptr32[&cpuRegs.pc], pc);
 				xADD(ptr32[&cpuRegs.cycle], scaleblockcycles());
-				recBlocks.Link(HWADDR(pc), xJcc32());
+				recBlocks.Link(HWADDR(pc), xJcc32(), s_pCurBlockEx->startpc);
 			}
 		}
 	}
@@ -2714,6 +3291,8 @@ StartRecomp:
 	pxAssert(xGetPtr() < SysMemory::GetEERecEnd());
 
 	s_pCurBlockEx->x86size = static_cast<u32>(xGetPtr() - recPtr);
+	s_code_guest_insts += s_pCurBlockEx->size;
+	s_code_host_bytes += s_pCurBlockEx->x86size;
 
 #if 0
 	// Example: Dump both x86/EE code
@@ -2721,7 +3300,13 @@ StartRecomp:
 		iDumpBlock(s_pCurBlockEx->startpc, s_pCurBlockEx->size*4, s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size);
 	}
 #endif
-	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	if (Perf::IsEnabled())
+	{
+		const FunctionInfo function = R5900SymbolGuardian.FunctionOverlappingAddress(s_pCurBlockEx->startpc);
+		Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc,
+			function.name.c_str(), function.address.value);
+	}
+	recRecordCachedBlock(s_pCurBlockEx->startpc, s_pCurBlockEx->size);
 
 	recPtr = xGetPtr();
 
@@ -2729,6 +3314,13 @@ StartRecomp:
 
 	s_pCurBlock = nullptr;
 	s_pCurBlockEx = nullptr;
+
+	// Keep headroom ahead of recPtr for any thunks the fault handler emits before the next block.
+	recReclaimCodeSpace();
+
+	// The entry point block is done, the dispatcher will jump to it once we return.
+	if (std::exchange(s_block_cache_preload_pending, false))
+		recPreloadCachedBlocks();
 }
 
 R5900cpu recCpu = {
@@ -2741,4 +3333,5 @@ R5900cpu recCpu = {
 
 	recSafeExitExecution,
 	recCancelInstruction,
-	recClear};
+	recClear,
+	recClearWrittenPage};
@@ -32,7 +32,10 @@ void recJ()
 
 	// SET_FPUSTATE;
 	u32 newpc = (_InstrucTarget_ << 2) + (pc & 0xf0000000);
+	const u32 jumppc = pc - 4;
 	recompileNextInstruction(true, false);
+	if (recTryTraceJump(jumppc, newpc))
+		return;
 	if (EmuConfig.Gamefixes.GoemonTlbHack)
 		SetBranchImm(vtlb_V2P(newpc));
 	else
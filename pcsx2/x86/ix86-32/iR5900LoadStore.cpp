@@ -415,10 +415,11 @@ void recSWL()
 
 	// If we're not using fastmem, we need to flush early. Because the first read
 	// (which would flush) happens inside a branch.
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 		iFlushCall(FLUSH_FULLVTLB);
 
-	xForwardJE8 skip;
+	// the slow path read with cache emulation doesn't fit in a short jump
+	xForwardJE32 skip;
 	xSHL(temp, 3);
 
 	vtlb_DynGenReadNonQuad(32, false, false, arg1regd.GetId(), RETURN_READ_IN_RAX);
@@ -490,10 +491,11 @@ void recSWR()
 
 	// If we're not using fastmem, we need to flush early. Because the first read
 	// (which would flush) happens inside a branch.
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 		iFlushCall(FLUSH_FULLVTLB);
 
-	xForwardJE8 skip;
+	// the slow path read with cache emulation doesn't fit in a short jump
+	xForwardJE32 skip;
 	xSHL(temp, 3);
 
 	vtlb_DynGenReadNonQuad(32, false, false, arg1regd.GetId(), RETURN_READ_IN_RAX);
@@ -826,10 +828,11 @@ void recSDL()
 
 		// If we're not using fastmem, we need to flush early. Because the first read
 		// (which would flush) happens inside a branch.
-		if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+		if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 			iFlushCall(FLUSH_FULLVTLB);
 
-		xForwardJE8 skip;
+		// the slow path read with cache emulation doesn't fit in a short jump
+		xForwardJE32 skip;
 		xADD(temp1, 1);
 		vtlb_DynGenReadNonQuad(64, false, false, arg1regd.GetId(), RETURN_READ_IN_RAX);
 
@@ -912,10 +915,11 @@ void recSDR()
 
 		// If we're not using fastmem, we need to flush early. Because the first read
 		// (which would flush) happens inside a branch.
-		if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+		if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 			iFlushCall(FLUSH_FULLVTLB);
 
-		xForwardJE8 skip;
+		// the slow path read with cache emulation doesn't fit in a short jump
+		xForwardJE32 skip;
 		vtlb_DynGenReadNonQuad(64, false, false, arg1regd.GetId(), RETURN_READ_IN_RAX);
 
 		xMOV(edx, 64);
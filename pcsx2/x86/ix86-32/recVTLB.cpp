@@ -2,12 +2,15 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "ps2/HwInternal.h"
 #include "vtlb.h"
 #include "x86/iCore.h"
 #include "x86/iR5900.h"
 
 #include "common/Perf.h"
 
+#include <type_traits>
+
 using namespace vtlb_private;
 using namespace x86Emitter;
 
@@ -116,13 +119,54 @@ static void __vectorcall LogWriteQuad(u32 addr, __m128i val)
 }
 #endif
 
+// ------------------------------------------------------------------------
+// Data cache helpers, used by compiled loads/stores while EE cache emulation is on.
+// vtlb_memRead/Write do the cached TLB check, the tag compare and line fill/writeback;
+// reads are extended here so rax matches what the direct and indirect paths return.
+template <typename T, bool sign>
+static u64 vtlb_CachedRead(u32 addr)
+{
+	const T value = vtlb_memRead<T>(addr);
+	if constexpr (sign)
+		return static_cast<u64>(static_cast<s64>(static_cast<std::make_signed_t<T>>(value)));
+	else
+		return value;
+}
+
+static const void* GetCachedReadPtr(u32 bits, bool sign)
+{
+	switch (bits)
+	{
+		case   8: return sign ? (void*)vtlb_CachedRead<mem8_t, true> : (void*)vtlb_CachedRead<mem8_t, false>;
+		case  16: return sign ? (void*)vtlb_CachedRead<mem16_t, true> : (void*)vtlb_CachedRead<mem16_t, false>;
+		case  32: return sign ? (void*)vtlb_CachedRead<mem32_t, true> : (void*)vtlb_CachedRead<mem32_t, false>;
+		case  64: return (void*)vtlb_CachedRead<mem64_t, false>;
+		case 128: return (void*)vtlb_memRead128;
+		jNO_DEFAULT
+	}
+	return nullptr;
+}
+
+static const void* GetCachedWritePtr(u32 bits)
+{
+	switch (bits)
+	{
+		case   8: return (void*)vtlb_memWrite<mem8_t>;
+		case  16: return (void*)vtlb_memWrite<mem16_t>;
+		case  32: return (void*)vtlb_memWrite<mem32_t>;
+		case  64: return (void*)vtlb_memWrite<mem64_t>;
+		case 128: return (void*)vtlb_memWrite128;
+		jNO_DEFAULT
+	}
+	return nullptr;
+}
+
 namespace vtlb_private
 {
 	// ------------------------------------------------------------------------
-	// Prepares eax, ecx, and, ebx for Direct or Indirect operations.
-	// Returns the writeback pointer for ebx (return address from indirect handling)
+	// Moves the guest address into arg1 and the store value (if any) into arg2/xmm arg1.
 	//
-	static void DynGen_PrepRegs(int addr_reg, int value_reg, u32 sz, bool xmm)
+	static void DynGen_PrepArgs(int addr_reg, int value_reg, u32 sz, bool xmm)
 	{
 		EE::Profiler.EmitMem();
 
@@ -150,13 +194,29 @@ namespace vtlb_private
 				xMOV(arg2reg, xRegister64(value_reg));
 			}
 		}
+	}
 
+	// ------------------------------------------------------------------------
+	// Turns the guest address in arg1 into a host pointer (or handler entry) via the vmap.
+	//
+	static void DynGen_VmapLookup()
+	{
 		xMOV(eax, arg1regd);
 		xSHR(eax, VTLB_PAGE_BITS);
 		xMOV(rax, ptrNative[xComplexAddress(arg3reg, vtlbdata.vmap, rax * wordsize)]);
 		xADD(arg1reg, rax);
 	}
 
+	// ------------------------------------------------------------------------
+	// Prepares eax, ecx, and, ebx for Direct or Indirect operations.
+	// Returns the writeback pointer for ebx (return address from indirect handling)
+	//
+	static void DynGen_PrepRegs(int addr_reg, int value_reg, u32 sz, bool xmm)
+	{
+		DynGen_PrepArgs(addr_reg, value_reg, sz, xmm);
+		DynGen_VmapLookup();
+	}
+
 	// ------------------------------------------------------------------------
 	static void DynGen_DirectRead(u32 bits, bool sign)
 	{
@@ -267,6 +327,24 @@ static void DynGen_HandlerTest(const GenDirectFn& gen_direct, int mode, int bits
 	done.SetTarget();
 }
 
+// ------------------------------------------------------------------------
+// Inline guard for cache emulation: while the guest keeps the data cache off in COP0 Config
+// the access stays on the vmap path, otherwise the cache helper takes over. Expects the
+// guest address in arg1 (not yet looked up) and the value in the argument registers.
+//
+template <typename GenUncachedFn>
+static void DynGen_CacheTest(const void* cached_fn, const GenUncachedFn& gen_uncached)
+{
+	xTEST(ptr8[reinterpret_cast<u8*>(&cpuRegs.CP0.n.Config) + 2], 1);
+	xForwardJNZ32 to_cache;
+	DynGen_VmapLookup();
+	gen_uncached();
+	xForwardJump32 done;
+	to_cache.SetTarget();
+	xFastCall(cached_fn);
+	done.SetTarget();
+}
+
 // ------------------------------------------------------------------------
 // Generates the various instances of the indirect dispatchers
 // In: arg1reg: vtlb entry, arg2reg: data ptr (if mode >= 64), rbx: function return ptr
@@ -369,12 +447,22 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 	pxAssume(bits <= 64);
 
 	int x86_dest_reg;
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
-		DynGen_PrepRegs(addr_reg, -1, bits, xmm);
-		DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign && bits < 64);
+		if (CHECK_CACHE)
+		{
+			DynGen_PrepArgs(addr_reg, -1, bits, xmm);
+			DynGen_CacheTest(GetCachedReadPtr(bits, sign && bits < 64), [bits, sign]() {
+				DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign && bits < 64);
+			});
+		}
+		else
+		{
+			DynGen_PrepRegs(addr_reg, -1, bits, xmm);
+			DynGen_HandlerTest([bits, sign]() { DynGen_DirectRead(bits, sign); }, 0, bits, sign && bits < 64);
+		}
 
 		if (!xmm)
 		{
@@ -432,7 +520,7 @@ int vtlb_DynGenReadNonQuad(u32 bits, bool sign, bool xmm, int addr_reg, vtlb_Rea
 		xNOP();
 
 	vtlb_AddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
-		pc, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
+		pc, s_nStartBlock, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
 		static_cast<u8>(addr_reg), static_cast<u8>(x86_dest_reg),
 		static_cast<u8>(bits), sign, true, xmm);
 
@@ -453,7 +541,24 @@ int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const,
 
 	int x86_dest_reg;
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		// Cacheability depends on the TLB and COP0 Config at run time, let the helper decide.
+		iFlushCall(FLUSH_FULLVTLB);
+		xFastCall(GetCachedReadPtr(bits, sign && bits < 64), addr_const);
+
+		if (!xmm)
+		{
+			x86_dest_reg = dest_reg_alloc ? dest_reg_alloc() : (_freeX86reg(eax), eax.GetId());
+			xMOV(xRegister64(x86_dest_reg), rax);
+		}
+		else
+		{
+			x86_dest_reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
+			xMOVDZX(xRegisterSSE(x86_dest_reg), eax);
+		}
+	}
+	else if (!vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
 		if (!xmm)
@@ -498,20 +603,21 @@ int vtlb_DynGenReadNonQuad_Const(u32 bits, bool sign, bool xmm, u32 addr_const,
 			case 64: szidx = 3; break;
 		}
 
-		// Shortcut for the INTC_STAT register, which many games like to spin on heavily.
-		if ((bits == 32) && !EmuConfig.Speedhacks.IntcStat && (paddr == INTC_STAT))
+		// Shortcut for the INTC_STAT register, which many games like to spin on heavily, and the
+		// DMAC/INTC registers which the handlers return unmodified, mostly polled D_STAT/CHCR.
+		if ((bits == 32) && ((!EmuConfig.Speedhacks.IntcStat && (paddr == INTC_STAT)) || hwIsDirectRead32(paddr)))
 		{
 			x86_dest_reg = dest_reg_alloc ? dest_reg_alloc() : (_freeX86reg(eax), eax.GetId());
 			if (!xmm)
 			{
 				if (sign)
-					xMOVSX(xRegister64(x86_dest_reg), ptr32[&psHu32(INTC_STAT)]);
+					xMOVSX(xRegister64(x86_dest_reg), ptr32[&psHu32(paddr)]);
 				else
-					xMOV(xRegister32(x86_dest_reg), ptr32[&psHu32(INTC_STAT)]);
+					xMOV(xRegister32(x86_dest_reg), ptr32[&psHu32(paddr)]);
 			}
 			else
 			{
-				xMOVDZX(xRegisterSSE(x86_dest_reg), ptr32[&psHu32(INTC_STAT)]);
+				xMOVDZX(xRegisterSSE(x86_dest_reg), ptr32[&psHu32(paddr)]);
 			}
 		}
 		else
@@ -557,12 +663,22 @@ int vtlb_DynGenReadQuad(u32 bits, int addr_reg, vtlb_ReadRegAllocCallback dest_r
 {
 	pxAssume(bits == 128);
 
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
-		DynGen_PrepRegs(arg1regd.GetId(), -1, bits, true);
-		DynGen_HandlerTest([bits]() {DynGen_DirectRead(bits, false); },  0, bits);
+		if (CHECK_CACHE)
+		{
+			DynGen_PrepArgs(arg1regd.GetId(), -1, bits, true);
+			DynGen_CacheTest(GetCachedReadPtr(bits, false), [bits]() {
+				DynGen_HandlerTest([bits]() { DynGen_DirectRead(bits, false); }, 0, bits);
+			});
+		}
+		else
+		{
+			DynGen_PrepRegs(arg1regd.GetId(), -1, bits, true);
+			DynGen_HandlerTest([bits]() {DynGen_DirectRead(bits, false); },  0, bits);
+		}
 
 		const int reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0); // Handler returns in xmm0
 		if (reg >= 0)
@@ -581,7 +697,7 @@ int vtlb_DynGenReadQuad(u32 bits, int addr_reg, vtlb_ReadRegAllocCallback dest_r
 		xNOP();
 
 	vtlb_AddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
-		pc, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
+		pc, s_nStartBlock, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
 		static_cast<u8>(arg1reg.GetId()), static_cast<u8>(reg),
 		static_cast<u8>(bits), false, true, true);
 
@@ -600,7 +716,15 @@ int vtlb_DynGenReadQuad_Const(u32 bits, u32 addr_const, vtlb_ReadRegAllocCallbac
 
 	int reg;
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (CHECK_CACHE && !vmv.isHandler(addr_const))
+	{
+		iFlushCall(FLUSH_FULLVTLB);
+		xFastCall(GetCachedReadPtr(bits, false), addr_const);
+
+		reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
+		xMOVAPS(xRegisterSSE(reg), xmm0);
+	}
+	else if (!vmv.isHandler(addr_const))
 	{
 		void* ppf = reinterpret_cast<void*>(vmv.assumePtr(addr_const));
 		reg = dest_reg_alloc ? dest_reg_alloc() : (_freeXMMreg(0), 0);
@@ -682,12 +806,22 @@ void vtlb_DynGenWrite(u32 sz, bool xmm, int addr_reg, int value_reg)
 	}
 #endif
 
-	if (!CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
+	if (CHECK_CACHE || !CHECK_FASTMEM || vtlb_IsFaultingPC(pc))
 	{
 		iFlushCall(FLUSH_FULLVTLB);
 
-		DynGen_PrepRegs(addr_reg, value_reg, sz, xmm);
-		DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, 1, sz);
+		if (CHECK_CACHE)
+		{
+			DynGen_PrepArgs(addr_reg, value_reg, sz, xmm);
+			DynGen_CacheTest(GetCachedWritePtr(sz), [sz]() {
+				DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, 1, sz);
+			});
+		}
+		else
+		{
+			DynGen_PrepRegs(addr_reg, value_reg, sz, xmm);
+			DynGen_HandlerTest([sz]() { DynGen_DirectWrite(sz); }, 1, sz);
+		}
 		return;
 	}
 
@@ -735,7 +869,7 @@ void vtlb_DynGenWrite(u32 sz, bool xmm, int addr_reg, int value_reg)
 		xNOP();
 
 	vtlb_AddLoadStoreInfo((uptr)codeStart, static_cast<u32>(x86Ptr - codeStart),
-		pc, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
+		pc, s_nStartBlock, GetAllocatedGPRBitmask(), GetAllocatedXMMBitmask(),
 		static_cast<u8>(addr_reg), static_cast<u8>(value_reg),
 		static_cast<u8>(sz), false, false, xmm);
 }
@@ -804,7 +938,7 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 #endif
 
 	auto vmv = vtlbdata.vmap[addr_const >> VTLB_PAGE_BITS];
-	if (!vmv.isHandler(addr_const))
+	if (!CHECK_CACHE && !vmv.isHandler(addr_const))
 	{
 		auto ppf = vmv.assumePtr(addr_const);
 		if (!xmm)
@@ -848,8 +982,11 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 	}
 	else
 	{
+		// Direct memory only gets here with cache emulation, which goes through the cache helper.
+		const bool handler = vmv.isHandler(addr_const);
+
 		// has to: translate, find function, call function
-		u32 paddr = vmv.assumeHandlerGetPAddr(addr_const);
+		u32 paddr = handler ? vmv.assumeHandlerGetPAddr(addr_const) : addr_const;
 
 		int szidx = 0;
 		switch (bits)
@@ -894,7 +1031,7 @@ void vtlb_DynGenWrite_Const(u32 bits, bool xmm, u32 addr_const, int value_reg)
 			xMOV(arg2reg, xRegister64(value_reg));
 		}
 
-		xFastCall(vmv.assumeHandlerGetRaw(szidx, true));
+		xFastCall(handler ? vmv.assumeHandlerGetRaw(szidx, true) : GetCachedWritePtr(bits));
 	}
 }
 
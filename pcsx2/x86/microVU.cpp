@@ -2,10 +2,17 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "microVU.h"
+#include "VMManager.h"
 
+#include "GS/GSXXH.h"
 #include "common/AlignedMalloc.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
 #include "common/Perf.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
 
 //------------------------------------------------------------------
 // Micro VU - Main Functions
@@ -42,6 +49,9 @@ void mVUreset(microVU& mVU, bool resetReserve)
 		VU0.VI[REG_VPU_STAT].UL &= ~0x100;
 	}
 
+	// Programs are about to be thrown away, remember them for the next boot first
+	mVUsaveProgramCache(mVU);
+
 	xSetPtr(mVU.cache);
 	mVUdispatcherAB(mVU);
 	mVUdispatcherCD(mVU);
@@ -301,6 +311,337 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 	return mVUentryGet(mVU, quick.block, startPC, pState);
 }
 
+//------------------------------------------------------------------
+// Micro VU - Program Cache
+//------------------------------------------------------------------
+// Compiled blocks embed absolute host addresses, so instead of the code we persist the
+// microcode of each VU1 program (only the recompiled ranges) together with the start PC and
+// pipeline state of every block that was compiled for it. On the next boot of the same game
+// the programs are recompiled from that data as soon as the entry point is reached, and are
+// then found by mVUsearchProg() like any other cached program.
+
+namespace
+{
+#pragma pack(push, 1)
+	struct ProgramCacheHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 gamefixes;
+		u32 settings;
+		u32 num_programs;
+	};
+
+	struct ProgramCacheRecord
+	{
+		u32 start_pc;
+		u32 num_ranges;
+		u32 num_words;
+		u32 num_blocks;
+	};
+
+	struct ProgramCacheBlock
+	{
+		u32 pc;
+		microRegInfo pState;
+	};
+#pragma pack(pop)
+
+	struct ProgramCacheEntry
+	{
+		u64 hash;
+		u32 start_pc;
+		std::vector<microRange> ranges;
+		std::vector<u32> words; // Microcode of each range, back to back
+		std::vector<ProgramCacheBlock> blocks;
+	};
+} // namespace
+
+static constexpr u32 PROGRAM_CACHE_MAGIC = 0x43505556; // VUPC
+static constexpr u32 PROGRAM_CACHE_VERSION = 1;
+static constexpr u32 PROGRAM_CACHE_MAX_PROGRAMS = 1024;
+
+static std::string s_vu1_cache_path;
+static std::vector<ProgramCacheEntry> s_vu1_cache_programs;
+
+static std::string mVUgetProgramCachePath()
+{
+	const std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (serial.empty() && crc == 0)
+		return {};
+
+	return Path::Combine(EmuFolders::Cache, fmt::format("vu1_programs_{}_{:08X}.bin", serial.empty() ? "NOSERIAL" : serial, crc));
+}
+
+// Everything which changes the code mVU generates for the same microcode
+static u32 mVUgetProgramCacheSettings()
+{
+	const Pcsx2Config::RecompilerOptions& rec = EmuConfig.Cpu.Recompiler;
+	return (rec.vu1Overflow << 0) | (rec.vu1ExtraOverflow << 1) | (rec.vu1SignOverflow << 2) | (rec.vu1Underflow << 3) |
+		   (EmuConfig.Speedhacks.vuFlagHack << 4) | (THREAD_VU1 << 5) | (static_cast<u32>(sizeof(microRegInfo)) << 8);
+}
+
+static bool mVUisValidRange(const microRange& range)
+{
+	return (range.start >= 0 && range.end > range.start && range.end <= 0x4000 && !(range.start & 3) && !(range.end & 3));
+}
+
+static u64 mVUhashProgramEntry(const ProgramCacheEntry& entry)
+{
+	const u64 hash = GSXXH3_64bits(entry.words.data(), entry.words.size() * sizeof(u32));
+	return hash ^ GSXXH3_64bits(entry.ranges.data(), entry.ranges.size() * sizeof(microRange)) ^ entry.start_pc;
+}
+
+static void mVUaddProgramEntry(ProgramCacheEntry&& entry)
+{
+	// Keep whichever copy of a program knows about more blocks
+	for (ProgramCacheEntry& existing : s_vu1_cache_programs)
+	{
+		if (existing.hash == entry.hash)
+		{
+			if (entry.blocks.size() > existing.blocks.size())
+				existing = std::move(entry);
+			return;
+		}
+	}
+
+	if (s_vu1_cache_programs.size() < PROGRAM_CACHE_MAX_PROGRAMS)
+		s_vu1_cache_programs.push_back(std::move(entry));
+}
+
+static void mVUcollectPrograms(microVU& mVU)
+{
+	for (u32 i = 0; i < (mVU.progSize / 2); i++)
+	{
+		if (!mVU.prog.prog[i])
+			continue;
+
+		for (const microProgram* prog : *mVU.prog.prog[i])
+		{
+			ProgramCacheEntry entry;
+			entry.start_pc = prog->startPC * 8;
+			for (const microRange& range : *prog->ranges)
+			{
+				if (!mVUisValidRange(range))
+					continue;
+
+				entry.ranges.push_back(range);
+				entry.words.insert(entry.words.end(), &prog->data[range.start / 4], &prog->data[range.end / 4]);
+			}
+
+			for (u32 j = 0; j < (mVU.progSize / 2); j++)
+			{
+				if (!prog->block[j])
+					continue;
+
+				prog->block[j]->forEachBlock([&entry, j](const microBlock& block) {
+					entry.blocks.push_back({j * 8, block.pState});
+				});
+			}
+
+			if (entry.ranges.empty() || entry.blocks.empty())
+				continue;
+
+			entry.hash = mVUhashProgramEntry(entry);
+			mVUaddProgramEntry(std::move(entry));
+		}
+	}
+}
+
+static void mVUreadProgramCache()
+{
+	s_vu1_cache_programs.clear();
+
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_vu1_cache_path.c_str());
+	if (!data.has_value())
+		return;
+
+	ProgramCacheHeader header;
+	if (data->size() < sizeof(header))
+		return;
+
+	std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != PROGRAM_CACHE_MAGIC || header.version != PROGRAM_CACHE_VERSION ||
+		header.num_programs > PROGRAM_CACHE_MAX_PROGRAMS)
+	{
+		Console.Warning("microVU1: Ignoring invalid program cache '%s'", s_vu1_cache_path.c_str());
+		return;
+	}
+
+	// Programs compiled with different settings would produce different code, start from scratch
+	if (header.gamefixes != EmuConfig.Gamefixes.bitset || header.settings != mVUgetProgramCacheSettings())
+		return;
+
+	size_t pos = sizeof(header);
+	auto read = [&data, &pos](void* dst, size_t size) {
+		if ((data->size() - pos) < size)
+			return false;
+		std::memcpy(dst, data->data() + pos, size);
+		pos += size;
+		return true;
+	};
+
+	for (u32 i = 0; i < header.num_programs; i++)
+	{
+		ProgramCacheRecord record;
+		ProgramCacheEntry entry;
+		if (!read(&record, sizeof(record)) || record.start_pc >= 0x4000 || (record.start_pc & 7) ||
+			record.num_ranges > mProgSize || record.num_words > mProgSize || record.num_blocks > mProgSize)
+		{
+			Console.Warning("microVU1: Program cache '%s' is truncated", s_vu1_cache_path.c_str());
+			s_vu1_cache_programs.clear();
+			return;
+		}
+
+		entry.start_pc = record.start_pc;
+		entry.ranges.resize(record.num_ranges);
+		entry.words.resize(record.num_words);
+		entry.blocks.resize(record.num_blocks);
+		if (!read(entry.ranges.data(), record.num_ranges * sizeof(microRange)) ||
+			!read(entry.words.data(), record.num_words * sizeof(u32)) ||
+			!read(entry.blocks.data(), record.num_blocks * sizeof(ProgramCacheBlock)))
+		{
+			Console.Warning("microVU1: Program cache '%s' is truncated", s_vu1_cache_path.c_str());
+			s_vu1_cache_programs.clear();
+			return;
+		}
+
+		u32 num_words = 0;
+		for (const microRange& range : entry.ranges)
+			num_words += mVUisValidRange(range) ? static_cast<u32>(range.end - range.start) / 4 : (mProgSize + 1);
+		if (num_words != record.num_words)
+			continue;
+
+		entry.hash = mVUhashProgramEntry(entry);
+		mVUaddProgramEntry(std::move(entry));
+	}
+}
+
+static void mVUwriteProgramCache()
+{
+	if (s_vu1_cache_path.empty() || s_vu1_cache_programs.empty())
+		return;
+
+	const ProgramCacheHeader header = {PROGRAM_CACHE_MAGIC, PROGRAM_CACHE_VERSION, EmuConfig.Gamefixes.bitset,
+		mVUgetProgramCacheSettings(), static_cast<u32>(s_vu1_cache_programs.size())};
+
+	std::vector<u8> data;
+	auto write = [&data](const void* src, size_t size) {
+		data.insert(data.end(), static_cast<const u8*>(src), static_cast<const u8*>(src) + size);
+	};
+
+	write(&header, sizeof(header));
+	for (const ProgramCacheEntry& entry : s_vu1_cache_programs)
+	{
+		const ProgramCacheRecord record = {entry.start_pc, static_cast<u32>(entry.ranges.size()),
+			static_cast<u32>(entry.words.size()), static_cast<u32>(entry.blocks.size())};
+		write(&record, sizeof(record));
+		write(entry.ranges.data(), entry.ranges.size() * sizeof(microRange));
+		write(entry.words.data(), entry.words.size() * sizeof(u32));
+		write(entry.blocks.data(), entry.blocks.size() * sizeof(ProgramCacheBlock));
+	}
+
+	if (!FileSystem::WriteBinaryFile(s_vu1_cache_path.c_str(), data.data(), data.size()))
+	{
+		Console.Error("microVU1: Failed to write program cache '%s'", s_vu1_cache_path.c_str());
+		return;
+	}
+
+	DevCon.WriteLn("microVU1: Wrote %zu programs to '%s'", s_vu1_cache_programs.size(), s_vu1_cache_path.c_str());
+}
+
+// Recompiles a cached program, using a scratch copy of micro memory holding its ranges
+static void mVUpreloadProgram(microVU& mVU, const ProgramCacheEntry& entry)
+{
+	std::memset(mVU.regs().Micro, 0, mVU.microMemSize);
+	const u32* words = entry.words.data();
+	for (const microRange& range : entry.ranges)
+	{
+		std::memcpy(mVU.regs().Micro + range.start, words, range.end - range.start);
+		words += (range.end - range.start) / 4;
+	}
+
+	mVU.regs().start_pc = entry.start_pc;
+	mVU.prog.cleared = 0;
+	mVU.prog.isSame  = 1;
+	mVU.prog.cur     = mVUcreateProg(mVU, entry.start_pc / 8);
+
+	xSetPtr(mVU.prog.x86ptr);
+	for (const ProgramCacheBlock& block : entry.blocks)
+		mVUblockFetch(mVU, block.pc, (uptr)&block.pState);
+	mVU.prog.x86ptr = x86Ptr;
+
+	mVU.prog.prog[entry.start_pc / 8]->push_back(mVU.prog.cur);
+}
+
+void mVUsaveProgramCache(microVU& mVU)
+{
+	if (!mVU.index || s_vu1_cache_path.empty())
+		return;
+
+	mVUcollectPrograms(mVU);
+}
+
+void mVUloadProgramCache(microVU& mVU)
+{
+	if (!mVU.index || !EmuConfig.Cpu.Recompiler.EnableVUProgramCache)
+		return;
+
+	s_vu1_cache_path = mVUgetProgramCachePath();
+	if (s_vu1_cache_path.empty())
+		return;
+
+	mVUreadProgramCache();
+	if (s_vu1_cache_programs.empty())
+		return;
+
+	Common::Timer timer;
+	u32 compiled = 0;
+
+	std::unique_ptr<u8[]> micro_backup = std::make_unique<u8[]>(mVU.microMemSize);
+	std::memcpy(micro_backup.get(), mVU.regs().Micro, mVU.microMemSize);
+	const u32 start_pc = mVU.regs().start_pc;
+
+	// Leave at least half of the program cache for programs which are discovered during gameplay.
+	const u8* preload_end = mVU.prog.x86start + (mVU.prog.x86end - mVU.prog.x86start) / 2;
+
+	for (const ProgramCacheEntry& entry : s_vu1_cache_programs)
+	{
+		if (mVU.prog.x86ptr >= preload_end)
+			break;
+
+		mVUpreloadProgram(mVU, entry);
+		compiled++;
+	}
+
+	std::memcpy(mVU.regs().Micro, micro_backup.get(), mVU.microMemSize);
+	mVU.regs().start_pc = start_pc;
+
+	mVU.prog.cleared = 1;
+	mVU.prog.isSame  = -1;
+	mVU.prog.cur     = NULL;
+	std::memset(&mVU.prog.lpState, 0, sizeof(mVU.prog.lpState));
+	for (u32 i = 0; i < (mVU.progSize / 2); i++)
+	{
+		mVU.prog.quick[i].block = NULL;
+		mVU.prog.quick[i].prog = NULL;
+	}
+
+	Console.WriteLn(Color_Orange, "microVU1: Precompiled %u programs in %.2f ms", compiled, timer.GetTimeMilliseconds());
+}
+
+void mVUcloseProgramCache(microVU& mVU)
+{
+	if (!mVU.index)
+		return;
+
+	mVUsaveProgramCache(mVU);
+	mVUwriteProgramCache();
+	s_vu1_cache_path = {};
+	s_vu1_cache_programs = {};
+}
+
 //------------------------------------------------------------------
 // recMicroVU0 / recMicroVU1
 //------------------------------------------------------------------
@@ -329,6 +670,7 @@ void recMicroVU1::Shutdown()
 {
 	if (vu1Thread.IsOpen())
 		vu1Thread.WaitVU();
+	mVUcloseProgramCache(microVU1);
 	mVUclose(microVU1);
 }
 
@@ -346,6 +688,8 @@ void recMicroVU1::Reset()
 	vu1Thread.WaitVU();
 	vu1Thread.Get_MTVUChanges();
 	mVUreset(microVU1, true);
+	mVUcloseProgramCache(microVU1);
+	mVUloadProgramCache(microVU1);
 }
 
 void recMicroVU0::SetStartPC(u32 startPC)
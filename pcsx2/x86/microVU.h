@@ -9,6 +9,7 @@
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include "Common.h"
 #include "VU.h"
 #include "MTVU.h"
@@ -28,6 +29,9 @@ struct microBlockLink
 {
 	microBlock block;
 	microBlockLink* next;
+	u64 signature; // Hash of the full pipeline state (full search blocks only)
+	u32 lastUse;   // Lookup stamp of the most recent hit, used to prune the least recently used variants
+	bool stale;    // Pruned from the full search, kept alive until reset() as code may still jump to it
 };
 
 struct microBlockLinkRef
@@ -136,19 +140,64 @@ struct microVU
 	}
 };
 
+// Folds the whole pipeline state into 64 bits, compareState() still confirms every match.
+static __fi u64 mVUstateSignature(const microRegInfo* pState)
+{
+	const u64* words = reinterpret_cast<const u64*>(pState);
+	u64 hash = 0;
+	for (u32 i = 0; i < sizeof(microRegInfo) / sizeof(u64); i++)
+	{
+		hash = (hash ^ words[i]) * 0x9E3779B97F4A7C15ULL;
+		hash ^= hash >> 29;
+	}
+	return hash;
+}
+
 class microBlockManager
 {
 private:
+	static const int fListLimit = 256; // Full search variants kept per start PC before the least recently used are pruned
+
 	microBlockLink *qBlockList, *qBlockEnd; // Quick Search
 	microBlockLink *fBlockList, *fBlockEnd; // Full  Search
 	std::vector<microBlockLinkRef> quickLookup;
-	int qListI, fListI;
+	std::unordered_map<u64, microBlockLink*> fullLookup; // Signature -> first live block with that signature
+	int qListI, fListI, fLiveI;
+	u32 useStamp;
+
+	void pruneFullList()
+	{
+		microBlockLink* oldest = nullptr;
+		for (microBlockLink* linkI = fBlockList; linkI != nullptr; linkI = linkI->next)
+		{
+			if (!linkI->stale && (!oldest || linkI->lastUse < oldest->lastUse))
+				oldest = linkI;
+		}
+
+		oldest->stale = true;
+		fLiveI--;
+		auto it = fullLookup.find(oldest->signature);
+		if (it == fullLookup.end() || it->second != oldest)
+			return;
+
+		// Hand the signature over to another live variant which collides with it, if any
+		for (microBlockLink* linkI = fBlockList; linkI != nullptr; linkI = linkI->next)
+		{
+			if (!linkI->stale && linkI->signature == oldest->signature)
+			{
+				it->second = linkI;
+				return;
+			}
+		}
+		fullLookup.erase(it);
+	}
 
 public:
 	inline int getFullListCount() const { return fListI; }
 	microBlockManager()
 	{
-		qListI = fListI = 0;
+		qListI = fListI = fLiveI = 0;
+		useStamp = 0;
 		qBlockEnd = qBlockList = nullptr;
 		fBlockEnd = fBlockList = nullptr;
 	}
@@ -169,10 +218,12 @@ public:
 			linkI = linkI->next;
 			_aligned_free(freeI);
 		}
-		qListI = fListI = 0;
+		qListI = fListI = fLiveI = 0;
+		useStamp = 0;
 		qBlockEnd = qBlockList = nullptr;
 		fBlockEnd = fBlockList = nullptr;
 		quickLookup.clear();
+		fullLookup.clear();
 	};
 	microBlock* add(microVU& mVU, microBlock* pBlock)
 	{
@@ -190,6 +241,9 @@ public:
 			microBlockLink*  newBlock  = (microBlockLink*)_aligned_malloc(sizeof(microBlockLink), 32);
 			newBlock->block.jumpCache  = nullptr;
 			newBlock->next             = nullptr;
+			newBlock->signature        = 0;
+			newBlock->lastUse          = ++useStamp;
+			newBlock->stale            = false;
 
 			if (blockEnd)
 			{
@@ -204,7 +258,17 @@ public:
 			std::memcpy(&newBlock->block, pBlock, sizeof(microBlock));
 			thisBlock = &newBlock->block;
 
-			quickLookup.push_back({&newBlock->block, pBlock->pState.quick64[0]});
+			if (fullCmp)
+			{
+				newBlock->signature = mVUstateSignature(&pBlock->pState);
+				fullLookup.emplace(newBlock->signature, newBlock);
+				if (++fLiveI > fListLimit)
+					pruneFullList();
+			}
+			else
+			{
+				quickLookup.push_back({&newBlock->block, pBlock->pState.quick64[0]});
+			}
 		}
 		return thisBlock;
 	}
@@ -212,35 +276,68 @@ public:
 	{
 		if (pState->needExactMatch) // Needs Detailed Search (Exact Match of Pipeline State)
 		{
-			microBlockLink* prevI = nullptr;
-			for (microBlockLink* linkI = fBlockList; linkI != nullptr; prevI = linkI, linkI = linkI->next)
+			const u64 signature = mVUstateSignature(pState);
+			auto it = fullLookup.find(signature);
+			if (it == fullLookup.end())
+			{
+				mVU.profiler.RecordLookup(true, 0);
+				return nullptr;
+			}
+
+			microBlockLink* found = nullptr;
+			u32 steps = 1;
+			if (mVU.compareState(pState, &it->second->block.pState) == 0)
 			{
-				if (mVU.compareState(pState, &linkI->block.pState) == 0)
+				found = it->second;
+			}
+			else
+			{
+				// Signature collision, fall back to walking the variants which share it
+				for (microBlockLink* linkI = fBlockList; linkI != nullptr; linkI = linkI->next)
 				{
-					if (linkI != fBlockList)
+					if (linkI->stale || linkI->signature != signature || linkI == it->second)
+						continue;
+					steps++;
+					if (mVU.compareState(pState, &linkI->block.pState) == 0)
 					{
-						prevI->next = linkI->next;
-						linkI->next = fBlockList;
-						fBlockList = linkI;
+						found = linkI;
+						break;
 					}
-
-					return &linkI->block;
 				}
 			}
+			mVU.profiler.RecordLookup(true, steps);
+
+			if (!found)
+				return nullptr;
+
+			found->lastUse = ++useStamp;
+			return &found->block;
 		}
 		else // Can do Simple Search (Only Matches the Important Pipeline Stuff)
 		{
 			const u64 quick64 = pState->quick64[0];
+			u32 steps = 0;
 			for (const microBlockLinkRef& ref : quickLookup)
 			{
+				steps++;
 				if (ref.quick != quick64) continue;
 				if (doConstProp && (ref.pBlock->pState.vi15 != pState->vi15))  continue;
 				if (doConstProp && (ref.pBlock->pState.vi15v != pState->vi15v)) continue;
+				mVU.profiler.RecordLookup(false, steps);
 				return ref.pBlock;
 			}
+			mVU.profiler.RecordLookup(false, steps);
 		}
 		return nullptr;
 	}
+	template <typename F>
+	void forEachBlock(const F& func) const
+	{
+		for (microBlockLink* linkI = qBlockList; linkI != nullptr; linkI = linkI->next)
+			func(linkI->block);
+		for (microBlockLink* linkI = fBlockList; linkI != nullptr; linkI = linkI->next)
+			func(linkI->block);
+	}
 	void printInfo(int pc, bool printQuick)
 	{
 		int listI = printQuick ? qListI : fListI;
@@ -285,6 +382,11 @@ extern void mVUcleanUpVU1();
 mVUop(mVUopU);
 mVUop(mVUopL);
 
+// Program Cache Functions
+extern void mVUsaveProgramCache(microVU& mVU);
+extern void mVUloadProgramCache(microVU& mVU);
+extern void mVUcloseProgramCache(microVU& mVU);
+
 // Private Functions
 extern void mVUcacheProg(microVU& mVU, microProgram& prog);
 extern void mVUdeleteProg(microVU& mVU, microProgram*& prog);
@@ -20,8 +20,26 @@ using namespace R5900::Dynarec;
 // we enter micro mode, they will get overriden otherwise...
 #define FLUSH_FOR_POSSIBLE_MICRO_EXEC (FLUSH_FREE_XMM | FLUSH_FREE_VU0)
 
+// The denormalized status flag is left in gprF0 after a macro op, so the next one can skip
+// reloading it. Only valid when that op is the very next instruction of the same block,
+// nothing is compiled in between which could reuse the register or run VU0.
+static bool s_sflag_resident = false;
+static u32 s_sflag_resident_pc = 0;
+static u32 s_sflag_resident_block = 0;
+
+static bool isStatusFlagResident()
+{
+	const bool resident = s_sflag_resident && pc == s_sflag_resident_pc && s_nStartBlock == s_sflag_resident_block &&
+						  !g_recompilingDelaySlot && !x86regs[gprF0.GetId()].inuse &&
+						  !(g_pCurInstInfo->info & (EEINST_COP2_FLUSH_VU0_REGISTERS | EEINST_COP2_SYNC_VU0 | EEINST_COP2_FINISH_VU0));
+	s_sflag_resident = false;
+	return resident;
+}
+
 void setupMacroOp(int mode, const char* opName)
 {
+	const bool sflag_resident = isStatusFlagResident();
+
 	// Set up reg allocation
 	microVU0.regAlloc->reset(true);
 
@@ -65,10 +83,9 @@ void setupMacroOp(int mode, const char* opName)
 			// flags are normalized, so denormalize before running the first instruction
 			mVUallocSFLAGd(&vu0Regs.VI[REG_STATUS_FLAG].UL, gprF0, eax, ecx);
 		}
-		else
+		else if (!sflag_resident)
 		{
 			// load denormalized status flag
-			// ideally we'd keep this in a register, but 32-bit...
 			xMOV(gprF0, ptr32[&vuRegs->VI[REG_STATUS_FLAG].UL]);
 		}
 	}
@@ -96,6 +113,13 @@ void endMacroOp(int mode)
 			// backup denormalized flags for the next instruction
 			// this is fine, because we'll normalize them again before this reg is accessed
 			xMOV(ptr32[&vuRegs->VI[REG_STATUS_FLAG].UL], gprF0);
+
+			if (!g_recompilingDelaySlot)
+			{
+				s_sflag_resident = true;
+				s_sflag_resident_pc = pc + 4;
+				s_sflag_resident_block = s_nStartBlock;
+			}
 		}
 	}
 
@@ -91,7 +91,9 @@ static const char microOpcodeName[][16] = {
 struct microProfiler
 {
 	static const u32 progLimit = 10000;
+	static const u32 chainBuckets = 8; // Lookups taking >= chainBuckets-1 steps share the last bucket
 	u64 opStats[opLastOpcode];
+	u64 chainStats[2][chainBuckets]; // [quick/full][steps taken by microBlockManager::search()]
 	u32 progCount;
 	int index;
 	void Reset(int _index)
@@ -104,6 +106,10 @@ struct microProfiler
 		xADD(ptr32[&(((u32*)opStats)[op * 2 + 0])], 1);
 		xADC(ptr32[&(((u32*)opStats)[op * 2 + 1])], 0);
 	}
+	void RecordLookup(bool fullSearch, u32 steps)
+	{
+		chainStats[fullSearch][std::min(steps, chainBuckets - 1)]++;
+	}
 	void Print()
 	{
 		progCount++;
@@ -129,7 +135,26 @@ struct microProfiler
 				DevCon.WriteLn("%s - [%3.4f%%][count=%u]",
 					str.c_str(), stat, (u32)count);
 			}
-			DevCon.WriteLn("Total = 0x%x%x\n\n", (u32)(u64)(total >> 32), (u32)total);
+			DevCon.WriteLn("Total = 0x%x%x\n", (u32)(u64)(total >> 32), (u32)total);
+			for (u32 i = 0; i < 2; i++)
+			{
+				u64 lookups = 0, steps = 0;
+				for (u32 j = 0; j < chainBuckets; j++)
+				{
+					lookups += chainStats[i][j];
+					steps += chainStats[i][j] * j;
+				}
+				if (!lookups)
+					continue;
+				DevCon.WriteLn("%s block lookups = %llu [avg chain=%.2f]", i ? "Full " : "Quick",
+					lookups, (double)steps / (double)lookups);
+				for (u32 j = 0; j < chainBuckets; j++)
+				{
+					DevCon.WriteLn("  %s%u steps - [%3.4f%%][count=%llu]", (j == chainBuckets - 1) ? ">=" : "  ", j,
+						(double)chainStats[i][j] / (double)lookups * 100.0, chainStats[i][j]);
+				}
+			}
+			DevCon.WriteLn("\n");
 		}
 	}
 };
@@ -138,6 +163,7 @@ struct microProfiler
 {
 	__fi void Reset(int _index) {}
 	__fi void EmitOp(microOpcode op) {}
+	__fi void RecordLookup(bool fullSearch, u32 steps) {}
 	__fi void Print() {}
 };
 #endif
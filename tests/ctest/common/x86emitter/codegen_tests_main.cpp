@@ -134,6 +134,18 @@ TEST(CodegenTests, BitwiseTest)
 	CODEGEN_TEST(xNOT(r8), "49 f7 d0");
 	CODEGEN_TEST(xNOT(ptr64[rax]), "48 f7 10");
 	CODEGEN_TEST(xNOT(ptr32[rbx]), "f7 13");
+	CODEGEN_TEST(xTEST(eax, 0x10), "a8 10"); // Converted to test al, 0x10
+	CODEGEN_TEST(xTEST(ecx, 0x10), "f6 c1 10"); // Converted to test cl, 0x10
+	CODEGEN_TEST(xTEST(esi, 0x10), "40 f6 c6 10"); // Converted to test sil, 0x10
+	CODEGEN_TEST(xTEST(r9, 0x7f), "41 f6 c1 7f"); // Converted to test r9b, 0x7f
+	CODEGEN_TEST(xTEST(ecx, 0x80), "f7 c1 80 00 00 00");
+	CODEGEN_TEST(xTEST(ecx, 0x100), "f7 c1 00 01 00 00");
+	CODEGEN_TEST(xTEST(ptr32[rax], 0x10), "f6 00 10"); // Converted to test byte ptr [rax], 0x10
+	CODEGEN_TEST(xTEST(ptr32[base], 0x10), "f6 05 f9 ff ff ff 10");
+	CODEGEN_TEST(xTEST(ptr32[rax], 0x1000), "f7 00 00 10 00 00");
+	CODEGEN_TEST(xCMP(ecx, 0), "85 c9"); // Converted to test ecx, ecx
+	CODEGEN_TEST(xCMP(r8, 0), "4d 85 c0"); // Converted to test r8, r8
+	CODEGEN_TEST(xCMP(eax, 1), "83 f8 01");
 }
 
 TEST(CodegenTests, JmpTest)
@@ -16,6 +16,7 @@ enum class TestISA
 	isa_sse4,
 	isa_avx,
 	isa_avx2,
+	isa_avx512,
 	isa_native,
 };
 
@@ -26,6 +27,9 @@ static bool CheckCapabilities(TestISA required_caps)
 		return false;
 	if (required_caps == TestISA::isa_avx2 && !cpuinfo_has_x86_avx2())
 		return false;
+	if (required_caps == TestISA::isa_avx512 && (!cpuinfo_has_x86_avx512f() || !cpuinfo_has_x86_avx512bw() ||
+		!cpuinfo_has_x86_avx512vl() || !cpuinfo_has_x86_avx512dq() || !cpuinfo_has_x86_avx512cd()))
+		return false;
 
 	return true;
 }
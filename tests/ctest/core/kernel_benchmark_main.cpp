@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: 2002-2025 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+// Microbenchmarks for the hot kernels which only see regressions once users notice them.
+// Run with --json to get output in the same shape as google-benchmark's JSON reporter,
+// and --filter=<substring> to only run some of them.
+
+#include "pcsx2/GS/GSBlock.h"
+#include "pcsx2/GS/GSClut.h"
+#include "pcsx2/GS/GSXXH.h"
+#include "pcsx2/GS/MultiISA.h"
+#include "pcsx2/IPU/IPU_MultiISA.h"
+#include "pcsx2/IPU/yuv2rgb.h"
+#include "pcsx2/SPU2/defs.h"
+
+#include "common/Timer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+MULTI_ISA_UNSHARED_IMPL;
+
+namespace
+{
+	struct Result
+	{
+		const char* name;
+		u64 iterations;
+		double ns_per_iteration;
+		u64 bytes_per_iteration;
+	};
+
+	// Roughly how long each benchmark runs for, after calibrating the iteration count.
+	static constexpr double TARGET_SECONDS = 0.25;
+
+	static std::string_view s_filter;
+	static std::vector<Result> s_results;
+
+	// Read back after each run so the compiler can't throw the kernels away.
+	static volatile u8 s_sink;
+
+	alignas(64) static u8 s_block[256];
+	alignas(64) static u8 s_pixels[256 * 8];
+	alignas(64) static u32 s_clut32[256];
+	alignas(64) static u64 s_clut64[256];
+	alignas(64) static u8 s_hash_data[64 * 1024];
+	alignas(32) static V_VoiceMixBlock s_voices;
+} // namespace
+
+template <typename Fn>
+static void Run(const char* name, u64 bytes_per_iteration, const u8* output, const Fn& fn)
+{
+	if (!s_filter.empty() && std::string_view(name).find(s_filter) == std::string_view::npos)
+		return;
+
+	u64 iterations = 64;
+	double seconds = 0.0;
+	for (;;)
+	{
+		const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+		for (u64 i = 0; i < iterations; i++)
+			fn();
+		seconds = Common::Timer::ConvertValueToSeconds(Common::Timer::GetCurrentValue() - start);
+		s_sink = *output;
+
+		if (seconds >= TARGET_SECONDS)
+			break;
+
+		// Aim straight for the target once the run is long enough to measure.
+		iterations = (seconds > 0.01) ? static_cast<u64>(iterations * (TARGET_SECONDS * 1.1 / seconds)) : iterations * 8;
+	}
+
+	s_results.push_back({name, iterations, seconds * 1e9 / static_cast<double>(iterations), bytes_per_iteration});
+}
+
+static void RunSwizzleBenchmarks()
+{
+	GIFRegTEXA texa = {};
+	texa.TA0 = 0x40;
+	texa.TA1 = 0x80;
+
+	Run("GSBlock/Read32", 256, s_pixels, []() { GSBlock::ReadBlock32(s_block, s_pixels, 32); });
+	Run("GSBlock/Write32", 256, s_block, []() { GSBlock::WriteBlock32<32, 0xFFFFFFFF>(s_block, s_pixels, 32); });
+	Run("GSBlock/Read16", 256, s_pixels, []() { GSBlock::ReadBlock16(s_block, s_pixels, 32); });
+	Run("GSBlock/ReadAndExpand16", 256, s_pixels, [&texa]() { GSBlock::ReadAndExpandBlock16<false>(s_block, s_pixels, 64, texa); });
+	Run("GSBlock/Write16", 256, s_block, []() { GSBlock::WriteBlock16<32>(s_block, s_pixels, 32); });
+	Run("GSBlock/Read8", 256, s_pixels, []() { GSBlock::ReadBlock8(s_block, s_pixels, 16); });
+	Run("GSBlock/ReadAndExpand8_32", 256, s_pixels, []() { GSBlock::ReadAndExpandBlock8_32(s_block, s_pixels, 64, s_clut32); });
+	Run("GSBlock/Write8", 256, s_block, []() { GSBlock::WriteBlock8<32>(s_block, s_pixels, 16); });
+	Run("GSBlock/Read8H", 256, s_pixels, []() { GSBlock::ReadBlock8HP(s_block, s_pixels, 8); });
+	Run("GSBlock/ReadAndExpand8H_32", 256, s_pixels, []() { GSBlock::ReadAndExpandBlock8H_32(s_block, s_pixels, 32, s_clut32); });
+	Run("GSBlock/Write8H", 256, s_pixels, []() { GSBlock::UnpackAndWriteBlock8H(s_block, 8, s_pixels); });
+	Run("GSBlock/Read4", 256, s_pixels, []() { GSBlock::ReadBlock4(s_block, s_pixels, 16); });
+	Run("GSBlock/Read4P", 256, s_pixels, []() { GSBlock::ReadBlock4P(s_block, s_pixels, 32); });
+	Run("GSBlock/ReadAndExpand4_32", 256, s_pixels, []() { GSBlock::ReadAndExpandBlock4_32(s_block, s_pixels, 128, s_clut32); });
+	Run("GSBlock/Write4", 256, s_block, []() { GSBlock::WriteBlock4<32>(s_block, s_pixels, 16); });
+	Run("GSBlock/Read4HH", 256, s_pixels, []() { GSBlock::ReadBlock4HHP(s_block, s_pixels, 8); });
+	Run("GSBlock/ReadAndExpand4HH_32", 256, s_pixels, []() { GSBlock::ReadAndExpandBlock4HH_32(s_block, s_pixels, 32, s_clut32); });
+}
+
+static void RunClutBenchmarks()
+{
+	Run("GSClut/ExpandCLUT64_T32_I8", sizeof(s_clut32), reinterpret_cast<const u8*>(s_clut64),
+		[]() { GSClut::ExpandCLUT64_T32_I8(s_clut32, s_clut64); });
+}
+
+static void RunHashBenchmarks()
+{
+	Run("GSXXH3/4K", 4096, s_block, []() { s_block[0] = static_cast<u8>(GSXXH3_64bits(s_hash_data, 4096)); });
+	Run("GSXXH3/64K", sizeof(s_hash_data), s_block,
+		[]() { s_block[0] = static_cast<u8>(GSXXH3_64bits(s_hash_data, sizeof(s_hash_data))); });
+}
+
+static void RunIPUBenchmarks()
+{
+	Run("IPU/yuv2rgb", sizeof(decoder.mb8), reinterpret_cast<const u8*>(&decoder.rgb32),
+		[]() { MULTI_ISA_SELECT(yuv2rgb)(); });
+}
+
+static void RunSPU2Benchmarks()
+{
+	for (u32 i = 0; i < V_Core::NumVoices; i++)
+	{
+		for (u32 tap = 0; tap < 4; tap++)
+		{
+			s_voices.Coefs[tap][i] = 0x1000 + static_cast<s32>(tap * 0x100);
+			s_voices.Samples[tap][i] = static_cast<s32>((i * 1337 + tap * 7919) & 0xFFFF) - 0x8000;
+			s_voices.Gates[tap][i] = -1;
+		}
+		s_voices.Envelope[i] = 0x7FFF;
+		s_voices.VolL[i] = 0x3FFF;
+		s_voices.VolR[i] = 0x3FFF;
+	}
+
+	static VoiceMixSet s_mix = {};
+	Run("SPU2/MixVoiceBlock", sizeof(s_voices), reinterpret_cast<const u8*>(s_voices.Out),
+		[]() { MULTI_ISA_SELECT(MixVoiceBlock)(s_voices, s_mix); });
+	Run("SPU2/ReverbDownsample", 0, reinterpret_cast<const u8*>(&Cores[0]),
+		[]() { s_mix.Dry.Left += MULTI_ISA_SELECT(ReverbDownsample)(Cores[0], false); });
+	Run("SPU2/ReverbUpsample", 0, reinterpret_cast<const u8*>(&Cores[0]),
+		[]() { s_mix.Dry.Right += MULTI_ISA_SELECT(ReverbUpsample)(Cores[0]).Left; });
+}
+
+static const char* GetVectorISAName()
+{
+#ifdef _M_X86
+	switch (g_cpu.vectorISA)
+	{
+		case ProcessorFeatures::VectorISA::AVX512F:
+			return "AVX512F";
+		case ProcessorFeatures::VectorISA::AVX2:
+			return "AVX2";
+		case ProcessorFeatures::VectorISA::AVX:
+			return "AVX";
+		case ProcessorFeatures::VectorISA::SSE4:
+		default:
+			return "SSE4";
+	}
+#else
+	return "native";
+#endif
+}
+
+static void PrintText()
+{
+	std::printf("Vector ISA: %s\n", GetVectorISAName());
+	std::printf("%-32s %14s %14s %12s\n", "Benchmark", "Time (ns)", "Iterations", "MB/s");
+	for (const Result& res : s_results)
+	{
+		if (res.bytes_per_iteration != 0)
+		{
+			std::printf("%-32s %14.2f %14llu %12.1f\n", res.name, res.ns_per_iteration,
+				static_cast<unsigned long long>(res.iterations), res.bytes_per_iteration * 1000.0 / res.ns_per_iteration);
+		}
+		else
+		{
+			std::printf("%-32s %14.2f %14llu %12s\n", res.name, res.ns_per_iteration,
+				static_cast<unsigned long long>(res.iterations), "-");
+		}
+	}
+}
+
+static void PrintJSON()
+{
+	std::printf("{\n  \"context\": {\"vector_isa\": \"%s\"},\n  \"benchmarks\": [\n", GetVectorISAName());
+	for (size_t i = 0; i < s_results.size(); i++)
+	{
+		const Result& res = s_results[i];
+		std::printf("    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.3f, \"cpu_time\": %.3f, "
+					"\"time_unit\": \"ns\", \"bytes_per_second\": %.1f}%s\n",
+			res.name, static_cast<unsigned long long>(res.iterations), res.ns_per_iteration, res.ns_per_iteration,
+			res.bytes_per_iteration * 1e9 / res.ns_per_iteration, (i + 1) < s_results.size() ? "," : "");
+	}
+	std::printf("  ]\n}\n");
+}
+
+int main(int argc, char* argv[])
+{
+	bool json = false;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg(argv[i]);
+		if (arg == "--json")
+			json = true;
+		else if (arg.starts_with("--filter="))
+			s_filter = arg.substr(9);
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--json] [--filter=<substring>]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	srand(0);
+	for (u32 i = 0; i < 256; i++)
+	{
+		s_block[i] = static_cast<u8>(rand());
+		s_clut32[i] = static_cast<u32>(rand());
+	}
+	for (u8& value : s_hash_data)
+		value = static_cast<u8>(rand());
+	GSClut::ExpandCLUT64_T32_I8(s_clut32, s_clut64);
+
+	RunSwizzleBenchmarks();
+	RunClutBenchmarks();
+	RunHashBenchmarks();
+	RunIPUBenchmarks();
+	RunSPU2Benchmarks();
+
+	if (json)
+		PrintJSON();
+	else
+		PrintText();
+
+	return EXIT_SUCCESS;
+}
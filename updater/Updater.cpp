@@ -4,6 +4,7 @@
 #include "Updater.h"
 
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
@@ -33,6 +34,15 @@ static constexpr size_t kInputBufSize = ((size_t)1 << 18);
 static constexpr ISzAlloc g_Alloc = {SzAlloc, SzFree};
 #endif
 
+// Files stored under this suffix are deltas against the installed copy, created with zstd --patch-from.
+static constexpr const char* DELTA_SUFFIX = ".zstpatch";
+
+// Size of each write when streaming a patched file out to the staging directory.
+static constexpr size_t DELTA_OUTPUT_CHUNK_SIZE = 256 * 1024;
+
+// Largest window zstd allows on 64-bit, deltas against big files need up to this.
+static constexpr int DELTA_MAX_WINDOW_LOG = 31;
+
 Updater::Updater(ProgressCallback* progress)
 	: m_progress(progress)
 {
@@ -201,9 +211,16 @@ bool Updater::ParseZip()
 		FileToUpdate entry;
 		entry.file_index = file_index;
 		entry.destination_filename = StringUtil::WideStringToUTF8String(reinterpret_cast<wchar_t*>(filename_buffer.data()));
+		entry.is_delta = false;
 		if (entry.destination_filename.empty())
 			continue;
 
+		if (StringUtil::EndsWithNoCase(entry.destination_filename, DELTA_SUFFIX))
+		{
+			entry.destination_filename.erase(entry.destination_filename.length() - std::strlen(DELTA_SUFFIX));
+			entry.is_delta = true;
+		}
+
 		// replace forward slashes with backslashes
 		for (size_t i = 0; i < entry.destination_filename.length(); i++)
 		{
@@ -222,7 +239,8 @@ bool Updater::ParseZip()
 			// also skips portable.ini to not mess with future non-portable installs.
 			if (StringUtil::Strcasecmp(entry.destination_filename.c_str(), "updater.exe") != 0)
 			{
-				m_progress->DisplayFormattedInformation("Found file in zip: '%s'", entry.destination_filename.c_str());
+				m_progress->DisplayFormattedInformation("Found %s in zip: '%s'", entry.is_delta ? "delta" : "file",
+					entry.destination_filename.c_str());
 				m_update_paths.push_back(std::move(entry));
 			}
 		}
@@ -310,6 +328,9 @@ bool Updater::StageUpdate()
 			ISzAlloc_Free(&g_Alloc, out_buffer);
 	});
 
+	// zstd may be one of the files being replaced, so it can't stay loaded until the commit.
+	ScopedGuard zstd_guard([this]() { m_zstd_library.Close(); });
+
 	for (const FileToUpdate& ftu : m_update_paths)
 	{
 		m_progress->SetFormattedStatusText("Extracting '%s'...", ftu.destination_filename.c_str());
@@ -326,10 +347,19 @@ bool Updater::StageUpdate()
 			return false;
 		}
 
-		m_progress->DisplayFormattedInformation("Writing '%s' to staging (%zu bytes)...", ftu.destination_filename.c_str(), extracted_size);
-
 		const std::string destination_file = StringUtil::StdStringFromFormat(
 			"%s" FS_OSPATH_SEPARATOR_STR "%s", m_staging_directory.c_str(), ftu.destination_filename.c_str());
+		if (ftu.is_delta)
+		{
+			m_progress->DisplayFormattedInformation("Patching '%s' into staging (%zu byte delta)...", ftu.destination_filename.c_str(), extracted_size);
+			if (!ApplyDelta(ftu, out_buffer + out_offset, extracted_size, destination_file))
+				return false;
+
+			m_progress->IncrementProgressValue();
+			continue;
+		}
+
+		m_progress->DisplayFormattedInformation("Writing '%s' to staging (%zu bytes)...", ftu.destination_filename.c_str(), extracted_size);
 		std::FILE* fp = FileSystem::OpenCFile(destination_file.c_str(), "wb");
 		if (!fp)
 		{
@@ -354,6 +384,129 @@ bool Updater::StageUpdate()
 #endif
 }
 
+bool Updater::LoadZstd()
+{
+	if (m_zstd_library.IsOpen())
+		return true;
+
+	Error error;
+	const std::string path = Path::Combine(m_destination_directory, DynamicLibrary::GetUnprefixedFilename("zstd"));
+	if (!m_zstd_library.Open(path.c_str(), &error))
+	{
+		m_progress->DisplayFormattedModalError("Failed to load '%s' for applying deltas: %s", path.c_str(), error.GetDescription().c_str());
+		return false;
+	}
+
+	if (!m_zstd_library.GetSymbol("ZSTD_createDCtx", &m_zstd_create_dctx) ||
+		!m_zstd_library.GetSymbol("ZSTD_freeDCtx", &m_zstd_free_dctx) ||
+		!m_zstd_library.GetSymbol("ZSTD_DCtx_setParameter", &m_zstd_dctx_set_parameter) ||
+		!m_zstd_library.GetSymbol("ZSTD_DCtx_refPrefix", &m_zstd_dctx_ref_prefix) ||
+		!m_zstd_library.GetSymbol("ZSTD_decompressStream", &m_zstd_decompress_stream) ||
+		!m_zstd_library.GetSymbol("ZSTD_isError", &m_zstd_is_error) ||
+		!m_zstd_library.GetSymbol("ZSTD_getErrorName", &m_zstd_get_error_name))
+	{
+		m_progress->DisplayFormattedModalError("'%s' is missing functions needed for applying deltas.", path.c_str());
+		m_zstd_library.Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool Updater::ApplyDelta(const FileToUpdate& ftu, const u8* patch, size_t patch_size, const std::string& destination_file)
+{
+	// The frame checksum is what tells us the delta was applied to the same file it was made
+	// against, so refuse deltas without one. It's bit 2 of the frame header descriptor.
+	if (patch_size < 5 || (patch[0] | (patch[1] << 8) | (patch[2] << 16) | (static_cast<u32>(patch[3]) << 24)) != ZSTD_MAGICNUMBER ||
+		(patch[4] & 0x04) == 0)
+	{
+		m_progress->DisplayFormattedModalError("Delta for '%s' is not a checksummed zstd frame.", ftu.destination_filename.c_str());
+		return false;
+	}
+
+	if (!LoadZstd())
+		return false;
+
+	const std::string base_file = StringUtil::StdStringFromFormat(
+		"%s" FS_OSPATH_SEPARATOR_STR "%s", m_destination_directory.c_str(), ftu.destination_filename.c_str());
+	const std::optional<std::vector<u8>> base = FileSystem::ReadBinaryFile(base_file.c_str());
+	if (!base.has_value())
+	{
+		m_progress->DisplayFormattedModalError("Failed to read '%s' to apply delta to.", base_file.c_str());
+		return false;
+	}
+
+	ZSTD_DCtx* dctx = m_zstd_create_dctx();
+	if (!dctx)
+	{
+		m_progress->DisplayFormattedModalError("ZSTD_createDCtx() failed");
+		return false;
+	}
+
+	ScopedGuard dctx_guard([this, dctx]() { m_zstd_free_dctx(dctx); });
+
+	// --patch-from sizes the window to cover the whole base file, which is past the default limit.
+	size_t zres = m_zstd_dctx_set_parameter(dctx, ZSTD_d_windowLogMax, DELTA_MAX_WINDOW_LOG);
+	if (!m_zstd_is_error(zres))
+		zres = m_zstd_dctx_ref_prefix(dctx, base->data(), base->size());
+	if (m_zstd_is_error(zres))
+	{
+		m_progress->DisplayFormattedModalError("Failed to set up delta for '%s': %s", ftu.destination_filename.c_str(),
+			m_zstd_get_error_name(zres));
+		return false;
+	}
+
+	std::FILE* fp = FileSystem::OpenCFile(destination_file.c_str(), "wb");
+	if (!fp)
+	{
+		m_progress->DisplayFormattedModalError("Failed to open staging output file '%s'", destination_file.c_str());
+		return false;
+	}
+
+	// Written out as it's decompressed, so the patched file never has to be held in memory.
+	std::unique_ptr<u8[]> chunk = std::make_unique_for_overwrite<u8[]>(DELTA_OUTPUT_CHUNK_SIZE);
+	ZSTD_inBuffer input = {patch, patch_size, 0};
+	const char* error = nullptr;
+	for (;;)
+	{
+		ZSTD_outBuffer output = {chunk.get(), DELTA_OUTPUT_CHUNK_SIZE, 0};
+		zres = m_zstd_decompress_stream(dctx, &output, &input);
+		if (m_zstd_is_error(zres))
+		{
+			// Includes checksum mismatches, i.e. the installed file isn't the one the delta was made against.
+			error = m_zstd_get_error_name(zres);
+			break;
+		}
+
+		if (output.pos > 0 && std::fwrite(chunk.get(), output.pos, 1, fp) != 1)
+		{
+			error = "write failed";
+			break;
+		}
+
+		if (zres == 0)
+			break;
+
+		if (input.pos == input.size && output.pos < output.size)
+		{
+			error = "delta is truncated";
+			break;
+		}
+	}
+
+	if ((std::fflush(fp) != 0 && !error) || (std::fclose(fp) != 0 && !error))
+		error = "write failed";
+
+	if (error)
+	{
+		m_progress->DisplayFormattedModalError("Failed to apply delta for '%s': %s", ftu.destination_filename.c_str(), error);
+		FileSystem::DeleteFilePath(destination_file.c_str());
+		return false;
+	}
+
+	return true;
+}
+
 bool Updater::CommitUpdate()
 {
 	m_progress->SetStatusText("Committing update...");
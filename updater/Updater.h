@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "common/DynamicLibrary.h"
 #include "common/ProgressCallback.h"
 
 #ifdef _WIN32
@@ -11,6 +12,8 @@
 #include "7zFile.h"
 #endif
 
+#include <zstd.h>
+
 #include <string>
 #include <vector>
 
@@ -42,10 +45,14 @@ private:
 	{
 		u32 file_index;
 		std::string destination_filename;
+		bool is_delta; ///< Stored as a zstd --patch-from delta against the installed file.
 	};
 
 	bool ParseZip();
 
+	bool LoadZstd();
+	bool ApplyDelta(const FileToUpdate& ftu, const u8* patch, size_t patch_size, const std::string& destination_file);
+
 	std::string m_zip_path;
 	std::string m_destination_directory;
 	std::string m_staging_directory;
@@ -55,6 +62,16 @@ private:
 
 	ProgressCallback* m_progress;
 
+	// Loaded from the installation on demand, so the updater itself doesn't depend on it.
+	DynamicLibrary m_zstd_library;
+	decltype(&ZSTD_createDCtx) m_zstd_create_dctx = nullptr;
+	decltype(&ZSTD_freeDCtx) m_zstd_free_dctx = nullptr;
+	decltype(&ZSTD_DCtx_setParameter) m_zstd_dctx_set_parameter = nullptr;
+	decltype(&ZSTD_DCtx_refPrefix) m_zstd_dctx_ref_prefix = nullptr;
+	decltype(&ZSTD_decompressStream) m_zstd_decompress_stream = nullptr;
+	decltype(&ZSTD_isError) m_zstd_is_error = nullptr;
+	decltype(&ZSTD_getErrorName) m_zstd_get_error_name = nullptr;
+
 #ifdef _WIN32
 	CFileInStream m_archive_stream = {};
 	CLookToRead2 m_look_stream = {};